@@ -120,10 +120,12 @@ group "Engine"
 group "Game" 
     include "../../Source/Game/Build-Game.lua"
     
--- group "Tools"
+group "Tools"
+    include "../../Source/Tools/AssetPacker/Build-AssetPacker.lua"
+    include "../../Source/Tools/AssetCooker/Build-AssetCooker.lua"
     -- include "Source/ModAPI/Build-ModAPI.lua"
     -- include "Source/Launcher/Build-Launcher.lua"
     -- include "Source/Editor/Build-Editor.lua"
     
--- group "Tests"
-    -- include "Tests/Build-Tests.lua"
\ No newline at end of file
+group "Tests"
+    include "../../Tests/Build-Tests.lua"
\ No newline at end of file
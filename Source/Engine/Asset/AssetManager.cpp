@@ -0,0 +1,1015 @@
+#include "ashbornpch.h"
+
+#include "AssetManager.h"
+#include "AssetPack.h"
+#include "Jobs/JobSystem.h"
+
+#include <fstream>
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t PRIORITY_COUNT = static_cast<size_t>(AssetPriority::Count);
+
+        constexpr std::string_view PACK_EXTENSION = ".ashpack";
+
+        std::string makeLookupKey(AssetTypeId type, std::string_view path) {
+            std::string key = std::to_string(type);
+            key += ':';
+            key += path;
+            return key;
+        }
+    }
+
+    // ==========================================
+    // LOAD CONTEXT
+    // ==========================================
+
+    std::optional<AssetLoadContext::Source> AssetLoadContext::findSource() const {
+        std::error_code ec;
+        const std::filesystem::path relative(path_);
+        if (relative.is_absolute()) {
+            if (std::filesystem::is_regular_file(relative, ec)) return Source{ relative, nullptr };
+            return std::nullopt;
+        }
+        for (const auto& root : roots_) {
+            if (root.pack) {
+                if (root.pack->contains(path_)) return Source{ {}, root.pack.get() };
+                continue;
+            }
+            std::filesystem::path candidate = root.path / relative;
+            if (std::filesystem::is_regular_file(candidate, ec)) {
+                return Source{ std::move(candidate), nullptr };
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::filesystem::path AssetLoadContext::resolve() const {
+        auto source = findSource();
+        return source ? std::move(source->file) : std::filesystem::path{};
+    }
+
+    std::optional<std::span<const std::byte>> AssetLoadContext::view() const {
+        const auto source = findSource();
+        if (!source || !source->pack) return std::nullopt;
+        return source->pack->view(path_, validate_);
+    }
+
+    std::expected<std::vector<std::byte>, AssetError> AssetLoadContext::readFile() const {
+        const auto source = findSource();
+        if (!source) {
+            return std::unexpected(AssetError::PathNotFound);
+        }
+        if (source->pack) {
+            return source->pack->read(path_, validate_);
+        }
+        const std::filesystem::path& file = source->file;
+
+        std::ifstream stream(file, std::ios::binary | std::ios::ate);
+        if (!stream) {
+            return std::unexpected(AssetError::PathNotFound);
+        }
+        const auto size = static_cast<size_t>(stream.tellg());
+        std::vector<std::byte> bytes(size);
+        stream.seekg(0);
+        if (!stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size))) {
+            return std::unexpected(AssetError::CorruptedAsset);
+        }
+        return bytes;
+    }
+
+    // ==========================================
+    // CONSTRUCTOR / DESTRUCTOR
+    // ==========================================
+
+    AssetManager::AssetManager(const AssetConfig& config)
+        : validate_(config.validate_assets)
+        , finalize_budget_(static_cast<int64_t>(config.finalize_budget_ms * 1000.0))
+        , budget_bytes_(config.cache_size_mb * 1024 * 1024) {
+
+        for (const auto& path : config.asset_paths) {
+            if (path.extension() != PACK_EXTENSION) {
+                roots_.push_back({ path, nullptr });
+                continue;
+            }
+            auto pack = AssetPack::open(path);
+            if (!pack) {
+                // The remaining roots may still provide what is needed
+                print_e("Failed to mount asset pack", LogContext{
+                    {"path", path.string()},
+                    {"error", static_cast<int>(pack.error())}
+                    });
+                continue;
+            }
+            roots_.push_back({ path, std::move(*pack) });
+        }
+
+        if (config.async_loading && config.loader_threads > 0) {
+            loaders_ = std::make_unique<JobSystem>(config.loader_threads, "AssetLoader");
+        }
+
+        print_d("Asset manager created", LogContext{
+            {"async", loaders_ != nullptr},
+            {"loader_threads", loaders_ ? loaders_->getWorkerCount() : 0u},
+            {"roots", roots_.size()},
+            {"cache_mb", config.cache_size_mb}
+            });
+    }
+
+    AssetManager::~AssetManager() {
+        // Queued loads are dropped; loads already running finish before the pool joins
+        {
+            std::lock_guard lock(queue_mutex_);
+            stopping_ = true;
+            for (auto& queue : load_queue_) queue.clear();
+            queue_entries_.clear();
+        }
+        completed_signal_.notify_all();
+        loaders_.reset();
+    }
+
+    void AssetManager::setLoader(AssetTypeId type, std::unique_ptr<ErasedLoader> loader) {
+        if (type >= type_loaders_.size()) {
+            type_loaders_.resize(type + 1);
+        }
+        type_loaders_[type] = std::move(loader);
+    }
+
+    // ==========================================
+    // REQUESTS
+    // ==========================================
+
+    AssetId AssetManager::request(AssetTypeId type, std::string_view path, AssetPriority priority) {
+        std::string key = makeLookupKey(type, path);
+        if (auto it = lookup_.find(key); it != lookup_.end()) {
+            ++cache_stats_.hits;
+            ++records_[it->second].references;
+            touch(it->second);
+            promote(it->second, priority);
+            return { it->second, records_[it->second].generation };
+        }
+
+        ++cache_stats_.misses;
+        const bool was_ghost = consumeGhost(key);
+
+        uint32_t index;
+        if (!free_records_.empty()) {
+            // Evicted slots keep their bumped generation so old ids stay stale
+            index = free_records_.back();
+            free_records_.pop_back();
+            const uint32_t generation = records_[index].generation;
+            records_[index] = Record{};
+            records_[index].generation = generation;
+        }
+        else {
+            index = static_cast<uint32_t>(records_.size());
+            records_.emplace_back();
+        }
+        lookup_.emplace(std::move(key), index);
+
+        Record& record = records_[index];
+        record.type = type;
+        record.priority = priority;
+        record.path = std::string(path);
+        record.references = 1;
+        record.frequent = was_ghost;
+
+        if (type >= type_loaders_.size() || !type_loaders_[type]) {
+            fail(index, AssetError::LoaderNotFound);
+            return { index, record.generation };
+        }
+
+        record.state = AssetState::Queued;
+        enqueue(index);
+        return { index, record.generation };
+    }
+
+    void AssetManager::enqueue(uint32_t index, bool reload) {
+        const Record& record = records_[index];
+        {
+            std::lock_guard lock(queue_mutex_);
+            queue_entries_[index] = { record.generation, record.priority, false };
+            load_queue_[static_cast<size_t>(record.priority)].push_back({ index, record.generation, record.type, record.priority, record.path, reload });
+        }
+
+        // Each job takes whatever is most urgent when it runs, not this request
+        if (loaders_) {
+            loaders_->submit([this]() { runOneLoad(); });
+        }
+    }
+
+    void AssetManager::promote(uint32_t index, AssetPriority priority) {
+        Record& record = records_[index];
+        if (priority >= record.priority) return;
+        record.priority = priority;
+
+        if (record.state == AssetState::Queued) {
+            // The old entry stays behind and is skipped when popped
+            std::lock_guard lock(queue_mutex_);
+            auto it = queue_entries_.find(index);
+            if (it != queue_entries_.end() && !it->second.claimed) {
+                it->second.priority = priority;
+                load_queue_[static_cast<size_t>(priority)].push_back({ index, record.generation, record.type, priority, record.path, false });
+            }
+        }
+        else if (record.state == AssetState::WaitingFinalize) {
+            finalize_queue_[static_cast<size_t>(priority)].push_back(index);
+        }
+
+        // Whatever an urgent asset waits on is just as urgent
+        for (const AssetId dependency : std::vector<AssetId>(record.dependencies)) {
+            promote(dependency.index, priority);
+        }
+    }
+
+    // ==========================================
+    // LOADING (ANY THREAD)
+    // ==========================================
+
+    bool AssetManager::runOneLoad() {
+        QueuedLoad job;
+        {
+            std::lock_guard lock(queue_mutex_);
+            bool found = false;
+            for (auto& queue : load_queue_) {
+                while (!found && !queue.empty()) {
+                    QueuedLoad candidate = std::move(queue.front());
+                    queue.pop_front();
+
+                    auto it = queue_entries_.find(candidate.index);
+                    if (it == queue_entries_.end() || it->second.generation != candidate.generation ||
+                        it->second.claimed || it->second.priority != candidate.priority) {
+                        continue;  // Promoted, cancelled or already taken
+                    }
+                    it->second.claimed = true;
+                    job = std::move(candidate);
+                    found = true;
+                }
+                if (found) break;
+            }
+            if (!found) return false;
+        }
+
+        AssetLoadContext context(job.path, roots_, validate_);
+        CompletedLoad completed{ job.index, job.generation, job.reload, std::unexpected(AssetError::Unknown), {} };
+        try {
+            completed.result = type_loaders_[job.type]->load(context);
+        }
+        catch (const std::exception& e) {
+            print_e("Exception while loading asset", LogContext{
+                {"path", job.path},
+                {"what", std::string(e.what())}
+                });
+        }
+        completed.dependencies = std::move(context.dependencies_);
+
+        {
+            std::lock_guard lock(queue_mutex_);
+            if (auto it = queue_entries_.find(job.index); it != queue_entries_.end() && it->second.generation == job.generation) {
+                queue_entries_.erase(it);
+            }
+            completed_.push_back(std::move(completed));
+        }
+        completed_signal_.notify_all();
+        return true;
+    }
+
+    // ==========================================
+    // MAIN THREAD
+    // ==========================================
+
+    void AssetManager::update() {
+        if (loaders_) {
+            collectCompleted();
+        }
+        else {
+            // Inline mode: keep going until dependency chains are exhausted
+            bool ran = true;
+            while (ran) {
+                ran = false;
+                while (runOneLoad()) ran = true;
+                collectCompleted();
+            }
+        }
+
+        finalizePending(false);
+        commitReloads();
+        enforceBudget();
+        updateStats();
+    }
+
+    AssetState AssetManager::wait(AssetId id) {
+        while (true) {
+            collectCompleted();
+            finalizePending(true);
+
+            const AssetState state = getState(id);
+            if (state == AssetState::Ready || state == AssetState::Failed || state == AssetState::Unknown) {
+                updateStats();
+                return state;
+            }
+
+            // Help with queued loads; otherwise sleep until a loader thread reports back
+            if (!runOneLoad()) {
+                std::unique_lock lock(queue_mutex_);
+                completed_signal_.wait_for(lock, std::chrono::milliseconds(1), [this]() { return !completed_.empty() || stopping_; });
+            }
+        }
+    }
+
+    void AssetManager::collectCompleted() {
+        {
+            std::lock_guard lock(queue_mutex_);
+            std::swap(completed_, completed_swap_);
+        }
+
+        for (CompletedLoad& completed : completed_swap_) {
+            if (completed.index >= records_.size()) continue;
+            if (completed.reload) {
+                stageReload(completed);
+                continue;
+            }
+            Record& record = records_[completed.index];
+            if (record.generation != completed.generation || record.state != AssetState::Queued) continue;
+
+            if (!completed.result) {
+                fail(completed.index, completed.result.error());
+                continue;
+            }
+            record.data = std::move(*completed.result);
+            resolveDependencies(completed.index, completed.dependencies);
+        }
+        completed_swap_.clear();
+    }
+
+    void AssetManager::resolveDependencies(uint32_t index, std::vector<AssetLoadContext::Dependency>& dependencies) {
+        records_[index].state = AssetState::WaitingDependencies;
+        records_[index].pending_dependencies = 0;
+
+        for (auto& dependency : dependencies) {
+            // May grow records_, so no references across this call
+            const AssetId id = request(dependency.type, dependency.path, records_[index].priority);
+            records_[index].dependencies.push_back(id);  // Holds the reference request() took
+
+            if (id.index == index || dependsOn(id.index, index)) {
+                print_e("Asset dependency cycle", LogContext{
+                    {"asset", records_[index].path},
+                    {"dependency", dependency.path}
+                    });
+                // A failed asset keeps its dependencies; a cycle must not keep itself alive
+                const std::vector<AssetId> cycle = std::move(records_[index].dependencies);
+                records_[index].dependencies.clear();
+                for (const AssetId held : cycle) {
+                    if (findRecord(held)) releaseIndex(held.index);
+                }
+                fail(index, AssetError::CorruptedAsset);
+                return;
+            }
+
+            Record& target = records_[id.index];
+            if (target.state == AssetState::Failed) {
+                fail(index, target.error);
+                return;
+            }
+            if (target.state != AssetState::Ready) {
+                target.dependents.push_back({ index, records_[index].generation });
+                ++records_[index].pending_dependencies;
+            }
+        }
+
+        Record& record = records_[index];
+        if (record.pending_dependencies == 0) {
+            record.state = AssetState::WaitingFinalize;
+            finalize_queue_[static_cast<size_t>(record.priority)].push_back(index);
+        }
+    }
+
+    bool AssetManager::dependsOn(uint32_t from, uint32_t target) const {
+        std::vector<uint32_t> stack{ from };
+        std::vector<bool> visited(records_.size(), false);
+        while (!stack.empty()) {
+            const uint32_t current = stack.back();
+            stack.pop_back();
+            if (current == target) return true;
+            if (visited[current]) continue;
+            visited[current] = true;
+            for (const AssetId dependency : records_[current].dependencies) {
+                stack.push_back(dependency.index);
+            }
+        }
+        return false;
+    }
+
+    void AssetManager::finalizePending(bool unbounded) {
+        const auto start = std::chrono::steady_clock::now();
+        stats_.finalized_last_update = 0;
+
+        for (size_t priority = 0; priority < PRIORITY_COUNT; ++priority) {
+            auto& queue = finalize_queue_[priority];
+            while (!queue.empty()) {
+                // Blocking work ignores the budget; everything else stops once it is spent
+                const bool over_budget = std::chrono::steady_clock::now() - start >= finalize_budget_;
+                if (!unbounded && priority != static_cast<size_t>(AssetPriority::Blocking) &&
+                    stats_.finalized_last_update > 0 && over_budget) {
+                    stats_.finalize_time_last_update = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+                    return;
+                }
+
+                const uint32_t index = queue.front();
+                queue.pop_front();
+                Record& record = records_[index];
+                if (record.state != AssetState::WaitingFinalize || static_cast<size_t>(record.priority) != priority) {
+                    continue;  // Stale entry left by a promotion
+                }
+
+                std::expected<void, AssetError> result = std::unexpected(AssetError::Unknown);
+                try {
+                    result = type_loaders_[record.type]->finalize(record.data.get());
+                }
+                catch (const std::exception& e) {
+                    print_e("Exception while finalizing asset", LogContext{
+                        {"path", record.path},
+                        {"what", std::string(e.what())}
+                        });
+                }
+
+                if (result) {
+                    markReady(index);
+                }
+                else {
+                    fail(index, result.error());
+                }
+                ++stats_.finalized_last_update;
+            }
+        }
+        stats_.finalize_time_last_update = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    }
+
+    void AssetManager::markReady(uint32_t index) {
+        Record& ready = records_[index];
+        ready.state = AssetState::Ready;
+        ready.bytes = type_loaders_[ready.type]->getMemorySize(ready.data.get());
+        linkResident(index, ready.frequent ? CacheList::Frequent : CacheList::Recent);
+
+        std::vector<AssetId> dependents = std::move(records_[index].dependents);
+        records_[index].dependents.clear();
+        for (const AssetId dependent : dependents) {
+            if (!findRecord(dependent)) continue;
+            Record& record = records_[dependent.index];
+            if (record.state != AssetState::WaitingDependencies) continue;
+            if (--record.pending_dependencies == 0) {
+                record.state = AssetState::WaitingFinalize;
+                finalize_queue_[static_cast<size_t>(record.priority)].push_back(dependent.index);
+            }
+        }
+    }
+
+    void AssetManager::fail(uint32_t index, AssetError error) {
+        Record& record = records_[index];
+        record.state = AssetState::Failed;
+        record.error = error;
+        record.data.reset();
+
+        print_w("Asset failed to load", LogContext{
+            {"path", record.path},
+            {"error", static_cast<int>(error)}
+            });
+
+        // Dependencies stay referenced, so reloading one that failed finds its dependents
+        std::vector<AssetId> dependents = std::move(record.dependents);
+        records_[index].dependents.clear();
+        for (const AssetId dependent : dependents) {
+            if (findRecord(dependent) && records_[dependent.index].state == AssetState::WaitingDependencies) {
+                fail(dependent.index, error);
+            }
+        }
+        dropFailed(index);
+    }
+
+    // ==========================================
+    // QUERIES
+    // ==========================================
+
+    const AssetManager::Record* AssetManager::findRecord(AssetId id) const noexcept {
+        if (id.index >= records_.size() || records_[id.index].generation != id.generation) return nullptr;
+        return &records_[id.index];
+    }
+
+    void* AssetManager::getData(AssetId id, AssetTypeId type) const noexcept {
+        const Record* record = findRecord(id);
+        if (!record || record->type != type || record->state != AssetState::Ready) return nullptr;
+        return record->data.get();
+    }
+
+    AssetState AssetManager::getState(AssetId id) const noexcept {
+        const Record* record = findRecord(id);
+        if (!record) return AssetState::Unknown;
+        if (record->state == AssetState::Queued) {
+            std::lock_guard lock(queue_mutex_);
+            auto it = queue_entries_.find(id.index);
+            // Loaded but not collected yet still counts as loading
+            if (it == queue_entries_.end() || it->second.claimed) return AssetState::Loading;
+        }
+        return record->state;
+    }
+
+    AssetError AssetManager::getError(AssetId id) const noexcept {
+        const Record* record = findRecord(id);
+        return record ? record->error : AssetError::None;
+    }
+
+    const std::string& AssetManager::getPath(AssetId id) const noexcept {
+        static const std::string empty;
+        const Record* record = findRecord(id);
+        return record ? record->path : empty;
+    }
+
+    std::span<const AssetId> AssetManager::getDependencies(AssetId id) const noexcept {
+        const Record* record = findRecord(id);
+        return record ? std::span<const AssetId>(record->dependencies) : std::span<const AssetId>{};
+    }
+
+    AssetTypeStats AssetManager::getTypeStats(AssetTypeId type) const noexcept {
+        return type < type_stats_.size() ? type_stats_[type] : AssetTypeStats{};
+    }
+
+    void AssetManager::updateStats() {
+        const uint32_t finalized = stats_.finalized_last_update;
+        const auto finalize_time = stats_.finalize_time_last_update;
+        stats_ = {};
+        stats_.finalized_last_update = finalized;
+        stats_.finalize_time_last_update = finalize_time;
+
+        cache_stats_.budget_bytes = budget_bytes_;
+        cache_stats_.recent_bytes = recent_.bytes;
+        cache_stats_.frequent_bytes = frequent_.bytes;
+        cache_stats_.recent_target_bytes = recent_target_;
+        cache_stats_.recent_ghost_bytes = recent_ghosts_.bytes;
+        cache_stats_.frequent_ghost_bytes = frequent_ghosts_.bytes;
+        cache_stats_.pinned_bytes = 0;
+        stats_.reloads_committed = reloads_committed_;
+
+        // One lock for the whole pass rather than one per queued record in getState()
+        std::lock_guard lock(queue_mutex_);
+        for (uint32_t index = 0; index < records_.size(); ++index) {
+            const Record& record = records_[index];
+            if (record.pins > 0) cache_stats_.pinned_bytes += record.bytes;
+            if (record.reload_batch != NO_BATCH) ++stats_.reloading;
+
+            AssetState state = record.state;
+            if (state == AssetState::Queued) {
+                auto it = queue_entries_.find(index);
+                if (it == queue_entries_.end() || it->second.claimed) state = AssetState::Loading;
+            }
+            switch (state) {
+            case AssetState::Queued: ++stats_.queued; break;
+            case AssetState::Loading: ++stats_.loading; break;
+            case AssetState::WaitingDependencies: ++stats_.waiting_dependencies; break;
+            case AssetState::WaitingFinalize: ++stats_.waiting_finalize; break;
+            case AssetState::Ready: ++stats_.ready; break;
+            case AssetState::Failed: ++stats_.failed; break;
+            case AssetState::Unknown: break;
+            }
+        }
+    }
+
+    // ==========================================
+    // CACHE
+    // ==========================================
+
+    void AssetManager::release(AssetId id) {
+        if (findRecord(id)) releaseIndex(id.index);
+    }
+
+    bool AssetManager::cancel(AssetId id) {
+        if (!findRecord(id)) return false;
+        releaseIndex(id.index);
+
+        Record& record = records_[id.index];
+        if (record.references > 0 || record.pins > 0 || record.state != AssetState::Queued) return false;
+        {
+            std::lock_guard lock(queue_mutex_);
+            auto it = queue_entries_.find(id.index);
+            // Already on a loader thread; let it finish into the cache
+            if (it == queue_entries_.end() || it->second.claimed) return false;
+            queue_entries_.erase(it);  // Its queue slots are skipped when popped
+        }
+
+        lookup_.erase(makeLookupKey(record.type, record.path));
+        record.state = AssetState::Unknown;
+        ++record.generation;
+        free_records_.push_back(id.index);
+        ++cache_stats_.cancelled;
+        return true;
+    }
+
+    void AssetManager::releaseIndex(uint32_t index) {
+        Record& record = records_[index];
+        if (record.references > 0) --record.references;
+        dropFailed(index);
+    }
+
+    void AssetManager::dropFailed(uint32_t index) {
+        Record& record = records_[index];
+        // Failures aren't cached: once nobody holds one, the next request loads it again
+        if (record.state != AssetState::Failed || record.references > 0 || record.pins > 0 || record.reload_batch != NO_BATCH) return;
+
+        lookup_.erase(makeLookupKey(record.type, record.path));
+        record.state = AssetState::Unknown;
+        ++record.generation;
+        free_records_.push_back(index);
+
+        const std::vector<AssetId> dependencies = std::move(record.dependencies);
+        record.dependencies.clear();
+        for (const AssetId dependency : dependencies) {
+            if (findRecord(dependency)) releaseIndex(dependency.index);
+        }
+    }
+
+    bool AssetManager::pin(AssetId id) {
+        if (!findRecord(id)) return false;
+        ++records_[id.index].pins;
+        return true;
+    }
+
+    void AssetManager::unpin(AssetId id) {
+        if (!findRecord(id) || records_[id.index].pins == 0) return;
+        --records_[id.index].pins;
+        dropFailed(id.index);
+    }
+
+    void AssetManager::touch(uint32_t index) {
+        Record& record = records_[index];
+        if (record.list == CacheList::None) {
+            // Still loading; a second request already makes it frequent
+            record.frequent = true;
+            return;
+        }
+        unlinkResident(index);
+        linkResident(index, CacheList::Frequent);
+    }
+
+    void AssetManager::linkResident(uint32_t index, CacheList list) {
+        Record& record = records_[index];
+        ResidentList& resident = getList(list);
+        record.list = list;
+        record.prev = NO_RECORD;
+        record.next = resident.head;
+        if (resident.head != NO_RECORD) records_[resident.head].prev = index;
+        resident.head = index;
+        if (resident.tail == NO_RECORD) resident.tail = index;
+        resident.bytes += record.bytes;
+
+        if (record.type >= type_stats_.size()) type_stats_.resize(record.type + 1);
+        ++type_stats_[record.type].resident;
+        type_stats_[record.type].resident_bytes += record.bytes;
+        cache_stats_.resident_bytes += record.bytes;
+    }
+
+    void AssetManager::unlinkResident(uint32_t index) {
+        Record& record = records_[index];
+        ResidentList& resident = getList(record.list);
+        if (record.prev != NO_RECORD) records_[record.prev].next = record.next;
+        else resident.head = record.next;
+        if (record.next != NO_RECORD) records_[record.next].prev = record.prev;
+        else resident.tail = record.prev;
+        resident.bytes -= record.bytes;
+
+        --type_stats_[record.type].resident;
+        type_stats_[record.type].resident_bytes -= record.bytes;
+        cache_stats_.resident_bytes -= record.bytes;
+
+        record.list = CacheList::None;
+        record.prev = NO_RECORD;
+        record.next = NO_RECORD;
+    }
+
+    bool AssetManager::consumeGhost(const std::string& key) {
+        auto found = ghost_lookup_.find(key);
+        if (found == ghost_lookup_.end()) return false;
+
+        const auto [list, entry] = found->second;
+        const size_t bytes = entry->bytes;
+
+        // A miss the recent list would have caught means it deserves more of
+        // the budget, and the other way round; the smaller ghost list moves
+        // the target faster
+        if (list == CacheList::Recent) {
+            const size_t ratio = std::max<size_t>(1, frequent_ghosts_.bytes / std::max<size_t>(recent_ghosts_.bytes, 1));
+            recent_target_ = std::min(budget_bytes_, recent_target_ + bytes * ratio);
+        }
+        else {
+            const size_t ratio = std::max<size_t>(1, recent_ghosts_.bytes / std::max<size_t>(frequent_ghosts_.bytes, 1));
+            const size_t delta = bytes * ratio;
+            recent_target_ = recent_target_ > delta ? recent_target_ - delta : 0;
+        }
+
+        GhostList& ghosts = getGhosts(list);
+        ghosts.bytes -= bytes;
+        ghosts.entries.erase(entry);
+        ghost_lookup_.erase(found);
+        ++cache_stats_.ghost_hits;
+        return true;
+    }
+
+    uint32_t AssetManager::findVictim(CacheList list) const noexcept {
+        const ResidentList& resident = list == CacheList::Recent ? recent_ : frequent_;
+        for (uint32_t index = resident.tail; index != NO_RECORD; index = records_[index].prev) {
+            const Record& record = records_[index];
+            if (record.references == 0 && record.pins == 0 && record.reload_batch == NO_BATCH) return index;
+        }
+        return NO_RECORD;
+    }
+
+    void AssetManager::enforceBudget() {
+        if (budget_bytes_ == 0) return;
+
+        while (cache_stats_.resident_bytes > budget_bytes_) {
+            // Shrink the recent list while it holds more than its target share
+            const bool prefer_recent = recent_.bytes > recent_target_;
+            uint32_t victim = findVictim(prefer_recent ? CacheList::Recent : CacheList::Frequent);
+            if (victim == NO_RECORD) {
+                victim = findVictim(prefer_recent ? CacheList::Frequent : CacheList::Recent);
+            }
+            if (victim == NO_RECORD) break;  // Everything resident is referenced or pinned
+            evict(victim);
+        }
+        trimGhosts();
+    }
+
+    void AssetManager::evict(uint32_t index) {
+        Record& record = records_[index];
+        const CacheList list = record.list;
+        unlinkResident(index);
+
+        std::string key = makeLookupKey(record.type, record.path);
+        lookup_.erase(key);
+
+        GhostList& ghosts = getGhosts(list);
+        const size_t ghost_bytes = std::max<size_t>(record.bytes, 1);
+        ghosts.entries.push_front({ key, ghost_bytes });
+        ghosts.bytes += ghost_bytes;
+        ghost_lookup_[std::move(key)] = { list, ghosts.entries.begin() };
+
+        ++cache_stats_.evictions;
+        cache_stats_.evicted_bytes += record.bytes;
+        ++type_stats_[record.type].evictions;
+
+        const std::vector<AssetId> dependencies = std::move(record.dependencies);
+        record.dependencies.clear();
+        record.data.reset();
+        record.state = AssetState::Unknown;
+        record.bytes = 0;
+        ++record.generation;
+        free_records_.push_back(index);
+
+        // Dependencies only kept alive by this asset become evictable too
+        for (const AssetId dependency : dependencies) {
+            if (findRecord(dependency)) releaseIndex(dependency.index);
+        }
+    }
+
+    void AssetManager::trimGhosts() {
+        auto dropOldest = [this](GhostList& ghosts) {
+            const Ghost& oldest = ghosts.entries.back();
+            ghosts.bytes -= oldest.bytes;
+            ghost_lookup_.erase(oldest.key);
+            ghosts.entries.pop_back();
+        };
+
+        // ARC's bounds: recent plus its ghosts within the budget, everything within twice the budget
+        while (!recent_ghosts_.entries.empty() && recent_.bytes + recent_ghosts_.bytes > budget_bytes_) {
+            dropOldest(recent_ghosts_);
+        }
+        while (!frequent_ghosts_.entries.empty() &&
+            cache_stats_.resident_bytes + recent_ghosts_.bytes + frequent_ghosts_.bytes > 2 * budget_bytes_) {
+            dropOldest(frequent_ghosts_);
+        }
+    }
+
+    // ==========================================
+    // HOT RELOAD
+    // ==========================================
+
+    uint32_t AssetManager::reload(std::string_view path) {
+        const std::string target = normalizeAssetPath(path);
+        std::vector<uint32_t> roots;
+        for (uint32_t index = 0; index < records_.size(); ++index) {
+            const Record& record = records_[index];
+            if ((record.state == AssetState::Ready || record.state == AssetState::Failed) &&
+                normalizeAssetPath(record.path) == target) {
+                roots.push_back(index);
+            }
+        }
+        return scheduleReload(std::move(roots));
+    }
+
+    uint32_t AssetManager::reloadAll() {
+        std::vector<uint32_t> roots;
+        for (uint32_t index = 0; index < records_.size(); ++index) {
+            const AssetState state = records_[index].state;
+            if (state == AssetState::Ready || state == AssetState::Failed) roots.push_back(index);
+        }
+        return scheduleReload(std::move(roots));
+    }
+
+    uint32_t AssetManager::scheduleReload(std::vector<uint32_t> roots) {
+        // Who depends on whom; ready and failed assets hold resolved dependency
+        // lists, so an asset failed by a broken dependency is retried with it
+        std::vector<std::vector<uint32_t>> dependents(records_.size());
+        for (uint32_t index = 0; index < records_.size(); ++index) {
+            const AssetState state = records_[index].state;
+            if (state != AssetState::Ready && state != AssetState::Failed) continue;
+            for (const AssetId dependency : records_[index].dependencies) {
+                dependents[dependency.index].push_back(index);
+            }
+        }
+
+        // Everything built on a changed asset may hold pointers into it, so it is re-imported too
+        std::vector<uint32_t> members;
+        std::vector<bool> seen(records_.size(), false);
+        while (!roots.empty()) {
+            const uint32_t index = roots.back();
+            roots.pop_back();
+            if (seen[index] || records_[index].reload_batch != NO_BATCH) continue;
+            seen[index] = true;
+            members.push_back(index);
+            roots.insert(roots.end(), dependents[index].begin(), dependents[index].end());
+        }
+        if (members.empty()) return 0;
+
+        const uint32_t batch_id = next_reload_batch_++;
+        ReloadBatch& batch = reload_batches_[batch_id];
+        batch.members = members;
+        batch.outstanding = static_cast<uint32_t>(members.size());
+
+        for (const uint32_t index : members) {
+            Record& record = records_[index];
+            record.reload_batch = batch_id;
+            record.reload_loaded = false;
+            enqueue(index, true);
+        }
+
+        print_i("Hot reload scheduled", LogContext{
+            {"asset", records_[members.front()].path},
+            {"count", members.size()}
+            });
+        return static_cast<uint32_t>(members.size());
+    }
+
+    void AssetManager::stageReload(CompletedLoad& completed) {
+        const uint32_t index = completed.index;
+        if (records_[index].generation != completed.generation || records_[index].reload_batch == NO_BATCH) return;
+
+        auto batch = reload_batches_.find(records_[index].reload_batch);
+        if (batch == reload_batches_.end()) return;
+        --batch->second.outstanding;
+        records_[index].reload_loaded = true;
+
+        if (!completed.result) {
+            print_w("Hot reload failed, keeping the previous version", LogContext{
+                {"path", records_[index].path},
+                {"error", static_cast<int>(completed.result.error())}
+                });
+            return;
+        }
+        records_[index].staged = std::move(*completed.result);
+
+        // The new version may name new dependencies; they load like any request
+        for (const auto& dependency : completed.dependencies) {
+            const AssetId id = request(dependency.type, dependency.path, records_[index].priority);
+            records_[index].staged_dependencies.push_back(id);
+            if (id.index == index || dependsOn(id.index, index)) {
+                print_e("Asset dependency cycle", LogContext{
+                    {"asset", records_[index].path},
+                    {"dependency", dependency.path}
+                    });
+                dropStaged(index);
+                return;
+            }
+        }
+    }
+
+    void AssetManager::dropStaged(uint32_t index) {
+        Record& record = records_[index];
+        record.staged.reset();
+        const std::vector<AssetId> dependencies = std::move(record.staged_dependencies);
+        record.staged_dependencies.clear();
+        for (const AssetId dependency : dependencies) {
+            if (findRecord(dependency)) releaseIndex(dependency.index);
+        }
+    }
+
+    void AssetManager::commitReloads() {
+        std::vector<uint32_t> committed;
+        for (auto& [batch_id, batch] : reload_batches_) {
+            if (batch.outstanding > 0) continue;
+
+            // Dependencies outside the batch must have settled too
+            bool settled = true;
+            for (const uint32_t index : batch.members) {
+                for (const AssetId dependency : records_[index].staged_dependencies) {
+                    const Record& target = records_[dependency.index];
+                    if (target.reload_batch != batch_id && target.state != AssetState::Ready && target.state != AssetState::Failed) {
+                        settled = false;
+                    }
+                }
+            }
+            if (!settled) continue;
+
+            commitBatch(batch);
+            committed.push_back(batch_id);
+        }
+        for (const uint32_t batch_id : committed) {
+            reload_batches_.erase(batch_id);
+        }
+    }
+
+    void AssetManager::commitBatch(ReloadBatch& batch) {
+        const uint32_t batch_id = records_[batch.members.front()].reload_batch;
+
+        // Dependencies first, so dependents finalize against the new versions
+        std::vector<uint32_t> order;
+        std::vector<uint8_t> visited(records_.size(), 0);
+        auto visit = [&](auto& self, uint32_t index) -> void {
+            if (visited[index]) return;
+            visited[index] = 1;
+            for (const AssetId dependency : records_[index].staged_dependencies) {
+                if (records_[dependency.index].reload_batch == batch_id) self(self, dependency.index);
+            }
+            order.push_back(index);
+        };
+        for (const uint32_t index : batch.members) visit(visit, index);
+
+        // Old versions die only after every swap, in case a dependent still points into one
+        std::vector<std::shared_ptr<void>> retired;
+        uint32_t swapped = 0;
+        uint32_t failed = 0;
+
+        for (const uint32_t index : order) {
+            Record& record = records_[index];
+            record.reload_batch = NO_BATCH;
+            if (!record.staged) {
+                failed += record.reload_loaded ? 1 : 0;
+                continue;
+            }
+
+            bool ok = true;
+            for (const AssetId dependency : record.staged_dependencies) {
+                ok &= records_[dependency.index].state == AssetState::Ready;
+            }
+
+            std::shared_ptr<void> previous = std::move(record.data);
+            record.data = std::move(record.staged);
+            if (ok) {
+                try {
+                    ok = type_loaders_[record.type]->finalize(record.data.get()).has_value();
+                }
+                catch (const std::exception& e) {
+                    print_e("Exception while finalizing asset", LogContext{
+                        {"path", record.path},
+                        {"what", std::string(e.what())}
+                        });
+                    ok = false;
+                }
+            }
+
+            if (!ok) {
+                print_w("Hot reload rejected, keeping the previous version", LogContext{ {"path", record.path} });
+                retired.push_back(std::move(record.data));
+                record.data = std::move(previous);
+                dropStaged(index);
+                ++failed;
+                continue;
+            }
+
+            retired.push_back(std::move(previous));
+            std::vector<AssetId> old_dependencies = std::move(record.dependencies);
+            record.dependencies = std::move(record.staged_dependencies);
+            record.staged_dependencies.clear();
+            for (const AssetId dependency : old_dependencies) {
+                if (findRecord(dependency)) releaseIndex(dependency.index);
+            }
+
+            // Re-charge the cache; a previously failed asset becomes resident now
+            const CacheList list = record.list == CacheList::None ? CacheList::Recent : record.list;
+            if (record.list != CacheList::None) unlinkResident(index);
+            record.bytes = type_loaders_[record.type]->getMemorySize(record.data.get());
+            record.state = AssetState::Ready;
+            record.error = AssetError::None;
+            linkResident(index, list);
+            ++swapped;
+        }
+
+        // Still failed and no longer referenced while the reload ran
+        for (const uint32_t index : order) dropFailed(index);
+
+        reloads_committed_ += swapped;
+        print_i("Hot reload committed", LogContext{
+            {"swapped", swapped},
+            {"failed", failed}
+            });
+    }
+
+} // namespace AshCore
@@ -0,0 +1,502 @@
+#pragma once
+
+#include "Engine/AshbornEngine.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    class AssetPack;
+    class JobSystem;
+
+    // ==========================================
+    // IDENTIFIERS
+    // ==========================================
+
+    using AssetTypeId = uint32_t;
+
+    namespace detail {
+        inline AssetTypeId nextAssetTypeId() noexcept {
+            static std::atomic<AssetTypeId> next{ 0 };
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Dense per-type id, assigned on first use
+    template<typename T>
+    [[nodiscard]] AssetTypeId getAssetTypeId() noexcept {
+        static const AssetTypeId id = detail::nextAssetTypeId();
+        return id;
+    }
+
+    // Generational slot id; stale ids never alias a newer asset
+    struct AssetId {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        [[nodiscard]] bool isValid() const noexcept { return index != UINT32_MAX; }
+        bool operator==(const AssetId&) const = default;
+    };
+
+    template<typename T>
+    struct AssetHandle {
+        AssetId id;
+
+        [[nodiscard]] bool isValid() const noexcept { return id.isValid(); }
+        bool operator==(const AssetHandle&) const = default;
+    };
+
+    // Scheduling class; lower values are loaded and finalized first
+    enum class AssetPriority : uint8_t {
+        Blocking = 0,  // Someone waits on it this frame; ignores the finalize budget
+        Visible,       // Needed on screen soon
+        Prefetch,      // Speculative
+        Count
+    };
+
+    enum class AssetState : uint8_t {
+        Unknown = 0,          // Invalid or stale id
+        Queued,
+        Loading,              // On a loader thread
+        WaitingDependencies,  // Decoded, dependencies not ready yet
+        WaitingFinalize,      // Ready for main-thread finalization
+        Ready,
+        Failed
+    };
+
+    // ==========================================
+    // LOADERS
+    // ==========================================
+
+    // A directory of loose files or a mounted .ashpack; roots are searched in config order
+    struct AssetRoot {
+        std::filesystem::path path;
+        std::shared_ptr<const AssetPack> pack;
+    };
+
+    /**
+     * Handed to AssetLoader::load on a loader thread. Dependencies found
+     * while parsing (a material naming its textures) are declared here;
+     * the asset is finalized only after all of them are ready.
+     */
+    class AssetLoadContext {
+    public:
+        AssetLoadContext(std::string_view path, std::span<const AssetRoot> roots, bool validate = false)
+            : path_(path), roots_(roots), validate_(validate) {}
+
+        [[nodiscard]] const std::string& getPath() const noexcept { return path_; }
+
+        // Loose file for the path, empty if none or if a pack provides it first
+        [[nodiscard]] std::filesystem::path resolve() const;
+        [[nodiscard]] std::expected<std::vector<std::byte>, AssetError> readFile() const;
+
+        // Bytes straight from a pack mapping when stored uncompressed, valid for
+        // the manager's lifetime; nullopt means fall back to readFile()
+        [[nodiscard]] std::optional<std::span<const std::byte>> view() const;
+
+        template<typename T>
+        void addDependency(std::string_view path) { dependencies_.push_back({ getAssetTypeId<T>(), std::string(path) }); }
+
+    private:
+        friend class AssetManager;
+
+        struct Dependency {
+            AssetTypeId type;
+            std::string path;
+        };
+
+        // First root that has the path: a loose file, or a pack (file left empty)
+        struct Source {
+            std::filesystem::path file;
+            const AssetPack* pack = nullptr;
+        };
+        [[nodiscard]] std::optional<Source> findSource() const;
+
+        std::string path_;
+        std::span<const AssetRoot> roots_;
+        bool validate_ = false;
+        std::vector<Dependency> dependencies_;
+    };
+
+    // load() runs concurrently on loader threads; finalize() on the main thread
+    template<typename T>
+    class AssetLoader {
+    public:
+        virtual ~AssetLoader() = default;
+
+        [[nodiscard]] virtual std::expected<std::unique_ptr<T>, AssetError> load(AssetLoadContext& context) = 0;
+
+        // GPU uploads, linking to dependencies; keep it short, it counts against the frame budget
+        [[nodiscard]] virtual std::expected<void, AssetError> finalize(T& /*asset*/) { return {}; }
+
+        // CPU bytes the asset holds once finalized; charged against AssetConfig::cache_size_mb
+        [[nodiscard]] virtual size_t getMemorySize(const T& /*asset*/) const { return sizeof(T); }
+    };
+
+    // ==========================================
+    // ASSET MANAGER
+    // ==========================================
+
+    struct AssetStats {
+        uint32_t queued = 0;
+        uint32_t loading = 0;
+        uint32_t waiting_dependencies = 0;
+        uint32_t waiting_finalize = 0;
+        uint32_t ready = 0;
+        uint32_t failed = 0;
+
+        uint32_t reloading = 0;           // Re-imports not committed yet
+        uint64_t reloads_committed = 0;
+
+        uint32_t finalized_last_update = 0;
+        std::chrono::microseconds finalize_time_last_update{ 0 };
+    };
+
+    struct AssetCacheStats {
+        uint64_t hits = 0;                // Requests served by an existing record
+        uint64_t misses = 0;              // Requests that started a load
+        uint64_t ghost_hits = 0;          // Misses on recently evicted assets; these steer the policy
+        uint64_t evictions = 0;
+        uint64_t evicted_bytes = 0;
+        uint64_t cancelled = 0;           // Queued loads dropped by cancel() before they started
+
+        size_t budget_bytes = 0;          // 0 = unbounded
+        size_t resident_bytes = 0;
+        size_t recent_bytes = 0;          // Requested once since loaded
+        size_t frequent_bytes = 0;        // Requested again while resident
+        size_t recent_target_bytes = 0;   // Adaptive share of the budget for the recent list
+        size_t pinned_bytes = 0;
+        size_t recent_ghost_bytes = 0;    // Remembered evictions; bounded by the budget
+        size_t frequent_ghost_bytes = 0;  // Together with everything resident, by twice the budget
+    };
+
+    struct AssetTypeStats {
+        uint32_t resident = 0;
+        size_t resident_bytes = 0;
+        uint64_t evictions = 0;
+    };
+
+    /**
+     * @brief Asynchronous asset loading with priorities and dependencies
+     *
+     * Requests are deduplicated by (type, path) and queued per priority;
+     * loader threads (AssetConfig::loader_threads) always take the most
+     * urgent request next, and re-requesting at a higher priority promotes
+     * a queued load. Decoded assets come back to the main thread in
+     * update(), which registers the dependencies they declared and then
+     * finalizes assets whose dependencies are ready, most urgent first,
+     * within the configured frame budget. A failed dependency fails its
+     * dependents. Failures are not cached: a failed asset is freed once
+     * nothing references it, so the next request loads it again.
+     *
+     * Without async loading (or with zero loader threads) update() and
+     * wait() run the loads inline.
+     *
+     * Asset paths ending in .ashpack are mounted as packs (see AssetPack)
+     * and searched in config order alongside plain directories, so a loose
+     * directory listed first overrides packed content.
+     *
+     * Every load() takes a reference that release() gives back; assets also
+     * reference their dependencies. Resident assets are kept under
+     * cache_size_mb with ARC: a recent list for assets requested once and a
+     * frequent list for those requested again, plus ghost lists of what was
+     * evicted from each. Re-requesting a ghost shifts the recent list's
+     * share of the budget toward the list that lost it, so a sweep through
+     * new content cannot flush assets that keep being reused. Only
+     * unreferenced, unpinned assets are evicted; the budget can be exceeded
+     * while everything resident is in use. cancel() is release() for
+     * speculative requests: a load nobody else references that has not
+     * reached a loader thread yet is dropped instead of cached.
+     *
+     * reload() re-imports an asset and everything that depends on it on the
+     * loader threads while the old versions stay in use. The whole batch is
+     * committed inside one update(): dependencies are swapped and finalized
+     * before their dependents, and the old data is released only after the
+     * last swap, so callers never see a half-reloaded set. An asset whose
+     * re-import fails keeps its previous version. Reloading a failed asset
+     * also retries the assets its failure failed.
+     */
+    class AssetManager {
+    public:
+        explicit AssetManager(const AssetConfig& config);
+        ~AssetManager();
+
+        AssetManager(const AssetManager&) = delete;
+        AssetManager& operator=(const AssetManager&) = delete;
+
+        template<typename T>
+        void registerLoader(std::unique_ptr<AssetLoader<T>> loader) {
+            setLoader(getAssetTypeId<T>(), std::make_unique<TypedLoader<T>>(std::move(loader)));
+        }
+
+        // Takes a reference; release() it when done
+        template<typename T>
+        [[nodiscard]] AssetHandle<T> load(std::string_view path, AssetPriority priority = AssetPriority::Visible) {
+            return { request(getAssetTypeId<T>(), path, priority) };
+        }
+
+        // For callers that only know the type id (see AssetPrefetcher)
+        [[nodiscard]] AssetId load(AssetTypeId type, std::string_view path, AssetPriority priority = AssetPriority::Visible) {
+            return request(type, path, priority);
+        }
+
+        // Unreferenced assets stay cached until the budget needs their memory
+        void release(AssetId id);
+        template<typename T>
+        void release(AssetHandle<T> handle) { release(handle.id); }
+
+        // Releases the reference and drops the load if it is still queued and
+        // unreferenced; true if it was dropped
+        bool cancel(AssetId id);
+        template<typename T>
+        bool cancel(AssetHandle<T> handle) { return cancel(handle.id); }
+
+        // Pinned assets are never evicted, referenced or not
+        bool pin(AssetId id);
+        void unpin(AssetId id);
+
+        // Re-imports every loaded asset with this path, plus its dependents.
+        // Returns how many assets were scheduled.
+        uint32_t reload(std::string_view path);
+        uint32_t reloadAll();
+
+        // Null until the asset is Ready (or if the handle is stale)
+        template<typename T>
+        [[nodiscard]] T* get(AssetHandle<T> handle) const noexcept {
+            return static_cast<T*>(getData(handle.id, getAssetTypeId<T>()));
+        }
+
+        // Main thread, once per frame: collect loads, resolve dependencies, finalize within budget
+        void update();
+
+        // Blocks until the asset is Ready or Failed, helping with loads meanwhile
+        AssetState wait(AssetId id);
+        template<typename T>
+        [[nodiscard]] T* loadBlocking(std::string_view path) {
+            const AssetHandle<T> handle = load<T>(path, AssetPriority::Blocking);
+            wait(handle.id);
+            return get(handle);
+        }
+
+        [[nodiscard]] AssetState getState(AssetId id) const noexcept;
+        [[nodiscard]] AssetError getError(AssetId id) const noexcept;
+        [[nodiscard]] const std::string& getPath(AssetId id) const noexcept;
+        [[nodiscard]] std::span<const AssetId> getDependencies(AssetId id) const noexcept;
+
+        [[nodiscard]] const AssetStats& getStats() const noexcept { return stats_; }
+        [[nodiscard]] const AssetCacheStats& getCacheStats() const noexcept { return cache_stats_; }
+        [[nodiscard]] AssetTypeStats getTypeStats(AssetTypeId type) const noexcept;
+        template<typename T>
+        [[nodiscard]] AssetTypeStats getTypeStats() const noexcept { return getTypeStats(getAssetTypeId<T>()); }
+        [[nodiscard]] bool isAsync() const noexcept { return loaders_ != nullptr; }
+        [[nodiscard]] std::span<const AssetRoot> getRoots() const noexcept { return roots_; }
+
+    private:
+        // Type-erased loader
+        class ErasedLoader {
+        public:
+            virtual ~ErasedLoader() = default;
+            virtual std::expected<std::shared_ptr<void>, AssetError> load(AssetLoadContext& context) = 0;
+            virtual std::expected<void, AssetError> finalize(void* asset) = 0;
+            virtual size_t getMemorySize(const void* asset) const = 0;
+        };
+
+        template<typename T>
+        class TypedLoader final : public ErasedLoader {
+        public:
+            explicit TypedLoader(std::unique_ptr<AssetLoader<T>> loader) : loader_(std::move(loader)) {}
+
+            std::expected<std::shared_ptr<void>, AssetError> load(AssetLoadContext& context) override {
+                auto result = loader_->load(context);
+                if (!result) return std::unexpected(result.error());
+                return std::shared_ptr<void>(std::shared_ptr<T>(std::move(*result)));
+            }
+            std::expected<void, AssetError> finalize(void* asset) override { return loader_->finalize(*static_cast<T*>(asset)); }
+            size_t getMemorySize(const void* asset) const override { return loader_->getMemorySize(*static_cast<const T*>(asset)); }
+
+        private:
+            std::unique_ptr<AssetLoader<T>> loader_;
+        };
+
+        static constexpr uint32_t NO_RECORD = UINT32_MAX;
+        static constexpr uint32_t NO_BATCH = UINT32_MAX;
+
+        enum class CacheList : uint8_t {
+            None = 0,
+            Recent,
+            Frequent
+        };
+
+        struct Record {
+            AssetTypeId type = 0;
+            uint32_t generation = 0;
+            AssetState state = AssetState::Unknown;
+            AssetPriority priority = AssetPriority::Prefetch;
+            AssetError error = AssetError::None;
+            std::string path;
+            std::shared_ptr<void> data;
+            std::vector<AssetId> dependencies;
+            std::vector<AssetId> dependents;   // Waiting on this record
+            uint32_t pending_dependencies = 0;
+
+            // Cache bookkeeping
+            size_t bytes = 0;
+            uint32_t references = 0;
+            uint32_t pins = 0;
+            CacheList list = CacheList::None;
+            bool frequent = false;  // Goes straight to the frequent list once ready
+            uint32_t prev = NO_RECORD;
+            uint32_t next = NO_RECORD;
+
+            // Hot reload; staged data replaces data when the batch commits
+            uint32_t reload_batch = NO_BATCH;
+            bool reload_loaded = false;
+            std::shared_ptr<void> staged;
+            std::vector<AssetId> staged_dependencies;
+        };
+
+        struct ReloadBatch {
+            std::vector<uint32_t> members;
+            uint32_t outstanding = 0;  // Re-imports still on loader threads
+        };
+
+        // Intrusive list through Record::prev/next, most recently used at the head
+        struct ResidentList {
+            uint32_t head = NO_RECORD;
+            uint32_t tail = NO_RECORD;
+            size_t bytes = 0;
+        };
+
+        // Key and size of an evicted asset
+        struct Ghost {
+            std::string key;
+            size_t bytes;
+        };
+
+        struct GhostList {
+            std::list<Ghost> entries;  // Most recent at the front
+            size_t bytes = 0;
+        };
+
+        // Loader-side view of a request; only touched under queue_mutex_
+        struct QueuedLoad {
+            uint32_t index;
+            uint32_t generation;
+            AssetTypeId type;
+            AssetPriority priority;
+            std::string path;
+            bool reload;
+        };
+
+        struct CompletedLoad {
+            uint32_t index;
+            uint32_t generation;
+            bool reload;
+            std::expected<std::shared_ptr<void>, AssetError> result;
+            std::vector<AssetLoadContext::Dependency> dependencies;
+        };
+
+        struct QueueEntry {
+            uint32_t generation;
+            AssetPriority priority;
+            bool claimed;
+        };
+
+    private:
+        void setLoader(AssetTypeId type, std::unique_ptr<ErasedLoader> loader);
+        [[nodiscard]] AssetId request(AssetTypeId type, std::string_view path, AssetPriority priority);
+        [[nodiscard]] void* getData(AssetId id, AssetTypeId type) const noexcept;
+        [[nodiscard]] const Record* findRecord(AssetId id) const noexcept;
+
+        void enqueue(uint32_t index, bool reload = false);
+        void promote(uint32_t index, AssetPriority priority);
+        bool runOneLoad();  // Any thread; false if nothing was queued
+
+        void collectCompleted();
+        void resolveDependencies(uint32_t index, std::vector<AssetLoadContext::Dependency>& dependencies);
+        void finalizePending(bool unbounded);
+        void markReady(uint32_t index);
+        void fail(uint32_t index, AssetError error);
+        [[nodiscard]] bool dependsOn(uint32_t from, uint32_t target) const;
+        void updateStats();
+
+        // Cache
+        void releaseIndex(uint32_t index);
+        void dropFailed(uint32_t index);  // Frees a failed record nothing holds
+        void touch(uint32_t index);
+        void linkResident(uint32_t index, CacheList list);
+        void unlinkResident(uint32_t index);
+        [[nodiscard]] ResidentList& getList(CacheList list) noexcept { return list == CacheList::Recent ? recent_ : frequent_; }
+        [[nodiscard]] GhostList& getGhosts(CacheList list) noexcept { return list == CacheList::Recent ? recent_ghosts_ : frequent_ghosts_; }
+        [[nodiscard]] uint32_t findVictim(CacheList list) const noexcept;
+        void enforceBudget();
+        void evict(uint32_t index);
+        void trimGhosts();
+        bool consumeGhost(const std::string& key);
+
+        // Hot reload
+        uint32_t scheduleReload(std::vector<uint32_t> roots);
+        void stageReload(CompletedLoad& completed);
+        void commitReloads();
+        void commitBatch(ReloadBatch& batch);
+        void dropStaged(uint32_t index);
+
+    private:
+        std::vector<AssetRoot> roots_;
+        bool validate_ = false;
+        std::chrono::microseconds finalize_budget_;
+
+        // Main-thread state
+        std::vector<Record> records_;
+        std::unordered_map<std::string, uint32_t> lookup_;  // "type:path" -> record
+        std::vector<uint32_t> free_records_;
+        std::array<std::deque<uint32_t>, static_cast<size_t>(AssetPriority::Count)> finalize_queue_;
+        AssetStats stats_;
+
+        // ARC state
+        size_t budget_bytes_ = 0;
+        size_t recent_target_ = 0;
+        ResidentList recent_;
+        ResidentList frequent_;
+        GhostList recent_ghosts_;
+        GhostList frequent_ghosts_;
+        std::unordered_map<std::string, std::pair<CacheList, std::list<Ghost>::iterator>> ghost_lookup_;
+        std::vector<AssetTypeStats> type_stats_;
+        AssetCacheStats cache_stats_;
+
+        std::unordered_map<uint32_t, ReloadBatch> reload_batches_;
+        uint32_t next_reload_batch_ = 0;
+        uint64_t reloads_committed_ = 0;
+
+        // Loaders are registered up front and only read afterwards
+        std::vector<std::unique_ptr<ErasedLoader>> type_loaders_;
+
+        // Shared with loader threads
+        mutable std::mutex queue_mutex_;
+        std::condition_variable completed_signal_;
+        std::array<std::deque<QueuedLoad>, static_cast<size_t>(AssetPriority::Count)> load_queue_;
+        std::unordered_map<uint32_t, QueueEntry> queue_entries_;
+        std::vector<CompletedLoad> completed_;
+        std::vector<CompletedLoad> completed_swap_;
+        bool stopping_ = false;
+
+        std::unique_ptr<JobSystem> loaders_;  // Destroyed first
+    };
+
+} // namespace AshCore
@@ -0,0 +1,496 @@
+#include "ashbornpch.h"
+
+#include "AssetPack.h"
+#include "PackCompression.h"
+#include "Hash/Hash.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint32_t ENTRIES_PER_BUCKET = 4;
+        constexpr uint32_t MAX_SEED = 1u << 20;
+        constexpr uint32_t MAX_BUILD_ATTEMPTS = 8;
+
+        // splitmix64 finalizer; a seed change has to reshuffle every bit of the slot choice
+        uint64_t mix(uint64_t value) noexcept {
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9ull;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111ebull;
+            value ^= value >> 31;
+            return value;
+        }
+
+        uint32_t bucketOf(uint64_t hash, uint32_t bucket_count) noexcept {
+            return static_cast<uint32_t>(mix(hash) % bucket_count);
+        }
+
+        uint32_t slotOf(uint64_t hash, uint32_t seed, uint32_t slot_count) noexcept {
+            return static_cast<uint32_t>(mix(hash ^ ((seed + 1ull) * 0x9e3779b97f4a7c15ull)) % slot_count);
+        }
+
+        uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        uint64_t seedsSize(uint32_t bucket_count) noexcept {
+            return alignUp(uint64_t{ bucket_count } * sizeof(uint32_t), 8);
+        }
+
+        struct PerfectHash {
+            std::vector<uint32_t> seeds;
+            std::vector<uint32_t> slot_entry;  // Entry index per slot, UINT32_MAX if free
+        };
+
+        // Hash and displace: place the biggest buckets first, each with the
+        // first seed that sends all of its keys to free, distinct slots
+        std::optional<PerfectHash> buildPerfectHash(std::span<const uint64_t> hashes, uint32_t bucket_count, uint32_t slot_count) {
+            std::vector<std::vector<uint32_t>> buckets(bucket_count);
+            for (uint32_t i = 0; i < hashes.size(); ++i) {
+                buckets[bucketOf(hashes[i], bucket_count)].push_back(i);
+            }
+
+            std::vector<uint32_t> order(bucket_count);
+            for (uint32_t b = 0; b < bucket_count; ++b) order[b] = b;
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                return buckets[a].size() > buckets[b].size();
+                });
+
+            PerfectHash result;
+            result.seeds.assign(bucket_count, 0);
+            result.slot_entry.assign(slot_count, UINT32_MAX);
+
+            std::vector<uint32_t> candidate;
+            for (const uint32_t bucket : order) {
+                const auto& keys = buckets[bucket];
+                if (keys.empty()) break;
+
+                bool placed = false;
+                for (uint32_t seed = 0; seed < MAX_SEED && !placed; ++seed) {
+                    candidate.clear();
+                    placed = true;
+                    for (const uint32_t key : keys) {
+                        const uint32_t slot = slotOf(hashes[key], seed, slot_count);
+                        if (result.slot_entry[slot] != UINT32_MAX || std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) {
+                            placed = false;
+                            break;
+                        }
+                        candidate.push_back(slot);
+                    }
+                    if (placed) {
+                        result.seeds[bucket] = seed;
+                        for (size_t k = 0; k < keys.size(); ++k) {
+                            result.slot_entry[candidate[k]] = keys[k];
+                        }
+                    }
+                }
+                if (!placed) return std::nullopt;
+            }
+            return result;
+        }
+    }
+
+    // ==========================================
+    // PATHS
+    // ==========================================
+
+    std::string normalizeAssetPath(std::string_view path) {
+        std::string normalized(path);
+        std::replace(normalized.begin(), normalized.end(), '\\', '/');
+        while (normalized.starts_with("./")) {
+            normalized.erase(0, 2);
+        }
+        return normalized;
+    }
+
+    uint64_t hashAssetPath(std::string_view normalized_path) noexcept {
+        return hash64(normalized_path);
+    }
+
+    uint64_t hashAssetContent(std::span<const std::byte> data) noexcept {
+        return hash64(data);
+    }
+
+    // ==========================================
+    // READER
+    // ==========================================
+
+    std::expected<std::unique_ptr<AssetPack>, AssetError> AssetPack::open(const std::filesystem::path& file) {
+        auto mapping = MappedFile::open(file);
+        if (!mapping) {
+            return std::unexpected(AssetError::PathNotFound);
+        }
+
+        AssetPackHeader header{};
+        if (mapping->getSize() < sizeof(header)) {
+            print_e("Asset pack truncated", LogContext{ {"path", file.string()} });
+            return std::unexpected(AssetError::CorruptedAsset);
+        }
+        std::memcpy(&header, mapping->getData().data(), sizeof(header));
+
+        if (header.magic != ASSET_PACK_MAGIC || header.version != ASSET_PACK_VERSION) {
+            print_e("Not an asset pack or unsupported version", LogContext{
+                {"path", file.string()},
+                {"version", header.version}
+                });
+            return std::unexpected(AssetError::CorruptedAsset);
+        }
+
+        std::unique_ptr<AssetPack> pack(new AssetPack(std::move(*mapping), file, header));
+        if (!pack->validateLayout()) {
+            print_e("Asset pack layout is corrupt", LogContext{ {"path", file.string()} });
+            return std::unexpected(AssetError::CorruptedAsset);
+        }
+
+        print_d("Asset pack opened", LogContext{
+            {"path", file.string()},
+            {"entries", header.entry_count},
+            {"size_mb", header.file_size / (1024 * 1024)}
+            });
+        return pack;
+    }
+
+    bool AssetPack::validateLayout() const {
+        const uint64_t file_size = file_.getSize();
+        const AssetPackHeader& h = header_;
+
+        if (h.file_size != file_size || h.slot_count < h.entry_count ||
+            (h.entry_count > 0 && (h.bucket_count == 0 || h.slot_count == 0))) {
+            return false;
+        }
+        if (h.slots_offset != sizeof(AssetPackHeader) + seedsSize(h.bucket_count) ||
+            h.slots_offset + uint64_t{ h.slot_count } * sizeof(AssetPackEntry) > h.strings_offset ||
+            h.strings_offset + h.strings_size > file_size) {
+            return false;
+        }
+
+        // Checked once here so lookups can trust the table
+        uint32_t used = 0;
+        for (uint32_t slot = 0; slot < h.slot_count; ++slot) {
+            const AssetPackEntry entry = readSlot(slot);
+            if (!(entry.flags & ASSET_PACK_ENTRY_USED)) continue;
+            ++used;
+            if (entry.offset > file_size || entry.stored_size > file_size - entry.offset ||
+                entry.path_offset >= h.strings_size) {
+                return false;
+            }
+            if (!(entry.flags & ASSET_PACK_ENTRY_LZ4) && entry.stored_size != entry.size) {
+                return false;
+            }
+            // LZ4 expands at most 255x, so a larger size is corrupt and must not size an allocation
+            if ((entry.flags & ASSET_PACK_ENTRY_LZ4) && entry.size > entry.stored_size * 255) {
+                return false;
+            }
+        }
+
+        // The string table must end in a terminator so entryPath() never runs off it
+        const auto strings = file_.getData().subspan(h.strings_offset, h.strings_size);
+        return used == h.entry_count && (strings.empty() || strings.back() == std::byte{ 0 });
+    }
+
+    AssetPackEntry AssetPack::readSlot(uint32_t slot) const noexcept {
+        AssetPackEntry entry{};
+        std::memcpy(&entry, file_.getData().data() + header_.slots_offset + uint64_t{ slot } * sizeof(AssetPackEntry), sizeof(entry));
+        return entry;
+    }
+
+    std::string_view AssetPack::entryPath(const AssetPackEntry& entry) const noexcept {
+        return reinterpret_cast<const char*>(file_.getData().data() + header_.strings_offset + entry.path_offset);
+    }
+
+    std::span<const std::byte> AssetPack::entryData(const AssetPackEntry& entry) const noexcept {
+        return file_.getData().subspan(entry.offset, entry.stored_size);
+    }
+
+    std::optional<AssetPackEntry> AssetPack::lookup(std::string_view path) const {
+        if (header_.entry_count == 0) return std::nullopt;
+
+        const std::string normalized = normalizeAssetPath(path);
+        const uint64_t hash = hashAssetPath(normalized);
+
+        uint32_t seed = 0;
+        const uint32_t bucket = bucketOf(hash, header_.bucket_count);
+        std::memcpy(&seed, file_.getData().data() + sizeof(AssetPackHeader) + uint64_t{ bucket } * sizeof(uint32_t), sizeof(seed));
+
+        // Every key maps to exactly one slot; a path that was never packed
+        // lands on some other entry's slot, which the path compare rejects
+        const AssetPackEntry entry = readSlot(slotOf(hash, seed, header_.slot_count));
+        if (!(entry.flags & ASSET_PACK_ENTRY_USED) || entry.path_hash != hash || entryPath(entry) != normalized) {
+            return std::nullopt;
+        }
+        return entry;
+    }
+
+    std::optional<AssetPack::EntryInfo> AssetPack::find(std::string_view path) const {
+        const auto entry = lookup(path);
+        if (!entry) return std::nullopt;
+        return EntryInfo{ entryPath(*entry), entry->size, entry->stored_size, (entry->flags & ASSET_PACK_ENTRY_LZ4) != 0 };
+    }
+
+    std::optional<std::span<const std::byte>> AssetPack::view(std::string_view path, bool validate) const {
+        const auto entry = lookup(path);
+        if (!entry || (entry->flags & ASSET_PACK_ENTRY_LZ4)) return std::nullopt;
+
+        const auto data = entryData(*entry);
+        if (validate && hashAssetContent(data) != entry->content_hash) {
+            print_e("Asset pack entry checksum mismatch", LogContext{ {"pack", path_.string()}, {"path", std::string(path)} });
+            return std::nullopt;
+        }
+        return data;
+    }
+
+    std::expected<std::vector<std::byte>, AssetError> AssetPack::read(std::string_view path, bool validate) const {
+        const auto entry = lookup(path);
+        if (!entry) {
+            return std::unexpected(AssetError::PathNotFound);
+        }
+
+        const auto stored = entryData(*entry);
+        std::vector<std::byte> bytes;
+        if (entry->flags & ASSET_PACK_ENTRY_LZ4) {
+            bytes.resize(entry->size);
+            if (!lz4Decompress(stored, bytes)) {
+                print_e("Asset pack entry failed to decompress", LogContext{ {"pack", path_.string()}, {"path", std::string(path)} });
+                return std::unexpected(AssetError::CorruptedAsset);
+            }
+        }
+        else {
+            bytes.assign(stored.begin(), stored.end());
+        }
+
+        if (validate && hashAssetContent(bytes) != entry->content_hash) {
+            print_e("Asset pack entry checksum mismatch", LogContext{ {"pack", path_.string()}, {"path", std::string(path)} });
+            return std::unexpected(AssetError::CorruptedAsset);
+        }
+        return bytes;
+    }
+
+    std::vector<AssetPack::EntryInfo> AssetPack::getEntries() const {
+        std::vector<EntryInfo> entries;
+        entries.reserve(header_.entry_count);
+        for (uint32_t slot = 0; slot < header_.slot_count; ++slot) {
+            const AssetPackEntry entry = readSlot(slot);
+            if (!(entry.flags & ASSET_PACK_ENTRY_USED)) continue;
+            entries.push_back({ entryPath(entry), entry.size, entry.stored_size, (entry.flags & ASSET_PACK_ENTRY_LZ4) != 0 });
+        }
+        return entries;
+    }
+
+    // ==========================================
+    // WRITER
+    // ==========================================
+
+    AssetPackWriter::AssetPackWriter(const AssetPackWriteOptions& options)
+        : options_(options) {
+        options_.alignment = std::max(options_.alignment, 1u);
+    }
+
+    bool AssetPackWriter::add(std::string_view path, std::vector<std::byte> data) {
+        std::string normalized = normalizeAssetPath(path);
+        const uint64_t hash = hashAssetPath(normalized);
+
+        auto [it, inserted] = hashes_.try_emplace(hash, normalized);
+        if (!inserted) {
+            if (it->second == normalized) {
+                print_w("Duplicate path in asset pack", LogContext{ {"path", normalized} });
+            }
+            else {
+                // Two keys on one hash could never both be looked up
+                print_e("Asset path hash collision", LogContext{ {"path", normalized}, {"existing", it->second} });
+            }
+            return false;
+        }
+
+        entries_.push_back({ std::move(normalized), hash, std::move(data) });
+        return true;
+    }
+
+    std::expected<AssetPackWriteStats, AssetError> AssetPackWriter::write(const std::filesystem::path& file, JobSystem* jobs) const {
+        // Sort by path so the same inputs always produce the same bytes
+        std::vector<const Pending*> sorted;
+        sorted.reserve(entries_.size());
+        for (const Pending& pending : entries_) sorted.push_back(&pending);
+        std::sort(sorted.begin(), sorted.end(), [](const Pending* a, const Pending* b) { return a->path < b->path; });
+
+        const auto count = static_cast<uint32_t>(sorted.size());
+
+        auto forEachEntry = [&](auto&& body) {
+            if (jobs) {
+                jobs->parallelFor(count, 1, body);
+            }
+            else {
+                body(0, count);
+            }
+        };
+
+        // ---- Hash every entry, then point identical ones at the first copy (in path order)
+        std::vector<uint64_t> content_hashes(count);
+        forEachEntry([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) content_hashes[i] = hashAssetContent(sorted[i]->data);
+            });
+
+        constexpr uint32_t UNIQUE = UINT32_MAX;
+        std::vector<uint32_t> duplicate_of(count, UNIQUE);
+        std::unordered_map<uint64_t, std::vector<uint32_t>> by_content;
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto& data = sorted[i]->data;
+            auto& candidates = by_content[content_hashes[i]];
+            for (const uint32_t candidate : candidates) {
+                // A hash match alone is not trusted; the bytes decide
+                if (sorted[candidate]->data == data) {
+                    duplicate_of[i] = candidate;
+                    break;
+                }
+            }
+            if (duplicate_of[i] == UNIQUE) candidates.push_back(i);
+        }
+
+        // ---- Compress the unique entries
+        std::vector<std::vector<std::byte>> compressed(count);
+        forEachEntry([&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto& data = sorted[i]->data;
+                if (!options_.compress || data.empty() || duplicate_of[i] != UNIQUE) continue;
+
+                std::vector<std::byte> packed(lz4CompressBound(data.size()));
+                const size_t packed_size = lz4Compress(data, packed);
+                const auto limit = static_cast<size_t>(static_cast<double>(data.size()) * (1.0 - options_.min_savings));
+                if (packed_size > 0 && packed_size <= limit) {
+                    packed.resize(packed_size);
+                    compressed[i] = std::move(packed);
+                }
+            }
+            });
+
+        // ---- Perfect hash; grow the slot table until every bucket finds a seed
+        std::vector<uint64_t> hashes(count);
+        for (uint32_t i = 0; i < count; ++i) hashes[i] = sorted[i]->hash;
+
+        const uint32_t bucket_count = std::max(1u, (count + ENTRIES_PER_BUCKET - 1) / ENTRIES_PER_BUCKET);
+        uint32_t slot_count = std::max(1u, count + count / 8);
+        std::optional<PerfectHash> table;
+        for (uint32_t attempt = 0; attempt < MAX_BUILD_ATTEMPTS && !table; ++attempt) {
+            table = buildPerfectHash(hashes, bucket_count, slot_count);
+            if (!table) slot_count += std::max(1u, slot_count / 4);
+        }
+        if (!table) {
+            print_e("Failed to build asset pack hash table", LogContext{ {"entries", count} });
+            return std::unexpected(AssetError::Unknown);
+        }
+
+        // ---- Layout
+        AssetPackHeader header{};
+        header.magic = ASSET_PACK_MAGIC;
+        header.version = ASSET_PACK_VERSION;
+        header.alignment = options_.alignment;
+        header.entry_count = count;
+        header.bucket_count = bucket_count;
+        header.slot_count = slot_count;
+        header.slots_offset = sizeof(AssetPackHeader) + seedsSize(bucket_count);
+        header.strings_offset = header.slots_offset + uint64_t{ slot_count } * sizeof(AssetPackEntry);
+
+        std::vector<char> strings;
+        std::vector<AssetPackEntry> entries(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            entries[i].path_offset = static_cast<uint32_t>(strings.size());
+            strings.insert(strings.end(), sorted[i]->path.begin(), sorted[i]->path.end());
+            strings.push_back('\0');
+        }
+        header.strings_size = strings.size();
+
+        AssetPackWriteStats stats;
+        stats.entries = count;
+        uint64_t offset = alignUp(header.strings_offset + header.strings_size, options_.alignment);
+        uint64_t data_end = header.strings_offset + header.strings_size;
+        for (uint32_t i = 0; i < count; ++i) {
+            AssetPackEntry& entry = entries[i];
+            entry.path_hash = sorted[i]->hash;
+            entry.size = sorted[i]->data.size();
+            entry.content_hash = content_hashes[i];
+            stats.raw_bytes += entry.size;
+
+            if (duplicate_of[i] != UNIQUE) {
+                const AssetPackEntry& original = entries[duplicate_of[i]];
+                entry.offset = original.offset;
+                entry.stored_size = original.stored_size;
+                entry.flags = original.flags;
+                ++stats.deduplicated;
+                stats.deduplicated_bytes += entry.size;
+                continue;
+            }
+
+            const bool packed = !compressed[i].empty();
+            entry.offset = offset;
+            entry.stored_size = packed ? compressed[i].size() : entry.size;
+            entry.flags = ASSET_PACK_ENTRY_USED | (packed ? ASSET_PACK_ENTRY_LZ4 : 0u);
+
+            data_end = entry.offset + entry.stored_size;
+            offset = alignUp(data_end, options_.alignment);
+            stats.compressed += packed ? 1 : 0;
+            stats.stored_bytes += entry.stored_size;
+        }
+        // The last entry is not padded out
+        header.file_size = data_end;
+        stats.file_bytes = header.file_size;
+
+        std::vector<AssetPackEntry> slots(slot_count, AssetPackEntry{});
+        for (uint32_t slot = 0; slot < slot_count; ++slot) {
+            if (table->slot_entry[slot] != UINT32_MAX) slots[slot] = entries[table->slot_entry[slot]];
+        }
+
+        // ---- Write, then rename so a failed pack never replaces a good one
+        std::filesystem::path temp = file;
+        temp += ".tmp";
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                print_e("Failed to create asset pack", LogContext{ {"path", temp.string()} });
+                return std::unexpected(AssetError::PathNotFound);
+            }
+
+            auto writeBytes = [&](const void* data, size_t size) {
+                out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+            const std::vector<char> zeros(options_.alignment, 0);
+            auto padTo = [&](uint64_t target) {
+                uint64_t position = static_cast<uint64_t>(out.tellp());
+                while (position < target) {
+                    const auto chunk = static_cast<size_t>(std::min<uint64_t>(target - position, zeros.size()));
+                    writeBytes(zeros.data(), chunk);
+                    position += chunk;
+                }
+            };
+
+            writeBytes(&header, sizeof(header));
+            writeBytes(table->seeds.data(), table->seeds.size() * sizeof(uint32_t));
+            padTo(header.slots_offset);
+            writeBytes(slots.data(), slots.size() * sizeof(AssetPackEntry));
+            writeBytes(strings.data(), strings.size());
+
+            for (uint32_t i = 0; i < count; ++i) {
+                if (duplicate_of[i] != UNIQUE) continue;
+                padTo(entries[i].offset);
+                const auto& data = compressed[i].empty() ? sorted[i]->data : compressed[i];
+                writeBytes(data.data(), data.size());
+            }
+            if (!out) {
+                print_e("Failed to write asset pack", LogContext{ {"path", temp.string()} });
+                return std::unexpected(AssetError::Unknown);
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temp, file, error);
+        if (error) {
+            print_e("Failed to move asset pack into place", LogContext{ {"path", file.string()}, {"error", error.message()} });
+            return std::unexpected(AssetError::Unknown);
+        }
+        return stats;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Engine/EngineErrors.h"
+#include "Platform/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // PATHS
+    // ==========================================
+
+    // Pack keys use forward slashes and no leading "./"
+    [[nodiscard]] std::string normalizeAssetPath(std::string_view path);
+
+    // Hash of an already normalized path (hash64, so stable across builds and tools)
+    [[nodiscard]] uint64_t hashAssetPath(std::string_view normalized_path) noexcept;
+
+    // Stored per entry, checked on read when validation is on and used to
+    // find identical entries when writing
+    [[nodiscard]] uint64_t hashAssetContent(std::span<const std::byte> data) noexcept;
+
+    // ==========================================
+    // FILE FORMAT
+    // ==========================================
+
+    inline constexpr uint64_t ASSET_PACK_MAGIC = 0x004B434150485341ull;  // "ASHPACK\0"
+    inline constexpr uint32_t ASSET_PACK_VERSION = 2;
+
+    // Layout: header, bucket seeds (u32, padded to 8 bytes), slot table,
+    // path strings, then entry data at header.alignment boundaries.
+    struct AssetPackHeader {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t alignment;       // Of every entry's data offset
+        uint32_t entry_count;
+        uint32_t bucket_count;
+        uint32_t slot_count;      // >= entry_count; unused slots have no USED flag
+        uint32_t reserved;
+        uint64_t slots_offset;
+        uint64_t strings_offset;
+        uint64_t strings_size;
+        uint64_t file_size;
+    };
+    static_assert(sizeof(AssetPackHeader) == 64);
+
+    enum AssetPackEntryFlags : uint32_t {
+        ASSET_PACK_ENTRY_USED = 1u << 0,
+        ASSET_PACK_ENTRY_LZ4 = 1u << 1
+    };
+
+    struct AssetPackEntry {
+        uint64_t path_hash;
+        uint64_t offset;          // From the start of the file; entries with identical content share it
+        uint64_t stored_size;     // Bytes in the file
+        uint64_t size;            // Bytes after decompression
+        uint64_t content_hash;    // Of the uncompressed bytes
+        uint32_t flags;
+        uint32_t path_offset;     // Into the string table; strings are NUL terminated
+    };
+    static_assert(sizeof(AssetPackEntry) == 48);
+
+    // ==========================================
+    // READER
+    // ==========================================
+
+    /**
+     * @brief Read-only archive of assets, memory mapped
+     *
+     * Lookups go through a perfect hash (hash and displace): the path hash
+     * picks a bucket, the bucket's seed picks the one slot the path can be
+     * in, so every lookup reads exactly one slot. Uncompressed entries are
+     * handed out as views straight into the mapping; nothing is copied and
+     * only the touched pages are read from disk.
+     */
+    class AssetPack {
+    public:
+        struct EntryInfo {
+            std::string_view path;
+            uint64_t size = 0;
+            uint64_t stored_size = 0;
+            bool compressed = false;
+        };
+
+        [[nodiscard]] static std::expected<std::unique_ptr<AssetPack>, AssetError> open(const std::filesystem::path& file);
+
+        [[nodiscard]] bool contains(std::string_view path) const { return find(path).has_value(); }
+        [[nodiscard]] std::optional<EntryInfo> find(std::string_view path) const;
+
+        // Zero-copy; nullopt if missing, compressed or (when validating) corrupt.
+        // Valid as long as the pack.
+        [[nodiscard]] std::optional<std::span<const std::byte>> view(std::string_view path, bool validate = false) const;
+
+        // Decompresses if needed
+        [[nodiscard]] std::expected<std::vector<std::byte>, AssetError> read(std::string_view path, bool validate) const;
+
+        [[nodiscard]] std::vector<EntryInfo> getEntries() const;
+        [[nodiscard]] uint32_t getEntryCount() const noexcept { return header_.entry_count; }
+        [[nodiscard]] const std::filesystem::path& getFilePath() const noexcept { return path_; }
+
+    private:
+        AssetPack(MappedFile file, std::filesystem::path path, const AssetPackHeader& header)
+            : file_(std::move(file)), path_(std::move(path)), header_(header) {}
+
+        [[nodiscard]] std::optional<AssetPackEntry> lookup(std::string_view path) const;
+        [[nodiscard]] AssetPackEntry readSlot(uint32_t slot) const noexcept;
+        [[nodiscard]] std::string_view entryPath(const AssetPackEntry& entry) const noexcept;
+        [[nodiscard]] std::span<const std::byte> entryData(const AssetPackEntry& entry) const noexcept;
+        [[nodiscard]] bool validateLayout() const;
+
+    private:
+        MappedFile file_;
+        std::filesystem::path path_;
+        AssetPackHeader header_;
+    };
+
+    // ==========================================
+    // WRITER
+    // ==========================================
+
+    struct AssetPackWriteOptions {
+        bool compress = false;
+        float min_savings = 0.1f;   // Keep the LZ4 form only if it is at least this much smaller
+        uint32_t alignment = 4096;  // Page aligned so views can be handed to the GPU uploader directly
+    };
+
+    struct AssetPackWriteStats {
+        uint32_t entries = 0;
+        uint32_t compressed = 0;
+        uint32_t deduplicated = 0;      // Entries pointing at an earlier entry's data
+        uint64_t raw_bytes = 0;
+        uint64_t stored_bytes = 0;      // Data actually written, after dedup and compression
+        uint64_t deduplicated_bytes = 0;
+        uint64_t file_bytes = 0;
+    };
+
+    // Offline side, used by the AssetPacker tool. Output does not depend on add order.
+    class AssetPackWriter {
+    public:
+        explicit AssetPackWriter(const AssetPackWriteOptions& options = {});
+
+        // False if the path (or another path with the same hash) is already in
+        bool add(std::string_view path, std::vector<std::byte> data);
+
+        // jobs may be null for single-threaded compression
+        [[nodiscard]] std::expected<AssetPackWriteStats, AssetError> write(const std::filesystem::path& file, JobSystem* jobs) const;
+
+        [[nodiscard]] size_t getEntryCount() const noexcept { return entries_.size(); }
+
+    private:
+        struct Pending {
+            std::string path;
+            uint64_t hash = 0;
+            std::vector<std::byte> data;
+        };
+
+        AssetPackWriteOptions options_;
+        std::vector<Pending> entries_;
+        std::unordered_map<uint64_t, std::string> hashes_;
+    };
+
+} // namespace AshCore
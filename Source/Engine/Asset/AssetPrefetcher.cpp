@@ -0,0 +1,168 @@
+#include "ashbornpch.h"
+
+#include "AssetPrefetcher.h"
+
+#include <algorithm>
+
+namespace AshCore {
+
+    AssetPrefetcher::AssetPrefetcher(AssetManager& manager, const AssetPrefetchConfig& config)
+        : manager_(manager), config_(config) {
+    }
+
+    AssetPrefetcher::~AssetPrefetcher() {
+        for (auto& [coord, chunk] : chunks_) {
+            if (chunk.issued) withdraw(chunk, true);
+        }
+    }
+
+    // ==========================================
+    // REGISTRY
+    // ==========================================
+
+    void AssetPrefetcher::addAsset(std::unordered_map<uint32_t, std::vector<uint32_t>>& table, uint32_t key, AssetTypeId type,
+        std::string_view path) {
+
+        std::string lookup = std::to_string(type);
+        lookup += ':';
+        lookup += path;
+
+        auto [it, inserted] = asset_lookup_.try_emplace(std::move(lookup), static_cast<uint32_t>(assets_.size()));
+        if (inserted) {
+            assets_.push_back({ type, std::string(path), {}, 0 });
+            asset_marks_.push_back(0);
+        }
+
+        std::vector<uint32_t>& entries = table[key];
+        if (std::find(entries.begin(), entries.end(), it->second) == entries.end()) {
+            entries.push_back(it->second);
+        }
+    }
+
+    void AssetPrefetcher::collectAssets(const std::unordered_map<uint32_t, std::vector<uint32_t>>& table, std::span<const uint32_t> keys,
+        std::vector<uint32_t>& out) {
+
+        // Palettes repeat assets (every stone variant shares a sound), keep each once
+        for (const uint32_t key : keys) {
+            const auto it = table.find(key);
+            if (it == table.end()) continue;  // Nothing registered; not every block has assets of its own
+            for (const uint32_t asset : it->second) {
+                if (asset_marks_[asset]) continue;
+                asset_marks_[asset] = 1;
+                out.push_back(asset);
+            }
+        }
+    }
+
+    // ==========================================
+    // SCHEDULING
+    // ==========================================
+
+    void AssetPrefetcher::prefetchChunk(const ChunkPrefetchRequest& request) {
+        ChunkEntry entry;
+        collectAssets(block_assets_, request.block_palette, entry.assets);
+        collectAssets(entity_assets_, request.entity_types, entry.assets);
+        for (const uint32_t asset : entry.assets) asset_marks_[asset] = 0;
+
+        auto [it, inserted] = chunks_.try_emplace(request.chunk);
+        if (!inserted && it->second.issued) {
+            // Request the new set before letting go of the old one so shared
+            // assets are not cancelled and queued again
+            issue(entry);
+            withdraw(it->second, true);
+        }
+        it->second = std::move(entry);
+        stats_.chunks = static_cast<uint32_t>(chunks_.size());
+    }
+
+    void AssetPrefetcher::completeChunk(ChunkCoord chunk) {
+        remove(chunk, false);
+    }
+
+    void AssetPrefetcher::cancelChunk(ChunkCoord chunk) {
+        remove(chunk, true);
+    }
+
+    void AssetPrefetcher::remove(ChunkCoord chunk, bool cancel) {
+        auto it = chunks_.find(chunk);
+        if (it == chunks_.end()) return;
+        if (it->second.issued) withdraw(it->second, cancel);
+        chunks_.erase(it);
+        stats_.chunks = static_cast<uint32_t>(chunks_.size());
+    }
+
+    uint32_t AssetPrefetcher::issue(ChunkEntry& chunk) {
+        uint32_t started = 0;
+        for (const uint32_t index : chunk.assets) {
+            AssetEntry& asset = assets_[index];
+            if (asset.chunks++ > 0) continue;
+            asset.id = manager_.load(asset.type, asset.path, AssetPriority::Prefetch);
+            ++stats_.requests;
+            ++stats_.held_assets;
+            ++started;
+        }
+        chunk.issued = true;
+        ++stats_.issued_chunks;
+        return started;
+    }
+
+    void AssetPrefetcher::withdraw(ChunkEntry& chunk, bool cancel) {
+        for (const uint32_t index : chunk.assets) {
+            AssetEntry& asset = assets_[index];
+            if (--asset.chunks > 0) continue;
+            if (cancel) {
+                if (manager_.cancel(asset.id)) ++stats_.cancelled;
+            }
+            else {
+                manager_.release(asset.id);
+            }
+            asset.id = {};
+            --stats_.held_assets;
+        }
+        chunk.issued = false;
+        --stats_.issued_chunks;
+    }
+
+    void AssetPrefetcher::update(const std::array<float, 3>& player_position, const std::array<float, 3>& player_velocity) {
+        if (chunks_.empty()) return;
+
+        // Where the player will be once these chunks arrive; standing still
+        // this is just distance to the player
+        std::array<float, 3> predicted;
+        for (int axis = 0; axis < 3; ++axis) {
+            predicted[axis] = player_position[axis] + player_velocity[axis] * config_.look_ahead_seconds;
+        }
+
+        ranked_.clear();
+        for (auto it = chunks_.begin(); it != chunks_.end(); ++it) {
+            const ChunkCoord& coord = it->first;
+            const float center[3] = {
+                (static_cast<float>(coord.x) + 0.5f) * config_.chunk_size,
+                (static_cast<float>(coord.y) + 0.5f) * config_.chunk_size,
+                (static_cast<float>(coord.z) + 0.5f) * config_.chunk_size
+            };
+            float distance = 0.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                const float delta = center[axis] - predicted[axis];
+                distance += delta * delta;
+            }
+            it->second.score = distance;
+            ranked_.push_back(it);
+        }
+        std::sort(ranked_.begin(), ranked_.end(), [](const auto& a, const auto& b) { return a->second.score < b->second.score; });
+
+        // Give back unlikely chunks first so their queued loads never start
+        for (size_t rank = config_.max_chunks; rank < ranked_.size(); ++rank) {
+            if (ranked_[rank]->second.issued) withdraw(ranked_[rank]->second, true);
+        }
+
+        // The prefetch queue is FIFO, so issuing nearest first is loading nearest first
+        uint32_t started = 0;
+        const size_t likely = std::min<size_t>(config_.max_chunks, ranked_.size());
+        for (size_t rank = 0; rank < likely && started < config_.max_requests_per_update; ++rank) {
+            ChunkEntry& chunk = ranked_[rank]->second;
+            if (!chunk.issued) started += issue(chunk);
+        }
+    }
+
+} // namespace AshCore
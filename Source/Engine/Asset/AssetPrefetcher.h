@@ -0,0 +1,140 @@
+#pragma once
+
+#include "AssetManager.h"
+
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // REQUESTS
+    // ==========================================
+
+    struct ChunkCoord {
+        int32_t x = 0;
+        int32_t y = 0;
+        int32_t z = 0;
+
+        auto operator<=>(const ChunkCoord&) const = default;
+    };
+
+    // What the streaming scheduler knows about a chunk it has queued
+    struct ChunkPrefetchRequest {
+        ChunkCoord chunk;
+        std::span<const uint32_t> block_palette;  // Block ids in the chunk's palette
+        std::span<const uint32_t> entity_types;   // Entity types saved with the chunk
+    };
+
+    struct AssetPrefetchConfig {
+        uint32_t max_chunks = 64;                // Predicted chunks with requests in flight; the rest wait
+        uint32_t max_requests_per_update = 256;  // New loads issued per update()
+        float look_ahead_seconds = 1.5f;         // Chunks near where the player will be go first
+        float chunk_size = 32.0f;                // World units per chunk edge
+    };
+
+    struct AssetPrefetchStats {
+        uint32_t chunks = 0;             // Scheduled, not completed or cancelled yet
+        uint32_t issued_chunks = 0;      // ... whose assets have been requested
+        uint32_t held_assets = 0;        // Distinct assets referenced for them
+        uint64_t requests = 0;
+        uint64_t cancelled = 0;          // Loads dropped before they started
+    };
+
+    // ==========================================
+    // ASSET PREFETCHER
+    // ==========================================
+
+    /**
+     * @brief Requests the assets of chunks before they are meshed
+     *
+     * Block and entity types are mapped up front to the textures, models
+     * and sounds they need. When the streaming scheduler queues a chunk it
+     * hands over the chunk's palette, which is known long before meshing
+     * finishes, and the distinct assets behind those ids are requested at
+     * AssetPriority::Prefetch, so they only use loader time nothing more
+     * urgent wants and are resident by the time the chunk first renders.
+     *
+     * update() ranks the scheduled chunks by distance to the player's
+     * position extrapolated along its velocity. The nearest max_chunks
+     * have their assets requested, nearest first; a chunk that falls out
+     * of that set (the player turned around) gives its requests back with
+     * AssetManager::cancel(), which drops loads that have not started, and
+     * is requested again if it becomes likely later. Assets shared by many
+     * chunks are requested once and held while any of them needs it.
+     *
+     * Main thread only, like AssetManager.
+     */
+    class AssetPrefetcher {
+    public:
+        explicit AssetPrefetcher(AssetManager& manager, const AssetPrefetchConfig& config = {});
+        ~AssetPrefetcher();  // Cancels whatever is still held; destroy before the manager
+
+        AssetPrefetcher(const AssetPrefetcher&) = delete;
+        AssetPrefetcher& operator=(const AssetPrefetcher&) = delete;
+
+        template<typename T>
+        void addBlockAsset(uint32_t block, std::string_view path) { addAsset(block_assets_, block, getAssetTypeId<T>(), path); }
+        template<typename T>
+        void addEntityAsset(uint32_t entity_type, std::string_view path) { addAsset(entity_assets_, entity_type, getAssetTypeId<T>(), path); }
+
+        // Scheduling the same chunk again replaces its palette
+        void prefetchChunk(const ChunkPrefetchRequest& request);
+
+        // Loaded: whoever renders it holds its own references now, so in-flight
+        // loads keep going
+        void completeChunk(ChunkCoord chunk);
+        // Dropped from the schedule: loads nobody else wants are cancelled
+        void cancelChunk(ChunkCoord chunk);
+
+        // Once per frame, before AssetManager::update()
+        void update(const std::array<float, 3>& player_position, const std::array<float, 3>& player_velocity);
+
+        [[nodiscard]] const AssetPrefetchStats& getStats() const noexcept { return stats_; }
+
+    private:
+        struct AssetEntry {
+            AssetTypeId type;
+            std::string path;
+            AssetId id;           // Valid while chunks > 0
+            uint32_t chunks = 0;  // Issued chunks needing it
+        };
+
+        struct ChunkEntry {
+            std::vector<uint32_t> assets;  // Indices into assets_, distinct
+            bool issued = false;
+            float score = 0.0f;
+        };
+
+        void addAsset(std::unordered_map<uint32_t, std::vector<uint32_t>>& table, uint32_t key, AssetTypeId type, std::string_view path);
+        void collectAssets(const std::unordered_map<uint32_t, std::vector<uint32_t>>& table, std::span<const uint32_t> keys,
+            std::vector<uint32_t>& out);
+        // Returns how many loads were started
+        uint32_t issue(ChunkEntry& chunk);
+        void withdraw(ChunkEntry& chunk, bool cancel);
+        void remove(ChunkCoord chunk, bool cancel);
+
+    private:
+        AssetManager& manager_;
+        AssetPrefetchConfig config_;
+
+        std::vector<AssetEntry> assets_;
+        std::unordered_map<std::string, uint32_t> asset_lookup_;  // "type:path" -> assets_
+        std::unordered_map<uint32_t, std::vector<uint32_t>> block_assets_;
+        std::unordered_map<uint32_t, std::vector<uint32_t>> entity_assets_;
+        std::vector<uint32_t> asset_marks_;  // Scratch for deduplicating a palette
+
+        std::map<ChunkCoord, ChunkEntry> chunks_;
+        std::vector<std::map<ChunkCoord, ChunkEntry>::iterator> ranked_;
+
+        AssetPrefetchStats stats_;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,113 @@
+#include "ashbornpch.h"
+
+#include "CookedTexture.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint64_t DATA_ALIGNMENT = 16;
+
+        uint64_t alignUp(uint64_t value) noexcept {
+            return (value + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+        }
+
+        uint64_t expectedMipSize(const CookedTextureHeader& header, uint32_t mip) noexcept {
+            return uint64_t{ getMipExtent(header.width, mip) } * getMipExtent(header.height, mip) *
+                getTexelSize(header.format) * header.layer_count;
+        }
+
+        bool isValidHeader(const CookedTextureHeader& header) noexcept {
+            return header.magic == COOKED_TEXTURE_MAGIC && header.version == COOKED_TEXTURE_VERSION &&
+                header.width > 0 && header.height > 0 && header.layer_count > 0 && header.mip_count > 0 &&
+                header.mip_count <= getFullMipCount(header.width, header.height) &&
+                header.format <= CookedTextureFormat::RGBA8Srgb;
+        }
+
+        bool isValidRegion(const CookedTextureHeader& header, const CookedAtlasRegion& region) noexcept {
+            return region.layer < header.layer_count && region.x <= header.width && region.width <= header.width - region.x &&
+                region.y <= header.height && region.height <= header.height - region.y;
+        }
+    }
+
+    std::span<const std::byte> CookedTextureView::getLayer(uint32_t mip, uint32_t layer) const noexcept {
+        if (mip >= mips.size() || layer >= header.layer_count) return {};
+        const size_t layer_size = mips[mip].size() / header.layer_count;
+        return mips[mip].subspan(layer * layer_size, layer_size);
+    }
+
+    const CookedAtlasRegion* CookedTextureView::findRegion(uint64_t name_hash) const noexcept {
+        auto it = std::lower_bound(regions.begin(), regions.end(), name_hash,
+            [](const CookedAtlasRegion& region, uint64_t hash) { return region.name_hash < hash; });
+        return it != regions.end() && it->name_hash == name_hash ? &*it : nullptr;
+    }
+
+    std::optional<CookedTextureView> parseCookedTexture(std::span<const std::byte> data) {
+        CookedTextureView view;
+        if (data.size() < sizeof(CookedTextureHeader)) return std::nullopt;
+        std::memcpy(&view.header, data.data(), sizeof(CookedTextureHeader));
+        if (!isValidHeader(view.header)) return std::nullopt;
+
+        const uint64_t regions_offset = sizeof(CookedTextureHeader) + uint64_t{ view.header.mip_count } * sizeof(CookedMip);
+        const uint64_t table_end = regions_offset + uint64_t{ view.header.region_count } * sizeof(CookedAtlasRegion);
+        if (data.size() < table_end) return std::nullopt;
+
+        view.regions.resize(view.header.region_count);
+        if (!view.regions.empty()) {
+            std::memcpy(view.regions.data(), data.data() + regions_offset, view.regions.size() * sizeof(CookedAtlasRegion));
+        }
+        for (size_t i = 0; i < view.regions.size(); ++i) {
+            if (!isValidRegion(view.header, view.regions[i]) || (i > 0 && view.regions[i - 1].name_hash >= view.regions[i].name_hash)) {
+                return std::nullopt;
+            }
+        }
+
+        view.mips.reserve(view.header.mip_count);
+        for (uint32_t mip = 0; mip < view.header.mip_count; ++mip) {
+            CookedMip entry{};
+            std::memcpy(&entry, data.data() + sizeof(CookedTextureHeader) + mip * sizeof(CookedMip), sizeof(entry));
+            if (entry.size != expectedMipSize(view.header, mip) || entry.offset < table_end ||
+                entry.offset > data.size() || entry.size > data.size() - entry.offset) {
+                return std::nullopt;
+            }
+            view.mips.push_back(data.subspan(entry.offset, entry.size));
+        }
+        return view;
+    }
+
+    std::optional<std::vector<std::byte>> serializeCookedTexture(const CookedTextureHeader& header,
+        std::span<const std::vector<std::byte>> mips, std::span<const CookedAtlasRegion> regions) {
+        if (!isValidHeader(header) || mips.size() != header.mip_count || regions.size() != header.region_count) return std::nullopt;
+
+        std::vector<CookedAtlasRegion> sorted(regions.begin(), regions.end());
+        std::sort(sorted.begin(), sorted.end(), [](const CookedAtlasRegion& a, const CookedAtlasRegion& b) {
+            return a.name_hash < b.name_hash;
+            });
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            if (!isValidRegion(header, sorted[i]) || (i > 0 && sorted[i - 1].name_hash == sorted[i].name_hash)) return std::nullopt;
+        }
+
+        std::vector<CookedMip> table(header.mip_count);
+        const uint64_t regions_offset = sizeof(CookedTextureHeader) + table.size() * sizeof(CookedMip);
+        uint64_t offset = alignUp(regions_offset + sorted.size() * sizeof(CookedAtlasRegion));
+        for (uint32_t mip = 0; mip < header.mip_count; ++mip) {
+            if (mips[mip].size() != expectedMipSize(header, mip)) return std::nullopt;
+            table[mip] = { offset, mips[mip].size() };
+            offset = alignUp(offset + mips[mip].size());
+        }
+
+        std::vector<std::byte> out(table.back().offset + table.back().size);
+        std::memcpy(out.data(), &header, sizeof(header));
+        std::memcpy(out.data() + sizeof(header), table.data(), table.size() * sizeof(CookedMip));
+        if (!sorted.empty()) {
+            std::memcpy(out.data() + regions_offset, sorted.data(), sorted.size() * sizeof(CookedAtlasRegion));
+        }
+        for (uint32_t mip = 0; mip < header.mip_count; ++mip) {
+            std::memcpy(out.data() + table[mip].offset, mips[mip].data(), mips[mip].size());
+        }
+        return out;
+    }
+
+} // namespace AshCore
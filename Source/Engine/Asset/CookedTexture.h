@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // COOKED TEXTURE FORMAT (.ashtex)
+    // ==========================================
+
+    // Output of the AssetCooker tool: every mip already generated, in the
+    // layout the GPU samples, so loading is a read (or a pack view) plus
+    // an upload. Layout: header, mip table, atlas region table, then per
+    // mip all layers back to back, each tightly packed rows, at 16-byte
+    // aligned offsets.
+
+    inline constexpr uint32_t COOKED_TEXTURE_MAGIC = 0x58455441;  // "ATEX"
+    inline constexpr uint32_t COOKED_TEXTURE_VERSION = 2;
+
+    enum class CookedTextureFormat : uint8_t {
+        RGBA8Unorm = 0,
+        RGBA8Srgb
+    };
+
+    enum CookedTextureFlags : uint8_t {
+        COOKED_TEXTURE_PREMULTIPLIED = 1u << 0,
+        COOKED_TEXTURE_ARRAY = 1u << 1  // Layers are atlas pages; regions say where each image went
+    };
+
+    struct CookedTextureHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint16_t mip_count;
+        uint16_t layer_count;
+        CookedTextureFormat format;
+        uint8_t flags;
+        uint16_t region_count;
+        uint64_t cook_key;  // Hash of sources and settings it was cooked from
+    };
+    static_assert(sizeof(CookedTextureHeader) == 32);
+
+    struct CookedMip {
+        uint64_t offset;  // From the start of the file
+        uint64_t size;    // All layers
+    };
+    static_assert(sizeof(CookedMip) == 16);
+
+    // Where one source image sits in an atlas, in mip 0 texels; sorted by name_hash
+    struct CookedAtlasRegion {
+        uint64_t name_hash;  // hashAssetPath of the source path without its extension
+        uint32_t layer;
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(CookedAtlasRegion) == 32);
+
+    [[nodiscard]] constexpr uint32_t getMipExtent(uint32_t size, uint32_t mip) noexcept {
+        return (size >> mip) > 0 ? (size >> mip) : 1u;
+    }
+
+    [[nodiscard]] constexpr uint32_t getFullMipCount(uint32_t width, uint32_t height) noexcept {
+        uint32_t count = 1;
+        while ((width >> count) > 0 || (height >> count) > 0) ++count;
+        return count;
+    }
+
+    [[nodiscard]] constexpr uint32_t getTexelSize(CookedTextureFormat /*format*/) noexcept {
+        return 4;  // Both formats are RGBA8
+    }
+
+    // Spans point into the parsed buffer
+    struct CookedTextureView {
+        CookedTextureHeader header{};
+        std::vector<std::span<const std::byte>> mips;
+        std::vector<CookedAtlasRegion> regions;
+
+        [[nodiscard]] std::span<const std::byte> getLayer(uint32_t mip, uint32_t layer) const noexcept;
+        [[nodiscard]] const CookedAtlasRegion* findRegion(uint64_t name_hash) const noexcept;
+    };
+
+    // nullopt if the blob is not a valid cooked texture
+    [[nodiscard]] std::optional<CookedTextureView> parseCookedTexture(std::span<const std::byte> data);
+
+    // mips[m] holds every layer of level m; sizes must match the header.
+    // regions are sorted here; header.region_count must match.
+    [[nodiscard]] std::optional<std::vector<std::byte>> serializeCookedTexture(const CookedTextureHeader& header,
+        std::span<const std::vector<std::byte>> mips, std::span<const CookedAtlasRegion> regions = {});
+
+} // namespace AshCore
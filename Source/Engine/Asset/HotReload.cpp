@@ -0,0 +1,95 @@
+#include "ashbornpch.h"
+
+#include "HotReload.h"
+
+#include <algorithm>
+
+namespace AshCore {
+
+    namespace {
+        // Relative path if file is under root, empty otherwise
+        std::filesystem::path relativeTo(const std::filesystem::path& file, const std::filesystem::path& root) {
+            if (root.empty()) return {};
+            std::filesystem::path relative = file.lexically_relative(root);
+            if (relative.empty() || *relative.begin() == "..") return {};
+            return relative;
+        }
+    }
+
+    HotReloadWatcher::HotReloadWatcher(std::span<const std::filesystem::path> asset_roots, const std::filesystem::path& shader_root,
+        std::chrono::milliseconds debounce)
+        : debounce_(debounce) {
+
+        std::error_code ec;
+        for (const auto& root : asset_roots) {
+            if (!std::filesystem::is_directory(root, ec)) continue;  // Packs are not watched
+            std::filesystem::path absolute = std::filesystem::absolute(root, ec).lexically_normal();
+            if (watcher_.watch(absolute)) {
+                asset_roots_.push_back(std::move(absolute));
+                active_ = true;
+            }
+        }
+
+        if (!shader_root.empty() && std::filesystem::is_directory(shader_root, ec)) {
+            std::filesystem::path absolute = std::filesystem::absolute(shader_root, ec).lexically_normal();
+            if (watcher_.watch(absolute)) {
+                shader_root_ = std::move(absolute);
+                active_ = true;
+            }
+        }
+
+        print_d("Hot reload watcher created", LogContext{
+            {"active", active_},
+            {"asset_roots", asset_roots_.size()},
+            {"shaders", !shader_root_.empty()},
+            {"debounce_ms", static_cast<int64_t>(debounce_.count())}
+            });
+    }
+
+    bool HotReloadWatcher::isIgnored(const std::filesystem::path& file) {
+        // Editor swap files, backups and write-then-rename temporaries
+        const std::string name = file.filename().string();
+        return name.empty() || name.front() == '.' || name.back() == '~' ||
+            name.ends_with(".tmp") || name.ends_with(".swp");
+    }
+
+    HotReloadChanges HotReloadWatcher::poll(std::chrono::steady_clock::time_point now) {
+        HotReloadChanges changes;
+        if (!active_) return changes;
+
+        events_.clear();
+        watcher_.poll(events_);
+        for (const auto& file : events_) {
+            if (isIgnored(file)) continue;
+
+            // The shader root may sit inside an asset root, so it wins
+            Pending pending{ now, true, relativeTo(file, shader_root_) };
+            for (size_t i = 0; pending.relative.empty() && i < asset_roots_.size(); ++i) {
+                pending.shader = false;
+                pending.relative = relativeTo(file, asset_roots_[i]);
+            }
+            if (pending.relative.empty()) continue;
+
+            pending_[file.string()] = std::move(pending);
+        }
+
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            if (now - it->second.last_event < debounce_) {
+                ++it;
+                continue;
+            }
+            if (it->second.shader) {
+                changes.shaders.push_back(std::move(it->second.relative));
+            }
+            else {
+                changes.assets.push_back(it->second.relative.generic_string());
+            }
+            it = pending_.erase(it);
+        }
+
+        std::sort(changes.assets.begin(), changes.assets.end());
+        std::sort(changes.shaders.begin(), changes.shaders.end());
+        return changes;
+    }
+
+} // namespace AshCore
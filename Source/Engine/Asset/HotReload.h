@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Platform/FileWatcher.h"
+
+#include <chrono>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    struct HotReloadChanges {
+        std::vector<std::string> assets;             // Relative to their asset root, '/' separated
+        std::vector<std::filesystem::path> shaders;  // Relative to the shader source root
+
+        [[nodiscard]] bool empty() const noexcept { return assets.empty() && shaders.empty(); }
+    };
+
+    /**
+     * @brief Turns file notifications into asset and shader reloads
+     *
+     * Editors and exporters touch a file several times per save (truncate,
+     * write, rename), so a path is only reported once it has been quiet for
+     * the debounce interval, and then only once per burst.
+     */
+    class HotReloadWatcher {
+    public:
+        HotReloadWatcher(std::span<const std::filesystem::path> asset_roots, const std::filesystem::path& shader_root,
+            std::chrono::milliseconds debounce);
+
+        // False if nothing could be watched (unsupported platform, no directories)
+        [[nodiscard]] bool isActive() const noexcept { return active_; }
+
+        [[nodiscard]] HotReloadChanges poll(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    private:
+        struct Pending {
+            std::chrono::steady_clock::time_point last_event;
+            bool shader = false;
+            std::filesystem::path relative;
+        };
+
+        [[nodiscard]] static bool isIgnored(const std::filesystem::path& file);
+
+    private:
+        FileWatcher watcher_;
+        std::vector<std::filesystem::path> asset_roots_;
+        std::filesystem::path shader_root_;
+        std::chrono::milliseconds debounce_;
+        bool active_ = false;
+
+        std::unordered_map<std::string, Pending> pending_;  // Absolute path -> latest event
+        std::vector<std::filesystem::path> events_;
+    };
+
+} // namespace AshCore
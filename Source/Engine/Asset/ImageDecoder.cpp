@@ -0,0 +1,514 @@
+#include "ashbornpch.h"
+
+#include "ImageDecoder.h"
+#include "Jobs/JobSystem.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t CHANNELS = 4;
+        constexpr uint32_t SRGB_ENCODE_STEPS = 4095;  // Linear -> sRGB table resolution
+        constexpr float INV_255 = 1.0f / 255.0f;
+
+        struct ColourTables {
+            alignas(32) float decode[256];                    // sRGB byte -> linear
+            alignas(32) int32_t encode[SRGB_ENCODE_STEPS + 1]; // Linear step -> sRGB byte; int32 so AVX2 can gather it
+
+            ColourTables() {
+                for (uint32_t i = 0; i < 256; ++i) {
+                    const float c = static_cast<float>(i) / 255.0f;
+                    decode[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                }
+                for (uint32_t i = 0; i <= SRGB_ENCODE_STEPS; ++i) {
+                    const float l = static_cast<float>(i) / static_cast<float>(SRGB_ENCODE_STEPS);
+                    const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                    encode[i] = static_cast<int32_t>(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+                }
+            }
+        };
+
+        const ColourTables& colourTables() {
+            static const ColourTables tables;
+            return tables;
+        }
+
+        enum class Premultiply : uint8_t {
+            None = 0,
+            Linear,
+            Srgb
+        };
+
+        // round(c * a / 255) without a division
+        uint8_t mulDiv255(uint32_t c, uint32_t a) noexcept {
+            const uint32_t t = c * a + 128;
+            return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+        }
+
+        // Same operation order as the AVX2 path, so both round alike
+        uint8_t premultiplySrgb(const ColourTables& tables, uint8_t c, float alpha) noexcept {
+            const float linear = tables.decode[c] * alpha;
+            return static_cast<uint8_t>(tables.encode[std::lrint(linear * static_cast<float>(SRGB_ENCODE_STEPS))]);
+        }
+
+        void convertScalar(const uint8_t* src, uint32_t channels, uint8_t* dst, size_t count, bool bgra, Premultiply premultiply) {
+            const ColourTables& tables = colourTables();
+            for (size_t i = 0; i < count; ++i, src += channels, dst += CHANNELS) {
+                uint8_t r = src[0];
+                uint8_t g = src[0];
+                uint8_t b = src[0];
+                uint8_t a = 255;
+                if (channels == 2) {
+                    a = src[1];
+                }
+                else if (channels >= 3) {
+                    g = src[1];
+                    b = src[2];
+                    if (channels == 4) a = src[3];
+                }
+
+                if (premultiply == Premultiply::Linear) {
+                    r = mulDiv255(r, a);
+                    g = mulDiv255(g, a);
+                    b = mulDiv255(b, a);
+                }
+                else if (premultiply == Premultiply::Srgb) {
+                    const float alpha = static_cast<float>(a) * INV_255;
+                    r = premultiplySrgb(tables, r, alpha);
+                    g = premultiplySrgb(tables, g, alpha);
+                    b = premultiplySrgb(tables, b, alpha);
+                }
+
+                dst[0] = bgra ? b : r;
+                dst[1] = g;
+                dst[2] = bgra ? r : b;
+                dst[3] = a;
+            }
+        }
+
+#if defined(__AVX2__)
+        // Byte shuffle that expands 8 source pixels to RGBA/BGRA; -1 leaves a zero for the alpha fill
+        __m256i expandMask(uint32_t channels, bool bgra) {
+            const char r = bgra ? 2 : 0;
+            const char b = bgra ? 0 : 2;
+            switch (channels) {
+            case 1:
+                return _mm256_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1,
+                    4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1);
+            case 2:
+                return _mm256_setr_epi8(0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7,
+                    8, 8, 8, 9, 10, 10, 10, 11, 12, 12, 12, 13, 14, 14, 14, 15);
+            case 3:
+                // Each 128-bit lane holds four RGB pixels (the upper lane is loaded from pixel 4)
+                return _mm256_setr_epi8(r, 1, b, -1, r + 3, 4, b + 3, -1, r + 6, 7, b + 6, -1, r + 9, 10, b + 9, -1,
+                    r, 1, b, -1, r + 3, 4, b + 3, -1, r + 6, 7, b + 6, -1, r + 9, 10, b + 9, -1);
+            default:
+                return _mm256_setr_epi8(r, 1, b, 3, r + 4, 5, b + 4, 7, r + 8, 9, b + 8, 11, r + 12, 13, b + 12, 15,
+                    r, 1, b, 3, r + 4, 5, b + 4, 7, r + 8, 9, b + 8, 11, r + 12, 13, b + 12, 15);
+            }
+        }
+
+        __m256i loadPixels(const uint8_t* src, uint32_t channels) {
+            switch (channels) {
+            case 1:
+                return _mm256_broadcastsi128_si256(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+            case 2:
+                return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+            case 3:
+                return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12)), 1);
+            default:
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            }
+        }
+
+        __m256i premultiplyLinear(__m256i pixels) {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i alpha_words = _mm256_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15,
+                6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+            const __m256i round = _mm256_set1_epi16(128);
+
+            auto scale = [&](__m256i words) {
+                const __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(words, _mm256_shuffle_epi8(words, alpha_words)), round);
+                return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+            };
+            const __m256i scaled = _mm256_packus_epi16(scale(_mm256_unpacklo_epi8(pixels, zero)), scale(_mm256_unpackhi_epi8(pixels, zero)));
+            return _mm256_blendv_epi8(scaled, pixels, _mm256_set1_epi32(static_cast<int>(0xFF000000u)));
+        }
+
+        __m256i premultiplySrgb(const ColourTables& tables, __m256i pixels) {
+            const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+            const __m256 alpha = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(pixels, 24)), _mm256_set1_ps(INV_255));
+            const __m256 steps = _mm256_set1_ps(static_cast<float>(SRGB_ENCODE_STEPS));
+
+            __m256i result = _mm256_and_si256(pixels, _mm256_set1_epi32(static_cast<int>(0xFF000000u)));
+            for (int shift = 0; shift < 24; shift += 8) {
+                const __m256i index = _mm256_and_si256(_mm256_srlv_epi32(pixels, _mm256_set1_epi32(shift)), byte_mask);
+                const __m256 linear = _mm256_mul_ps(_mm256_i32gather_ps(tables.decode, index, 4), alpha);
+                const __m256i step = _mm256_cvtps_epi32(_mm256_mul_ps(linear, steps));
+                const __m256i encoded = _mm256_i32gather_epi32(tables.encode, step, 4);
+                result = _mm256_or_si256(result, _mm256_sllv_epi32(encoded, _mm256_set1_epi32(shift)));
+            }
+            return result;
+        }
+
+        // Returns how many pixels were converted; the caller finishes the tail
+        size_t convertAvx2(const uint8_t* src, uint32_t channels, uint8_t* dst, size_t count, bool bgra, Premultiply premultiply) {
+            const ColourTables& tables = colourTables();
+            const __m256i mask = expandMask(channels, bgra);
+            const __m256i opaque = channels == 1 || channels == 3 ? _mm256_set1_epi32(static_cast<int>(0xFF000000u)) : _mm256_setzero_si256();
+
+            // The RGB load reads 4 bytes past its 8 pixels
+            const size_t safe = channels == 3 ? (count > 2 ? count - 2 : 0) : count;
+            size_t i = 0;
+            for (; i + 8 <= safe; i += 8) {
+                __m256i pixels = _mm256_or_si256(_mm256_shuffle_epi8(loadPixels(src + i * channels, channels), mask), opaque);
+                if (premultiply == Premultiply::Linear) pixels = premultiplyLinear(pixels);
+                else if (premultiply == Premultiply::Srgb) pixels = premultiplySrgb(tables, pixels);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * CHANNELS), pixels);
+            }
+            return i;
+        }
+#endif
+
+        void convertPixels(const uint8_t* src, uint32_t channels, uint8_t* dst, size_t count, const ImageDecodeSettings& settings) {
+            if (count == 0) return;
+
+            const bool bgra = settings.order == ImageChannelOrder::BGRA;
+            const bool has_alpha = channels == 2 || channels == 4;
+            const Premultiply premultiply = !settings.premultiply || !has_alpha ? Premultiply::None
+                : settings.srgb ? Premultiply::Srgb : Premultiply::Linear;
+
+            if (channels == 4 && !bgra && premultiply == Premultiply::None) {
+                std::memcpy(dst, src, count * CHANNELS);
+                return;
+            }
+
+            size_t done = 0;
+#if defined(__AVX2__)
+            if (settings.use_simd) {
+                done = convertAvx2(src, channels, dst, count, bgra, premultiply);
+            }
+#endif
+            convertScalar(src + done * channels, channels, dst + done * CHANNELS, count - done, bgra, premultiply);
+        }
+
+        const uint8_t* asBytes(std::span<const std::byte> data) noexcept {
+            return reinterpret_cast<const uint8_t*>(data.data());
+        }
+    }
+
+    // ==========================================
+    // IMAGE BUFFERS
+    // ==========================================
+
+    ImageBuffer::~ImageBuffer() {
+        release();
+    }
+
+    ImageBuffer::ImageBuffer(ImageBuffer&& other) noexcept
+        : storage_(std::move(other.storage_))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , size_(std::exchange(other.size_, 0))
+        , pool_(std::move(other.pool_)) {}
+
+    ImageBuffer& ImageBuffer::operator=(ImageBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            storage_ = std::move(other.storage_);
+            capacity_ = std::exchange(other.capacity_, 0);
+            size_ = std::exchange(other.size_, 0);
+            pool_ = std::move(other.pool_);
+        }
+        return *this;
+    }
+
+    void ImageBuffer::release() noexcept {
+        if (pool_ && storage_) {
+            std::lock_guard lock(pool_->mutex);
+            if (pool_->stats.pooled_bytes + capacity_ <= pool_->max_pooled_bytes) {
+                pool_->stats.pooled_bytes += capacity_;
+                pool_->free.emplace(capacity_, std::move(storage_));
+            }
+            else {
+                ++pool_->stats.dropped;
+            }
+        }
+        storage_.reset();
+        pool_.reset();
+        capacity_ = 0;
+        size_ = 0;
+    }
+
+    ImageBufferPool::ImageBufferPool(size_t max_pooled_bytes)
+        : state_(std::make_shared<detail::ImageBufferPoolState>()) {
+        state_->max_pooled_bytes = max_pooled_bytes;
+    }
+
+    ImageBuffer ImageBufferPool::acquire(size_t size) const {
+        ImageBuffer buffer;
+        buffer.pool_ = state_;
+        buffer.size_ = size;
+        {
+            std::lock_guard lock(state_->mutex);
+            ++state_->stats.acquired;
+            auto it = state_->free.lower_bound(size);
+            if (it != state_->free.end() && it->first / 2 <= size) {
+                buffer.capacity_ = it->first;
+                buffer.storage_ = std::move(it->second);
+                state_->stats.pooled_bytes -= it->first;
+                ++state_->stats.reused;
+                state_->free.erase(it);
+            }
+        }
+        if (!buffer.storage_) {
+            buffer.storage_ = std::make_unique_for_overwrite<std::byte[]>(size);
+            buffer.capacity_ = size;
+        }
+        return buffer;
+    }
+
+    void ImageBufferPool::trim() {
+        std::lock_guard lock(state_->mutex);
+        state_->free.clear();
+        state_->stats.pooled_bytes = 0;
+    }
+
+    ImageBufferPoolStats ImageBufferPool::getStats() const {
+        std::lock_guard lock(state_->mutex);
+        return state_->stats;
+    }
+
+    // ==========================================
+    // DECODING
+    // ==========================================
+
+    std::expected<DecodedImage, AssetError> decodeImage(const EncodedImage& image, const ImageDecodeSettings& settings,
+        const ImageBufferPool& pool) {
+        if (image.bytes.size() > static_cast<size_t>(INT_MAX)) {
+            print_e("Image too large to decode", LogContext{ {"name", std::string(image.name)}, {"bytes", image.bytes.size()} });
+            return std::unexpected(AssetError::CorruptedAsset);
+        }
+
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::unique_ptr<stbi_uc, void (*)(void*)> pixels(stbi_load_from_memory(asBytes(image.bytes), static_cast<int>(image.bytes.size()),
+            &width, &height, &channels, 0), stbi_image_free);
+        if (!pixels) {
+            print_e("Failed to decode image", LogContext{ {"name", std::string(image.name)}, {"reason", std::string(stbi_failure_reason())} });
+            return std::unexpected(AssetError::CorruptedAsset);
+        }
+
+        DecodedImage decoded;
+        decoded.width = static_cast<uint32_t>(width);
+        decoded.height = static_cast<uint32_t>(height);
+        decoded.source_channels = static_cast<uint32_t>(channels);
+        decoded.srgb = settings.srgb;
+        decoded.premultiplied = settings.premultiply;
+
+        const size_t count = size_t{ decoded.width } * decoded.height;
+        decoded.pixels = pool.acquire(count * CHANNELS);
+        convertPixels(pixels.get(), decoded.source_channels, reinterpret_cast<uint8_t*>(decoded.pixels.getData().data()), count, settings);
+        return decoded;
+    }
+
+    std::vector<std::expected<DecodedImage, AssetError>> decodeImages(std::span<const EncodedImage> images,
+        const ImageDecodeSettings& settings, const ImageBufferPool& pool, JobSystem* jobs) {
+        std::vector<std::expected<DecodedImage, AssetError>> results(images.size());
+        auto decode = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = decodeImage(images[i], settings, pool);
+            }
+        };
+
+        if (jobs && images.size() > 1) {
+            jobs->parallelFor(images.size(), 1, decode);
+        }
+        else {
+            decode(0, images.size());
+        }
+        return results;
+    }
+
+    void convertImagePixels(std::span<const std::byte> src, uint32_t src_channels, std::span<std::byte> dst,
+        const ImageDecodeSettings& settings) {
+        if (src_channels < 1 || src_channels > 4) return;
+        const size_t count = std::min(src.size() / src_channels, dst.size() / CHANNELS);
+        convertPixels(asBytes(src), src_channels, reinterpret_cast<uint8_t*>(dst.data()), count, settings);
+    }
+
+    bool isImageSimdAvailable() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // ==========================================
+    // LOADER
+    // ==========================================
+
+    std::expected<std::unique_ptr<DecodedImage>, AssetError> ImageLoader::load(AssetLoadContext& context) {
+        // Uncompressed pack entries are decoded straight out of the mapping
+        std::vector<std::byte> file;
+        std::span<const std::byte> bytes;
+        if (const auto view = context.view()) {
+            bytes = *view;
+        }
+        else {
+            auto read = context.readFile();
+            if (!read) return std::unexpected(read.error());
+            file = std::move(*read);
+            bytes = file;
+        }
+
+        auto image = decodeImage({ bytes, context.getPath() }, settings_, pool_);
+        if (!image) return std::unexpected(image.error());
+        return std::make_unique<DecodedImage>(std::move(*image));
+    }
+
+    // ==========================================
+    // BENCHMARK
+    // ==========================================
+
+    std::vector<std::vector<std::byte>> makeImageBenchmarkCorpus(uint32_t count, uint32_t size) {
+        constexpr uint32_t CHANNEL_CYCLE[] = { 1, 3, 4 };
+        constexpr size_t TGA_HEADER_SIZE = 18;
+
+        std::vector<std::vector<std::byte>> corpus(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t channels = CHANNEL_CYCLE[i % 3];
+            std::vector<std::byte>& file = corpus[i];
+            file.resize(TGA_HEADER_SIZE + size_t{ size } * size * channels);
+
+            // Uncompressed true colour (or grey), top-left origin
+            auto* data = reinterpret_cast<uint8_t*>(file.data());
+            data[2] = channels == 1 ? 3 : 2;
+            data[12] = static_cast<uint8_t>(size & 0xFF);
+            data[13] = static_cast<uint8_t>(size >> 8);
+            data[14] = static_cast<uint8_t>(size & 0xFF);
+            data[15] = static_cast<uint8_t>(size >> 8);
+            data[16] = static_cast<uint8_t>(channels * 8);
+            data[17] = static_cast<uint8_t>(0x20 | (channels == 4 ? 8 : 0));
+
+            std::mt19937 rng(i);
+            uint8_t* texel = data + TGA_HEADER_SIZE;
+            for (uint32_t y = 0; y < size; ++y) {
+                for (uint32_t x = 0; x < size; ++x) {
+                    for (uint32_t c = 0; c < channels; ++c) {
+                        *texel++ = static_cast<uint8_t>(x * 7 + y * 13 + c * 61 + i * 31 + (rng() & 15));
+                    }
+                }
+            }
+        }
+        return corpus;
+    }
+
+    ImageDecodeBenchmarkResult benchmarkImageDecode(std::span<const std::vector<std::byte>> corpus, JobSystem* jobs, uint32_t iterations) {
+        using Clock = std::chrono::steady_clock;
+        auto millisecondsSince = [](Clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        };
+        iterations = std::max(iterations, 1u);
+
+        ImageDecodeBenchmarkResult result;
+        result.images = static_cast<uint32_t>(corpus.size());
+
+        std::vector<EncodedImage> encoded;
+        encoded.reserve(corpus.size());
+        for (const auto& file : corpus) {
+            encoded.push_back({ file, "benchmark" });
+            result.encoded_bytes += file.size();
+        }
+
+        ImageDecodeSettings scalar;
+        scalar.premultiply = true;
+        scalar.use_simd = false;
+        ImageDecodeSettings simd = scalar;
+        simd.use_simd = true;
+
+        // ---- Whole decode: serial against parallel
+        uint64_t pixels = 0;
+        result.serial_ms = 1e30;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+            const ImageBufferPool unpooled(0);
+            pixels = 0;
+            const auto start = Clock::now();
+            for (const EncodedImage& image : encoded) {
+                if (auto decoded = decodeImage(image, scalar, unpooled)) {
+                    pixels += uint64_t{ decoded->width } * decoded->height;
+                }
+            }
+            result.serial_ms = std::min(result.serial_ms, millisecondsSince(start));
+        }
+        result.decoded_bytes = pixels * CHANNELS;
+
+        const ImageBufferPool pool;
+        result.parallel_ms = 1e30;
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+            const auto start = Clock::now();
+            const auto decoded = decodeImages(encoded, simd, pool, jobs);
+            result.parallel_ms = std::min(result.parallel_ms, millisecondsSince(start));
+        }
+        if (result.parallel_ms > 0.0) {
+            result.speedup = result.serial_ms / result.parallel_ms;
+            result.megapixels_per_second = static_cast<double>(pixels) / (result.parallel_ms * 1000.0);
+        }
+
+        // ---- Conversion pass alone, on stb's native-channel output
+        struct Raw {
+            std::unique_ptr<stbi_uc, void (*)(void*)> pixels{ nullptr, stbi_image_free };
+            size_t count = 0;
+            uint32_t channels = 0;
+        };
+        std::vector<Raw> raw;
+        raw.reserve(corpus.size());
+        size_t largest = 0;
+        for (const auto& file : corpus) {
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            Raw& entry = raw.emplace_back();
+            entry.pixels.reset(stbi_load_from_memory(asBytes(file), static_cast<int>(file.size()), &width, &height, &channels, 0));
+            if (!entry.pixels) {
+                raw.pop_back();
+                continue;
+            }
+            entry.count = size_t{ static_cast<uint32_t>(width) } * static_cast<uint32_t>(height);
+            entry.channels = static_cast<uint32_t>(channels);
+            largest = std::max(largest, entry.count);
+        }
+
+        std::vector<uint8_t> scratch(largest * CHANNELS);
+        auto timeConvert = [&](const ImageDecodeSettings& settings) {
+            double best = 1e30;
+            for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+                const auto start = Clock::now();
+                for (const Raw& entry : raw) {
+                    convertPixels(entry.pixels.get(), entry.channels, scratch.data(), entry.count, settings);
+                }
+                best = std::min(best, millisecondsSince(start));
+            }
+            return best;
+        };
+        result.convert_scalar_ms = timeConvert(scalar);
+        result.convert_simd_ms = isImageSimdAvailable() ? timeConvert(simd) : result.convert_scalar_ms;
+        return result;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "AssetManager.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // IMAGE BUFFERS
+    // ==========================================
+
+    struct ImageBufferPoolStats {
+        uint64_t acquired = 0;
+        uint64_t reused = 0;              // Served from a released buffer
+        uint64_t dropped = 0;             // Released while the pool was full
+        size_t pooled_bytes = 0;
+    };
+
+    namespace detail {
+        struct ImageBufferPoolState {
+            std::mutex mutex;
+            std::multimap<size_t, std::unique_ptr<std::byte[]>> free;  // By capacity
+            size_t max_pooled_bytes = 0;
+            ImageBufferPoolStats stats;
+        };
+    }
+
+    // Pixel storage that goes back to its pool when destroyed; move-only
+    class ImageBuffer {
+    public:
+        ImageBuffer() = default;
+        ~ImageBuffer();
+
+        ImageBuffer(ImageBuffer&& other) noexcept;
+        ImageBuffer& operator=(ImageBuffer&& other) noexcept;
+        ImageBuffer(const ImageBuffer&) = delete;
+        ImageBuffer& operator=(const ImageBuffer&) = delete;
+
+        [[nodiscard]] std::span<std::byte> getData() noexcept { return { storage_.get(), size_ }; }
+        [[nodiscard]] std::span<const std::byte> getData() const noexcept { return { storage_.get(), size_ }; }
+        [[nodiscard]] size_t getSize() const noexcept { return size_; }
+
+    private:
+        friend class ImageBufferPool;
+        void release() noexcept;
+
+        std::unique_ptr<std::byte[]> storage_;
+        size_t capacity_ = 0;
+        size_t size_ = 0;
+        std::shared_ptr<detail::ImageBufferPoolState> pool_;
+    };
+
+    /**
+     * @brief Recycles decoded pixel buffers, thread-safe
+     *
+     * Loading a pack of textures allocates and frees the same few sizes over
+     * and over; a released buffer is handed to the next acquire() it can
+     * hold (without wasting more than half of it), so steady-state decoding
+     * stops hitting the allocator. Buffers may outlive the pool.
+     */
+    class ImageBufferPool {
+    public:
+        explicit ImageBufferPool(size_t max_pooled_bytes = 256ull * 1024 * 1024);
+
+        // Contents are unspecified (fresh allocations are not zeroed)
+        [[nodiscard]] ImageBuffer acquire(size_t size) const;
+
+        void trim();
+        [[nodiscard]] ImageBufferPoolStats getStats() const;
+
+    private:
+        std::shared_ptr<detail::ImageBufferPoolState> state_;
+    };
+
+    // ==========================================
+    // DECODING
+    // ==========================================
+
+    enum class ImageChannelOrder : uint8_t {
+        RGBA = 0,
+        BGRA
+    };
+
+    struct ImageDecodeSettings {
+        ImageChannelOrder order = ImageChannelOrder::RGBA;
+        bool srgb = true;             // Colour is sRGB encoded; premultiplication then happens in linear space
+        bool premultiply = false;
+        bool use_simd = true;
+    };
+
+    // Always four channels, tightly packed, in settings.order
+    struct DecodedImage {
+        ImageBuffer pixels;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t source_channels = 0; // As stored in the file (1 grey .. 4 RGBA)
+        bool srgb = true;
+        bool premultiplied = false;
+    };
+
+    struct EncodedImage {
+        std::span<const std::byte> bytes;
+        std::string_view name;        // Only used in failure logs
+    };
+
+    // PNG, TGA, JPEG or BMP. stb decodes to the file's own channel count and
+    // one conversion pass writes the engine layout into a pooled buffer.
+    [[nodiscard]] std::expected<DecodedImage, AssetError> decodeImage(const EncodedImage& image, const ImageDecodeSettings& settings,
+        const ImageBufferPool& pool);
+
+    // Results in input order. One job per image, so a batch is decoded as
+    // wide as the pool; jobs may be null.
+    [[nodiscard]] std::vector<std::expected<DecodedImage, AssetError>> decodeImages(std::span<const EncodedImage> images,
+        const ImageDecodeSettings& settings, const ImageBufferPool& pool, JobSystem* jobs);
+
+    // 1-4 channel texels to four channels: expand grey, swizzle, premultiply.
+    // dst holds pixel_count * 4 bytes.
+    void convertImagePixels(std::span<const std::byte> src, uint32_t src_channels, std::span<std::byte> dst,
+        const ImageDecodeSettings& settings);
+
+    [[nodiscard]] bool isImageSimdAvailable() noexcept;
+
+    // ==========================================
+    // LOADER
+    // ==========================================
+
+    // Register with AssetManager::registerLoader<DecodedImage>. Each image is
+    // one load, so a pack of them decodes across all loader threads.
+    class ImageLoader final : public AssetLoader<DecodedImage> {
+    public:
+        explicit ImageLoader(const ImageDecodeSettings& settings = {}, size_t max_pooled_bytes = 256ull * 1024 * 1024)
+            : settings_(settings), pool_(max_pooled_bytes) {}
+
+        [[nodiscard]] std::expected<std::unique_ptr<DecodedImage>, AssetError> load(AssetLoadContext& context) override;
+        [[nodiscard]] size_t getMemorySize(const DecodedImage& image) const override { return sizeof(image) + image.pixels.getSize(); }
+
+        [[nodiscard]] const ImageBufferPool& getPool() const noexcept { return pool_; }
+
+    private:
+        ImageDecodeSettings settings_;
+        ImageBufferPool pool_;
+    };
+
+    // ==========================================
+    // BENCHMARK
+    // ==========================================
+
+    struct ImageDecodeBenchmarkResult {
+        uint32_t images = 0;
+        uint64_t encoded_bytes = 0;
+        uint64_t decoded_bytes = 0;
+        // Both modes premultiply in linear space, the most expensive conversion
+        double serial_ms = 0.0;       // One thread, scalar conversion, fresh buffers
+        double parallel_ms = 0.0;     // decodeImages on the job system, SIMD, pooled
+        double speedup = 0.0;
+        double megapixels_per_second = 0.0;  // Parallel
+        double convert_scalar_ms = 0.0;      // Conversion pass alone, whole corpus
+        double convert_simd_ms = 0.0;
+    };
+
+    // count TGA images (grey, RGB and RGBA in turn), a stand-in for a resource pack
+    [[nodiscard]] std::vector<std::vector<std::byte>> makeImageBenchmarkCorpus(uint32_t count = 1000, uint32_t size = 64);
+
+    // Best of iterations for each mode
+    [[nodiscard]] ImageDecodeBenchmarkResult benchmarkImageDecode(std::span<const std::vector<std::byte>> corpus, JobSystem* jobs,
+        uint32_t iterations = 3);
+
+} // namespace AshCore
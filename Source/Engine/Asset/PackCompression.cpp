@@ -0,0 +1,176 @@
+#include "ashbornpch.h"
+
+#include "PackCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t MIN_MATCH = 4;
+        constexpr size_t LAST_LITERALS = 5;   // The block must end with this many literals
+        constexpr size_t MATCH_FIND_LIMIT = 12;  // No match may start closer to the end
+        constexpr size_t MAX_OFFSET = 65535;
+        constexpr uint32_t HASH_BITS = 12;
+
+        uint32_t read32(const uint8_t* p) noexcept {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        uint32_t hashSequence(uint32_t sequence) noexcept {
+            return (sequence * 2654435761u) >> (32 - HASH_BITS);
+        }
+
+        // Bounds-checked output cursor; overflow latches and the caller bails
+        struct Writer {
+            uint8_t* out;
+            size_t capacity;
+            size_t pos = 0;
+            bool overflow = false;
+
+            void byte(uint8_t value) noexcept {
+                if (pos >= capacity) { overflow = true; return; }
+                out[pos++] = value;
+            }
+
+            void bytes(const uint8_t* src, size_t count) noexcept {
+                if (count > capacity - pos) { overflow = true; return; }
+                if (count == 0) return;  // src may be null for an empty block
+                std::memcpy(out + pos, src, count);
+                pos += count;
+            }
+
+            // 255-continuation encoding for lengths that overflow the token nibble
+            void length(size_t value) noexcept {
+                while (value >= 255) { byte(255); value -= 255; }
+                byte(static_cast<uint8_t>(value));
+            }
+        };
+
+        void emitSequence(Writer& writer, const uint8_t* literals, size_t literal_count, size_t offset, size_t match_length) {
+            const size_t match_code = match_length - MIN_MATCH;
+            const auto token = static_cast<uint8_t>((std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(match_code, 15));
+            writer.byte(token);
+            if (literal_count >= 15) writer.length(literal_count - 15);
+            writer.bytes(literals, literal_count);
+
+            writer.byte(static_cast<uint8_t>(offset & 0xFF));
+            writer.byte(static_cast<uint8_t>(offset >> 8));
+            if (match_code >= 15) writer.length(match_code - 15);
+        }
+
+        void emitLastLiterals(Writer& writer, const uint8_t* literals, size_t literal_count) {
+            writer.byte(static_cast<uint8_t>(std::min<size_t>(literal_count, 15) << 4));
+            if (literal_count >= 15) writer.length(literal_count - 15);
+            writer.bytes(literals, literal_count);
+        }
+    }
+
+    size_t lz4Compress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept {
+        const auto* in = reinterpret_cast<const uint8_t*>(src.data());
+        const size_t size = src.size();
+        Writer writer{ reinterpret_cast<uint8_t*>(dst.data()), dst.size() };
+
+        size_t anchor = 0;
+        if (size > MATCH_FIND_LIMIT) {
+            // Last position seen for each 4-byte hash; false hits are rejected by comparing bytes
+            std::array<uint32_t, size_t{ 1 } << HASH_BITS> table{};
+            const size_t match_limit = size - LAST_LITERALS;
+            const size_t search_end = size - MATCH_FIND_LIMIT;
+
+            size_t pos = 1;
+            table[hashSequence(read32(in))] = 0;
+            while (pos < search_end) {
+                const uint32_t sequence = read32(in + pos);
+                const uint32_t hash = hashSequence(sequence);
+                const size_t candidate = table[hash];
+                table[hash] = static_cast<uint32_t>(pos);
+
+                if (pos - candidate > MAX_OFFSET || read32(in + candidate) != sequence) {
+                    ++pos;
+                    continue;
+                }
+
+                size_t length = MIN_MATCH;
+                while (pos + length < match_limit && in[candidate + length] == in[pos + length]) {
+                    ++length;
+                }
+
+                emitSequence(writer, in + anchor, pos - anchor, pos - candidate, length);
+                if (writer.overflow) return 0;
+
+                pos += length;
+                anchor = pos;
+                if (pos < search_end) {
+                    // Seed the table inside the match so the next one can chain off it
+                    table[hashSequence(read32(in + pos - 2))] = static_cast<uint32_t>(pos - 2);
+                }
+            }
+        }
+
+        emitLastLiterals(writer, in + anchor, size - anchor);
+        return writer.overflow ? 0 : writer.pos;
+    }
+
+    bool lz4Decompress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept {
+        const auto* in = reinterpret_cast<const uint8_t*>(src.data());
+        auto* out = reinterpret_cast<uint8_t*>(dst.data());
+        const size_t in_size = src.size();
+        const size_t out_size = dst.size();
+
+        size_t ip = 0;
+        size_t op = 0;
+
+        // Returns false if the length runs past the input
+        auto readLength = [&](size_t& length) {
+            uint8_t extra = 255;
+            while (extra == 255) {
+                if (ip >= in_size) return false;
+                extra = in[ip++];
+                length += extra;
+            }
+            return true;
+        };
+
+        while (ip < in_size) {
+            const uint8_t token = in[ip++];
+
+            size_t literal_count = token >> 4;
+            if (literal_count == 15 && !readLength(literal_count)) return false;
+            if (literal_count > in_size - ip || literal_count > out_size - op) return false;
+            if (literal_count > 0) std::memcpy(out + op, in + ip, literal_count);  // out is null for empty dst
+            ip += literal_count;
+            op += literal_count;
+
+            if (ip == in_size) break;  // Final sequence carries literals only
+
+            if (in_size - ip < 2) return false;
+            const size_t offset = in[ip] | (static_cast<size_t>(in[ip + 1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > op) return false;
+
+            size_t match_length = (token & 0x0F);
+            if (match_length == 15 && !readLength(match_length)) return false;
+            match_length += MIN_MATCH;
+            if (match_length > out_size - op) return false;
+
+            // Overlapping copies repeat the pattern, so go byte by byte when they overlap
+            const uint8_t* match = out + op - offset;
+            if (offset >= match_length) {
+                std::memcpy(out + op, match, match_length);
+            }
+            else {
+                for (size_t i = 0; i < match_length; ++i) out[op + i] = match[i];
+            }
+            op += match_length;
+        }
+
+        return op == out_size;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace AshCore {
+
+    // ==========================================
+    // LZ4 BLOCK CODEC
+    // ==========================================
+
+    // Raw LZ4 block format (no frame header), used for asset pack entries.
+    // The compressor is a greedy single-probe matcher: fast to pack and
+    // byte-compatible with any LZ4 block decoder.
+
+    [[nodiscard]] constexpr size_t lz4CompressBound(size_t size) noexcept {
+        return size + size / 255 + 16;
+    }
+
+    // Returns the compressed size, or 0 if the result does not fit in dst
+    [[nodiscard]] size_t lz4Compress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept;
+
+    // dst must be exactly the uncompressed size; false on malformed input
+    [[nodiscard]] bool lz4Decompress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept;
+
+} // namespace AshCore
@@ -0,0 +1,9 @@
+#include "ashbornpch.h"
+
+// Single translation unit for the stb_image implementation
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_ONLY_TGA
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_BMP
+#include <stb_image.h>
@@ -142,4 +142,10 @@ project "Engine"
     filter { "files:World/Voxel/**.cpp", "configurations:Release or configurations:Dist" }
         optimize "Speed"
         vectorextensions "AVX2"  -- Modern CPU optimization
-        floatingpoint "Fast"
\ No newline at end of file
+        floatingpoint "Fast"
+
+    -- Hand-written AVX2 paths (scalar fallback otherwise)
+    filter { "files:Core/Hash/**.cpp or Asset/ImageDecoder.cpp or Renderer/Lighting/**.cpp or Renderer/Particles/**.cpp or Renderer/Culling/**.cpp or Renderer/Animation/**.cpp or Renderer/Texture/**.cpp", "configurations:Release or configurations:Dist" }
+        optimize "Speed"
+        vectorextensions "AVX2"
+        floatingpoint "Fast"
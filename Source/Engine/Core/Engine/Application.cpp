@@ -10,6 +10,7 @@
 
 #include "Application.h"
 #include "AshbornEngine.h"
+#include "Asset/AssetManager.h"
 
 #include <algorithm>
 #include <numeric>
@@ -318,6 +319,14 @@ namespace AshCore {
             callbacks_.on_update(timing_);
         }
 
+        // Changed files first, so their re-imports start this frame
+        engine_->pollHotReload();
+
+        // Finish loaded assets within the frame budget; hot reloads are swapped in here
+        if (auto* assets = engine_->getAssetManager()) {
+            assets->update();
+        }
+
         // Update subsystems that need variable timestep
         // (animations, particles, etc.)
     }
@@ -10,7 +10,12 @@
 #include <glad/vulkan.h>
 
 #include "AshbornEngine.h"
+#include "Jobs/JobSystem.h"
+#include "Asset/AssetManager.h"
+#include "Asset/HotReload.h"
+#include "Entity/EntityInstanceBatcher.h"
 
+#include <algorithm>
 #include <fstream>
 #include <thread>
 
@@ -148,10 +153,19 @@ namespace AshCore {
         print_d("Initializing core systems...");
 
         // Memory allocators would go here
-        // Thread pool initialization
         // Performance counters
 
-        print_s("Core systems initialized");
+        // Worker pool for renderer/world jobs (main thread is slot 0); the
+        // asset loader threads already take their share of the cores
+        const uint32_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+        const uint32_t loader_threads = config_.assets.async_loading ? config_.assets.loader_threads : 0;
+        const uint32_t busy_threads = 1 + loader_threads;
+        const uint32_t job_workers = hardware_threads > busy_threads ? hardware_threads - busy_threads : 1;
+        jobs_ = std::make_unique<JobSystem>(job_workers, "Engine");
+
+        print_s("Core systems initialized", LogContext{
+            {"job_workers", jobs_->getWorkerCount()}
+            });
         return {};
     }
 
@@ -206,6 +220,8 @@ namespace AshCore {
             return result;
         }
 
+        entity_batcher_ = std::make_unique<EntityInstanceBatcher>();
+
         print_s("Vulkan renderer initialized");
         return {};
     }
@@ -274,13 +290,22 @@ namespace AshCore {
             }
         }
 
-        // Initialize asset loaders
-        // Set up cache
-        // Start loader threads if async
+        // Loaders are registered by the subsystems that own each asset type
+        assets_ = std::make_unique<AssetManager>(config_.assets);
+
+        if (config_.assets.enable_hot_reload) {
+            hot_reload_ = std::make_unique<HotReloadWatcher>(config_.assets.asset_paths, config_.renderer.shader_source_path,
+                std::chrono::milliseconds(config_.assets.hot_reload_debounce_ms));
+            if (!hot_reload_->isActive()) {
+                hot_reload_.reset();
+            }
+        }
 
         print_s("Asset system initialized", LogContext{
             {"paths", config_.assets.asset_paths.size()},
-            {"cache_mb", config_.assets.cache_size_mb}
+            {"cache_mb", config_.assets.cache_size_mb},
+            {"async", assets_->isAsync()},
+            {"hot_reload", hot_reload_ != nullptr}
             });
 
         return {};
@@ -317,7 +342,8 @@ namespace AshCore {
 
     void AshbornEngine::shutdownAssets() noexcept {
         print_d("Shutting down asset system...");
-        // Clean up asset manager
+        hot_reload_.reset();
+        assets_.reset();
     }
 
     void AshbornEngine::shutdownNetwork() noexcept {
@@ -347,6 +373,7 @@ namespace AshCore {
 
     void AshbornEngine::shutdownRenderer() noexcept {
         print_d("Shutting down renderer...");
+        entity_batcher_.reset();
         cleanupSwapchain();
         cleanupDevice();
         cleanupInstance();
@@ -360,7 +387,7 @@ namespace AshCore {
 
     void AshbornEngine::shutdownCore() noexcept {
         print_d("Shutting down core systems...");
-        // Clean up thread pool
+        jobs_.reset();
         // Clean up memory allocators
     }
 
@@ -514,27 +541,66 @@ namespace AshCore {
     }
 
     std::expected<void, RendererError> AshbornEngine::reloadShaders() {
-        print_i("Reloading shaders...");
+        return reloadShaders({});
+    }
 
-        // In real implementation:
-        // - Wait for GPU idle
-        // - Recompile shaders
-        // - Recreate pipelines
+    std::expected<void, RendererError> AshbornEngine::reloadShaders(std::span<const std::filesystem::path> changed) {
+        if (!shader_reload_handler_) {
+            print_d("No shader reload handler registered");
+            return {};
+        }
+
+        print_i("Reloading shaders...", LogContext{ {"changed", changed.empty() ? std::string("all") : std::to_string(changed.size())} });
+
+        // The handler owns GPU idling and pipeline recreation; on failure the old pipelines stay
+        if (!shader_reload_handler_(changed)) {
+            print_e("Shader reload failed");
+            return std::unexpected(RendererError::ShaderCompilationFailed);
+        }
 
         print_s("Shaders reloaded");
         return {};
     }
 
     std::expected<void, AssetError> AshbornEngine::reloadAssets() {
-        print_i("Reloading assets...");
-
-        // Flush cache
-        // Reload modified assets
+        if (!assets_) {
+            return std::unexpected(AssetError::InitializationFailed);
+        }
 
-        print_s("Assets reloaded");
+        // Re-imported in the background; swapped in by a later AssetManager::update()
+        const uint32_t scheduled = assets_->reloadAll();
+        print_i("Reloading assets...", LogContext{ {"scheduled", scheduled} });
         return {};
     }
 
+    void AshbornEngine::pollHotReload() {
+        if (!hot_reload_) return;
+
+        const HotReloadChanges changes = hot_reload_->poll();
+        if (changes.empty()) return;
+
+        for (const auto& path : changes.assets) {
+            if (assets_) {
+                (void)assets_->reload(path);
+            }
+        }
+        if (!changes.shaders.empty()) {
+            (void)reloadShaders(changes.shaders);
+        }
+    }
+
+    void AshbornEngine::buildEntityDraws(const Frustum& frustum, std::span<const EntityRenderProxy> entities,
+        const EntityMeshTable& meshes, std::span<std::byte> instance_memory, EntityDrawList& out) {
+        if (!entity_batcher_) {
+            print_e("Entity draws requested before the renderer was initialized");
+            out.clear();
+            return;
+        }
+
+        entity_batcher_->build(frustum, entities, meshes, instance_memory, jobs_.get(), out);
+        stats_.entities_active = out.stats.entities;
+    }
+
     // ==========================================
     // STATISTICS
     // ==========================================
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <cstddef>
 #include <expected>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <string>
 #include <chrono>
 #include <optional>
 #include <filesystem>
+#include <span>
+
+#include "EngineErrors.h"
 
 // Forward declarations for subsystem types
 struct GLFWwindow;
@@ -15,84 +20,14 @@ struct VkDevice_T;
 
 namespace AshCore {
 
-    // ==========================================
-    // ERROR DEFINITIONS
-    // ==========================================
-
-    enum class EngineError {
-        None = 0,
-        AlreadyInitialized,
-        NotInitialized,
-        SubsystemFailure,
-        InvalidConfiguration,
-        Unknown
-    };
-
-    enum class RendererError {
-        None = 0,
-        VulkanInitFailed,
-        NoSuitableGPU,
-        SwapchainCreationFailed,
-        ValidationLayersUnavailable,
-        ExtensionNotSupported,
-        ShaderCompilationFailed,
-        OutOfGPUMemory,
-        Unknown
-    };
-
-    enum class WindowError {
-        None = 0,
-        GLFWInitFailed,
-        WindowCreationFailed,
-        MonitorNotFound,
-        InvalidDimensions,
-        SurfaceCreationFailed,
-        Unknown
-    };
-
-    enum class InputError {
-        None = 0,
-        InitializationFailed,
-        DeviceNotFound,
-        MappingFailed,
-        Unknown
-    };
-
-    enum class AudioError {
-        None = 0,
-        DeviceInitFailed,
-        NoOutputDevice,
-        FormatNotSupported,
-        BufferCreationFailed,
-        Unknown
-    };
-
-    enum class WorldError {
-        None = 0,
-        InitializationFailed,
-        InvalidConfiguration,
-        ChunkGenerationFailed,
-        SerializationFailed,
-        Unknown
-    };
-
-    enum class NetworkError {
-        None = 0,
-        InitializationFailed,
-        PortBindFailed,
-        SteamworksFailed,
-        ConnectionFailed,
-        Unknown
-    };
-
-    enum class AssetError {
-        None = 0,
-        InitializationFailed,
-        PathNotFound,
-        LoaderNotFound,
-        CorruptedAsset,
-        Unknown
-    };
+    class JobSystem;
+    class AssetManager;
+    class HotReloadWatcher;
+    class EntityInstanceBatcher;
+    class EntityMeshTable;
+    struct EntityRenderProxy;
+    struct EntityDrawList;
+    struct Frustum;
 
     // ==========================================
     // CONFIGURATION STRUCTURES
@@ -121,6 +56,7 @@ namespace AshCore {
         size_t vram_budget = 0;  // 0 = auto detect
         bool prefer_discrete_gpu = true;
         std::filesystem::path shader_cache_path = "Cache/Shaders";
+        std::filesystem::path shader_source_path = "Shaders";  // Watched for hot reload
     };
 
     struct InputConfig {
@@ -171,10 +107,12 @@ namespace AshCore {
     struct AssetConfig {
         std::vector<std::filesystem::path> asset_paths = { "Content" };
         bool enable_hot_reload = true;
+        uint32_t hot_reload_debounce_ms = 150;  // Quiet time before a changed file is reloaded
         bool validate_assets = true;
         size_t cache_size_mb = 512;
         bool async_loading = true;
         uint32_t loader_threads = 4;
+        double finalize_budget_ms = 2.0;  // Main-thread finalization per frame
     };
 
     struct EngineConfig {
@@ -237,6 +175,9 @@ namespace AshCore {
     // MAIN ENGINE CLASS
     // ==========================================
 
+    // Rebuilds pipelines from changed shader sources (empty span = all); false on compile errors
+    using ShaderReloadHandler = std::function<bool(std::span<const std::filesystem::path> changed)>;
+
     class AshbornEngine {
     public:
         // Lifecycle
@@ -289,14 +230,26 @@ namespace AshCore {
         [[nodiscard]] EngineStats getStats() const noexcept;
         [[nodiscard]] double getUptime() const noexcept;
 
+        // Once per frame after entity extraction: culls and batches entities into
+        // instanced draws on the job system, and updates entities_active
+        void buildEntityDraws(const Frustum& frustum, std::span<const EntityRenderProxy> entities,
+            const EntityMeshTable& meshes, std::span<std::byte> instance_memory, EntityDrawList& out);
+
         // Subsystem access (for main loop and game code)
         [[nodiscard]] GLFWwindow* getWindow() const noexcept { return window_; }
         [[nodiscard]] VkDevice_T* getDevice() const noexcept { return device_; }
         [[nodiscard]] VkInstance_T* getInstance() const noexcept { return instance_; }
+        [[nodiscard]] JobSystem* getJobSystem() const noexcept { return jobs_.get(); }
+        [[nodiscard]] AssetManager* getAssetManager() const noexcept { return assets_.get(); }
 
         // Hot reload support
         [[nodiscard]] std::expected<void, RendererError> reloadShaders();
+        [[nodiscard]] std::expected<void, RendererError> reloadShaders(std::span<const std::filesystem::path> changed);
         [[nodiscard]] std::expected<void, AssetError> reloadAssets();
+        void setShaderReloadHandler(ShaderReloadHandler handler) { shader_reload_handler_ = std::move(handler); }
+
+        // Once per frame before AssetManager::update(): forwards debounced file changes
+        void pollHotReload();
 
         // Profiling
         void beginProfile(const std::string& name) noexcept;
@@ -331,13 +284,19 @@ namespace AshCore {
         VkInstance_T* instance_ = nullptr;
         VkDevice_T* device_ = nullptr;
 
+        // Core services
+        std::unique_ptr<JobSystem> jobs_;
+
         // Subsystems (when we create them)
         // std::unique_ptr<Renderer> renderer_;
         // std::unique_ptr<World> world_;
         // std::unique_ptr<InputManager> input_;
         // std::unique_ptr<AudioSystem> audio_;
         // std::unique_ptr<NetworkManager> network_;
-        // std::unique_ptr<AssetManager> assets_;
+        std::unique_ptr<EntityInstanceBatcher> entity_batcher_;
+        std::unique_ptr<AssetManager> assets_;
+        std::unique_ptr<HotReloadWatcher> hot_reload_;
+        ShaderReloadHandler shader_reload_handler_;
 
         // Statistics tracking
         mutable EngineStats stats_{};
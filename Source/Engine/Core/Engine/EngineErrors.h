@@ -0,0 +1,87 @@
+#pragma once
+
+// Error enums shared by engine subsystems; light enough for any header
+
+namespace AshCore {
+
+    // ==========================================
+    // ERROR DEFINITIONS
+    // ==========================================
+
+    enum class EngineError {
+        None = 0,
+        AlreadyInitialized,
+        NotInitialized,
+        SubsystemFailure,
+        InvalidConfiguration,
+        Unknown
+    };
+
+    enum class RendererError {
+        None = 0,
+        VulkanInitFailed,
+        NoSuitableGPU,
+        SwapchainCreationFailed,
+        ValidationLayersUnavailable,
+        ExtensionNotSupported,
+        ShaderCompilationFailed,
+        OutOfGPUMemory,
+        InvalidRenderGraph,
+        Unknown
+    };
+
+    enum class WindowError {
+        None = 0,
+        GLFWInitFailed,
+        WindowCreationFailed,
+        MonitorNotFound,
+        InvalidDimensions,
+        SurfaceCreationFailed,
+        Unknown
+    };
+
+    enum class InputError {
+        None = 0,
+        InitializationFailed,
+        DeviceNotFound,
+        MappingFailed,
+        Unknown
+    };
+
+    enum class AudioError {
+        None = 0,
+        DeviceInitFailed,
+        NoOutputDevice,
+        FormatNotSupported,
+        BufferCreationFailed,
+        Unknown
+    };
+
+    enum class WorldError {
+        None = 0,
+        InitializationFailed,
+        InvalidConfiguration,
+        ChunkGenerationFailed,
+        SerializationFailed,
+        Unknown
+    };
+
+    enum class NetworkError {
+        None = 0,
+        InitializationFailed,
+        PortBindFailed,
+        SteamworksFailed,
+        ConnectionFailed,
+        Unknown
+    };
+
+    enum class AssetError {
+        None = 0,
+        InitializationFailed,
+        PathNotFound,
+        LoaderNotFound,
+        CorruptedAsset,
+        Unknown
+    };
+
+} // namespace AshCore
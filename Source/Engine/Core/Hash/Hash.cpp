@@ -0,0 +1,458 @@
+#include "ashbornpch.h"
+
+#include "Hash.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint32_t PRIME32_1 = 0x9E3779B1u;
+        constexpr uint32_t PRIME32_2 = 0x85EBCA77u;
+        constexpr uint32_t PRIME32_3 = 0xC2B2AE3Du;
+        constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ull;
+        constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ull;
+        constexpr uint64_t PRIME_MX1 = 0x165667919E3779F9ull;
+        constexpr uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ull;
+
+        constexpr size_t STRIPE_LEN = 64;
+        constexpr size_t SECRET_CONSUME_RATE = 8;  // Secret bytes advanced per stripe
+        constexpr size_t SECRET_SIZE = 192;
+        constexpr size_t SECRET_SIZE_MIN = 136;
+        constexpr size_t MIDSIZE_MAX = 240;
+        constexpr size_t MIDSIZE_START_OFFSET = 3;
+        constexpr size_t MIDSIZE_LAST_OFFSET = 17;
+        constexpr size_t SECRET_LASTACC_START = 7;
+        constexpr size_t SECRET_MERGEACCS_START = 11;
+
+        alignas(64) constexpr uint8_t DEFAULT_SECRET[SECRET_SIZE] = {
+            0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+            0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+            0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+            0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+            0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+            0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+            0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+            0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+            0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+            0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+            0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+            0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+        };
+
+        // ---- Primitives (input is read as little-endian on every platform)
+
+        uint32_t read32(const uint8_t* p) noexcept {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            if constexpr (std::endian::native == std::endian::big) value = std::byteswap(value);
+            return value;
+        }
+
+        uint64_t read64(const uint8_t* p) noexcept {
+            uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            if constexpr (std::endian::native == std::endian::big) value = std::byteswap(value);
+            return value;
+        }
+
+        void write64(uint8_t* p, uint64_t value) noexcept {
+            if constexpr (std::endian::native == std::endian::big) value = std::byteswap(value);
+            std::memcpy(p, &value, sizeof(value));
+        }
+
+        Hash128 multiply128(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+            __extension__ using uint128 = unsigned __int128;
+            const uint128 product = static_cast<uint128>(a) * b;
+            return { static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64) };
+#elif defined(_MSC_VER) && defined(_M_X64)
+            uint64_t high;
+            const uint64_t low = _umul128(a, b, &high);
+            return { low, high };
+#else
+            const uint64_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+            const uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+            const uint64_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+            const uint64_t hi_hi = (a >> 32) * (b >> 32);
+            const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+            return { (cross << 32) | (lo_lo & 0xFFFFFFFF), (hi_lo >> 32) + (cross >> 32) + hi_hi };
+#endif
+        }
+
+        uint64_t fold64(uint64_t a, uint64_t b) noexcept {
+            const Hash128 product = multiply128(a, b);
+            return product.low ^ product.high;
+        }
+
+        uint64_t xorshift(uint64_t value, int shift) noexcept {
+            return value ^ (value >> shift);
+        }
+
+        uint64_t avalancheXxh64(uint64_t hash) noexcept {
+            hash ^= hash >> 33;
+            hash *= PRIME64_2;
+            hash ^= hash >> 29;
+            hash *= PRIME64_3;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        uint64_t avalanche(uint64_t hash) noexcept {
+            hash = xorshift(hash, 37);
+            hash *= PRIME_MX1;
+            return xorshift(hash, 32);
+        }
+
+        uint64_t rrmxmx(uint64_t hash, uint64_t len) noexcept {
+            hash ^= std::rotl(hash, 49) ^ std::rotl(hash, 24);
+            hash *= PRIME_MX2;
+            hash ^= (hash >> 35) + len;
+            hash *= PRIME_MX2;
+            return xorshift(hash, 28);
+        }
+
+        uint64_t mix16(const uint8_t* input, const uint8_t* secret, uint64_t seed) noexcept {
+            return fold64(read64(input) ^ (read64(secret) + seed), read64(input + 8) ^ (read64(secret + 8) - seed));
+        }
+
+        // ---- Short inputs (up to 240 bytes) read the default secret directly
+
+        uint64_t hash64Short(const uint8_t* input, size_t len, const uint8_t* secret, uint64_t seed) noexcept {
+            if (len > 8) {
+                const uint64_t flip_lo = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+                const uint64_t flip_hi = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+                const uint64_t lo = read64(input) ^ flip_lo;
+                const uint64_t hi = read64(input + len - 8) ^ flip_hi;
+                return avalanche(len + std::byteswap(lo) + hi + fold64(lo, hi));
+            }
+            if (len >= 4) {
+                seed ^= static_cast<uint64_t>(std::byteswap(static_cast<uint32_t>(seed))) << 32;
+                const uint64_t flip = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+                const uint64_t combined = read32(input + len - 4) + (static_cast<uint64_t>(read32(input)) << 32);
+                return rrmxmx(combined ^ flip, len);
+            }
+            if (len > 0) {
+                const uint32_t combined = (uint32_t{ input[0] } << 16) | (uint32_t{ input[len >> 1] } << 24) |
+                    uint32_t{ input[len - 1] } | (static_cast<uint32_t>(len) << 8);
+                const uint64_t flip = (read32(secret) ^ read32(secret + 4)) + seed;
+                return avalancheXxh64(combined ^ flip);
+            }
+            return avalancheXxh64(seed ^ read64(secret + 56) ^ read64(secret + 64));
+        }
+
+        uint64_t hash64Medium(const uint8_t* input, size_t len, const uint8_t* secret, uint64_t seed) noexcept {
+            uint64_t acc = len * PRIME64_1;
+            if (len > 32) {
+                if (len > 64) {
+                    if (len > 96) {
+                        acc += mix16(input + 48, secret + 96, seed);
+                        acc += mix16(input + len - 64, secret + 112, seed);
+                    }
+                    acc += mix16(input + 32, secret + 64, seed);
+                    acc += mix16(input + len - 48, secret + 80, seed);
+                }
+                acc += mix16(input + 16, secret + 32, seed);
+                acc += mix16(input + len - 32, secret + 48, seed);
+            }
+            acc += mix16(input, secret, seed);
+            acc += mix16(input + len - 16, secret + 16, seed);
+            return avalanche(acc);
+        }
+
+        uint64_t hash64Mid(const uint8_t* input, size_t len, const uint8_t* secret, uint64_t seed) noexcept {
+            uint64_t acc = len * PRIME64_1;
+            for (size_t i = 0; i < 8; ++i) {
+                acc += mix16(input + 16 * i, secret + 16 * i, seed);
+            }
+            uint64_t acc_end = mix16(input + len - 16, secret + SECRET_SIZE_MIN - MIDSIZE_LAST_OFFSET, seed);
+            acc = avalanche(acc);
+            for (size_t i = 8; i < len / 16; ++i) {
+                acc_end += mix16(input + 16 * i, secret + 16 * (i - 8) + MIDSIZE_START_OFFSET, seed);
+            }
+            return avalanche(acc + acc_end);
+        }
+
+        Hash128 hash128Short(const uint8_t* input, size_t len, const uint8_t* secret, uint64_t seed) noexcept {
+            if (len > 8) {
+                const uint64_t flip_lo = (read64(secret + 32) ^ read64(secret + 40)) - seed;
+                const uint64_t flip_hi = (read64(secret + 48) ^ read64(secret + 56)) + seed;
+                const uint64_t lo = read64(input);
+                uint64_t hi = read64(input + len - 8);
+                Hash128 m = multiply128(lo ^ hi ^ flip_lo, PRIME64_1);
+                m.low += static_cast<uint64_t>(len - 1) << 54;
+                hi ^= flip_hi;
+                m.high += hi + static_cast<uint64_t>(static_cast<uint32_t>(hi)) * (PRIME32_2 - 1);
+                m.low ^= std::byteswap(m.high);
+
+                Hash128 h = multiply128(m.low, PRIME64_2);
+                h.high += m.high * PRIME64_2;
+                return { avalanche(h.low), avalanche(h.high) };
+            }
+            if (len >= 4) {
+                seed ^= static_cast<uint64_t>(std::byteswap(static_cast<uint32_t>(seed))) << 32;
+                const uint64_t combined = read32(input) + (static_cast<uint64_t>(read32(input + len - 4)) << 32);
+                const uint64_t flip = (read64(secret + 16) ^ read64(secret + 24)) + seed;
+                Hash128 m = multiply128(combined ^ flip, PRIME64_1 + (len << 2));
+                m.high += m.low << 1;
+                m.low ^= m.high >> 3;
+                m.low = xorshift(m.low, 35);
+                m.low *= PRIME_MX2;
+                m.low = xorshift(m.low, 28);
+                m.high = avalanche(m.high);
+                return m;
+            }
+            if (len > 0) {
+                const uint32_t combined_lo = (uint32_t{ input[0] } << 16) | (uint32_t{ input[len >> 1] } << 24) |
+                    uint32_t{ input[len - 1] } | (static_cast<uint32_t>(len) << 8);
+                const uint32_t combined_hi = std::rotl(std::byteswap(combined_lo), 13);
+                const uint64_t flip_lo = (read32(secret) ^ read32(secret + 4)) + seed;
+                const uint64_t flip_hi = (read32(secret + 8) ^ read32(secret + 12)) - seed;
+                return { avalancheXxh64(combined_lo ^ flip_lo), avalancheXxh64(combined_hi ^ flip_hi) };
+            }
+            return { avalancheXxh64(seed ^ read64(secret + 64) ^ read64(secret + 72)),
+                avalancheXxh64(seed ^ read64(secret + 80) ^ read64(secret + 88)) };
+        }
+
+        Hash128 mix32(Hash128 acc, const uint8_t* input_a, const uint8_t* input_b, const uint8_t* secret, uint64_t seed) noexcept {
+            acc.low += mix16(input_a, secret, seed);
+            acc.low ^= read64(input_b) + read64(input_b + 8);
+            acc.high += mix16(input_b, secret + 16, seed);
+            acc.high ^= read64(input_a) + read64(input_a + 8);
+            return acc;
+        }
+
+        Hash128 finish128(const Hash128& acc, size_t len, uint64_t seed) noexcept {
+            const uint64_t low = acc.low + acc.high;
+            const uint64_t high = acc.low * PRIME64_1 + acc.high * PRIME64_4 + (len - seed) * PRIME64_2;
+            return { avalanche(low), 0 - avalanche(high) };
+        }
+
+        Hash128 hash128Medium(const uint8_t* input, size_t len, const uint8_t* secret, uint64_t seed) noexcept {
+            Hash128 acc{ len * PRIME64_1, 0 };
+            if (len > 32) {
+                if (len > 64) {
+                    if (len > 96) {
+                        acc = mix32(acc, input + 48, input + len - 64, secret + 96, seed);
+                    }
+                    acc = mix32(acc, input + 32, input + len - 48, secret + 64, seed);
+                }
+                acc = mix32(acc, input + 16, input + len - 32, secret + 32, seed);
+            }
+            acc = mix32(acc, input, input + len - 16, secret, seed);
+            return finish128(acc, len, seed);
+        }
+
+        Hash128 hash128Mid(const uint8_t* input, size_t len, const uint8_t* secret, uint64_t seed) noexcept {
+            Hash128 acc{ len * PRIME64_1, 0 };
+            for (size_t i = 32; i < 160; i += 32) {
+                acc = mix32(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+            }
+            acc = { avalanche(acc.low), avalanche(acc.high) };
+            for (size_t i = 160; i <= len; i += 32) {
+                acc = mix32(acc, input + i - 32, input + i - 16, secret + MIDSIZE_START_OFFSET + i - 160, seed);
+            }
+            acc = mix32(acc, input + len - 16, input + len - 32, secret + SECRET_SIZE_MIN - MIDSIZE_LAST_OFFSET - 16, 0 - seed);
+            return finish128(acc, len, seed);
+        }
+
+        // ---- Long inputs: eight 64-bit lanes fed one 64-byte stripe at a time
+
+        struct ScalarKernel {
+            static void accumulate(uint64_t* acc, const uint8_t* input, const uint8_t* secret) noexcept {
+                for (size_t lane = 0; lane < 8; ++lane) {
+                    const uint64_t data = read64(input + lane * 8);
+                    const uint64_t key = data ^ read64(secret + lane * 8);
+                    acc[lane ^ 1] += data;
+                    acc[lane] += (key & 0xFFFFFFFF) * (key >> 32);
+                }
+            }
+
+            static void scramble(uint64_t* acc, const uint8_t* secret) noexcept {
+                for (size_t lane = 0; lane < 8; ++lane) {
+                    acc[lane] = (xorshift(acc[lane], 47) ^ read64(secret + lane * 8)) * PRIME32_1;
+                }
+            }
+        };
+
+#if defined(__AVX2__)
+        struct Avx2Kernel {
+            static void accumulate(uint64_t* acc, const uint8_t* input, const uint8_t* secret) noexcept {
+                auto* lanes = reinterpret_cast<__m256i*>(acc);
+                for (size_t i = 0; i < 2; ++i) {
+                    const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input) + i);
+                    const __m256i key = _mm256_xor_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+                    const __m256i product = _mm256_mul_epu32(key, _mm256_srli_epi64(key, 32));
+                    const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+                    _mm256_store_si256(lanes + i, _mm256_add_epi64(product, _mm256_add_epi64(_mm256_load_si256(lanes + i), swapped)));
+                }
+            }
+
+            static void scramble(uint64_t* acc, const uint8_t* secret) noexcept {
+                auto* lanes = reinterpret_cast<__m256i*>(acc);
+                const __m256i prime = _mm256_set1_epi32(static_cast<int>(PRIME32_1));
+                for (size_t i = 0; i < 2; ++i) {
+                    const __m256i value = _mm256_load_si256(lanes + i);
+                    const __m256i shifted = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+                    const __m256i keyed = _mm256_xor_si256(shifted, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+                    const __m256i low = _mm256_mul_epu32(keyed, prime);
+                    const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(keyed, 32), prime);
+                    _mm256_store_si256(lanes + i, _mm256_add_epi64(low, _mm256_slli_epi64(high, 32)));
+                }
+            }
+        };
+#endif
+
+        using LongAccumulator = std::array<uint64_t, 8>;
+
+        template<typename Kernel>
+        void hashLongLoop(LongAccumulator& acc, const uint8_t* input, size_t len, const uint8_t* secret) noexcept {
+            const size_t stripes_per_block = (SECRET_SIZE - STRIPE_LEN) / SECRET_CONSUME_RATE;
+            const size_t block_len = STRIPE_LEN * stripes_per_block;
+            const size_t blocks = (len - 1) / block_len;
+
+            for (size_t block = 0; block < blocks; ++block) {
+                const uint8_t* data = input + block * block_len;
+                for (size_t stripe = 0; stripe < stripes_per_block; ++stripe) {
+                    Kernel::accumulate(acc.data(), data + stripe * STRIPE_LEN, secret + stripe * SECRET_CONSUME_RATE);
+                }
+                Kernel::scramble(acc.data(), secret + SECRET_SIZE - STRIPE_LEN);
+            }
+
+            const uint8_t* tail = input + blocks * block_len;
+            const size_t stripes = ((len - 1) - blocks * block_len) / STRIPE_LEN;
+            for (size_t stripe = 0; stripe < stripes; ++stripe) {
+                Kernel::accumulate(acc.data(), tail + stripe * STRIPE_LEN, secret + stripe * SECRET_CONSUME_RATE);
+            }
+            // The last stripe always ends at the input's end, overlapping the previous one if needed
+            Kernel::accumulate(acc.data(), input + len - STRIPE_LEN, secret + SECRET_SIZE - STRIPE_LEN - SECRET_LASTACC_START);
+        }
+
+        uint64_t mergeAccumulators(const LongAccumulator& acc, const uint8_t* secret, uint64_t start) noexcept {
+            uint64_t result = start;
+            for (size_t i = 0; i < 4; ++i) {
+                result += fold64(acc[2 * i] ^ read64(secret + 16 * i), acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+            }
+            return avalanche(result);
+        }
+
+        // Seeded long hashes use the default secret shifted by the seed
+        const uint8_t* longSecret(uint64_t seed, uint8_t* storage) noexcept {
+            if (seed == 0) return DEFAULT_SECRET;
+            for (size_t i = 0; i < SECRET_SIZE / 16; ++i) {
+                write64(storage + 16 * i, read64(DEFAULT_SECRET + 16 * i) + seed);
+                write64(storage + 16 * i + 8, read64(DEFAULT_SECRET + 16 * i + 8) - seed);
+            }
+            return storage;
+        }
+
+        constexpr LongAccumulator INITIAL_ACCUMULATOR = { PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1 };
+
+        template<typename Kernel>
+        uint64_t hash64With(const uint8_t* input, size_t len, uint64_t seed) noexcept {
+            if (len <= 16) return hash64Short(input, len, DEFAULT_SECRET, seed);
+            if (len <= 128) return hash64Medium(input, len, DEFAULT_SECRET, seed);
+            if (len <= MIDSIZE_MAX) return hash64Mid(input, len, DEFAULT_SECRET, seed);
+
+            alignas(64) uint8_t storage[SECRET_SIZE];
+            const uint8_t* secret = longSecret(seed, storage);
+            alignas(32) LongAccumulator acc = INITIAL_ACCUMULATOR;
+            hashLongLoop<Kernel>(acc, input, len, secret);
+            return mergeAccumulators(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1);
+        }
+
+        template<typename Kernel>
+        Hash128 hash128With(const uint8_t* input, size_t len, uint64_t seed) noexcept {
+            if (len <= 16) return hash128Short(input, len, DEFAULT_SECRET, seed);
+            if (len <= 128) return hash128Medium(input, len, DEFAULT_SECRET, seed);
+            if (len <= MIDSIZE_MAX) return hash128Mid(input, len, DEFAULT_SECRET, seed);
+
+            alignas(64) uint8_t storage[SECRET_SIZE];
+            const uint8_t* secret = longSecret(seed, storage);
+            alignas(32) LongAccumulator acc = INITIAL_ACCUMULATOR;
+            hashLongLoop<Kernel>(acc, input, len, secret);
+            return { mergeAccumulators(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1),
+                mergeAccumulators(acc, secret + SECRET_SIZE - sizeof(acc) - SECRET_MERGEACCS_START, ~(len * PRIME64_2)) };
+        }
+
+#if defined(__AVX2__)
+        using DefaultKernel = Avx2Kernel;
+#else
+        using DefaultKernel = ScalarKernel;
+#endif
+
+        const uint8_t* bytesOf(std::span<const std::byte> data) noexcept {
+            return reinterpret_cast<const uint8_t*>(data.data());
+        }
+    }
+
+    uint64_t hash64(std::span<const std::byte> data, uint64_t seed) noexcept {
+        return hash64With<DefaultKernel>(bytesOf(data), data.size(), seed);
+    }
+
+    Hash128 hash128(std::span<const std::byte> data, uint64_t seed) noexcept {
+        return hash128With<DefaultKernel>(bytesOf(data), data.size(), seed);
+    }
+
+    bool isHashSimdAvailable() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::vector<HashBenchmarkResult> benchmarkHash(std::span<const size_t> sizes, uint32_t iterations) {
+        using Clock = std::chrono::steady_clock;
+        std::vector<HashBenchmarkResult> results;
+        results.reserve(sizes.size());
+
+        for (const size_t size : sizes) {
+            std::mt19937_64 rng(1337);
+            std::vector<uint8_t> buffer(size);
+            for (uint8_t& b : buffer) b = static_cast<uint8_t>(rng());
+
+            HashBenchmarkResult result;
+            result.bytes = size;
+            // Small inputs need many more calls to get a measurable time
+            result.iterations = std::max(iterations, 1u) * static_cast<uint32_t>(std::clamp<size_t>((1u << 20) / std::max<size_t>(size, 1), 1, 4096));
+
+            auto run = [&](auto kernel) -> double {
+                using Kernel = decltype(kernel);
+                uint64_t sink = hash64With<Kernel>(buffer.data(), size, 0);  // Warm up caches
+                const auto start = Clock::now();
+                for (uint32_t iteration = 0; iteration < result.iterations; ++iteration) {
+                    sink += hash64With<Kernel>(buffer.data(), size, sink);
+                }
+                const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+                volatile uint64_t keep = sink;
+                (void)keep;
+                return seconds > 0.0 ? static_cast<double>(size) * result.iterations / seconds / 1e9 : 0.0;
+                };
+
+            result.scalar_gbps = run(ScalarKernel{});
+            result.simd_gbps = isHashSimdAvailable() ? run(DefaultKernel{}) : result.scalar_gbps;
+            if (result.scalar_gbps > 0.0) {
+                result.speedup = result.simd_gbps / result.scalar_gbps;
+            }
+            results.push_back(result);
+        }
+        return results;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // CONTENT HASHING
+    // ==========================================
+
+    // XXH3, bit-compatible with xxHash's XXH3_64bits_withSeed and
+    // XXH3_128bits_withSeed, so hashes can be checked against the reference
+    // tool. Not cryptographic: for integrity checks, dedup and cache keys.
+    // Inputs over 240 bytes run through 64-byte stripes, AVX2 when compiled in.
+
+    struct Hash128 {
+        uint64_t low = 0;
+        uint64_t high = 0;
+
+        auto operator<=>(const Hash128&) const = default;
+    };
+
+    [[nodiscard]] uint64_t hash64(std::span<const std::byte> data, uint64_t seed = 0) noexcept;
+    [[nodiscard]] Hash128 hash128(std::span<const std::byte> data, uint64_t seed = 0) noexcept;
+
+    [[nodiscard]] inline uint64_t hash64(std::string_view text, uint64_t seed = 0) noexcept {
+        return hash64(std::as_bytes(std::span(text.data(), text.size())), seed);
+    }
+
+    [[nodiscard]] bool isHashSimdAvailable() noexcept;
+
+    struct HashBenchmarkResult {
+        size_t bytes = 0;
+        uint32_t iterations = 0;
+        double scalar_gbps = 0.0;
+        double simd_gbps = 0.0;
+        double speedup = 0.0;
+    };
+
+    inline constexpr std::array<size_t, 4> DEFAULT_HASH_BENCHMARK_SIZES = { 64, 4 * 1024, 256 * 1024, 16 * 1024 * 1024 };
+
+    // hash64 throughput over random buffers, one result per size
+    [[nodiscard]] std::vector<HashBenchmarkResult> benchmarkHash(std::span<const size_t> sizes = DEFAULT_HASH_BENCHMARK_SIZES,
+        uint32_t iterations = 20);
+
+} // namespace AshCore
@@ -0,0 +1,329 @@
+#include "ashbornpch.h"
+
+#include "AsyncIo.h"
+#include "Jobs/JobSystem.h"
+#include "Platform/IoRing.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+
+namespace AshCore {
+
+    namespace {
+        // One kernel read is capped well below its 32-bit length; larger files take several
+        constexpr uint64_t MAX_READ_SIZE = 1ull << 30;
+    }
+
+    // ==========================================
+    // CONSTRUCTOR / DESTRUCTOR
+    // ==========================================
+
+    AsyncIo::AsyncIo(JobSystem* jobs, const AsyncIoConfig& config)
+        : jobs_(jobs), config_(config) {
+
+        if (config_.use_io_uring) {
+            ring_ = IoRing::create(std::max(config_.queue_depth, 1u));
+        }
+        if (ring_) {
+            completion_thread_ = std::thread([this]() { completionLoop(); });
+        }
+        else {
+            pool_ = std::make_unique<JobSystem>(std::max(config_.fallback_threads, 1u), "AsyncIo");
+        }
+
+        print_d("Async I/O started", LogContext{
+            {"backend", ring_ ? "io_uring" : "thread_pool"},
+            {"queue_depth", ring_ ? ring_->getCapacity() : 0u}
+            });
+    }
+
+    AsyncIo::~AsyncIo() {
+        if (ring_) {
+            bool woken;
+            {
+                std::lock_guard lock(queue_mutex_);
+                stopping_ = true;
+                woken = ring_->wake();
+            }
+            // A dropped wake would leave the completion thread blocked for
+            // good; completions it reaps meanwhile free the queue again
+            while (!woken) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                std::lock_guard lock(queue_mutex_);
+                woken = completion_stopped_ || ring_->wake();
+            }
+            completion_thread_.join();
+        }
+        pool_.reset();
+    }
+
+    AsyncIoStats AsyncIo::getStats() const {
+        std::lock_guard lock(queue_mutex_);
+        AsyncIoStats stats = stats_;
+        stats.in_flight = in_flight_;
+        stats.queued = static_cast<uint32_t>(queued_.size());
+        return stats;
+    }
+
+    // ==========================================
+    // REQUESTS
+    // ==========================================
+
+    Task<FileReadResult> AsyncIo::read(FileReadRequest request) {
+        std::vector<FileReadRequest> requests;
+        requests.push_back(std::move(request));
+        std::vector<FileReadResult> results = co_await readBatch(std::move(requests));
+        co_return std::move(results.front());
+    }
+
+    Task<std::vector<FileReadResult>> AsyncIo::readBatch(std::vector<FileReadRequest> requests) {
+        Batch batch;
+        batch.requests = std::move(requests);
+        batch.results.resize(batch.requests.size());
+        batch.operations.resize(batch.requests.size());
+
+        co_await BatchAwaiter{ *this, batch };
+        co_return std::move(batch.results);
+    }
+
+    bool AsyncIo::BatchAwaiter::await_suspend(std::coroutine_handle<> handle) {
+        batch.waiter = handle;
+        // Our own count keeps reads that finish during start() from resuming us early
+        batch.remaining.store(batch.requests.size() + 1, std::memory_order_relaxed);
+        io.start(batch);
+        return batch.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void AsyncIo::start(Batch& batch) {
+        for (size_t i = 0; i < batch.operations.size(); ++i) {
+            Operation& operation = batch.operations[i];
+            operation.batch = &batch;
+            operation.index = i;
+        }
+
+        if (!ring_) {
+            {
+                std::lock_guard lock(queue_mutex_);
+                stats_.submissions += batch.operations.size();
+            }
+            for (Operation& operation : batch.operations) {
+                pool_->submit([this, &operation]() { readBlocking(operation); });
+            }
+            return;
+        }
+
+        Finished finished;
+        {
+            std::lock_guard lock(queue_mutex_);
+            for (Operation& operation : batch.operations) queued_.push_back(&operation);
+            pump(finished);
+        }
+        for (auto& [operation, result] : finished) {
+            finish(*operation, std::move(result));
+        }
+    }
+
+    void AsyncIo::finish(Operation& operation, FileReadResult result) {
+        closeFile(operation);
+        {
+            std::lock_guard lock(queue_mutex_);
+            ++stats_.reads;
+            if (result) stats_.bytes += result->size();
+        }
+
+        // The batch lives in the awaiting coroutine; the last read may hand it back
+        Batch& batch = *operation.batch;
+        batch.results[operation.index] = std::move(result);
+        if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            resumeOn(batch.waiter, jobs_);
+        }
+    }
+
+    void AsyncIo::closeFile(Operation& operation) noexcept {
+        if (operation.file >= 0) {
+            IoRing::closeFile({ operation.file, 0 });
+            operation.file = -1;
+        }
+    }
+
+    // ==========================================
+    // THREAD POOL FALLBACK
+    // ==========================================
+
+    void AsyncIo::readBlocking(Operation& operation) {
+        {
+            std::lock_guard lock(queue_mutex_);
+            stats_.peak_in_flight = std::max(stats_.peak_in_flight, ++in_flight_);
+        }
+
+        const FileReadRequest& request = operation.batch->requests[operation.index];
+        FileReadResult result = std::unexpected(AssetError::PathNotFound);
+        std::ifstream stream(request.path, std::ios::binary | std::ios::ate);
+        if (stream) {
+            const auto file_size = static_cast<uint64_t>(stream.tellg());
+            if (request.offset > file_size) {
+                result = std::unexpected(AssetError::CorruptedAsset);
+            }
+            else {
+                std::vector<std::byte> bytes(std::min(request.size, file_size - request.offset));
+                stream.seekg(static_cast<std::streamoff>(request.offset));
+                if (stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+                    result = std::move(bytes);
+                }
+                else {
+                    result = std::unexpected(AssetError::CorruptedAsset);
+                }
+            }
+        }
+
+        {
+            std::lock_guard lock(queue_mutex_);
+            --in_flight_;
+        }
+        finish(operation, std::move(result));
+    }
+
+    // ==========================================
+    // IO_URING
+    // ==========================================
+
+    std::optional<FileReadResult> AsyncIo::open(Operation& operation, bool can_wait) {
+        const FileReadRequest& request = operation.batch->requests[operation.index];
+        const auto file = IoRing::openFile(request.path);
+        if (!file) {
+            if ((file.error() == EMFILE || file.error() == ENFILE) && can_wait) {
+                return std::nullopt;
+            }
+            if (file.error() == ENOENT || file.error() == ENOTDIR) {
+                return std::unexpected(AssetError::PathNotFound);
+            }
+            print_w("Failed to open file", LogContext{ {"path", request.path.string()}, {"errno", file.error()} });
+            return std::unexpected(AssetError::Unknown);
+        }
+
+        operation.file = file->handle;
+        if (request.offset > file->size) {
+            return std::unexpected(AssetError::CorruptedAsset);
+        }
+        const uint64_t size = std::min(request.size, file->size - request.offset);
+        if (size == 0) {
+            return std::vector<std::byte>{};
+        }
+        operation.offset = request.offset;
+        operation.bytes.resize(size);
+        return std::nullopt;
+    }
+
+    void AsyncIo::pump(Finished& finished) {
+        const uint32_t capacity = ring_->getCapacity();
+        const size_t free_slots = capacity - std::min(in_flight_, capacity);
+
+        // Files open only when their read gets a slot, so at most
+        // queue_depth descriptors are held however large the batch
+        std::vector<Operation*> ready;
+        while (ready.size() < free_slots && !queued_.empty()) {
+            Operation& operation = *queued_.front();
+            if (operation.file < 0) {
+                std::optional<FileReadResult> result = open(operation, in_flight_ > 0 || !ready.empty());
+                if (result) {
+                    queued_.pop_front();
+                    finished.push_back({ &operation, std::move(*result) });
+                    continue;
+                }
+                if (operation.file < 0) break;  // Retried on the next completion
+            }
+            queued_.pop_front();
+            ready.push_back(&operation);
+        }
+        if (ready.empty()) return;
+
+        std::vector<IoRing::Read> reads;
+        reads.reserve(ready.size());
+        for (Operation* operation : ready) {
+            const uint64_t remaining = operation->bytes.size() - operation->done;
+            reads.push_back({
+                operation->file,
+                operation->bytes.data() + operation->done,
+                operation->offset + operation->done,
+                static_cast<uint32_t>(std::min(remaining, MAX_READ_SIZE)),
+                reinterpret_cast<uint64_t>(operation)
+                });
+        }
+
+        const uint32_t taken = ring_->submit(reads);
+        queued_.insert(queued_.begin(), ready.begin() + taken, ready.end());
+        in_flight_ += taken;
+        ++stats_.submissions;
+        stats_.peak_in_flight = std::max(stats_.peak_in_flight, in_flight_);
+
+        // Nothing in flight means no completion will come to retry these
+        if (taken == 0 && in_flight_ == 0) {
+            print_e("io_uring rejected reads", LogContext{ {"count", queued_.size()}, {"errno", errno} });
+            for (Operation* operation : queued_) finished.push_back({ operation, std::unexpected(AssetError::Unknown) });
+            queued_.clear();
+        }
+    }
+
+    void AsyncIo::completionLoop() {
+        std::vector<IoRing::Completion> completions;
+        std::vector<Operation*> retry;
+        Finished finished;
+
+        while (true) {
+            completions.clear();
+            ring_->wait(completions);
+
+            bool stop;
+            {
+                // Also orders the reads of each operation after the thread that queued it
+                std::lock_guard lock(queue_mutex_);
+                for (const IoRing::Completion& completion : completions) {
+                    if (completion.user_data == 0) continue;  // wake()
+                    --in_flight_;
+
+                    Operation& operation = *reinterpret_cast<Operation*>(completion.user_data);
+                    if (completion.result == -EAGAIN || completion.result == -EINTR) {
+                        retry.push_back(&operation);
+                    }
+                    else if (completion.result <= 0) {
+                        // 0 means the file shrank under us
+                        print_w("Async read failed", LogContext{
+                            {"path", operation.batch->requests[operation.index].path.string()},
+                            {"errno", -completion.result}
+                            });
+                        closeFile(operation);
+                        finished.push_back({ &operation, std::unexpected(AssetError::CorruptedAsset) });
+                    }
+                    else {
+                        operation.done += static_cast<uint64_t>(completion.result);
+                        if (operation.done < operation.bytes.size()) {
+                            retry.push_back(&operation);
+                        }
+                        else {
+                            // Closed here so a read waiting on a descriptor can open in pump()
+                            closeFile(operation);
+                            finished.push_back({ &operation, std::move(operation.bytes) });
+                        }
+                    }
+                }
+
+                // Short reads continue ahead of new work
+                queued_.insert(queued_.begin(), retry.begin(), retry.end());
+                pump(finished);
+                stop = stopping_ && in_flight_ == 0 && queued_.empty();
+                completion_stopped_ = stop;
+            }
+            retry.clear();
+
+            for (auto& [operation, result] : finished) {
+                finish(*operation, std::move(result));
+            }
+            finished.clear();
+
+            if (stop) return;
+        }
+    }
+
+} // namespace AshCore
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Engine/EngineErrors.h"
+#include "Jobs/Task.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace AshCore {
+
+    class IoRing;
+    class JobSystem;
+
+    // ==========================================
+    // REQUESTS
+    // ==========================================
+
+    struct AsyncIoConfig {
+        uint32_t queue_depth = 1024;     // Reads (and open files) in flight at once; the rest queue up
+        uint32_t fallback_threads = 4;   // Blocking readers when io_uring is unavailable
+        bool use_io_uring = true;
+    };
+
+    enum class AsyncIoBackend : uint8_t {
+        IoUring = 0,
+        ThreadPool
+    };
+
+    struct FileReadRequest {
+        static constexpr uint64_t WHOLE_FILE = UINT64_MAX;
+
+        std::filesystem::path path;
+        uint64_t offset = 0;
+        uint64_t size = WHOLE_FILE;      // Clamped to the end of the file
+    };
+
+    using FileReadResult = std::expected<std::vector<std::byte>, AssetError>;
+
+    struct AsyncIoStats {
+        uint64_t reads = 0;
+        uint64_t bytes = 0;
+        uint64_t submissions = 0;        // io_uring_enter calls, or pool jobs
+        uint32_t in_flight = 0;          // Kernel reads (io_uring) or running jobs
+        uint32_t peak_in_flight = 0;
+        uint32_t queued = 0;             // Waiting for a free slot
+    };
+
+    // ==========================================
+    // ASYNC IO
+    // ==========================================
+
+    /**
+     * @brief Coroutine file reads, batched through io_uring
+     *
+     * Asset and region loading can be written as straight-line coroutines:
+     *
+     *     auto bytes = co_await io.read({ path });
+     *     auto image = co_await runJob(jobs, [&]() { return decode(*bytes); });
+     *     co_await uploads.completion(*uploads.enqueueImage(...));
+     *
+     * On Linux every readBatch() goes to the kernel in one system call and a
+     * single completion thread reaps the results, so thousands of reads can
+     * be outstanding without a thread blocked on each; up to queue_depth
+     * are in the kernel at once. Without io_uring (other platforms, old
+     * kernels, sandboxes that forbid it) a small pool of threads does
+     * blocking reads instead.
+     *
+     * The awaiting coroutine resumes as a job on the given job system, or
+     * on the completion thread when it is null (fine for code that only
+     * collects bytes). Destruction waits for reads in flight.
+     */
+    class AsyncIo {
+    public:
+        explicit AsyncIo(JobSystem* jobs, const AsyncIoConfig& config = {});
+        ~AsyncIo();
+
+        AsyncIo(const AsyncIo&) = delete;
+        AsyncIo& operator=(const AsyncIo&) = delete;
+
+        [[nodiscard]] Task<FileReadResult> read(FileReadRequest request);
+
+        // Results in request order; a missing file fails only its own entry
+        [[nodiscard]] Task<std::vector<FileReadResult>> readBatch(std::vector<FileReadRequest> requests);
+
+        [[nodiscard]] AsyncIoBackend getBackend() const noexcept { return ring_ ? AsyncIoBackend::IoUring : AsyncIoBackend::ThreadPool; }
+        [[nodiscard]] AsyncIoStats getStats() const;
+
+    private:
+        struct Batch;
+
+        struct Operation {
+            Batch* batch = nullptr;
+            size_t index = 0;
+            int64_t file = -1;           // Opened once the read gets a ring slot
+            uint64_t offset = 0;         // Of bytes[0] in the file
+            uint64_t done = 0;           // Bytes read so far
+            std::vector<std::byte> bytes;
+        };
+
+        struct Batch {
+            std::vector<FileReadRequest> requests;
+            std::vector<FileReadResult> results;
+            std::vector<Operation> operations;
+            std::atomic<size_t> remaining{ 0 };
+            std::coroutine_handle<> waiter;
+        };
+
+        struct BatchAwaiter {
+            AsyncIo& io;
+            Batch& batch;
+
+            bool await_ready() const noexcept { return batch.requests.empty(); }
+            bool await_suspend(std::coroutine_handle<> handle);
+            void await_resume() const noexcept {}
+        };
+
+        using Finished = std::vector<std::pair<Operation*, FileReadResult>>;
+
+        void start(Batch& batch);
+        void readBlocking(Operation& operation);
+        void finish(Operation& operation, FileReadResult result);
+        static void closeFile(Operation& operation) noexcept;
+
+        // io_uring
+        void completionLoop();
+        // Opens the files of queued reads and moves them into free ring
+        // slots; reads that end early go to finished. queue_mutex_ held
+        void pump(Finished& finished);
+        // nullopt once the read is ready, or when it should wait for a
+        // descriptor (can_wait: reads in flight will close some)
+        [[nodiscard]] std::optional<FileReadResult> open(Operation& operation, bool can_wait);
+
+    private:
+        JobSystem* jobs_;
+        AsyncIoConfig config_;
+
+        std::unique_ptr<IoRing> ring_;
+        std::thread completion_thread_;
+        std::unique_ptr<JobSystem> pool_;  // Fallback backend
+
+        mutable std::mutex queue_mutex_;
+        std::deque<Operation*> queued_;
+        uint32_t in_flight_ = 0;
+        bool stopping_ = false;
+        bool completion_stopped_ = false;  // The loop saw stopping_ and returned; no wake needed
+        AsyncIoStats stats_;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,220 @@
+#include "ashbornpch.h"
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace AshCore {
+
+    namespace {
+        // Identifies the pool (and slot) the current thread works for
+        struct ThreadSlot {
+            const JobSystem* owner = nullptr;
+            uint32_t index = 0;
+        };
+        thread_local ThreadSlot t_slot;
+    }
+
+    // ==========================================
+    // CONSTRUCTOR / DESTRUCTOR
+    // ==========================================
+
+    JobSystem::JobSystem(uint32_t worker_count, const char* name)
+        : name_(name), owner_(std::this_thread::get_id()) {
+
+        if (worker_count == 0) {
+            unsigned int hw = std::thread::hardware_concurrency();
+            worker_count = hw > 1 ? hw - 1 : 1;
+        }
+
+        workers_.reserve(worker_count);
+        for (uint32_t i = 0; i < worker_count; ++i) {
+            workers_.emplace_back([this, i]() { workerLoop(i + 1); });
+        }
+
+        print_d("Job system started", LogContext{
+            {"name", std::string(name_)},
+            {"workers", worker_count}
+            });
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+
+        print_d("Job system stopped", LogContext{ {"name", std::string(name_)} });
+    }
+
+    // ==========================================
+    // SUBMISSION
+    // ==========================================
+
+    void JobSystem::submit(Job job) {
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push_back({ std::move(job), nullptr });
+        }
+        wake_.notify_one();
+        idle_.notify_all();
+    }
+
+    void JobSystem::submit(JobCounter& counter, Job job) {
+        counter.pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(mutex_);
+            queue_.push_back({ std::move(job), &counter });
+        }
+        wake_.notify_one();
+        idle_.notify_all();
+    }
+
+    void JobSystem::wait(JobCounter& counter) {
+        const bool helps = ownsThreadSlot();
+        while (!counter.isDone()) {
+            if (tryRunOne()) continue;
+
+            // Checked under the lock that queueing and draining notify under
+            std::unique_lock lock(mutex_);
+            idle_.wait(lock, [&]() { return counter.isDone() || (helps && !queue_.empty()); });
+        }
+
+        if (counter.failed_.load(std::memory_order_acquire)) {
+            std::exception_ptr exception = std::exchange(counter.exception_, nullptr);
+            counter.failed_.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void JobSystem::parallelFor(size_t count, size_t batch_size, const RangeJob& fn) {
+        if (count == 0) return;
+
+        batch_size = std::max<size_t>(batch_size, 1);
+        const size_t batch_count = (count + batch_size - 1) / batch_size;
+
+        // A thread without a slot must not run fn: it would share slot 0
+        const bool inline_first = ownsThreadSlot();
+
+        // Not worth a round trip through the queue
+        if (batch_count == 1 && inline_first) {
+            fn(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (size_t batch = inline_first ? 1 : 0; batch < batch_count; ++batch) {
+            const size_t begin = batch * batch_size;
+            const size_t end = std::min(begin + batch_size, count);
+            submit(counter, [&fn, begin, end]() { fn(begin, end); });
+        }
+
+        // The calling thread takes the first batch itself
+        if (inline_first) {
+            try {
+                fn(0, std::min(batch_size, count));
+            }
+            catch (...) {
+                // Queued batches still reference fn and counter on this frame;
+                // theirs lose to this exception
+                try { wait(counter); }
+                catch (...) {}
+                throw;
+            }
+        }
+        wait(counter);
+    }
+
+    uint32_t JobSystem::getThreadIndex() const noexcept {
+        return t_slot.owner == this ? t_slot.index : 0;
+    }
+
+    bool JobSystem::ownsThreadSlot() const noexcept {
+        return t_slot.owner == this || std::this_thread::get_id() == owner_;
+    }
+
+    // ==========================================
+    // INTERNAL
+    // ==========================================
+
+    void JobSystem::workerLoop(uint32_t index) {
+        t_slot = { this, index };
+
+        while (true) {
+            QueuedJob queued;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+
+                if (queue_.empty()) {
+                    return;  // Stopping and drained
+                }
+
+                queued = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            execute(queued);
+        }
+    }
+
+    bool JobSystem::tryRunOne() {
+        if (!ownsThreadSlot()) {
+            return false;
+        }
+
+        QueuedJob queued;
+        {
+            std::lock_guard lock(mutex_);
+            if (queue_.empty()) {
+                return false;
+            }
+            queued = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        execute(queued);
+        return true;
+    }
+
+    void JobSystem::execute(QueuedJob& queued) {
+        try {
+            queued.job();
+        }
+        catch (const std::exception& e) {
+            if (!captureException(queued)) {
+                print_e("Unhandled exception in job", LogContext{
+                    {"pool", std::string(name_)},
+                    {"what", std::string(e.what())}
+                    });
+            }
+        }
+        catch (...) {
+            if (!captureException(queued)) {
+                print_e("Unknown exception in job", LogContext{ {"pool", std::string(name_)} });
+            }
+        }
+
+        if (queued.counter && queued.counter->pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // The lock orders this against a waiter between its check and its sleep
+            { std::lock_guard lock(mutex_); }
+            idle_.notify_all();
+        }
+    }
+
+    bool JobSystem::captureException(QueuedJob& queued) noexcept {
+        if (!queued.counter) return false;
+        // Later exceptions of the same counter are dropped; wait() rethrows the first
+        if (!queued.counter->failed_.exchange(true, std::memory_order_relaxed)) {
+            queued.counter->exception_ = std::current_exception();
+        }
+        return true;
+    }
+
+} // namespace AshCore
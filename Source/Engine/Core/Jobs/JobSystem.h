@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // JOB COUNTER
+    // ==========================================
+
+    // Tracks a group of submitted jobs so callers can wait on them; the
+    // first exception one of them throws is kept for wait() to rethrow
+    class JobCounter {
+    public:
+        [[nodiscard]] bool isDone() const noexcept { return pending_.load(std::memory_order_acquire) == 0; }
+        [[nodiscard]] uint32_t getPending() const noexcept { return pending_.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+        std::atomic<uint32_t> pending_{ 0 };
+        std::atomic<bool> failed_{ false };
+        std::exception_ptr exception_;  // Written once, by whoever set failed_
+    };
+
+    // ==========================================
+    // JOB SYSTEM
+    // ==========================================
+
+    /**
+     * @brief Fixed-size worker pool with fork/join helpers
+     *
+     * Thread slot 0 belongs to the thread that created the pool (normally
+     * the main thread); workers occupy slots 1..N. Per-thread resources
+     * (command pools, scratch buffers) should be sized with getThreadCount()
+     * and indexed with getThreadIndex().
+     *
+     * Any other thread (asset loaders, the async I/O thread) may submit and
+     * wait, but never runs queued jobs itself: it has no slot of its own, so
+     * wait() just blocks and parallelFor() hands every batch to the workers.
+     */
+    class JobSystem {
+    public:
+        using Job = std::function<void()>;
+        using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+        // worker_count = 0 picks hardware_concurrency - 1 (at least one worker)
+        explicit JobSystem(uint32_t worker_count = 0, const char* name = "Jobs");
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        // Submission
+        void submit(Job job);
+        void submit(JobCounter& counter, Job job);
+
+        // Blocks until the counter drains, executing queued jobs meanwhile
+        // (owner and worker threads only) and sleeping while there are none.
+        // Rethrows the first exception of the counter's jobs, which clears it.
+        void wait(JobCounter& counter);
+
+        // Runs one queued job on the calling thread; false if there was none
+        // or the thread has no slot in this pool
+        bool tryRunOne();
+
+        // Splits [0, count) into batches of batch_size and blocks until all ran.
+        // Batch boundaries depend only on count/batch_size, never on scheduling.
+        // If a batch throws, the rest still finish first and the first
+        // exception is rethrown.
+        void parallelFor(size_t count, size_t batch_size, const RangeJob& fn);
+
+        // Thread identification
+        [[nodiscard]] uint32_t getWorkerCount() const noexcept { return static_cast<uint32_t>(workers_.size()); }
+        [[nodiscard]] uint32_t getThreadCount() const noexcept { return getWorkerCount() + 1; }
+        [[nodiscard]] uint32_t getThreadIndex() const noexcept;
+        // Owner or worker; only these threads execute queued jobs
+        [[nodiscard]] bool ownsThreadSlot() const noexcept;
+        [[nodiscard]] const char* getName() const noexcept { return name_; }
+
+    private:
+        struct QueuedJob {
+            Job job;
+            JobCounter* counter = nullptr;
+        };
+
+        void workerLoop(uint32_t index);
+        void execute(QueuedJob& queued);
+        // Inside a catch block; false for jobs without a counter
+        static bool captureException(QueuedJob& queued) noexcept;
+
+    private:
+        const char* name_;
+        std::thread::id owner_;
+        std::vector<std::thread> workers_;
+
+        std::mutex mutex_;
+        std::condition_variable wake_;     // Workers: a job was queued
+        std::condition_variable idle_;     // wait(): a job was queued or a counter drained
+        std::deque<QueuedJob> queue_;
+        bool stopping_ = false;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,26 @@
+#include "ashbornpch.h"
+
+#include "Task.h"
+
+namespace AshCore {
+
+    namespace {
+        detail::DetachedTask runDetached(Task<void> task) {
+            try {
+                co_await task;
+            }
+            catch (const std::exception& e) {
+                print_e("Unhandled exception in spawned task", LogContext{ {"what", std::string(e.what())} });
+            }
+            catch (...) {
+                print_e("Unknown exception in spawned task");
+            }
+        }
+    }
+
+    void spawn(Task<void> task) {
+        // The runner owns the task; both frames go away when it finishes
+        runDetached(std::move(task));
+    }
+
+} // namespace AshCore
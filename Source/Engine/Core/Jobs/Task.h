@@ -0,0 +1,296 @@
+#pragma once
+
+#include "Jobs/JobSystem.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AshCore {
+
+    template<typename T = void>
+    class Task;
+
+    // ==========================================
+    // PROMISES
+    // ==========================================
+
+    namespace detail {
+
+        struct TaskPromiseBase {
+            // Whoever co_awaits the task; resumed by symmetric transfer when it finishes
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+            std::exception_ptr exception;
+
+            struct FinalAwaiter {
+                bool await_ready() const noexcept { return false; }
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+                    return handle.promise().continuation;
+                }
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+
+        template<typename T>
+        struct TaskPromise final : TaskPromiseBase {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template<typename U>
+            void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+            T takeResult() {
+                if (exception) std::rethrow_exception(exception);
+                return std::move(*value);
+            }
+        };
+
+        template<>
+        struct TaskPromise<void> final : TaskPromiseBase {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() const noexcept {}
+
+            void takeResult() const {
+                if (exception) std::rethrow_exception(exception);
+            }
+        };
+
+        // Starts on creation and frees itself when done; drives tasks nobody co_awaits
+        struct DetachedTask {
+            struct promise_type {
+                DetachedTask get_return_object() const noexcept { return {}; }
+                std::suspend_never initial_suspend() const noexcept { return {}; }
+                std::suspend_never final_suspend() const noexcept { return {}; }
+                void return_void() const noexcept {}
+                void unhandled_exception() const noexcept { std::terminate(); }
+            };
+        };
+
+    } // namespace detail
+
+    // ==========================================
+    // TASK
+    // ==========================================
+
+    /**
+     * @brief Lazily started coroutine returning T
+     *
+     * Nothing runs until the task is co_awaited (or handed to syncWait /
+     * spawn); the awaiting coroutine is resumed on whichever thread
+     * finishes the task, so code after a co_await on a file read or a job
+     * continues on the I/O or worker thread that completed it. Exceptions
+     * are rethrown at the co_await. Move-only; destroying an unfinished
+     * task that has started is a bug.
+     */
+    template<typename T>
+    class [[nodiscard]] Task {
+    public:
+        using promise_type = detail::TaskPromise<T>;
+
+        Task() = default;
+        explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+        ~Task() { if (handle_) handle_.destroy(); }
+
+        Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                if (handle_) handle_.destroy();
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        [[nodiscard]] bool isValid() const noexcept { return static_cast<bool>(handle_); }
+        [[nodiscard]] bool isDone() const noexcept { return !handle_ || handle_.done(); }
+
+        // Once done: the result, or its exception rethrown
+        T takeResult() { return handle_.promise().takeResult(); }
+
+        auto operator co_await() & noexcept { return Awaiter{ handle_ }; }
+        auto operator co_await() && noexcept { return Awaiter{ handle_ }; }
+
+        // Waits for completion without taking the result (or the exception)
+        [[nodiscard]] auto whenReady() noexcept {
+            struct ReadyAwaiter : Awaiter {
+                void await_resume() const noexcept {}
+            };
+            return ReadyAwaiter{ { handle_ } };
+        }
+
+    private:
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() const { return handle.promise().takeResult(); }
+        };
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    namespace detail {
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() noexcept {
+            return Task<T>{ std::coroutine_handle<TaskPromise<T>>::from_promise(*this) };
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+            return Task<void>{ std::coroutine_handle<TaskPromise<void>>::from_promise(*this) };
+        }
+    }
+
+    // ==========================================
+    // JOB SYSTEM INTEGRATION
+    // ==========================================
+
+    // Resumes handle as a job, or right here without a job system
+    inline void resumeOn(std::coroutine_handle<> handle, JobSystem* jobs) {
+        if (jobs) jobs->submit([handle]() { handle.resume(); });
+        else handle.resume();
+    }
+
+    // co_await switchTo(jobs): the rest of the coroutine runs as a job
+    [[nodiscard]] inline auto switchTo(JobSystem& jobs) noexcept {
+        struct Awaiter {
+            JobSystem& jobs;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) const { jobs.submit([handle]() { handle.resume(); }); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{ jobs };
+    }
+
+    // fn() as a job (a decode, a mesh build); the caller continues on that worker
+    template<typename Fn>
+    [[nodiscard]] Task<std::invoke_result_t<Fn&>> runJob(JobSystem& jobs, Fn fn) {
+        co_await switchTo(jobs);
+        co_return fn();
+    }
+
+    /**
+     * Awaits every task; they all start before the first one is waited on,
+     * so a thousand reads are a thousand requests in flight. Results come
+     * back in input order; the first exception (in input order) is rethrown
+     * after all have finished.
+     */
+    template<typename T>
+    [[nodiscard]] Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> whenAll(std::vector<Task<T>> tasks);
+
+    namespace detail {
+
+        struct WhenAllLatch {
+            std::atomic<size_t> remaining;
+            std::coroutine_handle<> continuation;
+
+            // True for the last arrival
+            bool arrive() noexcept { return remaining.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+        };
+
+        template<typename T>
+        DetachedTask whenAllRunner(Task<T>& task, WhenAllLatch& latch) {
+            co_await task.whenReady();
+            if (latch.arrive()) latch.continuation.resume();
+        }
+
+        template<typename T>
+        struct WhenAllAwaiter {
+            std::vector<Task<T>>& tasks;
+            WhenAllLatch& latch;
+
+            bool await_ready() const noexcept { return tasks.empty(); }
+            bool await_suspend(std::coroutine_handle<> handle) {
+                latch.continuation = handle;
+                for (Task<T>& task : tasks) whenAllRunner(task, latch);
+                // Our own count keeps the latch open until every task has started
+                return !latch.arrive();
+            }
+            void await_resume() const noexcept {}
+        };
+
+    } // namespace detail
+
+    template<typename T>
+    Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> whenAll(std::vector<Task<T>> tasks) {
+        detail::WhenAllLatch latch{ tasks.size() + 1, {} };
+        co_await detail::WhenAllAwaiter<T>{ tasks, latch };
+
+        if constexpr (std::is_void_v<T>) {
+            for (Task<T>& task : tasks) co_await task;
+        }
+        else {
+            std::vector<T> results;
+            results.reserve(tasks.size());
+            for (Task<T>& task : tasks) results.push_back(co_await task);
+            co_return results;
+        }
+    }
+
+    // ==========================================
+    // ENTRY POINTS
+    // ==========================================
+
+    namespace detail {
+
+        struct SyncWaitState {
+            std::mutex mutex;
+            std::condition_variable signal;
+            std::atomic<bool> done{ false };
+        };
+
+        template<typename T>
+        DetachedTask syncWaitRunner(Task<T>& task, SyncWaitState& state) {
+            co_await task.whenReady();
+            // Notified under the lock: the waiter owns state and may return the moment it sees done
+            std::lock_guard lock(state.mutex);
+            state.done.store(true, std::memory_order_release);
+            state.signal.notify_all();
+        }
+
+    } // namespace detail
+
+    /**
+     * Runs the task to completion from ordinary code. With a job system the
+     * calling thread executes queued jobs meanwhile, which is required when
+     * called from a job whose continuation is scheduled on the same pool.
+     */
+    template<typename T>
+    T syncWait(Task<T> task, JobSystem* jobs = nullptr) {
+        detail::SyncWaitState state;
+        detail::syncWaitRunner(task, state);
+        if (jobs) {
+            while (!state.done.load(std::memory_order_acquire)) {
+                if (!jobs->tryRunOne()) std::this_thread::yield();
+            }
+        }
+        {
+            std::unique_lock lock(state.mutex);
+            state.signal.wait(lock, [&state]() { return state.done.load(std::memory_order_acquire); });
+        }
+        return task.takeResult();
+    }
+
+    // Fire and forget; exceptions are logged
+    void spawn(Task<void> task);
+
+} // namespace AshCore
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace AshCore {
+
+    /**
+     * @brief Reports files written or moved into watched directory trees
+     *
+     * Raw OS notifications with no debouncing: a single save can show up
+     * more than once. Directories created later under a watched root are
+     * picked up automatically. Implemented per platform in
+     * Core/Platform/<OS>/FileWatcher.cpp.
+     */
+    class FileWatcher {
+    public:
+        FileWatcher();
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        // Watches root and every directory below it; false if that is not possible here
+        bool watch(const std::filesystem::path& root);
+
+        // Non-blocking; appends files changed since the last call
+        void poll(std::vector<std::filesystem::path>& changed);
+
+        [[nodiscard]] static bool isSupported() noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+
+} // namespace AshCore
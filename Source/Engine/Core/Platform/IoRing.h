@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    /**
+     * @brief Kernel submission/completion queues for file reads
+     *
+     * Linux io_uring driven through raw system calls: any number of reads
+     * go to the kernel in one submit() and are reaped in batches by wait(),
+     * without a thread per outstanding read. create() returns null where
+     * that is not available (other platforms, kernels before 5.6 or without
+     * IORING_OP_READ, seccomp profiles that block it). submit()/wake() and wait() may run on
+     * different threads, but each side must be serialized by the caller.
+     * Implemented per platform in Core/Platform/<OS>/IoRing.cpp.
+     */
+    class IoRing {
+    public:
+        struct File {
+            int64_t handle = -1;
+            uint64_t size = 0;
+        };
+
+        struct Read {
+            int64_t file;
+            std::byte* dst;
+            uint64_t offset;
+            uint32_t size;
+            uint64_t user_data;    // Non-zero; 0 is reserved for wake()
+        };
+
+        struct Completion {
+            uint64_t user_data;
+            int64_t result;        // Bytes read, or -errno
+        };
+
+        [[nodiscard]] static std::unique_ptr<IoRing> create(uint32_t entries);
+        ~IoRing();
+
+        IoRing(const IoRing&) = delete;
+        IoRing& operator=(const IoRing&) = delete;
+
+        // Reads in flight at once never exceed this
+        [[nodiscard]] uint32_t getCapacity() const noexcept;
+
+        // One system call for the whole span; returns how many were queued
+        // (fewer when the submission queue is full)
+        uint32_t submit(std::span<const Read> reads);
+
+        // Blocks until at least one completion is available, then appends all
+        // of them; a wake() shows up as user_data 0
+        void wait(std::vector<Completion>& completions);
+        // False when the submission queue was full or the kernel refused the
+        // entry; nothing will interrupt wait() then, so try again later
+        [[nodiscard]] bool wake();
+
+        // The error is the errno of the failed open
+        [[nodiscard]] static std::expected<File, int> openFile(const std::filesystem::path& path);
+        static void closeFile(File file) noexcept;
+
+    private:
+        struct Impl;
+        explicit IoRing(std::unique_ptr<Impl> impl);
+
+        std::unique_ptr<Impl> impl_;
+    };
+
+} // namespace AshCore
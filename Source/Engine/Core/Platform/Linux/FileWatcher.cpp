@@ -0,0 +1,113 @@
+#include "ashbornpch.h"
+
+#include "Platform/FileWatcher.h"
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <unordered_map>
+
+namespace AshCore {
+
+    namespace {
+        // Saves that rewrite in place end in CLOSE_WRITE; editors that write a
+        // temp file and rename it end in MOVED_TO. MODIFY alone is too noisy.
+        constexpr uint32_t FILE_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO;
+        constexpr uint32_t DIRECTORY_EVENTS = IN_CREATE | IN_MOVED_TO | IN_ONLYDIR;
+        constexpr uint32_t WATCH_MASK = FILE_EVENTS | DIRECTORY_EVENTS | IN_DELETE_SELF;
+    }
+
+    struct FileWatcher::Impl {
+        int fd = -1;
+        std::unordered_map<int, std::filesystem::path> directories;  // Watch descriptor -> directory
+
+        bool addDirectory(const std::filesystem::path& directory) {
+            const int wd = inotify_add_watch(fd, directory.c_str(), WATCH_MASK);
+            if (wd < 0) {
+                print_w("Failed to watch directory", LogContext{
+                    {"path", directory.string()},
+                    {"error", std::string(std::strerror(errno))}
+                    });
+                return false;
+            }
+            directories[wd] = directory;
+            return true;
+        }
+
+        // existing, if set, receives files already in the tree
+        bool addTree(const std::filesystem::path& root, std::vector<std::filesystem::path>* existing) {
+            bool ok = addDirectory(root);
+            std::error_code ec;
+            for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+                !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+                if (it->is_directory(ec)) ok &= addDirectory(it->path());
+                else if (existing && it->is_regular_file(ec)) existing->push_back(it->path());
+            }
+            return ok;
+        }
+    };
+
+    FileWatcher::FileWatcher()
+        : impl_(std::make_unique<Impl>()) {
+        impl_->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (impl_->fd < 0) {
+            print_e("inotify unavailable", LogContext{ {"error", std::string(std::strerror(errno))} });
+        }
+    }
+
+    FileWatcher::~FileWatcher() {
+        if (impl_->fd >= 0) {
+            ::close(impl_->fd);  // Drops every watch with it
+        }
+    }
+
+    bool FileWatcher::watch(const std::filesystem::path& root) {
+        if (impl_->fd < 0) return false;
+        std::error_code ec;
+        if (!std::filesystem::is_directory(root, ec)) return false;
+        return impl_->addTree(root, nullptr);
+    }
+
+    void FileWatcher::poll(std::vector<std::filesystem::path>& changed) {
+        if (impl_->fd < 0) return;
+
+        alignas(inotify_event) char buffer[16 * 1024];
+        while (true) {
+            const ssize_t length = ::read(impl_->fd, buffer, sizeof(buffer));
+            if (length <= 0) break;  // EAGAIN: drained
+
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    print_w("File watcher queue overflowed; some changes were missed");
+                    continue;
+                }
+                if (event->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+                    impl_->directories.erase(event->wd);
+                    continue;
+                }
+
+                auto directory = impl_->directories.find(event->wd);
+                if (directory == impl_->directories.end() || event->len == 0) continue;
+                const std::filesystem::path path = directory->second / event->name;
+
+                if (event->mask & IN_ISDIR) {
+                    // Directory copied or moved in: watch it and report what it already holds
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) impl_->addTree(path, &changed);
+                }
+                else if (event->mask & FILE_EVENTS) {
+                    changed.push_back(path);
+                }
+            }
+        }
+    }
+
+    bool FileWatcher::isSupported() noexcept {
+        return true;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,230 @@
+#include "ashbornpch.h"
+
+#include "Platform/IoRing.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+namespace AshCore {
+
+    namespace {
+        int ioUringSetup(uint32_t entries, io_uring_params& params) {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        }
+
+        int ioUringEnter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+        }
+
+        // IORING_OP_READ came with 5.6, as did the probe; setup alone succeeds on 5.1
+        bool supportsRead(int fd) {
+            constexpr uint32_t OP_COUNT = 256;
+            std::vector<std::byte> storage(sizeof(io_uring_probe) + OP_COUNT * sizeof(io_uring_probe_op));
+            auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+            if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, OP_COUNT) < 0) {
+                return false;
+            }
+            return probe->last_op >= IORING_OP_READ && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0;
+        }
+
+        // Ring indices are shared with the kernel
+        uint32_t loadAcquire(uint32_t* value) { return std::atomic_ref<uint32_t>(*value).load(std::memory_order_acquire); }
+        void storeRelease(uint32_t* value, uint32_t v) { std::atomic_ref<uint32_t>(*value).store(v, std::memory_order_release); }
+    }
+
+    struct IoRing::Impl {
+        int fd = -1;
+        io_uring_params params{};
+
+        void* sq_ring = nullptr;
+        size_t sq_ring_size = 0;
+        void* cq_ring = nullptr;       // Same mapping as sq_ring with IORING_FEAT_SINGLE_MMAP
+        size_t cq_ring_size = 0;
+        io_uring_sqe* sqes = nullptr;
+        size_t sqes_size = 0;
+
+        uint32_t* sq_head = nullptr;
+        uint32_t* sq_tail = nullptr;
+        uint32_t sq_mask = 0;
+        uint32_t* sq_array = nullptr;
+        uint32_t* cq_head = nullptr;
+        uint32_t* cq_tail = nullptr;
+        uint32_t cq_mask = 0;
+        io_uring_cqe* cqes = nullptr;
+
+        ~Impl() {
+            if (sqes) ::munmap(sqes, sqes_size);
+            if (cq_ring && cq_ring != sq_ring) ::munmap(cq_ring, cq_ring_size);
+            if (sq_ring) ::munmap(sq_ring, sq_ring_size);
+            if (fd >= 0) ::close(fd);
+        }
+
+        // Fills count entries and hands them to the kernel in one call; an
+        // entry the kernel did not take is withdrawn again
+        template<typename Fill>
+        uint32_t submit(uint32_t count, const Fill& fill) {
+            const uint32_t head = loadAcquire(sq_head);
+            const uint32_t tail = *sq_tail;
+            count = std::min(count, params.sq_entries - (tail - head));
+            if (count == 0) return 0;
+
+            for (uint32_t i = 0; i < count; ++i) {
+                const uint32_t slot = (tail + i) & sq_mask;
+                io_uring_sqe& sqe = sqes[slot];
+                std::memset(&sqe, 0, sizeof(sqe));
+                fill(i, sqe);
+                sq_array[slot] = slot;
+            }
+            storeRelease(sq_tail, tail + count);
+
+            int submitted;
+            do {
+                submitted = ioUringEnter(fd, count, 0, 0);
+            } while (submitted < 0 && errno == EINTR);
+
+            const uint32_t taken = submitted > 0 ? static_cast<uint32_t>(submitted) : 0;
+            if (taken < count) {
+                storeRelease(sq_tail, tail + taken);
+            }
+            return taken;
+        }
+    };
+
+    IoRing::IoRing(std::unique_ptr<Impl> impl)
+        : impl_(std::move(impl)) {
+    }
+
+    IoRing::~IoRing() = default;
+
+    std::unique_ptr<IoRing> IoRing::create(uint32_t entries) {
+        auto impl = std::make_unique<Impl>();
+        impl->fd = ioUringSetup(std::max(entries, 2u), impl->params);
+        if (impl->fd < 0) {
+            print_d("io_uring unavailable", LogContext{ {"errno", errno} });
+            return nullptr;
+        }
+        if (!supportsRead(impl->fd)) {
+            print_d("io_uring has no IORING_OP_READ");
+            return nullptr;
+        }
+
+        const io_uring_params& params = impl->params;
+        impl->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        impl->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            impl->sq_ring_size = impl->cq_ring_size = std::max(impl->sq_ring_size, impl->cq_ring_size);
+        }
+
+        impl->sq_ring = ::mmap(nullptr, impl->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->fd, IORING_OFF_SQ_RING);
+        if (impl->sq_ring == MAP_FAILED) {
+            impl->sq_ring = nullptr;
+            return nullptr;
+        }
+        if (single_mmap) {
+            impl->cq_ring = impl->sq_ring;
+        }
+        else {
+            impl->cq_ring = ::mmap(nullptr, impl->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->fd, IORING_OFF_CQ_RING);
+            if (impl->cq_ring == MAP_FAILED) {
+                impl->cq_ring = nullptr;
+                return nullptr;
+            }
+        }
+        impl->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, impl->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, impl->fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return nullptr;
+        }
+        impl->sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<std::byte*>(impl->sq_ring);
+        auto* cq = static_cast<std::byte*>(impl->cq_ring);
+        impl->sq_head = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+        impl->sq_tail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+        impl->sq_mask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+        impl->sq_array = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+        impl->cq_head = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+        impl->cq_tail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+        impl->cq_mask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+        impl->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        print_d("io_uring created", LogContext{
+            {"sq_entries", params.sq_entries},
+            {"cq_entries", params.cq_entries}
+            });
+        return std::unique_ptr<IoRing>(new IoRing(std::move(impl)));
+    }
+
+    uint32_t IoRing::getCapacity() const noexcept {
+        // The completion queue is twice as deep, so it cannot overflow
+        return impl_->params.sq_entries;
+    }
+
+    uint32_t IoRing::submit(std::span<const Read> reads) {
+        return impl_->submit(static_cast<uint32_t>(reads.size()), [reads](uint32_t i, io_uring_sqe& sqe) {
+            const Read& read = reads[i];
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = static_cast<int>(read.file);
+            sqe.addr = reinterpret_cast<uint64_t>(read.dst);
+            sqe.len = read.size;
+            sqe.off = read.offset;
+            sqe.user_data = read.user_data;
+        });
+    }
+
+    void IoRing::wait(std::vector<Completion>& completions) {
+        Impl& impl = *impl_;
+        while (true) {
+            const uint32_t head = *impl.cq_head;
+            const uint32_t tail = loadAcquire(impl.cq_tail);
+            if (head != tail) {
+                for (uint32_t i = head; i != tail; ++i) {
+                    const io_uring_cqe& cqe = impl.cqes[i & impl.cq_mask];
+                    completions.push_back({ cqe.user_data, cqe.res });
+                }
+                storeRelease(impl.cq_head, tail);
+                return;
+            }
+            if (ioUringEnter(impl.fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                print_e("io_uring wait failed", LogContext{ {"errno", errno} });
+                return;
+            }
+        }
+    }
+
+    bool IoRing::wake() {
+        return impl_->submit(1, [](uint32_t, io_uring_sqe& sqe) {
+            sqe.opcode = IORING_OP_NOP;
+            sqe.user_data = 0;
+        }) == 1;
+    }
+
+    std::expected<IoRing::File, int> IoRing::openFile(const std::filesystem::path& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return std::unexpected(errno);
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            const int error = errno;
+            ::close(fd);
+            return std::unexpected(error);
+        }
+        return File{ fd, static_cast<uint64_t>(info.st_size) };
+    }
+
+    void IoRing::closeFile(File file) noexcept {
+        if (file.handle >= 0) ::close(static_cast<int>(file.handle));
+    }
+
+} // namespace AshCore
@@ -0,0 +1,79 @@
+#include "ashbornpch.h"
+
+#include "Platform/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace AshCore {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return std::nullopt;
+        }
+
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        MappedFile file;
+        if (info.st_size > 0) {
+            void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd);
+                return std::nullopt;
+            }
+            file.data_ = static_cast<const std::byte*>(data);
+            file.size_ = static_cast<size_t>(info.st_size);
+        }
+
+        // The mapping keeps the file alive
+        ::close(fd);
+        return file;
+    }
+
+    void MappedFile::prefetch(size_t offset, size_t size) const noexcept {
+        if (!data_ || offset >= size_) return;
+
+        // madvise wants a page-aligned start
+        const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t begin = offset / page * page;
+        const size_t end = std::min(offset + size, size_);
+        ::madvise(const_cast<std::byte*>(data_) + begin, end - begin, MADV_WILLNEED);
+    }
+
+    void MappedFile::close() noexcept {
+        if (data_) {
+            ::munmap(const_cast<std::byte*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+} // namespace AshCore
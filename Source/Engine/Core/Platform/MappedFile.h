@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace AshCore {
+
+    /**
+     * @brief Read-only memory mapping of a whole file
+     *
+     * Pages are faulted in on first touch, so opening a large archive costs
+     * nothing until its contents are read. Implemented per platform in
+     * Core/Platform/<OS>/MappedFile.cpp.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Empty files map to an empty span
+        [[nodiscard]] static std::optional<MappedFile> open(const std::filesystem::path& path);
+
+        [[nodiscard]] std::span<const std::byte> getData() const noexcept { return { data_, size_ }; }
+        [[nodiscard]] size_t getSize() const noexcept { return size_; }
+
+        // Hint that [offset, offset + size) will be read soon
+        void prefetch(size_t offset, size_t size) const noexcept;
+
+    private:
+        void close() noexcept;
+
+    private:
+        const std::byte* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+} // namespace AshCore
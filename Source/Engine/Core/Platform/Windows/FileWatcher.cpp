@@ -0,0 +1,33 @@
+#include "ashbornpch.h"
+
+#include "Platform/FileWatcher.h"
+
+namespace AshCore {
+
+    // Not implemented yet (ReadDirectoryChangesW); hot reload is manual on Windows
+    struct FileWatcher::Impl {
+        bool warned = false;
+    };
+
+    FileWatcher::FileWatcher()
+        : impl_(std::make_unique<Impl>()) {
+    }
+
+    FileWatcher::~FileWatcher() = default;
+
+    bool FileWatcher::watch(const std::filesystem::path& root) {
+        if (!impl_->warned) {
+            print_w("File watching is not supported on this platform", LogContext{ {"path", root.string()} });
+            impl_->warned = true;
+        }
+        return false;
+    }
+
+    void FileWatcher::poll(std::vector<std::filesystem::path>& /*changed*/) {
+    }
+
+    bool FileWatcher::isSupported() noexcept {
+        return false;
+    }
+
+} // namespace AshCore
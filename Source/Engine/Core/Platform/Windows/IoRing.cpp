@@ -0,0 +1,45 @@
+#include "ashbornpch.h"
+
+#include "Platform/IoRing.h"
+
+#include <cerrno>
+
+namespace AshCore {
+
+    // Not implemented yet (IoRing API / overlapped reads); AsyncIo uses its thread pool on Windows
+    struct IoRing::Impl {
+    };
+
+    IoRing::IoRing(std::unique_ptr<Impl> impl)
+        : impl_(std::move(impl)) {
+    }
+
+    IoRing::~IoRing() = default;
+
+    std::unique_ptr<IoRing> IoRing::create(uint32_t /*entries*/) {
+        return nullptr;
+    }
+
+    uint32_t IoRing::getCapacity() const noexcept {
+        return 0;
+    }
+
+    uint32_t IoRing::submit(std::span<const Read> /*reads*/) {
+        return 0;
+    }
+
+    void IoRing::wait(std::vector<Completion>& /*completions*/) {
+    }
+
+    bool IoRing::wake() {
+        return false;
+    }
+
+    std::expected<IoRing::File, int> IoRing::openFile(const std::filesystem::path& /*path*/) {
+        return std::unexpected(ENOSYS);
+    }
+
+    void IoRing::closeFile(File /*file*/) noexcept {
+    }
+
+} // namespace AshCore
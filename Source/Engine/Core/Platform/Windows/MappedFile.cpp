@@ -0,0 +1,84 @@
+#include "ashbornpch.h"
+
+#include "Platform/MappedFile.h"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace AshCore {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path) {
+        HANDLE file_handle = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (file_handle == INVALID_HANDLE_VALUE) {
+            return std::nullopt;
+        }
+
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file_handle, &size)) {
+            ::CloseHandle(file_handle);
+            return std::nullopt;
+        }
+
+        MappedFile file;
+        if (size.QuadPart > 0) {
+            HANDLE mapping = ::CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) {
+                ::CloseHandle(file_handle);
+                return std::nullopt;
+            }
+
+            void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping);  // The view keeps the mapping alive
+            if (!data) {
+                ::CloseHandle(file_handle);
+                return std::nullopt;
+            }
+            file.data_ = static_cast<const std::byte*>(data);
+            file.size_ = static_cast<size_t>(size.QuadPart);
+        }
+
+        ::CloseHandle(file_handle);
+        return file;
+    }
+
+    void MappedFile::prefetch(size_t offset, size_t size) const noexcept {
+        if (!data_ || offset >= size_) return;
+
+        WIN32_MEMORY_RANGE_ENTRY range{};
+        range.VirtualAddress = const_cast<std::byte*>(data_) + offset;
+        range.NumberOfBytes = std::min(size, size_ - offset);
+        ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+    }
+
+    void MappedFile::close() noexcept {
+        if (data_) {
+            ::UnmapViewOfFile(data_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+} // namespace AshCore
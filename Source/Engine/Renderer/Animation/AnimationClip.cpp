@@ -0,0 +1,154 @@
+#include "ashbornpch.h"
+
+#include "AnimationClip.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AshCore {
+
+    namespace {
+        constexpr float QUANT_MAX = 65535.0f;
+
+        uint16_t quantizeUnit(float value) {
+            return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * QUANT_MAX));
+        }
+
+        // Smallest-three: drop the largest component, keep the rest in order
+        void encodeRotation(std::array<float, 4> q, uint16_t& a, uint16_t& b, uint16_t& c, uint8_t& largest) {
+            const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+            if (length > 0.0f) {
+                for (float& component : q) component /= length;
+            }
+            else {
+                q = { 0.0f, 0.0f, 0.0f, 1.0f };
+            }
+
+            largest = 0;
+            for (uint8_t i = 1; i < 4; ++i) {
+                if (std::abs(q[i]) > std::abs(q[largest])) largest = i;
+            }
+            // q and -q are the same rotation; keep the dropped component positive
+            if (q[largest] < 0.0f) {
+                for (float& component : q) component = -component;
+            }
+
+            uint16_t* out[3] = { &a, &b, &c };
+            for (uint32_t i = 0, slot = 0; i < 4; ++i) {
+                if (i == largest) continue;
+                *out[slot++] = quantizeUnit(q[i] / QUAT_COMPONENT_RANGE * 0.5f + 0.5f);
+            }
+        }
+    }
+
+    // ==========================================
+    // SKELETON
+    // ==========================================
+
+    bool Skeleton::isValid() const noexcept {
+        if (parents.empty() || inverse_bind.size() != parents.size()) return false;
+        for (size_t bone = 0; bone < parents.size(); ++bone) {
+            if (parents[bone] < -1 || parents[bone] >= static_cast<int32_t>(bone)) return false;
+        }
+        return true;
+    }
+
+    // ==========================================
+    // ANIMATION CLIP
+    // ==========================================
+
+    std::optional<AnimationClip> AnimationClip::compress(const RawAnimationClip& raw) {
+        if (raw.bone_count == 0 || raw.frame_count == 0 || !(raw.frame_rate > 0.0f) ||
+            raw.keys.size() != static_cast<size_t>(raw.bone_count) * raw.frame_count) {
+            print_e("Invalid animation clip", LogContext{
+                {"bones", raw.bone_count},
+                {"frames", raw.frame_count},
+                {"keys", raw.keys.size()}
+                });
+            return std::nullopt;
+        }
+
+        AnimationClip clip;
+        clip.frame_rate_ = raw.frame_rate;
+        clip.frame_count_ = raw.frame_count;
+        clip.bone_count_ = raw.bone_count;
+        clip.padded_bones_ = (raw.bone_count + BONE_LANES - 1) / BONE_LANES * BONE_LANES;
+        clip.duration_ = static_cast<float>(raw.frame_count - 1) / raw.frame_rate;
+
+        const size_t stride = clip.padded_bones_;
+        const size_t total = stride * raw.frame_count;
+
+        // Padding lanes decode to identity: zero components, w dropped
+        const uint16_t zero = quantizeUnit(0.5f);
+        clip.rot_a_.assign(total, zero);
+        clip.rot_b_.assign(total, zero);
+        clip.rot_c_.assign(total, zero);
+        clip.rot_largest_.assign(total, 3);
+
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            clip.trans_[axis].assign(total, 0);
+            clip.trans_min_[axis].assign(stride, 0.0f);
+            clip.trans_scale_[axis].assign(stride, 0.0f);
+        }
+
+        // Per-bone translation range over the whole clip
+        for (uint32_t bone = 0; bone < raw.bone_count; ++bone) {
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                float lo = raw.keys[bone].translation[axis];
+                float hi = lo;
+                for (uint32_t frame = 1; frame < raw.frame_count; ++frame) {
+                    const float value = raw.keys[static_cast<size_t>(frame) * raw.bone_count + bone].translation[axis];
+                    lo = std::min(lo, value);
+                    hi = std::max(hi, value);
+                }
+                clip.trans_min_[axis][bone] = lo;
+                clip.trans_scale_[axis][bone] = (hi - lo) / QUANT_MAX;
+            }
+        }
+
+        for (uint32_t frame = 0; frame < raw.frame_count; ++frame) {
+            for (uint32_t bone = 0; bone < raw.bone_count; ++bone) {
+                const BoneTransform& key = raw.keys[static_cast<size_t>(frame) * raw.bone_count + bone];
+                const size_t index = frame * stride + bone;
+
+                encodeRotation(key.rotation, clip.rot_a_[index], clip.rot_b_[index], clip.rot_c_[index], clip.rot_largest_[index]);
+
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    const float scale = clip.trans_scale_[axis][bone];
+                    if (scale > 0.0f) {
+                        clip.trans_[axis][index] = quantizeUnit((key.translation[axis] - clip.trans_min_[axis][bone]) / (scale * QUANT_MAX));
+                    }
+                }
+            }
+        }
+        return clip;
+    }
+
+    size_t AnimationClip::getCompressedSize() const noexcept {
+        const size_t keys = rot_largest_.size();
+        return keys * (3 * sizeof(uint16_t) + sizeof(uint8_t) + 3 * sizeof(uint16_t)) + padded_bones_ * 6 * sizeof(float);
+    }
+
+    BoneTransform AnimationClip::decodeKey(uint32_t frame, uint32_t bone) const noexcept {
+        const size_t index = static_cast<size_t>(frame) * padded_bones_ + bone;
+        const float stored[3] = {
+            (rot_a_[index] / QUANT_MAX * 2.0f - 1.0f) * QUAT_COMPONENT_RANGE,
+            (rot_b_[index] / QUANT_MAX * 2.0f - 1.0f) * QUAT_COMPONENT_RANGE,
+            (rot_c_[index] / QUANT_MAX * 2.0f - 1.0f) * QUAT_COMPONENT_RANGE,
+        };
+        const uint32_t largest = rot_largest_[index];
+
+        BoneTransform key;
+        for (uint32_t i = 0, slot = 0; i < 4; ++i) {
+            key.rotation[i] = i == largest ? 0.0f : stored[slot++];
+        }
+        const float sum = stored[0] * stored[0] + stored[1] * stored[1] + stored[2] * stored[2];
+        key.rotation[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            key.translation[axis] = trans_min_[axis][bone] + trans_[axis][index] * trans_scale_[axis][bone];
+        }
+        return key;
+    }
+
+} // namespace AshCore
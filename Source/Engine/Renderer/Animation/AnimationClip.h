@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // SKELETON
+    // ==========================================
+
+    struct BoneTransform {
+        std::array<float, 4> rotation{ 0, 0, 0, 1 };  // Quaternion (x, y, z, w)
+        std::array<float, 3> translation{};
+    };
+
+    /**
+     * Bones are stored parents-first (parents[i] < i, -1 for roots) so the
+     * hierarchy can be resolved in one forward pass.
+     */
+    struct Skeleton {
+        std::vector<int32_t> parents;
+        std::vector<std::array<float, 12>> inverse_bind;  // Row-major 3x4, model -> bone space
+
+        [[nodiscard]] uint32_t getBoneCount() const noexcept { return static_cast<uint32_t>(parents.size()); }
+        [[nodiscard]] bool isValid() const noexcept;
+    };
+
+    // ==========================================
+    // ANIMATION CLIP
+    // ==========================================
+
+    // Uncompressed source: keys[frame * bone_count + bone], sampled at a fixed rate
+    struct RawAnimationClip {
+        float frame_rate = 30.0f;
+        uint32_t bone_count = 0;
+        uint32_t frame_count = 0;
+        std::vector<BoneTransform> keys;
+    };
+
+    /**
+     * @brief Uniformly sampled clip with quantized tracks in SoA layout
+     *
+     * Rotations use smallest-three: the largest quaternion component is
+     * dropped (and made positive), the other three are stored as 16-bit
+     * values in [-1/sqrt2, 1/sqrt2] plus a 2-bit index. Translations are
+     * 16-bit within each bone's range over the clip. Every frame stores
+     * each component as its own array padded to a multiple of 8 bones, so
+     * eight bones decode with one load per component. 13 bytes per bone
+     * and frame instead of 28.
+     */
+    class AnimationClip {
+    public:
+        static constexpr uint32_t BONE_LANES = 8;
+
+        [[nodiscard]] static std::optional<AnimationClip> compress(const RawAnimationClip& raw);
+
+        [[nodiscard]] float getDuration() const noexcept { return duration_; }
+        [[nodiscard]] float getFrameRate() const noexcept { return frame_rate_; }
+        [[nodiscard]] uint32_t getFrameCount() const noexcept { return frame_count_; }
+        [[nodiscard]] uint32_t getBoneCount() const noexcept { return bone_count_; }
+        [[nodiscard]] uint32_t getPaddedBoneCount() const noexcept { return padded_bones_; }
+        [[nodiscard]] size_t getCompressedSize() const noexcept;
+
+        // Frame f's arrays start at f * getPaddedBoneCount()
+        [[nodiscard]] const uint16_t* getRotationA() const noexcept { return rot_a_.data(); }
+        [[nodiscard]] const uint16_t* getRotationB() const noexcept { return rot_b_.data(); }
+        [[nodiscard]] const uint16_t* getRotationC() const noexcept { return rot_c_.data(); }
+        [[nodiscard]] const uint8_t* getRotationLargest() const noexcept { return rot_largest_.data(); }
+        [[nodiscard]] const uint16_t* getTranslation(uint32_t axis) const noexcept { return trans_[axis].data(); }
+
+        // Per bone (padded), dequantized = min + q * scale
+        [[nodiscard]] const float* getTranslationMin(uint32_t axis) const noexcept { return trans_min_[axis].data(); }
+        [[nodiscard]] const float* getTranslationScale(uint32_t axis) const noexcept { return trans_scale_[axis].data(); }
+
+        // Reference decode of one key (tools, validation)
+        [[nodiscard]] BoneTransform decodeKey(uint32_t frame, uint32_t bone) const noexcept;
+
+    private:
+        float duration_ = 0.0f;
+        float frame_rate_ = 30.0f;
+        uint32_t frame_count_ = 0;
+        uint32_t bone_count_ = 0;
+        uint32_t padded_bones_ = 0;
+
+        std::vector<uint16_t> rot_a_, rot_b_, rot_c_;
+        std::vector<uint8_t> rot_largest_;
+        std::array<std::vector<uint16_t>, 3> trans_;
+        std::array<std::vector<float>, 3> trans_min_;
+        std::array<std::vector<float>, 3> trans_scale_;
+    };
+
+    // Smallest-three scale: stored components lie in [-1/sqrt2, 1/sqrt2]
+    inline constexpr float QUAT_COMPONENT_RANGE = 0.70710678f;
+
+} // namespace AshCore
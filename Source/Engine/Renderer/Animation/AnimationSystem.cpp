@@ -0,0 +1,586 @@
+#include "ashbornpch.h"
+
+#include "AnimationSystem.h"
+#include "Jobs/JobSystem.h"
+#include "Upload/UploadManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint32_t LANES = AnimationClip::BONE_LANES;
+        constexpr size_t MATRIX_FLOATS = AnimationSystem::FLOATS_PER_BONE;
+        constexpr float IDENTITY_3X4[MATRIX_FLOATS] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0 };
+
+        // Runs fn(batch_index, begin, end) over fixed batches, on the job system when available
+        template<typename Fn>
+        void forEachBatch(JobSystem* jobs, size_t count, size_t batch_size, Fn&& fn) {
+            if (jobs && count > batch_size) {
+                jobs->parallelFor(count, batch_size, [&](size_t begin, size_t end) {
+                    fn(begin / batch_size, begin, end);
+                    });
+                return;
+            }
+            for (size_t begin = 0; begin < count; begin += batch_size) {
+                fn(begin / batch_size, begin, std::min(begin + batch_size, count));
+            }
+        }
+
+        // SoA pose being accumulated: one array per component, padded_bones lanes each
+        struct PoseView {
+            float* rotation[4];
+            float* translation[3];
+        };
+
+        struct FrameSample {
+            uint32_t f0;
+            uint32_t f1;
+            float alpha;
+        };
+
+        float wrapTime(float time, float duration, bool loop) {
+            if (!loop || duration <= 0.0f) return std::clamp(time, 0.0f, duration);
+            time = std::fmod(time, duration);
+            return time < 0.0f ? time + duration : time;
+        }
+
+        FrameSample locateFrames(const AnimationClip& clip, const AnimationLayer& layer) {
+            const float position = wrapTime(layer.time, clip.getDuration(), layer.loop) * clip.getFrameRate();
+            const uint32_t last = clip.getFrameCount() - 1;
+            const uint32_t f0 = std::min(static_cast<uint32_t>(position), last);
+            return { f0, std::min(f0 + 1, last), std::clamp(position - static_cast<float>(f0), 0.0f, 1.0f) };
+        }
+
+        // c = a * b for affine row-major 3x4 matrices
+        void multiplyAffine(const float* a, const float* b, float* c) {
+            for (size_t row = 0; row < 3; ++row) {
+                const float* r = a + row * 4;
+                for (size_t col = 0; col < 4; ++col) {
+                    c[row * 4 + col] = r[0] * b[col] + r[1] * b[4 + col] + r[2] * b[8 + col] + (col == 3 ? r[3] : 0.0f);
+                }
+            }
+        }
+
+        // ---- Scalar reference path
+
+        void sampleLayerScalar(const AnimationClip& clip, const FrameSample& frames, float weight, bool first,
+            const PoseView& pose, uint32_t padded_bones) {
+            for (uint32_t bone = 0; bone < padded_bones; ++bone) {
+                const BoneTransform k0 = clip.decodeKey(frames.f0, bone);
+                const BoneTransform k1 = clip.decodeKey(frames.f1, bone);
+
+                // nlerp along the shorter arc
+                float dot = 0.0f;
+                for (size_t i = 0; i < 4; ++i) dot += k0.rotation[i] * k1.rotation[i];
+                const float hemisphere = dot < 0.0f ? -1.0f : 1.0f;
+
+                float q[4];
+                float length = 0.0f;
+                for (size_t i = 0; i < 4; ++i) {
+                    q[i] = k0.rotation[i] + (k1.rotation[i] * hemisphere - k0.rotation[i]) * frames.alpha;
+                    length += q[i] * q[i];
+                }
+                const float inv_length = 1.0f / std::sqrt(length);
+
+                // Later layers are flipped into the accumulator's hemisphere before adding
+                float accumulated = 0.0f;
+                for (size_t i = 0; i < 4; ++i) accumulated += pose.rotation[i][bone] * q[i];
+                const float w = (!first && accumulated < 0.0f) ? -weight * inv_length : weight * inv_length;
+
+                for (size_t i = 0; i < 4; ++i) {
+                    pose.rotation[i][bone] = (first ? 0.0f : pose.rotation[i][bone]) + q[i] * w;
+                }
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    const float t = k0.translation[axis] + (k1.translation[axis] - k0.translation[axis]) * frames.alpha;
+                    pose.translation[axis][bone] = (first ? 0.0f : pose.translation[axis][bone]) + t * weight;
+                }
+            }
+        }
+
+        void poseToLocalScalar(const PoseView& pose, float inv_weight, float* local, uint32_t padded_bones) {
+            for (uint32_t bone = 0; bone < padded_bones; ++bone) {
+                float x = pose.rotation[0][bone], y = pose.rotation[1][bone], z = pose.rotation[2][bone], w = pose.rotation[3][bone];
+                const float length = std::sqrt(x * x + y * y + z * z + w * w);
+                const float inv_length = length > 0.0f ? 1.0f / length : 0.0f;  // Zero quaternion -> identity
+                x *= inv_length; y *= inv_length; z *= inv_length; w *= inv_length;
+
+                const float m[MATRIX_FLOATS] = {
+                    1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y), pose.translation[0][bone] * inv_weight,
+                    2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x), pose.translation[1][bone] * inv_weight,
+                    2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y), pose.translation[2][bone] * inv_weight,
+                };
+                for (size_t k = 0; k < MATRIX_FLOATS; ++k) local[k * padded_bones + bone] = m[k];
+            }
+        }
+
+        void multiplySoAScalar(const float* a, const float* b, float* c, uint32_t padded_bones) {
+            for (uint32_t bone = 0; bone < padded_bones; ++bone) {
+                float ma[MATRIX_FLOATS], mb[MATRIX_FLOATS], mc[MATRIX_FLOATS];
+                for (size_t k = 0; k < MATRIX_FLOATS; ++k) {
+                    ma[k] = a[k * padded_bones + bone];
+                    mb[k] = b[k * padded_bones + bone];
+                }
+                multiplyAffine(ma, mb, mc);
+                for (size_t k = 0; k < MATRIX_FLOATS; ++k) c[k * padded_bones + bone] = mc[k];
+            }
+        }
+
+#if defined(__AVX2__)
+        // ---- AVX2 path: eight bones per instruction
+
+        __m256 loadQuantized(const uint16_t* values) {
+            return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values))));
+        }
+
+        __m256 dot4(const __m256* a, const __m256* b) {
+            return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a[0], b[0]), _mm256_mul_ps(a[1], b[1])),
+                _mm256_add_ps(_mm256_mul_ps(a[2], b[2]), _mm256_mul_ps(a[3], b[3])));
+        }
+
+        // Smallest-three decode; the dropped component goes back in by the stored index
+        void decodeRotation8(const AnimationClip& clip, size_t index, __m256* q) {
+            const __m256 scale = _mm256_set1_ps(2.0f * QUAT_COMPONENT_RANGE / 65535.0f);
+            const __m256 bias = _mm256_set1_ps(QUAT_COMPONENT_RANGE);
+            const __m256 a = _mm256_sub_ps(_mm256_mul_ps(loadQuantized(clip.getRotationA() + index), scale), bias);
+            const __m256 b = _mm256_sub_ps(_mm256_mul_ps(loadQuantized(clip.getRotationB() + index), scale), bias);
+            const __m256 c = _mm256_sub_ps(_mm256_mul_ps(loadQuantized(clip.getRotationC() + index), scale), bias);
+
+            const __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b)), _mm256_mul_ps(c, c));
+            const __m256 d = _mm256_sqrt_ps(_mm256_max_ps(_mm256_setzero_ps(), _mm256_sub_ps(_mm256_set1_ps(1.0f), sum)));
+
+            const __m256i largest = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(clip.getRotationLargest() + index)));
+            const __m256 is0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest, _mm256_set1_epi32(0)));
+            const __m256 is1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest, _mm256_set1_epi32(1)));
+            const __m256 is2 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest, _mm256_set1_epi32(2)));
+            const __m256 is3 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(largest, _mm256_set1_epi32(3)));
+
+            q[0] = _mm256_blendv_ps(a, d, is0);
+            q[1] = _mm256_blendv_ps(_mm256_blendv_ps(b, d, is1), a, is0);
+            q[2] = _mm256_blendv_ps(_mm256_blendv_ps(b, d, is2), c, is3);
+            q[3] = _mm256_blendv_ps(c, d, is3);
+        }
+
+        void sampleLayerAvx2(const AnimationClip& clip, const FrameSample& frames, float weight, bool first,
+            const PoseView& pose, uint32_t padded_bones) {
+            const __m256 alpha = _mm256_set1_ps(frames.alpha);
+            const __m256 w = _mm256_set1_ps(weight);
+            const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+            const __m256 zero = _mm256_setzero_ps();
+            const size_t row0 = static_cast<size_t>(frames.f0) * padded_bones;
+            const size_t row1 = static_cast<size_t>(frames.f1) * padded_bones;
+
+            for (uint32_t base = 0; base < padded_bones; base += LANES) {
+                __m256 q0[4], q1[4];
+                decodeRotation8(clip, row0 + base, q0);
+                decodeRotation8(clip, row1 + base, q1);
+
+                // nlerp along the shorter arc
+                const __m256 flip = _mm256_and_ps(_mm256_cmp_ps(dot4(q0, q1), zero, _CMP_LT_OQ), sign_bit);
+                __m256 q[4];
+                for (size_t i = 0; i < 4; ++i) {
+                    q[i] = _mm256_add_ps(q0[i], _mm256_mul_ps(_mm256_sub_ps(_mm256_xor_ps(q1[i], flip), q0[i]), alpha));
+                }
+                const __m256 inv_length = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(dot4(q, q)));
+
+                __m256 scale = _mm256_mul_ps(w, inv_length);
+                __m256 accumulated[4];
+                for (size_t i = 0; i < 4; ++i) {
+                    accumulated[i] = first ? zero : _mm256_loadu_ps(pose.rotation[i] + base);
+                }
+                if (!first) {
+                    scale = _mm256_xor_ps(scale, _mm256_and_ps(_mm256_cmp_ps(dot4(accumulated, q), zero, _CMP_LT_OQ), sign_bit));
+                }
+                for (size_t i = 0; i < 4; ++i) {
+                    _mm256_storeu_ps(pose.rotation[i] + base, _mm256_add_ps(accumulated[i], _mm256_mul_ps(q[i], scale)));
+                }
+
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    const __m256 lo = _mm256_loadu_ps(clip.getTranslationMin(axis) + base);
+                    const __m256 step = _mm256_loadu_ps(clip.getTranslationScale(axis) + base);
+                    const __m256 t0 = _mm256_add_ps(lo, _mm256_mul_ps(loadQuantized(clip.getTranslation(axis) + row0 + base), step));
+                    const __m256 t1 = _mm256_add_ps(lo, _mm256_mul_ps(loadQuantized(clip.getTranslation(axis) + row1 + base), step));
+                    const __m256 t = _mm256_add_ps(t0, _mm256_mul_ps(_mm256_sub_ps(t1, t0), alpha));
+                    const __m256 previous = first ? zero : _mm256_loadu_ps(pose.translation[axis] + base);
+                    _mm256_storeu_ps(pose.translation[axis] + base, _mm256_add_ps(previous, _mm256_mul_ps(t, w)));
+                }
+            }
+        }
+
+        void poseToLocalAvx2(const PoseView& pose, float inv_weight, float* local, uint32_t padded_bones) {
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 two = _mm256_set1_ps(2.0f);
+            const __m256 iw = _mm256_set1_ps(inv_weight);
+
+            for (uint32_t base = 0; base < padded_bones; base += LANES) {
+                __m256 q[4];
+                for (size_t i = 0; i < 4; ++i) q[i] = _mm256_loadu_ps(pose.rotation[i] + base);
+
+                // Zero quaternion -> identity
+                const __m256 length = _mm256_sqrt_ps(dot4(q, q));
+                const __m256 inv_length = _mm256_and_ps(_mm256_div_ps(one, length), _mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_GT_OQ));
+                for (size_t i = 0; i < 4; ++i) q[i] = _mm256_mul_ps(q[i], inv_length);
+
+                const __m256 xx = _mm256_mul_ps(q[0], q[0]), yy = _mm256_mul_ps(q[1], q[1]), zz = _mm256_mul_ps(q[2], q[2]);
+                const __m256 xy = _mm256_mul_ps(q[0], q[1]), xz = _mm256_mul_ps(q[0], q[2]), yz = _mm256_mul_ps(q[1], q[2]);
+                const __m256 wx = _mm256_mul_ps(q[3], q[0]), wy = _mm256_mul_ps(q[3], q[1]), wz = _mm256_mul_ps(q[3], q[2]);
+
+                const __m256 m[MATRIX_FLOATS] = {
+                    _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))),
+                    _mm256_mul_ps(two, _mm256_sub_ps(xy, wz)),
+                    _mm256_mul_ps(two, _mm256_add_ps(xz, wy)),
+                    _mm256_mul_ps(_mm256_loadu_ps(pose.translation[0] + base), iw),
+                    _mm256_mul_ps(two, _mm256_add_ps(xy, wz)),
+                    _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))),
+                    _mm256_mul_ps(two, _mm256_sub_ps(yz, wx)),
+                    _mm256_mul_ps(_mm256_loadu_ps(pose.translation[1] + base), iw),
+                    _mm256_mul_ps(two, _mm256_sub_ps(xz, wy)),
+                    _mm256_mul_ps(two, _mm256_add_ps(yz, wx)),
+                    _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))),
+                    _mm256_mul_ps(_mm256_loadu_ps(pose.translation[2] + base), iw),
+                };
+                for (size_t k = 0; k < MATRIX_FLOATS; ++k) _mm256_storeu_ps(local + k * padded_bones + base, m[k]);
+            }
+        }
+
+        void multiplySoAAvx2(const float* a, const float* b, float* c, uint32_t padded_bones) {
+            for (uint32_t base = 0; base < padded_bones; base += LANES) {
+                __m256 ma[MATRIX_FLOATS], mb[MATRIX_FLOATS];
+                for (size_t k = 0; k < MATRIX_FLOATS; ++k) {
+                    ma[k] = _mm256_loadu_ps(a + k * padded_bones + base);
+                    mb[k] = _mm256_loadu_ps(b + k * padded_bones + base);
+                }
+                for (size_t row = 0; row < 3; ++row) {
+                    const __m256* r = ma + row * 4;
+                    for (size_t col = 0; col < 4; ++col) {
+                        __m256 value = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r[0], mb[col]), _mm256_mul_ps(r[1], mb[4 + col])),
+                            _mm256_mul_ps(r[2], mb[8 + col]));
+                        if (col == 3) value = _mm256_add_ps(value, r[3]);
+                        _mm256_storeu_ps(c + (row * 4 + col) * padded_bones + base, value);
+                    }
+                }
+            }
+        }
+#endif
+
+        // ---- Dispatch
+
+        void sampleLayer(const AnimationClip& clip, const FrameSample& frames, float weight, bool first,
+            const PoseView& pose, uint32_t padded_bones, [[maybe_unused]] bool simd) {
+#if defined(__AVX2__)
+            if (simd) return sampleLayerAvx2(clip, frames, weight, first, pose, padded_bones);
+#endif
+            sampleLayerScalar(clip, frames, weight, first, pose, padded_bones);
+        }
+
+        void poseToLocal(const PoseView& pose, float inv_weight, float* local, uint32_t padded_bones, [[maybe_unused]] bool simd) {
+#if defined(__AVX2__)
+            if (simd) return poseToLocalAvx2(pose, inv_weight, local, padded_bones);
+#endif
+            poseToLocalScalar(pose, inv_weight, local, padded_bones);
+        }
+
+        void multiplySoA(const float* a, const float* b, float* c, uint32_t padded_bones, [[maybe_unused]] bool simd) {
+#if defined(__AVX2__)
+            if (simd) return multiplySoAAvx2(a, b, c, padded_bones);
+#endif
+            multiplySoAScalar(a, b, c, padded_bones);
+        }
+    }
+
+    // ==========================================
+    // ANIMATION SYSTEM
+    // ==========================================
+
+    void AnimationSystem::PoseScratch::resize(size_t padded_bones) {
+        if (local.size() >= padded_bones * MATRIX_FLOATS) return;
+        for (auto& component : rotation) component.resize(padded_bones);
+        for (auto& component : translation) component.resize(padded_bones);
+        local.resize(padded_bones * MATRIX_FLOATS);
+        model.resize(padded_bones * MATRIX_FLOATS);
+        skin.resize(padded_bones * MATRIX_FLOATS);
+    }
+
+    AnimationSystem::AnimationSystem(const AnimationConfig& config)
+        : config_(config) {
+        config_.batch_size = std::max<size_t>(config_.batch_size, 1);
+        for (uint32_t& interval : config_.lod_intervals) interval = std::max(interval, 1u);
+    }
+
+    std::optional<uint32_t> AnimationSystem::addSkeleton(const Skeleton& skeleton) {
+        if (!skeleton.isValid()) {
+            print_e("Invalid skeleton: bones must follow their parents and have an inverse bind matrix", LogContext{
+                {"bones", skeleton.parents.size()},
+                {"inverse_bind", skeleton.inverse_bind.size()}
+                });
+            return std::nullopt;
+        }
+
+        SkeletonData data;
+        data.skeleton = skeleton;
+        data.padded_bones = (skeleton.getBoneCount() + LANES - 1) / LANES * LANES;
+        data.inverse_bind.resize(data.padded_bones * MATRIX_FLOATS);
+        for (uint32_t bone = 0; bone < data.padded_bones; ++bone) {
+            const float* m = bone < skeleton.getBoneCount() ? skeleton.inverse_bind[bone].data() : IDENTITY_3X4;
+            for (size_t k = 0; k < MATRIX_FLOATS; ++k) data.inverse_bind[k * data.padded_bones + bone] = m[k];
+        }
+
+        max_padded_bones_ = std::max(max_padded_bones_, data.padded_bones);
+        skeletons_.push_back(std::move(data));
+        return static_cast<uint32_t>(skeletons_.size() - 1);
+    }
+
+    uint32_t AnimationSystem::addClip(AnimationClip clip) {
+        clips_.push_back(std::move(clip));
+        return static_cast<uint32_t>(clips_.size() - 1);
+    }
+
+    std::optional<uint32_t> AnimationSystem::createInstance(uint32_t skeleton) {
+        if (skeleton >= skeletons_.size()) {
+            print_e("Unknown skeleton", LogContext{ {"skeleton", skeleton} });
+            return std::nullopt;
+        }
+
+        uint32_t id;
+        if (!free_instances_.empty()) {
+            id = free_instances_.back();
+            free_instances_.pop_back();
+        }
+        else {
+            id = static_cast<uint32_t>(instances_.size());
+            instances_.emplace_back();
+        }
+
+        Instance& instance = instances_[id];
+        instance = {};
+        instance.skeleton = skeleton;
+        instance.palette_offset = allocatePalette(skeletons_[skeleton].skeleton.getBoneCount());
+        instance.alive = true;
+        return id;
+    }
+
+    void AnimationSystem::destroyInstance(uint32_t instance) {
+        if (instance >= instances_.size() || !instances_[instance].alive) return;
+
+        Instance& data = instances_[instance];
+        freePalette(data.palette_offset, skeletons_[data.skeleton].skeleton.getBoneCount());
+        data.alive = false;
+        data.palette_offset = NO_PALETTE;
+        free_instances_.push_back(instance);
+    }
+
+    bool AnimationSystem::setLayers(uint32_t instance, std::span<const AnimationLayer> layers) {
+        if (instance >= instances_.size() || !instances_[instance].alive) return false;
+        Instance& data = instances_[instance];
+
+        const uint32_t bone_count = skeletons_[data.skeleton].skeleton.getBoneCount();
+        if (layers.size() > MAX_LAYERS) {
+            print_w("Too many animation layers", LogContext{ {"layers", layers.size()}, {"max", MAX_LAYERS} });
+            return false;
+        }
+        for (const AnimationLayer& layer : layers) {
+            if (layer.clip >= clips_.size() || clips_[layer.clip].getBoneCount() != bone_count) {
+                print_w("Animation clip does not match skeleton", LogContext{
+                    {"clip", layer.clip},
+                    {"bones", bone_count}
+                    });
+                return false;
+            }
+        }
+
+        std::copy(layers.begin(), layers.end(), data.layers.begin());
+        data.layer_count = static_cast<uint32_t>(layers.size());
+        data.pending_dt = 0.0f;
+        data.dirty = true;
+        return true;
+    }
+
+    void AnimationSystem::setPosition(uint32_t instance, const std::array<float, 3>& position) {
+        if (instance < instances_.size() && instances_[instance].alive) {
+            instances_[instance].position = position;
+        }
+    }
+
+    std::span<const AnimationLayer> AnimationSystem::getLayers(uint32_t instance) const noexcept {
+        if (instance >= instances_.size() || !instances_[instance].alive) return {};
+        return { instances_[instance].layers.data(), instances_[instance].layer_count };
+    }
+
+    uint32_t AnimationSystem::getPaletteOffset(uint32_t instance) const noexcept {
+        return instance < instances_.size() ? instances_[instance].palette_offset : NO_PALETTE;
+    }
+
+    void AnimationSystem::update(float dt, const std::array<float, 3>& camera_position, JobSystem* jobs) {
+        stats_ = {};
+        due_.clear();
+
+        // ---- Pick due instances and advance their clocks (serial, cheap)
+        for (uint32_t id = 0; id < instances_.size(); ++id) {
+            Instance& instance = instances_[id];
+            if (!instance.alive) continue;
+            ++stats_.instances;
+            instance.pending_dt += dt;
+
+            const float dx = instance.position[0] - camera_position[0];
+            const float dy = instance.position[1] - camera_position[1];
+            const float dz = instance.position[2] - camera_position[2];
+            const float distance_sq = dx * dx + dy * dy + dz * dz;
+            size_t level = 0;
+            while (level < config_.lod_distances.size() && distance_sq > config_.lod_distances[level] * config_.lod_distances[level]) {
+                ++level;
+            }
+
+            // Offsetting by id spreads each LOD level's updates over its interval
+            const uint32_t interval = config_.lod_intervals[level];
+            if (!instance.dirty && (frame_counter_ + id) % interval != 0) {
+                ++stats_.skipped_lod;
+                continue;
+            }
+
+            for (uint32_t i = 0; i < instance.layer_count; ++i) {
+                AnimationLayer& layer = instance.layers[i];
+                layer.time = wrapTime(layer.time + instance.pending_dt * layer.speed, clips_[layer.clip].getDuration(), layer.loop);
+            }
+            instance.pending_dt = 0.0f;
+            instance.dirty = false;
+
+            due_.push_back(id);
+            stats_.bones_sampled += static_cast<uint64_t>(skeletons_[instance.skeleton].skeleton.getBoneCount()) * instance.layer_count;
+        }
+        ++frame_counter_;
+        stats_.updated = static_cast<uint32_t>(due_.size());
+        if (due_.empty()) return;
+
+        // ---- Evaluate poses in batches; each instance writes only its own palette range
+        scratch_.resize(jobs ? jobs->getThreadCount() : 1);
+        for (PoseScratch& scratch : scratch_) scratch.resize(max_padded_bones_);
+
+        forEachBatch(jobs, due_.size(), config_.batch_size, [&](size_t, size_t begin, size_t end) {
+            PoseScratch& scratch = scratch_[jobs ? jobs->getThreadIndex() : 0];
+            for (size_t i = begin; i < end; ++i) {
+                evaluate(instances_[due_[i]], scratch);
+            }
+            });
+    }
+
+    void AnimationSystem::evaluate(const Instance& instance, PoseScratch& scratch) {
+        const SkeletonData& skeleton = skeletons_[instance.skeleton];
+        const uint32_t bone_count = skeleton.skeleton.getBoneCount();
+        const uint32_t padded = skeleton.padded_bones;
+        float* palette = palette_.data() + static_cast<size_t>(instance.palette_offset) * MATRIX_FLOATS;
+
+        const bool simd = config_.use_simd && isSimdAvailable();
+
+        const PoseView pose{
+            { scratch.rotation[0].data(), scratch.rotation[1].data(), scratch.rotation[2].data(), scratch.rotation[3].data() },
+            { scratch.translation[0].data(), scratch.translation[1].data(), scratch.translation[2].data() },
+        };
+
+        // ---- Sample and blend layers into the SoA pose
+        float total_weight = 0.0f;
+        for (uint32_t i = 0; i < instance.layer_count; ++i) {
+            const AnimationLayer& layer = instance.layers[i];
+            if (!(layer.weight > 0.0f)) continue;
+
+            const AnimationClip& clip = clips_[layer.clip];
+            const FrameSample frames = locateFrames(clip, layer);
+            const bool first = total_weight == 0.0f;
+            sampleLayer(clip, frames, layer.weight, first, pose, padded, simd);
+            total_weight += layer.weight;
+        }
+
+        // Nothing playing: bind pose
+        if (total_weight == 0.0f) {
+            for (uint32_t bone = 0; bone < bone_count; ++bone) {
+                std::memcpy(palette + bone * MATRIX_FLOATS, IDENTITY_3X4, sizeof(IDENTITY_3X4));
+            }
+            return;
+        }
+
+        float* local = scratch.local.data();
+        float* model = scratch.model.data();
+        float* skin = scratch.skin.data();
+
+        poseToLocal(pose, 1.0f / total_weight, local, padded, simd);
+
+        // ---- Parent chain: parents precede children, so one forward pass resolves it
+        const std::vector<int32_t>& parents = skeleton.skeleton.parents;
+        for (uint32_t bone = 0; bone < padded; ++bone) {
+            float child[MATRIX_FLOATS];
+            for (size_t k = 0; k < MATRIX_FLOATS; ++k) child[k] = local[k * padded + bone];
+
+            if (bone >= bone_count || parents[bone] < 0) {
+                for (size_t k = 0; k < MATRIX_FLOATS; ++k) model[k * padded + bone] = child[k];
+                continue;
+            }
+
+            const auto parent = static_cast<uint32_t>(parents[bone]);
+            float parent_model[MATRIX_FLOATS], result[MATRIX_FLOATS];
+            for (size_t k = 0; k < MATRIX_FLOATS; ++k) parent_model[k] = model[k * padded + parent];
+            multiplyAffine(parent_model, child, result);
+            for (size_t k = 0; k < MATRIX_FLOATS; ++k) model[k * padded + bone] = result[k];
+        }
+
+        // ---- Skinning matrices, transposed out of SoA into the palette
+        multiplySoA(model, skeleton.inverse_bind.data(), skin, padded, simd);
+        for (uint32_t bone = 0; bone < bone_count; ++bone) {
+            for (size_t k = 0; k < MATRIX_FLOATS; ++k) {
+                palette[bone * MATRIX_FLOATS + k] = skin[k * padded + bone];
+            }
+        }
+    }
+
+    bool AnimationSystem::writePalette(UploadManager& uploads, GpuBufferHandle palette_buffer, uint64_t dst_offset) const {
+        if (palette_bones_ == 0) return true;
+
+        const uint64_t bytes = static_cast<uint64_t>(palette_bones_) * MATRIX_FLOATS * sizeof(float);
+        auto write = uploads.writeBuffer(palette_buffer, dst_offset, bytes);
+        if (!write) {
+            return false;
+        }
+        std::memcpy(write->data.data(), palette_.data(), bytes);
+        return true;
+    }
+
+    // ==========================================
+    // PALETTE ALLOCATION
+    // ==========================================
+
+    uint32_t AnimationSystem::allocatePalette(uint32_t bone_count) {
+        uint32_t offset;
+        auto& free_list = free_palettes_[bone_count];
+        if (!free_list.empty()) {
+            offset = free_list.back();
+            free_list.pop_back();
+        }
+        else {
+            offset = palette_bones_;
+            palette_bones_ += bone_count;
+            palette_.resize(static_cast<size_t>(palette_bones_) * MATRIX_FLOATS);
+        }
+
+        for (uint32_t bone = 0; bone < bone_count; ++bone) {
+            std::memcpy(palette_.data() + (static_cast<size_t>(offset) + bone) * MATRIX_FLOATS, IDENTITY_3X4, sizeof(IDENTITY_3X4));
+        }
+        return offset;
+    }
+
+    void AnimationSystem::freePalette(uint32_t offset, uint32_t bone_count) {
+        free_palettes_[bone_count].push_back(offset);
+    }
+
+    bool AnimationSystem::isSimdAvailable() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+} // namespace AshCore
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "RenderTypes.h"
+#include "Animation/AnimationClip.h"
+#include "Entity/EntityInstanceBatcher.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+    class UploadManager;
+
+    // ==========================================
+    // CONFIGURATION
+    // ==========================================
+
+    struct AnimationLayer {
+        uint32_t clip = 0;
+        float time = 0.0f;    // Seconds; advanced by update()
+        float speed = 1.0f;
+        float weight = 1.0f;
+        bool loop = true;
+    };
+
+    struct AnimationConfig {
+        size_t batch_size = 64;  // Instances per job
+        bool use_simd = true;
+
+        // Camera distance thresholds; beyond lod_distances[i] an instance is
+        // evaluated every lod_intervals[i + 1] frames
+        std::array<float, 3> lod_distances{ 16.0f, 32.0f, 64.0f };
+        std::array<uint32_t, 4> lod_intervals{ 1, 2, 4, 8 };
+    };
+
+    struct AnimationStats {
+        uint32_t instances = 0;
+        uint32_t updated = 0;
+        uint32_t skipped_lod = 0;
+        uint64_t bones_sampled = 0;  // Bones x layers evaluated this frame
+    };
+
+    // ==========================================
+    // ANIMATION SYSTEM
+    // ==========================================
+
+    /**
+     * @brief Samples compressed clips, blends layers and builds skinning palettes
+     *
+     * Poses are SoA (one array per component, bones padded to 8) so
+     * decoding, interpolation, blending and the quaternion -> matrix
+     * conversion run eight bones per AVX2 instruction. Only the parent
+     * chain is resolved bone by bone. Instances are evaluated in batches on
+     * the job system and each writes its own palette range, so results do
+     * not depend on thread count.
+     *
+     * Palettes are row-major 3x4 matrices (model space * inverse bind)
+     * packed in one array; getPaletteOffset() is the value for
+     * EntityRenderProxy::palette_offset.
+     */
+    class AnimationSystem {
+    public:
+        static constexpr uint32_t MAX_LAYERS = 4;
+        static constexpr size_t FLOATS_PER_BONE = 12;
+
+        explicit AnimationSystem(const AnimationConfig& config = {});
+
+        [[nodiscard]] std::optional<uint32_t> addSkeleton(const Skeleton& skeleton);
+        [[nodiscard]] uint32_t addClip(AnimationClip clip);
+
+        [[nodiscard]] std::optional<uint32_t> createInstance(uint32_t skeleton);
+        void destroyInstance(uint32_t instance);
+
+        // Clips must match the instance's skeleton; at most MAX_LAYERS
+        bool setLayers(uint32_t instance, std::span<const AnimationLayer> layers);
+        void setPosition(uint32_t instance, const std::array<float, 3>& position);
+
+        [[nodiscard]] std::span<const AnimationLayer> getLayers(uint32_t instance) const noexcept;
+        [[nodiscard]] uint32_t getPaletteOffset(uint32_t instance) const noexcept;
+
+        // jobs may be null for single-threaded evaluation
+        void update(float dt, const std::array<float, 3>& camera_position, JobSystem* jobs);
+
+        // Copies the used palette range to palette_buffer at dst_offset
+        bool writePalette(UploadManager& uploads, GpuBufferHandle palette_buffer, uint64_t dst_offset) const;
+
+        [[nodiscard]] std::span<const float> getPaletteData() const noexcept { return palette_; }
+        [[nodiscard]] uint32_t getPaletteBoneCount() const noexcept { return palette_bones_; }
+        [[nodiscard]] const AnimationStats& getStats() const noexcept { return stats_; }
+        [[nodiscard]] const AnimationConfig& getConfig() const noexcept { return config_; }
+
+        [[nodiscard]] static bool isSimdAvailable() noexcept;
+
+    private:
+        struct SkeletonData {
+            Skeleton skeleton;
+            uint32_t padded_bones = 0;
+            std::vector<float> inverse_bind;  // SoA: element k of bone b at [k * padded_bones + b]
+        };
+
+        struct Instance {
+            uint32_t skeleton = 0;
+            uint32_t palette_offset = NO_PALETTE;
+            uint32_t layer_count = 0;
+            std::array<AnimationLayer, MAX_LAYERS> layers{};
+            std::array<float, 3> position{};
+            float pending_dt = 0.0f;
+            bool alive = false;
+            bool dirty = true;  // Evaluate next frame regardless of LOD
+        };
+
+        // Per-thread working set; every array holds max_padded_bones_ lanes
+        struct PoseScratch {
+            std::array<std::vector<float>, 4> rotation;
+            std::array<std::vector<float>, 3> translation;
+            std::vector<float> local;  // 12 SoA rows
+            std::vector<float> model;
+            std::vector<float> skin;
+
+            void resize(size_t padded_bones);
+        };
+
+    private:
+        void evaluate(const Instance& instance, PoseScratch& scratch);
+
+        uint32_t allocatePalette(uint32_t bone_count);
+        void freePalette(uint32_t offset, uint32_t bone_count);
+
+    private:
+        AnimationConfig config_;
+        AnimationStats stats_;
+        uint64_t frame_counter_ = 0;
+
+        std::vector<SkeletonData> skeletons_;
+        std::vector<AnimationClip> clips_;
+        std::vector<Instance> instances_;
+        std::vector<uint32_t> free_instances_;
+
+        // Palette ranges: bump allocated, recycled per bone count
+        std::vector<float> palette_;
+        uint32_t palette_bones_ = 0;
+        std::unordered_map<uint32_t, std::vector<uint32_t>> free_palettes_;
+
+        uint32_t max_padded_bones_ = 0;
+        std::vector<PoseScratch> scratch_;
+        std::vector<uint32_t> due_;
+    };
+
+} // namespace AshCore
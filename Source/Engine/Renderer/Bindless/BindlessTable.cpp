@@ -0,0 +1,259 @@
+#include "ashbornpch.h"
+
+#include "BindlessTable.h"
+
+#include <algorithm>
+
+namespace AshCore {
+
+    namespace {
+        const char* getTypeName(BindlessType type) noexcept {
+            switch (type) {
+            case BindlessType::SampledImage: return "SampledImage";
+            case BindlessType::StorageImage: return "StorageImage";
+            case BindlessType::StorageBuffer: return "StorageBuffer";
+            case BindlessType::Sampler: return "Sampler";
+            default: return "Unknown";
+            }
+        }
+
+        bool hasResource(const BindlessResource& resource) noexcept {
+            return resource.image.isValid() || resource.buffer.isValid() || resource.sampler.isValid();
+        }
+    }
+
+    // ==========================================
+    // INDEX ALLOCATOR
+    // ==========================================
+
+    BindlessIndexAllocator::BindlessIndexAllocator(BindlessType type, uint32_t capacity) {
+        reset(type, capacity);
+    }
+
+    void BindlessIndexAllocator::reset(BindlessType type, uint32_t capacity) {
+        capacity = std::clamp(capacity, 1u, BindlessHandle::MAX_INDEX + 1);
+
+        type_ = type;
+        generations_.assign(capacity, 0);
+        alive_.assign(capacity, 0);
+        used_ = 0;
+
+        free_.clear();
+        free_.reserve(capacity - 1);
+        for (uint32_t index = capacity - 1; index >= 1; --index) {
+            free_.push_back(index);
+        }
+    }
+
+    std::optional<BindlessHandle> BindlessIndexAllocator::allocate() {
+        if (free_.empty()) return std::nullopt;
+
+        const uint32_t index = free_.back();
+        free_.pop_back();
+        alive_[index] = 1;
+        ++used_;
+        return BindlessHandle::make(type_, generations_[index], index);
+    }
+
+    bool BindlessIndexAllocator::retire(BindlessHandle handle) {
+        if (!isAlive(handle)) return false;
+
+        const uint32_t index = handle.getIndex();
+        alive_[index] = 0;
+        generations_[index] = static_cast<uint8_t>((generations_[index] + 1) & BindlessHandle::GENERATION_MASK);
+        return true;
+    }
+
+    void BindlessIndexAllocator::recycle(uint32_t index) {
+        free_.push_back(index);
+        --used_;
+    }
+
+    bool BindlessIndexAllocator::isAlive(BindlessHandle handle) const noexcept {
+        const uint32_t index = handle.getIndex();
+        return handle.isValid() && handle.getType() == type_ && index < generations_.size() &&
+            alive_[index] && generations_[index] == handle.getGeneration();
+    }
+
+    // ==========================================
+    // BINDLESS TABLE
+    // ==========================================
+
+    BindlessTable::BindlessTable(IBindlessBackend& backend, const BindlessConfig& config)
+        : backend_(backend)
+        , config_(config) {
+        for (size_t type = 0; type < BINDLESS_TYPE_COUNT; ++type) {
+            allocators_[type].reset(static_cast<BindlessType>(type), config_.capacities[type]);
+            config_.capacities[type] = allocators_[type].getCapacity();
+        }
+    }
+
+    std::expected<void, RendererError> BindlessTable::initialize() {
+        if (auto result = backend_.createTable(config_.capacities); !result) {
+            print_e("Failed to create bindless descriptor table");
+            return result;
+        }
+
+        print_s("Bindless table initialized", LogContext{
+            {"sampled_images", config_.capacities[0]},
+            {"storage_images", config_.capacities[1]},
+            {"storage_buffers", config_.capacities[2]},
+            {"samplers", config_.capacities[3]}
+            });
+        return {};
+    }
+
+    void BindlessTable::setFallback(BindlessType type, const BindlessResource& resource) {
+        std::lock_guard lock(mutex_);
+        fallbacks_[static_cast<size_t>(type)] = resource;
+        pending_writes_.push_back({ type, 0, resource });
+    }
+
+    std::optional<BindlessHandle> BindlessTable::registerImage(GpuImageHandle image, BindlessType type) {
+        if (type != BindlessType::SampledImage && type != BindlessType::StorageImage) {
+            print_e("registerImage needs an image descriptor type", LogContext{ {"type", getTypeName(type)} });
+            return std::nullopt;
+        }
+        BindlessResource resource;
+        resource.image = image;
+        return registerResource(type, resource);
+    }
+
+    std::optional<BindlessHandle> BindlessTable::registerBuffer(GpuBufferHandle buffer, uint64_t offset, uint64_t range) {
+        BindlessResource resource;
+        resource.buffer = buffer;
+        resource.offset = offset;
+        resource.range = range;
+        return registerResource(BindlessType::StorageBuffer, resource);
+    }
+
+    std::optional<BindlessHandle> BindlessTable::registerSampler(GpuSamplerHandle sampler) {
+        BindlessResource resource;
+        resource.sampler = sampler;
+        return registerResource(BindlessType::Sampler, resource);
+    }
+
+    std::optional<BindlessHandle> BindlessTable::registerResource(BindlessType type, const BindlessResource& resource) {
+        std::lock_guard lock(mutex_);
+
+        auto handle = allocators_[static_cast<size_t>(type)].allocate();
+        if (!handle) {
+            if (allocation_failures_++ == 0) {
+                print_e("Bindless table full", LogContext{
+                    {"type", getTypeName(type)},
+                    {"capacity", config_.capacities[static_cast<size_t>(type)]}
+                    });
+            }
+            return std::nullopt;
+        }
+
+        pending_writes_.push_back({ type, handle->getIndex(), resource });
+        return handle;
+    }
+
+    void BindlessTable::release(BindlessHandle handle, uint64_t last_used_frame) {
+        std::lock_guard lock(mutex_);
+
+        const size_t type = static_cast<size_t>(handle.getType());
+        if (type >= BINDLESS_TYPE_COUNT || !allocators_[type].retire(handle)) {
+            ++stale_handle_errors_;
+            print_w("Released a stale bindless handle", LogContext{ {"handle", handle.value} });
+            return;
+        }
+
+        // Frames are usually released in order; keep the queue sorted when they aren't
+        auto it = pending_frees_.end();
+        if (!pending_frees_.empty() && pending_frees_.back().frame > last_used_frame) {
+            it = std::upper_bound(pending_frees_.begin(), pending_frees_.end(), last_used_frame,
+                [](uint64_t frame, const PendingFree& pending) { return frame < pending.frame; });
+        }
+        pending_frees_.insert(it, { last_used_frame, handle });
+    }
+
+    bool BindlessTable::isAlive(BindlessHandle handle) const {
+        std::lock_guard lock(mutex_);
+        const size_t type = static_cast<size_t>(handle.getType());
+        return type < BINDLESS_TYPE_COUNT && allocators_[type].isAlive(handle);
+    }
+
+    void BindlessTable::collect(uint64_t completed_frame) {
+        std::lock_guard lock(mutex_);
+
+        while (!pending_frees_.empty() && pending_frees_.front().frame <= completed_frame) {
+            const BindlessHandle handle = pending_frees_.front().handle;
+            const size_t type = static_cast<size_t>(handle.getType());
+            pending_frees_.pop_front();
+
+            // Stray indices now read the fallback instead of a destroyed resource
+            if (hasResource(fallbacks_[type])) {
+                pending_writes_.push_back({ handle.getType(), handle.getIndex(), fallbacks_[type] });
+            }
+            allocators_[type].recycle(handle.getIndex());
+        }
+    }
+
+    void BindlessTable::flush() {
+        writes_.clear();
+        runs_.clear();
+        {
+            std::lock_guard lock(mutex_);
+            writes_.swap(pending_writes_);
+        }
+
+        if (writes_.empty()) {
+            writes_last_flush_ = 0;
+            runs_last_flush_ = 0;
+            return;
+        }
+
+        // Sort by slot, last write per slot wins, then merge consecutive slots into runs
+        std::stable_sort(writes_.begin(), writes_.end(), [](const BindlessDescriptorWrite& a, const BindlessDescriptorWrite& b) {
+            if (a.type != b.type) return a.type < b.type;
+            return a.index < b.index;
+            });
+
+        size_t out = 0;
+        for (size_t i = 0; i < writes_.size(); ++i) {
+            if (out > 0 && writes_[out - 1].type == writes_[i].type && writes_[out - 1].index == writes_[i].index) {
+                writes_[out - 1] = writes_[i];
+                continue;
+            }
+            writes_[out++] = writes_[i];
+        }
+        writes_.resize(out);
+
+        for (uint32_t i = 0; i < writes_.size(); ++i) {
+            const BindlessDescriptorWrite& write = writes_[i];
+            if (!runs_.empty()) {
+                BindlessWriteRun& run = runs_.back();
+                if (run.type == write.type && run.first_index + run.count == write.index) {
+                    ++run.count;
+                    continue;
+                }
+            }
+            runs_.push_back({ write.type, write.index, 1, i });
+        }
+
+        backend_.writeDescriptors(writes_, runs_);
+        writes_last_flush_ = static_cast<uint32_t>(writes_.size());
+        runs_last_flush_ = static_cast<uint32_t>(runs_.size());
+    }
+
+    BindlessStats BindlessTable::getStats() const {
+        std::lock_guard lock(mutex_);
+
+        BindlessStats stats;
+        for (size_t type = 0; type < BINDLESS_TYPE_COUNT; ++type) {
+            stats.used[type] = allocators_[type].getUsed();
+            stats.capacity[type] = allocators_[type].getCapacity();
+        }
+        stats.pending_frees = static_cast<uint32_t>(pending_frees_.size());
+        stats.pending_writes = static_cast<uint32_t>(pending_writes_.size());
+        stats.writes_last_flush = writes_last_flush_;
+        stats.runs_last_flush = runs_last_flush_;
+        stats.stale_handle_errors = stale_handle_errors_;
+        stats.allocation_failures = allocation_failures_;
+        return stats;
+    }
+
+} // namespace AshCore
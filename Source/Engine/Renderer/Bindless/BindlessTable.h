@@ -0,0 +1,206 @@
+#pragma once
+
+#include "RenderTypes.h"
+#include "Engine/EngineErrors.h"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // HANDLES
+    // ==========================================
+
+    enum class BindlessType : uint8_t {
+        SampledImage,
+        StorageImage,
+        StorageBuffer,
+        Sampler,
+        Count
+    };
+
+    inline constexpr size_t BINDLESS_TYPE_COUNT = static_cast<size_t>(BindlessType::Count);
+
+    /**
+     * Packed as [type:4 | generation:8 | index:20]. Shaders only use the low 20
+     * bits; the rest lets the CPU side reject handles whose slot was recycled.
+     * Index 0 of every type is reserved for the fallback descriptor, so a
+     * zero handle is never valid.
+     */
+    struct BindlessHandle {
+        static constexpr uint32_t INDEX_BITS = 20;
+        static constexpr uint32_t GENERATION_BITS = 8;
+        static constexpr uint32_t MAX_INDEX = (1u << INDEX_BITS) - 1;
+        static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+
+        uint32_t value = 0;
+
+        [[nodiscard]] static constexpr BindlessHandle make(BindlessType type, uint32_t generation, uint32_t index) noexcept {
+            return BindlessHandle{ (static_cast<uint32_t>(type) << (INDEX_BITS + GENERATION_BITS)) |
+                ((generation & GENERATION_MASK) << INDEX_BITS) | (index & MAX_INDEX) };
+        }
+
+        [[nodiscard]] constexpr uint32_t getIndex() const noexcept { return value & MAX_INDEX; }
+        [[nodiscard]] constexpr uint32_t getGeneration() const noexcept { return (value >> INDEX_BITS) & GENERATION_MASK; }
+        [[nodiscard]] constexpr BindlessType getType() const noexcept { return static_cast<BindlessType>(value >> (INDEX_BITS + GENERATION_BITS)); }
+        [[nodiscard]] constexpr bool isValid() const noexcept { return getIndex() != 0; }
+
+        constexpr auto operator<=>(const BindlessHandle&) const noexcept = default;
+    };
+
+    // ==========================================
+    // INDEX ALLOCATOR
+    // ==========================================
+
+    // Free-list slot allocator with per-slot generations (slot 0 is reserved)
+    class BindlessIndexAllocator {
+    public:
+        BindlessIndexAllocator() = default;
+        BindlessIndexAllocator(BindlessType type, uint32_t capacity);
+
+        void reset(BindlessType type, uint32_t capacity);
+
+        [[nodiscard]] std::optional<BindlessHandle> allocate();
+
+        // Bumps the generation so copies of the handle stop validating; the slot
+        // is only reusable after recycle(). Returns false for stale handles.
+        bool retire(BindlessHandle handle);
+        void recycle(uint32_t index);
+
+        [[nodiscard]] bool isAlive(BindlessHandle handle) const noexcept;
+        [[nodiscard]] uint32_t getCapacity() const noexcept { return static_cast<uint32_t>(generations_.size()); }
+        [[nodiscard]] uint32_t getUsed() const noexcept { return used_; }
+
+    private:
+        BindlessType type_ = BindlessType::SampledImage;
+        std::vector<uint8_t> generations_;
+        std::vector<uint8_t> alive_;
+        std::vector<uint32_t> free_;  // Stack, starts with the lowest index on top to keep the table dense
+        uint32_t used_ = 0;           // Allocated or waiting to be recycled
+    };
+
+    // ==========================================
+    // DESCRIPTOR WRITES / BACKEND
+    // ==========================================
+
+    struct BindlessResource {
+        GpuImageHandle image;      // SampledImage / StorageImage
+        GpuBufferHandle buffer;    // StorageBuffer
+        uint64_t offset = 0;
+        uint64_t range = 0;        // 0 = whole buffer
+        GpuSamplerHandle sampler;  // Sampler
+    };
+
+    struct BindlessDescriptorWrite {
+        BindlessType type;
+        uint32_t index;
+        BindlessResource resource;
+    };
+
+    // Consecutive indices of one type: one VkWriteDescriptorSet with descriptorCount = count
+    struct BindlessWriteRun {
+        BindlessType type;
+        uint32_t first_index;
+        uint32_t count;
+        uint32_t first_write;  // Into the writes span
+    };
+
+    class IBindlessBackend {
+    public:
+        virtual ~IBindlessBackend() = default;
+
+        // One UPDATE_AFTER_BIND | PARTIALLY_BOUND set with a binding per type
+        [[nodiscard]] virtual std::expected<void, RendererError> createTable(const std::array<uint32_t, BINDLESS_TYPE_COUNT>& capacities) = 0;
+        virtual void writeDescriptors(std::span<const BindlessDescriptorWrite> writes, std::span<const BindlessWriteRun> runs) = 0;
+    };
+
+    // ==========================================
+    // BINDLESS TABLE
+    // ==========================================
+
+    struct BindlessConfig {
+        std::array<uint32_t, BINDLESS_TYPE_COUNT> capacities = { 65536, 8192, 65536, 256 };
+    };
+
+    struct BindlessStats {
+        std::array<uint32_t, BINDLESS_TYPE_COUNT> used{};
+        std::array<uint32_t, BINDLESS_TYPE_COUNT> capacity{};
+        uint32_t pending_frees = 0;
+        uint32_t pending_writes = 0;
+        uint32_t writes_last_flush = 0;
+        uint32_t runs_last_flush = 0;
+        uint32_t stale_handle_errors = 0;
+        uint32_t allocation_failures = 0;
+    };
+
+    /**
+     * @brief Global descriptor table indexed by BindlessHandle from shaders
+     *
+     * Registration may happen on any thread. Writes are queued and handed to
+     * the backend once per frame by flush(), merged into runs of consecutive
+     * indices. Released slots stay untouched until the frames that could
+     * still index them have completed, then point back at the fallback.
+     */
+    class BindlessTable {
+    public:
+        BindlessTable(IBindlessBackend& backend, const BindlessConfig& config = {});
+
+        BindlessTable(const BindlessTable&) = delete;
+        BindlessTable& operator=(const BindlessTable&) = delete;
+
+        [[nodiscard]] std::expected<void, RendererError> initialize();
+
+        // Descriptor for slot 0 and for recycled slots (pink texture, zero buffer, default sampler)
+        void setFallback(BindlessType type, const BindlessResource& resource);
+
+        [[nodiscard]] std::optional<BindlessHandle> registerImage(GpuImageHandle image, BindlessType type = BindlessType::SampledImage);
+        [[nodiscard]] std::optional<BindlessHandle> registerBuffer(GpuBufferHandle buffer, uint64_t offset = 0, uint64_t range = 0);
+        [[nodiscard]] std::optional<BindlessHandle> registerSampler(GpuSamplerHandle sampler);
+
+        // last_used_frame: newest frame whose commands may reference the handle
+        void release(BindlessHandle handle, uint64_t last_used_frame);
+
+        [[nodiscard]] bool isAlive(BindlessHandle handle) const;
+
+        // Frame boundary: recycle slots and submit pending writes (before recording)
+        void collect(uint64_t completed_frame);
+        void flush();
+
+        [[nodiscard]] BindlessStats getStats() const;
+
+    private:
+        struct PendingFree {
+            uint64_t frame;
+            BindlessHandle handle;
+        };
+
+        std::optional<BindlessHandle> registerResource(BindlessType type, const BindlessResource& resource);
+
+    private:
+        IBindlessBackend& backend_;
+        BindlessConfig config_;
+
+        mutable std::mutex mutex_;
+        std::array<BindlessIndexAllocator, BINDLESS_TYPE_COUNT> allocators_;
+        std::array<BindlessResource, BINDLESS_TYPE_COUNT> fallbacks_{};
+        std::deque<PendingFree> pending_frees_;  // Sorted by frame
+        std::vector<BindlessDescriptorWrite> pending_writes_;
+
+        // flush() scratch
+        std::vector<BindlessDescriptorWrite> writes_;
+        std::vector<BindlessWriteRun> runs_;
+
+        uint32_t writes_last_flush_ = 0;
+        uint32_t runs_last_flush_ = 0;
+        uint32_t stale_handle_errors_ = 0;
+        uint32_t allocation_failures_ = 0;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,34 @@
+#include "ashbornpch.h"
+
+#include "NullBindlessBackend.h"
+
+namespace AshCore {
+
+    std::expected<void, RendererError> NullBindlessBackend::createTable(const std::array<uint32_t, BINDLESS_TYPE_COUNT>& capacities) {
+        for (size_t type = 0; type < BINDLESS_TYPE_COUNT; ++type) {
+            table_[type].assign(capacities[type], BindlessResource{});
+        }
+        return {};
+    }
+
+    void NullBindlessBackend::writeDescriptors(std::span<const BindlessDescriptorWrite> writes, std::span<const BindlessWriteRun> runs) {
+        ++write_calls_;
+        runs_ += static_cast<uint32_t>(runs.size());
+
+        for (const BindlessWriteRun& run : runs) {
+            auto& table = table_[static_cast<size_t>(run.type)];
+            for (uint32_t i = 0; i < run.count; ++i) {
+                const BindlessDescriptorWrite& write = writes[run.first_write + i];
+                if (write.index < table.size()) {
+                    table[write.index] = write.resource;
+                }
+                ++descriptors_written_;
+            }
+        }
+    }
+
+    const BindlessResource& NullBindlessBackend::getDescriptor(BindlessType type, uint32_t index) const {
+        return table_[static_cast<size_t>(type)][index];
+    }
+
+} // namespace AshCore
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Bindless/BindlessTable.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // NULL BINDLESS BACKEND
+    // ==========================================
+
+    // Mirrors the descriptor table in memory so tests can check what each index resolves to
+    class NullBindlessBackend final : public IBindlessBackend {
+    public:
+        [[nodiscard]] std::expected<void, RendererError> createTable(const std::array<uint32_t, BINDLESS_TYPE_COUNT>& capacities) override;
+        void writeDescriptors(std::span<const BindlessDescriptorWrite> writes, std::span<const BindlessWriteRun> runs) override;
+
+        [[nodiscard]] const BindlessResource& getDescriptor(BindlessType type, uint32_t index) const;
+        [[nodiscard]] uint32_t getWriteCalls() const noexcept { return write_calls_; }
+        [[nodiscard]] uint32_t getRunCount() const noexcept { return runs_; }
+        [[nodiscard]] uint32_t getDescriptorsWritten() const noexcept { return descriptors_written_; }
+
+    private:
+        std::array<std::vector<BindlessResource>, BINDLESS_TYPE_COUNT> table_;
+        uint32_t write_calls_ = 0;
+        uint32_t runs_ = 0;
+        uint32_t descriptors_written_ = 0;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "RenderTypes.h"
+#include "RenderGraph/RenderGraph.h"
+#include "Engine/AshbornEngine.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+
+namespace AshCore {
+
+    // ==========================================
+    // COMMAND BUFFER INTERFACE
+    // ==========================================
+
+    enum class CommandBufferLevel : uint8_t {
+        Primary,
+        Secondary
+    };
+
+    enum class IndexType : uint8_t {
+        Uint16,
+        Uint32
+    };
+
+    // Attachment formats a secondary buffer renders into (VkCommandBufferInheritanceRenderingInfo)
+    struct CommandInheritance {
+        static constexpr uint32_t MAX_COLOR_ATTACHMENTS = 8;
+
+        RenderFormat color_formats[MAX_COLOR_ATTACHMENTS] = {};
+        uint32_t color_count = 0;
+        RenderFormat depth_format = RenderFormat::Undefined;
+        uint32_t samples = 1;
+    };
+
+    /**
+     * @brief Backend-neutral command recording (the subset of vkCmd* the renderer uses)
+     *
+     * Not thread-safe: a buffer is recorded by one thread at a time.
+     * Secondary buffers inherit no state, so every secondary must bind its
+     * own pipeline and buffers.
+     */
+    class ICommandBuffer {
+    public:
+        virtual ~ICommandBuffer() = default;
+
+        // inheritance is required for secondaries and ignored for primaries
+        virtual void begin(const CommandInheritance* inheritance = nullptr) = 0;
+        virtual void end() = 0;
+
+        virtual void bindPipeline(GpuPipelineHandle pipeline) = 0;
+        virtual void bindVertexBuffer(GpuBufferHandle buffer, uint64_t offset) = 0;
+        virtual void bindIndexBuffer(GpuBufferHandle buffer, uint64_t offset, IndexType type) = 0;
+        virtual void pushConstants(uint32_t offset, std::span<const std::byte> data) = 0;
+
+        virtual void drawIndexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index,
+            int32_t vertex_offset, uint32_t first_instance) = 0;
+        virtual void drawIndexedIndirect(GpuBufferHandle buffer, uint64_t offset, uint32_t draw_count, uint32_t stride) = 0;
+
+        // Primary only; secondaries run in span order
+        virtual void executeCommands(std::span<ICommandBuffer* const> secondaries) = 0;
+
+        [[nodiscard]] virtual CommandBufferLevel getLevel() const noexcept = 0;
+    };
+
+    // One per thread per frame in flight; buffers stay valid until reset()
+    class ICommandPool {
+    public:
+        virtual ~ICommandPool() = default;
+
+        [[nodiscard]] virtual ICommandBuffer* allocate(CommandBufferLevel level) = 0;
+
+        // Recycles every buffer allocated since the last reset (vkResetCommandPool)
+        virtual void reset() = 0;
+    };
+
+    class ICommandBackend {
+    public:
+        virtual ~ICommandBackend() = default;
+
+        [[nodiscard]] virtual std::expected<std::unique_ptr<ICommandPool>, RendererError> createCommandPool(uint32_t thread_index) = 0;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,178 @@
+#include "ashbornpch.h"
+
+#include "ParallelCommandRecorder.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+
+namespace AshCore {
+
+    // ==========================================
+    // CONSTRUCTOR / INITIALIZATION
+    // ==========================================
+
+    ParallelCommandRecorder::ParallelCommandRecorder(ICommandBackend& backend, JobSystem& jobs, const FrameTimeline& timeline,
+        const ParallelRecordConfig& config)
+        : backend_(backend)
+        , jobs_(jobs)
+        , timeline_(timeline)
+        , config_(config) {
+        config_.batch_size = std::max(config_.batch_size, 1u);
+    }
+
+    std::expected<void, RendererError> ParallelCommandRecorder::initialize() {
+        const uint32_t thread_count = jobs_.getThreadCount();
+
+        std::vector<PoolSet> frames;
+        frames.reserve(timeline_.getFramesInFlight());
+        for (uint32_t frame = 0; frame < timeline_.getFramesInFlight(); ++frame) {
+            PoolSet pools;
+            pools.reserve(thread_count);
+            for (uint32_t thread = 0; thread < thread_count; ++thread) {
+                auto pool = backend_.createCommandPool(thread);
+                if (!pool) {
+                    print_e("Failed to create command pool", LogContext{ {"thread", thread}, {"frame_slot", frame} });
+                    return std::unexpected(pool.error());
+                }
+                pools.push_back(std::move(*pool));
+            }
+            frames.push_back(std::move(pools));
+        }
+
+        pools_.emplace(timeline_, std::move(frames), [](PoolSet& pools, uint64_t) {
+            for (auto& pool : pools) pool->reset();
+            });
+        thread_used_.assign(thread_count, 0);
+
+        print_s("Parallel command recorder initialized", LogContext{
+            {"threads", thread_count},
+            {"frames_in_flight", timeline_.getFramesInFlight()}
+            });
+        return {};
+    }
+
+    // ==========================================
+    // RECORDING
+    // ==========================================
+
+    void ParallelCommandRecorder::beginFrame() {
+        frame_pools_ = &pools_->acquire();
+    }
+
+    ICommandPool* ParallelCommandRecorder::getThreadPool() {
+        if (!jobs_.ownsThreadSlot()) {
+            print_e("Command pool requested from a thread outside the job system");
+            return nullptr;
+        }
+        return (*frame_pools_)[jobs_.getThreadIndex()].get();
+    }
+
+    void ParallelCommandRecorder::record(ICommandBuffer& primary, uint32_t item_count, const CommandInheritance& inheritance,
+        const RecordFn& fn) {
+        stats_ = {};
+        stats_.items = item_count;
+        if (item_count == 0) return;
+
+        // Small lists aren't worth the secondary buffer overhead
+        if (!willUseSecondaries(item_count)) {
+            fn(primary, 0, item_count);
+            stats_.recorded_inline = true;
+            stats_.threads_used = 1;
+            return;
+        }
+
+        const uint32_t batch_count = (item_count + config_.batch_size - 1) / config_.batch_size;
+        secondaries_.assign(batch_count, nullptr);
+        std::fill(thread_used_.begin(), thread_used_.end(), 0);
+
+        // Batches only run on threads with a slot of their own (see JobSystem)
+        jobs_.parallelFor(item_count, config_.batch_size, [&](size_t begin, size_t end) {
+            const uint32_t thread = jobs_.getThreadIndex();
+
+            ICommandBuffer* cmd = (*frame_pools_)[thread]->allocate(CommandBufferLevel::Secondary);
+            cmd->begin(&inheritance);
+            fn(*cmd, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+            cmd->end();
+
+            secondaries_[begin / config_.batch_size] = cmd;
+            thread_used_[thread] = 1;
+            });
+
+        primary.executeCommands(secondaries_);
+
+        stats_.secondaries = batch_count;
+        stats_.threads_used = static_cast<uint32_t>(std::count(thread_used_.begin(), thread_used_.end(), 1));
+    }
+
+    void ParallelCommandRecorder::recordSectionDraws(ICommandBuffer& primary, const IndirectDrawList& draws,
+        const SectionDrawState& state, const CommandInheritance& inheritance) {
+        const auto& commands = draws.commands;
+
+        record(primary, static_cast<uint32_t>(commands.size()), inheritance, [&](ICommandBuffer& cmd, uint32_t begin, uint32_t end) {
+            cmd.bindPipeline(state.pipeline);
+            cmd.bindVertexBuffer(state.vertex_buffer, 0);
+            cmd.bindIndexBuffer(state.index_buffer, 0, state.index_type);
+
+            for (uint32_t i = begin; i < end; ++i) {
+                const DrawIndexedIndirectCommand& draw = commands[i];
+                cmd.drawIndexed(draw.index_count, draw.instance_count, draw.first_index, draw.vertex_offset, draw.first_instance);
+            }
+            });
+    }
+
+    // ==========================================
+    // BENCHMARK
+    // ==========================================
+
+    ParallelRecordBenchmarkResult ParallelCommandRecorder::benchmarkRecord(ICommandBackend& backend, JobSystem& jobs,
+        uint32_t draw_count, uint32_t iterations) {
+        using Clock = std::chrono::steady_clock;
+
+        ParallelRecordBenchmarkResult result;
+        result.draws = draw_count;
+        result.iterations = std::max(iterations, 1u);
+        result.threads = jobs.getThreadCount();
+
+        IndirectDrawList draws;
+        draws.commands.reserve(draw_count);
+        for (uint32_t i = 0; i < draw_count; ++i) {
+            draws.commands.push_back({ 36 + (i % 6) * 6, 1, i * 96, static_cast<int32_t>(i * 64), i });
+        }
+
+        const SectionDrawState state{ GpuPipelineHandle{ 1 }, GpuBufferHandle{ 2 }, GpuBufferHandle{ 3 } };
+        const CommandInheritance inheritance{ { RenderFormat::RGBA16Float }, 1, RenderFormat::D32Float };
+
+        auto run = [&](const ParallelRecordConfig& config) -> std::chrono::nanoseconds {
+            SimulatedFrameFence fence;
+            FrameTimeline timeline(fence, 1);
+            ParallelCommandRecorder recorder(backend, jobs, timeline, config);
+            if (!recorder.initialize()) return {};
+
+            std::chrono::nanoseconds total{};
+            for (uint32_t iteration = 0; iteration < result.iterations; ++iteration) {
+                const uint64_t frame = timeline.beginFrame();
+                const auto start = Clock::now();
+
+                recorder.beginFrame();
+                ICommandPool* pool = recorder.getThreadPool();
+                if (!pool) return {};
+                ICommandBuffer* primary = pool->allocate(CommandBufferLevel::Primary);
+                primary->begin();
+                recorder.recordSectionDraws(*primary, draws, state, inheritance);
+                primary->end();
+
+                total += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+                fence.signal(frame);
+            }
+            return total / result.iterations;
+        };
+
+        result.avg_single_thread = run({ .batch_size = draw_count, .min_parallel_items = UINT32_MAX });
+        result.avg_parallel = run({});
+        if (result.avg_parallel.count() > 0) {
+            result.speedup = static_cast<double>(result.avg_single_thread.count()) / static_cast<double>(result.avg_parallel.count());
+        }
+        return result;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Command/CommandBuffer.h"
+#include "Draw/IndirectDraw.h"
+#include "Frame/FrameResourceRing.h"
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // CONFIGURATION / STATISTICS
+    // ==========================================
+
+    struct ParallelRecordConfig {
+        uint32_t batch_size = 256;          // Items per secondary buffer
+        uint32_t min_parallel_items = 512;  // Below this, record straight into the primary
+    };
+
+    struct ParallelRecordStats {
+        uint32_t items = 0;
+        uint32_t secondaries = 0;
+        uint32_t threads_used = 0;
+        bool recorded_inline = false;
+    };
+
+    // State every secondary re-binds before drawing sections
+    struct SectionDrawState {
+        GpuPipelineHandle pipeline;
+        GpuBufferHandle vertex_buffer;
+        GpuBufferHandle index_buffer;
+        IndexType index_type = IndexType::Uint32;
+    };
+
+    struct ParallelRecordBenchmarkResult {
+        uint32_t draws = 0;
+        uint32_t iterations = 0;
+        uint32_t threads = 0;
+        std::chrono::nanoseconds avg_single_thread{};
+        std::chrono::nanoseconds avg_parallel{};
+        double speedup = 0.0;
+    };
+
+    // ==========================================
+    // PARALLEL COMMAND RECORDER
+    // ==========================================
+
+    /**
+     * @brief Splits draw recording into secondary command buffers across job workers
+     *
+     * Every JobSystem thread slot owns one command pool per frame in flight;
+     * pools are reset when FrameTimeline hands their frame slot out again.
+     * Work is cut into fixed batches and the primary executes the secondaries
+     * in batch order, so the command stream never depends on scheduling.
+     *
+     * Whether a list goes to secondaries depends only on its item count, so
+     * the caller can ask willUseSecondaries() before beginning rendering on
+     * the primary and pick the matching contents (inline vs secondary).
+     */
+    class ParallelCommandRecorder {
+    public:
+        using RecordFn = std::function<void(ICommandBuffer& cmd, uint32_t begin, uint32_t end)>;
+
+        ParallelCommandRecorder(ICommandBackend& backend, JobSystem& jobs, const FrameTimeline& timeline,
+            const ParallelRecordConfig& config = {});
+
+        ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+        ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+        [[nodiscard]] std::expected<void, RendererError> initialize();
+
+        // Call after FrameTimeline::beginFrame(); recycles this slot's pools
+        void beginFrame();
+
+        // Pool owned by the calling thread for the current frame; null (and an
+        // error) on threads without a JobSystem slot, which would share slot 0's
+        [[nodiscard]] ICommandPool* getThreadPool();
+
+        // Decided before rendering begins; record() makes the same choice
+        [[nodiscard]] bool willUseSecondaries(uint32_t item_count) const noexcept {
+            return item_count >= config_.min_parallel_items;
+        }
+
+        // fn is called once per batch, possibly concurrently, with a begun secondary
+        // (or once, inline on the primary, when willUseSecondaries() is false)
+        void record(ICommandBuffer& primary, uint32_t item_count, const CommandInheritance& inheritance, const RecordFn& fn);
+
+        // One drawIndexed per command of an IndirectDrawList (for GPUs without multi-draw indirect)
+        void recordSectionDraws(ICommandBuffer& primary, const IndirectDrawList& draws, const SectionDrawState& state,
+            const CommandInheritance& inheritance);
+
+        [[nodiscard]] const ParallelRecordStats& getStats() const noexcept { return stats_; }
+
+        [[nodiscard]] static ParallelRecordBenchmarkResult benchmarkRecord(ICommandBackend& backend, JobSystem& jobs,
+            uint32_t draw_count = 100'000, uint32_t iterations = 20);
+
+    private:
+        using PoolSet = std::vector<std::unique_ptr<ICommandPool>>;  // Indexed by JobSystem thread slot
+
+    private:
+        ICommandBackend& backend_;
+        JobSystem& jobs_;
+        const FrameTimeline& timeline_;
+        ParallelRecordConfig config_;
+
+        std::optional<FrameResourceRing<PoolSet>> pools_;
+        PoolSet* frame_pools_ = nullptr;
+
+        std::vector<ICommandBuffer*> secondaries_;  // Indexed by batch
+        std::vector<uint8_t> thread_used_;
+        ParallelRecordStats stats_;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,129 @@
+#include "ashbornpch.h"
+
+#include "RecordingCommandBackend.h"
+
+namespace AshCore {
+
+    // ==========================================
+    // RECORDING COMMAND BUFFER
+    // ==========================================
+
+    void RecordingCommandBuffer::begin(const CommandInheritance* inheritance) {
+        if (recording_ || (level_ == CommandBufferLevel::Secondary && !inheritance)) ++errors_;
+
+        reset();
+        recording_ = true;
+        if (inheritance) inheritance_ = *inheritance;
+    }
+
+    void RecordingCommandBuffer::end() {
+        if (!recording_) ++errors_;
+        recording_ = false;
+    }
+
+    void RecordingCommandBuffer::bindPipeline(GpuPipelineHandle pipeline) {
+        push({ .type = RecordedCommandType::BindPipeline, .handle = pipeline.value });
+    }
+
+    void RecordingCommandBuffer::bindVertexBuffer(GpuBufferHandle buffer, uint64_t offset) {
+        push({ .type = RecordedCommandType::BindVertexBuffer, .handle = buffer.value, .offset = offset });
+    }
+
+    void RecordingCommandBuffer::bindIndexBuffer(GpuBufferHandle buffer, uint64_t offset, IndexType type) {
+        push({ .type = RecordedCommandType::BindIndexBuffer, .handle = buffer.value, .offset = offset,
+            .args = { static_cast<uint32_t>(type) } });
+    }
+
+    void RecordingCommandBuffer::pushConstants(uint32_t offset, std::span<const std::byte> data) {
+        // args: [payload offset in constants_, size]
+        push({ .type = RecordedCommandType::PushConstants, .offset = offset,
+            .args = { static_cast<uint32_t>(constants_.size()), static_cast<uint32_t>(data.size()) } });
+        constants_.insert(constants_.end(), data.begin(), data.end());
+    }
+
+    void RecordingCommandBuffer::drawIndexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index,
+        int32_t vertex_offset, uint32_t first_instance) {
+        push({ .type = RecordedCommandType::DrawIndexed,
+            .args = { index_count, instance_count, first_index, first_instance },
+            .vertex_offset = vertex_offset });
+    }
+
+    void RecordingCommandBuffer::drawIndexedIndirect(GpuBufferHandle buffer, uint64_t offset, uint32_t draw_count, uint32_t stride) {
+        push({ .type = RecordedCommandType::DrawIndexedIndirect, .handle = buffer.value, .offset = offset,
+            .args = { draw_count, stride } });
+    }
+
+    void RecordingCommandBuffer::executeCommands(std::span<ICommandBuffer* const> secondaries) {
+        if (level_ != CommandBufferLevel::Primary) ++errors_;
+
+        // args: [first index in executed_, count]
+        push({ .type = RecordedCommandType::ExecuteCommands,
+            .args = { static_cast<uint32_t>(executed_.size()), static_cast<uint32_t>(secondaries.size()) } });
+
+        for (ICommandBuffer* secondary : secondaries) {
+            auto* recorded = dynamic_cast<const RecordingCommandBuffer*>(secondary);
+            if (!recorded || recorded->level_ != CommandBufferLevel::Secondary || recorded->recording_) ++errors_;
+            executed_.push_back(recorded);
+        }
+    }
+
+    void RecordingCommandBuffer::reset() {
+        recording_ = false;
+        inheritance_ = {};
+        commands_.clear();
+        constants_.clear();
+        executed_.clear();
+    }
+
+    void RecordingCommandBuffer::flatten(std::vector<RecordedCommand>& out) const {
+        for (const RecordedCommand& command : commands_) {
+            if (command.type != RecordedCommandType::ExecuteCommands) {
+                out.push_back(command);
+                continue;
+            }
+            for (uint32_t i = 0; i < command.args[1]; ++i) {
+                if (const RecordingCommandBuffer* secondary = executed_[command.args[0] + i]) {
+                    secondary->flatten(out);
+                }
+            }
+        }
+    }
+
+    void RecordingCommandBuffer::push(const RecordedCommand& command) {
+        if (!recording_) ++errors_;
+        commands_.push_back(command);
+    }
+
+    // ==========================================
+    // RECORDING COMMAND POOL / BACKEND
+    // ==========================================
+
+    ICommandBuffer* RecordingCommandPool::allocate(CommandBufferLevel level) {
+        // Buffers are recycled in allocation order; replace one whose level doesn't match
+        if (used_ < buffers_.size()) {
+            auto& buffer = buffers_[used_];
+            if (buffer->getLevel() != level) {
+                buffer = std::make_unique<RecordingCommandBuffer>(level);
+            }
+            return buffers_[used_++].get();
+        }
+
+        buffers_.push_back(std::make_unique<RecordingCommandBuffer>(level));
+        ++used_;
+        return buffers_.back().get();
+    }
+
+    void RecordingCommandPool::reset() {
+        for (uint32_t i = 0; i < used_; ++i) {
+            buffers_[i]->reset();
+        }
+        used_ = 0;
+        ++resets_;
+    }
+
+    std::expected<std::unique_ptr<ICommandPool>, RendererError> RecordingCommandBackend::createCommandPool(uint32_t thread_index) {
+        ++pools_created_;
+        return std::make_unique<RecordingCommandPool>(thread_index);
+    }
+
+} // namespace AshCore
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Command/CommandBuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // RECORDING COMMAND BACKEND
+    // ==========================================
+
+    enum class RecordedCommandType : uint8_t {
+        BindPipeline,
+        BindVertexBuffer,
+        BindIndexBuffer,
+        PushConstants,
+        DrawIndexed,
+        DrawIndexedIndirect,
+        ExecuteCommands
+    };
+
+    struct RecordedCommand {
+        RecordedCommandType type;
+        uint64_t handle = 0;       // Pipeline/buffer value
+        uint64_t offset = 0;       // Buffer offset, or push constant byte offset
+        uint32_t args[5] = {};     // Draw parameters / index type / secondary range
+        int32_t vertex_offset = 0;
+    };
+
+    // Stores commands in memory instead of talking to a GPU (headless runs, tests, benchmarks)
+    class RecordingCommandBuffer final : public ICommandBuffer {
+    public:
+        explicit RecordingCommandBuffer(CommandBufferLevel level) : level_(level) {}
+
+        void begin(const CommandInheritance* inheritance = nullptr) override;
+        void end() override;
+
+        void bindPipeline(GpuPipelineHandle pipeline) override;
+        void bindVertexBuffer(GpuBufferHandle buffer, uint64_t offset) override;
+        void bindIndexBuffer(GpuBufferHandle buffer, uint64_t offset, IndexType type) override;
+        void pushConstants(uint32_t offset, std::span<const std::byte> data) override;
+
+        void drawIndexed(uint32_t index_count, uint32_t instance_count, uint32_t first_index,
+            int32_t vertex_offset, uint32_t first_instance) override;
+        void drawIndexedIndirect(GpuBufferHandle buffer, uint64_t offset, uint32_t draw_count, uint32_t stride) override;
+
+        void executeCommands(std::span<ICommandBuffer* const> secondaries) override;
+
+        [[nodiscard]] CommandBufferLevel getLevel() const noexcept override { return level_; }
+
+        void reset();
+
+        // Commands with executed secondaries expanded in place
+        void flatten(std::vector<RecordedCommand>& out) const;
+
+        [[nodiscard]] const std::vector<RecordedCommand>& getCommands() const noexcept { return commands_; }
+        [[nodiscard]] const CommandInheritance& getInheritance() const noexcept { return inheritance_; }
+        [[nodiscard]] bool isRecording() const noexcept { return recording_; }
+
+        // Misuse (recording outside begin/end, executing unfinished secondaries, ...)
+        [[nodiscard]] uint32_t getErrorCount() const noexcept { return errors_; }
+
+    private:
+        void push(const RecordedCommand& command);
+
+        CommandBufferLevel level_;
+        bool recording_ = false;
+        uint32_t errors_ = 0;
+        CommandInheritance inheritance_;
+        std::vector<RecordedCommand> commands_;
+        std::vector<std::byte> constants_;                    // PushConstants payloads
+        std::vector<const RecordingCommandBuffer*> executed_; // ExecuteCommands targets
+    };
+
+    class RecordingCommandPool final : public ICommandPool {
+    public:
+        explicit RecordingCommandPool(uint32_t thread_index) : thread_index_(thread_index) {}
+
+        [[nodiscard]] ICommandBuffer* allocate(CommandBufferLevel level) override;
+        void reset() override;
+
+        [[nodiscard]] uint32_t getThreadIndex() const noexcept { return thread_index_; }
+        [[nodiscard]] uint32_t getAllocatedCount() const noexcept { return used_; }
+        [[nodiscard]] uint32_t getResetCount() const noexcept { return resets_; }
+
+    private:
+        uint32_t thread_index_;
+        std::vector<std::unique_ptr<RecordingCommandBuffer>> buffers_;  // Reused after reset
+        uint32_t used_ = 0;
+        uint32_t resets_ = 0;
+    };
+
+    class RecordingCommandBackend final : public ICommandBackend {
+    public:
+        [[nodiscard]] std::expected<std::unique_ptr<ICommandPool>, RendererError> createCommandPool(uint32_t thread_index) override;
+
+        [[nodiscard]] uint32_t getPoolCount() const noexcept { return pools_created_; }
+
+    private:
+        uint32_t pools_created_ = 0;
+    };
+
+} // namespace AshCore
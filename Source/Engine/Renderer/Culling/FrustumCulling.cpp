@@ -0,0 +1,178 @@
+#include "ashbornpch.h"
+
+#include "FrustumCulling.h"
+
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t LANES = 8;
+
+        uint32_t cullSpheresScalar(const Frustum& frustum, const float* x, const float* y, const float* z, const float* radius) {
+            uint32_t mask = 0;
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                bool inside = true;
+                for (const auto& plane : frustum.planes) {
+                    const float distance = plane[0] * x[lane] + plane[1] * y[lane] + plane[2] * z[lane] + plane[3];
+                    inside = inside && distance >= -radius[lane];
+                }
+                if (inside) mask |= 1u << lane;
+            }
+            return mask;
+        }
+
+#if defined(__AVX2__)
+        uint32_t cullSpheresAvx2(const Frustum& frustum, const float* x, const float* y, const float* z, const float* radius) {
+            const __m256 px = _mm256_loadu_ps(x);
+            const __m256 py = _mm256_loadu_ps(y);
+            const __m256 pz = _mm256_loadu_ps(z);
+            const __m256 neg_radius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius));
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (const auto& plane : frustum.planes) {
+                const __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[0]), px), _mm256_mul_ps(_mm256_set1_ps(plane[1]), py)),
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[2]), pz), _mm256_set1_ps(plane[3])));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, neg_radius, _CMP_GE_OQ));
+            }
+            return static_cast<uint32_t>(_mm256_movemask_ps(inside));
+        }
+
+        uint32_t cullAabbsAvx2(const Frustum& frustum, const float* const* lo, const float* const* hi) {
+            __m256 lower[3], upper[3];
+            for (size_t axis = 0; axis < 3; ++axis) {
+                lower[axis] = _mm256_loadu_ps(lo[axis]);
+                upper[axis] = _mm256_loadu_ps(hi[axis]);
+            }
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (const auto& plane : frustum.planes) {
+                // The corner is picked per plane, so no per-lane select is needed
+                const __m256 px = plane[0] >= 0.0f ? upper[0] : lower[0];
+                const __m256 py = plane[1] >= 0.0f ? upper[1] : lower[1];
+                const __m256 pz = plane[2] >= 0.0f ? upper[2] : lower[2];
+                const __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[0]), px), _mm256_mul_ps(_mm256_set1_ps(plane[1]), py)),
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[2]), pz), _mm256_set1_ps(plane[3])));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+            return static_cast<uint32_t>(_mm256_movemask_ps(inside));
+        }
+#endif
+
+        uint32_t cullAabbsScalar(const Frustum& frustum, const float* const* lo, const float* const* hi) {
+            uint32_t mask = 0;
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                bool inside = true;
+                for (const auto& plane : frustum.planes) {
+                    float distance = plane[3];
+                    for (size_t axis = 0; axis < 3; ++axis) {
+                        distance += plane[axis] * (plane[axis] >= 0.0f ? hi[axis][lane] : lo[axis][lane]);
+                    }
+                    inside = inside && distance >= 0.0f;
+                }
+                if (inside) mask |= 1u << lane;
+            }
+            return mask;
+        }
+    }
+
+    // ==========================================
+    // FRUSTUM
+    // ==========================================
+
+    Frustum Frustum::fromViewProjection(const std::array<float, 16>& m) noexcept {
+        // Row i of the column-major matrix
+        auto row = [&](size_t i) { return std::array<float, 4>{ m[i], m[4 + i], m[8 + i], m[12 + i] }; };
+        const auto r0 = row(0);
+        const auto r1 = row(1);
+        const auto r2 = row(2);
+        const auto r3 = row(3);
+
+        Frustum frustum;
+        for (size_t c = 0; c < 4; ++c) {
+            frustum.planes[Left][c] = r3[c] + r0[c];
+            frustum.planes[Right][c] = r3[c] - r0[c];
+            frustum.planes[Bottom][c] = r3[c] + r1[c];
+            frustum.planes[Top][c] = r3[c] - r1[c];
+            frustum.planes[Near][c] = r2[c];
+            frustum.planes[Far][c] = r3[c] - r2[c];
+        }
+
+        // Normalized so plane distances are in world units (sphere radii compare directly)
+        for (auto& plane : frustum.planes) {
+            const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (length > 0.0f) {
+                for (float& component : plane) component /= length;
+            }
+        }
+        return frustum;
+    }
+
+    // ==========================================
+    // SPHERE CULLING
+    // ==========================================
+
+    uint32_t cullSpheres8(const Frustum& frustum, const float* x, const float* y, const float* z, const float* radius,
+        [[maybe_unused]] bool simd) noexcept {
+#if defined(__AVX2__)
+        if (simd) return cullSpheresAvx2(frustum, x, y, z, radius);
+#endif
+        return cullSpheresScalar(frustum, x, y, z, radius);
+    }
+
+    void cullSpheres(const Frustum& frustum, const float* x, const float* y, const float* z, const float* radius,
+        size_t count, std::vector<uint32_t>& visible, bool simd) {
+        for (size_t base = 0; base < count; base += LANES) {
+            uint32_t mask = cullSpheres8(frustum, x + base, y + base, z + base, radius + base, simd);
+            if (count - base < LANES) mask &= (1u << (count - base)) - 1;
+
+            while (mask != 0) {
+                visible.push_back(static_cast<uint32_t>(base + static_cast<size_t>(std::countr_zero(mask))));
+                mask &= mask - 1;
+            }
+        }
+    }
+
+    // ==========================================
+    // BOX CULLING
+    // ==========================================
+
+    uint32_t cullAabbs8(const Frustum& frustum, const float* min_x, const float* min_y, const float* min_z,
+        const float* max_x, const float* max_y, const float* max_z, [[maybe_unused]] bool simd) noexcept {
+        const float* lo[3] = { min_x, min_y, min_z };
+        const float* hi[3] = { max_x, max_y, max_z };
+#if defined(__AVX2__)
+        if (simd) return cullAabbsAvx2(frustum, lo, hi);
+#endif
+        return cullAabbsScalar(frustum, lo, hi);
+    }
+
+    void cullAabbs(const Frustum& frustum, const float* min_x, const float* min_y, const float* min_z,
+        const float* max_x, const float* max_y, const float* max_z, size_t count, std::vector<uint32_t>& visible, bool simd) {
+        for (size_t base = 0; base < count; base += LANES) {
+            uint32_t mask = cullAabbs8(frustum, min_x + base, min_y + base, min_z + base, max_x + base, max_y + base, max_z + base, simd);
+            if (count - base < LANES) mask &= (1u << (count - base)) - 1;
+
+            while (mask != 0) {
+                visible.push_back(static_cast<uint32_t>(base + static_cast<size_t>(std::countr_zero(mask))));
+                mask &= mask - 1;
+            }
+        }
+    }
+
+    bool isFrustumCullingSimd() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+} // namespace AshCore
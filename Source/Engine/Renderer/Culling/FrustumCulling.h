@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // FRUSTUM
+    // ==========================================
+
+    // Planes face inwards: a point p is inside when dot(plane.xyz, p) + plane.w >= 0
+    struct Frustum {
+        enum Plane : uint32_t { Left, Right, Bottom, Top, Near, Far, Count };
+
+        std::array<std::array<float, 4>, Plane::Count> planes{};
+
+        // Column-major view-projection with Vulkan's [0, 1] clip depth
+        [[nodiscard]] static Frustum fromViewProjection(const std::array<float, 16>& view_projection) noexcept;
+    };
+
+    // ==========================================
+    // SPHERE CULLING
+    // ==========================================
+
+    // Bit per lane whose sphere touches the frustum; reads exactly eight lanes of each array
+    [[nodiscard]] uint32_t cullSpheres8(const Frustum& frustum, const float* x, const float* y, const float* z, const float* radius,
+        bool simd = true) noexcept;
+
+    // Appends the indices in [0, count) of visible spheres; arrays must be padded to a multiple of 8
+    void cullSpheres(const Frustum& frustum, const float* x, const float* y, const float* z, const float* radius,
+        size_t count, std::vector<uint32_t>& visible, bool simd = true);
+
+    // ==========================================
+    // BOX CULLING
+    // ==========================================
+
+    // Axis-aligned boxes tested by their corner furthest along each plane normal.
+    // Same contract as the sphere variants: eight lanes per call, padded arrays.
+    [[nodiscard]] uint32_t cullAabbs8(const Frustum& frustum, const float* min_x, const float* min_y, const float* min_z,
+        const float* max_x, const float* max_y, const float* max_z, bool simd = true) noexcept;
+
+    void cullAabbs(const Frustum& frustum, const float* min_x, const float* min_y, const float* min_z,
+        const float* max_x, const float* max_y, const float* max_z, size_t count, std::vector<uint32_t>& visible, bool simd = true);
+
+    [[nodiscard]] bool isFrustumCullingSimd() noexcept;  // AVX2 path compiled in
+
+} // namespace AshCore
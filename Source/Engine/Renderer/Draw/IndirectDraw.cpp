@@ -0,0 +1,210 @@
+#include "ashbornpch.h"
+
+#include "IndirectDraw.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace AshCore {
+
+    namespace {
+        // Calls emit(first_face, face_count) for each run of consecutive visible, non-empty faces
+        template<typename Fn>
+        void forEachFaceRun(const SectionMeshRange& range, uint8_t face_mask, Fn&& emit) {
+            size_t face = 0;
+            while (face < FACE_DIRECTION_COUNT) {
+                const bool drawable = (face_mask & (1u << face)) && range.face_index_counts[face] > 0;
+                if (!drawable) {
+                    ++face;
+                    continue;
+                }
+
+                // Empty groups cost nothing, so a run may continue through them even if culled
+                size_t end = face + 1;
+                size_t last_drawable = face;
+                while (end < FACE_DIRECTION_COUNT &&
+                    ((face_mask & (1u << end)) || range.face_index_counts[end] == 0)) {
+                    if (range.face_index_counts[end] > 0) {
+                        last_drawable = end;
+                    }
+                    ++end;
+                }
+
+                emit(face, last_drawable + 1 - face);
+                face = end;
+            }
+        }
+    }
+
+    // ==========================================
+    // SECTION MESH TABLE
+    // ==========================================
+
+    uint32_t SectionMeshRange::getIndexCount() const noexcept {
+        return std::accumulate(face_index_counts.begin(), face_index_counts.end(), 0u);
+    }
+
+    void SectionMeshTable::resize(uint32_t slot_count) {
+        ranges_.resize(slot_count);
+        origins_.resize(slot_count);
+    }
+
+    void SectionMeshTable::setSection(uint32_t slot, const SectionMeshRange& range, const std::array<float, 3>& origin) {
+        if (slot >= ranges_.size()) {
+            resize(slot + 1);
+        }
+        ranges_[slot] = range;
+        origins_[slot] = origin;
+    }
+
+    void SectionMeshTable::clearSection(uint32_t slot) {
+        if (slot < ranges_.size()) {
+            ranges_[slot] = {};
+        }
+    }
+
+    void IndirectDrawList::clear() noexcept {
+        commands.clear();
+        draw_data.clear();
+        stats = {};
+    }
+
+    // ==========================================
+    // DRAW GENERATION
+    // ==========================================
+
+    IndirectDrawBuilder::IndirectDrawBuilder(const IndirectDrawConfig& config)
+        : config_(config) {
+        config_.batch_size = std::max<size_t>(config_.batch_size, 1);
+    }
+
+    void IndirectDrawBuilder::build(std::span<const VisibleSection> visible,
+        const SectionMeshTable& table,
+        JobSystem* jobs,
+        IndirectDrawList& out) {
+
+        out.clear();
+        out.stats.sections_visible = static_cast<uint32_t>(visible.size());
+        if (visible.empty()) return;
+
+        const size_t batch_size = config_.batch_size;
+        const size_t batch_count = (visible.size() + batch_size - 1) / batch_size;
+        batch_counts_.assign(batch_count, {});
+
+        auto run_batches = [&](auto&& fn) {
+            if (jobs) {
+                jobs->parallelFor(visible.size(), batch_size, [&](size_t begin, size_t end) {
+                    fn(begin / batch_size, begin, end);
+                    });
+            }
+            else {
+                for (size_t batch = 0; batch < batch_count; ++batch) {
+                    const size_t begin = batch * batch_size;
+                    fn(batch, begin, std::min(begin + batch_size, visible.size()));
+                }
+            }
+        };
+
+        // Pass 1: count what every batch will emit
+        run_batches([&](size_t batch, size_t begin, size_t end) {
+            countBatch(visible, table, begin, end, batch_counts_[batch]);
+            });
+
+        // Exclusive prefix sum turns counts into write offsets
+        BatchCounts total;
+        for (auto& counts : batch_counts_) {
+            const BatchCounts batch = counts;
+            counts.sections = total.sections;
+            counts.commands = total.commands;
+            total.sections += batch.sections;
+            total.commands += batch.commands;
+            total.indices += batch.indices;
+        }
+
+        out.commands.resize(total.commands);
+        out.draw_data.resize(total.sections);
+
+        // Pass 2: every batch writes into its own disjoint range
+        run_batches([&](size_t batch, size_t begin, size_t end) {
+            writeBatch(visible, table, begin, end, batch_counts_[batch], out);
+            });
+
+        out.stats.sections_drawn = total.sections;
+        out.stats.commands = total.commands;
+        out.stats.indices = total.indices;
+        out.stats.faces = static_cast<uint32_t>(total.indices / 6);
+    }
+
+    void IndirectDrawBuilder::countBatch(std::span<const VisibleSection> visible, const SectionMeshTable& table,
+        size_t begin, size_t end, BatchCounts& counts) const {
+
+        counts = {};
+        for (size_t i = begin; i < end; ++i) {
+            const VisibleSection& section = visible[i];
+            if (section.section_slot >= table.getSlotCount()) continue;
+
+            const SectionMeshRange& range = table.getRange(section.section_slot);
+            const uint8_t mask = config_.cull_face_groups ? section.face_mask : ALL_FACES_MASK;
+
+            uint32_t commands = 0;
+            forEachFaceRun(range, mask, [&](size_t first_face, size_t face_count) {
+                ++commands;
+                for (size_t f = first_face; f < first_face + face_count; ++f) {
+                    counts.indices += range.face_index_counts[f];
+                }
+                });
+
+            if (commands > 0) {
+                counts.sections++;
+                counts.commands += commands;
+            }
+        }
+    }
+
+    void IndirectDrawBuilder::writeBatch(std::span<const VisibleSection> visible, const SectionMeshTable& table,
+        size_t begin, size_t end, const BatchCounts& offsets, IndirectDrawList& out) const {
+
+        uint32_t section_index = offsets.sections;
+        uint32_t command_index = offsets.commands;
+
+        for (size_t i = begin; i < end; ++i) {
+            const VisibleSection& section = visible[i];
+            if (section.section_slot >= table.getSlotCount()) continue;
+
+            const SectionMeshRange& range = table.getRange(section.section_slot);
+            const uint8_t mask = config_.cull_face_groups ? section.face_mask : ALL_FACES_MASK;
+
+            bool emitted = false;
+            forEachFaceRun(range, mask, [&](size_t first_face, size_t face_count) {
+                uint32_t first_index = range.first_index;
+                for (size_t f = 0; f < first_face; ++f) {
+                    first_index += range.face_index_counts[f];
+                }
+
+                uint32_t index_count = 0;
+                for (size_t f = first_face; f < first_face + face_count; ++f) {
+                    index_count += range.face_index_counts[f];
+                }
+
+                out.commands[command_index++] = DrawIndexedIndirectCommand{
+                    .index_count = index_count,
+                    .instance_count = 1,
+                    .first_index = first_index,
+                    .vertex_offset = range.vertex_offset,
+                    .first_instance = section_index
+                };
+                emitted = true;
+                });
+
+            if (emitted) {
+                const auto& origin = table.getOrigin(section.section_slot);
+                out.draw_data[section_index++] = SectionDrawData{
+                    .origin = { origin[0], origin[1], origin[2] },
+                    .section_slot = section.section_slot
+                };
+            }
+        }
+    }
+
+} // namespace AshCore
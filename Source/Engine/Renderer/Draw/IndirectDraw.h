@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // GPU-FACING LAYOUTS
+    // ==========================================
+
+    // Binary-compatible with VkDrawIndexedIndirectCommand
+    struct DrawIndexedIndirectCommand {
+        uint32_t index_count;
+        uint32_t instance_count;
+        uint32_t first_index;
+        int32_t vertex_offset;
+        uint32_t first_instance;
+    };
+    static_assert(sizeof(DrawIndexedIndirectCommand) == 20, "Must match VkDrawIndexedIndirectCommand");
+
+    // Per-section data read by the vertex shader through first_instance
+    struct alignas(16) SectionDrawData {
+        float origin[3];        // World-space section origin
+        uint32_t section_slot;  // Slot in the SectionMeshTable
+    };
+    static_assert(sizeof(SectionDrawData) == 16, "std430 layout expects 16 bytes");
+
+    // ==========================================
+    // SECTION MESH TABLE
+    // ==========================================
+
+    // Face groups in the order they are stored in a section's index range.
+    // Opposite faces are not adjacent so that a typical camera (which sees
+    // at most three of them) still tends to produce contiguous runs.
+    enum class FaceDirection : uint8_t {
+        PosX = 0,
+        PosY,
+        PosZ,
+        NegX,
+        NegY,
+        NegZ,
+        Count
+    };
+
+    inline constexpr size_t FACE_DIRECTION_COUNT = static_cast<size_t>(FaceDirection::Count);
+    inline constexpr uint8_t ALL_FACES_MASK = (1u << FACE_DIRECTION_COUNT) - 1;
+
+    // Where a section mesh lives inside the shared vertex/index arena.
+    // Face groups are stored back to back starting at first_index.
+    struct SectionMeshRange {
+        int32_t vertex_offset = 0;
+        uint32_t first_index = 0;
+        std::array<uint32_t, FACE_DIRECTION_COUNT> face_index_counts{};
+
+        [[nodiscard]] uint32_t getIndexCount() const noexcept;
+        [[nodiscard]] bool isEmpty() const noexcept { return getIndexCount() == 0; }
+    };
+
+    // Dense slot -> mesh range table, written by the mesher, read by draw generation
+    class SectionMeshTable {
+    public:
+        void resize(uint32_t slot_count);
+        void setSection(uint32_t slot, const SectionMeshRange& range, const std::array<float, 3>& origin);
+        void clearSection(uint32_t slot);
+
+        [[nodiscard]] uint32_t getSlotCount() const noexcept { return static_cast<uint32_t>(ranges_.size()); }
+        [[nodiscard]] const SectionMeshRange& getRange(uint32_t slot) const noexcept { return ranges_[slot]; }
+        [[nodiscard]] const std::array<float, 3>& getOrigin(uint32_t slot) const noexcept { return origins_[slot]; }
+
+    private:
+        std::vector<SectionMeshRange> ranges_;
+        std::vector<std::array<float, 3>> origins_;
+    };
+
+    // ==========================================
+    // CULLING OUTPUT / DRAW LIST
+    // ==========================================
+
+    // One entry per section that survived culling
+    struct VisibleSection {
+        uint32_t section_slot;
+        uint8_t face_mask = ALL_FACES_MASK;  // Bit per FaceDirection that can face the camera
+    };
+
+    struct IndirectDrawStats {
+        uint32_t sections_visible = 0;
+        uint32_t sections_drawn = 0;   // Visible and non-empty
+        uint32_t commands = 0;
+        uint64_t indices = 0;
+        uint32_t faces = 0;            // Quads (6 indices each)
+    };
+
+    // Ready to upload: commands go to the indirect buffer, draw_data to an SSBO
+    struct IndirectDrawList {
+        std::vector<DrawIndexedIndirectCommand> commands;
+        std::vector<SectionDrawData> draw_data;
+        IndirectDrawStats stats;
+
+        void clear() noexcept;
+        [[nodiscard]] size_t getCommandBytes() const noexcept { return commands.size() * sizeof(DrawIndexedIndirectCommand); }
+        [[nodiscard]] size_t getDrawDataBytes() const noexcept { return draw_data.size() * sizeof(SectionDrawData); }
+    };
+
+    // ==========================================
+    // DRAW GENERATION
+    // ==========================================
+
+    struct IndirectDrawConfig {
+        size_t batch_size = 512;        // Visible sections per job
+        bool cull_face_groups = true;   // Honor VisibleSection::face_mask
+    };
+
+    /**
+     * @brief Turns culling output into a multi-draw-indirect command array
+     *
+     * Runs a count pass and a write pass over fixed batches so the output
+     * order always matches the culling order, regardless of thread count.
+     * Adjacent visible face groups are merged into a single command.
+     */
+    class IndirectDrawBuilder {
+    public:
+        explicit IndirectDrawBuilder(const IndirectDrawConfig& config = {});
+
+        // jobs may be null for single-threaded generation
+        void build(std::span<const VisibleSection> visible,
+            const SectionMeshTable& table,
+            JobSystem* jobs,
+            IndirectDrawList& out);
+
+        [[nodiscard]] const IndirectDrawConfig& getConfig() const noexcept { return config_; }
+
+    private:
+        struct BatchCounts {
+            uint32_t sections = 0;
+            uint32_t commands = 0;
+            uint64_t indices = 0;
+        };
+
+        void countBatch(std::span<const VisibleSection> visible, const SectionMeshTable& table,
+            size_t begin, size_t end, BatchCounts& counts) const;
+        void writeBatch(std::span<const VisibleSection> visible, const SectionMeshTable& table,
+            size_t begin, size_t end, const BatchCounts& offsets, IndirectDrawList& out) const;
+
+    private:
+        IndirectDrawConfig config_;
+        std::vector<BatchCounts> batch_counts_;  // Reused between frames
+    };
+
+} // namespace AshCore
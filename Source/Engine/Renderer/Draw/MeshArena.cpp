@@ -0,0 +1,236 @@
+#include "ashbornpch.h"
+
+#include "MeshArena.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace AshCore {
+
+    // ==========================================
+    // CONSTRUCTION
+    // ==========================================
+
+    MeshArena::MeshArena(const MeshArenaConfig& config)
+        : config_(config)
+        , vertex_allocator_(config.vertex_capacity)
+        , index_allocator_(config.index_capacity) {
+
+        print_d("Mesh arena created", LogContext{
+            {"vertex_mb", getVertexBufferBytes() / (1024 * 1024)},
+            {"index_mb", getIndexBufferBytes() / (1024 * 1024)}
+            });
+    }
+
+    // ==========================================
+    // SECTION ALLOCATION
+    // ==========================================
+
+    std::expected<SectionMeshRange, RendererError> MeshArena::allocateSection(
+        uint32_t slot,
+        uint32_t vertex_count,
+        const std::array<uint32_t, FACE_DIRECTION_COUNT>& face_index_counts,
+        uint64_t frame) {
+
+        releaseSection(slot, frame);
+
+        const uint32_t index_count = std::accumulate(face_index_counts.begin(), face_index_counts.end(), 0u);
+        if (vertex_count == 0 || index_count == 0) {
+            return SectionMeshRange{};  // Nothing to draw, nothing to store
+        }
+
+        auto vertices = vertex_allocator_.allocate(vertex_count);
+        if (!vertices) {
+            failed_allocations_++;
+            print_w("Mesh arena out of vertex space", LogContext{
+                {"slot", slot},
+                {"vertices", vertex_count},
+                {"fragmentation", vertex_allocator_.getStats().getFragmentation()}
+                });
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+
+        auto indices = index_allocator_.allocate(index_count);
+        if (!indices) {
+            vertex_allocator_.free(*vertices);
+            failed_allocations_++;
+            print_w("Mesh arena out of index space", LogContext{
+                {"slot", slot},
+                {"indices", index_count},
+                {"fragmentation", index_allocator_.getStats().getFragmentation()}
+                });
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+
+        if (slot >= sections_.size()) {
+            sections_.resize(slot + 1);
+        }
+
+        SectionAllocation& section = sections_[slot];
+        section.vertices = *vertices;
+        section.indices = *indices;
+        section.range.vertex_offset = static_cast<int32_t>(vertices->offset);
+        section.range.first_index = static_cast<uint32_t>(indices->offset);
+        section.range.face_index_counts = face_index_counts;
+        section.live = true;
+        live_sections_++;
+
+        return section.range;
+    }
+
+    void MeshArena::releaseSection(uint32_t slot, uint64_t frame) {
+        if (slot >= sections_.size() || !sections_[slot].live) return;
+
+        SectionAllocation& section = sections_[slot];
+        retire(MeshArenaBuffer::Vertex, section.vertices, frame);
+        retire(MeshArenaBuffer::Index, section.indices, frame);
+        section = {};
+        live_sections_--;
+    }
+
+    void MeshArena::collectGarbage(uint64_t completed_frame) {
+        while (!pending_frees_.empty() && pending_frees_.front().frame <= completed_frame) {
+            const PendingFree& pending = pending_frees_.front();
+            getAllocator(pending.buffer).free(pending.allocation);
+            pending_frees_.pop_front();
+        }
+    }
+
+    std::optional<SectionMeshRange> MeshArena::getSection(uint32_t slot) const noexcept {
+        if (slot >= sections_.size() || !sections_[slot].live) {
+            return std::nullopt;
+        }
+        return sections_[slot].range;
+    }
+
+    // ==========================================
+    // COMPACTION
+    // ==========================================
+
+    uint64_t MeshArena::compact(uint64_t frame, std::vector<MeshArenaCopy>& copies) {
+        bytes_moved_last_frame_ = 0;
+
+        uint64_t budget = config_.compaction_bytes_per_frame;
+        for (MeshArenaBuffer buffer : { MeshArenaBuffer::Vertex, MeshArenaBuffer::Index }) {
+            if (getAllocator(buffer).getStats().getFragmentation() < config_.compaction_threshold) {
+                continue;
+            }
+
+            const uint64_t moved = compactBuffer(buffer, frame, budget, copies);
+            budget -= moved;
+            bytes_moved_last_frame_ += moved;
+        }
+
+        bytes_moved_total_ += bytes_moved_last_frame_;
+        return bytes_moved_last_frame_;
+    }
+
+    uint64_t MeshArena::compactBuffer(MeshArenaBuffer buffer, uint64_t frame, uint64_t budget,
+        std::vector<MeshArenaCopy>& copies) {
+
+        TlsfAllocator& allocator = getAllocator(buffer);
+        const uint64_t unit = getUnitSize(buffer);
+        const bool is_vertex = buffer == MeshArenaBuffer::Vertex;
+
+        // Highest allocations first: moving them down shrinks the tail and merges holes
+        std::vector<uint32_t> candidates;
+        candidates.reserve(live_sections_);
+        for (uint32_t slot = 0; slot < sections_.size(); ++slot) {
+            if (sections_[slot].live) {
+                candidates.push_back(slot);
+            }
+        }
+
+        auto offset_of = [&](uint32_t slot) {
+            return is_vertex ? sections_[slot].vertices.offset : sections_[slot].indices.offset;
+        };
+        std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b) {
+            return offset_of(a) > offset_of(b);
+            });
+
+        uint64_t moved = 0;
+        uint32_t attempts = 0;
+        for (uint32_t slot : candidates) {
+            if (attempts >= config_.compaction_attempts_per_frame) break;
+
+            SectionAllocation& section = sections_[slot];
+            TlsfAllocation& current = is_vertex ? section.vertices : section.indices;
+            const uint64_t units = allocator.getAllocationSize(current);
+            const uint64_t bytes = units * unit;
+            if (bytes > budget - moved) continue;
+
+            attempts++;
+            auto target = allocator.allocate(units);
+            if (!target) continue;
+
+            if (target->offset >= current.offset) {
+                allocator.free(*target);  // No lower hole fits this one
+                continue;
+            }
+
+            copies.push_back(MeshArenaCopy{
+                .buffer = buffer,
+                .src_offset = current.offset * unit,
+                .dst_offset = target->offset * unit,
+                .size = bytes,
+                .section_slot = slot
+                });
+
+            // In-flight frames still read the old range
+            retire(buffer, current, frame);
+            current = *target;
+            if (is_vertex) {
+                section.range.vertex_offset = static_cast<int32_t>(target->offset);
+            }
+            else {
+                section.range.first_index = static_cast<uint32_t>(target->offset);
+            }
+
+            moved += bytes;
+        }
+
+        return moved;
+    }
+
+    // ==========================================
+    // STATISTICS
+    // ==========================================
+
+    MeshArenaStats MeshArena::getStats() const noexcept {
+        MeshArenaStats stats;
+        stats.vertices = vertex_allocator_.getStats();
+        stats.indices = index_allocator_.getStats();
+        stats.sections = live_sections_;
+        stats.pending_frees = static_cast<uint32_t>(pending_frees_.size());
+        stats.bytes_moved_last_frame = bytes_moved_last_frame_;
+        stats.bytes_moved_total = bytes_moved_total_;
+        stats.failed_allocations = failed_allocations_;
+        return stats;
+    }
+
+    uint64_t MeshArena::getVertexBufferBytes() const noexcept {
+        return uint64_t{ config_.vertex_capacity } * config_.vertex_stride;
+    }
+
+    uint64_t MeshArena::getIndexBufferBytes() const noexcept {
+        return uint64_t{ config_.index_capacity } * INDEX_SIZE;
+    }
+
+    // ==========================================
+    // INTERNAL
+    // ==========================================
+
+    TlsfAllocator& MeshArena::getAllocator(MeshArenaBuffer buffer) noexcept {
+        return buffer == MeshArenaBuffer::Vertex ? vertex_allocator_ : index_allocator_;
+    }
+
+    uint64_t MeshArena::getUnitSize(MeshArenaBuffer buffer) const noexcept {
+        return buffer == MeshArenaBuffer::Vertex ? config_.vertex_stride : INDEX_SIZE;
+    }
+
+    void MeshArena::retire(MeshArenaBuffer buffer, const TlsfAllocation& allocation, uint64_t frame) {
+        if (!allocation.isValid()) return;
+        pending_frees_.push_back({ frame, buffer, allocation });
+    }
+
+} // namespace AshCore
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Draw/IndirectDraw.h"
+#include "Memory/TlsfAllocator.h"
+#include "Engine/EngineErrors.h"
+
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <optional>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // CONFIGURATION / STATISTICS
+    // ==========================================
+
+    struct MeshArenaConfig {
+        uint32_t vertex_capacity = 8 * 1024 * 1024;    // Vertices (64 MB at 8 bytes)
+        uint32_t index_capacity = 12 * 1024 * 1024;    // 32-bit indices (48 MB)
+        uint32_t vertex_stride = 8;                    // Packed voxel vertex
+
+        // Background compaction
+        float compaction_threshold = 0.25f;            // Fragmentation that triggers compaction
+        uint64_t compaction_bytes_per_frame = 2 * 1024 * 1024;
+        uint32_t compaction_attempts_per_frame = 64;   // Bounds CPU cost on failed moves
+    };
+
+    enum class MeshArenaBuffer : uint8_t {
+        Vertex,
+        Index
+    };
+
+    // GPU copy the renderer must record before this frame's draws
+    struct MeshArenaCopy {
+        MeshArenaBuffer buffer;
+        uint64_t src_offset;  // Bytes
+        uint64_t dst_offset;  // Bytes
+        uint64_t size;        // Bytes
+        uint32_t section_slot;
+    };
+
+    struct MeshArenaStats {
+        TlsfStats vertices;
+        TlsfStats indices;
+        uint32_t sections = 0;
+        uint32_t pending_frees = 0;
+        uint64_t bytes_moved_last_frame = 0;
+        uint64_t bytes_moved_total = 0;
+        uint32_t failed_allocations = 0;
+    };
+
+    // ==========================================
+    // MESH ARENA
+    // ==========================================
+
+    /**
+     * @brief One shared vertex buffer + index buffer for all section meshes
+     *
+     * Offsets are handed out by TLSF allocators (vertex_offset in vertices,
+     * first_index in indices) so every section can be drawn from the same
+     * bindings. Freed ranges stay reserved until the frame that last used
+     * them completes on the GPU.
+     */
+    class MeshArena {
+    public:
+        explicit MeshArena(const MeshArenaConfig& config = {});
+
+        // Replaces any existing mesh for the slot; the old range is retired at `frame`
+        [[nodiscard]] std::expected<SectionMeshRange, RendererError> allocateSection(
+            uint32_t slot,
+            uint32_t vertex_count,
+            const std::array<uint32_t, FACE_DIRECTION_COUNT>& face_index_counts,
+            uint64_t frame);
+
+        void releaseSection(uint32_t slot, uint64_t frame);
+
+        // Frees ranges whose last use is <= completed_frame
+        void collectGarbage(uint64_t completed_frame);
+
+        // Moves tail allocations into lower holes, bounded by the per-frame byte budget.
+        // Section ranges are updated immediately; record `copies` before this frame's draws.
+        uint64_t compact(uint64_t frame, std::vector<MeshArenaCopy>& copies);
+
+        [[nodiscard]] std::optional<SectionMeshRange> getSection(uint32_t slot) const noexcept;
+        [[nodiscard]] MeshArenaStats getStats() const noexcept;
+        [[nodiscard]] const MeshArenaConfig& getConfig() const noexcept { return config_; }
+
+        // Sizes of the backing GPU buffers
+        [[nodiscard]] uint64_t getVertexBufferBytes() const noexcept;
+        [[nodiscard]] uint64_t getIndexBufferBytes() const noexcept;
+
+        static constexpr uint32_t INDEX_SIZE = sizeof(uint32_t);
+
+    private:
+        struct SectionAllocation {
+            TlsfAllocation vertices;
+            TlsfAllocation indices;
+            SectionMeshRange range;
+            bool live = false;
+        };
+
+        struct PendingFree {
+            uint64_t frame;
+            MeshArenaBuffer buffer;
+            TlsfAllocation allocation;
+        };
+
+        TlsfAllocator& getAllocator(MeshArenaBuffer buffer) noexcept;
+        uint64_t getUnitSize(MeshArenaBuffer buffer) const noexcept;
+        void retire(MeshArenaBuffer buffer, const TlsfAllocation& allocation, uint64_t frame);
+        uint64_t compactBuffer(MeshArenaBuffer buffer, uint64_t frame, uint64_t budget,
+            std::vector<MeshArenaCopy>& copies);
+
+    private:
+        MeshArenaConfig config_;
+        TlsfAllocator vertex_allocator_;
+        TlsfAllocator index_allocator_;
+
+        std::vector<SectionAllocation> sections_;  // Indexed by section slot
+        uint32_t live_sections_ = 0;
+        std::deque<PendingFree> pending_frees_;    // Ordered by frame
+
+        uint64_t bytes_moved_last_frame_ = 0;
+        uint64_t bytes_moved_total_ = 0;
+        uint32_t failed_allocations_ = 0;
+    };
+
+} // namespace AshCore
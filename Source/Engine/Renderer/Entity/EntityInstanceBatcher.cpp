@@ -0,0 +1,190 @@
+#include "ashbornpch.h"
+
+#include "EntityInstanceBatcher.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t LANES = 8;
+
+        // Runs fn(batch_index, begin, end) over fixed batches, on the job system when available
+        template<typename Fn>
+        void forEachBatch(JobSystem* jobs, size_t count, size_t batch_size, Fn&& fn) {
+            if (jobs && count > batch_size) {
+                jobs->parallelFor(count, batch_size, [&](size_t begin, size_t end) {
+                    fn(begin / batch_size, begin, end);
+                    });
+                return;
+            }
+            for (size_t begin = 0; begin < count; begin += batch_size) {
+                fn(begin / batch_size, begin, std::min(begin + batch_size, count));
+            }
+        }
+    }
+
+    // ==========================================
+    // ENTITY MESH TABLE
+    // ==========================================
+
+    void EntityMeshTable::setMesh(uint32_t mesh, const EntityMeshInfo& info) {
+        if (mesh >= meshes_.size()) {
+            meshes_.resize(mesh + 1);
+        }
+        meshes_[mesh] = info;
+    }
+
+    void EntityMeshTable::clearMesh(uint32_t mesh) {
+        if (mesh < meshes_.size()) {
+            meshes_[mesh] = {};
+        }
+    }
+
+    void EntityDrawList::clear() noexcept {
+        groups.clear();
+        commands.clear();
+        stats = {};
+    }
+
+    // ==========================================
+    // INSTANCE BATCHER
+    // ==========================================
+
+    EntityInstanceBatcher::EntityInstanceBatcher(const EntityBatchConfig& config)
+        : config_(config) {
+        // Whole SIMD groups per batch
+        config_.batch_size = std::max<size_t>((config_.batch_size + LANES - 1) / LANES * LANES, LANES);
+    }
+
+    void EntityInstanceBatcher::build(const Frustum& frustum, std::span<const EntityRenderProxy> entities, const EntityMeshTable& meshes,
+        std::span<std::byte> instance_memory, JobSystem* jobs, EntityDrawList& out) {
+        out.clear();
+        out.stats.entities = static_cast<uint32_t>(entities.size());
+        if (entities.empty()) return;
+
+        const size_t batch_size = config_.batch_size;
+        const size_t batch_count = (entities.size() + batch_size - 1) / batch_size;
+        batch_visible_.resize(batch_count);
+
+        // ---- Pass 1: cull eight bounding spheres at a time
+        forEachBatch(jobs, entities.size(), batch_size, [&](size_t batch, size_t begin, size_t end) {
+            std::vector<uint32_t>& visible = batch_visible_[batch];
+            visible.clear();
+
+            alignas(32) float x[LANES], y[LANES], z[LANES], radius[LANES];
+            for (size_t base = begin; base < end; base += LANES) {
+                const size_t lanes = std::min(LANES, end - base);
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    const auto& bounds = entities[base + std::min(lane, lanes - 1)].bounds;
+                    x[lane] = bounds[0];
+                    y[lane] = bounds[1];
+                    z[lane] = bounds[2];
+                    radius[lane] = bounds[3];
+                }
+
+                uint32_t mask = cullSpheres8(frustum, x, y, z, radius, config_.use_simd);
+                mask &= (1u << lanes) - 1;
+                while (mask != 0) {
+                    const auto entity = static_cast<uint32_t>(base + static_cast<size_t>(std::countr_zero(mask)));
+                    if (meshes.isValid(entities[entity].mesh)) visible.push_back(entity);
+                    mask &= mask - 1;
+                }
+            }
+            });
+
+        // ---- Group by (material, mesh) in visible order
+        visible_.clear();
+        visible_group_.clear();
+        groups_.clear();
+        group_lookup_.clear();
+        for (const auto& batch : batch_visible_) {
+            for (const uint32_t entity : batch) {
+                const EntityRenderProxy& proxy = entities[entity];
+                const uint64_t key = (static_cast<uint64_t>(proxy.material) << 32) | proxy.mesh;
+
+                auto [it, inserted] = group_lookup_.try_emplace(key, static_cast<uint32_t>(groups_.size()));
+                if (inserted) {
+                    groups_.push_back({ proxy.material, proxy.mesh, 0, 0 });
+                }
+                ++groups_[it->second].instance_count;
+
+                visible_.push_back({ entity, UINT32_MAX });
+                visible_group_.push_back(it->second);
+            }
+        }
+        out.stats.entities_visible = static_cast<uint32_t>(visible_.size());
+        if (visible_.empty()) return;
+
+        // Material-major order keeps pipeline/descriptor changes to a minimum
+        group_order_.resize(groups_.size());
+        std::iota(group_order_.begin(), group_order_.end(), 0u);
+        std::sort(group_order_.begin(), group_order_.end(), [&](uint32_t a, uint32_t b) {
+            if (groups_[a].material != groups_[b].material) return groups_[a].material < groups_[b].material;
+            return groups_[a].mesh < groups_[b].mesh;
+            });
+
+        uint32_t first_instance = 0;
+        for (const uint32_t group : group_order_) {
+            groups_[group].first_instance = first_instance;
+            first_instance += groups_[group].instance_count;
+        }
+
+        // ---- Assign instance slots; whatever doesn't fit the buffer is dropped
+        const auto capacity = static_cast<uint32_t>(instance_memory.size() / sizeof(GpuEntityInstance));
+        group_cursor_.assign(groups_.size(), 0);
+        for (size_t i = 0; i < visible_.size(); ++i) {
+            const uint32_t group = visible_group_[i];
+            const uint32_t slot = groups_[group].first_instance + group_cursor_[group]++;
+            if (slot < capacity) {
+                visible_[i].slot = slot;
+            }
+            else {
+                ++out.stats.instances_dropped;
+            }
+        }
+        if (out.stats.instances_dropped > 0) {
+            print_w("Entity instance buffer full, entities dropped", LogContext{
+                {"visible", out.stats.entities_visible},
+                {"capacity", capacity}
+                });
+        }
+
+        // ---- Pass 2: write instances straight into the mapped frame buffer
+        std::byte* memory = instance_memory.data();
+        forEachBatch(jobs, visible_.size(), batch_size, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (visible_[i].slot == UINT32_MAX) continue;
+                const EntityRenderProxy& proxy = entities[visible_[i].entity];
+
+                GpuEntityInstance instance;
+                std::memcpy(instance.transform, proxy.transform.data(), sizeof(instance.transform));
+                instance.palette_offset = proxy.palette_offset;
+                instance.entity_id = proxy.entity_id;
+                instance.tint = proxy.tint;
+                instance.highlight = proxy.highlight;
+                std::memcpy(memory + static_cast<size_t>(visible_[i].slot) * sizeof(GpuEntityInstance), &instance, sizeof(instance));
+            }
+            });
+
+        // ---- One instanced draw per group
+        out.groups.reserve(groups_.size());
+        out.commands.reserve(groups_.size());
+        for (const uint32_t index : group_order_) {
+            EntityDrawGroup group = groups_[index];
+            if (group.first_instance >= capacity) break;
+            group.instance_count = std::min(group.instance_count, capacity - group.first_instance);
+
+            const EntityMeshInfo& mesh = meshes.getMesh(group.mesh);
+            out.groups.push_back(group);
+            out.commands.push_back({ mesh.index_count, group.instance_count, mesh.first_index, mesh.vertex_offset, group.first_instance });
+            out.stats.instances_written += group.instance_count;
+        }
+        out.stats.draws = static_cast<uint32_t>(out.commands.size());
+    }
+
+} // namespace AshCore
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Draw/IndirectDraw.h"
+#include "Culling/FrustumCulling.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // GPU-FACING LAYOUT
+    // ==========================================
+
+    // Per-instance data read by the entity vertex shader through gl_InstanceIndex
+    struct alignas(16) GpuEntityInstance {
+        float transform[12];      // Row-major 3x4 world matrix
+        uint32_t palette_offset;  // First bone matrix in the skinning palette buffer, NO_PALETTE if rigid
+        uint32_t entity_id;       // Picking / debug
+        uint32_t tint;            // RGBA8
+        float highlight;          // 0..1 damage flash
+    };
+    static_assert(sizeof(GpuEntityInstance) == 64, "std430 layout expects 64 bytes");
+
+    inline constexpr uint32_t NO_PALETTE = UINT32_MAX;
+
+    // ==========================================
+    // ENTITY INPUT / MESHES
+    // ==========================================
+
+    // Snapshot of one entity, written by the entity system after its spatial update
+    struct EntityRenderProxy {
+        std::array<float, 12> transform{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0 };
+        std::array<float, 4> bounds{};  // World-space bounding sphere (center, radius)
+        uint32_t mesh = 0;
+        uint32_t material = 0;
+        uint32_t palette_offset = NO_PALETTE;
+        uint32_t entity_id = 0;
+        uint32_t tint = 0xFFFFFFFF;
+        float highlight = 0.0f;
+    };
+
+    struct EntityMeshInfo {
+        int32_t vertex_offset = 0;
+        uint32_t first_index = 0;
+        uint32_t index_count = 0;
+    };
+
+    // Mesh id -> index range in the entity mesh buffers
+    class EntityMeshTable {
+    public:
+        void setMesh(uint32_t mesh, const EntityMeshInfo& info);
+        void clearMesh(uint32_t mesh);
+
+        [[nodiscard]] bool isValid(uint32_t mesh) const noexcept { return mesh < meshes_.size() && meshes_[mesh].index_count > 0; }
+        [[nodiscard]] const EntityMeshInfo& getMesh(uint32_t mesh) const noexcept { return meshes_[mesh]; }
+        [[nodiscard]] uint32_t getMeshCount() const noexcept { return static_cast<uint32_t>(meshes_.size()); }
+
+    private:
+        std::vector<EntityMeshInfo> meshes_;
+    };
+
+    // ==========================================
+    // DRAW OUTPUT
+    // ==========================================
+
+    // One instanced draw; commands[i] of the list draws groups[i]
+    struct EntityDrawGroup {
+        uint32_t material;
+        uint32_t mesh;
+        uint32_t first_instance;
+        uint32_t instance_count;
+    };
+
+    struct EntityDrawStats {
+        uint32_t entities = 0;           // Submitted this frame (EngineStats::entities_active)
+        uint32_t entities_visible = 0;
+        uint32_t instances_written = 0;
+        uint32_t instances_dropped = 0;  // Instance buffer was full
+        uint32_t draws = 0;
+    };
+
+    struct EntityDrawList {
+        std::vector<EntityDrawGroup> groups;             // Sorted by material, then mesh
+        std::vector<DrawIndexedIndirectCommand> commands;
+        EntityDrawStats stats;
+
+        void clear() noexcept;
+    };
+
+    // ==========================================
+    // INSTANCE BATCHER
+    // ==========================================
+
+    struct EntityBatchConfig {
+        size_t batch_size = 1024;  // Entities per job
+        bool use_simd = true;
+    };
+
+    /**
+     * @brief Culls entities and turns them into one instanced draw per mesh/material pair
+     *
+     * Culling and instance writes run over fixed batches on the job system;
+     * grouping in between is a single linear pass. Instances land in
+     * visible order inside each group, so the output never depends on
+     * thread count. instance_memory is the mapped per-frame instance buffer
+     * (e.g. one FrameResourceRing slot); first_instance indexes into it.
+     */
+    class EntityInstanceBatcher {
+    public:
+        explicit EntityInstanceBatcher(const EntityBatchConfig& config = {});
+
+        // jobs may be null for single-threaded extraction
+        void build(const Frustum& frustum, std::span<const EntityRenderProxy> entities, const EntityMeshTable& meshes,
+            std::span<std::byte> instance_memory, JobSystem* jobs, EntityDrawList& out);
+
+        [[nodiscard]] const EntityBatchConfig& getConfig() const noexcept { return config_; }
+
+    private:
+        struct VisibleEntity {
+            uint32_t entity;
+            uint32_t slot;  // Instance index, UINT32_MAX when dropped
+        };
+
+    private:
+        EntityBatchConfig config_;
+
+        // Reused between frames
+        std::vector<std::vector<uint32_t>> batch_visible_;
+        std::vector<VisibleEntity> visible_;
+        std::vector<uint32_t> visible_group_;
+        std::unordered_map<uint64_t, uint32_t> group_lookup_;  // (material << 32 | mesh) -> group
+        std::vector<EntityDrawGroup> groups_;
+        std::vector<uint32_t> group_order_;
+        std::vector<uint32_t> group_cursor_;
+    };
+
+} // namespace AshCore
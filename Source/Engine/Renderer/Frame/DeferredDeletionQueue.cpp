@@ -0,0 +1,63 @@
+#include "ashbornpch.h"
+
+#include "DeferredDeletionQueue.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace AshCore {
+
+    DeferredDeletionQueue::~DeferredDeletionQueue() {
+        if (!entries_.empty()) {
+            print_w("Deferred deletion queue destroyed with pending entries - flushing", LogContext{
+                {"count", entries_.size()}
+                });
+            flush();
+        }
+    }
+
+    void DeferredDeletionQueue::enqueue(uint64_t last_used_frame, Deleter deleter) {
+        std::lock_guard lock(mutex_);
+
+        // Usually appended in frame order; keep the deque sorted if a late thread isn't
+        if (entries_.empty() || entries_.back().frame <= last_used_frame) {
+            entries_.push_back({ last_used_frame, std::move(deleter) });
+            return;
+        }
+
+        auto it = std::upper_bound(entries_.begin(), entries_.end(), last_used_frame,
+            [](uint64_t frame, const Entry& entry) { return frame < entry.frame; });
+        entries_.insert(it, { last_used_frame, std::move(deleter) });
+    }
+
+    size_t DeferredDeletionQueue::collect(uint64_t completed_frame) {
+        // Run deleters outside the lock: they may enqueue dependent objects
+        std::vector<Deleter> ready;
+        {
+            std::lock_guard lock(mutex_);
+            while (!entries_.empty() && entries_.front().frame <= completed_frame) {
+                ready.push_back(std::move(entries_.front().deleter));
+                entries_.pop_front();
+            }
+        }
+
+        for (auto& deleter : ready) {
+            deleter();
+        }
+        return ready.size();
+    }
+
+    size_t DeferredDeletionQueue::flush() {
+        size_t total = 0;
+        while (size_t ran = collect(UINT64_MAX)) {
+            total += ran;
+        }
+        return total;
+    }
+
+    size_t DeferredDeletionQueue::getPendingCount() const {
+        std::lock_guard lock(mutex_);
+        return entries_.size();
+    }
+
+} // namespace AshCore
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace AshCore {
+
+    // ==========================================
+    // DEFERRED DELETION QUEUE
+    // ==========================================
+
+    /**
+     * @brief Destroys GPU objects once the last frame that used them has completed
+     *
+     * Callers push a deleter tagged with the frame that last referenced the
+     * object (normally the current frame); collect() runs every deleter whose
+     * frame the fence has passed. Thread-safe, so loader/streaming threads can
+     * retire resources too.
+     */
+    class DeferredDeletionQueue {
+    public:
+        using Deleter = std::function<void()>;
+
+        DeferredDeletionQueue() = default;
+        ~DeferredDeletionQueue();
+
+        DeferredDeletionQueue(const DeferredDeletionQueue&) = delete;
+        DeferredDeletionQueue& operator=(const DeferredDeletionQueue&) = delete;
+
+        void enqueue(uint64_t last_used_frame, Deleter deleter);
+
+        // Runs deleters for frames <= completed_frame, returns how many ran
+        size_t collect(uint64_t completed_frame);
+
+        // Runs everything; only valid after the device is idle
+        size_t flush();
+
+        [[nodiscard]] size_t getPendingCount() const;
+
+    private:
+        struct Entry {
+            uint64_t frame;
+            Deleter deleter;
+        };
+
+        mutable std::mutex mutex_;
+        std::deque<Entry> entries_;  // Sorted by frame
+    };
+
+} // namespace AshCore
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Frame/FrameTimeline.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // FRAME RESOURCE RING
+    // ==========================================
+
+    /**
+     * @brief One instance of T per frame in flight (command pools, descriptor pools, transient buffers)
+     *
+     * acquire() hands out the slot for the timeline's current frame and runs
+     * the reset hook the first time a slot is reused. FrameTimeline::beginFrame()
+     * has already waited for the frame that used the slot before, so the reset
+     * (vkResetCommandPool, vkResetDescriptorPool, rewinding a bump allocator)
+     * never races the GPU.
+     */
+    template<typename T>
+    class FrameResourceRing {
+    public:
+        using ResetFn = std::function<void(T& resource, uint64_t frame)>;
+
+        FrameResourceRing(const FrameTimeline& timeline, std::vector<T> resources, ResetFn reset = {})
+            : timeline_(timeline)
+            , resources_(std::move(resources))
+            , last_frame_(resources_.size(), 0)
+            , reset_(std::move(reset)) {
+        }
+
+        template<typename Factory>
+        static FrameResourceRing create(const FrameTimeline& timeline, Factory&& factory, ResetFn reset = {}) {
+            std::vector<T> resources;
+            resources.reserve(timeline.getFramesInFlight());
+            for (uint32_t i = 0; i < timeline.getFramesInFlight(); ++i) {
+                resources.push_back(factory(i));
+            }
+            return FrameResourceRing(timeline, std::move(resources), std::move(reset));
+        }
+
+        // Resource for the current frame
+        [[nodiscard]] T& acquire() {
+            const uint64_t frame = timeline_.getCurrentFrame();
+            const uint32_t slot = timeline_.getFrameSlot();
+
+            if (last_frame_[slot] != frame) {
+                if (last_frame_[slot] != 0 && reset_) {
+                    reset_(resources_[slot], frame);
+                }
+                last_frame_[slot] = frame;
+            }
+            return resources_[slot];
+        }
+
+        // Access without reset semantics (teardown, debug UI)
+        [[nodiscard]] T& getSlot(uint32_t slot) noexcept { return resources_[slot]; }
+        [[nodiscard]] uint32_t getSlotCount() const noexcept { return static_cast<uint32_t>(resources_.size()); }
+
+        template<typename Fn>
+        void forEach(Fn&& fn) {
+            for (auto& resource : resources_) fn(resource);
+        }
+
+    private:
+        const FrameTimeline& timeline_;
+        std::vector<T> resources_;
+        std::vector<uint64_t> last_frame_;  // Frame that last acquired each slot
+        ResetFn reset_;
+    };
+
+} // namespace AshCore
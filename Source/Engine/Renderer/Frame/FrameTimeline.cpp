@@ -0,0 +1,75 @@
+#include "ashbornpch.h"
+
+#include "FrameTimeline.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace AshCore {
+
+    // ==========================================
+    // SIMULATED FENCE
+    // ==========================================
+
+    uint64_t SimulatedFrameFence::getCompletedValue() const {
+        std::lock_guard lock(mutex_);
+        return value_;
+    }
+
+    bool SimulatedFrameFence::wait(uint64_t value, uint64_t timeout_ns) {
+        std::unique_lock lock(mutex_);
+        return signalled_.wait_for(lock, std::chrono::nanoseconds(timeout_ns), [&]() { return value_ >= value; });
+    }
+
+    void SimulatedFrameFence::signal(uint64_t value) {
+        {
+            std::lock_guard lock(mutex_);
+            value_ = std::max(value_, value);
+        }
+        signalled_.notify_all();
+    }
+
+    // ==========================================
+    // FRAME TIMELINE
+    // ==========================================
+
+    FrameTimeline::FrameTimeline(IFrameFence& fence, uint32_t frames_in_flight)
+        : fence_(fence)
+        , frames_in_flight_(std::max(frames_in_flight, 1u)) {
+    }
+
+    uint64_t FrameTimeline::beginFrame() {
+        const uint64_t next = current_frame_ + 1;
+        poll();
+
+        // The frame that last used this slot must be done before we reuse it
+        if (next > frames_in_flight_) {
+            const uint64_t required = next - frames_in_flight_;
+            if (completed_frame_ < required) {
+                constexpr uint64_t WARN_AFTER_NS = 1'000'000'000;  // 1s: the GPU is likely hung
+                while (!fence_.wait(required, WARN_AFTER_NS)) {
+                    print_w("Waiting on GPU frame fence", LogContext{
+                        {"frame", required},
+                        {"completed", fence_.getCompletedValue()}
+                        });
+                }
+                poll();
+            }
+        }
+
+        current_frame_ = next;
+        return current_frame_;
+    }
+
+    uint64_t FrameTimeline::poll() {
+        completed_frame_ = std::max(completed_frame_, fence_.getCompletedValue());
+        return completed_frame_;
+    }
+
+    void FrameTimeline::waitIdle() {
+        while (poll() < current_frame_) {
+            fence_.wait(current_frame_, 1'000'000'000);
+        }
+    }
+
+} // namespace AshCore
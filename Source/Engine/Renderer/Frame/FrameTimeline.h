@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace AshCore {
+
+    // ==========================================
+    // FRAME FENCE
+    // ==========================================
+
+    // Timeline-semaphore semantics: the GPU signals the frame number when a frame's work is done
+    class IFrameFence {
+    public:
+        virtual ~IFrameFence() = default;
+
+        [[nodiscard]] virtual uint64_t getCompletedValue() const = 0;
+
+        // Returns false on timeout
+        virtual bool wait(uint64_t value, uint64_t timeout_ns) = 0;
+    };
+
+    // CPU-driven fence for headless runs and tests: "GPU" progress is whatever signal() says
+    class SimulatedFrameFence final : public IFrameFence {
+    public:
+        [[nodiscard]] uint64_t getCompletedValue() const override;
+        bool wait(uint64_t value, uint64_t timeout_ns) override;
+
+        void signal(uint64_t value);
+
+    private:
+        mutable std::mutex mutex_;
+        std::condition_variable signalled_;
+        uint64_t value_ = 0;
+    };
+
+    // ==========================================
+    // FRAME TIMELINE
+    // ==========================================
+
+    /**
+     * @brief Frame numbering and CPU/GPU pacing for N frames in flight
+     *
+     * Frame numbers start at 1 and increase forever; frame 0 is "nothing".
+     * beginFrame() blocks until frame (N - frames_in_flight) has completed,
+     * which is what makes it safe to reuse that frame's per-frame resources.
+     */
+    class FrameTimeline {
+    public:
+        FrameTimeline(IFrameFence& fence, uint32_t frames_in_flight);
+
+        // Returns the new frame number
+        uint64_t beginFrame();
+
+        // Value the frame's final submission must signal
+        [[nodiscard]] uint64_t getSignalValue() const noexcept { return current_frame_; }
+
+        // Refreshes the completed value without blocking
+        uint64_t poll();
+
+        // Blocks until everything submitted so far is done (shutdown, device loss)
+        void waitIdle();
+
+        [[nodiscard]] uint64_t getCurrentFrame() const noexcept { return current_frame_; }
+        [[nodiscard]] uint64_t getCompletedFrame() const noexcept { return completed_frame_; }
+        [[nodiscard]] uint32_t getFramesInFlight() const noexcept { return frames_in_flight_; }
+        [[nodiscard]] uint32_t getFrameSlot() const noexcept { return static_cast<uint32_t>(current_frame_ % frames_in_flight_); }
+        [[nodiscard]] bool isComplete(uint64_t frame) const noexcept { return frame <= completed_frame_; }
+
+    private:
+        IFrameFence& fence_;
+        uint32_t frames_in_flight_;
+        uint64_t current_frame_ = 0;
+        uint64_t completed_frame_ = 0;
+    };
+
+} // namespace AshCore
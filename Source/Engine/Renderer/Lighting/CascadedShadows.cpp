@@ -0,0 +1,313 @@
+#include "ashbornpch.h"
+
+#include "CascadedShadows.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t LANES = 8;
+        constexpr float EMPTY_BOUND = 1e30f;      // Parks empty slots far outside any frustum
+        constexpr float RADIUS_QUANTUM = 1.0f / 16.0f;
+
+        using Vec3 = std::array<float, 3>;
+
+        // Runs fn(batch_index, begin, end) over fixed batches, on the job system when available
+        template<typename Fn>
+        void forEachBatch(JobSystem* jobs, size_t count, size_t batch_size, Fn&& fn) {
+            if (jobs && count > batch_size) {
+                jobs->parallelFor(count, batch_size, [&](size_t begin, size_t end) {
+                    fn(begin / batch_size, begin, end);
+                    });
+                return;
+            }
+            for (size_t begin = 0; begin < count; begin += batch_size) {
+                fn(begin / batch_size, begin, std::min(begin + batch_size, count));
+            }
+        }
+
+        size_t padToLanes(size_t count) {
+            return (count + LANES - 1) / LANES * LANES;
+        }
+
+        float dot(const Vec3& a, const Vec3& b) {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        Vec3 cross(const Vec3& a, const Vec3& b) {
+            return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+        }
+
+        Vec3 normalize(const Vec3& v) {
+            const float length = std::sqrt(dot(v, v));
+            return length > 0.0f ? Vec3{ v[0] / length, v[1] / length, v[2] / length } : v;
+        }
+    }
+
+    // ==========================================
+    // SHADOW CASTERS
+    // ==========================================
+
+    void ShadowCasterTable::reserveSlot(uint32_t slot) {
+        if (slot < slot_count_) return;
+        slot_count_ = slot + 1;
+
+        const size_t padded = padToLanes(slot_count_);
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            min_[axis].resize(padded, EMPTY_BOUND);
+            max_[axis].resize(padded, EMPTY_BOUND);
+        }
+        occupied_.resize(slot_count_, 0);
+    }
+
+    void ShadowCasterTable::recordChange(uint32_t slot) {
+        if (!occupied_[slot]) return;
+        changes_.push_back({ { min_[0][slot], min_[1][slot], min_[2][slot] }, { max_[0][slot], max_[1][slot], max_[2][slot] } });
+    }
+
+    void ShadowCasterTable::setSection(uint32_t slot, const std::array<float, 3>& min, const std::array<float, 3>& max) {
+        reserveSlot(slot);
+        recordChange(slot);  // Old bounds: the geometry leaves them
+
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            min_[axis][slot] = min[axis];
+            max_[axis][slot] = max[axis];
+        }
+        occupied_[slot] = 1;
+        recordChange(slot);
+    }
+
+    void ShadowCasterTable::clearSection(uint32_t slot) {
+        if (slot >= slot_count_ || !occupied_[slot]) return;
+
+        recordChange(slot);
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            min_[axis][slot] = EMPTY_BOUND;
+            max_[axis][slot] = EMPTY_BOUND;
+        }
+        occupied_[slot] = 0;
+    }
+
+    // ==========================================
+    // CASCADED SHADOW MAPS
+    // ==========================================
+
+    CascadedShadowMaps::CascadedShadowMaps(const ShadowConfig& config)
+        : config_(config) {
+        config_.cascade_count = std::clamp(config_.cascade_count, 1u, MAX_SHADOW_CASCADES);
+        config_.resolution = std::max(config_.resolution, 1u);
+        config_.first_cached_cascade = std::min(config_.first_cached_cascade, config_.cascade_count);
+        config_.cache_margin = std::max(config_.cache_margin, 0.0f);
+    }
+
+    void CascadedShadowMaps::invalidate() noexcept {
+        for (CascadeState& state : states_) state.valid = false;
+    }
+
+    CascadedShadowMaps::LightFit CascadedShadowMaps::makeBasis(const std::array<float, 3>& sun_direction) {
+        LightFit fit{};
+        fit.forward = sun_direction;
+
+        // The sun arcs east-west, so north stays a stable reference for most of the day
+        const Vec3 reference = std::abs(fit.forward[2]) < 0.99f ? Vec3{ 0.0f, 0.0f, 1.0f } : Vec3{ 1.0f, 0.0f, 0.0f };
+        fit.right = normalize(cross(fit.forward, reference));
+        fit.up = cross(fit.right, fit.forward);
+        return fit;
+    }
+
+    std::array<float, 16> CascadedShadowMaps::buildViewProjection(const LightFit& fit) const {
+        const float inv_extent = 1.0f / fit.radius;
+        const float near_depth = fit.center[2] - fit.radius - config_.caster_distance;
+        const float inv_depth = 1.0f / (2.0f * fit.radius + config_.caster_distance);
+
+        // Rows: light right/up scaled to [-1, 1], forward to [0, 1]
+        std::array<float, 16> m{};
+        for (size_t axis = 0; axis < 3; ++axis) {
+            m[axis * 4 + 0] = fit.right[axis] * inv_extent;
+            m[axis * 4 + 1] = fit.up[axis] * inv_extent;
+            m[axis * 4 + 2] = fit.forward[axis] * inv_depth;
+        }
+        m[12] = -fit.center[0] * inv_extent;
+        m[13] = -fit.center[1] * inv_extent;
+        m[14] = -near_depth * inv_depth;
+        m[15] = 1.0f;
+        return m;
+    }
+
+    void CascadedShadowMaps::update(const ClusterCamera& camera, const std::array<float, 3>& sun_direction,
+        ShadowCasterTable& casters, JobSystem* jobs) {
+        stats_ = {};
+        const uint32_t count = config_.cascade_count;
+
+        Vec3 sun = normalize(sun_direction);
+        if (dot(sun, sun) == 0.0f) {
+            sun = { 0.0f, -1.0f, 0.0f };
+        }
+
+        // ---- Camera basis from the rigid world -> view matrix
+        const auto& v = camera.view;
+        const Vec3 cam_right{ v[0], v[4], v[8] };
+        const Vec3 cam_up{ v[1], v[5], v[9] };
+        const Vec3 cam_forward{ -v[2], -v[6], -v[10] };
+        Vec3 cam_position{};
+        for (size_t j = 0; j < 3; ++j) {
+            cam_position[j] = -(v[j * 4 + 0] * v[12] + v[j * 4 + 1] * v[13] + v[j * 4 + 2] * v[14]);
+        }
+
+        // ---- Practical split scheme: blend of logarithmic and uniform
+        const float near_plane = camera.near_plane;
+        const float far_plane = std::max(std::min(camera.far_plane, config_.max_distance), near_plane * 1.001f);
+        std::array<float, MAX_SHADOW_CASCADES + 1> splits{};
+        for (uint32_t i = 0; i <= count; ++i) {
+            const float t = static_cast<float>(i) / static_cast<float>(count);
+            const float logarithmic = near_plane * std::pow(far_plane / near_plane, t);
+            const float uniform = near_plane + (far_plane - near_plane) * t;
+            splits[i] = config_.split_lambda * logarithmic + (1.0f - config_.split_lambda) * uniform;
+        }
+
+        // ---- Changed section boxes, padded for the SIMD cull
+        const auto changes = casters.getChanges();
+        const size_t padded_changes = padToLanes(changes.size());
+        for (auto& bound : change_bounds_) bound.assign(padded_changes, EMPTY_BOUND);
+        for (size_t i = 0; i < changes.size(); ++i) {
+            for (size_t axis = 0; axis < 3; ++axis) {
+                change_bounds_[axis][i] = changes[i].min[axis];
+                change_bounds_[3 + axis][i] = changes[i].max[axis];
+            }
+        }
+
+        const float tan_half_fov = std::tan(camera.fov_y * 0.5f);
+        const float cos_threshold = std::cos(config_.sun_angle_threshold);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            ShadowCascade& cascade = cascades_[i];
+            CascadeState& state = states_[i];
+            cascade.split_near = splits[i];
+            cascade.split_far = splits[i + 1];
+
+            // Bounding sphere of the frustum slice; its radius only depends on the
+            // projection, so quantizing it makes the extent exactly constant
+            Vec3 corners[8];
+            for (uint32_t c = 0; c < 8; ++c) {
+                const float depth = (c & 4) ? cascade.split_far : cascade.split_near;
+                const float sx = (c & 1) ? 1.0f : -1.0f;
+                const float sy = (c & 2) ? 1.0f : -1.0f;
+                const float half_height = depth * tan_half_fov;
+                const float half_width = half_height * camera.aspect;
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    corners[c][axis] = cam_position[axis] + cam_forward[axis] * depth +
+                        cam_right[axis] * sx * half_width + cam_up[axis] * sy * half_height;
+                }
+            }
+            Vec3 center{};
+            for (const Vec3& corner : corners) {
+                for (size_t axis = 0; axis < 3; ++axis) center[axis] += corner[axis] * 0.125f;
+            }
+            float radius = 0.0f;
+            for (const Vec3& corner : corners) {
+                const Vec3 d{ corner[0] - center[0], corner[1] - center[1], corner[2] - center[2] };
+                radius = std::max(radius, std::sqrt(dot(d, d)));
+            }
+            radius = std::ceil(radius / RADIUS_QUANTUM) * RADIUS_QUANTUM;
+
+            // ---- Decide whether this cascade's layer is still good
+            const bool cached = i >= config_.first_cached_cascade;
+            bool refit = !cached || !state.valid;
+            bool render = refit;
+            if (!refit) {
+                const LightFit& fit = state.fit;
+                const Vec3 local{ dot(center, fit.right), dot(center, fit.up), dot(center, fit.forward) };
+                bool covered = true;
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    covered = covered && std::abs(local[axis] - fit.center[axis]) + radius <= fit.radius;
+                }
+
+                if (dot(fit.forward, sun) < cos_threshold) {
+                    refit = true;
+                    ++stats_.invalidated_by_sun;
+                }
+                else if (!covered) {
+                    refit = true;
+                    ++stats_.invalidated_by_camera;
+                }
+                else if (!changes.empty()) {
+                    change_hits_.clear();
+                    cullAabbs(state.frustum, change_bounds_[0].data(), change_bounds_[1].data(), change_bounds_[2].data(),
+                        change_bounds_[3].data(), change_bounds_[4].data(), change_bounds_[5].data(),
+                        changes.size(), change_hits_, config_.use_simd);
+                    if (!change_hits_.empty()) {
+                        ++stats_.invalidated_by_sections;
+                    }
+                    render = !change_hits_.empty();
+                }
+                render = render || refit;
+            }
+
+            if (refit) {
+                LightFit fit = makeBasis(sun);
+                fit.radius = cached ? radius * (1.0f + config_.cache_margin) : radius;
+
+                // Snap to whole texels so the rasterized grid never slides under the scene
+                const float texel = 2.0f * fit.radius / static_cast<float>(config_.resolution);
+                fit.center = { dot(center, fit.right), dot(center, fit.up), dot(center, fit.forward) };
+                fit.center[0] = std::round(fit.center[0] / texel) * texel;
+                fit.center[1] = std::round(fit.center[1] / texel) * texel;
+
+                state.fit = fit;
+                state.frustum = Frustum::fromViewProjection(buildViewProjection(fit));
+                state.valid = true;
+            }
+
+            cascade.view_projection = buildViewProjection(state.fit);
+            cascade.sun_direction = state.fit.forward;
+            cascade.texel_size = 2.0f * state.fit.radius / static_cast<float>(config_.resolution);
+            cascade.cached = cached;
+            cascade.render = render;
+            if (!render) cascade.casters.clear();
+        }
+
+        // ---- Cull casters for every layer that gets redrawn, one cascade per job
+        forEachBatch(jobs, count, 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                ShadowCascade& cascade = cascades_[i];
+                if (!cascade.render) continue;
+
+                std::vector<uint32_t>& visible = visible_[i];
+                visible.clear();
+                cullAabbs(states_[i].frustum, casters.getMin(0), casters.getMin(1), casters.getMin(2),
+                    casters.getMax(0), casters.getMax(1), casters.getMax(2), casters.getSlotCount(), visible, config_.use_simd);
+
+                cascade.casters.clear();
+                cascade.casters.reserve(visible.size());
+                for (const uint32_t slot : visible) {
+                    cascade.casters.push_back({ slot, ALL_FACES_MASK });
+                }
+            }
+            });
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (cascades_[i].render) {
+                ++stats_.cascades_rendered;
+                stats_.casters_drawn += static_cast<uint32_t>(cascades_[i].casters.size());
+            }
+            else {
+                ++stats_.cascades_reused;
+            }
+        }
+        casters.clearChanges();
+    }
+
+    GpuShadowCascades CascadedShadowMaps::getGpuData() const noexcept {
+        GpuShadowCascades data{};
+        for (uint32_t i = 0; i < config_.cascade_count; ++i) {
+            std::copy(cascades_[i].view_projection.begin(), cascades_[i].view_projection.end(), data.view_projection[i]);
+            data.split_far[i] = cascades_[i].split_far;
+            data.texel_size[i] = cascades_[i].texel_size;
+        }
+        return data;
+    }
+
+} // namespace AshCore
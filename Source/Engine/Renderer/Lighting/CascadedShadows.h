@@ -0,0 +1,173 @@
+#pragma once
+
+#include "Culling/FrustumCulling.h"
+#include "Draw/IndirectDraw.h"
+#include "Lighting/ClusteredLighting.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // SHADOW CASTERS
+    // ==========================================
+
+    /**
+     * Section bounds in SoA form for the box culling path, indexed by the
+     * same slot as SectionMeshTable. Every set/clear also records the
+     * affected boxes so cached cascades can tell whether they went stale.
+     */
+    class ShadowCasterTable {
+    public:
+        struct Change {
+            std::array<float, 3> min;
+            std::array<float, 3> max;
+        };
+
+        void setSection(uint32_t slot, const std::array<float, 3>& min, const std::array<float, 3>& max);
+        void clearSection(uint32_t slot);
+        void clearChanges() noexcept { changes_.clear(); }
+
+        [[nodiscard]] uint32_t getSlotCount() const noexcept { return slot_count_; }
+        [[nodiscard]] std::span<const Change> getChanges() const noexcept { return changes_; }
+
+        // Padded to a multiple of 8; empty slots never pass culling
+        [[nodiscard]] const float* getMin(uint32_t axis) const noexcept { return min_[axis].data(); }
+        [[nodiscard]] const float* getMax(uint32_t axis) const noexcept { return max_[axis].data(); }
+
+    private:
+        void reserveSlot(uint32_t slot);
+        void recordChange(uint32_t slot);
+
+    private:
+        uint32_t slot_count_ = 0;
+        std::array<std::vector<float>, 3> min_;
+        std::array<std::vector<float>, 3> max_;
+        std::vector<uint8_t> occupied_;
+        std::vector<Change> changes_;
+    };
+
+    // ==========================================
+    // CASCADES
+    // ==========================================
+
+    inline constexpr uint32_t MAX_SHADOW_CASCADES = 4;
+
+    struct ShadowConfig {
+        uint32_t cascade_count = 4;
+        uint32_t resolution = 2048;           // Per cascade layer
+        float max_distance = 256.0f;          // Shadows end here (or at the camera far plane)
+        float split_lambda = 0.75f;           // 0 = uniform splits, 1 = logarithmic
+        float caster_distance = 128.0f;       // How far toward the sun casters are kept
+        uint32_t first_cached_cascade = 2;    // This cascade and beyond are cached
+        float cache_margin = 0.25f;           // Extra extent of cached cascades, relative to their radius
+        float sun_angle_threshold = 0.0087f;  // Radians (~0.5 deg) before cached cascades follow the sun
+        bool use_simd = true;
+    };
+
+    struct ShadowCascade {
+        std::array<float, 16> view_projection{};  // Column-major, Vulkan [0, 1] depth
+        std::array<float, 3> sun_direction{};     // Direction the cascade was rendered with
+        float split_near = 0.0f;                  // View depth range it covers
+        float split_far = 0.0f;
+        float texel_size = 0.0f;                  // World units per shadow map texel
+        bool render = false;                      // Layer must be redrawn this frame
+        bool cached = false;                      // Kept across frames until invalidated
+        std::vector<VisibleSection> casters;      // Filled when render is set
+    };
+
+    /**
+     * Matches the shadow uniform block in the lighting shaders:
+     *   layout(std140) uniform ShadowCascades {
+     *       mat4 view_projection[4];
+     *       vec4 split_far;     // Cascade i in component i
+     *       vec4 texel_size;
+     *   };
+     * The per-cascade scalars must be vec4s there: a float[4] in std140
+     * strides every element to 16 bytes and would not match this struct.
+     */
+    struct alignas(16) GpuShadowCascades {
+        float view_projection[MAX_SHADOW_CASCADES][16];
+        float split_far[MAX_SHADOW_CASCADES];
+        float texel_size[MAX_SHADOW_CASCADES];
+    };
+    static_assert(MAX_SHADOW_CASCADES == 4, "split_far and texel_size are packed as one vec4 each");
+    static_assert(offsetof(GpuShadowCascades, split_far) == 256, "std140 layout expects split_far at 256");
+    static_assert(offsetof(GpuShadowCascades, texel_size) == 272, "std140 layout expects texel_size at 272");
+    static_assert(sizeof(GpuShadowCascades) == 288, "std140 layout expects 288 bytes");
+
+    struct ShadowStats {
+        uint32_t cascades_rendered = 0;
+        uint32_t cascades_reused = 0;
+        uint32_t casters_drawn = 0;       // Summed over rendered cascades
+        uint32_t invalidated_by_sun = 0;
+        uint32_t invalidated_by_camera = 0;
+        uint32_t invalidated_by_sections = 0;
+    };
+
+    /**
+     * @brief Fits sun shadow cascades to the camera and decides which need redrawing
+     *
+     * Each cascade is fitted with a bounding sphere of its slice of the
+     * view frustum, so its extent does not change as the camera turns, and
+     * its center is snapped to whole shadow texels in light space. Both keep
+     * edges from shimmering. Near cascades are refitted and redrawn every
+     * frame. Far cascades are fitted with a margin and kept until the camera
+     * leaves that margin, the sun turns past the threshold, or a section
+     * inside them changes; otherwise the previous layer is reused as is.
+     */
+    class CascadedShadowMaps {
+    public:
+        explicit CascadedShadowMaps(const ShadowConfig& config = {});
+
+        // sun_direction points from the sun into the scene. Consumes casters' change list.
+        // jobs may be null for single-threaded culling
+        void update(const ClusterCamera& camera, const std::array<float, 3>& sun_direction,
+            ShadowCasterTable& casters, JobSystem* jobs);
+
+        // Drops all cached cascades, e.g. after the shadow maps were recreated
+        void invalidate() noexcept;
+
+        [[nodiscard]] std::span<const ShadowCascade> getCascades() const noexcept { return { cascades_.data(), config_.cascade_count }; }
+        [[nodiscard]] GpuShadowCascades getGpuData() const noexcept;
+        [[nodiscard]] const ShadowStats& getStats() const noexcept { return stats_; }
+        [[nodiscard]] const ShadowConfig& getConfig() const noexcept { return config_; }
+
+    private:
+        // Orthographic light box; center is in light space (right, up, forward)
+        struct LightFit {
+            std::array<float, 3> right;
+            std::array<float, 3> up;
+            std::array<float, 3> forward;
+            std::array<float, 3> center;
+            float radius;
+        };
+
+        struct CascadeState {
+            LightFit fit{};
+            Frustum frustum;
+            bool valid = false;
+        };
+
+        [[nodiscard]] static LightFit makeBasis(const std::array<float, 3>& sun_direction);
+        [[nodiscard]] std::array<float, 16> buildViewProjection(const LightFit& fit) const;
+
+    private:
+        ShadowConfig config_;
+        ShadowStats stats_;
+        std::array<ShadowCascade, MAX_SHADOW_CASCADES> cascades_;
+        std::array<CascadeState, MAX_SHADOW_CASCADES> states_;
+
+        // Change boxes in SoA, rebuilt each update
+        std::array<std::vector<float>, 6> change_bounds_;
+        std::array<std::vector<uint32_t>, MAX_SHADOW_CASCADES> visible_;
+        std::vector<uint32_t> change_hits_;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,407 @@
+#include "ashbornpch.h"
+
+#include "ClusteredLighting.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <random>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t LANES = 8;
+
+        // Padding lanes sit far away with zero radius; finite so fast-math can't break the compare
+        constexpr float PAD_POSITION = 1e18f;
+
+        struct Aabb {
+            float min_x, min_y, min_z;
+            float max_x, max_y, max_z;
+        };
+
+        // Bit per lane whose sphere touches the box (squared distance to the box <= r^2)
+        uint32_t overlapMaskScalar(const float* x, const float* y, const float* z, const float* r, const Aabb& box) {
+            uint32_t mask = 0;
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                const float dx = std::max(std::max(box.min_x - x[lane], x[lane] - box.max_x), 0.0f);
+                const float dy = std::max(std::max(box.min_y - y[lane], y[lane] - box.max_y), 0.0f);
+                const float dz = std::max(std::max(box.min_z - z[lane], z[lane] - box.max_z), 0.0f);
+                if (dx * dx + dy * dy + dz * dz <= r[lane] * r[lane]) {
+                    mask |= 1u << lane;
+                }
+            }
+            return mask;
+        }
+
+#if defined(__AVX2__)
+        uint32_t overlapMaskAvx2(const float* x, const float* y, const float* z, const float* r, const Aabb& box) {
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 px = _mm256_loadu_ps(x);
+            const __m256 py = _mm256_loadu_ps(y);
+            const __m256 pz = _mm256_loadu_ps(z);
+            const __m256 radius = _mm256_loadu_ps(r);
+
+            const __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(box.min_x), px),
+                _mm256_sub_ps(px, _mm256_set1_ps(box.max_x))), zero);
+            const __m256 dy = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(box.min_y), py),
+                _mm256_sub_ps(py, _mm256_set1_ps(box.max_y))), zero);
+            const __m256 dz = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(box.min_z), pz),
+                _mm256_sub_ps(pz, _mm256_set1_ps(box.max_z))), zero);
+
+            const __m256 dist2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+            return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(dist2, _mm256_mul_ps(radius, radius), _CMP_LE_OQ)));
+        }
+#endif
+
+        // Calls fn(lane) for every light in the (padded) arrays that touches the box
+        template<typename Fn>
+        void forEachOverlap(const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z,
+            const std::vector<float>& r, const Aabb& box, bool simd, Fn&& fn) {
+            for (size_t base = 0; base < x.size(); base += LANES) {
+#if defined(__AVX2__)
+                uint32_t mask = simd
+                    ? overlapMaskAvx2(&x[base], &y[base], &z[base], &r[base], box)
+                    : overlapMaskScalar(&x[base], &y[base], &z[base], &r[base], box);
+#else
+                (void)simd;
+                uint32_t mask = overlapMaskScalar(&x[base], &y[base], &z[base], &r[base], box);
+#endif
+                while (mask != 0) {
+                    fn(base + static_cast<size_t>(std::countr_zero(mask)));
+                    mask &= mask - 1;
+                }
+            }
+        }
+
+        size_t paddedSize(size_t count) {
+            return (count + LANES - 1) / LANES * LANES;
+        }
+    }
+
+    void ClusterLightGrid::clear() noexcept {
+        params = {};
+        ranges.clear();
+        light_indices.clear();
+        stats = {};
+    }
+
+    // ==========================================
+    // LIGHT SOA
+    // ==========================================
+
+    void LightClusterBuilder::LightSoA::clear() noexcept {
+        x.clear();
+        y.clear();
+        z.clear();
+        r.clear();
+        index.clear();
+        count = 0;
+    }
+
+    void LightClusterBuilder::LightSoA::resize(size_t light_count) {
+        const size_t padded = paddedSize(light_count);
+        x.assign(padded, PAD_POSITION);
+        y.assign(padded, PAD_POSITION);
+        z.assign(padded, PAD_POSITION);
+        r.assign(padded, 0.0f);
+        index.assign(padded, UINT32_MAX);
+        count = light_count;
+    }
+
+    void LightClusterBuilder::LightSoA::push(float px, float py, float pz, float pr, uint32_t light) {
+        x.push_back(px);
+        y.push_back(py);
+        z.push_back(pz);
+        r.push_back(pr);
+        index.push_back(light);
+        ++count;
+    }
+
+    void LightClusterBuilder::LightSoA::pad() {
+        const size_t padded = paddedSize(count);
+        x.resize(padded, PAD_POSITION);
+        y.resize(padded, PAD_POSITION);
+        z.resize(padded, PAD_POSITION);
+        r.resize(padded, 0.0f);
+        index.resize(padded, UINT32_MAX);
+    }
+
+    // ==========================================
+    // LIGHT CLUSTER BUILDER
+    // ==========================================
+
+    LightClusterBuilder::LightClusterBuilder(const ClusterConfig& config)
+        : config_(config) {
+        config_.tiles_x = std::max(config_.tiles_x, 1u);
+        config_.tiles_y = std::max(config_.tiles_y, 1u);
+        config_.slices = std::max(config_.slices, 1u);
+        config_.transform_batch_size = std::max<size_t>(config_.transform_batch_size, LANES);
+    }
+
+    bool LightClusterBuilder::isSimdAvailable() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void LightClusterBuilder::build(const ClusterCamera& camera, std::span<const GpuPointLight> lights, JobSystem* jobs,
+        ClusterLightGrid& out) {
+        const uint32_t slice_count = config_.slices;
+        const uint32_t tile_count = config_.tiles_x * config_.tiles_y;
+        const uint32_t cluster_count = tile_count * slice_count;
+        const float near_plane = std::max(camera.near_plane, 1e-3f);
+        const float far_plane = std::max(camera.far_plane, near_plane * 1.001f);
+        const float log_ratio = std::log2(far_plane / near_plane);
+
+        simd_ = config_.use_simd && isSimdAvailable();
+        tan_y_ = std::tan(camera.fov_y * 0.5f);
+        tan_x_ = tan_y_ * camera.aspect;
+
+        out.clear();
+        out.params.tile_scale_x = static_cast<float>(config_.tiles_x) / static_cast<float>(std::max(camera.viewport_width, 1u));
+        out.params.tile_scale_y = static_cast<float>(config_.tiles_y) / static_cast<float>(std::max(camera.viewport_height, 1u));
+        out.params.slice_scale = static_cast<float>(slice_count) / log_ratio;
+        out.params.slice_bias = -static_cast<float>(slice_count) * std::log2(near_plane) / log_ratio;
+        out.params.tiles_x = config_.tiles_x;
+        out.params.tiles_y = config_.tiles_y;
+        out.params.slices = slice_count;
+        out.params.light_count = static_cast<uint32_t>(lights.size());
+        out.stats.lights = static_cast<uint32_t>(lights.size());
+        out.stats.clusters = cluster_count;
+
+        slice_depths_.resize(slice_count + 1);
+        for (uint32_t slice = 0; slice <= slice_count; ++slice) {
+            slice_depths_[slice] = near_plane * std::exp2(log_ratio * static_cast<float>(slice) / static_cast<float>(slice_count));
+        }
+        slice_depths_[slice_count] = far_plane;
+
+        // ---- Move lights to view space (SoA)
+        view_lights_.resize(lights.size());
+        const auto& m = camera.view;
+        auto transform = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const float* p = lights[i].position;
+                view_lights_.x[i] = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+                view_lights_.y[i] = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+                view_lights_.z[i] = m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14];
+                view_lights_.r[i] = lights[i].radius;
+                view_lights_.index[i] = static_cast<uint32_t>(i);
+            }
+            };
+        if (jobs && lights.size() > config_.transform_batch_size) {
+            jobs->parallelFor(lights.size(), config_.transform_batch_size, transform);
+        }
+        else {
+            transform(0, lights.size());
+        }
+
+        // ---- Bucket lights by the depth slices their sphere spans (counting sort)
+        auto sliceRange = [&](size_t i, uint32_t& first, uint32_t& last) -> bool {
+            const float depth = -view_lights_.z[i];
+            const float radius = view_lights_.r[i];
+            if (radius <= 0.0f || depth + radius <= near_plane || depth - radius >= far_plane) return false;
+
+            const float min_depth = std::max(depth - radius, near_plane);
+            const float max_depth = std::min(depth + radius, far_plane);
+            auto sliceOf = [&](float d) {
+                const float s = std::floor(std::log2(d) * out.params.slice_scale + out.params.slice_bias);
+                return static_cast<uint32_t>(std::clamp(s, 0.0f, static_cast<float>(slice_count - 1)));
+            };
+
+            // The log may round across a boundary; settle against the exact boundaries the AABBs use
+            first = sliceOf(min_depth);
+            last = sliceOf(max_depth);
+            while (first > 0 && slice_depths_[first] > min_depth) --first;
+            while (last + 1 < slice_count && slice_depths_[last + 1] < max_depth) ++last;
+            return true;
+            };
+
+        slice_offsets_.assign(slice_count + 1, 0);
+        for (size_t i = 0; i < lights.size(); ++i) {
+            uint32_t first, last;
+            if (!sliceRange(i, first, last)) continue;
+            ++out.stats.lights_in_view;
+            for (uint32_t slice = first; slice <= last; ++slice) ++slice_offsets_[slice + 1];
+        }
+        for (uint32_t slice = 0; slice < slice_count; ++slice) {
+            slice_offsets_[slice + 1] += slice_offsets_[slice];
+        }
+        slice_lights_.resize(slice_offsets_[slice_count]);
+        {
+            std::vector<uint32_t> cursor(slice_offsets_.begin(), slice_offsets_.end() - 1);
+            for (size_t i = 0; i < lights.size(); ++i) {
+                uint32_t first, last;
+                if (!sliceRange(i, first, last)) continue;
+                for (uint32_t slice = first; slice <= last; ++slice) slice_lights_[cursor[slice]++] = static_cast<uint32_t>(i);
+            }
+        }
+
+        // ---- One job per slice
+        slices_.resize(slice_count);
+        auto run = [&](size_t begin, size_t end) {
+            for (size_t slice = begin; slice < end; ++slice) {
+                buildSlice(static_cast<uint32_t>(slice), slices_[slice]);
+            }
+            };
+        if (jobs) {
+            jobs->parallelFor(slice_count, 1, run);
+        }
+        else {
+            run(0, slice_count);
+        }
+
+        // ---- Stitch slices into one compact index list
+        size_t total = 0;
+        for (const SliceScratch& scratch : slices_) total += scratch.indices.size();
+        out.light_indices.resize(total);
+        out.ranges.resize(cluster_count);
+
+        uint32_t offset = 0;
+        for (uint32_t slice = 0; slice < slice_count; ++slice) {
+            const SliceScratch& scratch = slices_[slice];
+            std::copy(scratch.indices.begin(), scratch.indices.end(), out.light_indices.begin() + offset);
+
+            for (uint32_t tile = 0; tile < tile_count; ++tile) {
+                const uint32_t count = scratch.counts[tile];
+                out.ranges[slice * tile_count + tile] = { offset, count };
+                offset += count;
+
+                if (count > 0) ++out.stats.clusters_occupied;
+                out.stats.max_cluster_lights = std::max(out.stats.max_cluster_lights, count);
+            }
+            out.stats.clusters_overflowed += scratch.overflowed;
+        }
+        out.stats.light_indices = static_cast<uint32_t>(total);
+    }
+
+    void LightClusterBuilder::buildSlice(uint32_t slice, SliceScratch& scratch) const {
+        const uint32_t tiles_x = config_.tiles_x;
+        const uint32_t tiles_y = config_.tiles_y;
+        const float near_depth = slice_depths_[slice];
+        const float far_depth = slice_depths_[slice + 1];
+
+        scratch.indices.clear();
+        scratch.counts.assign(static_cast<size_t>(tiles_x) * tiles_y, 0);
+        scratch.overflowed = 0;
+
+        scratch.candidates.clear();
+        for (uint32_t i = slice_offsets_[slice]; i < slice_offsets_[slice + 1]; ++i) {
+            const uint32_t light = slice_lights_[i];
+            scratch.candidates.push(view_lights_.x[light], view_lights_.y[light], view_lights_.z[light], view_lights_.r[light], light);
+        }
+        if (scratch.candidates.count == 0) return;
+        scratch.candidates.pad();
+
+        // Extent of an NDC span [a, b] over the slice's depth range
+        auto extent = [&](float a, float b, float& lo, float& hi) {
+            lo = a * (a < 0.0f ? far_depth : near_depth);
+            hi = b * (b > 0.0f ? far_depth : near_depth);
+            };
+
+        Aabb box{};
+        box.min_z = -far_depth;
+        box.max_z = -near_depth;
+
+        for (uint32_t row = 0; row < tiles_y; ++row) {
+            // Row 0 is the top of the screen (+Y in view space)
+            const float top = tan_y_ * (1.0f - 2.0f * static_cast<float>(row) / static_cast<float>(tiles_y));
+            const float bottom = tan_y_ * (1.0f - 2.0f * static_cast<float>(row + 1) / static_cast<float>(tiles_y));
+            extent(bottom, top, box.min_y, box.max_y);
+            extent(-tan_x_, tan_x_, box.min_x, box.max_x);
+
+            const LightSoA& candidates = scratch.candidates;
+            LightSoA& row_lights = scratch.row;
+            row_lights.clear();
+            forEachOverlap(candidates.x, candidates.y, candidates.z, candidates.r, box, simd_, [&](size_t lane) {
+                row_lights.push(candidates.x[lane], candidates.y[lane], candidates.z[lane], candidates.r[lane], candidates.index[lane]);
+                });
+            if (row_lights.count == 0) continue;
+            row_lights.pad();
+
+            for (uint32_t column = 0; column < tiles_x; ++column) {
+                const float left = tan_x_ * (-1.0f + 2.0f * static_cast<float>(column) / static_cast<float>(tiles_x));
+                const float right = tan_x_ * (-1.0f + 2.0f * static_cast<float>(column + 1) / static_cast<float>(tiles_x));
+                extent(left, right, box.min_x, box.max_x);
+
+                uint32_t& count = scratch.counts[row * tiles_x + column];
+                bool overflowed = false;
+                forEachOverlap(row_lights.x, row_lights.y, row_lights.z, row_lights.r, box, simd_, [&](size_t lane) {
+                    if (count >= config_.max_lights_per_cluster) {
+                        overflowed = true;
+                        return;
+                    }
+                    scratch.indices.push_back(row_lights.index[lane]);
+                    ++count;
+                    });
+                if (overflowed) ++scratch.overflowed;
+            }
+        }
+    }
+
+    // ==========================================
+    // BENCHMARK
+    // ==========================================
+
+    std::vector<ClusterBenchmarkResult> LightClusterBuilder::benchmarkBuild(JobSystem* jobs, std::span<const uint32_t> light_counts,
+        uint32_t iterations) {
+        using Clock = std::chrono::steady_clock;
+
+        const ClusterCamera camera;
+        std::vector<ClusterBenchmarkResult> results;
+        results.reserve(light_counts.size());
+
+        for (const uint32_t light_count : light_counts) {
+            // Torch-sized lights scattered around the camera through a slab of terrain
+            std::mt19937 rng(1337);
+            std::uniform_real_distribution<float> horizontal(-camera.far_plane, camera.far_plane);
+            std::uniform_real_distribution<float> height(-32.0f, 96.0f);
+            std::uniform_real_distribution<float> radius(4.0f, 10.0f);
+
+            std::vector<GpuPointLight> lights(light_count);
+            for (GpuPointLight& light : lights) {
+                light.position[0] = horizontal(rng);
+                light.position[1] = height(rng);
+                light.position[2] = horizontal(rng);
+                light.radius = radius(rng);
+                light.color[0] = light.color[1] = light.color[2] = 1.0f;
+                light.intensity = 1.0f;
+            }
+
+            ClusterBenchmarkResult result;
+            result.lights = light_count;
+            result.iterations = std::max(iterations, 1u);
+
+            auto run = [&](bool simd) -> std::chrono::nanoseconds {
+                ClusterConfig config;
+                config.use_simd = simd;
+                LightClusterBuilder builder(config);
+                ClusterLightGrid grid;
+                builder.build(camera, lights, jobs, grid);  // Warm up scratch allocations
+
+                const auto start = Clock::now();
+                for (uint32_t iteration = 0; iteration < result.iterations; ++iteration) {
+                    builder.build(camera, lights, jobs, grid);
+                }
+                result.light_indices = grid.stats.light_indices;
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start) / result.iterations;
+                };
+
+            result.avg_scalar = run(false);
+            result.avg_simd = isSimdAvailable() ? run(true) : result.avg_scalar;
+            if (result.avg_simd.count() > 0) {
+                result.speedup = static_cast<double>(result.avg_scalar.count()) / static_cast<double>(result.avg_simd.count());
+            }
+            results.push_back(result);
+        }
+        return results;
+    }
+
+} // namespace AshCore
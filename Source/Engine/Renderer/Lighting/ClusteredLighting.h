@@ -0,0 +1,175 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // GPU-FACING LAYOUTS
+    // ==========================================
+
+    // World-space point light as stored in the light SSBO
+    struct alignas(16) GpuPointLight {
+        float position[3];
+        float radius;          // Influence ends here
+        float color[3];
+        float intensity;
+    };
+    static_assert(sizeof(GpuPointLight) == 32, "std430 layout expects 32 bytes");
+
+    // Slice of ClusterLightGrid::light_indices belonging to one cluster
+    struct ClusterRange {
+        uint32_t offset;
+        uint32_t count;
+    };
+    static_assert(sizeof(ClusterRange) == 8, "std430 layout expects 8 bytes");
+
+    /**
+     * Shader lookup for a fragment at pixel (px, py) with view depth d:
+     *   tile  = uvec2(px * tile_scale_x, py * tile_scale_y)
+     *   slice = min(uint(max(log2(d) * slice_scale + slice_bias, 0)), slices - 1)
+     *   cluster = (slice * tiles_y + tile.y) * tiles_x + tile.x
+     * Tile row 0 is the top of the screen. The clamp matters: at or beyond
+     * the far plane the formula yields slices or more, which would index
+     * past the grid; those fragments use the last slice instead.
+     */
+    struct alignas(16) ClusterGridParams {
+        float tile_scale_x;
+        float tile_scale_y;
+        float slice_scale;
+        float slice_bias;
+        uint32_t tiles_x;
+        uint32_t tiles_y;
+        uint32_t slices;
+        uint32_t light_count;
+    };
+    static_assert(sizeof(ClusterGridParams) == 32, "std430 layout expects 32 bytes");
+
+    // ==========================================
+    // CAMERA / OUTPUT
+    // ==========================================
+
+    // Right-handed view space looking down -Z (glm::lookAt convention)
+    struct ClusterCamera {
+        std::array<float, 16> view{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };  // Column-major world -> view
+        float fov_y = 1.2f;         // Radians
+        float aspect = 16.0f / 9.0f;
+        float near_plane = 0.1f;
+        float far_plane = 512.0f;
+        uint32_t viewport_width = 1920;
+        uint32_t viewport_height = 1080;
+    };
+
+    struct ClusterLightStats {
+        uint32_t lights = 0;
+        uint32_t lights_in_view = 0;        // Touched at least one depth slice
+        uint32_t clusters = 0;
+        uint32_t clusters_occupied = 0;
+        uint32_t light_indices = 0;
+        uint32_t max_cluster_lights = 0;
+        uint32_t clusters_overflowed = 0;   // Hit max_lights_per_cluster
+    };
+
+    // Ready to upload: ranges and light_indices go to SSBOs, params to a UBO
+    struct ClusterLightGrid {
+        ClusterGridParams params{};
+        std::vector<ClusterRange> ranges;         // One per cluster
+        std::vector<uint32_t> light_indices;      // Into the caller's light array
+        ClusterLightStats stats;
+
+        void clear() noexcept;
+        [[nodiscard]] size_t getRangeBytes() const noexcept { return ranges.size() * sizeof(ClusterRange); }
+        [[nodiscard]] size_t getIndexBytes() const noexcept { return light_indices.size() * sizeof(uint32_t); }
+    };
+
+    // ==========================================
+    // LIGHT CLUSTER BUILDER
+    // ==========================================
+
+    struct ClusterConfig {
+        uint32_t tiles_x = 16;
+        uint32_t tiles_y = 9;
+        uint32_t slices = 24;                    // Exponential in depth between near and far
+        uint32_t max_lights_per_cluster = 256;
+        size_t transform_batch_size = 4096;      // Lights per job when moving to view space
+        bool use_simd = true;                    // AVX2 path when compiled in
+    };
+
+    struct ClusterBenchmarkResult {
+        uint32_t lights = 0;
+        uint32_t iterations = 0;
+        uint32_t light_indices = 0;
+        std::chrono::nanoseconds avg_scalar{};
+        std::chrono::nanoseconds avg_simd{};
+        double speedup = 0.0;
+    };
+
+    /**
+     * @brief Assigns point lights to a view-space froxel grid
+     *
+     * Lights are bucketed into depth slices first; each slice is one job
+     * that narrows the candidates per tile row and then per tile with
+     * sphere-vs-AABB tests, eight lights at a time. Output order depends
+     * only on the input, never on thread count.
+     */
+    class LightClusterBuilder {
+    public:
+        explicit LightClusterBuilder(const ClusterConfig& config = {});
+
+        // jobs may be null for single-threaded assignment
+        void build(const ClusterCamera& camera, std::span<const GpuPointLight> lights, JobSystem* jobs, ClusterLightGrid& out);
+
+        [[nodiscard]] const ClusterConfig& getConfig() const noexcept { return config_; }
+        [[nodiscard]] static bool isSimdAvailable() noexcept;
+
+        // Random lights in front of a default camera, one result per count
+        [[nodiscard]] static std::vector<ClusterBenchmarkResult> benchmarkBuild(JobSystem* jobs,
+            std::span<const uint32_t> light_counts = DEFAULT_BENCHMARK_COUNTS, uint32_t iterations = 20);
+
+        static constexpr std::array<uint32_t, 4> DEFAULT_BENCHMARK_COUNTS = { 1024, 4096, 16384, 65536 };
+
+    private:
+        // View-space spheres, padded to a multiple of 8 with lanes that never overlap
+        struct LightSoA {
+            std::vector<float> x, y, z, r;
+            std::vector<uint32_t> index;
+            size_t count = 0;
+
+            void clear() noexcept;
+            void resize(size_t light_count);  // Lanes past light_count become padding
+            void push(float px, float py, float pz, float pr, uint32_t light);
+            void pad();
+        };
+
+        struct SliceScratch {
+            LightSoA candidates;
+            LightSoA row;
+            std::vector<uint32_t> indices;  // Tile order, then light order
+            std::vector<uint32_t> counts;   // Per tile
+            uint32_t overflowed = 0;
+        };
+
+        void buildSlice(uint32_t slice, SliceScratch& scratch) const;
+
+    private:
+        ClusterConfig config_;
+
+        // Per-build state, read by slice jobs
+        LightSoA view_lights_;
+        std::vector<uint32_t> slice_offsets_;   // Counting sort of lights by slice
+        std::vector<uint32_t> slice_lights_;
+        std::vector<SliceScratch> slices_;
+        std::vector<float> slice_depths_;       // slices + 1 boundaries
+        float tan_x_ = 0.0f;
+        float tan_y_ = 0.0f;
+        bool simd_ = false;
+    };
+
+} // namespace AshCore
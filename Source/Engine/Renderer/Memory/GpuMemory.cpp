@@ -0,0 +1,515 @@
+#include "ashbornpch.h"
+
+#include "GpuMemory.h"
+
+#include <algorithm>
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint64_t MB = 1024 * 1024;
+
+        uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept {
+            return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+        }
+    }
+
+    uint64_t GpuMemoryStats::getDeviceLocalUsed() const noexcept {
+        uint64_t used = 0;
+        for (const auto& heap : heaps) {
+            if (heap.device_local) used += heap.allocated;
+        }
+        return used;
+    }
+
+    uint64_t GpuMemoryStats::getDeviceLocalBudget() const noexcept {
+        uint64_t budget = 0;
+        for (const auto& heap : heaps) {
+            if (heap.device_local) budget += heap.budget;
+        }
+        return budget;
+    }
+
+    // ==========================================
+    // CONSTRUCTOR / DESTRUCTOR
+    // ==========================================
+
+    GpuMemoryAllocator::GpuMemoryAllocator(IGpuMemoryBackend& backend, const RendererConfig& renderer_config,
+        const GpuMemoryConfig& config)
+        : backend_(backend)
+        , config_(config)
+        , vram_budget_override_(renderer_config.vram_budget) {
+
+        const size_t heap_count = backend_.getHeaps().size();
+        heap_budgets_.assign(heap_count, 0);
+        heap_allocated_.assign(heap_count, 0);
+        refreshBudgets();
+
+        print_i("GPU memory allocator created", LogContext{
+            {"heaps", heap_count},
+            {"memory_types", backend_.getMemoryTypes().size()},
+            {"vram_budget_mb", getStats().getDeviceLocalBudget() / MB}
+            });
+    }
+
+    GpuMemoryAllocator::~GpuMemoryAllocator() {
+        std::lock_guard lock(mutex_);
+
+        uint32_t leaked = 0;
+        for (uint32_t i = 0; i < blocks_.size(); ++i) {
+            if (!blocks_[i].in_use) continue;
+            if (!blocks_[i].linear) leaked += blocks_[i].allocation_count;
+            destroyBlock(i);
+        }
+
+        if (leaked > 0) {
+            print_w("GPU allocations still alive at allocator destruction", LogContext{ {"count", leaked} });
+        }
+    }
+
+    // ==========================================
+    // ALLOCATION
+    // ==========================================
+
+    std::expected<GpuAllocation, RendererError> GpuMemoryAllocator::allocate(
+        const GpuMemoryRequirements& requirements, const GpuAllocationDesc& desc) {
+
+        if (requirements.size == 0) {
+            return std::unexpected(RendererError::Unknown);
+        }
+
+        std::unique_lock lock(mutex_);
+
+        // Linear pools ignore memory_type_bits: the pool was created for its usage
+        if (desc.linear_pool != INVALID_LINEAR_POOL) {
+            if (desc.linear_pool >= blocks_.size() || !blocks_[desc.linear_pool].linear) {
+                return std::unexpected(RendererError::Unknown);
+            }
+
+            Block& pool = blocks_[desc.linear_pool];
+            const uint64_t offset = alignUp(pool.linear_head, requirements.alignment);
+            if (offset + requirements.size > pool.size) {
+                failed_allocations_++;
+                return std::unexpected(RendererError::OutOfGPUMemory);
+            }
+
+            pool.linear_head = offset + requirements.size;
+            pool.used = pool.linear_head;
+            pool.allocation_count++;
+            return makeAllocation(desc.linear_pool, offset, requirements.size, {});
+        }
+
+        const auto memory_type = selectMemoryType(requirements.memory_type_bits, desc.usage);
+        if (!memory_type) {
+            print_e("No memory type satisfies allocation", LogContext{
+                {"type_bits", requirements.memory_type_bits},
+                {"usage", static_cast<int>(desc.usage)}
+                });
+            failed_allocations_++;
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+
+        const uint64_t block_size = getBlockSize(getHeapIndex(*memory_type));
+        const bool dedicated = desc.dedicated ||
+            requirements.size > static_cast<uint64_t>(static_cast<double>(block_size) * config_.dedicated_threshold);
+
+        if (dedicated) {
+            auto block = createBlock(*memory_type, requirements.size, true, false, desc.priority, lock);
+            if (!block) {
+                failed_allocations_++;
+                return std::unexpected(block.error());
+            }
+
+            Block& owner = blocks_[*block];
+            owner.used = requirements.size;
+            owner.allocation_count = 1;
+            return makeAllocation(*block, 0, requirements.size, {});
+        }
+
+        // Another thread may grab the fresh block while the lock is dropped for eviction
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (auto allocation = allocateFromBlocks(*memory_type, requirements)) {
+                return *allocation;
+            }
+
+            auto block = createBlock(*memory_type, block_size, false, false, desc.priority, lock);
+            if (!block) {
+                failed_allocations_++;
+                return std::unexpected(block.error());
+            }
+        }
+
+        failed_allocations_++;
+        return std::unexpected(RendererError::OutOfGPUMemory);
+    }
+
+    void GpuMemoryAllocator::free(const GpuAllocation& allocation) {
+        if (!allocation.isValid()) return;
+
+        std::lock_guard lock(mutex_);
+
+        if (allocation.block >= blocks_.size() || !blocks_[allocation.block].in_use) {
+            print_e("GPU free of unknown allocation");
+            return;
+        }
+
+        Block& block = blocks_[allocation.block];
+
+        // Linear pool memory is only reclaimed by resetLinearPool; frees from
+        // before the last reset have nothing left to release
+        if (block.linear) {
+            if (allocation.generation == block.generation && block.allocation_count > 0) {
+                block.allocation_count--;
+            }
+            return;
+        }
+
+        const uint32_t node = allocation.sub_allocation.node;
+        const bool live = block.dedicated
+            ? allocation.generation == block.generation
+            : node < block.live_generations.size() && block.live_generations[node] == allocation.generation;
+        if (!live) {
+            print_e("GPU free of stale or already freed allocation", LogContext{
+                {"block", allocation.block},
+                {"offset", allocation.offset},
+                {"size", allocation.size}
+                });
+            return;
+        }
+
+        if (block.dedicated) {
+            destroyBlock(allocation.block);
+            return;
+        }
+
+        block.live_generations[node] = 0;
+        block.tlsf.free(allocation.sub_allocation);
+        block.used -= allocation.size;
+        block.allocation_count--;
+
+        if (block.allocation_count > 0) return;
+
+        // Keep a few empty blocks around to absorb allocate/free churn
+        uint32_t empty_blocks = 0;
+        for (const Block& other : blocks_) {
+            if (other.in_use && !other.dedicated && !other.linear &&
+                other.memory_type == block.memory_type && other.allocation_count == 0) {
+                empty_blocks++;
+            }
+        }
+        if (empty_blocks > config_.empty_blocks_to_keep) {
+            destroyBlock(allocation.block);
+        }
+    }
+
+    // ==========================================
+    // LINEAR POOLS
+    // ==========================================
+
+    std::expected<GpuLinearPoolId, RendererError> GpuMemoryAllocator::createLinearPool(GpuMemoryUsage usage, uint64_t size) {
+        std::unique_lock lock(mutex_);
+
+        const auto memory_type = selectMemoryType(~0u, usage);
+        if (!memory_type) {
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+
+        auto block = createBlock(*memory_type, size, false, true, GpuAllocationPriority::Critical, lock);
+        if (!block) {
+            return std::unexpected(block.error());
+        }
+        return *block;
+    }
+
+    void GpuMemoryAllocator::resetLinearPool(GpuLinearPoolId pool) {
+        std::lock_guard lock(mutex_);
+        if (pool >= blocks_.size() || !blocks_[pool].linear) return;
+
+        blocks_[pool].linear_head = 0;
+        blocks_[pool].used = 0;
+        blocks_[pool].allocation_count = 0;
+        blocks_[pool].generation = nextGeneration();
+    }
+
+    void GpuMemoryAllocator::destroyLinearPool(GpuLinearPoolId pool) {
+        std::lock_guard lock(mutex_);
+        if (pool >= blocks_.size() || !blocks_[pool].linear) return;
+        destroyBlock(pool);
+    }
+
+    // ==========================================
+    // BUDGET
+    // ==========================================
+
+    void GpuMemoryAllocator::addEvictionCallback(GpuEvictionCallback callback) {
+        std::lock_guard lock(mutex_);
+        eviction_callbacks_.push_back(std::move(callback));
+    }
+
+    void GpuMemoryAllocator::refreshBudgets() {
+        const auto heaps = backend_.getHeaps();
+
+        std::lock_guard lock(mutex_);
+        for (uint32_t i = 0; i < heaps.size(); ++i) {
+            uint64_t budget = static_cast<uint64_t>(static_cast<double>(heaps[i].size) * config_.auto_budget_fraction);
+
+            // The extension's budget already accounts for other processes
+            if (auto reported = backend_.queryBudget(i)) {
+                budget = reported->budget;
+            }
+
+            if (heaps[i].device_local && vram_budget_override_ > 0) {
+                budget = std::min<uint64_t>(vram_budget_override_, heaps[i].size);
+            }
+
+            heap_budgets_[i] = budget;
+        }
+    }
+
+    bool GpuMemoryAllocator::reserveBudget(uint32_t heap_index, uint64_t size, std::unique_lock<std::mutex>& lock) {
+        auto fits = [&]() { return heap_allocated_[heap_index] + size <= heap_budgets_[heap_index]; };
+
+        // Cached empty blocks are the cheapest thing to give back
+        auto release_empty_blocks = [&]() {
+            for (uint32_t i = 0; i < blocks_.size() && !fits(); ++i) {
+                const Block& block = blocks_[i];
+                if (block.in_use && !block.dedicated && !block.linear && block.allocation_count == 0 &&
+                    getHeapIndex(block.memory_type) == heap_index) {
+                    destroyBlock(i);
+                }
+            }
+            return fits();
+        };
+
+        if (fits() || release_empty_blocks()) return true;
+
+        // Callbacks free through this allocator, so they must run unlocked
+        const auto callbacks = eviction_callbacks_;
+        for (const auto& callback : callbacks) {
+            const uint64_t needed = heap_allocated_[heap_index] + size - heap_budgets_[heap_index];
+
+            lock.unlock();
+            const uint64_t released = callback(heap_index, needed);
+            lock.lock();
+
+            evicted_bytes_ += released;
+            if (fits() || release_empty_blocks()) return true;
+        }
+
+        print_w("GPU heap over budget", LogContext{
+            {"heap", heap_index},
+            {"allocated_mb", heap_allocated_[heap_index] / MB},
+            {"budget_mb", heap_budgets_[heap_index] / MB},
+            {"request_mb", size / MB}
+            });
+        return false;
+    }
+
+    // ==========================================
+    // STATISTICS
+    // ==========================================
+
+    GpuMemoryStats GpuMemoryAllocator::getStats() const {
+        const auto heaps = backend_.getHeaps();
+
+        std::lock_guard lock(mutex_);
+
+        GpuMemoryStats stats;
+        stats.heaps.resize(heaps.size());
+        for (uint32_t i = 0; i < heaps.size(); ++i) {
+            stats.heaps[i].size = heaps[i].size;
+            stats.heaps[i].device_local = heaps[i].device_local;
+            stats.heaps[i].budget = heap_budgets_[i];
+            stats.heaps[i].allocated = heap_allocated_[i];
+        }
+
+        for (const Block& block : blocks_) {
+            if (!block.in_use) continue;
+
+            GpuHeapStats& heap = stats.heaps[getHeapIndex(block.memory_type)];
+            heap.used += block.used;
+            heap.allocation_count += block.allocation_count;
+            if (block.dedicated) {
+                heap.dedicated_count++;
+            }
+            else {
+                heap.block_count++;
+            }
+        }
+
+        stats.device_allocations = device_allocations_;
+        stats.evicted_bytes = evicted_bytes_;
+        stats.failed_allocations = failed_allocations_;
+        return stats;
+    }
+
+    size_t GpuMemoryAllocator::getVramUsedMB() const {
+        return static_cast<size_t>(getStats().getDeviceLocalUsed() / MB);
+    }
+
+    size_t GpuMemoryAllocator::getVramAvailableMB() const {
+        const auto stats = getStats();
+        const uint64_t used = stats.getDeviceLocalUsed();
+        const uint64_t budget = stats.getDeviceLocalBudget();
+        return static_cast<size_t>((budget > used ? budget - used : 0) / MB);
+    }
+
+    // ==========================================
+    // INTERNAL
+    // ==========================================
+
+    std::optional<uint32_t> GpuMemoryAllocator::selectMemoryType(uint32_t type_bits, GpuMemoryUsage usage) const {
+        const auto types = backend_.getMemoryTypes();
+
+        // Lower score is better; UINT32_MAX means unusable
+        auto score = [usage](const GpuMemoryTypeInfo& type) -> uint32_t {
+            switch (usage) {
+            case GpuMemoryUsage::GpuOnly:
+                if (!type.device_local) return 100;  // Works, but slow
+                return type.host_visible ? 1 : 0;    // Keep ReBAR for uploads
+            case GpuMemoryUsage::Upload:
+                if (!type.host_visible || !type.host_coherent) return UINT32_MAX;
+                return (type.device_local ? 1 : 0) + (type.host_cached ? 2 : 0);
+            case GpuMemoryUsage::Readback:
+                if (!type.host_visible) return UINT32_MAX;
+                return (type.host_cached ? 0 : 2) + (type.device_local ? 1 : 0);
+            }
+            return UINT32_MAX;
+        };
+
+        std::optional<uint32_t> best;
+        uint32_t best_score = UINT32_MAX;
+        for (uint32_t i = 0; i < types.size(); ++i) {
+            if (!(type_bits & (1u << i))) continue;
+
+            const uint32_t s = score(types[i]);
+            if (s < best_score) {
+                best_score = s;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    uint64_t GpuMemoryAllocator::getBlockSize(uint32_t heap_index) const {
+        const uint64_t heap_size = backend_.getHeaps()[heap_index].size;
+        if (heap_size < config_.small_heap_threshold) {
+            return std::max<uint64_t>(alignUp(heap_size / 8, 32), 1);
+        }
+        return config_.preferred_block_size;
+    }
+
+    uint32_t GpuMemoryAllocator::getHeapIndex(uint32_t memory_type) const {
+        return backend_.getMemoryTypes()[memory_type].heap_index;
+    }
+
+    std::expected<uint32_t, RendererError> GpuMemoryAllocator::createBlock(uint32_t memory_type, uint64_t size,
+        bool dedicated, bool linear, GpuAllocationPriority priority, std::unique_lock<std::mutex>& lock) {
+
+        if (device_allocations_ >= backend_.getMaxAllocationCount()) {
+            print_e("Device allocation count limit reached", LogContext{ {"limit", backend_.getMaxAllocationCount()} });
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+
+        const uint32_t heap_index = getHeapIndex(memory_type);
+        if (priority != GpuAllocationPriority::Critical && !reserveBudget(heap_index, size, lock)) {
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+
+        auto memory = backend_.allocateMemory(memory_type, size);
+        if (!memory) {
+            return std::unexpected(memory.error());
+        }
+
+        uint32_t index = 0;
+        if (!free_block_slots_.empty()) {
+            index = free_block_slots_.back();
+            free_block_slots_.pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(blocks_.size());
+            blocks_.emplace_back();
+        }
+
+        Block& block = blocks_[index];
+        block.memory = *memory;
+        block.size = size;
+        block.memory_type = memory_type;
+        block.dedicated = dedicated;
+        block.linear = linear;
+        block.in_use = true;
+        block.generation = nextGeneration();
+        block.used = 0;
+        block.allocation_count = 0;
+        block.linear_head = 0;
+        block.tlsf.reset(dedicated || linear ? 0 : size);
+        block.mapped = backend_.getMemoryTypes()[memory_type].host_visible
+            ? static_cast<uint8_t*>(backend_.mapMemory(*memory))
+            : nullptr;
+
+        heap_allocated_[heap_index] += size;
+        device_allocations_++;
+        return index;
+    }
+
+    void GpuMemoryAllocator::destroyBlock(uint32_t index) {
+        Block& block = blocks_[index];
+        backend_.freeMemory(block.memory);
+
+        heap_allocated_[getHeapIndex(block.memory_type)] -= block.size;
+        device_allocations_--;
+
+        block.memory = NULL_DEVICE_MEMORY;
+        block.in_use = false;
+        block.mapped = nullptr;
+        block.tlsf.reset(0);
+        block.live_generations.clear();
+        free_block_slots_.push_back(index);
+    }
+
+    std::optional<GpuAllocation> GpuMemoryAllocator::allocateFromBlocks(uint32_t memory_type,
+        const GpuMemoryRequirements& requirements) {
+
+        for (uint32_t i = 0; i < blocks_.size(); ++i) {
+            Block& block = blocks_[i];
+            if (!block.in_use || block.dedicated || block.linear || block.memory_type != memory_type) continue;
+            if (block.size - block.used < requirements.size) continue;
+
+            if (auto sub = block.tlsf.allocate(requirements.size, requirements.alignment)) {
+                block.used += requirements.size;
+                block.allocation_count++;
+
+                GpuAllocation allocation = makeAllocation(i, sub->offset, requirements.size, *sub);
+                allocation.generation = nextGeneration();
+                if (sub->node >= block.live_generations.size()) {
+                    block.live_generations.resize(sub->node + 1, 0);
+                }
+                block.live_generations[sub->node] = allocation.generation;
+                return allocation;
+            }
+        }
+        return std::nullopt;
+    }
+
+    GpuAllocation GpuMemoryAllocator::makeAllocation(uint32_t block, uint64_t offset, uint64_t size, const TlsfAllocation& sub) {
+        const Block& owner = blocks_[block];
+
+        GpuAllocation allocation;
+        allocation.memory = owner.memory;
+        allocation.offset = offset;
+        allocation.size = size;
+        allocation.mapped = owner.mapped ? owner.mapped + offset : nullptr;
+        allocation.memory_type = owner.memory_type;
+        allocation.block = block;
+        allocation.generation = owner.generation;
+        allocation.sub_allocation = sub;
+        return allocation;
+    }
+
+    uint32_t GpuMemoryAllocator::nextGeneration() noexcept {
+        // 0 marks a free node
+        if (++generation_counter_ == 0) ++generation_counter_;
+        return generation_counter_;
+    }
+
+} // namespace AshCore
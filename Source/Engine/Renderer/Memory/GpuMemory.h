@@ -0,0 +1,237 @@
+#pragma once
+
+#include "Memory/TlsfAllocator.h"
+#include "Engine/AshbornEngine.h"
+
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // DEVICE DESCRIPTION
+    // ==========================================
+
+    // Opaque VkDeviceMemory (or fake backend id)
+    using GpuDeviceMemory = uint64_t;
+    inline constexpr GpuDeviceMemory NULL_DEVICE_MEMORY = 0;
+
+    struct GpuHeapInfo {
+        uint64_t size = 0;
+        bool device_local = false;
+    };
+
+    struct GpuMemoryTypeInfo {
+        uint32_t heap_index = 0;
+        bool device_local = false;
+        bool host_visible = false;
+        bool host_coherent = false;
+        bool host_cached = false;
+    };
+
+    // VK_EXT_memory_budget values for one heap
+    struct GpuHeapBudget {
+        uint64_t usage = 0;
+        uint64_t budget = 0;
+    };
+
+    // ==========================================
+    // BACKEND INTERFACE
+    // ==========================================
+
+    // Thin wrapper over vkAllocateMemory & co. so the allocator runs without a device
+    class IGpuMemoryBackend {
+    public:
+        virtual ~IGpuMemoryBackend() = default;
+
+        [[nodiscard]] virtual std::span<const GpuHeapInfo> getHeaps() const = 0;
+        [[nodiscard]] virtual std::span<const GpuMemoryTypeInfo> getMemoryTypes() const = 0;
+        [[nodiscard]] virtual uint32_t getMaxAllocationCount() const = 0;  // maxMemoryAllocationCount
+
+        [[nodiscard]] virtual std::expected<GpuDeviceMemory, RendererError> allocateMemory(uint32_t memory_type, uint64_t size) = 0;
+        virtual void freeMemory(GpuDeviceMemory memory) = 0;
+        [[nodiscard]] virtual void* mapMemory(GpuDeviceMemory memory) = 0;  // Whole range, persistent
+
+        [[nodiscard]] virtual std::optional<GpuHeapBudget> queryBudget(uint32_t heap_index) const = 0;
+    };
+
+    // ==========================================
+    // ALLOCATION REQUESTS
+    // ==========================================
+
+    enum class GpuMemoryUsage : uint8_t {
+        GpuOnly,    // Device local, not mappable
+        Upload,     // Host visible, write-combined staging / dynamic data
+        Readback    // Host visible + cached
+    };
+
+    enum class GpuAllocationPriority : uint8_t {
+        Normal,     // Subject to the budget, may trigger eviction
+        Critical    // Swapchain, render targets: never refused because of the budget
+    };
+
+    // vkGet*MemoryRequirements output
+    struct GpuMemoryRequirements {
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+        uint32_t memory_type_bits = ~0u;
+    };
+
+    using GpuLinearPoolId = uint32_t;
+    inline constexpr GpuLinearPoolId INVALID_LINEAR_POOL = ~0u;
+
+    struct GpuAllocationDesc {
+        GpuMemoryUsage usage = GpuMemoryUsage::GpuOnly;
+        GpuAllocationPriority priority = GpuAllocationPriority::Normal;
+        bool dedicated = false;                         // Force a dedicated VkDeviceMemory
+        GpuLinearPoolId linear_pool = INVALID_LINEAR_POOL;  // Bump-allocate from a linear pool
+    };
+
+    struct GpuAllocation {
+        GpuDeviceMemory memory = NULL_DEVICE_MEMORY;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        void* mapped = nullptr;     // Host pointer at `offset` for host-visible memory
+        uint32_t memory_type = 0;
+
+        // Internal bookkeeping
+        uint32_t block = ~0u;
+        uint32_t generation = 0;    // Catches stale and double frees
+        TlsfAllocation sub_allocation;
+
+        [[nodiscard]] bool isValid() const noexcept { return memory != NULL_DEVICE_MEMORY; }
+    };
+
+    // ==========================================
+    // CONFIGURATION / STATISTICS
+    // ==========================================
+
+    struct GpuMemoryConfig {
+        uint64_t preferred_block_size = 256ull * 1024 * 1024;
+        uint64_t small_heap_threshold = 1ull * 1024 * 1024 * 1024;  // Heaps below this get heap/8 blocks
+        float dedicated_threshold = 0.5f;        // Fraction of a block above which allocations go dedicated
+        float auto_budget_fraction = 0.8f;       // Used when vram_budget = 0 and no budget extension
+        uint32_t empty_blocks_to_keep = 1;       // Per memory type, avoids allocate/free churn
+    };
+
+    struct GpuHeapStats {
+        uint64_t size = 0;
+        uint64_t budget = 0;
+        uint64_t allocated = 0;      // Device memory owned (blocks + dedicated)
+        uint64_t used = 0;           // Bytes handed to resources
+        uint32_t block_count = 0;
+        uint32_t dedicated_count = 0;
+        uint32_t allocation_count = 0;
+        bool device_local = false;
+    };
+
+    struct GpuMemoryStats {
+        std::vector<GpuHeapStats> heaps;
+        uint32_t device_allocations = 0;   // Live vkAllocateMemory objects
+        uint64_t evicted_bytes = 0;
+        uint32_t failed_allocations = 0;
+
+        [[nodiscard]] uint64_t getDeviceLocalUsed() const noexcept;
+        [[nodiscard]] uint64_t getDeviceLocalBudget() const noexcept;
+    };
+
+    // Called when an allocation would exceed the budget. Must release memory
+    // through GpuMemoryAllocator::free and return the number of bytes freed.
+    using GpuEvictionCallback = std::function<uint64_t(uint32_t heap_index, uint64_t bytes_needed)>;
+
+    // ==========================================
+    // GPU MEMORY ALLOCATOR
+    // ==========================================
+
+    /**
+     * @brief Sub-allocates device memory in large per-memory-type blocks
+     *
+     * Regular allocations are placed with TLSF inside shared blocks, linear
+     * pools serve transient per-frame data, and big resources get their own
+     * device allocation. Device-local heaps are held to
+     * RendererConfig::vram_budget (or an auto-detected budget), with eviction
+     * callbacks consulted before a request is refused.
+     */
+    class GpuMemoryAllocator {
+    public:
+        GpuMemoryAllocator(IGpuMemoryBackend& backend, const RendererConfig& renderer_config,
+            const GpuMemoryConfig& config = {});
+        ~GpuMemoryAllocator();
+
+        GpuMemoryAllocator(const GpuMemoryAllocator&) = delete;
+        GpuMemoryAllocator& operator=(const GpuMemoryAllocator&) = delete;
+
+        [[nodiscard]] std::expected<GpuAllocation, RendererError> allocate(
+            const GpuMemoryRequirements& requirements, const GpuAllocationDesc& desc = {});
+        // Stale or repeated frees are reported and ignored
+        void free(const GpuAllocation& allocation);
+
+        // Linear pools: one block, bump allocation, freed all at once by reset
+        [[nodiscard]] std::expected<GpuLinearPoolId, RendererError> createLinearPool(GpuMemoryUsage usage, uint64_t size);
+        void resetLinearPool(GpuLinearPoolId pool);
+        void destroyLinearPool(GpuLinearPoolId pool);
+
+        // Eviction
+        void addEvictionCallback(GpuEvictionCallback callback);
+        void refreshBudgets();  // Re-query VK_EXT_memory_budget, call once per frame
+
+        [[nodiscard]] GpuMemoryStats getStats() const;
+        [[nodiscard]] size_t getVramUsedMB() const;
+        [[nodiscard]] size_t getVramAvailableMB() const;
+
+    private:
+        struct Block {
+            GpuDeviceMemory memory = NULL_DEVICE_MEMORY;
+            uint64_t size = 0;
+            uint32_t memory_type = 0;
+            uint8_t* mapped = nullptr;
+            TlsfAllocator tlsf;
+            std::vector<uint32_t> live_generations;  // By TLSF node, 0 = free
+            uint32_t generation = 0;      // This use of the slot; linear pools bump it on reset
+            uint64_t linear_head = 0;     // Linear pools only
+            uint64_t used = 0;
+            uint32_t allocation_count = 0;
+            bool dedicated = false;
+            bool linear = false;
+            bool in_use = false;
+        };
+
+        std::optional<uint32_t> selectMemoryType(uint32_t type_bits, GpuMemoryUsage usage) const;
+        uint64_t getBlockSize(uint32_t heap_index) const;
+        uint32_t getHeapIndex(uint32_t memory_type) const;
+
+        // Both expect mutex_ held
+        std::expected<uint32_t, RendererError> createBlock(uint32_t memory_type, uint64_t size,
+            bool dedicated, bool linear, GpuAllocationPriority priority, std::unique_lock<std::mutex>& lock);
+        void destroyBlock(uint32_t block);
+        bool reserveBudget(uint32_t heap_index, uint64_t size, std::unique_lock<std::mutex>& lock);
+
+        std::optional<GpuAllocation> allocateFromBlocks(uint32_t memory_type, const GpuMemoryRequirements& requirements);
+        GpuAllocation makeAllocation(uint32_t block, uint64_t offset, uint64_t size, const TlsfAllocation& sub);
+        uint32_t nextGeneration() noexcept;
+
+    private:
+        IGpuMemoryBackend& backend_;
+        GpuMemoryConfig config_;
+        uint64_t vram_budget_override_;
+
+        mutable std::mutex mutex_;
+        std::vector<Block> blocks_;
+        std::vector<uint32_t> free_block_slots_;
+        std::vector<uint64_t> heap_budgets_;
+        std::vector<uint64_t> heap_allocated_;
+        std::vector<GpuEvictionCallback> eviction_callbacks_;
+        uint32_t device_allocations_ = 0;
+        uint32_t generation_counter_ = 0;
+        uint64_t evicted_bytes_ = 0;
+        uint32_t failed_allocations_ = 0;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,101 @@
+#include "ashbornpch.h"
+
+#include "NullGpuMemoryBackend.h"
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint64_t GB = 1024ull * 1024 * 1024;
+        constexpr uint64_t MB = 1024ull * 1024;
+    }
+
+    // ==========================================
+    // CONSTRUCTION
+    // ==========================================
+
+    NullGpuMemoryBackend::NullGpuMemoryBackend()
+        : NullGpuMemoryBackend(
+            {
+                { .size = 8 * GB, .device_local = true },
+                { .size = 16 * GB, .device_local = false },
+                { .size = 256 * MB, .device_local = true }
+            },
+            {
+                { .heap_index = 0, .device_local = true },
+                { .heap_index = 1, .host_visible = true, .host_coherent = true },
+                { .heap_index = 1, .host_visible = true, .host_coherent = true, .host_cached = true },
+                { .heap_index = 2, .device_local = true, .host_visible = true, .host_coherent = true }
+            }) {
+    }
+
+    NullGpuMemoryBackend::NullGpuMemoryBackend(std::vector<GpuHeapInfo> heaps, std::vector<GpuMemoryTypeInfo> types,
+        uint32_t max_allocation_count)
+        : heaps_(std::move(heaps))
+        , types_(std::move(types))
+        , max_allocation_count_(max_allocation_count)
+        , heap_usage_(heaps_.size(), 0)
+        , external_usage_(heaps_.size(), 0) {
+    }
+
+    // ==========================================
+    // BACKEND INTERFACE
+    // ==========================================
+
+    std::expected<GpuDeviceMemory, RendererError> NullGpuMemoryBackend::allocateMemory(uint32_t memory_type, uint64_t size) {
+        if (memory_type >= types_.size() || size == 0) {
+            return std::unexpected(RendererError::Unknown);
+        }
+
+        const uint32_t heap = types_[memory_type].heap_index;
+        if (allocations_.size() >= max_allocation_count_ ||
+            heap_usage_[heap] + external_usage_[heap] + size > heaps_[heap].size) {
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+
+        FakeAllocation allocation{ memory_type, size, nullptr };
+        if (types_[memory_type].host_visible) {
+            allocation.host_memory = std::make_unique<uint8_t[]>(size);
+        }
+
+        const GpuDeviceMemory handle = next_handle_++;
+        allocations_.emplace(handle, std::move(allocation));
+        heap_usage_[heap] += size;
+        return handle;
+    }
+
+    void NullGpuMemoryBackend::freeMemory(GpuDeviceMemory memory) {
+        auto it = allocations_.find(memory);
+        if (it == allocations_.end()) {
+            print_e("Null backend: free of unknown device memory", LogContext{ {"handle", memory} });
+            return;
+        }
+
+        heap_usage_[types_[it->second.memory_type].heap_index] -= it->second.size;
+        allocations_.erase(it);
+    }
+
+    void* NullGpuMemoryBackend::mapMemory(GpuDeviceMemory memory) {
+        auto it = allocations_.find(memory);
+        return it != allocations_.end() ? it->second.host_memory.get() : nullptr;
+    }
+
+    std::optional<GpuHeapBudget> NullGpuMemoryBackend::queryBudget(uint32_t heap_index) const {
+        if (!reports_budget_ || heap_index >= heaps_.size()) {
+            return std::nullopt;
+        }
+
+        // Mirrors drivers that report ~80% of the heap minus what other processes use
+        const uint64_t budget = heaps_[heap_index].size / 10 * 8;
+        return GpuHeapBudget{
+            .usage = heap_usage_[heap_index],
+            .budget = budget > external_usage_[heap_index] ? budget - external_usage_[heap_index] : 0
+        };
+    }
+
+    void NullGpuMemoryBackend::setExternalUsage(uint32_t heap_index, uint64_t bytes) {
+        if (heap_index < external_usage_.size()) {
+            external_usage_[heap_index] = bytes;
+        }
+    }
+
+} // namespace AshCore
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Memory/GpuMemory.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // NULL GPU MEMORY BACKEND
+    // ==========================================
+
+    /**
+     * @brief Simulated device memory for headless runs, tools and tests
+     *
+     * Enforces heap sizes and the allocation count limit like a driver
+     * would. Host-visible allocations are backed by real system memory so
+     * mapped writes can be inspected.
+     */
+    class NullGpuMemoryBackend final : public IGpuMemoryBackend {
+    public:
+        // Defaults to a typical discrete GPU: 8 GB VRAM, 16 GB system heap, 256 MB ReBAR window
+        NullGpuMemoryBackend();
+        NullGpuMemoryBackend(std::vector<GpuHeapInfo> heaps, std::vector<GpuMemoryTypeInfo> types,
+            uint32_t max_allocation_count = 4096);
+
+        [[nodiscard]] std::span<const GpuHeapInfo> getHeaps() const override { return heaps_; }
+        [[nodiscard]] std::span<const GpuMemoryTypeInfo> getMemoryTypes() const override { return types_; }
+        [[nodiscard]] uint32_t getMaxAllocationCount() const override { return max_allocation_count_; }
+
+        [[nodiscard]] std::expected<GpuDeviceMemory, RendererError> allocateMemory(uint32_t memory_type, uint64_t size) override;
+        void freeMemory(GpuDeviceMemory memory) override;
+        [[nodiscard]] void* mapMemory(GpuDeviceMemory memory) override;
+        [[nodiscard]] std::optional<GpuHeapBudget> queryBudget(uint32_t heap_index) const override;
+
+        // Simulates memory used by other applications (shrinks the reported budget)
+        void setExternalUsage(uint32_t heap_index, uint64_t bytes);
+        void setReportsBudget(bool reports) noexcept { reports_budget_ = reports; }
+
+        [[nodiscard]] uint64_t getHeapUsage(uint32_t heap_index) const { return heap_usage_[heap_index]; }
+        [[nodiscard]] uint32_t getAllocationCount() const noexcept { return static_cast<uint32_t>(allocations_.size()); }
+
+    private:
+        struct FakeAllocation {
+            uint32_t memory_type;
+            uint64_t size;
+            std::unique_ptr<uint8_t[]> host_memory;
+        };
+
+        std::vector<GpuHeapInfo> heaps_;
+        std::vector<GpuMemoryTypeInfo> types_;
+        uint32_t max_allocation_count_;
+
+        std::vector<uint64_t> heap_usage_;
+        std::vector<uint64_t> external_usage_;
+        std::unordered_map<GpuDeviceMemory, FakeAllocation> allocations_;
+        GpuDeviceMemory next_handle_ = 1;
+        bool reports_budget_ = true;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,304 @@
+#include "ashbornpch.h"
+
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace AshCore {
+
+    namespace {
+        uint32_t mostSignificantBit(uint64_t value) noexcept {
+            return 63u - static_cast<uint32_t>(std::countl_zero(value));
+        }
+
+        uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    // ==========================================
+    // CONSTRUCTION
+    // ==========================================
+
+    TlsfAllocator::TlsfAllocator(uint64_t capacity) {
+        reset(capacity);
+    }
+
+    void TlsfAllocator::reset(uint64_t capacity) {
+        capacity_ = capacity;
+        used_ = 0;
+        allocation_count_ = 0;
+        free_block_count_ = 0;
+        fl_bitmap_ = 0;
+        sl_bitmap_.fill(0);
+        for (auto& heads : free_heads_) {
+            heads.fill(NIL);
+        }
+        nodes_.clear();
+        unused_nodes_.clear();
+
+        if (capacity_ > 0) {
+            const uint32_t node = newNode();
+            nodes_[node].offset = 0;
+            nodes_[node].size = capacity_;
+            insertFreeBlock(node);
+        }
+    }
+
+    // ==========================================
+    // ALLOCATION
+    // ==========================================
+
+    std::optional<TlsfAllocation> TlsfAllocator::allocate(uint64_t size, uint64_t alignment) {
+        if (size == 0) size = 1;
+        if (alignment <= 1) alignment = 1;
+
+        // Over-ask so that any block we get can absorb the alignment padding
+        const uint64_t search_size = size + (alignment - 1);
+        if (search_size < size || search_size > capacity_) {
+            return std::nullopt;
+        }
+
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mappingSearch(search_size, fl, sl);
+
+        uint32_t node = findFreeBlock(fl, sl);
+        if (node == NIL) {
+            return std::nullopt;
+        }
+        removeFreeBlock(node);
+
+        // Give the leading padding back as its own free block
+        const uint64_t padding = alignUp(nodes_[node].offset, alignment) - nodes_[node].offset;
+        if (padding > 0) {
+            const uint32_t aligned = splitBlock(node, padding);
+            insertFreeBlock(node);
+            node = aligned;
+        }
+
+        if (nodes_[node].size > size) {
+            const uint32_t remainder = splitBlock(node, size);
+            insertFreeBlock(remainder);
+        }
+
+        if (++generation_counter_ == 0) ++generation_counter_;
+        nodes_[node].is_free = false;
+        nodes_[node].generation = generation_counter_;
+        used_ += nodes_[node].size;
+        allocation_count_++;
+
+        return TlsfAllocation{ nodes_[node].offset, node, generation_counter_ };
+    }
+
+    void TlsfAllocator::free(const TlsfAllocation& allocation) {
+        if (!allocation.isValid() || allocation.node >= nodes_.size()) return;
+
+        Block& block = nodes_[allocation.node];
+        if (block.is_free || block.offset != allocation.offset || block.generation != allocation.generation) {
+            print_e("TLSF free of an unknown or already freed allocation", LogContext{
+                {"offset", allocation.offset},
+                {"generation", allocation.generation}
+                });
+            return;
+        }
+
+        used_ -= block.size;
+        allocation_count_--;
+
+        const uint32_t merged = mergeWithNeighbours(allocation.node);
+        insertFreeBlock(merged);
+    }
+
+    uint64_t TlsfAllocator::getAllocationSize(const TlsfAllocation& allocation) const noexcept {
+        if (!allocation.isValid() || allocation.node >= nodes_.size()) return 0;
+        const Block& block = nodes_[allocation.node];
+        if (block.is_free || block.generation != allocation.generation) return 0;
+        return block.size;
+    }
+
+    TlsfStats TlsfAllocator::getStats() const noexcept {
+        TlsfStats stats;
+        stats.capacity = capacity_;
+        stats.used = used_;
+        stats.free = capacity_ - used_;
+        stats.allocation_count = allocation_count_;
+        stats.free_block_count = free_block_count_;
+
+        // The largest block lives in the highest non-empty list; scan just that one
+        if (fl_bitmap_ != 0) {
+            const uint32_t fl = mostSignificantBit(fl_bitmap_);
+            const uint32_t sl = 31u - static_cast<uint32_t>(std::countl_zero(sl_bitmap_[fl]));
+            for (uint32_t node = free_heads_[fl][sl]; node != NIL; node = nodes_[node].next_free) {
+                stats.largest_free = std::max(stats.largest_free, nodes_[node].size);
+            }
+        }
+
+        return stats;
+    }
+
+    // ==========================================
+    // SIZE CLASS MAPPING
+    // ==========================================
+
+    void TlsfAllocator::mappingInsert(uint64_t size, uint32_t& fl, uint32_t& sl) noexcept {
+        if (size < SMALL_BLOCK_SIZE) {
+            fl = 0;
+            sl = static_cast<uint32_t>(size);
+            return;
+        }
+
+        const uint32_t msb = mostSignificantBit(size);
+        sl = static_cast<uint32_t>(size >> (msb - SL_INDEX_LOG2)) ^ SL_INDEX_COUNT;
+        fl = msb - SL_INDEX_LOG2 + 1;
+    }
+
+    void TlsfAllocator::mappingSearch(uint64_t size, uint32_t& fl, uint32_t& sl) noexcept {
+        // Round up to the next list boundary so any block in the list is big enough
+        if (size >= SMALL_BLOCK_SIZE) {
+            const uint64_t round = (uint64_t{ 1 } << (mostSignificantBit(size) - SL_INDEX_LOG2)) - 1;
+            size = (size + round < size) ? ~uint64_t{ 0 } : size + round;
+        }
+        mappingInsert(size, fl, sl);
+    }
+
+    uint32_t TlsfAllocator::findFreeBlock(uint32_t fl, uint32_t sl) const noexcept {
+        if (fl >= FL_INDEX_COUNT) return NIL;
+
+        uint32_t sl_map = sl_bitmap_[fl] & (~0u << sl);
+        if (sl_map == 0) {
+            if (fl + 1 >= FL_INDEX_COUNT) return NIL;
+
+            const uint64_t fl_map = fl_bitmap_ & (~uint64_t{ 0 } << (fl + 1));
+            if (fl_map == 0) return NIL;
+
+            fl = static_cast<uint32_t>(std::countr_zero(fl_map));
+            sl_map = sl_bitmap_[fl];
+        }
+
+        sl = static_cast<uint32_t>(std::countr_zero(sl_map));
+        return free_heads_[fl][sl];
+    }
+
+    // ==========================================
+    // FREE LISTS
+    // ==========================================
+
+    void TlsfAllocator::insertFreeBlock(uint32_t node) {
+        Block& block = nodes_[node];
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mappingInsert(block.size, fl, sl);
+
+        block.is_free = true;
+        block.prev_free = NIL;
+        block.next_free = free_heads_[fl][sl];
+        if (block.next_free != NIL) {
+            nodes_[block.next_free].prev_free = node;
+        }
+        free_heads_[fl][sl] = node;
+
+        fl_bitmap_ |= uint64_t{ 1 } << fl;
+        sl_bitmap_[fl] |= 1u << sl;
+        free_block_count_++;
+    }
+
+    void TlsfAllocator::removeFreeBlock(uint32_t node) {
+        Block& block = nodes_[node];
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mappingInsert(block.size, fl, sl);
+
+        if (block.prev_free != NIL) {
+            nodes_[block.prev_free].next_free = block.next_free;
+        }
+        else {
+            free_heads_[fl][sl] = block.next_free;
+        }
+        if (block.next_free != NIL) {
+            nodes_[block.next_free].prev_free = block.prev_free;
+        }
+
+        if (free_heads_[fl][sl] == NIL) {
+            sl_bitmap_[fl] &= ~(1u << sl);
+            if (sl_bitmap_[fl] == 0) {
+                fl_bitmap_ &= ~(uint64_t{ 1 } << fl);
+            }
+        }
+
+        block.is_free = false;
+        block.prev_free = NIL;
+        block.next_free = NIL;
+        free_block_count_--;
+    }
+
+    uint32_t TlsfAllocator::splitBlock(uint32_t node, uint64_t size) {
+        const uint32_t remainder = newNode();  // May reallocate nodes_
+        Block& block = nodes_[node];
+        Block& rest = nodes_[remainder];
+
+        rest.offset = block.offset + size;
+        rest.size = block.size - size;
+        rest.prev_physical = node;
+        rest.next_physical = block.next_physical;
+        if (rest.next_physical != NIL) {
+            nodes_[rest.next_physical].prev_physical = remainder;
+        }
+
+        block.size = size;
+        block.next_physical = remainder;
+        return remainder;
+    }
+
+    uint32_t TlsfAllocator::mergeWithNeighbours(uint32_t node) {
+        // Absorb the previous block into this one's slot
+        const uint32_t prev = nodes_[node].prev_physical;
+        if (prev != NIL && nodes_[prev].is_free) {
+            removeFreeBlock(prev);
+            nodes_[prev].size += nodes_[node].size;
+            nodes_[prev].next_physical = nodes_[node].next_physical;
+            if (nodes_[prev].next_physical != NIL) {
+                nodes_[nodes_[prev].next_physical].prev_physical = prev;
+            }
+            releaseNode(node);
+            node = prev;
+        }
+
+        const uint32_t next = nodes_[node].next_physical;
+        if (next != NIL && nodes_[next].is_free) {
+            removeFreeBlock(next);
+            nodes_[node].size += nodes_[next].size;
+            nodes_[node].next_physical = nodes_[next].next_physical;
+            if (nodes_[node].next_physical != NIL) {
+                nodes_[nodes_[node].next_physical].prev_physical = node;
+            }
+            releaseNode(next);
+        }
+
+        return node;
+    }
+
+    // ==========================================
+    // NODE POOL
+    // ==========================================
+
+    uint32_t TlsfAllocator::newNode() {
+        if (!unused_nodes_.empty()) {
+            const uint32_t node = unused_nodes_.back();
+            unused_nodes_.pop_back();
+            nodes_[node] = {};
+            return node;
+        }
+        nodes_.emplace_back();
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void TlsfAllocator::releaseNode(uint32_t node) {
+        nodes_[node] = {};
+        nodes_[node].is_free = true;  // Never looks like a live allocation
+        nodes_[node].offset = ~uint64_t{ 0 };
+        unused_nodes_.push_back(node);
+    }
+
+} // namespace AshCore
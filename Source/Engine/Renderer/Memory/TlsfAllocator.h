@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // ALLOCATION / STATISTICS
+    // ==========================================
+
+    // Offsets and sizes are in caller-defined units (bytes, vertices, indices...)
+    struct TlsfAllocation {
+        static constexpr uint32_t INVALID_NODE = std::numeric_limits<uint32_t>::max();
+
+        uint64_t offset = 0;
+        uint32_t node = INVALID_NODE;
+        uint32_t generation = 0;      // Catches stale and double frees once the node is reused
+
+        [[nodiscard]] bool isValid() const noexcept { return node != INVALID_NODE; }
+    };
+
+    struct TlsfStats {
+        uint64_t capacity = 0;
+        uint64_t used = 0;
+        uint64_t free = 0;
+        uint64_t largest_free = 0;
+        uint32_t allocation_count = 0;
+        uint32_t free_block_count = 0;
+
+        // 0 = all free space is one block, -> 1 = free space is scattered
+        [[nodiscard]] float getFragmentation() const noexcept {
+            return free > 0 ? 1.0f - static_cast<float>(largest_free) / static_cast<float>(free) : 0.0f;
+        }
+    };
+
+    // ==========================================
+    // TLSF ALLOCATOR
+    // ==========================================
+
+    /**
+     * @brief Two-level segregated fit allocator over an abstract offset range
+     *
+     * Owns no memory: it hands out offsets into a buffer/heap that lives
+     * elsewhere, which keeps it usable for GPU memory and unit testing alike.
+     * Allocation and free are O(1); neighbouring free blocks are merged
+     * eagerly.
+     */
+    class TlsfAllocator {
+    public:
+        explicit TlsfAllocator(uint64_t capacity = 0);
+
+        // alignment must be a power of two (0/1 = unaligned)
+        [[nodiscard]] std::optional<TlsfAllocation> allocate(uint64_t size, uint64_t alignment = 0);
+        void free(const TlsfAllocation& allocation);
+        void reset(uint64_t capacity);
+
+        [[nodiscard]] uint64_t getAllocationSize(const TlsfAllocation& allocation) const noexcept;
+        [[nodiscard]] uint64_t getCapacity() const noexcept { return capacity_; }
+        [[nodiscard]] uint64_t getUsed() const noexcept { return used_; }
+        [[nodiscard]] bool isEmpty() const noexcept { return allocation_count_ == 0; }
+        [[nodiscard]] TlsfStats getStats() const noexcept;
+
+    private:
+        static constexpr uint32_t SL_INDEX_LOG2 = 5;
+        static constexpr uint32_t SL_INDEX_COUNT = 1u << SL_INDEX_LOG2;
+        static constexpr uint32_t FL_INDEX_COUNT = 64 - SL_INDEX_LOG2 + 1;
+        static constexpr uint64_t SMALL_BLOCK_SIZE = SL_INDEX_COUNT;
+        static constexpr uint32_t NIL = std::numeric_limits<uint32_t>::max();
+
+        struct Block {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+            uint32_t prev_physical = NIL;
+            uint32_t next_physical = NIL;
+            uint32_t prev_free = NIL;
+            uint32_t next_free = NIL;
+            uint32_t generation = 0;      // Of the allocation that holds the block
+            bool is_free = false;
+        };
+
+        static void mappingInsert(uint64_t size, uint32_t& fl, uint32_t& sl) noexcept;
+        static void mappingSearch(uint64_t size, uint32_t& fl, uint32_t& sl) noexcept;
+
+        uint32_t findFreeBlock(uint32_t fl, uint32_t sl) const noexcept;
+        void insertFreeBlock(uint32_t node);
+        void removeFreeBlock(uint32_t node);
+        uint32_t splitBlock(uint32_t node, uint64_t size);  // Returns the remainder node
+        uint32_t mergeWithNeighbours(uint32_t node);
+
+        uint32_t newNode();
+        void releaseNode(uint32_t node);
+
+    private:
+        uint64_t capacity_ = 0;
+        uint64_t used_ = 0;
+        uint32_t allocation_count_ = 0;
+        uint32_t free_block_count_ = 0;
+
+        uint64_t fl_bitmap_ = 0;
+        std::array<uint32_t, FL_INDEX_COUNT> sl_bitmap_{};
+        std::array<std::array<uint32_t, SL_INDEX_COUNT>, FL_INDEX_COUNT> free_heads_{};
+
+        std::vector<Block> nodes_;
+        std::vector<uint32_t> unused_nodes_;
+        uint32_t generation_counter_ = 0;  // Survives reset(), so older handles stay stale
+    };
+
+} // namespace AshCore
@@ -0,0 +1,517 @@
+#include "ashbornpch.h"
+
+#include "ParticleSystem.h"
+#include "Jobs/JobSystem.h"
+#include "Upload/UploadManager.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t LANES = 8;
+
+        // age / lifetime must stay finite, even for a type with lifetime_min = 0
+        constexpr float MIN_LIFETIME = 1e-3f;
+
+        size_t paddedSize(size_t count) {
+            return (count + LANES - 1) / LANES * LANES;
+        }
+
+        // Runs fn(batch_index, begin, end) over fixed batches, on the job system when available
+        template<typename Fn>
+        void forEachBatch(JobSystem* jobs, size_t count, size_t batch_size, Fn&& fn) {
+            if (jobs && count > batch_size) {
+                jobs->parallelFor(count, batch_size, [&](size_t begin, size_t end) {
+                    fn(begin / batch_size, begin, end);
+                    });
+                return;
+            }
+            for (size_t begin = 0; begin < count; begin += batch_size) {
+                fn(begin / batch_size, begin, std::min(begin + batch_size, count));
+            }
+        }
+
+        // Bit per lane of [base, base + 8) that is below end
+        uint32_t validLanes(size_t base, size_t end) {
+            return end >= base + LANES ? 0xFFu : (1u << (end - base)) - 1;
+        }
+
+#if defined(__AVX2__)
+        // Left-pack permutations: entry m lists the set lanes of m first
+        struct LeftPackTable {
+            alignas(32) uint32_t lanes[256][LANES];
+
+            constexpr LeftPackTable() : lanes{} {
+                for (uint32_t mask = 0; mask < 256; ++mask) {
+                    uint32_t out = 0;
+                    for (uint32_t lane = 0; lane < LANES; ++lane) {
+                        if (mask & (1u << lane)) lanes[mask][out++] = lane;
+                    }
+                }
+            }
+        };
+        constexpr LeftPackTable LEFT_PACK;
+
+        // Writes the masked lanes of src[0..8) contiguously to dst (all 8 lanes are stored)
+        template<typename T>
+        void leftPack(const T* src, T* dst, __m256i permutation) {
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_permutevar8x32_epi32(values, permutation));
+        }
+#endif
+    }
+
+    // ==========================================
+    // COLLISION HEIGHTFIELD
+    // ==========================================
+
+    void ParticleHeightfield::resize(int32_t origin_x, int32_t origin_z, uint32_t width, uint32_t depth) {
+        origin_x_ = origin_x;
+        origin_z_ = origin_z;
+        width_ = width;
+        depth_ = depth;
+        heights_.assign(static_cast<size_t>(width) * depth, NO_GROUND);
+    }
+
+    void ParticleHeightfield::setHeight(int32_t world_x, int32_t world_z, float height) {
+        const int64_t x = static_cast<int64_t>(world_x) - origin_x_;
+        const int64_t z = static_cast<int64_t>(world_z) - origin_z_;
+        if (x < 0 || z < 0 || x >= width_ || z >= depth_) return;
+        heights_[static_cast<size_t>(z) * width_ + static_cast<size_t>(x)] = height;
+    }
+
+    float ParticleHeightfield::sample(float x, float z) const noexcept {
+        const float cell_x = std::floor(x - static_cast<float>(origin_x_));
+        const float cell_z = std::floor(z - static_cast<float>(origin_z_));
+        if (!(cell_x >= 0.0f && cell_z >= 0.0f && cell_x < static_cast<float>(width_) && cell_z < static_cast<float>(depth_))) {
+            return NO_GROUND;
+        }
+        return heights_[static_cast<size_t>(cell_z) * width_ + static_cast<size_t>(cell_x)];
+    }
+
+    // ==========================================
+    // PARTICLE TYPE PRESETS
+    // ==========================================
+
+    ParticleTypeDesc ParticleTypeDesc::blockBreak() {
+        ParticleTypeDesc desc;
+        desc.name = "block_break";
+        desc.max_particles = 8192;
+        desc.gravity = 20.0f;
+        desc.drag = 0.5f;
+        desc.lifetime_min = 0.6f;
+        desc.lifetime_max = 1.2f;
+        desc.size = 0.12f;
+        desc.collision = ParticleCollision::Bounce;
+        return desc;
+    }
+
+    ParticleTypeDesc ParticleTypeDesc::smoke() {
+        ParticleTypeDesc desc;
+        desc.name = "smoke";
+        desc.max_particles = 16384;
+        desc.gravity = -0.8f;
+        desc.drag = 1.5f;
+        desc.wind_influence = 0.6f;
+        desc.lifetime_min = 2.0f;
+        desc.lifetime_max = 4.0f;
+        desc.size = 0.3f;
+        desc.size_growth = 0.4f;
+        return desc;
+    }
+
+    ParticleTypeDesc ParticleTypeDesc::rain() {
+        ParticleTypeDesc desc;
+        desc.name = "rain";
+        desc.max_particles = 131072;
+        desc.drag = 0.8f;                    // Settles near terminal velocity
+        desc.wind_influence = 0.3f;
+        desc.lifetime_min = 3.0f;
+        desc.lifetime_max = 3.0f;
+        desc.size = 0.05f;
+        desc.collision = ParticleCollision::Kill;
+        return desc;
+    }
+
+    ParticleTypeDesc ParticleTypeDesc::snow() {
+        ParticleTypeDesc desc;
+        desc.name = "snow";
+        desc.max_particles = 131072;
+        desc.gravity = 1.0f;
+        desc.drag = 2.0f;
+        desc.wind_influence = 1.0f;
+        desc.lifetime_min = 8.0f;
+        desc.lifetime_max = 12.0f;
+        desc.size = 0.08f;
+        desc.collision = ParticleCollision::Stick;
+        return desc;
+    }
+
+    // ==========================================
+    // PARTICLE SYSTEM
+    // ==========================================
+
+    void ParticleSystem::ParticleSoA::allocate(size_t capacity) {
+        // One extra group of slack: left-packing stores eight lanes past the last survivor
+        const size_t padded = paddedSize(capacity) + LANES;
+        for (auto* field : { &px, &py, &pz, &vx, &vy, &vz, &age, &lifetime, &size }) {
+            field->assign(padded, 0.0f);
+        }
+        color.assign(padded, 0);
+    }
+
+    ParticleSystem::ParticleSystem(const ParticleConfig& config)
+        : config_(config) {
+        config_.batch_size = std::max<size_t>(paddedSize(config_.batch_size), LANES);
+        simd_ = config_.use_simd && isSimdAvailable();
+    }
+
+    bool ParticleSystem::isSimdAvailable() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    ParticleTypeId ParticleSystem::registerType(const ParticleTypeDesc& desc) {
+        Pool& pool = pools_.emplace_back();
+        pool.desc = desc;
+        pool.capacity = desc.max_particles;
+        pool.front.allocate(pool.capacity);
+        pool.back.allocate(pool.capacity);
+
+        print_i("Particle type registered", LogContext{ {"name", desc.name}, {"capacity", desc.max_particles} });
+        return ParticleTypeId{ static_cast<uint32_t>(pools_.size() - 1) };
+    }
+
+    uint32_t ParticleSystem::emit(ParticleTypeId type, const ParticleBurst& burst) {
+        if (type.value >= pools_.size()) return 0;
+        Pool& pool = pools_[type.value];
+
+        const uint32_t spawn = std::min(burst.count, pool.capacity - pool.count);
+        dropped_since_update_ += burst.count - spawn;
+
+        // xorshift32 -> [0, 1)
+        auto random = [this]() {
+            rng_state_ ^= rng_state_ << 13;
+            rng_state_ ^= rng_state_ >> 17;
+            rng_state_ ^= rng_state_ << 5;
+            return static_cast<float>(rng_state_ >> 8) * (1.0f / 16777216.0f);
+            };
+        auto jitter = [&](float center, float extent) { return center + (random() * 2.0f - 1.0f) * extent; };
+
+        ParticleSoA& soa = pool.front;
+        for (uint32_t i = pool.count; i < pool.count + spawn; ++i) {
+            soa.px[i] = jitter(burst.position[0], burst.position_jitter[0]);
+            soa.py[i] = jitter(burst.position[1], burst.position_jitter[1]);
+            soa.pz[i] = jitter(burst.position[2], burst.position_jitter[2]);
+            soa.vx[i] = jitter(burst.velocity[0], burst.velocity_jitter[0]);
+            soa.vy[i] = jitter(burst.velocity[1], burst.velocity_jitter[1]);
+            soa.vz[i] = jitter(burst.velocity[2], burst.velocity_jitter[2]);
+            soa.age[i] = 0.0f;
+            const float lifetime = pool.desc.lifetime_min + random() * (pool.desc.lifetime_max - pool.desc.lifetime_min);
+            soa.lifetime[i] = std::max(lifetime, MIN_LIFETIME);
+            soa.size[i] = pool.desc.size;
+            soa.color[i] = burst.color;
+        }
+
+        pool.count += spawn;
+        spawned_since_update_ += spawn;
+        return spawn;
+    }
+
+    void ParticleSystem::clear(ParticleTypeId type) {
+        if (type.value < pools_.size()) pools_[type.value].count = 0;
+    }
+
+    uint32_t ParticleSystem::getAliveCount(ParticleTypeId type) const noexcept {
+        return type.value < pools_.size() ? pools_[type.value].count : 0;
+    }
+
+    uint64_t ParticleSystem::getInstanceBufferSize() const noexcept {
+        uint64_t particles = 0;
+        for (const Pool& pool : pools_) particles += pool.capacity;
+        return particles * sizeof(ParticleInstance);
+    }
+
+    // ==========================================
+    // SIMULATION
+    // ==========================================
+
+    void ParticleSystem::update(float dt, JobSystem* jobs) {
+        stats_.spawned = spawned_since_update_;
+        stats_.dropped = dropped_since_update_;
+        stats_.died = 0;
+        stats_.alive = 0;
+        spawned_since_update_ = 0;
+        dropped_since_update_ = 0;
+
+        for (Pool& pool : pools_) {
+            if (pool.count == 0) continue;
+
+            StepParams step{};
+            step.dt = dt;
+            step.accel[0] = wind_[0] * pool.desc.wind_influence;
+            step.accel[1] = wind_[1] * pool.desc.wind_influence - pool.desc.gravity;
+            step.accel[2] = wind_[2] * pool.desc.wind_influence;
+            step.damping = std::max(0.0f, 1.0f - pool.desc.drag * dt);
+            step.growth = pool.desc.size_growth * dt;
+
+            const size_t batch_size = config_.batch_size;
+            const size_t batch_count = (pool.count + batch_size - 1) / batch_size;
+            pool.batch_alive.assign(batch_count, 0);
+
+            // Pass 1: integrate, collide, count survivors per batch
+            forEachBatch(jobs, pool.count, batch_size, [&](size_t batch, size_t begin, size_t end) {
+                simulateBatch(pool, step, begin, end, pool.batch_alive[batch]);
+                });
+
+            // Pass 2: each batch packs its survivors at its prefix-sum offset in the back buffer
+            pool.batch_offsets.resize(batch_count);
+            uint32_t alive = 0;
+            for (size_t batch = 0; batch < batch_count; ++batch) {
+                pool.batch_offsets[batch] = alive;
+                alive += pool.batch_alive[batch];
+            }
+            forEachBatch(jobs, pool.count, batch_size, [&](size_t batch, size_t begin, size_t end) {
+                compactBatch(pool, begin, end, pool.batch_offsets[batch], pool.batch_alive[batch]);
+                });
+
+            std::swap(pool.front, pool.back);
+            stats_.died += pool.count - alive;
+            pool.count = alive;
+            stats_.alive += alive;
+        }
+    }
+
+    void ParticleSystem::simulateBatch(Pool& pool, const StepParams& step, size_t begin, size_t end, uint32_t& alive) const {
+        ParticleSoA& p = pool.front;
+        const ParticleCollision collision = heightfield_ && heightfield_->getWidth() > 0 ? pool.desc.collision : ParticleCollision::None;
+        const float restitution = -pool.desc.restitution;
+        const float friction = pool.desc.friction;
+
+        uint32_t survivors = 0;
+        size_t i = begin;
+
+#if defined(__AVX2__)
+        if (simd_) {
+            const __m256 dt = _mm256_set1_ps(step.dt);
+            const __m256 ax = _mm256_set1_ps(step.accel[0] * step.dt);
+            const __m256 ay = _mm256_set1_ps(step.accel[1] * step.dt);
+            const __m256 az = _mm256_set1_ps(step.accel[2] * step.dt);
+            const __m256 damping = _mm256_set1_ps(step.damping);
+            const __m256 growth = _mm256_set1_ps(step.growth);
+
+            // Heightfield lookup setup
+            const __m256 origin_x = _mm256_set1_ps(heightfield_ ? static_cast<float>(heightfield_->getOriginX()) : 0.0f);
+            const __m256 origin_z = _mm256_set1_ps(heightfield_ ? static_cast<float>(heightfield_->getOriginZ()) : 0.0f);
+            const __m256i width = _mm256_set1_epi32(heightfield_ ? static_cast<int32_t>(heightfield_->getWidth()) : 0);
+            const __m256i depth = _mm256_set1_epi32(heightfield_ ? static_cast<int32_t>(heightfield_->getDepth()) : 0);
+            const __m256i minus_one = _mm256_set1_epi32(-1);
+            const __m256 no_ground = _mm256_set1_ps(ParticleHeightfield::NO_GROUND);
+
+            // Last group may run past count into padding; those lanes are never counted or packed
+            for (; i < end; i += LANES) {
+                __m256 vx = _mm256_add_ps(_mm256_loadu_ps(&p.vx[i]), ax);
+                __m256 vy = _mm256_add_ps(_mm256_loadu_ps(&p.vy[i]), ay);
+                __m256 vz = _mm256_add_ps(_mm256_loadu_ps(&p.vz[i]), az);
+                vx = _mm256_mul_ps(vx, damping);
+                vy = _mm256_mul_ps(vy, damping);
+                vz = _mm256_mul_ps(vz, damping);
+
+                const __m256 px = _mm256_add_ps(_mm256_loadu_ps(&p.px[i]), _mm256_mul_ps(vx, dt));
+                __m256 py = _mm256_add_ps(_mm256_loadu_ps(&p.py[i]), _mm256_mul_ps(vy, dt));
+                const __m256 pz = _mm256_add_ps(_mm256_loadu_ps(&p.pz[i]), _mm256_mul_ps(vz, dt));
+                __m256 age = _mm256_add_ps(_mm256_loadu_ps(&p.age[i]), dt);
+                const __m256 lifetime = _mm256_loadu_ps(&p.lifetime[i]);
+
+                if (collision != ParticleCollision::None) {
+                    const __m256i cell_x = _mm256_cvttps_epi32(_mm256_floor_ps(_mm256_sub_ps(px, origin_x)));
+                    const __m256i cell_z = _mm256_cvttps_epi32(_mm256_floor_ps(_mm256_sub_ps(pz, origin_z)));
+                    const __m256i inside = _mm256_and_si256(
+                        _mm256_and_si256(_mm256_cmpgt_epi32(cell_x, minus_one), _mm256_cmpgt_epi32(width, cell_x)),
+                        _mm256_and_si256(_mm256_cmpgt_epi32(cell_z, minus_one), _mm256_cmpgt_epi32(depth, cell_z)));
+                    const __m256i cell = _mm256_add_epi32(_mm256_mullo_epi32(cell_z, width), cell_x);
+                    const __m256 ground = _mm256_mask_i32gather_ps(no_ground, heightfield_->getHeights(),
+                        _mm256_and_si256(cell, inside), _mm256_castsi256_ps(inside), 4);
+                    const __m256 below = _mm256_cmp_ps(py, ground, _CMP_LT_OQ);
+
+                    switch (collision) {
+                    case ParticleCollision::Kill:
+                        age = _mm256_blendv_ps(age, lifetime, below);
+                        break;
+                    case ParticleCollision::Bounce:
+                        py = _mm256_blendv_ps(py, ground, below);
+                        vy = _mm256_blendv_ps(vy, _mm256_mul_ps(vy, _mm256_set1_ps(restitution)), below);
+                        vx = _mm256_blendv_ps(vx, _mm256_mul_ps(vx, _mm256_set1_ps(friction)), below);
+                        vz = _mm256_blendv_ps(vz, _mm256_mul_ps(vz, _mm256_set1_ps(friction)), below);
+                        break;
+                    case ParticleCollision::Stick:
+                        py = _mm256_blendv_ps(py, ground, below);
+                        vx = _mm256_andnot_ps(below, vx);
+                        vy = _mm256_andnot_ps(below, vy);
+                        vz = _mm256_andnot_ps(below, vz);
+                        break;
+                    case ParticleCollision::None:
+                        break;
+                    }
+                }
+
+                _mm256_storeu_ps(&p.px[i], px);
+                _mm256_storeu_ps(&p.py[i], py);
+                _mm256_storeu_ps(&p.pz[i], pz);
+                _mm256_storeu_ps(&p.vx[i], vx);
+                _mm256_storeu_ps(&p.vy[i], vy);
+                _mm256_storeu_ps(&p.vz[i], vz);
+                _mm256_storeu_ps(&p.age[i], age);
+                _mm256_storeu_ps(&p.size[i], _mm256_add_ps(_mm256_loadu_ps(&p.size[i]), growth));
+
+                const auto live = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(age, lifetime, _CMP_LT_OQ)));
+                survivors += static_cast<uint32_t>(std::popcount(live & validLanes(i, end)));
+            }
+        }
+#endif
+
+        for (; i < end; ++i) {
+            p.vx[i] = (p.vx[i] + step.accel[0] * step.dt) * step.damping;
+            p.vy[i] = (p.vy[i] + step.accel[1] * step.dt) * step.damping;
+            p.vz[i] = (p.vz[i] + step.accel[2] * step.dt) * step.damping;
+            p.px[i] += p.vx[i] * step.dt;
+            p.py[i] += p.vy[i] * step.dt;
+            p.pz[i] += p.vz[i] * step.dt;
+            p.age[i] += step.dt;
+            p.size[i] += step.growth;
+
+            if (collision != ParticleCollision::None) {
+                const float ground = heightfield_->sample(p.px[i], p.pz[i]);
+                if (p.py[i] < ground) {
+                    switch (collision) {
+                    case ParticleCollision::Kill:
+                        p.age[i] = p.lifetime[i];
+                        break;
+                    case ParticleCollision::Bounce:
+                        p.py[i] = ground;
+                        p.vy[i] *= restitution;
+                        p.vx[i] *= friction;
+                        p.vz[i] *= friction;
+                        break;
+                    case ParticleCollision::Stick:
+                        p.py[i] = ground;
+                        p.vx[i] = p.vy[i] = p.vz[i] = 0.0f;
+                        break;
+                    case ParticleCollision::None:
+                        break;
+                    }
+                }
+            }
+
+            if (p.age[i] < p.lifetime[i]) ++survivors;
+        }
+
+        alive = survivors;
+    }
+
+    void ParticleSystem::compactBatch(Pool& pool, size_t begin, size_t end, uint32_t out_offset, [[maybe_unused]] uint32_t alive) const {
+        const ParticleSoA& src = pool.front;
+        ParticleSoA& dst = pool.back;
+
+        auto copyOne = [&](size_t from, size_t to) {
+            dst.px[to] = src.px[from];
+            dst.py[to] = src.py[from];
+            dst.pz[to] = src.pz[from];
+            dst.vx[to] = src.vx[from];
+            dst.vy[to] = src.vy[from];
+            dst.vz[to] = src.vz[from];
+            dst.age[to] = src.age[from];
+            dst.lifetime[to] = src.lifetime[from];
+            dst.size[to] = src.size[from];
+            dst.color[to] = src.color[from];
+            };
+
+        uint32_t written = 0;
+        for (size_t base = begin; base < end; base += LANES) {
+            uint32_t mask = 0;
+            const uint32_t valid = validLanes(base, end);
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                if ((valid & (1u << lane)) && src.age[base + lane] < src.lifetime[base + lane]) mask |= 1u << lane;
+            }
+            if (mask == 0) continue;
+
+#if defined(__AVX2__)
+            // Full-width stores may only spill into this batch's own output range
+            if (simd_ && written + LANES <= alive) {
+                const size_t to = out_offset + written;
+                const __m256i permutation = _mm256_load_si256(reinterpret_cast<const __m256i*>(LEFT_PACK.lanes[mask]));
+                leftPack(&src.px[base], &dst.px[to], permutation);
+                leftPack(&src.py[base], &dst.py[to], permutation);
+                leftPack(&src.pz[base], &dst.pz[to], permutation);
+                leftPack(&src.vx[base], &dst.vx[to], permutation);
+                leftPack(&src.vy[base], &dst.vy[to], permutation);
+                leftPack(&src.vz[base], &dst.vz[to], permutation);
+                leftPack(&src.age[base], &dst.age[to], permutation);
+                leftPack(&src.lifetime[base], &dst.lifetime[to], permutation);
+                leftPack(&src.size[base], &dst.size[to], permutation);
+                leftPack(&src.color[base], &dst.color[to], permutation);
+                written += static_cast<uint32_t>(std::popcount(mask));
+                continue;
+            }
+#endif
+            while (mask != 0) {
+                copyOne(base + static_cast<size_t>(std::countr_zero(mask)), out_offset + written);
+                ++written;
+                mask &= mask - 1;
+            }
+        }
+    }
+
+    // ==========================================
+    // INSTANCE OUTPUT
+    // ==========================================
+
+    bool ParticleSystem::writeInstances(UploadManager& uploads, GpuBufferHandle instance_buffer, uint64_t dst_offset, JobSystem* jobs) {
+        draw_ranges_.clear();
+        stats_.instance_bytes = 0;
+
+        uint64_t total = 0;
+        for (const Pool& pool : pools_) total += pool.count;
+        if (total == 0) return true;
+
+        const uint64_t bytes = total * sizeof(ParticleInstance);
+        auto write = uploads.writeBuffer(instance_buffer, dst_offset, bytes);
+        if (!write) {
+            return false;
+        }
+
+        std::byte* out = write->data.data();
+        uint32_t first_instance = 0;
+        for (uint32_t type = 0; type < pools_.size(); ++type) {
+            const Pool& pool = pools_[type];
+            if (pool.count == 0) continue;
+
+            const ParticleSoA& p = pool.front;
+            std::byte* base = out + static_cast<size_t>(first_instance) * sizeof(ParticleInstance);
+            forEachBatch(jobs, pool.count, config_.batch_size, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const ParticleInstance instance{ { p.px[i], p.py[i], p.pz[i] }, p.size[i], p.color[i], p.age[i] / p.lifetime[i] };
+                    std::memcpy(base + i * sizeof(ParticleInstance), &instance, sizeof(ParticleInstance));
+                }
+                });
+
+            draw_ranges_.push_back({ ParticleTypeId{ type }, first_instance, pool.count });
+            first_instance += pool.count;
+        }
+
+        stats_.instance_bytes = bytes;
+        return true;
+    }
+
+} // namespace AshCore
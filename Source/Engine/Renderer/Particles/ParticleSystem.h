@@ -0,0 +1,212 @@
+#pragma once
+
+#include "RenderTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+    class UploadManager;
+
+    // ==========================================
+    // GPU-FACING LAYOUT
+    // ==========================================
+
+    // Per-instance vertex data for camera-facing particle quads
+    struct ParticleInstance {
+        float position[3];
+        float size;
+        uint32_t color;       // RGBA8
+        float life;           // age / lifetime, drives fades in the shader
+    };
+    static_assert(sizeof(ParticleInstance) == 24, "Instance stride must stay 24 bytes");
+
+    // ==========================================
+    // COLLISION HEIGHTFIELD
+    // ==========================================
+
+    /**
+     * @brief Top surface of the voxel terrain around the camera, one cell per block column
+     *
+     * The world writes the height of the highest solid block of each column;
+     * cells outside the window (or never set) have no ground.
+     */
+    class ParticleHeightfield {
+    public:
+        static constexpr float NO_GROUND = -1e30f;  // Finite so fast-math compares stay valid
+
+        void resize(int32_t origin_x, int32_t origin_z, uint32_t width, uint32_t depth);
+        void setHeight(int32_t world_x, int32_t world_z, float height);
+
+        [[nodiscard]] float sample(float x, float z) const noexcept;
+
+        [[nodiscard]] int32_t getOriginX() const noexcept { return origin_x_; }
+        [[nodiscard]] int32_t getOriginZ() const noexcept { return origin_z_; }
+        [[nodiscard]] uint32_t getWidth() const noexcept { return width_; }
+        [[nodiscard]] uint32_t getDepth() const noexcept { return depth_; }
+        [[nodiscard]] const float* getHeights() const noexcept { return heights_.data(); }
+
+    private:
+        int32_t origin_x_ = 0;
+        int32_t origin_z_ = 0;
+        uint32_t width_ = 0;
+        uint32_t depth_ = 0;
+        std::vector<float> heights_;  // Row-major, z rows of width
+    };
+
+    // ==========================================
+    // PARTICLE TYPES / EMISSION
+    // ==========================================
+
+    enum class ParticleCollision : uint8_t {
+        None,
+        Kill,     // Rain, snow
+        Bounce,   // Block debris
+        Stick     // Settles where it lands until it expires
+    };
+
+    struct ParticleTypeDesc {
+        const char* name = "particles";
+        uint32_t max_particles = 4096;
+        float gravity = 9.81f;                 // Blocks/s^2, negative rises (smoke)
+        float drag = 0.0f;                     // Fraction of velocity lost per second
+        float wind_influence = 0.0f;           // Scales ParticleSystem::setWind
+        float lifetime_min = 1.0f;
+        float lifetime_max = 1.0f;
+        float size = 0.1f;
+        float size_growth = 0.0f;              // Blocks/s
+        ParticleCollision collision = ParticleCollision::None;
+        float restitution = 0.3f;              // Bounce: vertical speed kept
+        float friction = 0.6f;                 // Bounce: horizontal speed kept per bounce
+
+        [[nodiscard]] static ParticleTypeDesc blockBreak();
+        [[nodiscard]] static ParticleTypeDesc smoke();
+        [[nodiscard]] static ParticleTypeDesc rain();
+        [[nodiscard]] static ParticleTypeDesc snow();
+    };
+
+    struct ParticleTypeId {
+        uint32_t value = UINT32_MAX;
+        [[nodiscard]] bool isValid() const noexcept { return value != UINT32_MAX; }
+        bool operator==(const ParticleTypeId&) const noexcept = default;
+    };
+
+    // Spawns count particles uniformly within +/- jitter around position and velocity
+    struct ParticleBurst {
+        std::array<float, 3> position{};
+        std::array<float, 3> position_jitter{};
+        std::array<float, 3> velocity{};
+        std::array<float, 3> velocity_jitter{};
+        uint32_t color = 0xFFFFFFFF;
+        uint32_t count = 1;
+    };
+
+    // Instances [first_instance, first_instance + count) of the instance buffer
+    struct ParticleDrawRange {
+        ParticleTypeId type;
+        uint32_t first_instance;
+        uint32_t count;
+    };
+
+    // ==========================================
+    // PARTICLE SYSTEM
+    // ==========================================
+
+    struct ParticleConfig {
+        size_t batch_size = 4096;   // Particles per job, rounded to a multiple of 8
+        bool use_simd = true;       // AVX2 path when compiled in
+    };
+
+    struct ParticleStats {
+        uint32_t alive = 0;
+        uint32_t spawned = 0;       // Since the last update()
+        uint32_t died = 0;          // In the last update()
+        uint32_t dropped = 0;       // Spawns rejected because a pool was full, since the last update()
+        uint64_t instance_bytes = 0;
+    };
+
+    /**
+     * @brief SoA particle pools simulated eight at a time on the job system
+     *
+     * update() integrates, collides against the heightfield and compacts
+     * survivors into a second buffer in two passes over fixed batches, so
+     * particle order (and thus draw order) never depends on thread count.
+     * writeInstances() converts the pools straight into the upload ring.
+     * Emission and update() belong to one thread.
+     */
+    class ParticleSystem {
+    public:
+        explicit ParticleSystem(const ParticleConfig& config = {});
+
+        [[nodiscard]] ParticleTypeId registerType(const ParticleTypeDesc& desc);
+
+        // Returns how many particles were spawned (the rest didn't fit)
+        uint32_t emit(ParticleTypeId type, const ParticleBurst& burst);
+
+        void setHeightfield(const ParticleHeightfield* heightfield) noexcept { heightfield_ = heightfield; }
+        void setWind(const std::array<float, 3>& wind) noexcept { wind_ = wind; }
+
+        // jobs may be null for single-threaded simulation
+        void update(float dt, JobSystem* jobs);
+
+        // Stages every live particle into instance_buffer at dst_offset through the upload
+        // ring; false (and no draw ranges) when the ring can't take it this frame
+        bool writeInstances(UploadManager& uploads, GpuBufferHandle instance_buffer, uint64_t dst_offset, JobSystem* jobs);
+
+        void clear(ParticleTypeId type);
+
+        [[nodiscard]] uint32_t getAliveCount(ParticleTypeId type) const noexcept;
+        [[nodiscard]] uint64_t getInstanceBufferSize() const noexcept;  // Bytes for every pool at capacity
+        [[nodiscard]] std::span<const ParticleDrawRange> getDrawRanges() const noexcept { return draw_ranges_; }
+        [[nodiscard]] const ParticleStats& getStats() const noexcept { return stats_; }
+        [[nodiscard]] static bool isSimdAvailable() noexcept;
+
+    private:
+        struct ParticleSoA {
+            std::vector<float> px, py, pz;
+            std::vector<float> vx, vy, vz;
+            std::vector<float> age, lifetime, size;
+            std::vector<uint32_t> color;
+
+            void allocate(size_t capacity);
+        };
+
+        struct Pool {
+            ParticleTypeDesc desc;
+            ParticleSoA front;
+            ParticleSoA back;                  // Compaction target, swapped after update()
+            uint32_t count = 0;
+            uint32_t capacity = 0;
+            std::vector<uint32_t> batch_alive;    // Survivors per batch
+            std::vector<uint32_t> batch_offsets;  // Where each batch's survivors land
+        };
+
+        struct StepParams {
+            float dt;
+            float accel[3];
+            float damping;
+            float growth;
+        };
+
+        void simulateBatch(Pool& pool, const StepParams& step, size_t begin, size_t end, uint32_t& alive) const;
+        void compactBatch(Pool& pool, size_t begin, size_t end, uint32_t out_offset, uint32_t alive) const;
+
+    private:
+        ParticleConfig config_;
+        std::vector<Pool> pools_;
+        const ParticleHeightfield* heightfield_ = nullptr;
+        std::array<float, 3> wind_{};
+        std::vector<ParticleDrawRange> draw_ranges_;
+        uint32_t rng_state_ = 0x9E3779B9u;
+        uint32_t spawned_since_update_ = 0;
+        uint32_t dropped_since_update_ = 0;
+        bool simd_ = false;
+        ParticleStats stats_;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,90 @@
+#include "ashbornpch.h"
+
+#include "NullPipelineBackend.h"
+
+#include <cstring>
+#include <thread>
+
+namespace AshCore {
+
+    NullPipelineBackend::NullPipelineBackend(const PipelineDeviceInfo& device, std::chrono::microseconds compile_delay)
+        : device_(device)
+        , compile_delay_(compile_delay) {
+    }
+
+    std::expected<void, RendererError> NullPipelineBackend::createDriverCache(std::span<const std::byte> initial_data) {
+        std::lock_guard lock(mutex_);
+        cached_keys_.clear();
+        cache_order_.clear();
+
+        if (initial_data.size() % sizeof(uint64_t) != 0) {
+            return std::unexpected(RendererError::Unknown);
+        }
+        for (size_t pos = 0; pos < initial_data.size(); pos += sizeof(uint64_t)) {
+            uint64_t key = 0;
+            std::memcpy(&key, initial_data.data() + pos, sizeof(key));
+            if (cached_keys_.insert(key).second) cache_order_.push_back(key);
+        }
+        return {};
+    }
+
+    std::vector<std::byte> NullPipelineBackend::getDriverCacheData() {
+        std::lock_guard lock(mutex_);
+        const auto bytes = std::as_bytes(std::span(cache_order_));
+        return { bytes.begin(), bytes.end() };
+    }
+
+    std::expected<GpuPipelineHandle, RendererError> NullPipelineBackend::createGraphicsPipeline(const GraphicsPipelineDesc& desc) {
+        return create(desc, desc.vertex_shader);
+    }
+
+    std::expected<GpuPipelineHandle, RendererError> NullPipelineBackend::createComputePipeline(const ComputePipelineDesc& desc) {
+        return create(desc, desc.shader);
+    }
+
+    std::expected<GpuPipelineHandle, RendererError> NullPipelineBackend::create(const PipelineDesc& desc, uint64_t shader) {
+        if (shader == 0) {
+            return std::unexpected(RendererError::ShaderCompilationFailed);
+        }
+
+        const uint64_t key = PipelineKey::make(desc).hash;
+        bool cached = false;
+        {
+            std::lock_guard lock(mutex_);
+            cached = cached_keys_.contains(key);
+        }
+
+        if (!cached && compile_delay_.count() > 0) {
+            std::this_thread::sleep_for(compile_delay_);
+        }
+
+        std::lock_guard lock(mutex_);
+        ++creates_;
+        ++live_;
+        if (cached) ++cache_hits_;
+        else if (cached_keys_.insert(key).second) cache_order_.push_back(key);
+        return GpuPipelineHandle{ next_handle_++ };
+    }
+
+    void NullPipelineBackend::destroyPipeline(GpuPipelineHandle pipeline) {
+        if (!pipeline) return;
+        std::lock_guard lock(mutex_);
+        --live_;
+    }
+
+    uint32_t NullPipelineBackend::getCreateCount() const {
+        std::lock_guard lock(mutex_);
+        return creates_;
+    }
+
+    uint32_t NullPipelineBackend::getDriverCacheHits() const {
+        std::lock_guard lock(mutex_);
+        return cache_hits_;
+    }
+
+    uint32_t NullPipelineBackend::getLivePipelines() const {
+        std::lock_guard lock(mutex_);
+        return live_;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Pipeline/PipelineCache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // NULL PIPELINE BACKEND
+    // ==========================================
+
+    /**
+     * Simulates a driver: pipeline creation costs compile_delay unless the
+     * key is already in the driver cache, whose blob is simply the list of
+     * key hashes compiled so far. A shader hash of 0 fails like a missing
+     * module would. Lets cache behaviour be checked headless.
+     */
+    class NullPipelineBackend final : public IPipelineBackend {
+    public:
+        explicit NullPipelineBackend(const PipelineDeviceInfo& device = { 0x10DE, 0x2684, 1, {} },
+            std::chrono::microseconds compile_delay = std::chrono::microseconds(0));
+
+        [[nodiscard]] PipelineDeviceInfo getDeviceInfo() const override { return device_; }
+
+        [[nodiscard]] std::expected<void, RendererError> createDriverCache(std::span<const std::byte> initial_data) override;
+        [[nodiscard]] std::vector<std::byte> getDriverCacheData() override;
+
+        [[nodiscard]] std::expected<GpuPipelineHandle, RendererError> createGraphicsPipeline(const GraphicsPipelineDesc& desc) override;
+        [[nodiscard]] std::expected<GpuPipelineHandle, RendererError> createComputePipeline(const ComputePipelineDesc& desc) override;
+        void destroyPipeline(GpuPipelineHandle pipeline) override;
+
+        [[nodiscard]] uint32_t getCreateCount() const;
+        [[nodiscard]] uint32_t getDriverCacheHits() const;
+        [[nodiscard]] uint32_t getLivePipelines() const;
+
+    private:
+        std::expected<GpuPipelineHandle, RendererError> create(const PipelineDesc& desc, uint64_t shader);
+
+        PipelineDeviceInfo device_;
+        std::chrono::microseconds compile_delay_;
+
+        mutable std::mutex mutex_;
+        std::unordered_set<uint64_t> cached_keys_;
+        std::vector<uint64_t> cache_order_;  // Blob contents, in insertion order
+        uint64_t next_handle_ = 1;
+        uint32_t creates_ = 0;
+        uint32_t cache_hits_ = 0;
+        uint32_t live_ = 0;
+    };
+
+} // namespace AshCore
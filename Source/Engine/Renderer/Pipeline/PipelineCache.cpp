@@ -0,0 +1,625 @@
+#include "ashbornpch.h"
+
+#include "PipelineCache.h"
+#include "Hash/Hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint32_t DRIVER_CACHE_MAGIC = 0x43505341;  // "ASPC"
+        constexpr uint32_t PREWARM_MAGIC = 0x57505341;       // "ASPW"
+        constexpr uint32_t DRIVER_CACHE_VERSION = 2;
+        constexpr uint32_t KEY_FORMAT_VERSION = 2;           // Bump when key serialization changes
+
+        constexpr uint8_t KIND_GRAPHICS = 0;
+        constexpr uint8_t KIND_COMPUTE = 1;
+
+        struct DriverCacheHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendor_id;
+            uint32_t device_id;
+            uint32_t driver_version;
+            uint8_t cache_uuid[16];
+            uint32_t reserved;
+            uint64_t data_size;
+            uint64_t data_checksum;
+            uint64_t header_checksum;  // Over every field above
+        };
+        static_assert(sizeof(DriverCacheHeader) == 64);
+
+        struct PrewarmHeader {
+            uint32_t magic;
+            uint32_t key_version;
+            uint32_t count;
+            uint32_t reserved;
+            uint64_t payload_size;
+            uint64_t payload_checksum;
+        };
+        static_assert(sizeof(PrewarmHeader) == 32);
+
+        uint64_t headerChecksum(const DriverCacheHeader& header) noexcept {
+            return hash64(std::as_bytes(std::span(&header, 1)).first(offsetof(DriverCacheHeader, header_checksum)));
+        }
+
+        // ---- Little-endian key serialization
+
+        class ByteWriter {
+        public:
+            explicit ByteWriter(std::vector<std::byte>& out) : out_(out) {}
+
+            void u8(uint8_t value) { out_.push_back(static_cast<std::byte>(value)); }
+            void u16(uint16_t value) { u8(value & 0xFF); u8(value >> 8); }
+            void u32(uint32_t value) { u16(value & 0xFFFF); u16(value >> 16); }
+            void u64(uint64_t value) { u32(static_cast<uint32_t>(value)); u32(static_cast<uint32_t>(value >> 32)); }
+
+        private:
+            std::vector<std::byte>& out_;
+        };
+
+        class ByteReader {
+        public:
+            explicit ByteReader(std::span<const std::byte> data) : data_(data) {}
+
+            uint8_t u8() {
+                if (pos_ >= data_.size()) { ok_ = false; return 0; }
+                return static_cast<uint8_t>(data_[pos_++]);
+            }
+            uint16_t u16() { uint16_t lo = u8(); return static_cast<uint16_t>(lo | (u8() << 8)); }
+            uint32_t u32() { uint32_t lo = u16(); return lo | (static_cast<uint32_t>(u16()) << 16); }
+            uint64_t u64() { uint64_t lo = u32(); return lo | (static_cast<uint64_t>(u32()) << 32); }
+
+            // Counts are bounded by what could still fit, so corrupt input can't allocate wildly
+            uint32_t count(size_t min_element_size) {
+                const uint32_t value = u32();
+                if (value > (data_.size() - std::min(pos_, data_.size())) / min_element_size) ok_ = false;
+                return ok_ ? value : 0;
+            }
+
+            template<typename E>
+            E enumeration(E last) {
+                const uint8_t value = u8();
+                if (value > static_cast<uint8_t>(last)) ok_ = false;
+                return static_cast<E>(value);
+            }
+
+            [[nodiscard]] bool isComplete() const noexcept { return ok_ && pos_ == data_.size(); }
+
+        private:
+            std::span<const std::byte> data_;
+            size_t pos_ = 0;
+            bool ok_ = true;
+        };
+
+        std::vector<SpecializationConstant> canonicalSpecialization(std::vector<SpecializationConstant> constants) {
+            // Sorted by id; a repeated id keeps its last value
+            std::stable_sort(constants.begin(), constants.end(),
+                [](const SpecializationConstant& a, const SpecializationConstant& b) { return a.id < b.id; });
+
+            std::vector<SpecializationConstant> out;
+            for (const SpecializationConstant& constant : constants) {
+                if (!out.empty() && out.back().id == constant.id) out.back() = constant;
+                else out.push_back(constant);
+            }
+            return out;
+        }
+
+        void writeSpecialization(ByteWriter& writer, const std::vector<SpecializationConstant>& specialization) {
+            const auto constants = canonicalSpecialization(specialization);
+            writer.u32(static_cast<uint32_t>(constants.size()));
+            for (const SpecializationConstant& constant : constants) {
+                writer.u32(constant.id);
+                writer.u32(constant.value);
+            }
+        }
+
+        std::vector<SpecializationConstant> readSpecialization(ByteReader& reader) {
+            std::vector<SpecializationConstant> constants(reader.count(8));
+            for (SpecializationConstant& constant : constants) {
+                constant.id = reader.u32();
+                constant.value = reader.u32();
+            }
+            return constants;
+        }
+
+        void writeGraphics(ByteWriter& writer, const GraphicsPipelineDesc& desc) {
+            writer.u8(KIND_GRAPHICS);
+            writer.u64(desc.vertex_shader);
+            writer.u64(desc.fragment_shader);
+
+            auto bindings = desc.bindings;
+            std::sort(bindings.begin(), bindings.end(),
+                [](const VertexBindingDesc& a, const VertexBindingDesc& b) { return a.binding < b.binding; });
+            writer.u32(static_cast<uint32_t>(bindings.size()));
+            for (const VertexBindingDesc& binding : bindings) {
+                writer.u32(binding.binding);
+                writer.u32(binding.stride);
+                writer.u8(binding.per_instance);
+            }
+
+            auto attributes = desc.attributes;
+            std::sort(attributes.begin(), attributes.end(),
+                [](const VertexAttributeDesc& a, const VertexAttributeDesc& b) { return a.location < b.location; });
+            writer.u32(static_cast<uint32_t>(attributes.size()));
+            for (const VertexAttributeDesc& attribute : attributes) {
+                writer.u32(attribute.location);
+                writer.u32(attribute.binding);
+                writer.u8(static_cast<uint8_t>(attribute.format));
+                writer.u32(attribute.offset);
+            }
+
+            writer.u8(static_cast<uint8_t>(desc.topology));
+            writer.u8(static_cast<uint8_t>(desc.cull_mode));
+            writer.u8(desc.front_face_ccw);
+            writer.u8(desc.wireframe);
+
+            // Depth state is irrelevant once the test is off
+            writer.u8(desc.depth_test);
+            writer.u8(desc.depth_test && desc.depth_write);
+            writer.u8(static_cast<uint8_t>(desc.depth_test ? desc.depth_compare : CompareOp::Always));
+
+            writer.u32(static_cast<uint32_t>(desc.color_formats.size()));
+            for (size_t i = 0; i < desc.color_formats.size(); ++i) {
+                writer.u16(static_cast<uint16_t>(desc.color_formats[i]));
+
+                BlendAttachmentDesc blend = i < desc.blend.size() ? desc.blend[i] : BlendAttachmentDesc{};
+                if (!blend.enable) {
+                    const uint8_t mask = blend.write_mask;
+                    blend = {};
+                    blend.write_mask = mask;
+                }
+                writer.u8(blend.enable);
+                writer.u8(static_cast<uint8_t>(blend.src_color));
+                writer.u8(static_cast<uint8_t>(blend.dst_color));
+                writer.u8(static_cast<uint8_t>(blend.color_op));
+                writer.u8(static_cast<uint8_t>(blend.src_alpha));
+                writer.u8(static_cast<uint8_t>(blend.dst_alpha));
+                writer.u8(static_cast<uint8_t>(blend.alpha_op));
+                writer.u8(blend.write_mask & 0xF);
+            }
+
+            writer.u16(static_cast<uint16_t>(desc.depth_format));
+            writer.u32(std::max(desc.samples, 1u));
+            writer.u32(desc.push_constant_size);
+            writeSpecialization(writer, desc.specialization);
+        }
+
+        void writeCompute(ByteWriter& writer, const ComputePipelineDesc& desc) {
+            writer.u8(KIND_COMPUTE);
+            writer.u64(desc.shader);
+            writer.u32(desc.push_constant_size);
+            writeSpecialization(writer, desc.specialization);
+        }
+
+        GraphicsPipelineDesc readGraphics(ByteReader& reader) {
+            GraphicsPipelineDesc desc;
+            desc.vertex_shader = reader.u64();
+            desc.fragment_shader = reader.u64();
+
+            desc.bindings.resize(reader.count(9));
+            for (VertexBindingDesc& binding : desc.bindings) {
+                binding.binding = reader.u32();
+                binding.stride = reader.u32();
+                binding.per_instance = reader.u8() != 0;
+            }
+
+            desc.attributes.resize(reader.count(13));
+            for (VertexAttributeDesc& attribute : desc.attributes) {
+                attribute.location = reader.u32();
+                attribute.binding = reader.u32();
+                attribute.format = reader.enumeration(VertexFormat::Snorm8x4);
+                attribute.offset = reader.u32();
+            }
+
+            desc.topology = reader.enumeration(PrimitiveTopology::PointList);
+            desc.cull_mode = reader.enumeration(CullMode::Back);
+            desc.front_face_ccw = reader.u8() != 0;
+            desc.wireframe = reader.u8() != 0;
+
+            desc.depth_test = reader.u8() != 0;
+            desc.depth_write = reader.u8() != 0;
+            desc.depth_compare = reader.enumeration(CompareOp::Always);
+
+            const uint32_t color_count = reader.count(10);
+            desc.color_formats.resize(color_count);
+            desc.blend.resize(color_count);
+            for (uint32_t i = 0; i < color_count; ++i) {
+                desc.color_formats[i] = static_cast<RenderFormat>(reader.u16());
+                BlendAttachmentDesc& blend = desc.blend[i];
+                blend.enable = reader.u8() != 0;
+                blend.src_color = reader.enumeration(BlendFactor::OneMinusDstAlpha);
+                blend.dst_color = reader.enumeration(BlendFactor::OneMinusDstAlpha);
+                blend.color_op = reader.enumeration(BlendOp::Max);
+                blend.src_alpha = reader.enumeration(BlendFactor::OneMinusDstAlpha);
+                blend.dst_alpha = reader.enumeration(BlendFactor::OneMinusDstAlpha);
+                blend.alpha_op = reader.enumeration(BlendOp::Max);
+                blend.write_mask = reader.u8();
+            }
+
+            desc.depth_format = static_cast<RenderFormat>(reader.u16());
+            desc.samples = reader.u32();
+            desc.push_constant_size = reader.u32();
+            desc.specialization = readSpecialization(reader);
+            return desc;
+        }
+
+        ComputePipelineDesc readCompute(ByteReader& reader) {
+            ComputePipelineDesc desc;
+            desc.shader = reader.u64();
+            desc.push_constant_size = reader.u32();
+            desc.specialization = readSpecialization(reader);
+            return desc;
+        }
+
+        std::optional<std::vector<std::byte>> readFile(const std::filesystem::path& path) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file) return std::nullopt;
+
+            const std::streamsize size = file.tellg();
+            if (size < 0) return std::nullopt;
+
+            std::vector<std::byte> data(static_cast<size_t>(size));
+            file.seekg(0);
+            if (!file.read(reinterpret_cast<char*>(data.data()), size)) return std::nullopt;
+            return data;
+        }
+
+        // Write-then-rename so a crash mid-save never leaves a torn file behind
+        bool writeFileAtomic(const std::filesystem::path& path, std::span<const std::byte> header, std::span<const std::byte> payload) {
+            std::filesystem::path temp = path;
+            temp += ".tmp";
+            {
+                std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+                if (!file) return false;
+                file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+                file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+                if (!file) return false;
+            }
+
+            std::error_code error;
+            std::filesystem::rename(temp, path, error);
+            return !error;
+        }
+    }
+
+    // ==========================================
+    // PIPELINE KEY
+    // ==========================================
+
+    PipelineKey PipelineKey::make(const PipelineDesc& desc) {
+        PipelineKey key;
+        key.bytes.reserve(128);
+
+        ByteWriter writer(key.bytes);
+        if (const auto* graphics = std::get_if<GraphicsPipelineDesc>(&desc)) writeGraphics(writer, *graphics);
+        else writeCompute(writer, std::get<ComputePipelineDesc>(desc));
+
+        key.hash = hash64(key.bytes);
+        return key;
+    }
+
+    std::optional<PipelineDesc> PipelineKey::decode(std::span<const std::byte> bytes) {
+        ByteReader reader(bytes);
+
+        PipelineDesc desc;
+        switch (reader.u8()) {
+        case KIND_GRAPHICS: desc = readGraphics(reader); break;
+        case KIND_COMPUTE: desc = readCompute(reader); break;
+        default: return std::nullopt;
+        }
+
+        if (!reader.isComplete()) return std::nullopt;
+        return desc;
+    }
+
+    // ==========================================
+    // CONSTRUCTOR / DESTRUCTOR
+    // ==========================================
+
+    PipelineCache::PipelineCache(IPipelineBackend& backend, JobSystem& jobs, const RendererConfig& renderer_config,
+        const PipelineCacheConfig& config)
+        : backend_(backend)
+        , jobs_(jobs)
+        , config_(config)
+        , cache_dir_(renderer_config.shader_cache_path) {
+    }
+
+    PipelineCache::~PipelineCache() {
+        waitAll();
+
+        for (Entry& entry : entries_) {
+            if (entry.state.load(std::memory_order_acquire) == EntryState::Ready) {
+                backend_.destroyPipeline(GpuPipelineHandle{ entry.pipeline.load(std::memory_order_relaxed) });
+            }
+        }
+    }
+
+    std::expected<void, RendererError> PipelineCache::initialize() {
+        std::error_code error;
+        std::filesystem::create_directories(cache_dir_, error);
+        if (error) {
+            print_w("Pipeline cache directory unavailable, caching in memory only", LogContext{
+                {"path", cache_dir_.string()},
+                {"error", error.message()}
+                });
+        }
+
+        loadDriverCache();
+        if (!driver_cache_loaded_) {
+            if (auto result = backend_.createDriverCache({}); !result) {
+                print_e("Failed to create driver pipeline cache");
+                return result;
+            }
+        }
+
+        loadPrewarmList();
+
+        print_s("Pipeline cache initialized", LogContext{
+            {"driver_cache_kb", driver_cache_bytes_ / 1024},
+            {"prewarming", prewarmed_}
+            });
+        return {};
+    }
+
+    // ==========================================
+    // PERSISTENCE
+    // ==========================================
+
+    void PipelineCache::loadDriverCache() {
+        const auto path = cache_dir_ / config_.driver_cache_file;
+        auto data = readFile(path);
+        if (!data) return;
+
+        const PipelineDeviceInfo device = backend_.getDeviceInfo();
+        DriverCacheHeader header{};
+        const char* reason = nullptr;
+
+        if (data->size() < sizeof(header)) {
+            reason = "truncated";
+        }
+        else {
+            std::memcpy(&header, data->data(), sizeof(header));
+            const auto payload = std::span(*data).subspan(sizeof(header));
+
+            if (header.magic != DRIVER_CACHE_MAGIC || header.version != DRIVER_CACHE_VERSION || header.header_checksum != headerChecksum(header)) {
+                reason = "bad header";
+            }
+            else if (header.vendor_id != device.vendor_id || header.device_id != device.device_id ||
+                header.driver_version != device.driver_version ||
+                std::memcmp(header.cache_uuid, device.cache_uuid.data(), sizeof(header.cache_uuid)) != 0) {
+                reason = "different device or driver";
+            }
+            else if (header.data_size != payload.size() || header.data_checksum != hash64(payload)) {
+                reason = "checksum mismatch";
+            }
+            else if (!backend_.createDriverCache(payload)) {
+                reason = "rejected by driver";
+            }
+            else {
+                driver_cache_loaded_ = true;
+                driver_cache_bytes_ = payload.size();
+            }
+        }
+
+        if (reason) {
+            print_i("Discarding pipeline cache", LogContext{ {"path", path.string()}, {"reason", reason} });
+        }
+    }
+
+    void PipelineCache::loadPrewarmList() {
+        auto data = readFile(cache_dir_ / config_.prewarm_file);
+        if (!data || data->size() < sizeof(PrewarmHeader)) return;
+
+        PrewarmHeader header{};
+        std::memcpy(&header, data->data(), sizeof(header));
+        const auto payload = std::span(*data).subspan(sizeof(header));
+
+        if (header.magic != PREWARM_MAGIC || header.key_version != KEY_FORMAT_VERSION ||
+            header.payload_size != payload.size() || header.payload_checksum != hash64(payload)) {
+            print_i("Discarding stale pipeline prewarm list");
+            return;
+        }
+
+        size_t pos = 0;
+        for (uint32_t i = 0; i < header.count && pos + 4 <= payload.size(); ++i) {
+            uint32_t size = 0;
+            std::memcpy(&size, payload.data() + pos, 4);
+            pos += 4;
+            if (size > payload.size() - pos) break;
+
+            const auto bytes = payload.subspan(pos, size);
+            pos += size;
+
+            if (auto desc = PipelineKey::decode(bytes)) {
+                findOrInsert(PipelineKey::make(*desc), *desc, true);
+            }
+        }
+    }
+
+    std::expected<void, RendererError> PipelineCache::save() {
+        bool ok = true;
+
+        // ---- Driver blob
+        const std::vector<std::byte> blob = backend_.getDriverCacheData();
+        if (!blob.empty()) {
+            const PipelineDeviceInfo device = backend_.getDeviceInfo();
+
+            DriverCacheHeader header{};
+            header.magic = DRIVER_CACHE_MAGIC;
+            header.version = DRIVER_CACHE_VERSION;
+            header.vendor_id = device.vendor_id;
+            header.device_id = device.device_id;
+            header.driver_version = device.driver_version;
+            std::memcpy(header.cache_uuid, device.cache_uuid.data(), sizeof(header.cache_uuid));
+            header.data_size = blob.size();
+            header.data_checksum = hash64(blob);
+            header.header_checksum = headerChecksum(header);
+
+            ok &= writeFileAtomic(cache_dir_ / config_.driver_cache_file, std::as_bytes(std::span(&header, 1)), blob);
+        }
+
+        // ---- Prewarm list: pipelines used this session first, then older ones still worth keeping
+        std::vector<std::byte> payload;
+        uint32_t count = 0;
+        {
+            std::lock_guard lock(mutex_);
+            for (int pass = 0; pass < 2; ++pass) {
+                for (const Entry& entry : entries_) {
+                    const bool wanted = pass == 0 ? entry.used_this_session : (!entry.used_this_session && entry.prewarmed);
+                    if (!wanted || entry.state.load(std::memory_order_acquire) == EntryState::Failed) continue;
+                    if (count >= config_.max_prewarm_entries) break;
+
+                    const uint32_t size = static_cast<uint32_t>(entry.key.bytes.size());
+                    const auto* size_bytes = reinterpret_cast<const std::byte*>(&size);
+                    payload.insert(payload.end(), size_bytes, size_bytes + 4);
+                    payload.insert(payload.end(), entry.key.bytes.begin(), entry.key.bytes.end());
+                    ++count;
+                }
+            }
+        }
+
+        PrewarmHeader header{};
+        header.magic = PREWARM_MAGIC;
+        header.key_version = KEY_FORMAT_VERSION;
+        header.count = count;
+        header.payload_size = payload.size();
+        header.payload_checksum = hash64(payload);
+        ok &= writeFileAtomic(cache_dir_ / config_.prewarm_file, std::as_bytes(std::span(&header, 1)), payload);
+
+        if (!ok) {
+            print_w("Failed to write pipeline cache", LogContext{ {"path", cache_dir_.string()} });
+            return std::unexpected(RendererError::Unknown);
+        }
+
+        print_i("Pipeline cache saved", LogContext{ {"driver_cache_kb", blob.size() / 1024}, {"prewarm_entries", count} });
+        return {};
+    }
+
+    // ==========================================
+    // REQUESTS
+    // ==========================================
+
+    PipelineId PipelineCache::request(const PipelineDesc& desc) {
+        return findOrInsert(PipelineKey::make(desc), desc, false);
+    }
+
+    PipelineId PipelineCache::findOrInsert(PipelineKey key, const PipelineDesc& desc, bool prewarm) {
+        PipelineId id;
+        {
+            std::lock_guard lock(mutex_);
+
+            auto& bucket = by_hash_[key.hash];
+            for (uint32_t index : bucket) {
+                Entry& entry = entries_[index];
+                if (entry.key.bytes == key.bytes) {
+                    if (!prewarm) {
+                        entry.used_this_session = true;
+                        ++hits_;
+                    }
+                    return PipelineId{ index };
+                }
+            }
+
+            id.value = static_cast<uint32_t>(entries_.size());
+            Entry* created = &entries_.emplace_back();
+            created->key = std::move(key);
+            created->desc = desc;
+            created->used_this_session = !prewarm;
+            created->prewarmed = prewarm;
+            bucket.push_back(id.value);
+
+            if (prewarm) ++prewarmed_;
+            else ++misses_;
+
+            // Submitted under the lock: once another thread can find the entry,
+            // its counter already covers the compile, so wait() cannot return early
+            jobs_.submit(created->counter, [this, created]() { compile(*created); });
+        }
+        return id;
+    }
+
+    void PipelineCache::compile(Entry& entry) {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::expected<GpuPipelineHandle, RendererError> result = std::visit([this](const auto& desc) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(desc)>, GraphicsPipelineDesc>) return backend_.createGraphicsPipeline(desc);
+            else return backend_.createComputePipeline(desc);
+            }, entry.desc);
+
+        compile_ns_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+            std::memory_order_relaxed);
+
+        if (!result) {
+            print_e("Pipeline creation failed", LogContext{ {"key", entry.key.hash} });
+            entry.state.store(EntryState::Failed, std::memory_order_release);
+            return;
+        }
+
+        entry.pipeline.store(result->value, std::memory_order_relaxed);
+        entry.state.store(EntryState::Ready, std::memory_order_release);
+    }
+
+    GpuPipelineHandle PipelineCache::getPipeline(PipelineId id) const {
+        std::lock_guard lock(mutex_);
+        if (id.value >= entries_.size()) return {};
+
+        const Entry& entry = entries_[id.value];
+        if (entry.state.load(std::memory_order_acquire) != EntryState::Ready) return {};
+        return GpuPipelineHandle{ entry.pipeline.load(std::memory_order_relaxed) };
+    }
+
+    bool PipelineCache::isReady(PipelineId id) const {
+        return getPipeline(id).isValid();
+    }
+
+    GpuPipelineHandle PipelineCache::wait(PipelineId id) {
+        Entry* entry = nullptr;
+        {
+            std::lock_guard lock(mutex_);
+            if (id.value >= entries_.size()) return {};
+            entry = &entries_[id.value];
+        }
+
+        jobs_.wait(entry->counter);
+        return getPipeline(id);
+    }
+
+    void PipelineCache::waitAll() {
+        std::vector<Entry*> pending;
+        {
+            std::lock_guard lock(mutex_);
+            for (Entry& entry : entries_) {
+                if (!entry.counter.isDone()) pending.push_back(&entry);
+            }
+        }
+        for (Entry* entry : pending) {
+            jobs_.wait(entry->counter);
+        }
+    }
+
+    PipelineCacheStats PipelineCache::getStats() const {
+        std::lock_guard lock(mutex_);
+
+        PipelineCacheStats stats;
+        stats.pipelines = static_cast<uint32_t>(entries_.size());
+        for (const Entry& entry : entries_) {
+            switch (entry.state.load(std::memory_order_acquire)) {
+            case EntryState::Pending: ++stats.pending; break;
+            case EntryState::Ready: ++stats.ready; break;
+            case EntryState::Failed: ++stats.failed; break;
+            }
+        }
+        stats.prewarmed = prewarmed_;
+        stats.hits = hits_;
+        stats.misses = misses_;
+        stats.driver_cache_loaded = driver_cache_loaded_;
+        stats.driver_cache_bytes = driver_cache_bytes_;
+        stats.compile_time = std::chrono::nanoseconds(compile_ns_.load(std::memory_order_relaxed));
+        return stats;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "RenderTypes.h"
+#include "RenderGraph/RenderGraph.h"
+#include "Jobs/JobSystem.h"
+#include "Engine/AshbornEngine.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // PIPELINE STATE DESCRIPTION
+    // ==========================================
+
+    enum class VertexFormat : uint8_t {
+        Float,
+        Float2,
+        Float3,
+        Float4,
+        Uint,
+        Uint2,
+        Uint4,
+        Unorm8x4,
+        Snorm8x4
+    };
+
+    enum class PrimitiveTopology : uint8_t {
+        TriangleList,
+        TriangleStrip,
+        LineList,
+        PointList
+    };
+
+    enum class CullMode : uint8_t {
+        None,
+        Front,
+        Back
+    };
+
+    enum class CompareOp : uint8_t {
+        Never,
+        Less,
+        Equal,
+        LessOrEqual,
+        Greater,
+        NotEqual,
+        GreaterOrEqual,
+        Always
+    };
+
+    enum class BlendFactor : uint8_t {
+        Zero,
+        One,
+        SrcColor,
+        OneMinusSrcColor,
+        SrcAlpha,
+        OneMinusSrcAlpha,
+        DstColor,
+        OneMinusDstColor,
+        DstAlpha,
+        OneMinusDstAlpha
+    };
+
+    enum class BlendOp : uint8_t {
+        Add,
+        Subtract,
+        ReverseSubtract,
+        Min,
+        Max
+    };
+
+    struct VertexBindingDesc {
+        uint32_t binding = 0;
+        uint32_t stride = 0;
+        bool per_instance = false;
+    };
+
+    struct VertexAttributeDesc {
+        uint32_t location = 0;
+        uint32_t binding = 0;
+        VertexFormat format = VertexFormat::Float3;
+        uint32_t offset = 0;
+    };
+
+    struct BlendAttachmentDesc {
+        bool enable = false;
+        BlendFactor src_color = BlendFactor::One;
+        BlendFactor dst_color = BlendFactor::Zero;
+        BlendOp color_op = BlendOp::Add;
+        BlendFactor src_alpha = BlendFactor::One;
+        BlendFactor dst_alpha = BlendFactor::Zero;
+        BlendOp alpha_op = BlendOp::Add;
+        uint8_t write_mask = 0xF;  // RGBA
+    };
+
+    struct SpecializationConstant {
+        uint32_t id = 0;
+        uint32_t value = 0;
+    };
+
+    // Shaders are referenced by the content hash of their SPIR-V module
+    struct GraphicsPipelineDesc {
+        uint64_t vertex_shader = 0;
+        uint64_t fragment_shader = 0;
+
+        std::vector<VertexBindingDesc> bindings;
+        std::vector<VertexAttributeDesc> attributes;
+
+        PrimitiveTopology topology = PrimitiveTopology::TriangleList;
+        CullMode cull_mode = CullMode::Back;
+        bool front_face_ccw = true;
+        bool wireframe = false;
+
+        bool depth_test = true;
+        bool depth_write = true;
+        CompareOp depth_compare = CompareOp::Greater;  // Reverse-Z
+
+        std::vector<RenderFormat> color_formats;
+        std::vector<BlendAttachmentDesc> blend;        // Per color attachment; missing entries = opaque
+        RenderFormat depth_format = RenderFormat::D32Float;
+        uint32_t samples = 1;
+
+        uint32_t push_constant_size = 0;
+        std::vector<SpecializationConstant> specialization;
+    };
+
+    struct ComputePipelineDesc {
+        uint64_t shader = 0;
+        uint32_t push_constant_size = 0;
+        std::vector<SpecializationConstant> specialization;
+    };
+
+    using PipelineDesc = std::variant<GraphicsPipelineDesc, ComputePipelineDesc>;
+
+    /**
+     * @brief Canonical, hashable form of a pipeline description
+     *
+     * Two descriptions that create the same pipeline (attribute order,
+     * blend factors of disabled attachments, compare op with depth test
+     * off, ...) produce identical bytes, so they share one pipeline.
+     */
+    struct PipelineKey {
+        uint64_t hash = 0;
+        std::vector<std::byte> bytes;
+
+        [[nodiscard]] static PipelineKey make(const PipelineDesc& desc);
+        [[nodiscard]] static std::optional<PipelineDesc> decode(std::span<const std::byte> bytes);
+
+        bool operator==(const PipelineKey& other) const noexcept { return hash == other.hash && bytes == other.bytes; }
+    };
+
+    // ==========================================
+    // BACKEND INTERFACE
+    // ==========================================
+
+    // Identifies which device/driver a saved cache blob belongs to. This is
+    // what VkPipelineCacheHeaderVersionOne itself carries (vendorID, deviceID,
+    // pipelineCacheUUID) plus driverVersion, rather than the deviceUUID /
+    // driverUUID of VkPhysicalDeviceIDProperties: pipelineCacheUUID is the
+    // value drivers bump when their cache format changes, and it needs no
+    // Vulkan 1.1 properties2 query.
+    struct PipelineDeviceInfo {
+        uint32_t vendor_id = 0;
+        uint32_t device_id = 0;
+        uint32_t driver_version = 0;
+        std::array<uint8_t, 16> cache_uuid{};  // VkPhysicalDeviceProperties::pipelineCacheUUID
+    };
+
+    // Pipeline creation is called from job workers and must be thread-safe
+    // (a single VkPipelineCache is internally synchronized)
+    class IPipelineBackend {
+    public:
+        virtual ~IPipelineBackend() = default;
+
+        [[nodiscard]] virtual PipelineDeviceInfo getDeviceInfo() const = 0;
+
+        // initial_data is empty when there is no valid blob for this device
+        [[nodiscard]] virtual std::expected<void, RendererError> createDriverCache(std::span<const std::byte> initial_data) = 0;
+        [[nodiscard]] virtual std::vector<std::byte> getDriverCacheData() = 0;
+
+        [[nodiscard]] virtual std::expected<GpuPipelineHandle, RendererError> createGraphicsPipeline(const GraphicsPipelineDesc& desc) = 0;
+        [[nodiscard]] virtual std::expected<GpuPipelineHandle, RendererError> createComputePipeline(const ComputePipelineDesc& desc) = 0;
+        virtual void destroyPipeline(GpuPipelineHandle pipeline) = 0;
+    };
+
+    // ==========================================
+    // PIPELINE CACHE
+    // ==========================================
+
+    struct PipelineCacheConfig {
+        const char* driver_cache_file = "pipeline_cache.bin";
+        const char* prewarm_file = "pipeline_prewarm.bin";
+        uint32_t max_prewarm_entries = 4096;
+    };
+
+    // Stable id of a pipeline in the cache; resolves to a GpuPipelineHandle once compiled
+    struct PipelineId {
+        uint32_t value = UINT32_MAX;
+        [[nodiscard]] bool isValid() const noexcept { return value != UINT32_MAX; }
+        bool operator==(const PipelineId&) const noexcept = default;
+    };
+
+    struct PipelineCacheStats {
+        uint32_t pipelines = 0;
+        uint32_t ready = 0;
+        uint32_t pending = 0;
+        uint32_t failed = 0;
+        uint32_t prewarmed = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        bool driver_cache_loaded = false;
+        uint64_t driver_cache_bytes = 0;
+        std::chrono::nanoseconds compile_time{};  // Summed over workers
+    };
+
+    /**
+     * @brief De-duplicated, asynchronously compiled pipelines with a persistent cache
+     *
+     * request() never blocks: a miss queues compilation on the JobSystem and
+     * getPipeline() returns an invalid handle until it finishes. The driver
+     * blob and the list of pipelines used this session are written under
+     * RendererConfig::shader_cache_path; the blob is only fed back to a
+     * device with the same PipelineDeviceInfo, and both files carry
+     * checksums so truncated writes are ignored.
+     */
+    class PipelineCache {
+    public:
+        PipelineCache(IPipelineBackend& backend, JobSystem& jobs, const RendererConfig& renderer_config,
+            const PipelineCacheConfig& config = {});
+        ~PipelineCache();
+
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        // Loads the driver blob and starts compiling last session's pipelines
+        [[nodiscard]] std::expected<void, RendererError> initialize();
+
+        // Writes the driver blob and prewarm list (call before device destruction)
+        [[nodiscard]] std::expected<void, RendererError> save();
+
+        [[nodiscard]] PipelineId request(const PipelineDesc& desc);
+
+        [[nodiscard]] GpuPipelineHandle getPipeline(PipelineId id) const;
+        [[nodiscard]] bool isReady(PipelineId id) const;
+
+        // Blocks (helping the job system) until the pipeline is compiled or
+        // failed; an id returned by request() is never seen as done earlier
+        GpuPipelineHandle wait(PipelineId id);
+        void waitAll();
+
+        [[nodiscard]] PipelineCacheStats getStats() const;
+
+    private:
+        enum class EntryState : uint8_t {
+            Pending,
+            Ready,
+            Failed
+        };
+
+        struct Entry {
+            PipelineKey key;
+            PipelineDesc desc;
+            std::atomic<EntryState> state{ EntryState::Pending };
+            std::atomic<uint64_t> pipeline{ 0 };
+            JobCounter counter;
+            bool used_this_session = false;
+            bool prewarmed = false;
+        };
+
+        PipelineId findOrInsert(PipelineKey key, const PipelineDesc& desc, bool prewarm);
+        void compile(Entry& entry);
+
+        void loadDriverCache();
+        void loadPrewarmList();
+
+    private:
+        IPipelineBackend& backend_;
+        JobSystem& jobs_;
+        PipelineCacheConfig config_;
+        std::filesystem::path cache_dir_;
+
+        mutable std::mutex mutex_;
+        std::deque<Entry> entries_;                                    // Stable addresses for jobs
+        std::unordered_map<uint64_t, std::vector<uint32_t>> by_hash_;  // Key hash -> entries
+
+        uint64_t hits_ = 0;
+        uint64_t misses_ = 0;
+        uint32_t prewarmed_ = 0;
+        bool driver_cache_loaded_ = false;
+        uint64_t driver_cache_bytes_ = 0;
+        std::atomic<int64_t> compile_ns_{ 0 };
+    };
+
+} // namespace AshCore
@@ -0,0 +1,56 @@
+#include "ashbornpch.h"
+
+#include "NullRenderGraphBackend.h"
+
+#include <algorithm>
+
+namespace AshCore {
+
+    RGMemoryRequirements NullRenderGraphBackend::getTextureRequirements(const RGTextureDesc& desc) {
+        // Full mip chain upper bound, 64 KB alignment like most discrete GPUs
+        uint64_t size = 0;
+        uint64_t width = desc.width;
+        uint64_t height = desc.height;
+        for (uint32_t mip = 0; mip < std::max(desc.mip_levels, 1u); ++mip) {
+            size += width * height;
+            width = std::max<uint64_t>(width / 2, 1);
+            height = std::max<uint64_t>(height / 2, 1);
+        }
+        size *= uint64_t(getFormatSize(desc.format)) * std::max(desc.array_layers, 1u) * std::max(desc.samples, 1u);
+        return { size, 64 * 1024 };
+    }
+
+    RGMemoryRequirements NullRenderGraphBackend::getBufferRequirements(const RGBufferDesc& desc) {
+        return { desc.size, 256 };
+    }
+
+    std::expected<void, RendererError> NullRenderGraphBackend::reserveTransientMemory(RGResourceKind kind, uint64_t size) {
+        if (memory_limit_ != 0 && size > memory_limit_) {
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+        uint64_t& reserved = reserved_[static_cast<size_t>(kind)];
+        reserved = std::max(reserved, size);
+        return {};
+    }
+
+    std::expected<GpuImageHandle, RendererError> NullRenderGraphBackend::createTransientImage(const RGTextureDesc&, uint64_t) {
+        return GpuImageHandle{ next_handle_++ };
+    }
+
+    std::expected<GpuBufferHandle, RendererError> NullRenderGraphBackend::createTransientBuffer(const RGBufferDesc&, uint64_t) {
+        return GpuBufferHandle{ next_handle_++ };
+    }
+
+    void NullRenderGraphBackend::recordBarriers(std::span<const RenderGraphBarrier> barriers) {
+        events_.push_back({ EventType::Barriers, {}, { barriers.begin(), barriers.end() } });
+    }
+
+    void NullRenderGraphBackend::beginPass(std::string_view name) {
+        events_.push_back({ EventType::BeginPass, std::string(name), {} });
+    }
+
+    void NullRenderGraphBackend::endPass() {
+        events_.push_back({ EventType::EndPass, {}, {} });
+    }
+
+} // namespace AshCore
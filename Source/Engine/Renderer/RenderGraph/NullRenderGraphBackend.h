@@ -0,0 +1,55 @@
+#pragma once
+
+#include "RenderGraph/RenderGraph.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // NULL RENDER GRAPH BACKEND
+    // ==========================================
+
+    // Records what the graph asked for instead of talking to a GPU (headless runs, graph tests, benchmarks)
+    class NullRenderGraphBackend final : public IRenderGraphBackend {
+    public:
+        enum class EventType : uint8_t {
+            Barriers,
+            BeginPass,
+            EndPass
+        };
+
+        struct Event {
+            EventType type;
+            std::string pass;                          // BeginPass
+            std::vector<RenderGraphBarrier> barriers;  // Barriers
+        };
+
+        [[nodiscard]] RGMemoryRequirements getTextureRequirements(const RGTextureDesc& desc) override;
+        [[nodiscard]] RGMemoryRequirements getBufferRequirements(const RGBufferDesc& desc) override;
+
+        [[nodiscard]] std::expected<void, RendererError> reserveTransientMemory(RGResourceKind kind, uint64_t size) override;
+        [[nodiscard]] std::expected<GpuImageHandle, RendererError> createTransientImage(const RGTextureDesc& desc, uint64_t heap_offset) override;
+        [[nodiscard]] std::expected<GpuBufferHandle, RendererError> createTransientBuffer(const RGBufferDesc& desc, uint64_t heap_offset) override;
+
+        void recordBarriers(std::span<const RenderGraphBarrier> barriers) override;
+        void beginPass(std::string_view name) override;
+        void endPass() override;
+
+        // Fails reservations above this many bytes per heap (0 = unlimited)
+        void setMemoryLimit(uint64_t bytes) noexcept { memory_limit_ = bytes; }
+
+        [[nodiscard]] const std::vector<Event>& getEvents() const noexcept { return events_; }
+        [[nodiscard]] uint64_t getReservedBytes(RGResourceKind kind) const noexcept { return reserved_[static_cast<size_t>(kind)]; }
+        void clearEvents() { events_.clear(); }
+
+    private:
+        std::vector<Event> events_;
+        uint64_t reserved_[2] = { 0, 0 };
+        uint64_t memory_limit_ = 0;
+        uint64_t next_handle_ = 1ull << 32;  // Clear of imported test handles
+    };
+
+} // namespace AshCore
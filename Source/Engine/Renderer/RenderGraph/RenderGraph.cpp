@@ -0,0 +1,702 @@
+#include "ashbornpch.h"
+
+#include "RenderGraph.h"
+
+#include <algorithm>
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint32_t NO_PASS = UINT32_MAX;
+        constexpr uint32_t ALL_BITS = UINT32_MAX;
+
+        struct AccessInfo {
+            uint32_t stages;
+            uint32_t read_access;   // Used by read() / readWrite()
+            uint32_t write_access;  // Used by write() / readWrite()
+            RGLayout layout;        // Textures only
+            bool texture_only;
+            bool buffer_only;
+        };
+
+        // Indexed by RGAccess
+        constexpr AccessInfo ACCESS_INFO[] = {
+            // ColorAttachment
+            { RGStage::ColorAttachmentOutput, RGAccessBits::ColorAttachmentRead, RGAccessBits::ColorAttachmentWrite,
+              RGLayout::ColorAttachment, true, false },
+            // DepthAttachment
+            { RGStage::EarlyFragmentTests | RGStage::LateFragmentTests, RGAccessBits::DepthStencilRead, RGAccessBits::DepthStencilWrite,
+              RGLayout::DepthStencilAttachment, true, false },
+            // DepthReadOnly
+            { RGStage::EarlyFragmentTests | RGStage::LateFragmentTests, RGAccessBits::DepthStencilRead, RGAccessBits::None,
+              RGLayout::DepthStencilReadOnly, true, false },
+            // SampledFragment
+            { RGStage::FragmentShader, RGAccessBits::ShaderSampledRead, RGAccessBits::None,
+              RGLayout::ShaderReadOnly, true, false },
+            // SampledCompute
+            { RGStage::ComputeShader, RGAccessBits::ShaderSampledRead, RGAccessBits::None,
+              RGLayout::ShaderReadOnly, true, false },
+            // StorageFragment
+            { RGStage::FragmentShader, RGAccessBits::ShaderStorageRead, RGAccessBits::ShaderStorageWrite,
+              RGLayout::General, false, false },
+            // StorageCompute
+            { RGStage::ComputeShader, RGAccessBits::ShaderStorageRead, RGAccessBits::ShaderStorageWrite,
+              RGLayout::General, false, false },
+            // UniformBuffer
+            { RGStage::VertexShader | RGStage::FragmentShader | RGStage::ComputeShader, RGAccessBits::UniformRead, RGAccessBits::None,
+              RGLayout::Undefined, false, true },
+            // VertexBuffer
+            { RGStage::VertexInput, RGAccessBits::VertexAttributeRead, RGAccessBits::None,
+              RGLayout::Undefined, false, true },
+            // IndexBuffer
+            { RGStage::VertexInput, RGAccessBits::IndexRead, RGAccessBits::None,
+              RGLayout::Undefined, false, true },
+            // IndirectArgs
+            { RGStage::DrawIndirect, RGAccessBits::IndirectCommandRead, RGAccessBits::None,
+              RGLayout::Undefined, false, true },
+            // TransferSrc
+            { RGStage::Transfer, RGAccessBits::TransferRead, RGAccessBits::None,
+              RGLayout::TransferSrc, false, false },
+            // TransferDst
+            { RGStage::Transfer, RGAccessBits::None, RGAccessBits::TransferWrite,
+              RGLayout::TransferDst, false, false },
+        };
+
+        const AccessInfo& getAccessInfo(RGAccess access) noexcept {
+            return ACCESS_INFO[static_cast<size_t>(access)];
+        }
+
+        uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept {
+            return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+        }
+
+        bool overlaps(uint32_t first_a, uint32_t last_a, uint32_t first_b, uint32_t last_b) noexcept {
+            return first_a <= last_b && first_b <= last_a;
+        }
+    }
+
+    // ==========================================
+    // FORMATS
+    // ==========================================
+
+    uint32_t getFormatSize(RenderFormat format) noexcept {
+        switch (format) {
+        case RenderFormat::RGBA8Unorm:
+        case RenderFormat::RGBA8Srgb:
+        case RenderFormat::BGRA8Srgb:
+        case RenderFormat::RG16Float:
+        case RenderFormat::R32Float:
+        case RenderFormat::R32Uint:
+        case RenderFormat::D32Float:
+        case RenderFormat::D24UnormS8:
+            return 4;
+        case RenderFormat::RGBA16Float:
+            return 8;
+        case RenderFormat::RGBA32Float:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    bool isDepthFormat(RenderFormat format) noexcept {
+        return format == RenderFormat::D32Float || format == RenderFormat::D24UnormS8;
+    }
+
+    // ==========================================
+    // BUILDER / CONTEXT
+    // ==========================================
+
+    RGResource RenderGraphBuilder::createTexture(std::string_view name, const RGTextureDesc& desc) {
+        RGResource handle = graph_.addResource(name, RGResourceKind::Texture);
+        graph_.resources_[handle.index].texture = desc;
+        return handle;
+    }
+
+    RGResource RenderGraphBuilder::createBuffer(std::string_view name, const RGBufferDesc& desc) {
+        RGResource handle = graph_.addResource(name, RGResourceKind::Buffer);
+        graph_.resources_[handle.index].buffer = desc;
+        return handle;
+    }
+
+    RGResource RenderGraphBuilder::read(RGResource resource, RGAccess access) {
+        return graph_.recordAccess(pass_, resource, access, true, false);
+    }
+
+    RGResource RenderGraphBuilder::write(RGResource resource, RGAccess access) {
+        return graph_.recordAccess(pass_, resource, access, false, true);
+    }
+
+    RGResource RenderGraphBuilder::readWrite(RGResource resource, RGAccess access) {
+        return graph_.recordAccess(pass_, resource, access, true, true);
+    }
+
+    void RenderGraphBuilder::setSideEffect() {
+        graph_.passes_[pass_].side_effect = true;
+    }
+
+    GpuImageHandle RenderPassContext::getImage(RGResource resource) const {
+        return graph_.resources_[resource.index].image;
+    }
+
+    GpuBufferHandle RenderPassContext::getBuffer(RGResource resource) const {
+        return graph_.resources_[resource.index].buffer_handle;
+    }
+
+    const RGTextureDesc& RenderPassContext::getTextureDesc(RGResource resource) const {
+        return graph_.resources_[resource.index].texture;
+    }
+
+    std::string_view RenderPassContext::getPassName() const {
+        return graph_.passes_[pass_].name;
+    }
+
+    IRenderGraphBackend& RenderPassContext::getBackend() const noexcept {
+        return graph_.backend_;
+    }
+
+    // ==========================================
+    // DECLARATION
+    // ==========================================
+
+    RenderGraph::RenderGraph(IRenderGraphBackend& backend)
+        : backend_(backend) {
+    }
+
+    void RenderGraph::reset() {
+        resources_.clear();
+        passes_.clear();
+        schedule_.clear();
+        barriers_.clear();
+        final_barriers_.clear();
+        heap_sizes_[0] = heap_sizes_[1] = 0;
+        error_.clear();
+        compiled_ = false;
+        stats_ = {};
+    }
+
+    RGResource RenderGraph::importTexture(std::string_view name, GpuImageHandle image, const RGTextureDesc& desc,
+        RGLayout initial_layout, RGLayout final_layout) {
+        RGResource handle = addResource(name, RGResourceKind::Texture);
+        ResourceNode& node = resources_[handle.index];
+        node.imported = true;
+        node.image = image;
+        node.texture = desc;
+        node.initial_layout = initial_layout;
+        node.final_layout = final_layout;
+        return handle;
+    }
+
+    RGResource RenderGraph::importBuffer(std::string_view name, GpuBufferHandle buffer, const RGBufferDesc& desc) {
+        RGResource handle = addResource(name, RGResourceKind::Buffer);
+        ResourceNode& node = resources_[handle.index];
+        node.imported = true;
+        node.buffer_handle = buffer;
+        node.buffer = desc;
+        return handle;
+    }
+
+    uint32_t RenderGraph::addPass(std::string_view name, const RGSetupFn& setup, RGExecuteFn execute) {
+        const uint32_t index = static_cast<uint32_t>(passes_.size());
+        passes_.push_back({});
+        passes_.back().name = name;
+        passes_.back().execute = std::move(execute);
+
+        RenderGraphBuilder builder(*this, index);
+        setup(builder);
+
+        compiled_ = false;
+        return index;
+    }
+
+    void RenderGraph::markOutput(RGResource resource) {
+        if (resource.index >= resources_.size()) {
+            fail("markOutput on an invalid resource");
+            return;
+        }
+        resources_[resource.index].output = true;
+    }
+
+    bool RenderGraph::isPassCulled(uint32_t pass) const {
+        return pass < passes_.size() && passes_[pass].culled;
+    }
+
+    RGResource RenderGraph::addResource(std::string_view name, RGResourceKind kind) {
+        const uint32_t index = static_cast<uint32_t>(resources_.size());
+        resources_.push_back({});
+        resources_.back().name = name;
+        resources_.back().kind = kind;
+        resources_.back().producers.push_back(NO_PASS);
+        return RGResource{ index, 0 };
+    }
+
+    RGResource RenderGraph::recordAccess(uint32_t pass, RGResource resource, RGAccess access, bool read, bool write) {
+        if (resource.index >= resources_.size()) {
+            fail("Pass '" + passes_[pass].name + "' uses an invalid resource");
+            return {};
+        }
+
+        ResourceNode& node = resources_[resource.index];
+        const AccessInfo& info = getAccessInfo(access);
+        const uint32_t latest = static_cast<uint32_t>(node.producers.size() - 1);
+
+        if ((info.texture_only && node.kind != RGResourceKind::Texture) ||
+            (info.buffer_only && node.kind != RGResourceKind::Buffer)) {
+            fail(passFailure(pass, node, "with an access that doesn't match its kind"));
+            return {};
+        }
+        if ((read && info.read_access == RGAccessBits::None) || (write && info.write_access == RGAccessBits::None)) {
+            fail(passFailure(pass, node, write ? "writes through a read-only access" : "reads through a write-only access"));
+            return {};
+        }
+        if (resource.version > latest) {
+            fail(passFailure(pass, node, "uses an unknown version"));
+            return {};
+        }
+        if (read && !node.imported && resource.version == 0) {
+            fail(passFailure(pass, node, "reads it before anything wrote it"));
+            return {};
+        }
+        if (write && resource.version != latest) {
+            fail(passFailure(pass, node, "writes a stale version"));
+            return {};
+        }
+
+        passes_[pass].accesses.push_back({ resource.index, resource.version, access, read, write });
+
+        if (write) {
+            node.producers.push_back(pass);
+            return RGResource{ resource.index, latest + 1 };
+        }
+        return resource;
+    }
+
+    std::string RenderGraph::passFailure(uint32_t pass, const ResourceNode& resource, std::string_view problem) const {
+        std::string message = "Pass '" + passes_[pass].name + "' / '" + resource.name + "': ";
+        message += problem;
+        return message;
+    }
+
+    void RenderGraph::fail(std::string message) {
+        if (error_.empty()) {
+            error_ = std::move(message);
+        }
+    }
+
+    // ==========================================
+    // COMPILATION
+    // ==========================================
+
+    std::expected<void, RendererError> RenderGraph::compile() {
+        stats_ = {};
+        schedule_.clear();
+        barriers_.clear();
+        final_barriers_.clear();
+        compiled_ = false;
+
+        if (error_.empty()) {
+            cullPasses();
+            computeLifetimes();
+            placeTransients();
+            buildBarriers();
+        }
+
+        if (!error_.empty()) {
+            print_e("Render graph compilation failed", LogContext{ {"error", error_} });
+            return std::unexpected(RendererError::InvalidRenderGraph);
+        }
+
+        stats_.passes_declared = static_cast<uint32_t>(passes_.size());
+        stats_.passes_culled = stats_.passes_declared - static_cast<uint32_t>(schedule_.size());
+        stats_.barriers = static_cast<uint32_t>(barriers_.size() + final_barriers_.size());
+        stats_.transient_bytes_allocated = heap_sizes_[0] + heap_sizes_[1];
+
+        compiled_ = true;
+        return {};
+    }
+
+    void RenderGraph::cullPasses() {
+        // Declaration order is topological, so one reverse sweep propagates liveness
+        std::vector<uint8_t> needed(passes_.size(), 0);
+        for (uint32_t p = 0; p < passes_.size(); ++p) {
+            needed[p] = passes_[p].side_effect;
+        }
+        for (const ResourceNode& node : resources_) {
+            if (node.output && node.producers.back() != NO_PASS) {
+                needed[node.producers.back()] = 1;
+            }
+        }
+
+        for (uint32_t p = static_cast<uint32_t>(passes_.size()); p-- > 0;) {
+            if (!needed[p]) continue;
+            for (const PassAccess& access : passes_[p].accesses) {
+                if (!access.read) continue;
+                const uint32_t producer = resources_[access.resource].producers[access.version];
+                if (producer != NO_PASS) needed[producer] = 1;
+            }
+        }
+
+        for (uint32_t p = 0; p < passes_.size(); ++p) {
+            passes_[p].culled = !needed[p];
+            if (needed[p]) schedule_.push_back(p);
+        }
+    }
+
+    void RenderGraph::computeLifetimes() {
+        for (ResourceNode& node : resources_) {
+            node.first_use = UINT32_MAX;
+            node.last_use = 0;
+        }
+
+        for (uint32_t position = 0; position < schedule_.size(); ++position) {
+            for (const PassAccess& access : passes_[schedule_[position]].accesses) {
+                ResourceNode& node = resources_[access.resource];
+                node.first_use = std::min(node.first_use, position);
+                node.last_use = std::max(node.last_use, position);
+            }
+        }
+    }
+
+    void RenderGraph::placeTransients() {
+        heap_sizes_[0] = heap_sizes_[1] = 0;
+
+        std::vector<uint32_t> transients;
+        for (uint32_t i = 0; i < resources_.size(); ++i) {
+            ResourceNode& node = resources_[i];
+            if (node.imported || node.first_use == UINT32_MAX) continue;
+
+            node.requirements = node.kind == RGResourceKind::Texture
+                ? backend_.getTextureRequirements(node.texture)
+                : backend_.getBufferRequirements(node.buffer);
+            stats_.transient_bytes_requested += node.requirements.size;
+            transients.push_back(i);
+        }
+        stats_.transient_resources = static_cast<uint32_t>(transients.size());
+
+        // Largest first packs best; ties broken by first use for determinism
+        std::sort(transients.begin(), transients.end(), [&](uint32_t a, uint32_t b) {
+            const ResourceNode& ra = resources_[a];
+            const ResourceNode& rb = resources_[b];
+            if (ra.kind != rb.kind) return ra.kind < rb.kind;
+            if (ra.requirements.size != rb.requirements.size) return ra.requirements.size > rb.requirements.size;
+            if (ra.first_use != rb.first_use) return ra.first_use < rb.first_use;
+            return a < b;
+            });
+
+        // First fit among the ranges held by resources whose lifetimes overlap
+        std::vector<std::pair<uint64_t, uint64_t>> occupied;
+        for (size_t i = 0; i < transients.size(); ++i) {
+            ResourceNode& node = resources_[transients[i]];
+
+            occupied.clear();
+            for (size_t j = 0; j < i; ++j) {
+                const ResourceNode& other = resources_[transients[j]];
+                if (other.kind == node.kind && overlaps(node.first_use, node.last_use, other.first_use, other.last_use)) {
+                    occupied.emplace_back(other.heap_offset, other.heap_offset + other.requirements.size);
+                }
+            }
+            std::sort(occupied.begin(), occupied.end());
+
+            uint64_t offset = 0;
+            for (const auto& [begin, end] : occupied) {
+                if (alignUp(offset, node.requirements.alignment) + node.requirements.size <= begin) break;
+                offset = std::max(offset, end);
+            }
+
+            node.heap_offset = alignUp(offset, node.requirements.alignment);
+            uint64_t& heap = heap_sizes_[static_cast<size_t>(node.kind)];
+            heap = std::max(heap, node.heap_offset + node.requirements.size);
+        }
+    }
+
+    void RenderGraph::buildBarriers() {
+        struct State {
+            bool initialized = false;
+            RGLayout layout = RGLayout::Undefined;
+            uint32_t write_stages = RGStage::None;   // Last write (or transition) still to be waited on
+            uint32_t write_access = RGAccessBits::None;
+            uint32_t read_stages = RGStage::None;    // Reads since that write
+            uint32_t visible_stages = RGStage::None; // Where the last write is already visible
+            uint32_t visible_access = RGAccessBits::None;
+        };
+        std::vector<State> states(resources_.size());
+
+        struct MergedAccess {
+            uint32_t resource;
+            uint32_t stages;
+            uint32_t read_access;
+            uint32_t write_access;
+            RGLayout layout;
+        };
+        std::vector<MergedAccess> merged;
+
+        auto initialize = [&](uint32_t index) {
+            State& state = states[index];
+            const ResourceNode& node = resources_[index];
+            state.initialized = true;
+
+            if (node.imported) {
+                // Whoever handed us the resource synchronized it (acquire semaphore, previous frame)
+                state.layout = node.initial_layout;
+                state.visible_stages = ALL_BITS;
+                state.visible_access = ALL_BITS;
+                return;
+            }
+
+            // Aliased memory: wait for every earlier occupant of the same bytes
+            const uint64_t begin = node.heap_offset;
+            const uint64_t end = begin + node.requirements.size;
+            for (uint32_t other = 0; other < resources_.size(); ++other) {
+                const ResourceNode& occupant = resources_[other];
+                if (other == index || occupant.imported || occupant.kind != node.kind ||
+                    occupant.first_use == UINT32_MAX || occupant.last_use >= node.first_use) continue;
+                if (occupant.heap_offset >= end || occupant.heap_offset + occupant.requirements.size <= begin) continue;
+
+                state.write_stages |= states[other].write_stages | states[other].read_stages;
+                state.write_access |= states[other].write_access;
+            }
+        };
+
+        for (uint32_t pass : schedule_) {
+            PassNode& node = passes_[pass];
+            node.barrier_begin = static_cast<uint32_t>(barriers_.size());
+
+            // One entry per resource: a pass may use a resource through several accesses
+            merged.clear();
+            for (const PassAccess& access : node.accesses) {
+                const AccessInfo& info = getAccessInfo(access.access);
+                const bool texture = resources_[access.resource].kind == RGResourceKind::Texture;
+                const RGLayout layout = texture ? info.layout : RGLayout::Undefined;
+
+                auto it = std::find_if(merged.begin(), merged.end(),
+                    [&](const MergedAccess& m) { return m.resource == access.resource; });
+                if (it == merged.end()) {
+                    merged.push_back({ access.resource, RGStage::None, RGAccessBits::None, RGAccessBits::None, layout });
+                    it = merged.end() - 1;
+                }
+                else if (it->layout != layout) {
+                    fail(passFailure(pass, resources_[access.resource], "needs it in two layouts"));
+                    return;
+                }
+
+                it->stages |= info.stages;
+                if (access.read) it->read_access |= info.read_access;
+                if (access.write) it->write_access |= info.write_access;
+            }
+
+            for (const MergedAccess& access : merged) {
+                State& state = states[access.resource];
+                if (!state.initialized) initialize(access.resource);
+
+                const bool writes = access.write_access != RGAccessBits::None;
+                const uint32_t dst_access = access.read_access | access.write_access;
+                const bool transition = resources_[access.resource].kind == RGResourceKind::Texture && state.layout != access.layout;
+                const bool pending_write = state.write_stages != RGStage::None || state.write_access != RGAccessBits::None;
+
+                RenderGraphBarrier barrier;
+                bool needed = transition;
+
+                // RAW / WAW: wait for the last write unless it is already visible here
+                const bool visible = (access.stages & ~state.visible_stages) == 0 && (dst_access & ~state.visible_access) == 0;
+                if (pending_write && (writes || transition || !visible)) {
+                    barrier.src_stages |= state.write_stages;
+                    barrier.src_access |= state.write_access;
+                    needed = true;
+                }
+
+                // WAR: execution dependency on earlier readers (layout transitions count as writes)
+                if ((writes || transition) && state.read_stages != RGStage::None) {
+                    barrier.src_stages |= state.read_stages;
+                    needed = true;
+                }
+
+                if (needed) {
+                    barrier.resource = access.resource;
+                    barrier.kind = resources_[access.resource].kind;
+                    barrier.dst_stages = access.stages;
+                    barrier.dst_access = dst_access;
+                    barrier.old_layout = state.layout;
+                    barrier.new_layout = transition ? access.layout : state.layout;
+                    barriers_.push_back(barrier);
+                    if (transition) ++stats_.layout_transitions;
+                }
+
+                if (writes) {
+                    state.write_stages = access.stages;
+                    state.write_access = access.write_access;
+                    state.read_stages = RGStage::None;
+                    state.visible_stages = RGStage::None;
+                    state.visible_access = RGAccessBits::None;
+                }
+                else {
+                    if (transition) {
+                        // Later readers chain on this barrier's destination scope
+                        state.write_stages = access.stages;
+                        state.write_access = RGAccessBits::None;
+                        state.visible_stages = access.stages;
+                        state.visible_access = dst_access;
+                    }
+                    else if (needed) {
+                        state.visible_stages |= access.stages;
+                        state.visible_access |= dst_access;
+                    }
+                    state.read_stages |= access.stages;
+                }
+                state.layout = transition ? access.layout : state.layout;
+            }
+
+            node.barrier_count = static_cast<uint32_t>(barriers_.size()) - node.barrier_begin;
+        }
+
+        // Hand imported textures back in the layout the caller expects (e.g. Present)
+        for (uint32_t i = 0; i < resources_.size(); ++i) {
+            const ResourceNode& node = resources_[i];
+            if (!node.imported || node.kind != RGResourceKind::Texture || node.final_layout == RGLayout::Undefined) continue;
+
+            const State& state = states[i];
+            const RGLayout current = state.initialized ? state.layout : node.initial_layout;
+            if (current == node.final_layout) continue;
+
+            RenderGraphBarrier barrier;
+            barrier.resource = i;
+            barrier.kind = node.kind;
+            barrier.src_stages = state.write_stages | state.read_stages;
+            barrier.src_access = state.write_access;
+            barrier.old_layout = current;
+            barrier.new_layout = node.final_layout;
+            final_barriers_.push_back(barrier);
+            ++stats_.layout_transitions;
+        }
+    }
+
+    // ==========================================
+    // EXECUTION
+    // ==========================================
+
+    std::expected<void, RendererError> RenderGraph::execute() {
+        if (!compiled_) {
+            if (auto result = compile(); !result) {
+                return result;
+            }
+        }
+
+        for (size_t kind = 0; kind < 2; ++kind) {
+            if (heap_sizes_[kind] == 0) continue;
+            if (auto result = backend_.reserveTransientMemory(static_cast<RGResourceKind>(kind), heap_sizes_[kind]); !result) {
+                print_e("Failed to reserve transient render graph memory", LogContext{ {"bytes", heap_sizes_[kind]} });
+                return result;
+            }
+        }
+
+        for (ResourceNode& node : resources_) {
+            if (node.imported || node.first_use == UINT32_MAX) continue;
+
+            if (node.kind == RGResourceKind::Texture) {
+                auto image = backend_.createTransientImage(node.texture, node.heap_offset);
+                if (!image) return std::unexpected(image.error());
+                node.image = *image;
+            }
+            else {
+                auto buffer = backend_.createTransientBuffer(node.buffer, node.heap_offset);
+                if (!buffer) return std::unexpected(buffer.error());
+                node.buffer_handle = *buffer;
+            }
+        }
+
+        auto record = [&](std::span<const RenderGraphBarrier> barriers) {
+            if (barriers.empty()) return;
+
+            resolved_.assign(barriers.begin(), barriers.end());
+            for (RenderGraphBarrier& barrier : resolved_) {
+                barrier.image = resources_[barrier.resource].image;
+                barrier.buffer = resources_[barrier.resource].buffer_handle;
+            }
+            backend_.recordBarriers(resolved_);
+        };
+
+        for (uint32_t pass : schedule_) {
+            PassNode& node = passes_[pass];
+            record(std::span(barriers_).subspan(node.barrier_begin, node.barrier_count));
+
+            backend_.beginPass(node.name);
+            if (node.execute) {
+                RenderPassContext context(*this, pass);
+                node.execute(context);
+            }
+            backend_.endPass();
+        }
+
+        record(final_barriers_);
+        return {};
+    }
+
+    // ==========================================
+    // BENCHMARK
+    // ==========================================
+
+    RenderGraphBenchmarkResult RenderGraph::benchmarkCompile(IRenderGraphBackend& backend, uint32_t pass_count, uint32_t iterations) {
+        using Clock = std::chrono::steady_clock;
+
+        RenderGraphBenchmarkResult result;
+        result.passes = std::max(pass_count, 3u);
+        result.iterations = std::max(iterations, 1u);
+        result.min_compile = std::chrono::nanoseconds::max();
+
+        RenderGraph graph(backend);
+        std::chrono::nanoseconds total{};
+
+        for (uint32_t iteration = 0; iteration < result.iterations; ++iteration) {
+            // Declaration is part of the per-frame cost, so it is timed too
+            const auto start = Clock::now();
+
+            graph.reset();
+            const RGTextureDesc screen{ 1920, 1080, RenderFormat::BGRA8Srgb };
+            RGResource backbuffer = graph.importTexture("Backbuffer", GpuImageHandle{ 1 }, screen,
+                RGLayout::Undefined, RGLayout::Present);
+
+            RGResource depth;
+            graph.addPass("Depth", [&](RenderGraphBuilder& builder) {
+                depth = builder.createTexture("Depth", { 1920, 1080, RenderFormat::D32Float });
+                depth = builder.write(depth, RGAccess::DepthAttachment);
+                }, {});
+
+            RGResource previous = depth;
+            RGAccess previous_access = RGAccess::SampledFragment;
+            for (uint32_t i = 0; i + 2 < result.passes; ++i) {
+                const uint32_t scale = 1u << (i % 3);
+                const bool compute = i % 7 == 6;
+                const bool dead = i % 5 == 4;  // Debug views nobody samples: culled
+
+                graph.addPass("Effect", [&](RenderGraphBuilder& builder) {
+                    RGResource target = builder.createTexture("Target", { 1920 / scale, 1080 / scale, RenderFormat::RGBA16Float });
+                    builder.read(previous, previous_access);
+                    if (i % 2 == 0 && previous != depth) builder.read(depth, compute ? RGAccess::SampledCompute : RGAccess::DepthReadOnly);
+                    target = builder.write(target, compute ? RGAccess::StorageCompute : RGAccess::ColorAttachment);
+                    if (!dead) {
+                        previous = target;
+                        previous_access = compute ? RGAccess::SampledCompute : RGAccess::SampledFragment;
+                    }
+                    }, {});
+            }
+
+            graph.addPass("Composite", [&](RenderGraphBuilder& builder) {
+                builder.read(previous, RGAccess::SampledFragment);
+                backbuffer = builder.write(backbuffer, RGAccess::ColorAttachment);
+                }, {});
+            graph.markOutput(backbuffer);
+
+            if (!graph.compile()) break;
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            total += elapsed;
+            result.min_compile = std::min(result.min_compile, elapsed);
+            result.max_compile = std::max(result.max_compile, elapsed);
+        }
+
+        if (total.count() == 0) result.min_compile = {};
+        result.avg_compile = total / result.iterations;
+        result.stats = graph.getStats();
+        return result;
+    }
+
+} // namespace AshCore
@@ -0,0 +1,352 @@
+#pragma once
+
+#include "RenderTypes.h"
+#include "Engine/EngineErrors.h"
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // RESOURCE DESCRIPTIONS
+    // ==========================================
+
+    enum class RenderFormat : uint16_t {
+        Undefined,
+        RGBA8Unorm,
+        RGBA8Srgb,
+        BGRA8Srgb,
+        RG16Float,
+        RGBA16Float,
+        R32Float,
+        R32Uint,
+        RGBA32Float,
+        D32Float,
+        D24UnormS8
+    };
+
+    [[nodiscard]] uint32_t getFormatSize(RenderFormat format) noexcept;
+    [[nodiscard]] bool isDepthFormat(RenderFormat format) noexcept;
+
+    struct RGTextureDesc {
+        uint32_t width = 1;
+        uint32_t height = 1;
+        RenderFormat format = RenderFormat::RGBA8Unorm;
+        uint32_t mip_levels = 1;
+        uint32_t array_layers = 1;
+        uint32_t samples = 1;
+    };
+
+    struct RGBufferDesc {
+        uint64_t size = 0;
+    };
+
+    enum class RGResourceKind : uint8_t {
+        Texture,
+        Buffer
+    };
+
+    // Versioned handle: every write produces a new version
+    struct RGResource {
+        static constexpr uint32_t INVALID = UINT32_MAX;
+
+        uint32_t index = INVALID;
+        uint32_t version = 0;
+
+        [[nodiscard]] bool isValid() const noexcept { return index != INVALID; }
+        bool operator==(const RGResource&) const noexcept = default;
+    };
+
+    // ==========================================
+    // ACCESS / SYNCHRONIZATION
+    // ==========================================
+
+    // Mirrors the VkPipelineStageFlags2 / VkAccessFlags2 bits the graph needs
+    namespace RGStage {
+        constexpr uint32_t None = 0;
+        constexpr uint32_t DrawIndirect = 1u << 0;
+        constexpr uint32_t VertexInput = 1u << 1;
+        constexpr uint32_t VertexShader = 1u << 2;
+        constexpr uint32_t FragmentShader = 1u << 3;
+        constexpr uint32_t EarlyFragmentTests = 1u << 4;
+        constexpr uint32_t LateFragmentTests = 1u << 5;
+        constexpr uint32_t ColorAttachmentOutput = 1u << 6;
+        constexpr uint32_t ComputeShader = 1u << 7;
+        constexpr uint32_t Transfer = 1u << 8;
+    }
+
+    namespace RGAccessBits {
+        constexpr uint32_t None = 0;
+        constexpr uint32_t IndirectCommandRead = 1u << 0;
+        constexpr uint32_t IndexRead = 1u << 1;
+        constexpr uint32_t VertexAttributeRead = 1u << 2;
+        constexpr uint32_t UniformRead = 1u << 3;
+        constexpr uint32_t ShaderSampledRead = 1u << 4;
+        constexpr uint32_t ShaderStorageRead = 1u << 5;
+        constexpr uint32_t ShaderStorageWrite = 1u << 6;
+        constexpr uint32_t ColorAttachmentRead = 1u << 7;
+        constexpr uint32_t ColorAttachmentWrite = 1u << 8;
+        constexpr uint32_t DepthStencilRead = 1u << 9;
+        constexpr uint32_t DepthStencilWrite = 1u << 10;
+        constexpr uint32_t TransferRead = 1u << 11;
+        constexpr uint32_t TransferWrite = 1u << 12;
+    }
+
+    enum class RGLayout : uint8_t {
+        Undefined,
+        General,
+        ColorAttachment,
+        DepthStencilAttachment,
+        DepthStencilReadOnly,
+        ShaderReadOnly,
+        TransferSrc,
+        TransferDst,
+        Present
+    };
+
+    // How a pass uses a resource; the graph derives stages, access masks and layouts from it
+    enum class RGAccess : uint8_t {
+        ColorAttachment,
+        DepthAttachment,
+        DepthReadOnly,
+        SampledFragment,
+        SampledCompute,
+        StorageFragment,
+        StorageCompute,
+        UniformBuffer,
+        VertexBuffer,
+        IndexBuffer,
+        IndirectArgs,
+        TransferSrc,
+        TransferDst
+    };
+
+    // One entry of a vkCmdPipelineBarrier2 batch
+    struct RenderGraphBarrier {
+        uint32_t resource = RGResource::INVALID;
+        RGResourceKind kind = RGResourceKind::Texture;
+        GpuImageHandle image;    // Resolved at execute()
+        GpuBufferHandle buffer;
+        uint32_t src_stages = RGStage::None;
+        uint32_t src_access = RGAccessBits::None;
+        uint32_t dst_stages = RGStage::None;
+        uint32_t dst_access = RGAccessBits::None;
+        RGLayout old_layout = RGLayout::Undefined;
+        RGLayout new_layout = RGLayout::Undefined;
+    };
+
+    // ==========================================
+    // BACKEND INTERFACE
+    // ==========================================
+
+    struct RGMemoryRequirements {
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+    };
+
+    /**
+     * Transient resources are placed in one heap per kind; the backend owns
+     * that memory and should cache the images/buffers it creates at a given
+     * (desc, offset), since the same graph usually compiles to the same layout.
+     */
+    class IRenderGraphBackend {
+    public:
+        virtual ~IRenderGraphBackend() = default;
+
+        [[nodiscard]] virtual RGMemoryRequirements getTextureRequirements(const RGTextureDesc& desc) = 0;
+        [[nodiscard]] virtual RGMemoryRequirements getBufferRequirements(const RGBufferDesc& desc) = 0;
+
+        [[nodiscard]] virtual std::expected<void, RendererError> reserveTransientMemory(RGResourceKind kind, uint64_t size) = 0;
+        [[nodiscard]] virtual std::expected<GpuImageHandle, RendererError> createTransientImage(const RGTextureDesc& desc, uint64_t heap_offset) = 0;
+        [[nodiscard]] virtual std::expected<GpuBufferHandle, RendererError> createTransientBuffer(const RGBufferDesc& desc, uint64_t heap_offset) = 0;
+
+        virtual void recordBarriers(std::span<const RenderGraphBarrier> barriers) = 0;
+        virtual void beginPass(std::string_view name) = 0;
+        virtual void endPass() = 0;
+    };
+
+    // ==========================================
+    // PASS SETUP / EXECUTION
+    // ==========================================
+
+    class RenderGraph;
+
+    class RenderGraphBuilder {
+    public:
+        RGResource createTexture(std::string_view name, const RGTextureDesc& desc);
+        RGResource createBuffer(std::string_view name, const RGBufferDesc& desc);
+
+        // write() discards previous contents; readWrite() keeps them (blending, depth test, accumulation)
+        RGResource read(RGResource resource, RGAccess access);
+        RGResource write(RGResource resource, RGAccess access);
+        RGResource readWrite(RGResource resource, RGAccess access);
+
+        // Never culled (readbacks, debug captures)
+        void setSideEffect();
+
+    private:
+        friend class RenderGraph;
+        RenderGraphBuilder(RenderGraph& graph, uint32_t pass) : graph_(graph), pass_(pass) {}
+
+        RenderGraph& graph_;
+        uint32_t pass_;
+    };
+
+    class RenderPassContext {
+    public:
+        [[nodiscard]] GpuImageHandle getImage(RGResource resource) const;
+        [[nodiscard]] GpuBufferHandle getBuffer(RGResource resource) const;
+        [[nodiscard]] const RGTextureDesc& getTextureDesc(RGResource resource) const;
+        [[nodiscard]] std::string_view getPassName() const;
+        [[nodiscard]] IRenderGraphBackend& getBackend() const noexcept;
+
+    private:
+        friend class RenderGraph;
+        RenderPassContext(const RenderGraph& graph, uint32_t pass) : graph_(graph), pass_(pass) {}
+
+        const RenderGraph& graph_;
+        uint32_t pass_;
+    };
+
+    using RGSetupFn = std::function<void(RenderGraphBuilder&)>;
+    using RGExecuteFn = std::function<void(RenderPassContext&)>;
+
+    // ==========================================
+    // RENDER GRAPH
+    // ==========================================
+
+    struct RenderGraphStats {
+        uint32_t passes_declared = 0;
+        uint32_t passes_culled = 0;
+        uint32_t barriers = 0;
+        uint32_t layout_transitions = 0;
+        uint32_t transient_resources = 0;
+        uint64_t transient_bytes_requested = 0;  // Sum of all transients
+        uint64_t transient_bytes_allocated = 0;  // After aliasing
+    };
+
+    struct RenderGraphBenchmarkResult {
+        uint32_t passes = 0;
+        uint32_t iterations = 0;
+        std::chrono::nanoseconds avg_compile{};
+        std::chrono::nanoseconds min_compile{};
+        std::chrono::nanoseconds max_compile{};
+        RenderGraphStats stats;
+    };
+
+    /**
+     * @brief Per-frame pass graph: declare, compile, execute
+     *
+     * Passes are declared in submission order and only see handles returned
+     * by earlier passes, so declaration order is already a valid schedule.
+     * compile() culls passes that contribute to no output or side effect,
+     * derives the minimal barrier batch in front of each surviving pass and
+     * places transient resources with disjoint lifetimes at overlapping heap
+     * offsets. reset() starts the next frame while keeping allocations.
+     */
+    class RenderGraph {
+    public:
+        explicit RenderGraph(IRenderGraphBackend& backend);
+
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        void reset();
+
+        // External resources keep their contents; final_layout is restored after the last pass
+        RGResource importTexture(std::string_view name, GpuImageHandle image, const RGTextureDesc& desc,
+            RGLayout initial_layout, RGLayout final_layout);
+        RGResource importBuffer(std::string_view name, GpuBufferHandle buffer, const RGBufferDesc& desc);
+
+        uint32_t addPass(std::string_view name, const RGSetupFn& setup, RGExecuteFn execute);
+
+        // The latest version of the resource must be produced (swapchain, history buffers)
+        void markOutput(RGResource resource);
+
+        [[nodiscard]] std::expected<void, RendererError> compile();
+        [[nodiscard]] std::expected<void, RendererError> execute();
+
+        [[nodiscard]] const RenderGraphStats& getStats() const noexcept { return stats_; }
+        [[nodiscard]] std::span<const uint32_t> getSchedule() const noexcept { return schedule_; }
+        [[nodiscard]] bool isPassCulled(uint32_t pass) const;
+
+        // Compiles a synthetic deferred-style graph `iterations` times
+        [[nodiscard]] static RenderGraphBenchmarkResult benchmarkCompile(IRenderGraphBackend& backend,
+            uint32_t pass_count = 64, uint32_t iterations = 1000);
+
+    private:
+        friend class RenderGraphBuilder;
+        friend class RenderPassContext;
+
+        struct ResourceNode {
+            std::string name;
+            RGResourceKind kind = RGResourceKind::Texture;
+            RGTextureDesc texture;
+            RGBufferDesc buffer;
+            bool imported = false;
+            bool output = false;
+            RGLayout initial_layout = RGLayout::Undefined;
+            RGLayout final_layout = RGLayout::Undefined;
+            std::vector<uint32_t> producers;  // Pass that wrote each version (version 0 of a transient has none)
+
+            // Compiled
+            GpuImageHandle image;
+            GpuBufferHandle buffer_handle;
+            RGMemoryRequirements requirements;
+            uint32_t first_use = UINT32_MAX;  // Schedule positions
+            uint32_t last_use = 0;
+            uint64_t heap_offset = 0;
+        };
+
+        struct PassAccess {
+            uint32_t resource;
+            uint32_t version;      // Version read, or version produced for write-only
+            RGAccess access;
+            bool read;
+            bool write;
+        };
+
+        struct PassNode {
+            std::string name;
+            RGExecuteFn execute;
+            std::vector<PassAccess> accesses;
+            bool side_effect = false;
+            bool culled = false;
+            uint32_t barrier_begin = 0;
+            uint32_t barrier_count = 0;
+        };
+
+        RGResource addResource(std::string_view name, RGResourceKind kind);
+        RGResource recordAccess(uint32_t pass, RGResource resource, RGAccess access, bool read, bool write);
+        std::string passFailure(uint32_t pass, const ResourceNode& resource, std::string_view problem) const;
+        void fail(std::string message);
+
+        void cullPasses();
+        void computeLifetimes();
+        void placeTransients();
+        void buildBarriers();
+
+    private:
+        IRenderGraphBackend& backend_;
+
+        std::vector<ResourceNode> resources_;
+        std::vector<PassNode> passes_;
+        std::vector<uint32_t> schedule_;
+        std::vector<RenderGraphBarrier> barriers_;
+        std::vector<RenderGraphBarrier> final_barriers_;
+        std::vector<RenderGraphBarrier> resolved_;  // Scratch for execute()
+
+        uint64_t heap_sizes_[2] = { 0, 0 };
+        std::string error_;
+        bool compiled_ = false;
+        RenderGraphStats stats_;
+    };
+
+} // namespace AshCore
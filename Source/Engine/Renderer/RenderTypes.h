@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace AshCore {
+
+    // ==========================================
+    // GPU RESOURCE HANDLES
+    // ==========================================
+
+    // Opaque backend handles (VkBuffer/VkImage/VkPipeline/VkSampler cast to an integer, or a fake id).
+    // Distinct types so a buffer can't be passed where an image is expected.
+    template<typename Tag>
+    struct GpuHandle {
+        uint64_t value = 0;
+
+        [[nodiscard]] constexpr bool isValid() const noexcept { return value != 0; }
+        constexpr explicit operator bool() const noexcept { return isValid(); }
+        constexpr auto operator<=>(const GpuHandle&) const noexcept = default;
+    };
+
+    using GpuBufferHandle = GpuHandle<struct GpuBufferTag>;
+    using GpuImageHandle = GpuHandle<struct GpuImageTag>;
+    using GpuPipelineHandle = GpuHandle<struct GpuPipelineTag>;
+    using GpuSamplerHandle = GpuHandle<struct GpuSamplerTag>;
+
+} // namespace AshCore
+
+template<typename Tag>
+struct std::hash<AshCore::GpuHandle<Tag>> {
+    size_t operator()(const AshCore::GpuHandle<Tag>& handle) const noexcept {
+        return std::hash<uint64_t>{}(handle.value);
+    }
+};
@@ -0,0 +1,340 @@
+#include "ashbornpch.h"
+
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AshCore {
+
+    namespace {
+        // Unseen textures still rank their cached mips by size
+        constexpr float MIN_AREA = 1e-6f;
+    }
+
+    // ==========================================
+    // CONSTRUCTOR / REGISTRATION
+    // ==========================================
+
+    TextureStreamer::TextureStreamer(const RendererConfig& renderer_config, const TextureStreamingConfig& config)
+        : config_(config) {
+        if (config_.budget != 0) {
+            budget_ = config_.budget;
+        }
+        else if (renderer_config.vram_budget != 0) {
+            budget_ = static_cast<uint64_t>(static_cast<double>(renderer_config.vram_budget) * config_.budget_fraction);
+        }
+        else {
+            budget_ = config_.default_budget;
+        }
+    }
+
+    StreamedTextureId TextureStreamer::registerTexture(const StreamedTextureDesc& desc) {
+        uint32_t id;
+        if (!free_ids_.empty()) {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        }
+        else {
+            id = static_cast<uint32_t>(textures_.size());
+            textures_.emplace_back();
+        }
+
+        Texture& texture = textures_[id];
+        texture = {};
+        texture.desc = desc;
+        texture.desc.mip_count = std::max(desc.mip_count, 1u);
+        texture.desc.block_size = std::max(desc.block_size, 1u);
+        texture.alive = true;
+
+        // Coarsest levels small enough to keep resident no matter what
+        uint32_t tail = 0;
+        while (tail + 1 < texture.desc.mip_count &&
+            std::max(desc.width >> tail, desc.height >> tail) > config_.tail_size) {
+            ++tail;
+        }
+        texture.tail_mip = tail;
+        texture.resident_mip = texture.desc.mip_count;
+        texture.pending_mip = texture.desc.mip_count;
+        texture.allowed_mip = tail;
+
+        return StreamedTextureId{ id };
+    }
+
+    void TextureStreamer::unregisterTexture(StreamedTextureId id) {
+        if (id.value >= textures_.size() || !textures_[id.value].alive) return;
+
+        Texture& texture = textures_[id.value];
+        resident_bytes_ -= residentBytes(texture);
+        if (texture.pending_mip != texture.desc.mip_count) {
+            pending_bytes_ -= texture.pending_bytes;
+            --pending_loads_;
+        }
+
+        texture.alive = false;
+        free_ids_.push_back(id.value);
+    }
+
+    void TextureStreamer::submitFeedback(std::span<const TextureFeedback> feedback) {
+        std::lock_guard lock(feedback_mutex_);
+        feedback_.insert(feedback_.end(), feedback.begin(), feedback.end());
+    }
+
+    // ==========================================
+    // POLICY
+    // ==========================================
+
+    void TextureStreamer::update(uint64_t frame, StreamingDecisions& out) {
+        out.clear();
+
+        // ---- Fold this frame's feedback: finest mip and largest area win
+        std::vector<TextureFeedback> feedback;
+        {
+            std::lock_guard lock(feedback_mutex_);
+            feedback.swap(feedback_);
+        }
+        for (const TextureFeedback& entry : feedback) {
+            if (entry.texture.value >= textures_.size()) continue;
+            Texture& texture = textures_[entry.texture.value];
+            if (!texture.alive) continue;
+
+            if (!texture.seen || texture.last_seen_frame != frame) {
+                texture.desired_mip = entry.desired_mip;
+                texture.screen_area = entry.screen_area;
+            }
+            else {
+                texture.desired_mip = std::min(texture.desired_mip, entry.desired_mip);
+                texture.screen_area = std::max(texture.screen_area, entry.screen_area);
+            }
+            texture.last_seen_frame = frame;
+            texture.seen = true;
+        }
+
+        // ---- Grant finer mips greedily by value per byte
+        uint64_t granted = 0;
+        uint64_t desired = 0;
+        steps_.clear();
+        for (uint32_t id = 0; id < textures_.size(); ++id) {
+            Texture& texture = textures_[id];
+            if (!texture.alive) continue;
+
+            for (uint32_t mip = texture.tail_mip; mip < texture.desc.mip_count; ++mip) {
+                granted += mipBytes(texture.desc, mip);
+            }
+            texture.allowed_mip = texture.tail_mip;
+
+            const float area = std::max(texture.screen_area, MIN_AREA);
+            const uint32_t wanted = wantedMip(texture, frame);
+            for (uint32_t mip = texture.tail_mip; mip-- > wanted;) {
+                const uint64_t bytes = mipBytes(texture.desc, mip);
+                steps_.push_back({ id, mip, area / static_cast<float>(bytes), bytes });
+            }
+        }
+        desired = granted;
+        for (const Step& step : steps_) desired += step.bytes;
+
+        // Finer levels of a texture are larger, so they already sort after its coarser ones
+        std::sort(steps_.begin(), steps_.end(), [](const Step& a, const Step& b) {
+            if (a.priority != b.priority) return a.priority > b.priority;
+            if (a.texture != b.texture) return a.texture < b.texture;
+            return a.mip > b.mip;
+            });
+        for (const Step& step : steps_) {
+            Texture& texture = textures_[step.texture];
+            if (step.mip + 1 != texture.allowed_mip || granted + step.bytes > budget_) continue;
+            texture.allowed_mip = step.mip;
+            granted += step.bytes;
+        }
+
+        // ---- Evict cached levels that weren't granted once usage, counting
+        // granted levels still to load, nears the budget
+        uint64_t usage = resident_bytes_ + pending_bytes_;
+        for (const Texture& texture : textures_) {
+            if (!texture.alive || texture.resident_mip == texture.desc.mip_count) continue;
+            const uint32_t loaded = std::min(texture.resident_mip, texture.pending_mip);
+            for (uint32_t mip = texture.allowed_mip; mip < loaded; ++mip) usage += mipBytes(texture.desc, mip);
+        }
+
+        const auto high = static_cast<uint64_t>(static_cast<double>(budget_) * config_.high_watermark);
+        const auto low = static_cast<uint64_t>(static_cast<double>(budget_) * config_.low_watermark);
+        if (usage > high) {
+            steps_.clear();
+            for (uint32_t id = 0; id < textures_.size(); ++id) {
+                const Texture& texture = textures_[id];
+                // A finer level in flight lands on top of the resident ones; they
+                // go once it completes, or onLoadComplete() would leave a gap
+                if (!texture.alive || texture.pending_mip < texture.resident_mip) continue;
+
+                const float area = std::max(texture.screen_area, MIN_AREA);
+                for (uint32_t mip = texture.resident_mip; mip < texture.allowed_mip; ++mip) {
+                    const uint64_t bytes = mipBytes(texture.desc, mip);
+                    steps_.push_back({ id, mip, area / static_cast<float>(bytes), bytes });
+                }
+            }
+
+            // Least valuable first; finest level of each texture goes before coarser ones
+            std::sort(steps_.begin(), steps_.end(), [](const Step& a, const Step& b) {
+                if (a.priority != b.priority) return a.priority < b.priority;
+                if (a.texture != b.texture) return a.texture < b.texture;
+                return a.mip < b.mip;
+                });
+
+            for (const Step& step : steps_) {
+                if (usage <= low) break;
+
+                Texture& texture = textures_[step.texture];
+                if (step.mip != texture.resident_mip) continue;
+
+                texture.resident_mip = step.mip + 1;
+                resident_bytes_ -= step.bytes;
+                usage -= step.bytes;
+                ++stats_.evictions;
+                stats_.bytes_evicted += step.bytes;
+                out.evictions.push_back({ StreamedTextureId{ step.texture }, texture.resident_mip, step.bytes });
+            }
+
+            // One entry per texture even if its levels weren't adjacent in the order
+            std::stable_sort(out.evictions.begin(), out.evictions.end(),
+                [](const MipEviction& a, const MipEviction& b) { return a.texture.value < b.texture.value; });
+            size_t merged = 0;
+            for (size_t i = 0; i < out.evictions.size(); ++i) {
+                if (merged > 0 && out.evictions[merged - 1].texture == out.evictions[i].texture) {
+                    out.evictions[merged - 1].new_resident_mip = std::max(out.evictions[merged - 1].new_resident_mip, out.evictions[i].new_resident_mip);
+                    out.evictions[merged - 1].bytes += out.evictions[i].bytes;
+                }
+                else {
+                    out.evictions[merged++] = out.evictions[i];
+                }
+            }
+            out.evictions.resize(merged);
+        }
+
+        // ---- Loads: mip tails first (mandatory), then one level per texture by priority
+        uint64_t frame_bytes = 0;
+        auto issue = [&](uint32_t id, uint32_t mip, uint32_t count, uint64_t bytes) {
+            Texture& texture = textures_[id];
+            texture.pending_mip = mip;
+            texture.pending_bytes = bytes;
+            pending_bytes_ += bytes;
+            ++pending_loads_;
+            frame_bytes += bytes;
+            ++stats_.loads_issued;
+            out.loads.push_back({ StreamedTextureId{ id }, mip, count, bytes });
+        };
+
+        for (uint32_t id = 0; id < textures_.size(); ++id) {
+            const Texture& texture = textures_[id];
+            if (!texture.alive || texture.resident_mip != texture.desc.mip_count || texture.pending_mip != texture.desc.mip_count) continue;
+            if (pending_loads_ >= config_.max_pending_loads) break;
+
+            uint64_t bytes = 0;
+            for (uint32_t mip = texture.tail_mip; mip < texture.desc.mip_count; ++mip) bytes += mipBytes(texture.desc, mip);
+            issue(id, texture.tail_mip, texture.desc.mip_count - texture.tail_mip, bytes);
+        }
+
+        steps_.clear();
+        for (uint32_t id = 0; id < textures_.size(); ++id) {
+            const Texture& texture = textures_[id];
+            if (!texture.alive || texture.resident_mip == texture.desc.mip_count ||
+                texture.pending_mip != texture.desc.mip_count || texture.allowed_mip >= texture.resident_mip) continue;
+
+            const uint32_t mip = texture.resident_mip - 1;
+            const uint64_t bytes = mipBytes(texture.desc, mip);
+            steps_.push_back({ id, mip, std::max(texture.screen_area, MIN_AREA) / static_cast<float>(bytes), bytes });
+        }
+        std::sort(steps_.begin(), steps_.end(), [](const Step& a, const Step& b) {
+            if (a.priority != b.priority) return a.priority > b.priority;
+            return a.texture < b.texture;
+            });
+
+        for (const Step& step : steps_) {
+            if (pending_loads_ >= config_.max_pending_loads) break;
+            if (frame_bytes > 0 && frame_bytes + step.bytes > config_.max_load_bytes_per_frame) break;
+            if (resident_bytes_ + pending_bytes_ + step.bytes > budget_) continue;
+            issue(step.texture, step.mip, 1, step.bytes);
+        }
+
+        // ---- Stats
+        stats_.textures = 0;
+        stats_.textures_at_desired = 0;
+        for (const Texture& texture : textures_) {
+            if (!texture.alive) continue;
+            ++stats_.textures;
+            if (texture.resident_mip <= wantedMip(texture, frame)) ++stats_.textures_at_desired;
+        }
+        stats_.pending_loads = pending_loads_;
+        stats_.budget = budget_;
+        stats_.resident_bytes = resident_bytes_;
+        stats_.pending_bytes = pending_bytes_;
+        stats_.desired_bytes = desired;
+    }
+
+    void TextureStreamer::onLoadComplete(StreamedTextureId id, uint32_t mip) {
+        if (id.value >= textures_.size()) return;
+        Texture& texture = textures_[id.value];
+        if (!texture.alive || texture.pending_mip != mip) return;
+
+        texture.resident_mip = mip;
+        texture.pending_mip = texture.desc.mip_count;
+        resident_bytes_ += texture.pending_bytes;
+        pending_bytes_ -= texture.pending_bytes;
+        texture.pending_bytes = 0;
+        --pending_loads_;
+    }
+
+    void TextureStreamer::onLoadFailed(StreamedTextureId id, uint32_t mip) {
+        if (id.value >= textures_.size()) return;
+        Texture& texture = textures_[id.value];
+        if (!texture.alive || texture.pending_mip != mip) return;
+
+        print_w("Texture mip load failed, will retry", LogContext{ {"texture", id.value}, {"mip", mip} });
+        texture.pending_mip = texture.desc.mip_count;
+        pending_bytes_ -= texture.pending_bytes;
+        texture.pending_bytes = 0;
+        --pending_loads_;
+    }
+
+    // ==========================================
+    // QUERIES / HELPERS
+    // ==========================================
+
+    uint32_t TextureStreamer::getResidentMip(StreamedTextureId id) const {
+        return id.value < textures_.size() ? textures_[id.value].resident_mip : 0;
+    }
+
+    uint64_t TextureStreamer::getMipBytes(StreamedTextureId id, uint32_t mip) const {
+        return id.value < textures_.size() ? mipBytes(textures_[id.value].desc, mip) : 0;
+    }
+
+    float TextureStreamer::computeDesiredMip(float texels_per_meter, float distance, float screen_height_px, float fov_y_radians) noexcept {
+        // Pixels covered by one meter at this distance
+        const float pixels_per_meter = screen_height_px / (2.0f * std::max(distance, 0.01f) * std::tan(fov_y_radians * 0.5f));
+        const float texels_per_pixel = texels_per_meter / std::max(pixels_per_meter, 1e-3f);
+        return std::max(0.0f, std::log2(std::max(texels_per_pixel, 1.0f)));
+    }
+
+    uint64_t TextureStreamer::mipBytes(const StreamedTextureDesc& desc, uint32_t mip) const noexcept {
+        const uint64_t width = std::max(desc.width >> mip, 1u);
+        const uint64_t height = std::max(desc.height >> mip, 1u);
+        const uint64_t blocks_x = (width + desc.block_size - 1) / desc.block_size;
+        const uint64_t blocks_y = (height + desc.block_size - 1) / desc.block_size;
+        return blocks_x * blocks_y * desc.bytes_per_block;
+    }
+
+    uint64_t TextureStreamer::residentBytes(const Texture& texture) const noexcept {
+        uint64_t bytes = 0;
+        for (uint32_t mip = texture.resident_mip; mip < texture.desc.mip_count; ++mip) {
+            bytes += mipBytes(texture.desc, mip);
+        }
+        return bytes;
+    }
+
+    uint32_t TextureStreamer::wantedMip(const Texture& texture, uint64_t frame) const noexcept {
+        if (!texture.seen || frame - texture.last_seen_frame > config_.feedback_frames) {
+            return texture.tail_mip;
+        }
+        const float mip = std::floor(texture.desired_mip + config_.mip_bias);
+        return std::min(static_cast<uint32_t>(std::max(mip, 0.0f)), texture.tail_mip);
+    }
+
+} // namespace AshCore
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "Engine/AshbornEngine.h"
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // DESCRIPTIONS / FEEDBACK
+    // ==========================================
+
+    struct StreamedTextureDesc {
+        uint32_t width = 1;
+        uint32_t height = 1;
+        uint32_t mip_count = 1;
+        uint32_t block_size = 1;       // 4 for BCn, 1 for uncompressed
+        uint32_t bytes_per_block = 4;  // 8/16 for BCn, texel size otherwise
+    };
+
+    struct StreamedTextureId {
+        uint32_t value = UINT32_MAX;
+        [[nodiscard]] bool isValid() const noexcept { return value != UINT32_MAX; }
+        bool operator==(const StreamedTextureId&) const noexcept = default;
+    };
+
+    // What the visible sections asked of a texture this frame
+    struct TextureFeedback {
+        StreamedTextureId texture;
+        float desired_mip = 0.0f;   // Finest mip worth sampling (fractional)
+        float screen_area = 0.0f;   // Share of the screen it covers, drives priority
+    };
+
+    // Load mips [mip, mip + count) into the texture
+    struct MipLoadRequest {
+        StreamedTextureId texture;
+        uint32_t mip;
+        uint32_t count;
+        uint64_t bytes;
+    };
+
+    // Drop mips finer than new_resident_mip (the texture keeps sampling from new_resident_mip)
+    struct MipEviction {
+        StreamedTextureId texture;
+        uint32_t new_resident_mip;
+        uint64_t bytes;
+    };
+
+    struct StreamingDecisions {
+        std::vector<MipLoadRequest> loads;
+        std::vector<MipEviction> evictions;
+
+        void clear() noexcept { loads.clear(); evictions.clear(); }
+    };
+
+    // ==========================================
+    // TEXTURE STREAMER
+    // ==========================================
+
+    struct TextureStreamingConfig {
+        uint64_t budget = 0;                 // Bytes; 0 = budget_fraction of RendererConfig::vram_budget
+        float budget_fraction = 0.5f;        // Share of VRAM for streamed textures
+        uint64_t default_budget = 1024ull * 1024 * 1024;  // When neither is set
+        float high_watermark = 0.95f;        // Start evicting above this share of the budget
+        float low_watermark = 0.85f;         // ... until usage is back under this
+        uint32_t tail_size = 64;             // Mips at or below this edge are always resident
+        uint32_t feedback_frames = 30;       // Unseen for this long = only the tail is wanted
+        float mip_bias = 0.0f;               // Positive = coarser everywhere
+        uint32_t max_pending_loads = 32;
+        uint64_t max_load_bytes_per_frame = 16ull * 1024 * 1024;
+    };
+
+    struct TextureStreamingStats {
+        uint32_t textures = 0;
+        uint32_t textures_at_desired = 0;
+        uint32_t pending_loads = 0;
+        uint64_t budget = 0;
+        uint64_t resident_bytes = 0;
+        uint64_t pending_bytes = 0;
+        uint64_t desired_bytes = 0;       // If the budget were unlimited
+        uint64_t loads_issued = 0;
+        uint64_t evictions = 0;
+        uint64_t bytes_evicted = 0;
+    };
+
+    /**
+     * @brief Decides which texture mips are resident under the streaming budget
+     *
+     * Pure CPU policy: update() turns feedback into load and eviction
+     * decisions; the renderer carries them out and reports completed loads.
+     * New textures load their mip tail first. Finer mips are granted
+     * greedily by screen area per byte, one level at a time, coarse to fine.
+     * Mips already resident but no longer granted stay cached until usage
+     * crosses the high watermark, then the least valuable go first; a
+     * texture with a finer level still loading keeps its mips until then.
+     */
+    class TextureStreamer {
+    public:
+        TextureStreamer(const RendererConfig& renderer_config, const TextureStreamingConfig& config = {});
+
+        [[nodiscard]] StreamedTextureId registerTexture(const StreamedTextureDesc& desc);
+        void unregisterTexture(StreamedTextureId texture);
+
+        // Thread-safe; feedback accumulates (max per texture) until the next update()
+        void submitFeedback(std::span<const TextureFeedback> feedback);
+
+        void update(uint64_t frame, StreamingDecisions& out);
+
+        // Renderer callbacks
+        void onLoadComplete(StreamedTextureId texture, uint32_t mip);
+        void onLoadFailed(StreamedTextureId texture, uint32_t mip);
+
+        void setBudget(uint64_t bytes) noexcept { budget_ = bytes; }
+
+        [[nodiscard]] uint32_t getResidentMip(StreamedTextureId texture) const;
+        [[nodiscard]] uint64_t getMipBytes(StreamedTextureId texture, uint32_t mip) const;
+        [[nodiscard]] const TextureStreamingStats& getStats() const noexcept { return stats_; }
+
+        // Finest useful mip for a texture tiled at texels_per_meter, seen at distance (meters)
+        [[nodiscard]] static float computeDesiredMip(float texels_per_meter, float distance,
+            float screen_height_px, float fov_y_radians) noexcept;
+
+    private:
+        struct Texture {
+            StreamedTextureDesc desc;
+            bool alive = false;
+            uint32_t tail_mip = 0;        // Coarsest streamed level; [tail_mip, mip_count) always resident
+            uint32_t resident_mip = 0;    // Finest resident mip (mip_count = nothing yet)
+            uint32_t pending_mip = 0;     // Level being loaded (mip_count = none)
+            uint32_t allowed_mip = 0;     // Granted by the last update()
+            uint64_t pending_bytes = 0;
+            float desired_mip = 0.0f;
+            float screen_area = 0.0f;
+            uint64_t last_seen_frame = 0;
+            bool seen = false;
+        };
+
+        struct Step {
+            uint32_t texture;
+            uint32_t mip;
+            float priority;
+            uint64_t bytes;
+        };
+
+        uint64_t mipBytes(const StreamedTextureDesc& desc, uint32_t mip) const noexcept;
+        uint64_t residentBytes(const Texture& texture) const noexcept;
+        uint32_t wantedMip(const Texture& texture, uint64_t frame) const noexcept;
+
+    private:
+        TextureStreamingConfig config_;
+        uint64_t budget_;
+
+        std::vector<Texture> textures_;
+        std::vector<uint32_t> free_ids_;
+
+        std::mutex feedback_mutex_;
+        std::vector<TextureFeedback> feedback_;
+
+        std::vector<Step> steps_;  // update() scratch
+        uint64_t resident_bytes_ = 0;
+        uint64_t pending_bytes_ = 0;
+        uint32_t pending_loads_ = 0;
+        TextureStreamingStats stats_;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,260 @@
+#include "ashbornpch.h"
+
+#include "AtlasPacker.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t CHANNELS = 4;
+
+        uint32_t alignUp(uint32_t value, uint32_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        // Top edge of the packed area as runs of equal height, left to right, covering the page
+        class Skyline {
+        public:
+            struct Position {
+                uint32_t x;
+                uint32_t y;
+            };
+
+            Skyline(uint32_t width, uint32_t height)
+                : width_(width), height_(height), nodes_{ { 0, 0, width } } {}
+
+            // Lowest top edge wins, then leftmost
+            std::optional<Position> find(uint32_t width, uint32_t height) const {
+                std::optional<Position> best;
+                uint32_t best_top = UINT32_MAX;
+                for (size_t i = 0; i < nodes_.size(); ++i) {
+                    const auto y = fit(i, width, height);
+                    if (y && *y + height < best_top) {
+                        best_top = *y + height;
+                        best = Position{ nodes_[i].x, *y };
+                    }
+                }
+                return best;
+            }
+
+            void insert(const Position& position, uint32_t width, uint32_t height) {
+                const uint32_t left = position.x;
+                const uint32_t right = position.x + width;
+
+                std::vector<Node> nodes;
+                nodes.reserve(nodes_.size() + 2);
+                bool placed = false;
+                for (const Node& node : nodes_) {
+                    const uint32_t node_right = node.x + node.width;
+                    if (node_right <= left || node.x >= right) {
+                        nodes.push_back(node);
+                        continue;
+                    }
+                    if (node.x < left) nodes.push_back({ node.x, node.y, left - node.x });
+                    if (!placed) {
+                        nodes.push_back({ left, position.y + height, width });
+                        placed = true;
+                    }
+                    if (node_right > right) nodes.push_back({ right, node.y, node_right - right });
+                }
+
+                // Merge neighbours at the same height
+                nodes_.clear();
+                for (const Node& node : nodes) {
+                    if (!nodes_.empty() && nodes_.back().y == node.y) {
+                        nodes_.back().width += node.width;
+                    }
+                    else {
+                        nodes_.push_back(node);
+                    }
+                }
+            }
+
+        private:
+            struct Node {
+                uint32_t x;
+                uint32_t y;
+                uint32_t width;
+            };
+
+            // Resting height for a rect whose left edge is at node i
+            std::optional<uint32_t> fit(size_t i, uint32_t width, uint32_t height) const {
+                if (nodes_[i].x + width > width_) return std::nullopt;
+
+                uint32_t y = 0;
+                uint32_t remaining = width;
+                for (size_t j = i; remaining > 0; ++j) {
+                    y = std::max(y, nodes_[j].y);
+                    if (y + height > height_) return std::nullopt;
+                    remaining -= std::min(remaining, nodes_[j].width);
+                }
+                return y;
+            }
+
+        private:
+            uint32_t width_;
+            uint32_t height_;
+            std::vector<Node> nodes_;
+        };
+
+        struct PaddedRect {
+            uint32_t index;
+            uint32_t width;
+            uint32_t height;
+        };
+
+        // Places every rect into pages of size x size; false if some rect never fits
+        bool packPages(std::span<const PaddedRect> rects, uint32_t size, uint32_t max_pages, uint32_t padding,
+            AtlasLayout& layout) {
+            std::vector<Skyline> pages;
+            for (const PaddedRect& rect : rects) {
+                bool placed = false;
+                for (size_t page = 0; page < pages.size() && !placed; ++page) {
+                    if (auto position = pages[page].find(rect.width, rect.height)) {
+                        pages[page].insert(*position, rect.width, rect.height);
+                        layout.placements[rect.index].page = static_cast<uint32_t>(page);
+                        layout.placements[rect.index].x = position->x + padding;
+                        layout.placements[rect.index].y = position->y + padding;
+                        placed = true;
+                    }
+                }
+                if (placed) continue;
+                if (pages.size() == max_pages) return false;
+
+                Skyline& page = pages.emplace_back(size, size);
+                auto position = page.find(rect.width, rect.height);
+                if (!position) return false;
+                page.insert(*position, rect.width, rect.height);
+                layout.placements[rect.index].page = static_cast<uint32_t>(pages.size() - 1);
+                layout.placements[rect.index].x = position->x + padding;
+                layout.placements[rect.index].y = position->y + padding;
+            }
+
+            layout.width = size;
+            layout.height = size;
+            layout.page_count = static_cast<uint32_t>(pages.size());
+            return true;
+        }
+    }
+
+    std::optional<AtlasLayout> packAtlas(std::span<const AtlasImage> images, const AtlasPackSettings& settings) {
+        const uint32_t alignment = std::max(settings.alignment, 1u);
+        const uint32_t max_size = settings.max_size / alignment * alignment;
+
+        AtlasLayout layout;
+        layout.placements.resize(images.size());
+        if (images.empty()) return layout;
+
+        std::vector<PaddedRect> rects(images.size());
+        uint64_t area = 0;
+        uint32_t largest = 0;
+        for (size_t i = 0; i < images.size(); ++i) {
+            const AtlasImage& image = images[i];
+            rects[i] = { static_cast<uint32_t>(i), alignUp(image.width + settings.padding * 2, alignment),
+                alignUp(image.height + settings.padding * 2, alignment) };
+            if (image.width == 0 || image.height == 0 || rects[i].width > max_size || rects[i].height > max_size) {
+                print_e("Atlas region does not fit in a page", LogContext{
+                    {"index", i},
+                    {"width", image.width},
+                    {"height", image.height},
+                    {"max_size", max_size}
+                    });
+                return std::nullopt;
+            }
+            layout.placements[i].width = image.width;
+            layout.placements[i].height = image.height;
+            area += uint64_t{ rects[i].width } * rects[i].height;
+            largest = std::max({ largest, rects[i].width, rects[i].height });
+        }
+
+        std::sort(rects.begin(), rects.end(), [](const PaddedRect& a, const PaddedRect& b) {
+            if (a.height != b.height) return a.height > b.height;
+            if (a.width != b.width) return a.width > b.width;
+            return a.index < b.index;
+            });
+
+        // Smallest single page that holds everything, growing from the area bound
+        auto roundSize = [&](uint64_t size) {
+            uint32_t rounded = alignUp(static_cast<uint32_t>(std::min<uint64_t>(size, max_size)), alignment);
+            if (settings.power_of_two) rounded = std::bit_ceil(rounded);
+            return rounded;
+        };
+        uint32_t size = roundSize(std::max<uint64_t>(largest, static_cast<uint64_t>(std::ceil(std::sqrt(static_cast<double>(area))))));
+        while (size <= max_size) {
+            if (packPages(rects, size, 1, settings.padding, layout)) return layout;
+            const uint32_t next = roundSize(uint64_t{ size } + std::max(size / 4, alignment));
+            if (next <= size) break;
+            size = next;
+        }
+
+        // Does not fit one page: as many full-size pages as it takes
+        packPages(rects, max_size, UINT32_MAX, settings.padding, layout);
+        return layout;
+    }
+
+    std::vector<std::byte> composeAtlas(const AtlasLayout& layout, std::span<const AtlasImage> images,
+        uint32_t padding, JobSystem* jobs) {
+        const size_t page_bytes = size_t{ layout.width } * layout.height * CHANNELS;
+        std::vector<std::byte> pages(page_bytes * layout.page_count);
+
+        // Regions (with their padding) never overlap, so each can be written independently
+        auto blit = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const AtlasImage& image = images[i];
+                const AtlasPlacement& placement = layout.placements[i];
+                std::byte* page = pages.data() + placement.page * page_bytes;
+                const int64_t width = placement.width;
+                const int64_t height = placement.height;
+                const int64_t pad = padding;
+
+                for (int64_t y = -pad; y < height + pad; ++y) {
+                    const int64_t source_y = std::clamp<int64_t>(y, 0, height - 1);
+                    const std::byte* source = image.rgba.data() + source_y * width * CHANNELS;
+                    std::byte* row = page + ((placement.y + y) * int64_t{ layout.width } + placement.x) * CHANNELS;
+
+                    std::memcpy(row, source, static_cast<size_t>(width) * CHANNELS);
+                    for (int64_t x = 1; x <= pad; ++x) {
+                        std::memcpy(row - x * CHANNELS, source, CHANNELS);
+                        std::memcpy(row + (width - 1 + x) * CHANNELS, source + (width - 1) * CHANNELS, CHANNELS);
+                    }
+                }
+            }
+        };
+
+        if (jobs && images.size() > 1) {
+            jobs->parallelFor(images.size(), 1, blit);
+        }
+        else {
+            blit(0, images.size());
+        }
+        return pages;
+    }
+
+    uint32_t getAtlasMipLimit(const AtlasPackSettings& settings, const MipSettings& mips) noexcept {
+        const uint32_t alignment = std::max(settings.alignment, 1u);
+        uint32_t count = 1;
+        while (count < 32) {
+            // Page texels per texel of the next level
+            const uint64_t scale = uint64_t{ 1 } << count;
+            bool clean;
+            if (mips.filter == MipFilter::Box) {
+                clean = scale <= settings.padding && alignment % scale == 0;
+            }
+            else {
+                // Each level m filters level m - 1 over kaiser_radius of its own texels,
+                // 2^m page texels apiece: sum over levels 1..m of radius * 2^m
+                const double reach = static_cast<double>(mips.kaiser_radius) * static_cast<double>(2 * scale - 2);
+                clean = reach <= static_cast<double>(settings.padding);
+            }
+            if (!clean) break;
+            ++count;
+        }
+        return count;
+    }
+
+} // namespace AshCore
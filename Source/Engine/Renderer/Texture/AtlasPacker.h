@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Texture/MipGenerator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // ATLAS PACKING
+    // ==========================================
+
+    struct AtlasPackSettings {
+        uint32_t max_size = 4096;     // Page width/height limit; more pages become array layers
+        uint32_t padding = 4;         // Edge texels replicated around every region
+        uint32_t alignment = 4;       // Padded regions start and end on this grid
+        bool power_of_two = true;     // Page size rounded up to a power of two
+    };
+
+    struct AtlasPlacement {
+        uint32_t page = 0;
+        uint32_t x = 0;               // Of the content, inside the padding
+        uint32_t y = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    // Every page has the same size so they can be layers of one array texture
+    struct AtlasLayout {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t page_count = 0;
+        std::vector<AtlasPlacement> placements;  // Same order as the input sizes
+    };
+
+    struct AtlasImage {
+        std::span<const std::byte> rgba;  // Tightly packed RGBA8
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    /**
+     * Skyline bottom-left packing. Regions are placed tallest first (ties
+     * broken by width, then input order), and the page size is the smallest
+     * one that holds everything, so the layout depends only on the input
+     * sizes and settings. Padding, and padded regions starting on the
+     * alignment grid, keep neighbours from bleeding into each other once
+     * the pages are mipmapped, down to getAtlasMipLimit() levels.
+     *
+     * nullopt if a region does not fit in a max_size page.
+     */
+    [[nodiscard]] std::optional<AtlasLayout> packAtlas(std::span<const AtlasImage> images, const AtlasPackSettings& settings);
+
+    // All pages back to back (page-major RGBA8), padding filled from each
+    // region's edges and unused space transparent. jobs may be null.
+    [[nodiscard]] std::vector<std::byte> composeAtlas(const AtlasLayout& layout, std::span<const AtlasImage> images,
+        uint32_t padding, JobSystem* jobs);
+
+    // Mip levels of the composed pages (mip 0 included) in which no region's
+    // texels pick up a neighbour. A box texel of mip m averages an aligned
+    // 2^m block, which stays inside its padded region while 2^m fits the
+    // padding and the grid; a Kaiser texel reaches kaiser_radius texels of
+    // every level above it, so padding 4 protects none of its mips.
+    [[nodiscard]] uint32_t getAtlasMipLimit(const AtlasPackSettings& settings, const MipSettings& mips) noexcept;
+
+} // namespace AshCore
@@ -0,0 +1,474 @@
+#include "ashbornpch.h"
+
+#include "MipGenerator.h"
+#include "Jobs/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace AshCore {
+
+    namespace {
+        constexpr size_t CHANNELS = 4;
+        constexpr uint32_t SRGB_ENCODE_STEPS = 16383;  // Linear -> sRGB table resolution
+        constexpr uint32_t COVERAGE_BINS = 1024;
+
+        // [0, 256): sRGB byte -> linear, [256, 512): unorm byte -> float
+        struct DecodeTable {
+            alignas(32) float values[512];
+
+            DecodeTable() {
+                for (uint32_t i = 0; i < 256; ++i) {
+                    const float c = static_cast<float>(i) / 255.0f;
+                    values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                    values[256 + i] = c;
+                }
+            }
+        };
+
+        // Linear value quantized to SRGB_ENCODE_STEPS -> sRGB byte
+        struct EncodeTable {
+            uint8_t values[SRGB_ENCODE_STEPS + 1];
+
+            EncodeTable() {
+                for (uint32_t i = 0; i <= SRGB_ENCODE_STEPS; ++i) {
+                    const float l = static_cast<float>(i) / static_cast<float>(SRGB_ENCODE_STEPS);
+                    const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+                    values[i] = static_cast<uint8_t>(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+                }
+            }
+        };
+
+        const DecodeTable& decodeTable() {
+            static const DecodeTable table;
+            return table;
+        }
+
+        const EncodeTable& encodeTable() {
+            static const EncodeTable table;
+            return table;
+        }
+
+        // Runs fn(begin, end) over row batches, on the job system when available
+        template<typename Fn>
+        void forEachRowBatch(JobSystem* jobs, size_t rows, size_t batch_size, Fn&& fn) {
+            if (jobs && rows > batch_size) {
+                jobs->parallelFor(rows, batch_size, fn);
+                return;
+            }
+            fn(size_t{ 0 }, rows);
+        }
+
+        // Zeroth-order modified Bessel function of the first kind (power series)
+        double besselI0(double x) {
+            double sum = 1.0;
+            double term = 1.0;
+            const double half_sq = x * x * 0.25;
+            for (int k = 1; k < 32; ++k) {
+                term *= half_sq / (static_cast<double>(k) * k);
+                sum += term;
+                if (term < sum * 1e-12) break;
+            }
+            return sum;
+        }
+
+        double sinc(double x) {
+            if (std::abs(x) < 1e-9) return 1.0;
+            const double px = std::numbers::pi * x;
+            return std::sin(px) / px;
+        }
+    }
+
+    // ==========================================
+    // MIP GENERATOR
+    // ==========================================
+
+    MipGenerator::MipGenerator(const MipSettings& settings)
+        : settings_(settings) {
+        settings_.row_batch_size = std::max<size_t>(settings_.row_batch_size, 1);
+        settings_.alpha_cutoff = std::clamp(settings_.alpha_cutoff, 1.0f / 255.0f, 1.0f);
+        settings_.kaiser_radius = std::max(settings_.kaiser_radius, 1.0f);
+        simd_ = settings_.use_simd && isSimdAvailable();
+    }
+
+    bool MipGenerator::isSimdAvailable() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::optional<std::vector<std::vector<std::byte>>> MipGenerator::generate(std::span<const std::byte> rgba,
+        uint32_t width, uint32_t height, JobSystem* jobs) {
+        if (width == 0 || height == 0 || rgba.size() != size_t{ width } * height * CHANNELS) {
+            print_e("Mip generation input does not match its size", LogContext{
+                {"width", width},
+                {"height", height},
+                {"bytes", rgba.size()}
+                });
+            return std::nullopt;
+        }
+
+        const uint32_t full_count = [&]() {
+            uint32_t count = 1;
+            while ((width >> count) > 0 || (height >> count) > 0) ++count;
+            return count;
+            }();
+        const uint32_t mip_count = settings_.max_mips > 0 ? std::min(settings_.max_mips, full_count) : full_count;
+
+        levels_.resize(mip_count);
+        expandTop(rgba, width, height, jobs);
+
+        float target_coverage = 0.0f;
+        if (settings_.preserve_coverage) {
+            const std::vector<float>& top = levels_[0];
+            size_t passing = 0;
+            for (size_t i = 3; i < top.size(); i += CHANNELS) {
+                if (top[i] >= settings_.alpha_cutoff) ++passing;
+            }
+            target_coverage = static_cast<float>(passing) / static_cast<float>(size_t{ width } * height);
+        }
+
+        std::vector<std::vector<std::byte>> out(mip_count);
+        if (settings_.premultiply) {
+            quantize(levels_[0], width, height, 1.0f, out[0], jobs);
+        }
+        else {
+            out[0].assign(rgba.begin(), rgba.end());  // Untouched; avoids a lossy round trip
+        }
+
+        for (uint32_t mip = 1; mip < mip_count; ++mip) {
+            const uint32_t src_width = std::max(1u, width >> (mip - 1));
+            const uint32_t src_height = std::max(1u, height >> (mip - 1));
+            if (settings_.filter == MipFilter::Kaiser) {
+                downsampleKaiser(levels_[mip - 1], src_width, src_height, levels_[mip], jobs);
+            }
+            else {
+                downsampleBox(levels_[mip - 1], src_width, src_height, levels_[mip], jobs);
+            }
+
+            // Unscaled levels feed the next one; the scale only affects the stored bytes
+            const float alpha_scale = settings_.preserve_coverage && target_coverage > 0.0f
+                ? findCoverageScale(levels_[mip], target_coverage) : 1.0f;
+            quantize(levels_[mip], std::max(1u, width >> mip), std::max(1u, height >> mip), alpha_scale, out[mip], jobs);
+        }
+        return out;
+    }
+
+    void MipGenerator::expandTop(std::span<const std::byte> rgba, uint32_t width, uint32_t height, JobSystem* jobs) {
+        std::vector<float>& top = levels_[0];
+        top.resize(size_t{ width } * height * CHANNELS);
+
+        const float* table = decodeTable().values;
+        const uint32_t colour_offset = settings_.srgb ? 0 : 256;
+        const bool premultiply = settings_.premultiply;
+        const auto* src = reinterpret_cast<const uint8_t*>(rgba.data());
+        const size_t row_floats = size_t{ width } * CHANNELS;
+
+        forEachRowBatch(jobs, height, settings_.row_batch_size, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                const uint8_t* in = src + y * row_floats;
+                float* row = top.data() + y * row_floats;
+                size_t i = 0;
+#if defined(__AVX2__)
+                if (simd_) {
+                    const __m256i offsets = _mm256_setr_epi32(colour_offset, colour_offset, colour_offset, 256,
+                        colour_offset, colour_offset, colour_offset, 256);
+                    for (; i + 8 <= row_floats; i += 8) {
+                        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i));
+                        const __m256i index = _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), offsets);
+                        __m256 texels = _mm256_i32gather_ps(table, index, 4);
+                        if (premultiply) {
+                            const __m256 alpha = _mm256_permute_ps(texels, 0xFF);
+                            texels = _mm256_blend_ps(_mm256_mul_ps(texels, alpha), texels, 0x88);
+                        }
+                        _mm256_storeu_ps(row + i, texels);
+                    }
+                }
+#endif
+                for (; i < row_floats; i += CHANNELS) {
+                    const float alpha = table[256 + in[i + 3]];
+                    const float scale = premultiply ? alpha : 1.0f;
+                    for (size_t c = 0; c < 3; ++c) {
+                        row[i + c] = table[colour_offset + in[i + c]] * scale;
+                    }
+                    row[i + 3] = alpha;
+                }
+            }
+            });
+    }
+
+    void MipGenerator::downsampleBox(const std::vector<float>& src, uint32_t width, uint32_t height,
+        std::vector<float>& dst, JobSystem* jobs) {
+        const uint32_t out_width = std::max(1u, width / 2);
+        const uint32_t out_height = std::max(1u, height / 2);
+        dst.resize(size_t{ out_width } * out_height * CHANNELS);
+
+        forEachRowBatch(jobs, out_height, settings_.row_batch_size, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                const float* row0 = src.data() + std::min<size_t>(y * 2, height - 1) * width * CHANNELS;
+                const float* row1 = src.data() + std::min<size_t>(y * 2 + 1, height - 1) * width * CHANNELS;
+                float* out = dst.data() + y * out_width * CHANNELS;
+
+                uint32_t x = 0;
+#if defined(__AVX2__)
+                // Two output texels per step: source texels 4x..4x+3 of both rows
+                if (simd_ && width >= 2) {
+                    const __m256 quarter = _mm256_set1_ps(0.25f);
+                    for (; x + 2 <= out_width; x += 2) {
+                        const size_t i = size_t{ x } * 2 * CHANNELS;
+                        const __m256 a = _mm256_add_ps(_mm256_loadu_ps(row0 + i), _mm256_loadu_ps(row1 + i));
+                        const __m256 b = _mm256_add_ps(_mm256_loadu_ps(row0 + i + 8), _mm256_loadu_ps(row1 + i + 8));
+                        const __m256 left = _mm256_permute2f128_ps(a, b, 0x20);
+                        const __m256 right = _mm256_permute2f128_ps(a, b, 0x31);
+                        _mm256_storeu_ps(out + size_t{ x } * CHANNELS, _mm256_mul_ps(_mm256_add_ps(left, right), quarter));
+                    }
+                }
+#endif
+                for (; x < out_width; ++x) {
+                    const size_t x0 = std::min<size_t>(size_t{ x } * 2, width - 1) * CHANNELS;
+                    const size_t x1 = std::min<size_t>(size_t{ x } * 2 + 1, width - 1) * CHANNELS;
+                    for (size_t c = 0; c < CHANNELS; ++c) {
+                        out[x * CHANNELS + c] = ((row0[x0 + c] + row1[x0 + c]) + (row0[x1 + c] + row1[x1 + c])) * 0.25f;
+                    }
+                }
+            }
+            });
+    }
+
+    void MipGenerator::buildKaiserAxis(uint32_t src_size, uint32_t dst_size, FilterAxis& axis) const {
+        const double scale = static_cast<double>(src_size) / static_cast<double>(dst_size);
+        const double radius = settings_.kaiser_radius;
+        const double support = radius * scale;  // In source texels
+        const double alpha = settings_.kaiser_alpha;
+        const double window_norm = 1.0 / besselI0(alpha);
+
+        axis.taps = static_cast<uint32_t>(std::floor(support * 2.0)) + 2;
+        axis.taps += axis.taps & 1;
+        axis.first.resize(dst_size);
+        axis.weights.assign(size_t{ dst_size } * axis.taps, 0.0f);
+
+        for (uint32_t x = 0; x < dst_size; ++x) {
+            const double center = (x + 0.5) * scale - 0.5;
+            const int32_t first = static_cast<int32_t>(std::ceil(center - support));
+            axis.first[x] = first;
+
+            float* weights = axis.weights.data() + size_t{ x } * axis.taps;
+            double sum = 0.0;
+            for (uint32_t k = 0; k < axis.taps; ++k) {
+                const double t = (first + static_cast<int32_t>(k) - center) / scale;  // In output texels
+                if (std::abs(t) > radius) continue;
+                const double ratio = t / radius;
+                const double weight = sinc(t) * besselI0(alpha * std::sqrt(1.0 - ratio * ratio)) * window_norm;
+                weights[k] = static_cast<float>(weight);
+                sum += weight;
+            }
+            for (uint32_t k = 0; k < axis.taps; ++k) {
+                weights[k] = static_cast<float>(weights[k] / sum);
+            }
+        }
+    }
+
+    void MipGenerator::downsampleKaiser(const std::vector<float>& src, uint32_t width, uint32_t height,
+        std::vector<float>& dst, JobSystem* jobs) {
+        const uint32_t out_width = std::max(1u, width / 2);
+        const uint32_t out_height = std::max(1u, height / 2);
+        buildKaiserAxis(width, out_width, axis_x_);
+        buildKaiserAxis(height, out_height, axis_y_);
+
+        // Horizontal: every source row to out_width texels
+        temp_.resize(size_t{ out_width } * height * CHANNELS);
+        const uint32_t taps_x = axis_x_.taps;
+        forEachRowBatch(jobs, height, settings_.row_batch_size, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                const float* row = src.data() + y * width * CHANNELS;
+                float* out = temp_.data() + y * out_width * CHANNELS;
+                for (uint32_t x = 0; x < out_width; ++x) {
+                    const int32_t first = axis_x_.first[x];
+                    const float* weights = axis_x_.weights.data() + size_t{ x } * taps_x;
+                    const bool interior = first >= 0 && static_cast<uint32_t>(first) + taps_x <= width;
+#if defined(__AVX2__)
+                    // Two taps (eight floats) per step; only where no tap needs clamping
+                    if (simd_ && interior) {
+                        const float* texel = row + static_cast<size_t>(first) * CHANNELS;
+                        __m256 sum = _mm256_setzero_ps();
+                        for (uint32_t k = 0; k < taps_x; k += 2) {
+                            const __m256 weight = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(weights[k])),
+                                _mm_set1_ps(weights[k + 1]), 1);
+                            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(texel + size_t{ k } * CHANNELS), weight));
+                        }
+                        _mm_storeu_ps(out + size_t{ x } * CHANNELS,
+                            _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1)));
+                        continue;
+                    }
+#endif
+                    float sum[CHANNELS] = {};
+                    for (uint32_t k = 0; k < taps_x; ++k) {
+                        const int32_t column = interior ? first + static_cast<int32_t>(k)
+                            : std::clamp(first + static_cast<int32_t>(k), 0, static_cast<int32_t>(width) - 1);
+                        const float* texel = row + static_cast<size_t>(column) * CHANNELS;
+                        for (size_t c = 0; c < CHANNELS; ++c) sum[c] += texel[c] * weights[k];
+                    }
+                    for (size_t c = 0; c < CHANNELS; ++c) out[size_t{ x } * CHANNELS + c] = sum[c];
+                }
+            }
+            });
+
+        // Vertical: weighted sum of whole temp rows, edges clamped
+        dst.resize(size_t{ out_width } * out_height * CHANNELS);
+        const size_t row_floats = size_t{ out_width } * CHANNELS;
+        const uint32_t taps_y = axis_y_.taps;
+        forEachRowBatch(jobs, out_height, settings_.row_batch_size, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                float* out = dst.data() + y * row_floats;
+                std::fill(out, out + row_floats, 0.0f);
+                const float* weights = axis_y_.weights.data() + y * taps_y;
+                for (uint32_t k = 0; k < taps_y; ++k) {
+                    if (weights[k] == 0.0f) continue;
+                    const int32_t source = std::clamp(axis_y_.first[y] + static_cast<int32_t>(k), 0, static_cast<int32_t>(height) - 1);
+                    const float* row = temp_.data() + static_cast<size_t>(source) * row_floats;
+                    size_t i = 0;
+#if defined(__AVX2__)
+                    if (simd_) {
+                        const __m256 weight = _mm256_set1_ps(weights[k]);
+                        for (; i + 8 <= row_floats; i += 8) {
+                            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(_mm256_loadu_ps(row + i), weight)));
+                        }
+                    }
+#endif
+                    for (; i < row_floats; ++i) out[i] += row[i] * weights[k];
+                }
+            }
+            });
+    }
+
+    float MipGenerator::findCoverageScale(const std::vector<float>& level, float target) const {
+        // Histogram of alpha, walked from the top until enough texels pass
+        std::array<uint32_t, COVERAGE_BINS> histogram{};
+        const size_t texels = level.size() / CHANNELS;
+        for (size_t i = 3; i < level.size(); i += CHANNELS) {
+            const float alpha = std::clamp(level[i], 0.0f, 1.0f);
+            ++histogram[static_cast<size_t>(alpha * (COVERAGE_BINS - 1))];
+        }
+
+        const size_t wanted = std::max<size_t>(1, static_cast<size_t>(std::lround(target * static_cast<float>(texels))));
+        size_t passing = 0;
+        uint32_t bin = COVERAGE_BINS - 1;
+        for (;; --bin) {
+            const size_t above = passing;
+            passing += histogram[bin];
+            if (passing >= wanted) {
+                // Alpha is coarse in small mips; stopping one bin higher may land closer
+                if (above > 0 && wanted - above < passing - wanted) {
+                    while (histogram[++bin] == 0) {}
+                }
+                break;
+            }
+            if (bin == 1) break;
+        }
+
+        // Texels in this bin and above should land at or above the cutoff
+        const float threshold = static_cast<float>(bin) / static_cast<float>(COVERAGE_BINS - 1);
+        return settings_.alpha_cutoff / threshold;
+    }
+
+    void MipGenerator::quantize(const std::vector<float>& level, uint32_t width, uint32_t height, float alpha_scale,
+        std::vector<std::byte>& out, JobSystem* jobs) const {
+        const size_t row_floats = size_t{ width } * CHANNELS;
+        out.resize(row_floats * height);
+
+        // Premultiplied colour follows its alpha so the straight colour is unchanged
+        const float colour_scale = settings_.premultiply ? alpha_scale : 1.0f;
+        const bool srgb = settings_.srgb;
+        const float colour_steps = srgb ? static_cast<float>(SRGB_ENCODE_STEPS) : 255.0f;
+        const uint8_t* encode = encodeTable().values;
+
+        forEachRowBatch(jobs, height, settings_.row_batch_size, [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                const float* in = level.data() + y * row_floats;
+                auto* dst = reinterpret_cast<uint8_t*>(out.data()) + y * row_floats;
+                size_t i = 0;
+#if defined(__AVX2__)
+                if (simd_) {
+                    const __m256 scale = _mm256_setr_ps(colour_scale, colour_scale, colour_scale, alpha_scale,
+                        colour_scale, colour_scale, colour_scale, alpha_scale);
+                    const __m256 steps = _mm256_setr_ps(colour_steps, colour_steps, colour_steps, 255.0f,
+                        colour_steps, colour_steps, colour_steps, 255.0f);
+                    const __m256 zero = _mm256_setzero_ps();
+                    const __m256 one = _mm256_set1_ps(1.0f);
+                    const __m256 half = _mm256_set1_ps(0.5f);
+                    alignas(32) int32_t index[8];
+                    for (; i + 8 <= row_floats; i += 8) {
+                        const __m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), zero), one);
+                        _mm256_store_si256(reinterpret_cast<__m256i*>(index),
+                            _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(value, steps), half)));
+                        for (size_t lane = 0; lane < 8; ++lane) {
+                            const bool colour = (lane & 3) != 3;
+                            dst[i + lane] = colour && srgb ? encode[index[lane]] : static_cast<uint8_t>(index[lane]);
+                        }
+                    }
+                }
+#endif
+                for (; i < row_floats; ++i) {
+                    const bool colour = (i & 3) != 3;
+                    const float value = std::clamp(in[i] * (colour ? colour_scale : alpha_scale), 0.0f, 1.0f);
+                    const auto index = static_cast<int32_t>(value * (colour ? colour_steps : 255.0f) + 0.5f);
+                    dst[i] = colour && srgb ? encode[index] : static_cast<uint8_t>(index);
+                }
+            }
+            });
+    }
+
+    std::vector<MipBenchmarkResult> MipGenerator::benchmarkGenerate(JobSystem* jobs, MipFilter filter,
+        std::span<const uint32_t> sizes, uint32_t iterations) {
+        using Clock = std::chrono::steady_clock;
+        std::vector<MipBenchmarkResult> results;
+        results.reserve(sizes.size());
+
+        for (const uint32_t size : sizes) {
+            // Random texels; alpha noise makes coverage preservation do real work
+            std::mt19937 rng(1337);
+            std::uniform_int_distribution<int> channel(0, 255);
+            std::vector<std::byte> image(size_t{ size } * size * CHANNELS);
+            for (size_t i = 0; i < image.size(); ++i) {
+                image[i] = static_cast<std::byte>(channel(rng));
+            }
+
+            MipBenchmarkResult result;
+            result.size = size;
+            result.filter = filter;
+            result.iterations = std::max(iterations, 1u);
+
+            auto run = [&](bool simd) -> std::chrono::nanoseconds {
+                MipSettings settings;
+                settings.filter = filter;
+                settings.preserve_coverage = true;
+                settings.use_simd = simd;
+                MipGenerator generator(settings);
+                (void)generator.generate(image, size, size, jobs);  // Warm up scratch allocations
+
+                const auto start = Clock::now();
+                for (uint32_t iteration = 0; iteration < result.iterations; ++iteration) {
+                    (void)generator.generate(image, size, size, jobs);
+                }
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start) / result.iterations;
+                };
+
+            result.avg_scalar = run(false);
+            result.avg_simd = isSimdAvailable() ? run(true) : result.avg_scalar;
+            if (result.avg_simd.count() > 0) {
+                result.speedup = static_cast<double>(result.avg_scalar.count()) / static_cast<double>(result.avg_simd.count());
+            }
+            results.push_back(result);
+        }
+        return results;
+    }
+
+} // namespace AshCore
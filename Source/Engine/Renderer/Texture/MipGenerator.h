@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // SETTINGS
+    // ==========================================
+
+    enum class MipFilter : uint8_t {
+        Box = 0,    // 2x2 average; odd edges drop their last row/column
+        Kaiser      // Kaiser-windowed sinc; sharper, handles any size
+    };
+
+    struct MipSettings {
+        MipFilter filter = MipFilter::Box;
+        bool srgb = true;                 // Colour channels are sRGB encoded; alpha is always linear
+        bool premultiply = false;         // Output colour multiplied by alpha (done before filtering)
+        bool preserve_coverage = false;   // Rescale alpha so each mip passes the alpha test as often as mip 0
+        float alpha_cutoff = 0.5f;        // Alpha-test reference used by preserve_coverage
+        uint32_t max_mips = 0;            // 0 = full chain down to 1x1
+        float kaiser_alpha = 4.0f;        // Window shape; higher is smoother
+        float kaiser_radius = 3.0f;       // Filter support in output texels
+        size_t row_batch_size = 32;       // Rows per job
+        bool use_simd = true;             // AVX2 path when compiled in
+    };
+
+    struct MipBenchmarkResult {
+        uint32_t size = 0;
+        uint32_t iterations = 0;
+        MipFilter filter = MipFilter::Box;
+        std::chrono::nanoseconds avg_scalar{};
+        std::chrono::nanoseconds avg_simd{};
+        double speedup = 0.0;
+    };
+
+    // ==========================================
+    // MIP GENERATOR
+    // ==========================================
+
+    /**
+     * @brief Builds RGBA8 mip chains with gamma-correct filtering
+     *
+     * Mip 0 is expanded to linear float RGBA once; every further level is
+     * filtered from the previous float level (never from 8-bit data) and
+     * only then quantized, so rounding does not accumulate down the chain.
+     * Coverage preservation scales each level's alpha so the fraction of
+     * texels at or above alpha_cutoff matches mip 0, which keeps foliage
+     * from thinning out with distance.
+     *
+     * Scratch buffers are kept between calls; one generator per thread.
+     */
+    class MipGenerator {
+    public:
+        explicit MipGenerator(const MipSettings& settings = {});
+
+        // levels[m] is tightly packed RGBA8 of mip m; nullopt if the input size is wrong.
+        // jobs may be null for single-threaded filtering.
+        [[nodiscard]] std::optional<std::vector<std::vector<std::byte>>> generate(std::span<const std::byte> rgba,
+            uint32_t width, uint32_t height, JobSystem* jobs);
+
+        [[nodiscard]] const MipSettings& getSettings() const noexcept { return settings_; }
+        [[nodiscard]] static bool isSimdAvailable() noexcept;
+
+        // Random square textures, one result per size
+        [[nodiscard]] static std::vector<MipBenchmarkResult> benchmarkGenerate(JobSystem* jobs, MipFilter filter,
+            std::span<const uint32_t> sizes = DEFAULT_BENCHMARK_SIZES, uint32_t iterations = 10);
+
+        static constexpr std::array<uint32_t, 3> DEFAULT_BENCHMARK_SIZES = { 256, 1024, 2048 };
+
+    private:
+        // Per output texel along one axis: first source texel and a weight per tap
+        struct FilterAxis {
+            uint32_t taps = 0;                // Even, so the AVX2 path can take two at a time
+            std::vector<int32_t> first;
+            std::vector<float> weights;       // first.size() * taps
+        };
+
+        void expandTop(std::span<const std::byte> rgba, uint32_t width, uint32_t height, JobSystem* jobs);
+        void downsampleBox(const std::vector<float>& src, uint32_t width, uint32_t height, std::vector<float>& dst, JobSystem* jobs);
+        void downsampleKaiser(const std::vector<float>& src, uint32_t width, uint32_t height, std::vector<float>& dst, JobSystem* jobs);
+        void buildKaiserAxis(uint32_t src_size, uint32_t dst_size, FilterAxis& axis) const;
+        [[nodiscard]] float findCoverageScale(const std::vector<float>& level, float target) const;
+        void quantize(const std::vector<float>& level, uint32_t width, uint32_t height, float alpha_scale,
+            std::vector<std::byte>& out, JobSystem* jobs) const;
+
+    private:
+        MipSettings settings_;
+        bool simd_ = false;
+
+        std::vector<std::vector<float>> levels_;  // Linear float RGBA per mip
+        std::vector<float> temp_;                 // Kaiser horizontal pass output
+        FilterAxis axis_x_;
+        FilterAxis axis_y_;
+    };
+
+} // namespace AshCore
@@ -0,0 +1,59 @@
+#include "ashbornpch.h"
+
+#include "NullUploadBackend.h"
+
+#include <cstring>
+
+namespace AshCore {
+
+    std::expected<StagingBuffer, RendererError> NullUploadBackend::createStagingBuffer(uint64_t size) {
+        if (staging_handle_) {
+            return std::unexpected(RendererError::Unknown);  // One ring per backend
+        }
+
+        staging_memory_.assign(size, std::byte{ 0 });
+        staging_handle_ = GpuBufferHandle{ next_handle_++ };
+        return StagingBuffer{ staging_handle_, staging_memory_.data(), size };
+    }
+
+    void NullUploadBackend::destroyStagingBuffer(const StagingBuffer& buffer) {
+        if (buffer.buffer == staging_handle_) {
+            staging_memory_.clear();
+            staging_handle_ = {};
+        }
+    }
+
+    void NullUploadBackend::recordCopies(const UploadBatch& batch) {
+        // Execute immediately, in batch order, as a transfer queue would
+        for (const BufferCopyBatch& copy : batch.buffers) {
+            auto it = buffers_.find(copy.dst);
+            if (it == buffers_.end()) continue;
+
+            for (const BufferCopyRegion& region : copy.regions) {
+                if (region.dst_offset + region.size > it->second.size() ||
+                    region.src_offset + region.size > staging_memory_.size()) {
+                    print_e("Null upload backend: copy out of bounds", LogContext{
+                        {"dst_offset", region.dst_offset},
+                        {"size", region.size}
+                        });
+                    continue;
+                }
+                std::memcpy(it->second.data() + region.dst_offset, staging_memory_.data() + region.src_offset, region.size);
+            }
+        }
+
+        batches_.push_back(batch);
+    }
+
+    GpuBufferHandle NullUploadBackend::createBuffer(uint64_t size) {
+        const GpuBufferHandle handle{ next_handle_++ };
+        buffers_[handle].assign(size, std::byte{ 0 });
+        return handle;
+    }
+
+    const std::vector<std::byte>* NullUploadBackend::getBufferContents(GpuBufferHandle buffer) const {
+        auto it = buffers_.find(buffer);
+        return it != buffers_.end() ? &it->second : nullptr;
+    }
+
+} // namespace AshCore
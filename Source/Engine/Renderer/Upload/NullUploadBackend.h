@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Upload/UploadManager.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    // ==========================================
+    // NULL UPLOAD BACKEND
+    // ==========================================
+
+    /**
+     * @brief Executes upload batches on the CPU instead of a transfer queue
+     *
+     * Buffers created through createBuffer() are plain byte arrays, so the
+     * result of a batch can be read back and compared. Image copies are only
+     * recorded.
+     */
+    class NullUploadBackend final : public IUploadBackend {
+    public:
+        [[nodiscard]] std::expected<StagingBuffer, RendererError> createStagingBuffer(uint64_t size) override;
+        void destroyStagingBuffer(const StagingBuffer& buffer) override;
+        void recordCopies(const UploadBatch& batch) override;
+
+        // Fake destination resources
+        [[nodiscard]] GpuBufferHandle createBuffer(uint64_t size);
+        [[nodiscard]] const std::vector<std::byte>* getBufferContents(GpuBufferHandle buffer) const;
+
+        [[nodiscard]] const std::vector<UploadBatch>& getRecordedBatches() const noexcept { return batches_; }
+        void clearRecordedBatches() noexcept { batches_.clear(); }
+
+    private:
+        std::vector<std::byte> staging_memory_;
+        GpuBufferHandle staging_handle_;
+        std::unordered_map<GpuBufferHandle, std::vector<std::byte>> buffers_;
+        std::vector<UploadBatch> batches_;
+        uint64_t next_handle_ = 1;
+    };
+
+} // namespace AshCore
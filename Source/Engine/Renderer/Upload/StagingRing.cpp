@@ -0,0 +1,86 @@
+#include "ashbornpch.h"
+
+#include "StagingRing.h"
+
+namespace AshCore {
+
+    namespace {
+        uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept {
+            return alignment > 1 ? (value + alignment - 1) & ~(alignment - 1) : value;
+        }
+    }
+
+    StagingRing::StagingRing(std::byte* mapped, uint64_t capacity) {
+        reset(mapped, capacity);
+    }
+
+    void StagingRing::reset(std::byte* mapped, uint64_t capacity) {
+        mapped_ = mapped;
+        capacity_ = capacity;
+        head_ = 0;
+        tail_ = 0;
+        used_ = 0;
+        markers_.clear();
+    }
+
+    std::optional<StagingAllocation> StagingRing::allocate(uint64_t size, uint64_t alignment, uint64_t frame) {
+        if (size == 0 || size > capacity_) return std::nullopt;
+
+        const bool empty = markers_.empty();
+        if (!empty && head_ == tail_) return std::nullopt;  // Completely full
+
+        uint64_t offset = 0;
+        uint64_t new_head = 0;
+        const uint64_t aligned = alignUp(head_, alignment);
+
+        if (empty || head_ > tail_) {
+            // Free space is [head, capacity) followed by [0, tail)
+            if (aligned + size <= capacity_) {
+                offset = aligned;
+            }
+            else if (size <= tail_ || empty) {
+                offset = 0;  // Wrap; the end of the buffer is wasted this lap
+            }
+            else {
+                return std::nullopt;
+            }
+        }
+        else {
+            // Wrapped: free space is [head, tail)
+            if (aligned + size > tail_) return std::nullopt;
+            offset = aligned;
+        }
+
+        new_head = offset + size;
+        const uint64_t consumed = offset >= head_ ? new_head - head_ : (capacity_ - head_) + new_head;
+
+        if (!markers_.empty() && markers_.back().frame == frame) {
+            markers_.back().end = new_head;
+            markers_.back().bytes += consumed;
+        }
+        else {
+            markers_.push_back({ frame, new_head, consumed });
+        }
+
+        head_ = new_head;
+        used_ += consumed;
+
+        return StagingAllocation{ offset, size, mapped_ ? mapped_ + offset : nullptr };
+    }
+
+    void StagingRing::retire(uint64_t completed_frame) {
+        while (!markers_.empty() && markers_.front().frame <= completed_frame) {
+            tail_ = markers_.front().end;
+            used_ -= markers_.front().bytes;
+            markers_.pop_front();
+        }
+
+        // Rewind when idle so large allocations don't straddle the end
+        if (markers_.empty()) {
+            head_ = 0;
+            tail_ = 0;
+            used_ = 0;
+        }
+    }
+
+} // namespace AshCore
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace AshCore {
+
+    // ==========================================
+    // STAGING RING
+    // ==========================================
+
+    struct StagingAllocation {
+        uint64_t offset = 0;       // Offset in the staging buffer
+        uint64_t size = 0;
+        std::byte* data = nullptr; // Mapped pointer at offset
+    };
+
+    /**
+     * @brief Frame-fenced ring over a persistently mapped staging buffer
+     *
+     * Every allocation belongs to the frame that will consume it. Space is
+     * reclaimed in bulk once that frame's fence signals, so no per-upload
+     * bookkeeping or locking against the GPU is needed.
+     */
+    class StagingRing {
+    public:
+        StagingRing() = default;
+        StagingRing(std::byte* mapped, uint64_t capacity);
+
+        void reset(std::byte* mapped, uint64_t capacity);
+
+        // alignment must be a power of two
+        [[nodiscard]] std::optional<StagingAllocation> allocate(uint64_t size, uint64_t alignment, uint64_t frame);
+
+        // Reclaims everything allocated for frames <= completed_frame
+        void retire(uint64_t completed_frame);
+
+        [[nodiscard]] uint64_t getCapacity() const noexcept { return capacity_; }
+        [[nodiscard]] uint64_t getUsed() const noexcept { return used_; }
+        [[nodiscard]] bool isEmpty() const noexcept { return markers_.empty(); }
+
+    private:
+        // End of the region owned by each frame still in flight
+        struct FrameMarker {
+            uint64_t frame;
+            uint64_t end;
+            uint64_t bytes;  // Including wrap/alignment waste
+        };
+
+    private:
+        std::byte* mapped_ = nullptr;
+        uint64_t capacity_ = 0;
+        uint64_t head_ = 0;  // Next write position
+        uint64_t tail_ = 0;  // Start of the oldest live region
+        uint64_t used_ = 0;
+        std::deque<FrameMarker> markers_;
+    };
+
+} // namespace AshCore
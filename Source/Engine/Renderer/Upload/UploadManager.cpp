@@ -0,0 +1,325 @@
+#include "ashbornpch.h"
+
+#include "UploadManager.h"
+#include "Jobs/Task.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint64_t MB = 1024 * 1024;
+    }
+
+    // ==========================================
+    // CONSTRUCTOR / DESTRUCTOR
+    // ==========================================
+
+    UploadManager::UploadManager(IUploadBackend& backend, const RendererConfig& renderer_config, const UploadConfig& config)
+        : backend_(backend)
+        , config_(config)
+        , frames_in_flight_(std::max(renderer_config.max_frames_in_flight, 1u)) {
+    }
+
+    UploadManager::~UploadManager() {
+        std::lock_guard lock(mutex_);
+        if (!pending_.empty()) {
+            print_w("Upload manager destroyed with pending uploads", LogContext{ {"count", pending_.size()} });
+        }
+        {
+            std::lock_guard waiters_lock(waiters_mutex_);
+            if (!waiters_.empty()) {
+                print_w("Upload manager destroyed with coroutines awaiting uploads", LogContext{ {"count", waiters_.size()} });
+            }
+        }
+        if (staging_.buffer) {
+            backend_.destroyStagingBuffer(staging_);
+        }
+    }
+
+    std::expected<void, RendererError> UploadManager::initialize() {
+        const uint64_t capacity = getRingCapacity();
+
+        auto staging = backend_.createStagingBuffer(capacity);
+        if (!staging) {
+            print_e("Failed to create staging ring", LogContext{ {"size_mb", capacity / MB} });
+            return std::unexpected(staging.error());
+        }
+
+        std::lock_guard lock(mutex_);
+        staging_ = *staging;
+        ring_.reset(staging_.mapped, staging_.size);
+
+        print_s("Upload manager initialized", LogContext{
+            {"ring_mb", capacity / MB},
+            {"frame_budget_mb", config_.frame_budget / MB},
+            {"frames_in_flight", frames_in_flight_}
+            });
+        return {};
+    }
+
+    // ==========================================
+    // FRAME BOUNDARIES
+    // ==========================================
+
+    void UploadManager::beginFrame(uint64_t frame, uint64_t completed_frame) {
+        {
+            std::lock_guard lock(mutex_);
+            frame_ = frame;
+            bytes_this_frame_ = 0;
+
+            ring_.retire(completed_frame);
+            while (!in_flight_.empty() && in_flight_.front().frame <= completed_frame) {
+                completed_ticket_.store(in_flight_.front().ticket, std::memory_order_release);
+                in_flight_.pop_front();
+            }
+        }
+        // Unlocked: a coroutine resumed inline may enqueue its next upload
+        resumeWaiters();
+    }
+
+    bool UploadManager::addWaiter(UploadTicket ticket, std::coroutine_handle<> handle, JobSystem* jobs) {
+        std::lock_guard lock(waiters_mutex_);
+        // beginFrame() may have retired it since await_ready()
+        if (isComplete(ticket)) return false;
+        waiters_.push_back({ ticket.id, handle, jobs });
+        return true;
+    }
+
+    void UploadManager::resumeWaiters() {
+        std::vector<TicketWaiter> ready;
+        {
+            std::lock_guard lock(waiters_mutex_);
+            const auto retired = std::partition(waiters_.begin(), waiters_.end(),
+                [this](const TicketWaiter& waiter) { return !isComplete(UploadTicket{ waiter.ticket }); });
+            ready.assign(retired, waiters_.end());
+            waiters_.erase(retired, waiters_.end());
+        }
+        for (const TicketWaiter& waiter : ready) {
+            resumeOn(waiter.handle, waiter.jobs);
+        }
+    }
+
+    void UploadManager::flush() {
+        std::lock_guard lock(mutex_);
+
+        // Strict FIFO: stop at the first upload that doesn't fit this frame
+        while (!pending_.empty() && hasBudgetFor(pending_.front().data.size())) {
+            if (!stage(pending_.front())) break;
+
+            pending_bytes_ -= pending_.front().data.size();
+            pending_.pop_front();
+        }
+
+        UploadBatch batch;
+        batch.frame = frame_;
+        batch.staging = staging_.buffer;
+        buildBatch(batch);
+
+        if (!batch.isEmpty()) {
+            backend_.recordCopies(batch);
+            in_flight_.push_back({ frame_, last_ticket_staged_ });
+        }
+    }
+
+    // ==========================================
+    // SUBMISSION
+    // ==========================================
+
+    std::expected<UploadTicket, RendererError> UploadManager::enqueueBuffer(GpuBufferHandle dst, uint64_t dst_offset, std::vector<std::byte> data) {
+        if (data.empty()) return UploadTicket{};
+
+        PendingUpload upload;
+        upload.buffer = dst;
+        upload.dst_offset = dst_offset;
+        upload.data = std::move(data);
+        return enqueue(std::move(upload));
+    }
+
+    std::expected<UploadTicket, RendererError> UploadManager::enqueueImage(GpuImageHandle dst, std::vector<std::byte> data, std::vector<ImageCopyRegion> regions) {
+        if (data.empty() || regions.empty()) return UploadTicket{};
+
+        PendingUpload upload;
+        upload.image = dst;
+        upload.data = std::move(data);
+        upload.regions = std::move(regions);
+        return enqueue(std::move(upload));
+    }
+
+    std::expected<UploadTicket, RendererError> UploadManager::enqueue(PendingUpload upload) {
+        // Could never be staged, and its ticket would never complete
+        if (upload.data.size() > getRingCapacity()) {
+            print_e("Upload larger than the staging ring", LogContext{
+                {"bytes", upload.data.size()},
+                {"ring", getRingCapacity()}
+                });
+            return std::unexpected(RendererError::OutOfGPUMemory);
+        }
+
+        std::lock_guard lock(mutex_);
+        upload.ticket = nextTicket();
+        pending_bytes_ += upload.data.size();
+        pending_.push_back(std::move(upload));
+        return pending_.back().ticket;
+    }
+
+    std::optional<StagingWrite> UploadManager::writeBuffer(GpuBufferHandle dst, uint64_t dst_offset, uint64_t size) {
+        std::lock_guard lock(mutex_);
+
+        // Must not overtake queued uploads, or ticket completion would be out of order
+        if (!pending_.empty() || size == 0 || !hasBudgetFor(size)) {
+            return std::nullopt;
+        }
+
+        auto allocation = ring_.allocate(size, config_.alignment, frame_);
+        if (!allocation) {
+            return std::nullopt;
+        }
+
+        bytes_this_frame_ += size;
+        bytes_uploaded_total_ += size;
+        staged_buffer_regions_.push_back({ dst, BufferCopyRegion{ allocation->offset, dst_offset, size } });
+
+        const UploadTicket ticket = nextTicket();
+        last_ticket_staged_ = ticket.id;
+        return StagingWrite{ std::span<std::byte>(allocation->data, size), ticket };
+    }
+
+    UploadStats UploadManager::getStats() const {
+        std::lock_guard lock(mutex_);
+        return UploadStats{
+            .bytes_staged_this_frame = bytes_this_frame_,
+            .bytes_pending = pending_bytes_,
+            .uploads_pending = static_cast<uint32_t>(pending_.size()),
+            .regions_this_frame = last_regions_,
+            .copy_commands_this_frame = last_copy_commands_,
+            .ring_used = ring_.getUsed(),
+            .ring_capacity = ring_.getCapacity(),
+            .bytes_uploaded_total = bytes_uploaded_total_
+        };
+    }
+
+    // ==========================================
+    // INTERNAL
+    // ==========================================
+
+    bool UploadManager::hasBudgetFor(uint64_t size) const noexcept {
+        // An oversized upload is let through alone so it can't block the queue forever
+        return bytes_this_frame_ == 0 || bytes_this_frame_ + size <= config_.frame_budget;
+    }
+
+    bool UploadManager::stage(PendingUpload& upload) {
+        // enqueue() refused anything larger than the ring, so this fits once it drains
+        auto allocation = ring_.allocate(upload.data.size(), config_.alignment, frame_);
+        if (!allocation) {
+            return false;
+        }
+
+        if (allocation->data) {
+            std::memcpy(allocation->data, upload.data.data(), upload.data.size());
+        }
+
+        if (upload.buffer) {
+            staged_buffer_regions_.push_back({ upload.buffer,
+                BufferCopyRegion{ allocation->offset, upload.dst_offset, upload.data.size() } });
+        }
+        else {
+            for (ImageCopyRegion region : upload.regions) {
+                region.src_offset += allocation->offset;
+                staged_image_regions_.push_back({ upload.image, region });
+            }
+        }
+
+        bytes_this_frame_ += upload.data.size();
+        bytes_uploaded_total_ += upload.data.size();
+        last_ticket_staged_ = upload.ticket.id;
+        return true;
+    }
+
+    void UploadManager::buildBatch(UploadBatch& batch) {
+        last_regions_ = static_cast<uint32_t>(staged_buffer_regions_.size() + staged_image_regions_.size());
+        last_copy_commands_ = 0;
+
+        // ---- Buffers: sort by destination, split overlapping writes into later passes, merge neighbours
+        struct Entry {
+            GpuBufferHandle dst;
+            BufferCopyRegion region;
+            uint32_t sequence;
+            uint32_t pass = 0;
+        };
+
+        std::vector<Entry> entries;
+        entries.reserve(staged_buffer_regions_.size());
+        for (uint32_t i = 0; i < staged_buffer_regions_.size(); ++i) {
+            entries.push_back({ staged_buffer_regions_[i].first, staged_buffer_regions_[i].second, i });
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            if (a.dst != b.dst) return a.dst < b.dst;
+            if (a.region.dst_offset != b.region.dst_offset) return a.region.dst_offset < b.region.dst_offset;
+            return a.sequence < b.sequence;
+            });
+
+        // Overlapping writes within one copy command are undefined; order each
+        // cluster of overlapping regions by submission into successive passes
+        for (size_t begin = 0; begin < entries.size();) {
+            size_t end = begin + 1;
+            uint64_t cluster_end = entries[begin].region.dst_offset + entries[begin].region.size;
+            while (end < entries.size() && entries[end].dst == entries[begin].dst &&
+                entries[end].region.dst_offset < cluster_end) {
+                cluster_end = std::max(cluster_end, entries[end].region.dst_offset + entries[end].region.size);
+                ++end;
+            }
+
+            if (end - begin > 1) {
+                std::vector<Entry*> cluster;
+                for (size_t i = begin; i < end; ++i) cluster.push_back(&entries[i]);
+                std::sort(cluster.begin(), cluster.end(), [](const Entry* a, const Entry* b) { return a->sequence < b->sequence; });
+                for (uint32_t pass = 0; pass < cluster.size(); ++pass) cluster[pass]->pass = pass;
+            }
+            begin = end;
+        }
+
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.pass < b.pass; });
+
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const Entry& entry = entries[i];
+            if (batch.buffers.empty() || batch.buffers.back().dst != entry.dst || entries[i - 1].pass != entry.pass) {
+                batch.buffers.push_back({ entry.dst, {} });
+            }
+
+            auto& regions = batch.buffers.back().regions;
+            if (!regions.empty()) {
+                BufferCopyRegion& last = regions.back();
+                if (last.dst_offset + last.size == entry.region.dst_offset &&
+                    last.src_offset + last.size == entry.region.src_offset) {
+                    last.size += entry.region.size;  // Contiguous on both sides
+                    continue;
+                }
+            }
+            regions.push_back(entry.region);
+        }
+
+        // ---- Images: group per image, a repeated (mip, layer) starts a new pass
+        std::map<std::tuple<uint64_t, uint32_t, uint32_t>, uint32_t> subresource_writes;
+        std::map<std::pair<uint64_t, uint32_t>, size_t> batch_for_pass;
+        for (const auto& [image, region] : staged_image_regions_) {
+            const uint32_t pass = subresource_writes[{ image.value, region.mip_level, region.array_layer }]++;
+
+            auto [it, inserted] = batch_for_pass.try_emplace({ image.value, pass }, batch.images.size());
+            if (inserted) {
+                batch.images.push_back({ image, {} });
+            }
+            batch.images[it->second].regions.push_back(region);
+        }
+
+        for (const auto& buffer : batch.buffers) last_copy_commands_ += static_cast<uint32_t>(buffer.regions.size());
+        for (const auto& image : batch.images) last_copy_commands_ += static_cast<uint32_t>(image.regions.size());
+
+        staged_buffer_regions_.clear();
+        staged_image_regions_.clear();
+    }
+
+} // namespace AshCore
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "RenderTypes.h"
+#include "Upload/StagingRing.h"
+#include "Engine/AshbornEngine.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace AshCore {
+
+    class JobSystem;
+
+    // ==========================================
+    // COPY REGIONS
+    // ==========================================
+
+    struct BufferCopyRegion {
+        uint64_t src_offset;  // In the staging buffer
+        uint64_t dst_offset;
+        uint64_t size;
+    };
+
+    // Mirrors VkBufferImageCopy (tightly packed rows)
+    struct ImageCopyRegion {
+        uint64_t src_offset;
+        uint32_t mip_level = 0;
+        uint32_t array_layer = 0;
+        uint32_t offset[3] = { 0, 0, 0 };
+        uint32_t extent[3] = { 1, 1, 1 };
+    };
+
+    struct BufferCopyBatch {
+        GpuBufferHandle dst;
+        std::vector<BufferCopyRegion> regions;  // Sorted by dst_offset, adjacent ranges merged
+    };
+
+    struct ImageCopyBatch {
+        GpuImageHandle dst;
+        std::vector<ImageCopyRegion> regions;
+    };
+
+    // Everything one frame records: one vkCmdCopyBuffer/vkCmdCopyBufferToImage per entry.
+    // A destination only appears twice when writes overlap; later entries need a
+    // transfer->transfer barrier against earlier ones.
+    struct UploadBatch {
+        uint64_t frame = 0;
+        GpuBufferHandle staging;
+        std::vector<BufferCopyBatch> buffers;
+        std::vector<ImageCopyBatch> images;
+
+        [[nodiscard]] bool isEmpty() const noexcept { return buffers.empty() && images.empty(); }
+    };
+
+    // ==========================================
+    // BACKEND INTERFACE
+    // ==========================================
+
+    struct StagingBuffer {
+        GpuBufferHandle buffer;
+        std::byte* mapped = nullptr;
+        uint64_t size = 0;
+    };
+
+    class IUploadBackend {
+    public:
+        virtual ~IUploadBackend() = default;
+
+        [[nodiscard]] virtual std::expected<StagingBuffer, RendererError> createStagingBuffer(uint64_t size) = 0;
+        virtual void destroyStagingBuffer(const StagingBuffer& buffer) = 0;
+
+        // Records the batch into the frame's transfer commands (with the needed barriers)
+        virtual void recordCopies(const UploadBatch& batch) = 0;
+    };
+
+    // ==========================================
+    // UPLOAD MANAGER
+    // ==========================================
+
+    struct UploadConfig {
+        uint64_t frame_budget = 32ull * 1024 * 1024;   // Staged bytes per frame
+        uint64_t alignment = 16;                       // optimalBufferCopyOffsetAlignment, texel size
+    };
+
+    // Completes once the frame it was staged in has retired on the GPU
+    struct UploadTicket {
+        uint64_t id = 0;
+        [[nodiscard]] bool isValid() const noexcept { return id != 0; }
+    };
+
+    // Direct write into the ring (no intermediate copy); fill `data` before flush()
+    struct StagingWrite {
+        std::span<std::byte> data;
+        UploadTicket ticket;
+    };
+
+    struct UploadStats {
+        uint64_t bytes_staged_this_frame = 0;
+        uint64_t bytes_pending = 0;
+        uint32_t uploads_pending = 0;
+        uint32_t regions_this_frame = 0;       // Before coalescing
+        uint32_t copy_commands_this_frame = 0; // After coalescing
+        uint64_t ring_used = 0;
+        uint64_t ring_capacity = 0;
+        uint64_t bytes_uploaded_total = 0;
+    };
+
+    /**
+     * @brief Streams CPU data to GPU buffers/images through a staging ring
+     *
+     * The ring holds frame_budget * max_frames_in_flight bytes. Uploads are
+     * staged strictly in submission order so a later write to a range never
+     * overtakes an earlier one; anything over the frame budget waits for the
+     * next frame. flush() hands one coalesced batch per frame to the backend.
+     *
+     * beginFrame()/flush() belong to the render thread; enqueue*(),
+     * writeBuffer() and completion() may be called from any thread (loader
+     * coroutines, jobs). An upload larger than the whole ring is refused at
+     * enqueue time, so every ticket handed out eventually completes.
+     */
+    class UploadManager {
+    public:
+        UploadManager(IUploadBackend& backend, const RendererConfig& renderer_config, const UploadConfig& config = {});
+        ~UploadManager();
+
+        UploadManager(const UploadManager&) = delete;
+        UploadManager& operator=(const UploadManager&) = delete;
+
+        [[nodiscard]] std::expected<void, RendererError> initialize();
+
+        // Frame boundaries: completed_frame is the newest frame whose fence signalled
+        void beginFrame(uint64_t frame, uint64_t completed_frame);
+        void flush();
+
+        // Queued uploads (data is owned until staged). Empty data gives an
+        // already complete ticket; more than getRingCapacity() bytes fails.
+        [[nodiscard]] std::expected<UploadTicket, RendererError> enqueueBuffer(GpuBufferHandle dst, uint64_t dst_offset, std::vector<std::byte> data);
+        [[nodiscard]] std::expected<UploadTicket, RendererError> enqueueImage(GpuImageHandle dst, std::vector<std::byte> data, std::vector<ImageCopyRegion> regions);
+
+        // Zero-copy path; fails (nullopt) when the ring or budget can't take it this frame
+        [[nodiscard]] std::optional<StagingWrite> writeBuffer(GpuBufferHandle dst, uint64_t dst_offset, uint64_t size);
+
+        [[nodiscard]] bool isComplete(UploadTicket ticket) const noexcept {
+            return ticket.id <= completed_ticket_.load(std::memory_order_acquire);
+        }
+
+        // co_await uploads.completion(ticket) from any thread. The coroutine
+        // resumes from beginFrame() once the ticket retires, as a job when
+        // jobs is given.
+        [[nodiscard]] auto completion(UploadTicket ticket, JobSystem* jobs = nullptr) noexcept {
+            struct Awaiter {
+                UploadManager& uploads;
+                UploadTicket ticket;
+                JobSystem* jobs;
+
+                bool await_ready() const noexcept { return uploads.isComplete(ticket); }
+                bool await_suspend(std::coroutine_handle<> handle) { return uploads.addWaiter(ticket, handle, jobs); }
+                void await_resume() const noexcept {}
+            };
+            return Awaiter{ *this, ticket, jobs };
+        }
+        [[nodiscard]] UploadStats getStats() const;
+
+        // frame_budget * max_frames_in_flight: the largest single upload
+        [[nodiscard]] uint64_t getRingCapacity() const noexcept { return config_.frame_budget * frames_in_flight_; }
+
+    private:
+        struct PendingUpload {
+            UploadTicket ticket;
+            GpuBufferHandle buffer;
+            GpuImageHandle image;
+            uint64_t dst_offset = 0;
+            std::vector<std::byte> data;
+            std::vector<ImageCopyRegion> regions;  // src_offset relative to data
+        };
+
+        struct StagedTicket {
+            uint64_t frame;
+            uint64_t ticket;
+        };
+
+        struct TicketWaiter {
+            uint64_t ticket;
+            std::coroutine_handle<> handle;
+            JobSystem* jobs;
+        };
+
+        [[nodiscard]] std::expected<UploadTicket, RendererError> enqueue(PendingUpload upload);
+
+        // These expect mutex_ held
+        bool stage(PendingUpload& upload);
+        bool hasBudgetFor(uint64_t size) const noexcept;
+        UploadTicket nextTicket() noexcept { return UploadTicket{ ++last_ticket_ }; }
+        void buildBatch(UploadBatch& batch);
+
+        bool addWaiter(UploadTicket ticket, std::coroutine_handle<> handle, JobSystem* jobs);  // False if already complete
+        void resumeWaiters();
+
+    private:
+        IUploadBackend& backend_;
+        UploadConfig config_;
+        uint32_t frames_in_flight_;
+
+        // Guards everything below except the ticket waiters
+        mutable std::mutex mutex_;
+
+        StagingBuffer staging_{};
+        StagingRing ring_;
+        uint64_t frame_ = 0;
+        uint64_t bytes_this_frame_ = 0;
+
+        std::deque<PendingUpload> pending_;
+        uint64_t pending_bytes_ = 0;
+
+        // Regions staged this frame, grouped into batches at flush()
+        std::vector<std::pair<GpuBufferHandle, BufferCopyRegion>> staged_buffer_regions_;
+        std::vector<std::pair<GpuImageHandle, ImageCopyRegion>> staged_image_regions_;
+
+        std::deque<StagedTicket> in_flight_;
+        uint64_t last_ticket_ = 0;
+        uint64_t last_ticket_staged_ = 0;
+        std::atomic<uint64_t> completed_ticket_{ 0 };
+
+        std::mutex waiters_mutex_;
+        std::vector<TicketWaiter> waiters_;
+
+        uint32_t last_regions_ = 0;
+        uint32_t last_copy_commands_ = 0;
+        uint64_t bytes_uploaded_total_ = 0;
+    };
+
+} // namespace AshCore
@@ -84,6 +84,7 @@ int main_with_control([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
             print_i("Performance", LogContext{
                 {"fps", stats.fps},
                 {"chunks", stats.chunks_loaded},
+                {"entities", stats.entities_active},
                 {"faces", stats.faces_rendered}
                 });
             last_report = timing.total_time;
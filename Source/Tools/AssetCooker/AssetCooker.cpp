@@ -0,0 +1,470 @@
+#include "AssetCooker.h"
+
+#include <Core/Logger/log.h>
+#include <Core/IO/AsyncIo.h>
+#include <Core/Jobs/JobSystem.h>
+#include <Asset/AssetPack.h>
+#include <Asset/CookedTexture.h>
+#include <Texture/AtlasPacker.h>
+#include <Texture/MipGenerator.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <sstream>
+
+namespace AshCore {
+
+    namespace {
+        constexpr uint32_t COOK_VERSION = 3;  // Bump to recook everything after a cooker change
+        constexpr std::string_view DIRECTORY_SETTINGS = "dir.cook";
+        constexpr std::string_view SETTINGS_EXTENSION = ".cook";
+        constexpr std::string_view COOKED_TEXTURE_EXTENSION = ".ashtex";
+        constexpr std::array<std::string_view, 5> IMAGE_EXTENSIONS = { ".png", ".tga", ".jpg", ".jpeg", ".bmp" };
+
+        std::string toLower(std::string text) {
+            std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return text;
+        }
+
+        std::string_view trim(std::string_view text) {
+            const auto begin = text.find_first_not_of(" \t\r");
+            if (begin == std::string_view::npos) return {};
+            const auto end = text.find_last_not_of(" \t\r");
+            return text.substr(begin, end - begin + 1);
+        }
+
+        bool isImage(const std::filesystem::path& path) {
+            const std::string extension = toLower(path.extension().string());
+            return std::find(IMAGE_EXTENSIONS.begin(), IMAGE_EXTENSIONS.end(), extension) != IMAGE_EXTENSIONS.end();
+        }
+
+        // Write-then-rename; the .tmp name is ignored by the hot reload watcher
+        bool writeFileAtomic(const std::filesystem::path& path, std::span<const std::byte> data) {
+            std::error_code error;
+            std::filesystem::create_directories(path.parent_path(), error);
+
+            std::filesystem::path temp = path;
+            temp += ".tmp";
+            {
+                std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+                if (!file) return false;
+                file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                if (!file) return false;
+            }
+            std::filesystem::rename(temp, path, error);
+            return !error;
+        }
+
+        std::string formatKey(uint64_t key) {
+            char buffer[17];
+            std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(key));
+            return buffer;
+        }
+
+        std::string replaceExtension(const std::string& path, std::string_view extension) {
+            std::filesystem::path replaced(path);
+            replaced.replace_extension(extension);
+            return replaced.generic_string();
+        }
+    }
+
+    // ==========================================
+    // SETTINGS
+    // ==========================================
+
+    bool TextureCookSettings::apply(std::string_view key, std::string_view value) {
+        auto toBool = [&](bool& target) {
+            if (value == "1" || value == "true" || value == "yes") { target = true; return true; }
+            if (value == "0" || value == "false" || value == "no") { target = false; return true; }
+            return false;
+        };
+
+        auto toUint = [&](uint32_t& target) {
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), target);
+            return error == std::errc{} && end == value.data() + value.size();
+        };
+
+        if (key == "srgb") return toBool(srgb);
+        if (key == "mips") return toBool(mips);
+        if (key == "premultiply") return toBool(premultiply);
+        if (key == "coverage") return toBool(preserve_coverage);
+        if (key == "filter") {
+            if (value == "box") { filter = MipFilter::Box; return true; }
+            if (value == "kaiser") { filter = MipFilter::Kaiser; return true; }
+            return false;
+        }
+        if (key == "alpha_cutoff") {
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), alpha_cutoff);
+            return error == std::errc{} && end == value.data() + value.size() && alpha_cutoff > 0.0f && alpha_cutoff <= 1.0f;
+        }
+        if (key == "atlas") {
+            atlas = std::string(value);
+            return true;
+        }
+        if (key == "atlas_padding") return toUint(atlas_padding);
+        if (key == "atlas_size") return toUint(atlas_size) && atlas_size > 0;
+        return false;
+    }
+
+    std::string TextureCookSettings::describe() const {
+        std::string text = "srgb=";
+        text += srgb ? '1' : '0';
+        text += ";mips=";
+        text += mips ? '1' : '0';
+        text += ";premultiply=";
+        text += premultiply ? '1' : '0';
+        text += ";filter=";
+        text += filter == MipFilter::Kaiser ? "kaiser" : "box";
+        text += ";coverage=";
+        text += preserve_coverage ? std::to_string(alpha_cutoff) : "0";
+        text += ";atlas=";
+        text += atlas;
+        if (!atlas.empty()) {
+            text += ";padding=" + std::to_string(atlas_padding) + ";size=" + std::to_string(atlas_size);
+        }
+        return text;
+    }
+
+    // ==========================================
+    // COOKER
+    // ==========================================
+
+    AssetCooker::AssetCooker(AssetCookerOptions options)
+        : options_(std::move(options)) {
+        if (options_.cache_file.empty()) {
+            options_.cache_file = options_.output;
+            options_.cache_file += ".cookcache";
+        }
+    }
+
+    TextureCookSettings AssetCooker::loadSettings(const std::string& image) const {
+        TextureCookSettings settings;
+
+        auto applyFile = [&](const std::filesystem::path& file) {
+            std::ifstream stream(file);
+            std::string line;
+            for (uint32_t number = 1; std::getline(stream, line); ++number) {
+                std::string_view text = trim(line);
+                if (text.empty() || text.front() == '#') continue;
+
+                const auto equals = text.find('=');
+                const std::string_view key = trim(text.substr(0, equals));
+                const std::string_view value = equals == std::string_view::npos ? std::string_view{} : trim(text.substr(equals + 1));
+                if (equals == std::string_view::npos || !settings.apply(key, value)) {
+                    print_w("Ignoring cook setting", LogContext{
+                        {"file", file.string()},
+                        {"line", number},
+                        {"text", std::string(text)}
+                        });
+                }
+            }
+        };
+
+        // dir.cook from the source root down to the image's directory, then the image's own
+        std::filesystem::path directory = options_.source;
+        std::error_code ec;
+        if (std::filesystem::exists(directory / DIRECTORY_SETTINGS, ec)) applyFile(directory / DIRECTORY_SETTINGS);
+        const std::filesystem::path relative(image);
+        for (const auto& part : relative.parent_path()) {
+            directory /= part;
+            if (std::filesystem::exists(directory / DIRECTORY_SETTINGS, ec)) applyFile(directory / DIRECTORY_SETTINGS);
+        }
+
+        std::filesystem::path own = options_.source / relative;
+        own += SETTINGS_EXTENSION;
+        if (std::filesystem::exists(own, ec)) applyFile(own);
+        return settings;
+    }
+
+    std::expected<std::vector<AssetCooker::Step>, AssetError> AssetCooker::planSteps() const {
+        std::error_code ec;
+        std::vector<std::string> files;
+        for (auto it = std::filesystem::recursive_directory_iterator(options_.source, ec);
+            !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (it->is_regular_file(ec)) {
+                files.push_back(std::filesystem::relative(it->path(), options_.source).generic_string());
+            }
+        }
+        if (ec) {
+            print_e("Failed to walk source directory", LogContext{ {"path", options_.source.string()}, {"error", ec.message()} });
+            return std::unexpected(AssetError::PathNotFound);
+        }
+        std::sort(files.begin(), files.end());
+
+        std::vector<Step> steps;
+        std::map<std::string, Step> atlases;  // Ordered, so step order does not depend on the walk
+        for (const std::string& file : files) {
+            const std::filesystem::path path(file);
+            if (path.extension() == SETTINGS_EXTENSION) continue;
+
+            if (!isImage(path)) {
+                steps.push_back({ StepKind::Copy, { file }, file, {} });
+                continue;
+            }
+
+            TextureCookSettings settings = loadSettings(file);
+            if (settings.atlas.empty()) {
+                steps.push_back({ StepKind::Texture, { file }, replaceExtension(file, COOKED_TEXTURE_EXTENSION), std::move(settings) });
+                continue;
+            }
+
+            const std::string output = normalizeAssetPath(settings.atlas) + std::string(COOKED_TEXTURE_EXTENSION);
+            auto [it, inserted] = atlases.try_emplace(output);
+            Step& atlas = it->second;
+            if (inserted) {
+                atlas = { StepKind::Atlas, {}, output, settings };
+            }
+            else if (settings.describe() != atlas.settings.describe()) {
+                print_w("Atlas image settings differ from the first image; using the first", LogContext{
+                    {"atlas", output},
+                    {"image", file}
+                    });
+            }
+            atlas.inputs.push_back(file);
+        }
+        for (auto& [output, atlas] : atlases) {
+            steps.push_back(std::move(atlas));
+        }
+
+        // a.png and a.tga would both cook to a.ashtex
+        std::unordered_map<std::string, const Step*> outputs;
+        for (const Step& step : steps) {
+            auto [it, inserted] = outputs.try_emplace(step.output, &step);
+            if (!inserted) {
+                print_e("Two sources cook to the same output", LogContext{
+                    {"output", step.output},
+                    {"first", it->second->inputs.front()},
+                    {"second", step.inputs.front()}
+                    });
+                return std::unexpected(AssetError::CorruptedAsset);
+            }
+        }
+        return steps;
+    }
+
+    AssetCooker::StepResult AssetCooker::runStep(const Step& step, JobSystem& jobs, AsyncIo& io) const {
+        StepResult result;
+
+        // The key covers the cooker version, settings and every input's name and content
+        std::string identity = std::to_string(COOK_VERSION);
+        identity += '|';
+        identity += std::to_string(static_cast<int>(step.kind));
+        identity += '|';
+        identity += step.settings.describe();
+
+        // An atlas's inputs are all read in one batch
+        std::vector<FileReadRequest> requests;
+        requests.reserve(step.inputs.size());
+        for (const std::string& input : step.inputs) {
+            requests.push_back({ options_.source / input });
+        }
+        std::vector<FileReadResult> reads = syncWait(io.readBatch(std::move(requests)));
+
+        std::vector<std::vector<std::byte>> contents;
+        contents.reserve(step.inputs.size());
+        for (size_t i = 0; i < step.inputs.size(); ++i) {
+            if (!reads[i]) {
+                print_e("Failed to read source", LogContext{ {"path", step.inputs[i]} });
+                return result;
+            }
+            identity += '|';
+            identity += step.inputs[i];
+            identity += ':';
+            identity += formatKey(hashAssetContent(*reads[i]));
+            contents.push_back(std::move(*reads[i]));
+        }
+        result.key = hashAssetPath(identity);
+
+        const std::filesystem::path output = options_.output / step.output;
+        std::error_code ec;
+        if (!options_.force) {
+            auto cached = cache_.find(step.output);
+            if (cached != cache_.end() && cached->second == result.key && std::filesystem::exists(output, ec)) {
+                result.outcome = Outcome::UpToDate;
+                return result;
+            }
+        }
+
+        if (step.kind == StepKind::Copy) {
+            result.outcome = writeFileAtomic(output, contents.front()) ? Outcome::Copied : Outcome::Failed;
+            return result;
+        }
+
+        const TextureCookSettings& settings = step.settings;
+
+        // An atlas can have hundreds of inputs; they decode across the whole pool.
+        // Premultiplication is left to the mip generator.
+        std::vector<EncodedImage> encoded;
+        encoded.reserve(contents.size());
+        for (size_t i = 0; i < contents.size(); ++i) {
+            encoded.push_back({ contents[i], step.inputs[i] });
+        }
+        ImageDecodeSettings decode_settings;
+        decode_settings.srgb = settings.srgb;
+
+        std::vector<DecodedImage> images;
+        images.reserve(contents.size());
+        for (auto& image : decodeImages(encoded, decode_settings, image_pool_, &jobs)) {
+            if (!image) return result;
+            images.push_back(std::move(*image));
+        }
+
+        CookedTextureHeader header{};
+        header.magic = COOKED_TEXTURE_MAGIC;
+        header.version = COOKED_TEXTURE_VERSION;
+        header.format = settings.srgb ? CookedTextureFormat::RGBA8Srgb : CookedTextureFormat::RGBA8Unorm;
+        header.flags = static_cast<uint8_t>(settings.premultiply ? COOKED_TEXTURE_PREMULTIPLIED : 0);
+        header.cook_key = result.key;
+
+        // Layers to mip: the image itself, or the composed atlas pages
+        std::vector<std::byte> atlas_pages;
+        AtlasPackSettings pack_settings;
+        std::span<const std::byte> pages;
+        std::vector<CookedAtlasRegion> regions;
+        if (step.kind == StepKind::Atlas) {
+            std::vector<AtlasImage> sources;
+            sources.reserve(images.size());
+            for (const DecodedImage& image : images) {
+                sources.push_back({ image.pixels.getData(), image.width, image.height });
+            }
+
+            pack_settings.max_size = settings.atlas_size;
+            pack_settings.padding = settings.atlas_padding;
+            const auto layout = packAtlas(sources, pack_settings);
+            if (!layout || layout->page_count > UINT16_MAX || sources.size() > UINT16_MAX) {
+                print_e("Failed to pack atlas", LogContext{ {"atlas", step.output}, {"images", sources.size()} });
+                return result;
+            }
+            atlas_pages = composeAtlas(*layout, sources, pack_settings.padding, nullptr);
+            pages = atlas_pages;
+
+            for (size_t i = 0; i < step.inputs.size(); ++i) {
+                const AtlasPlacement& placement = layout->placements[i];
+                const std::string name = replaceExtension(step.inputs[i], "");
+                regions.push_back({ hashAssetPath(name), placement.page, placement.x, placement.y, placement.width, placement.height, 0 });
+            }
+
+            header.width = layout->width;
+            header.height = layout->height;
+            header.layer_count = static_cast<uint16_t>(layout->page_count);
+            header.region_count = static_cast<uint16_t>(regions.size());
+            header.flags |= COOKED_TEXTURE_ARRAY;
+        }
+        else {
+            pages = images.front().pixels.getData();
+            header.width = images.front().width;
+            header.height = images.front().height;
+            header.layer_count = 1;
+        }
+
+        MipSettings mip_settings;
+        mip_settings.filter = settings.filter;
+        mip_settings.srgb = settings.srgb;
+        mip_settings.premultiply = settings.premultiply;
+        mip_settings.preserve_coverage = settings.preserve_coverage;
+        mip_settings.alpha_cutoff = settings.alpha_cutoff;
+        mip_settings.max_mips = settings.mips ? 0 : 1;
+        if (settings.mips && step.kind == StepKind::Atlas) {
+            // Levels past this would average neighbouring regions together
+            mip_settings.max_mips = getAtlasMipLimit(pack_settings, mip_settings);
+            print_d("Atlas mips limited by padding", LogContext{ {"atlas", step.output}, {"mips", mip_settings.max_mips} });
+        }
+        MipGenerator generator(mip_settings);
+
+        // Steps already run in parallel, so each one filters on its own thread
+        const size_t layer_bytes = size_t{ header.width } * header.height * getTexelSize(header.format);
+        std::vector<std::vector<std::byte>> mips;
+        for (uint32_t layer = 0; layer < header.layer_count; ++layer) {
+            auto chain = generator.generate(pages.subspan(layer * layer_bytes, layer_bytes), header.width, header.height, nullptr);
+            if (!chain) return result;
+            if (mips.empty()) mips.resize(chain->size());
+            for (size_t mip = 0; mip < chain->size(); ++mip) {
+                mips[mip].insert(mips[mip].end(), (*chain)[mip].begin(), (*chain)[mip].end());
+            }
+        }
+        header.mip_count = static_cast<uint16_t>(mips.size());
+
+        auto blob = serializeCookedTexture(header, mips, regions);
+        if (!blob || !writeFileAtomic(output, *blob)) {
+            print_e("Failed to write cooked texture", LogContext{ {"path", output.string()} });
+            return result;
+        }
+        result.outcome = Outcome::Cooked;
+        return result;
+    }
+
+    void AssetCooker::loadCache() {
+        cache_.clear();
+        std::ifstream stream(options_.cache_file);
+        std::string line;
+        while (std::getline(stream, line)) {
+            const auto space = line.find(' ');
+            if (space != 16) continue;  // "<16 hex digits> <output>"
+            cache_[line.substr(space + 1)] = std::strtoull(line.substr(0, space).c_str(), nullptr, 16);
+        }
+    }
+
+    bool AssetCooker::saveCache(const std::vector<Step>& steps, const std::vector<StepResult>& results) const {
+        // Failed steps are left out so the next run retries them
+        std::ostringstream text;
+        for (size_t i = 0; i < steps.size(); ++i) {
+            if (results[i].outcome == Outcome::Failed) continue;
+            text << formatKey(results[i].key) << ' ' << steps[i].output << '\n';
+        }
+        const std::string data = text.str();
+        return writeFileAtomic(options_.cache_file, std::as_bytes(std::span(data.data(), data.size())));
+    }
+
+    std::expected<AssetCookerStats, AssetError> AssetCooker::run(JobSystem& jobs) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(options_.source, ec)) {
+            print_e("Source is not a directory", LogContext{ {"path", options_.source.string()} });
+            return std::unexpected(AssetError::PathNotFound);
+        }
+
+        auto steps = planSteps();
+        if (!steps) return std::unexpected(steps.error());
+        loadCache();
+
+        // Reads resume on the completion thread, so a step waiting on them needs no free worker
+        AsyncIo io(nullptr);
+
+        std::vector<StepResult> results(steps->size());
+        jobs.parallelFor(steps->size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                results[i] = runStep((*steps)[i], jobs, io);
+            }
+            });
+
+        AssetCookerStats stats;
+        for (const StepResult& result : results) {
+            switch (result.outcome) {
+            case Outcome::Cooked: ++stats.cooked; break;
+            case Outcome::Copied: ++stats.copied; break;
+            case Outcome::UpToDate: ++stats.up_to_date; break;
+            case Outcome::Failed: ++stats.failed; break;
+            }
+        }
+
+        // Outputs cooked last time whose sources have since disappeared
+        std::unordered_map<std::string, bool> current;
+        for (const Step& step : *steps) current.emplace(step.output, true);
+        for (const auto& [output, key] : cache_) {
+            if (!current.contains(output) && std::filesystem::remove(options_.output / output, ec)) {
+                ++stats.removed;
+            }
+        }
+
+        if (!saveCache(*steps, results)) {
+            print_w("Failed to write cook cache", LogContext{ {"path", options_.cache_file.string()} });
+        }
+        return stats;
+    }
+
+} // namespace AshCore
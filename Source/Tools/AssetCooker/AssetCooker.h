@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Engine/AshbornEngine.h>
+#include <Asset/ImageDecoder.h>
+#include <Texture/MipGenerator.h>
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AshCore {
+
+    class AsyncIo;
+    class JobSystem;
+
+    // Settings come from the nearest dir.cook files (outermost first) and
+    // then the image's own <image>.cook; both are "key = value" lines
+    struct TextureCookSettings {
+        bool srgb = true;
+        bool mips = true;
+        bool premultiply = false;
+        MipFilter filter = MipFilter::Box;
+        bool preserve_coverage = false;  // For alpha-tested foliage
+        float alpha_cutoff = 0.5f;
+        std::string atlas;               // Non-empty: the image is packed into this atlas
+        uint32_t atlas_padding = 4;      // More padding keeps more atlas mips clean
+        uint32_t atlas_size = 4096;      // Page limit; larger atlases get more array layers
+
+        bool apply(std::string_view key, std::string_view value);
+
+        // Stable text form; part of the cook key
+        [[nodiscard]] std::string describe() const;
+    };
+
+    struct AssetCookerOptions {
+        std::filesystem::path source;
+        std::filesystem::path output;
+        std::filesystem::path cache_file;  // Empty = <output>.cookcache
+        bool force = false;                // Ignore the cache and cook everything
+    };
+
+    struct AssetCookerStats {
+        uint32_t cooked = 0;
+        uint32_t copied = 0;
+        uint32_t up_to_date = 0;
+        uint32_t failed = 0;
+        uint32_t removed = 0;  // Outputs whose sources are gone
+    };
+
+    /**
+     * @brief Converts a source content tree into cooked, GPU-ready assets
+     *
+     * Images become .ashtex files with their mip chains generated (and
+     * alpha premultiplied if asked); images sharing an atlas setting are
+     * packed into one padded atlas, paged into array layers, with a region
+     * table naming where each went. Everything else is copied through. Each output is
+     * keyed by a hash of its inputs' contents and settings, recorded in the
+     * cache file, so a rerun only redoes outputs whose key changed. Steps
+     * run in parallel on the job system, and an atlas decodes its images
+     * on it as well.
+     */
+    class AssetCooker {
+    public:
+        explicit AssetCooker(AssetCookerOptions options);
+
+        [[nodiscard]] std::expected<AssetCookerStats, AssetError> run(JobSystem& jobs);
+
+    private:
+        enum class StepKind : uint8_t {
+            Texture,
+            Atlas,
+            Copy
+        };
+
+        enum class Outcome : uint8_t {
+            Cooked,
+            Copied,
+            UpToDate,
+            Failed
+        };
+
+        struct Step {
+            StepKind kind = StepKind::Copy;
+            std::vector<std::string> inputs;  // Relative to the source root, sorted
+            std::string output;               // Relative to the output root
+            TextureCookSettings settings;
+        };
+
+        struct StepResult {
+            Outcome outcome = Outcome::Failed;
+            uint64_t key = 0;
+        };
+
+        [[nodiscard]] std::expected<std::vector<Step>, AssetError> planSteps() const;
+        [[nodiscard]] TextureCookSettings loadSettings(const std::string& image) const;
+        [[nodiscard]] StepResult runStep(const Step& step, JobSystem& jobs, AsyncIo& io) const;
+
+        void loadCache();
+        [[nodiscard]] bool saveCache(const std::vector<Step>& steps, const std::vector<StepResult>& results) const;
+
+    private:
+        AssetCookerOptions options_;
+        std::unordered_map<std::string, uint64_t> cache_;  // Output -> key it was cooked with
+        ImageBufferPool image_pool_;                        // Shared by concurrent steps
+    };
+
+} // namespace AshCore
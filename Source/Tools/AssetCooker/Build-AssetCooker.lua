@@ -0,0 +1,39 @@
+-- Source/Tools/AssetCooker/Build-AssetCooker.lua
+-- Offline tool that turns source content into GPU-ready cooked assets
+
+project "AssetCooker"
+    location( _SCRIPT_DIR )
+    targetdir "../../../Build/%{cfg.buildcfg}"
+    kind "ConsoleApp"
+    language "C++"
+    staticruntime "Off"
+
+    files {
+        "**.h",
+        "**.cpp"
+    }
+
+    includedirs {
+        ".",
+
+        -- Engine access
+        "../../Engine",
+        "../../Engine/Core",
+        "../../Engine/Renderer",
+        "../../Engine/World",
+
+        -- Dependencies
+        "%{IncludeDir.stb}"
+    }
+
+    links {
+        "Engine"
+    }
+
+    defines {
+        "ASHBORN_TOOLS"
+    }
+
+    -- Cooking is CPU bound; keep it fast even in Debug
+    filter "configurations:Debug"
+        optimize "Speed"
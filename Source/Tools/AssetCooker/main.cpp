@@ -0,0 +1,128 @@
+#include "AssetCooker.h"
+
+#include <Core/Logger/log.h>
+#include <Core/Jobs/JobSystem.h>
+#include <Asset/ImageDecoder.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+
+    void printUsage() {
+        std::cerr << "Usage: AssetCooker <source_dir> <output_dir> [--cache <file>] [--force]\n"
+                  << "       AssetCooker --benchmark-decode [<image_dir>]\n";
+    }
+
+    // Every image under the directory, or a generated stand-in when none is given
+    std::vector<std::vector<std::byte>> loadCorpus(const std::filesystem::path& directory) {
+        if (directory.empty()) {
+            return makeImageBenchmarkCorpus();
+        }
+
+        std::vector<std::vector<std::byte>> corpus;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (!entry.is_regular_file() || (extension != ".png" && extension != ".tga" && extension != ".jpg" && extension != ".jpeg" && extension != ".bmp")) {
+                continue;
+            }
+
+            std::ifstream file(entry.path(), std::ios::binary);
+            std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            auto& data = corpus.emplace_back(bytes.size());
+            std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char*>(data.data()));
+        }
+        return corpus;
+    }
+
+    int benchmarkDecode(const std::filesystem::path& directory) {
+        const auto corpus = loadCorpus(directory);
+        if (corpus.empty()) {
+            print_e("No images to benchmark", LogContext{ {"path", directory.string()} });
+            return 1;
+        }
+
+        JobSystem jobs(0, "AssetCooker");
+        const ImageDecodeBenchmarkResult result = benchmarkImageDecode(corpus, &jobs);
+        print_i("Image decode benchmark", LogContext{
+            {"images", result.images},
+            {"encoded_kb", result.encoded_bytes / 1024},
+            {"decoded_kb", result.decoded_bytes / 1024},
+            {"threads", jobs.getThreadCount()},
+            {"serial_ms", result.serial_ms},
+            {"parallel_ms", result.parallel_ms},
+            {"speedup", result.speedup},
+            {"megapixels_per_second", result.megapixels_per_second},
+            {"convert_scalar_ms", result.convert_scalar_ms},
+            {"convert_simd_ms", result.convert_simd_ms}
+            });
+        return 0;
+    }
+
+    int cook(const AssetCookerOptions& options) {
+        JobSystem jobs(0, "AssetCooker");
+        AssetCooker cooker(options);
+
+        const auto stats = cooker.run(jobs);
+        if (!stats) {
+            return 1;
+        }
+
+        print_i("Cook finished", LogContext{
+            {"output", options.output.string()},
+            {"cooked", stats->cooked},
+            {"copied", stats->copied},
+            {"up_to_date", stats->up_to_date},
+            {"removed", stats->removed},
+            {"failed", stats->failed}
+            });
+        return stats->failed == 0 ? 0 : 1;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const bool benchmark = argc >= 2 && std::string(argv[1]) == "--benchmark-decode";
+    if (argc < (benchmark ? 2 : 3) || (benchmark && argc > 3)) {
+        printUsage();
+        return 2;
+    }
+
+    AssetCookerOptions options;
+    if (!benchmark) {
+        options.source = argv[1];
+        options.output = argv[2];
+    }
+    for (int i = 3; i < argc && !benchmark; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--force") {
+            options.force = true;
+        }
+        else if (arg == "--cache" && i + 1 < argc) {
+            options.cache_file = argv[++i];
+        }
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (auto result = Logger::init(); !result) {
+        std::cerr << "Logger init failed\n";
+        return 1;
+    }
+
+    const int exit_code = benchmark ? benchmarkDecode(argc == 3 ? argv[2] : std::filesystem::path{}) : cook(options);
+
+    if (!Logger::shutdown()) {
+        std::cerr << "Logger shutdown failed\n";
+    }
+    return exit_code;
+}
@@ -0,0 +1,32 @@
+-- Source/Tools/AssetPacker/Build-AssetPacker.lua
+-- Offline tool that bundles a content directory into an .ashpack archive
+
+project "AssetPacker"
+    location( _SCRIPT_DIR )
+    targetdir "../../../Build/%{cfg.buildcfg}"
+    kind "ConsoleApp"
+    language "C++"
+    staticruntime "Off"
+
+    files {
+        "**.h",
+        "**.cpp"
+    }
+
+    includedirs {
+        ".",
+
+        -- Engine access
+        "../../Engine",
+        "../../Engine/Core",
+        "../../Engine/Renderer",
+        "../../Engine/World"
+    }
+
+    links {
+        "Engine"
+    }
+
+    defines {
+        "ASHBORN_TOOLS"
+    }
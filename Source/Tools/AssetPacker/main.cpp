@@ -0,0 +1,124 @@
+#include <Core/Logger/log.h>
+#include <Core/Jobs/JobSystem.h>
+#include <Asset/AssetPack.h>
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+
+    void printUsage() {
+        std::cerr << "Usage: AssetPacker <input_dir> <output.ashpack> [--compress] [--align <bytes>]\n";
+    }
+
+    std::optional<std::vector<std::byte>> readWholeFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return std::nullopt;
+
+        const std::streamsize size = file.tellg();
+        if (size < 0) return std::nullopt;
+
+        std::vector<std::byte> data(static_cast<size_t>(size));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(data.data()), size)) return std::nullopt;
+        return data;
+    }
+
+    int pack(const std::filesystem::path& input, const std::filesystem::path& output, const AssetPackWriteOptions& options) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(input, ec)) {
+            print_e("Input is not a directory", LogContext{ {"path", input.string()} });
+            return 1;
+        }
+
+        // Sorted so logs and failures are reproducible; the writer sorts again for the layout
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input, ec)) {
+            if (entry.is_regular_file()) files.push_back(entry.path());
+        }
+        if (ec) {
+            print_e("Failed to walk input directory", LogContext{ {"path", input.string()}, {"error", ec.message()} });
+            return 1;
+        }
+        std::sort(files.begin(), files.end());
+
+        AssetPackWriter writer(options);
+        for (const auto& file : files) {
+            const std::string relative = std::filesystem::relative(file, input).generic_string();
+            auto data = readWholeFile(file);
+            if (!data) {
+                print_e("Failed to read input file", LogContext{ {"path", file.string()} });
+                return 1;
+            }
+            if (!writer.add(relative, std::move(*data))) {
+                return 1;
+            }
+        }
+
+        JobSystem jobs(0, "AssetPacker");
+        const auto stats = writer.write(output, &jobs);
+        if (!stats) {
+            return 1;
+        }
+
+        print_i("Asset pack written", LogContext{
+            {"path", output.string()},
+            {"entries", stats->entries},
+            {"compressed", stats->compressed},
+            {"deduplicated", stats->deduplicated},
+            {"deduplicated_kb", stats->deduplicated_bytes / 1024},
+            {"raw_kb", stats->raw_bytes / 1024},
+            {"stored_kb", stats->stored_bytes / 1024},
+            {"file_kb", stats->file_bytes / 1024}
+            });
+        return 0;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printUsage();
+        return 2;
+    }
+
+    AssetPackWriteOptions options;
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--compress") {
+            options.compress = true;
+        }
+        else if (arg == "--align" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), options.alignment);
+            if (error != std::errc{} || end != value.data() + value.size() || options.alignment == 0) {
+                printUsage();
+                return 2;
+            }
+        }
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (auto result = Logger::init(); !result) {
+        std::cerr << "Logger init failed\n";
+        return 1;
+    }
+
+    const int exit_code = pack(argv[1], argv[2], options);
+
+    if (!Logger::shutdown()) {
+        std::cerr << "Logger shutdown failed\n";
+    }
+    return exit_code;
+}
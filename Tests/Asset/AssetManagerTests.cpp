@@ -0,0 +1,272 @@
+#include "TestFramework.h"
+
+#include "Asset/AssetManager.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    struct TestAsset {
+        std::string path;
+    };
+
+    // Assets live in memory: a path loads unless it is marked broken
+    class TestLoader final : public AssetLoader<TestAsset> {
+    public:
+        TestLoader(std::map<std::string, std::vector<std::string>>& dependencies, std::set<std::string>& broken)
+            : dependencies_(dependencies), broken_(broken) {}
+
+        std::expected<std::unique_ptr<TestAsset>, AssetError> load(AssetLoadContext& context) override {
+            if (broken_.contains(context.getPath())) return std::unexpected(AssetError::CorruptedAsset);
+            for (const std::string& dependency : dependencies_[context.getPath()]) {
+                context.addDependency<TestAsset>(dependency);
+            }
+            return std::make_unique<TestAsset>(TestAsset{ context.getPath() });
+        }
+
+    private:
+        std::map<std::string, std::vector<std::string>>& dependencies_;
+        std::set<std::string>& broken_;
+    };
+
+    struct Fixture {
+        std::map<std::string, std::vector<std::string>> dependencies;
+        std::set<std::string> broken;
+        AssetManager assets;
+
+        explicit Fixture(bool async = false) : assets(makeConfig(async)) {
+            assets.registerLoader<TestAsset>(std::make_unique<TestLoader>(dependencies, broken));
+        }
+
+        static AssetConfig makeConfig(bool async) {
+            AssetConfig config;
+            config.asset_paths = {};
+            config.async_loading = async;
+            config.loader_threads = 2;
+            return config;
+        }
+    };
+
+    // Every asset reports the same size, so the budget holds a fixed count
+    constexpr size_t ASSET_BYTES = 256 * 1024;
+
+    class SizedLoader final : public AssetLoader<TestAsset> {
+    public:
+        std::expected<std::unique_ptr<TestAsset>, AssetError> load(AssetLoadContext& context) override {
+            return std::make_unique<TestAsset>(TestAsset{ context.getPath() });
+        }
+
+        size_t getMemorySize(const TestAsset&) const override { return ASSET_BYTES; }
+    };
+
+    // Four assets to the megabyte
+    struct CacheFixture {
+        AssetManager assets;
+
+        CacheFixture() : assets(makeConfig()) {
+            assets.registerLoader<TestAsset>(std::make_unique<SizedLoader>());
+        }
+
+        static AssetConfig makeConfig() {
+            AssetConfig config = Fixture::makeConfig(false);
+            config.cache_size_mb = 1;
+            config.finalize_budget_ms = 1000.0;
+            return config;
+        }
+
+        // Loads and finalizes, then drops the reference and lets update() enforce the budget
+        AssetId use(const std::string& path) {
+            const AssetId id = assets.load<TestAsset>(path).id;
+            assets.update();
+            assets.release(id);
+            assets.update();
+            return id;
+        }
+
+        // Evicted records bump their generation, so the old id reads Unknown
+        bool isResident(AssetId id) const { return assets.getState(id) == AssetState::Ready; }
+    };
+}
+
+TEST(AssetManager, FailedAssetIsFreedOnceReleased) {
+    Fixture fixture;
+    fixture.broken.insert("broken.tex");
+
+    const AssetHandle<TestAsset> handle = fixture.assets.load<TestAsset>("broken.tex");
+    fixture.assets.update();
+    CHECK(fixture.assets.getState(handle.id) == AssetState::Failed);
+    CHECK(fixture.assets.getStats().failed == 1);
+
+    fixture.assets.release(handle);
+    CHECK(fixture.assets.getState(handle.id) == AssetState::Unknown);
+    fixture.assets.update();
+    CHECK(fixture.assets.getStats().failed == 0);
+
+    // The next request loads again instead of returning the cached failure
+    fixture.broken.clear();
+    const AssetHandle<TestAsset> retry = fixture.assets.load<TestAsset>("broken.tex");
+    fixture.assets.update();
+    CHECK(fixture.assets.getState(retry.id) == AssetState::Ready);
+    CHECK(fixture.assets.get(retry) != nullptr);
+}
+
+TEST(AssetManager, ReloadingFailedDependencyRetriesDependents) {
+    Fixture fixture;
+    fixture.dependencies["stone.mat"] = { "stone.tex" };
+    fixture.broken.insert("stone.tex");
+
+    const AssetHandle<TestAsset> material = fixture.assets.load<TestAsset>("stone.mat");
+    fixture.assets.update();
+    REQUIRE(fixture.assets.getState(material.id) == AssetState::Failed);
+    CHECK(fixture.assets.getStats().failed == 2);  // The texture stays alive through the material
+
+    fixture.broken.clear();
+    CHECK(fixture.assets.reload("stone.tex") == 2);
+    fixture.assets.update();
+    CHECK(fixture.assets.getState(material.id) == AssetState::Ready);
+    REQUIRE(fixture.assets.get(material) != nullptr);
+    CHECK(fixture.assets.get(material)->path == "stone.mat");
+    CHECK(fixture.assets.getStats().ready == 2);
+    CHECK(fixture.assets.getStats().failed == 0);
+}
+
+TEST(AssetManager, FailedDependentReleasesItsDependencies) {
+    Fixture fixture;
+    fixture.dependencies["stone.mat"] = { "stone.tex", "stone.normal" };
+    fixture.broken.insert("stone.normal");
+
+    const AssetHandle<TestAsset> material = fixture.assets.load<TestAsset>("stone.mat");
+    fixture.assets.update();
+    REQUIRE(fixture.assets.getState(material.id) == AssetState::Failed);
+
+    fixture.assets.release(material);
+    fixture.assets.update();
+    CHECK(fixture.assets.getStats().failed == 0);
+    CHECK(fixture.assets.getStats().ready == 1);  // stone.tex, now unreferenced and cached
+}
+
+TEST(AssetManager, StatsCountAsyncLoads) {
+    Fixture fixture(true);
+    std::vector<AssetId> ids;
+    for (int i = 0; i < 32; ++i) {
+        ids.push_back(fixture.assets.load<TestAsset>("asset" + std::to_string(i)).id);
+    }
+    fixture.assets.update();
+    const AssetStats& stats = fixture.assets.getStats();
+    CHECK(stats.queued + stats.loading + stats.waiting_finalize + stats.ready == 32);
+
+    for (const AssetId id : ids) CHECK(fixture.assets.wait(id) == AssetState::Ready);
+    fixture.assets.update();
+    CHECK(fixture.assets.getStats().ready == 32);
+}
+
+TEST(AssetManager, LoadsOverBudgetEvictDownToIt) {
+    CacheFixture fixture;
+    fixture.assets.update();
+    const size_t budget = fixture.assets.getCacheStats().budget_bytes;
+    REQUIRE(budget == 4 * ASSET_BYTES);
+
+    std::vector<AssetId> ids;
+    for (int i = 0; i < 10; ++i) {
+        ids.push_back(fixture.use("asset" + std::to_string(i)));
+        CHECK(fixture.assets.getCacheStats().resident_bytes <= budget);
+    }
+    const AssetCacheStats& stats = fixture.assets.getCacheStats();
+    CHECK(stats.resident_bytes == budget);
+    CHECK(stats.evictions == 6);
+    CHECK(stats.evicted_bytes == 6 * ASSET_BYTES);
+    CHECK(fixture.assets.getStats().ready == 4);
+
+    // Oldest first: only the last four survive
+    for (int i = 0; i < 10; ++i) CHECK(fixture.isResident(ids[i]) == (i >= 6));
+}
+
+TEST(AssetManager, ReferencedAndPinnedAssetsAreNeverEvicted) {
+    CacheFixture fixture;
+    const AssetId pinned = fixture.assets.load<TestAsset>("pinned").id;
+    fixture.assets.update();
+    REQUIRE(fixture.assets.pin(pinned));
+    fixture.assets.release(pinned);
+    const AssetId held = fixture.assets.load<TestAsset>("held").id;
+
+    for (int i = 0; i < 20; ++i) fixture.use("sweep" + std::to_string(i));
+    CHECK(fixture.isResident(pinned));
+    CHECK(fixture.isResident(held));
+    CHECK(fixture.assets.getCacheStats().pinned_bytes == ASSET_BYTES);
+    CHECK(fixture.assets.getCacheStats().resident_bytes <= fixture.assets.getCacheStats().budget_bytes);
+
+    // With everything pinned or referenced the budget gives way instead
+    std::vector<AssetId> extra;
+    for (int i = 0; i < 4; ++i) extra.push_back(fixture.assets.load<TestAsset>("extra" + std::to_string(i)).id);
+    fixture.assets.update();
+    CHECK(fixture.assets.getCacheStats().resident_bytes == 6 * ASSET_BYTES);
+    for (const AssetId id : extra) fixture.assets.release(id);
+
+    fixture.assets.unpin(pinned);
+    fixture.assets.release(held);
+    for (int i = 0; i < 8; ++i) fixture.use("after" + std::to_string(i));
+    CHECK(!fixture.isResident(pinned));
+    CHECK(!fixture.isResident(held));
+}
+
+TEST(AssetManager, RecentGhostHitGrowsTheRecentTarget) {
+    CacheFixture fixture;
+    const AssetCacheStats& stats = fixture.assets.getCacheStats();
+
+    // Two reused assets on the frequent list keep the recent list under the
+    // whole budget, so what it evicts is remembered
+    for (const char* hot : { "hot0", "hot1" }) {
+        fixture.use(hot);
+        fixture.use(hot);
+    }
+    for (int i = 0; i < 4; ++i) fixture.use("asset" + std::to_string(i));
+    CHECK(stats.recent_target_bytes == 0);
+    CHECK(stats.recent_ghost_bytes == 2 * ASSET_BYTES);
+
+    // asset0 was evicted from the recent list; asking again means it went too soon
+    const AssetId again = fixture.use("asset0");
+    CHECK(stats.ghost_hits == 1);
+    CHECK(stats.recent_target_bytes == ASSET_BYTES);
+    CHECK(fixture.isResident(again));
+    CHECK(stats.frequent_bytes == 3 * ASSET_BYTES);  // A ghost hit comes back as frequent
+
+    // With the recent list at its target, a new asset pushes hot0 off the frequent list
+    fixture.use("promoted");
+    fixture.use("promoted");
+    fixture.use("new");
+    CHECK(stats.frequent_ghost_bytes == ASSET_BYTES);
+
+    // And a frequent ghost hit gives the recent list's share back
+    fixture.use("hot0");
+    CHECK(stats.ghost_hits == 2);
+    CHECK(stats.recent_target_bytes == 0);
+}
+
+TEST(AssetManager, GhostListsStayBounded) {
+    CacheFixture fixture;
+    fixture.assets.update();
+    const size_t budget = fixture.assets.getCacheStats().budget_bytes;
+
+    // A reused working set on the frequent list, then a long sweep with
+    // some quick repeats, so both lists and both ghost lists fill
+    for (int i = 0; i < 6; ++i) fixture.use("hot" + std::to_string(i % 3));
+    size_t most_frequent_ghosts = 0;
+    for (int i = 0; i < 300; ++i) {
+        fixture.use("sweep" + std::to_string(i));
+        fixture.use("hot" + std::to_string(i % 3));
+        if (i % 5 == 4) fixture.use("sweep" + std::to_string(i - 2));
+
+        const AssetCacheStats& stats = fixture.assets.getCacheStats();
+        CHECK(stats.recent_bytes + stats.recent_ghost_bytes <= budget);
+        CHECK(stats.resident_bytes + stats.recent_ghost_bytes + stats.frequent_ghost_bytes <= 2 * budget);
+        most_frequent_ghosts = std::max(most_frequent_ghosts, stats.frequent_ghost_bytes);
+    }
+    CHECK(fixture.assets.getCacheStats().evictions > 250);
+    CHECK(fixture.assets.getCacheStats().ghost_hits > 0);
+    CHECK(most_frequent_ghosts > 0);
+}
@@ -0,0 +1,219 @@
+#include "TestFramework.h"
+
+#include "Asset/AssetPack.h"
+#include "Asset/PackCompression.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    using Bytes = std::vector<std::byte>;
+
+    struct TempDirectory {
+        std::filesystem::path path;
+
+        TempDirectory() {
+            path = std::filesystem::temp_directory_path() / "ashborn_assetpack_test";
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path);
+        }
+
+        ~TempDirectory() {
+            std::error_code error;
+            std::filesystem::remove_all(path, error);
+        }
+    };
+
+    Bytes noise(size_t size, uint32_t seed) {
+        std::mt19937 rng(seed);
+        Bytes bytes(size);
+        for (std::byte& b : bytes) b = static_cast<std::byte>(rng());
+        return bytes;
+    }
+
+    Bytes pattern(size_t size) {
+        Bytes bytes(size);
+        for (size_t i = 0; i < size; ++i) bytes[i] = static_cast<std::byte>((i / 64) % 3);
+        return bytes;
+    }
+
+    // Empty, incompressible, highly compressible, a duplicate, and enough
+    // small entries to fill several perfect hash buckets
+    std::map<std::string, Bytes> makeEntries() {
+        std::map<std::string, Bytes> entries;
+        entries["empty.bin"] = {};
+        entries["noise.bin"] = noise(10000, 1);
+        entries["pattern.bin"] = pattern(200000);
+        entries["copy/pattern.bin"] = pattern(200000);
+        for (uint32_t i = 0; i < 150; ++i) {
+            entries["textures/t" + std::to_string(i) + ".png"] = noise(1 + i * 13, 100 + i);
+        }
+        return entries;
+    }
+
+    std::filesystem::path writePack(const std::filesystem::path& directory, const std::map<std::string, Bytes>& entries) {
+        AssetPackWriter writer({ .compress = true, .alignment = 256 });
+        for (const auto& [path, data] : entries) REQUIRE(writer.add(path, data));
+        const std::filesystem::path file = directory / "test.pack";
+        REQUIRE(writer.write(file, nullptr).has_value());
+        return file;
+    }
+
+    Bytes readFile(const std::filesystem::path& file) {
+        std::ifstream in(file, std::ios::binary);
+        std::vector<char> chars((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        Bytes bytes(chars.size());
+        if (!chars.empty()) std::memcpy(bytes.data(), chars.data(), chars.size());
+        return bytes;
+    }
+
+    // Writes a damaged copy of a pack and opens it
+    std::expected<std::unique_ptr<AssetPack>, AssetError> openDamaged(const std::filesystem::path& directory, Bytes bytes,
+        const std::function<void(Bytes&)>& damage) {
+        damage(bytes);
+        const std::filesystem::path file = directory / "damaged.pack";
+        std::ofstream(file, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(bytes.data()),
+            static_cast<std::streamsize>(bytes.size()));
+        return AssetPack::open(file);
+    }
+
+    AssetPackHeader headerOf(const Bytes& bytes) {
+        AssetPackHeader header{};
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        return header;
+    }
+
+    // Applies fn to the first used slot whose flags match
+    void editSlot(Bytes& bytes, uint32_t flags, const std::function<void(AssetPackEntry&)>& fn) {
+        const AssetPackHeader header = headerOf(bytes);
+        for (uint32_t slot = 0; slot < header.slot_count; ++slot) {
+            std::byte* at = bytes.data() + header.slots_offset + size_t{ slot } * sizeof(AssetPackEntry);
+            AssetPackEntry entry{};
+            std::memcpy(&entry, at, sizeof(entry));
+            if (entry.flags != flags) continue;
+            fn(entry);
+            std::memcpy(at, &entry, sizeof(entry));
+            return;
+        }
+        REQUIRE(false);
+    }
+}
+
+TEST(PackCompression, RoundTripsEdgeSizes) {
+    for (const size_t size : { size_t{ 0 }, size_t{ 1 }, size_t{ 12 }, size_t{ 13 }, size_t{ 4096 }, size_t{ 70000 } }) {
+        for (const Bytes& source : { noise(size, 7), pattern(size) }) {
+            Bytes packed(lz4CompressBound(size));
+            const size_t packed_size = lz4Compress(source, packed);
+            REQUIRE(packed_size > 0);
+            packed.resize(packed_size);
+
+            Bytes unpacked(size);
+            CHECK(lz4Decompress(packed, unpacked));
+            CHECK(unpacked == source);
+        }
+    }
+}
+
+TEST(AssetPack, RoundTripsEveryEntry) {
+    TempDirectory directory;
+    const std::map<std::string, Bytes> entries = makeEntries();
+    auto pack = AssetPack::open(writePack(directory.path, entries));
+    REQUIRE(pack.has_value());
+    CHECK((*pack)->getEntryCount() == entries.size());
+    CHECK((*pack)->getEntries().size() == entries.size());
+
+    for (const auto& [path, data] : entries) {
+        const auto info = (*pack)->find(path);
+        REQUIRE(info.has_value());
+        CHECK(info->path == path);
+        CHECK(info->size == data.size());
+
+        const auto bytes = (*pack)->read(path, true);
+        REQUIRE(bytes.has_value());
+        CHECK(*bytes == data);
+
+        if (!info->compressed) {
+            const auto view = (*pack)->view(path, true);
+            REQUIRE(view.has_value());
+            CHECK(std::equal(view->begin(), view->end(), data.begin(), data.end()));
+        }
+    }
+
+    CHECK((*pack)->find("pattern.bin")->compressed);
+    CHECK(!(*pack)->find("noise.bin")->compressed);
+    CHECK(!(*pack)->find("empty.bin")->compressed);
+    CHECK((*pack)->read("./copy\\pattern.bin", false).has_value());
+}
+
+TEST(AssetPack, MissingPathIsNotFound) {
+    TempDirectory directory;
+    auto pack = AssetPack::open(writePack(directory.path, makeEntries()));
+    REQUIRE(pack.has_value());
+
+    for (const char* path : { "missing.bin", "textures/t150.png", "textures", "noise.bin2" }) {
+        CHECK(!(*pack)->contains(path));
+        CHECK(!(*pack)->view(path).has_value());
+        const auto bytes = (*pack)->read(path, true);
+        CHECK(!bytes && bytes.error() == AssetError::PathNotFound);
+    }
+    CHECK(AssetPack::open(directory.path / "none.pack").error() == AssetError::PathNotFound);
+}
+
+TEST(AssetPack, RejectsTruncatedAndCorruptLayouts) {
+    TempDirectory directory;
+    const Bytes good = readFile(writePack(directory.path, makeEntries()));
+    REQUIRE(openDamaged(directory.path, good, [](Bytes&) {}).has_value());
+
+    const std::vector<std::function<void(Bytes&)>> damages = {
+        [](Bytes& b) { b.resize(sizeof(AssetPackHeader) - 1); },
+        [](Bytes& b) { b.resize(b.size() / 2); },
+        [](Bytes& b) { b[0] = std::byte{ 'X' }; },
+        [](Bytes& b) { b[offsetof(AssetPackHeader, version)] = std::byte{ 99 }; },
+        [](Bytes& b) { b[offsetof(AssetPackHeader, entry_count)] ^= std::byte{ 1 }; },
+        [](Bytes& b) { b[offsetof(AssetPackHeader, slots_offset)] ^= std::byte{ 8 }; },
+        [](Bytes& b) {
+            const AssetPackHeader header = headerOf(b);
+            b[header.strings_offset + header.strings_size - 1] = std::byte{ 'x' };
+        },
+        [](Bytes& b) { editSlot(b, ASSET_PACK_ENTRY_USED, [&](AssetPackEntry& e) { e.offset = b.size() + 1; }); },
+        [](Bytes& b) { editSlot(b, ASSET_PACK_ENTRY_USED, [&](AssetPackEntry& e) { e.stored_size = b.size(); }); },
+        [](Bytes& b) { editSlot(b, ASSET_PACK_ENTRY_USED, [](AssetPackEntry& e) { e.size += 1; }); },
+        [](Bytes& b) { editSlot(b, ASSET_PACK_ENTRY_USED, [](AssetPackEntry& e) { e.path_offset = 0xFFFFFF; }); },
+        // An uncompressed size LZ4 could never produce must not size an allocation
+        [](Bytes& b) {
+            editSlot(b, ASSET_PACK_ENTRY_USED | ASSET_PACK_ENTRY_LZ4, [](AssetPackEntry& e) { e.size = e.stored_size * 255 + 1; });
+        },
+        [](Bytes& b) {
+            editSlot(b, ASSET_PACK_ENTRY_USED | ASSET_PACK_ENTRY_LZ4, [](AssetPackEntry& e) { e.size = UINT64_MAX / 2; });
+        },
+    };
+    for (const auto& damage : damages) {
+        const auto pack = openDamaged(directory.path, good, damage);
+        CHECK(!pack && pack.error() == AssetError::CorruptedAsset);
+    }
+}
+
+TEST(AssetPack, CorruptCompressedDataFailsToRead) {
+    TempDirectory directory;
+    const Bytes good = readFile(writePack(directory.path, makeEntries()));
+
+    // Entry headers stay intact, so the pack opens and only reading catches it
+    uint64_t data_offset = 0;
+    auto pack = openDamaged(directory.path, good, [&](Bytes& b) {
+        editSlot(b, ASSET_PACK_ENTRY_USED | ASSET_PACK_ENTRY_LZ4, [&](AssetPackEntry& e) { data_offset = e.offset; });
+        for (size_t i = 0; i < 64; ++i) b[data_offset + i] ^= std::byte{ 0x5A };
+        });
+    REQUIRE(pack.has_value());
+    for (const char* path : { "pattern.bin", "copy/pattern.bin" }) {
+        const auto bytes = (*pack)->read(path, true);
+        CHECK(!bytes && bytes.error() == AssetError::CorruptedAsset);
+    }
+}
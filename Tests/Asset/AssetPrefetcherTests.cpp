@@ -0,0 +1,224 @@
+#include "TestFramework.h"
+
+#include "Asset/AssetManager.h"
+#include "Asset/AssetPrefetcher.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    using namespace std::chrono_literals;
+
+    struct TestAsset {
+        std::string path;
+    };
+
+    // Twice the 1 MiB cache budget, so an asset nothing holds is evicted as soon as it is finalized
+    constexpr size_t ASSET_BYTES = 2 * 1024 * 1024;
+
+    // Counts imports and finalizations per path; "slow" paths wait for open()
+    class CountingLoader final : public AssetLoader<TestAsset> {
+    public:
+        std::expected<std::unique_ptr<TestAsset>, AssetError> load(AssetLoadContext& context) override {
+            const std::string& path = context.getPath();
+            if (path.starts_with("slow")) {
+                started_slow_ = true;
+                while (!open_) std::this_thread::sleep_for(1ms);
+            }
+            std::lock_guard lock(mutex_);
+            ++loads_[path];
+            return std::make_unique<TestAsset>(TestAsset{ path });
+        }
+
+        std::expected<void, AssetError> finalize(TestAsset& asset) override {
+            std::lock_guard lock(mutex_);
+            ++finalizes_[asset.path];
+            return {};
+        }
+
+        size_t getMemorySize(const TestAsset&) const override { return ASSET_BYTES; }
+
+        int loads(const std::string& path) {
+            std::lock_guard lock(mutex_);
+            return loads_[path];
+        }
+
+        int finalizes(const std::string& path) {
+            std::lock_guard lock(mutex_);
+            return finalizes_[path];
+        }
+
+        bool hasStartedSlow() const { return started_slow_; }
+        void open() { open_ = true; }
+
+    private:
+        std::mutex mutex_;
+        std::map<std::string, int> loads_;
+        std::map<std::string, int> finalizes_;
+        std::atomic<bool> started_slow_{ false };
+        std::atomic<bool> open_{ false };
+    };
+
+    constexpr uint32_t STONE = 1;
+    constexpr uint32_t GRASS = 2;
+    constexpr uint32_t SLOW = 3;
+    constexpr uint32_t COW = 7;
+
+    constexpr std::array<float, 3> ORIGIN{ 0.0f, 0.0f, 0.0f };
+
+    struct Fixture {
+        CountingLoader* loader = nullptr;
+        AssetManager assets;
+        AssetPrefetcher prefetcher;
+
+        explicit Fixture(bool async = false, const AssetPrefetchConfig& config = {}) : assets(makeConfig(async)), prefetcher(assets, config) {
+            auto counting = std::make_unique<CountingLoader>();
+            loader = counting.get();
+            assets.registerLoader<TestAsset>(std::move(counting));
+
+            prefetcher.addBlockAsset<TestAsset>(STONE, "stone.tex");
+            prefetcher.addBlockAsset<TestAsset>(GRASS, "grass.tex");
+            prefetcher.addBlockAsset<TestAsset>(SLOW, "slow.tex");
+            prefetcher.addEntityAsset<TestAsset>(COW, "cow.model");
+        }
+
+        static AssetConfig makeConfig(bool async) {
+            AssetConfig config;
+            config.asset_paths = {};
+            config.async_loading = async;
+            config.loader_threads = 1;
+            config.cache_size_mb = 1;
+            return config;
+        }
+
+        void prefetch(ChunkCoord chunk, std::span<const uint32_t> palette, std::span<const uint32_t> entities = {}) {
+            prefetcher.prefetchChunk({ chunk, palette, entities });
+        }
+    };
+}
+
+TEST(AssetPrefetcher, UnloadingChunkCancelsItsQueuedPrefetches) {
+    Fixture fixture;
+    const std::vector<uint32_t> near_palette{ STONE, GRASS, STONE };
+    const std::vector<uint32_t> cows{ COW };
+    const std::vector<uint32_t> grass{ GRASS };
+    fixture.prefetch({ 0, 0, 0 }, near_palette, cows);
+    fixture.prefetch({ 1, 0, 0 }, grass);
+    fixture.prefetcher.update(ORIGIN, ORIGIN);
+
+    const AssetPrefetchStats& stats = fixture.prefetcher.getStats();
+    CHECK(stats.issued_chunks == 2);
+    CHECK(stats.requests == 3);  // Grass is shared and requested once
+    CHECK(stats.held_assets == 3);
+
+    // Nothing has reached a loader yet (inline loading runs in update())
+    fixture.prefetcher.cancelChunk({ 0, 0, 0 });
+    CHECK(stats.chunks == 1);
+    CHECK(stats.cancelled == 2);
+    CHECK(stats.held_assets == 1);
+    CHECK(fixture.assets.getCacheStats().cancelled == 2);
+
+    fixture.assets.update();
+    CHECK(fixture.loader->loads("stone.tex") == 0);
+    CHECK(fixture.loader->loads("cow.model") == 0);
+    CHECK(fixture.loader->loads("grass.tex") == 1);
+
+    // The other chunk still wanted grass; completing it cancels nothing
+    fixture.prefetcher.completeChunk({ 1, 0, 0 });
+    CHECK(stats.cancelled == 2);
+    CHECK(stats.held_assets == 0);
+    CHECK(stats.issued_chunks == 0);
+}
+
+TEST(AssetPrefetcher, ChunksLeavingTheLikelySetGiveBackTheirLoads) {
+    AssetPrefetchConfig config;
+    config.max_chunks = 1;
+    Fixture fixture(false, config);
+    const std::vector<uint32_t> stone{ STONE };
+    const std::vector<uint32_t> grass{ GRASS };
+    fixture.prefetch({ 0, 0, 0 }, stone);
+    fixture.prefetch({ 10, 0, 0 }, grass);
+
+    fixture.prefetcher.update(ORIGIN, ORIGIN);
+    CHECK(fixture.prefetcher.getStats().requests == 1);
+
+    // Heading for the far chunk: it takes the only slot and the near one's load is dropped
+    fixture.prefetcher.update(ORIGIN, { 224.0f, 0.0f, 0.0f });
+    CHECK(fixture.prefetcher.getStats().requests == 2);
+    CHECK(fixture.prefetcher.getStats().cancelled == 1);
+    CHECK(fixture.prefetcher.getStats().issued_chunks == 1);
+
+    fixture.assets.update();
+    CHECK(fixture.loader->loads("stone.tex") == 0);
+    CHECK(fixture.loader->loads("grass.tex") == 1);
+}
+
+TEST(AssetPrefetcher, CancelledLoadNeverFinalizesOrPins) {
+    Fixture fixture;
+    const std::vector<uint32_t> stone{ STONE };
+    fixture.prefetch({ 0, 0, 0 }, stone);
+    fixture.prefetcher.update(ORIGIN, ORIGIN);
+    fixture.prefetcher.cancelChunk({ 0, 0, 0 });
+    for (int frame = 0; frame < 3; ++frame) fixture.assets.update();
+
+    CHECK(fixture.loader->loads("stone.tex") == 0);
+    CHECK(fixture.loader->finalizes("stone.tex") == 0);
+    CHECK(fixture.assets.getStats().queued == 0);
+    CHECK(fixture.assets.getStats().ready == 0);
+    CHECK(fixture.assets.getCacheStats().resident_bytes == 0);
+    CHECK(fixture.assets.getCacheStats().pinned_bytes == 0);
+
+    // The record was dropped, so a real request later loads it from scratch
+    const AssetHandle<TestAsset> handle = fixture.assets.load<TestAsset>("stone.tex");
+    fixture.assets.update();
+    CHECK(fixture.assets.getState(handle.id) == AssetState::Ready);
+    CHECK(fixture.loader->loads("stone.tex") == 1);
+    CHECK(fixture.loader->finalizes("stone.tex") == 1);
+    CHECK(fixture.assets.getCacheStats().misses == 2);
+}
+
+TEST(AssetPrefetcher, CancelLeavesOtherReferencesAlone) {
+    Fixture fixture;
+    const AssetHandle<TestAsset> held = fixture.assets.load<TestAsset>("stone.tex");
+    const std::vector<uint32_t> stone{ STONE };
+    fixture.prefetch({ 0, 0, 0 }, stone);
+    fixture.prefetcher.update(ORIGIN, ORIGIN);
+    fixture.prefetcher.cancelChunk({ 0, 0, 0 });
+    CHECK(fixture.prefetcher.getStats().cancelled == 0);
+
+    fixture.assets.update();
+    CHECK(fixture.assets.getState(held.id) == AssetState::Ready);
+    CHECK(fixture.loader->loads("stone.tex") == 1);
+}
+
+TEST(AssetPrefetcher, LoadAlreadyRunningFinishesUnheld) {
+    Fixture fixture(true);
+    const std::vector<uint32_t> slow{ SLOW };
+    fixture.prefetch({ 0, 0, 0 }, slow);
+    fixture.prefetcher.update(ORIGIN, ORIGIN);
+    while (!fixture.loader->hasStartedSlow()) std::this_thread::sleep_for(1ms);
+
+    // Too late to drop: the loader thread owns it
+    fixture.prefetcher.cancelChunk({ 0, 0, 0 });
+    CHECK(fixture.prefetcher.getStats().cancelled == 0);
+    fixture.loader->open();
+
+    // It lands in the cache with no reference or pin, so the budget takes it straight back
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (fixture.loader->finalizes("slow.tex") == 0 && std::chrono::steady_clock::now() < deadline) {
+        fixture.assets.update();
+        std::this_thread::sleep_for(1ms);
+    }
+    CHECK(fixture.loader->finalizes("slow.tex") == 1);
+    CHECK(fixture.assets.getCacheStats().evictions == 1);
+    CHECK(fixture.assets.getCacheStats().resident_bytes == 0);
+    CHECK(fixture.assets.getCacheStats().pinned_bytes == 0);
+}
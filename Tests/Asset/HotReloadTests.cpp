@@ -0,0 +1,130 @@
+#include "TestFramework.h"
+
+#include "Asset/AssetManager.h"
+#include "Asset/HotReload.h"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    using namespace std::chrono_literals;
+
+    constexpr std::chrono::milliseconds DEBOUNCE{ 150 };
+
+    struct TempDirectory {
+        std::filesystem::path path;
+
+        TempDirectory() {
+            path = std::filesystem::temp_directory_path() / "ashborn_hotreload_test";
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path / "textures");
+        }
+
+        ~TempDirectory() {
+            std::error_code error;
+            std::filesystem::remove_all(path, error);
+        }
+
+        // Closing after a write is what the watcher reports
+        void save(const std::string& relative, const std::string& contents) const {
+            std::ofstream(path / relative, std::ios::binary | std::ios::trunc) << contents;
+        }
+    };
+
+    struct TestAsset {
+        std::string path;
+    };
+
+    // Counts imports per path; materials depend on the texture of the same name
+    class CountingLoader final : public AssetLoader<TestAsset> {
+    public:
+        explicit CountingLoader(std::map<std::string, int>& loads) : loads_(loads) {}
+
+        std::expected<std::unique_ptr<TestAsset>, AssetError> load(AssetLoadContext& context) override {
+            const std::string& path = context.getPath();
+            ++loads_[path];
+            if (path.ends_with(".mat")) {
+                context.addDependency<TestAsset>("textures/" + path.substr(0, path.size() - 4) + ".tex");
+            }
+            return std::make_unique<TestAsset>(TestAsset{ path });
+        }
+
+    private:
+        std::map<std::string, int>& loads_;
+    };
+}
+
+TEST(HotReload, BurstOfWritesCoalescesIntoOneChange) {
+    TempDirectory directory;
+    const std::vector<std::filesystem::path> roots{ directory.path };
+    HotReloadWatcher watcher(roots, {}, DEBOUNCE);
+    if (!watcher.isActive()) return;  // No file notifications on this platform
+
+    // An exporter saving in three steps, 100 ms apart
+    const auto start = std::chrono::steady_clock::now();
+    directory.save("textures/stone.tex", "a");
+    CHECK(watcher.poll(start).empty());
+    directory.save("textures/stone.tex", "ab");
+    directory.save("textures/.stone.tex.swp", "x");  // Ignored
+    CHECK(watcher.poll(start + 100ms).empty());
+    directory.save("textures/stone.tex", "abc");
+    CHECK(watcher.poll(start + 200ms).empty());
+
+    // Quiet for less than the interval since the last write
+    CHECK(watcher.poll(start + 200ms + DEBOUNCE - 1ms).empty());
+
+    const HotReloadChanges changes = watcher.poll(start + 200ms + DEBOUNCE);
+    REQUIRE(changes.assets.size() == 1);
+    CHECK(changes.assets[0] == "textures/stone.tex");
+    CHECK(changes.shaders.empty());
+
+    // The burst was reported once
+    CHECK(watcher.poll(start + 10s).empty());
+}
+
+TEST(HotReload, ChangedAssetReloadsItsDependents) {
+    TempDirectory directory;
+    const std::vector<std::filesystem::path> roots{ directory.path };
+    HotReloadWatcher watcher(roots, {}, DEBOUNCE);
+    if (!watcher.isActive()) return;
+
+    AssetConfig config;
+    config.asset_paths = { directory.path };
+    config.async_loading = false;
+    AssetManager assets(config);
+    std::map<std::string, int> loads;
+    assets.registerLoader<TestAsset>(std::make_unique<CountingLoader>(loads));
+
+    const AssetHandle<TestAsset> material = assets.load<TestAsset>("stone.mat");
+    const AssetHandle<TestAsset> other = assets.load<TestAsset>("grass.mat");
+    assets.update();
+    REQUIRE(assets.getState(material.id) == AssetState::Ready);
+    REQUIRE(loads["textures/stone.tex"] == 1);
+
+    // What AshbornEngine::pollHotReload does each frame
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t scheduled = 0;
+    for (int step = 0; step < 6; ++step) {
+        const auto now = start + step * 50ms;
+        if (step < 3) directory.save("textures/stone.tex", std::string(step + 1, 'x'));
+        for (const std::string& path : watcher.poll(now).assets) scheduled += assets.reload(path);
+        assets.update();
+    }
+    for (const std::string& path : watcher.poll(start + 10s).assets) scheduled += assets.reload(path);
+    assets.update();
+
+    // One reload of the texture, and the material using it along with it
+    CHECK(scheduled == 2);
+    CHECK(loads["textures/stone.tex"] == 2);
+    CHECK(loads["stone.mat"] == 2);
+    CHECK(loads["grass.mat"] == 1);
+    CHECK(loads["textures/grass.tex"] == 1);
+    CHECK(assets.getStats().reloads_committed == 2);
+    CHECK(assets.getState(material.id) == AssetState::Ready);
+    CHECK(assets.getState(other.id) == AssetState::Ready);
+}
@@ -0,0 +1,47 @@
+-- Tests/Build-Tests.lua
+-- Engine unit tests: CPU-side behaviour only, no window or GPU needed
+
+project "Tests"
+    location( _SCRIPT_DIR )
+    targetdir "../Build/%{cfg.buildcfg}"
+    kind "ConsoleApp"
+    language "C++"
+    staticruntime "Off"
+
+    files {
+        "**.h",
+        "**.cpp",
+
+        -- Tool code under test; the tool's main.cpp stays out
+        "../Source/Tools/AssetCooker/AssetCooker.h",
+        "../Source/Tools/AssetCooker/AssetCooker.cpp"
+    }
+
+    includedirs {
+        ".",
+
+        -- Engine access
+        "../Source/Engine",
+        "../Source/Engine/Core",
+        "../Source/Engine/Renderer",
+        "../Source/Engine/World",
+        "../Source/Tools",
+
+        -- Dependencies
+        "%{IncludeDir.glm}",
+        "%{IncludeDir.glad}",
+        "%{IncludeDir.stb}"
+    }
+
+    links {
+        "Engine"
+    }
+
+    defines {
+        "ASHBORN_TESTS"
+    }
+
+    filter "system:linux"
+        links {
+            "pthread"
+        }
@@ -0,0 +1,138 @@
+#include "TestFramework.h"
+
+#include "IO/AsyncIo.h"
+#include "Jobs/JobSystem.h"
+#include "Platform/IoRing.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+using namespace AshCore;
+
+namespace {
+    // A fresh directory of small files whose contents name them
+    struct TempFiles {
+        std::filesystem::path directory;
+        std::vector<std::filesystem::path> paths;
+
+        explicit TempFiles(size_t count) {
+            directory = std::filesystem::temp_directory_path() / "ashborn_asyncio_test";
+            std::filesystem::remove_all(directory);
+            std::filesystem::create_directories(directory);
+            for (size_t i = 0; i < count; ++i) {
+                paths.push_back(directory / ("file" + std::to_string(i) + ".bin"));
+                std::ofstream(paths.back(), std::ios::binary) << contents(i);
+            }
+        }
+
+        ~TempFiles() {
+            std::error_code error;
+            std::filesystem::remove_all(directory, error);
+        }
+
+        static std::string contents(size_t i) { return "file " + std::to_string(i) + std::string(i % 7, '.'); }
+    };
+
+    bool matches(const FileReadResult& result, const std::string& expected) {
+        return result && result->size() == expected.size()
+            && std::equal(expected.begin(), expected.end(), result->begin(), [](char c, std::byte b) { return static_cast<std::byte>(c) == b; });
+    }
+
+    std::vector<FileReadResult> readAll(AsyncIo& io, const std::vector<std::filesystem::path>& paths) {
+        std::vector<FileReadRequest> requests;
+        for (const auto& path : paths) requests.push_back({ path });
+        return syncWait(io.readBatch(std::move(requests)));
+    }
+}
+
+TEST(AsyncIo, MissingFileIsPathNotFound) {
+    TempFiles files(1);
+    for (const bool use_io_uring : { true, false }) {
+        AsyncIo io(nullptr, { .use_io_uring = use_io_uring });
+        const auto results = readAll(io, { files.directory / "missing.bin", files.paths[0] });
+        REQUIRE(results.size() == 2);
+        CHECK(!results[0] && results[0].error() == AssetError::PathNotFound);
+        CHECK(matches(results[1], TempFiles::contents(0)));
+    }
+}
+
+TEST(AsyncIo, OffsetPastEndIsCorrupted) {
+    TempFiles files(1);
+    for (const bool use_io_uring : { true, false }) {
+        AsyncIo io(nullptr, { .use_io_uring = use_io_uring });
+        const FileReadResult past = syncWait(io.read({ files.paths[0], 1000 }));
+        CHECK(!past && past.error() == AssetError::CorruptedAsset);
+        const FileReadResult tail = syncWait(io.read({ files.paths[0], 5 }));
+        CHECK(matches(tail, TempFiles::contents(0).substr(5)));
+    }
+}
+
+TEST(AsyncIo, BatchLargerThanQueueDepth) {
+    TempFiles files(300);
+    JobSystem jobs(2, "Test");
+    for (const bool use_io_uring : { true, false }) {
+        AsyncIo io(&jobs, { .queue_depth = 4, .fallback_threads = 2, .use_io_uring = use_io_uring });
+        const auto results = readAll(io, files.paths);
+        REQUIRE(results.size() == files.paths.size());
+        for (size_t i = 0; i < results.size(); ++i) CHECK(matches(results[i], TempFiles::contents(i)));
+
+        const AsyncIoStats stats = io.getStats();
+        CHECK(stats.reads == files.paths.size());
+        CHECK(stats.queued == 0);
+        CHECK(stats.peak_in_flight <= (io.getBackend() == AsyncIoBackend::IoUring ? 4u : 2u));
+    }
+}
+
+#ifdef __linux__
+TEST(AsyncIo, BatchLargerThanDescriptorLimit) {
+    TempFiles files(200);
+    AsyncIo io(nullptr, { .queue_depth = 8 });
+    if (io.getBackend() != AsyncIoBackend::IoUring) return;  // The pool opens one file per thread
+
+    // Room for the reads in flight but not for every file of the batch
+    rlimit saved{};
+    REQUIRE(::getrlimit(RLIMIT_NOFILE, &saved) == 0);
+    size_t open_files = 0;
+    for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator("/proc/self/fd")) ++open_files;
+    rlimit limited = saved;
+    limited.rlim_cur = open_files + 32;
+    REQUIRE(::setrlimit(RLIMIT_NOFILE, &limited) == 0);
+
+    const auto results = readAll(io, files.paths);
+    ::setrlimit(RLIMIT_NOFILE, &saved);
+
+    REQUIRE(results.size() == files.paths.size());
+    for (size_t i = 0; i < results.size(); ++i) CHECK(matches(results[i], TempFiles::contents(i)));
+}
+#endif
+
+TEST(IoRing, EveryAcceptedWakeIsDelivered) {
+    const std::unique_ptr<IoRing> ring = IoRing::create(4);
+    if (!ring) return;  // No io_uring here
+
+    // Far more than the completion queue holds, with nothing reaping them;
+    // a wake the ring cannot take must say so instead of vanishing
+    uint32_t accepted = 0;
+    for (uint32_t i = 0; i < ring->getCapacity() * 8; ++i) accepted += ring->wake() ? 1 : 0;
+    CHECK(accepted > 0);
+
+    uint32_t delivered = 0;
+    std::vector<IoRing::Completion> completions;
+    while (delivered < accepted) {
+        completions.clear();
+        ring->wait(completions);
+        for (const IoRing::Completion& completion : completions) {
+            CHECK(completion.user_data == 0);
+            ++delivered;
+        }
+    }
+    CHECK(delivered == accepted);
+    CHECK(ring->wake());
+}
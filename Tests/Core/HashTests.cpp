@@ -0,0 +1,70 @@
+#include "TestFramework.h"
+
+#include "Hash/Hash.h"
+
+#include <array>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    constexpr uint64_t SEED = 0x9E3779B185EBCA8Dull;
+
+    struct KnownAnswer {
+        size_t length;
+        uint64_t hash64;
+        Hash128 hash128;
+    };
+
+    // From xxHash 0.8's XXH3_64bits_withSeed and XXH3_128bits_withSeed over
+    // input(), covering both ends of every length class. Inputs over 240
+    // bytes take the stripe loop, AVX2 in Release and scalar in Debug, so
+    // both configurations must pass; 4103 bytes spans four 1 KiB blocks.
+    constexpr std::array<KnownAnswer, 20> KNOWN_ANSWERS{ {
+        { 0, 0xA8A6B918B2F0364Aull, { 0xA986DFC5D7605BFEull, 0x00FEAA732A3CE25Eull } },
+        { 1, 0x2A78BB5976584331ull, { 0x2A78BB5976584331ull, 0xE48033618F77941Cull } },
+        { 2, 0x5491A1A895B760C2ull, { 0x5491A1A895B760C2ull, 0x447B2517593472A3ull } },
+        { 3, 0xCD0D4D14286F82CAull, { 0xCD0D4D14286F82CAull, 0x474374B8298D51D5ull } },
+        { 4, 0xEB16000CE9016AB7ull, { 0x0675DB0776826FA6ull, 0xFCC53BAE10FD8454ull } },
+        { 5, 0x85AA73545B992FBEull, { 0x4ACD9E4D92CED13Aull, 0x046E4F511FA137C4ull } },
+        { 8, 0x6306063894134414ull, { 0x888322FD8E2E8FEDull, 0x81262058D5871B78ull } },
+        { 9, 0xD372377736C99CB1ull, { 0x15EC32EDCF635251ull, 0x8D8D1E5F090B05A6ull } },
+        { 12, 0x146C452AB1DEA2F2ull, { 0x9F44882286FE26B5ull, 0xA46562BC10396CB1ull } },
+        { 16, 0x1CA868756D53C923ull, { 0x2707E563337A29AAull, 0x0D3B102F9FED3D2Full } },
+        { 17, 0x0BBC5F022418BAE8ull, { 0xCFF10F4BFF7A4768ull, 0xB214EBC520560F53ull } },
+        { 64, 0xD950F6B7E4E2E28Full, { 0x70AAA89B54BAF50Dull, 0xE6605ADFD4C08875ull } },
+        { 128, 0x11654AECE48E405Aull, { 0x8DF5EE611A3F6A90ull, 0x28BFD127D3CF3F4Aull } },
+        { 129, 0xE55152A9B8CB8966ull, { 0x60E675AAED0355EBull, 0x0165BF48BC15EACFull } },
+        { 200, 0xACA665F6FE9609C9ull, { 0x93DEC22D54F2E9BBull, 0x0A8DDA68B2FEA970ull } },
+        { 240, 0xA37D8CA0436A3623ull, { 0xB16477BA94D2D999ull, 0xC6B01107D8DFD55Cull } },
+        { 241, 0x2B7A84E86217424Eull, { 0x2B7A84E86217424Eull, 0x1534A526CAA2FD24ull } },
+        { 1000, 0xDECE0BFA455E0A37ull, { 0xDECE0BFA455E0A37ull, 0xADF4C46469E373E8ull } },
+        { 1024, 0xA0484E2ED2B185C8ull, { 0xA0484E2ED2B185C8ull, 0x9CC2D3D59A91ECA7ull } },
+        { 4103, 0xEF6F78EC17970098ull, { 0xEF6F78EC17970098ull, 0xC9C8A9C9770CA104ull } },
+    } };
+
+    // Without a seed, long inputs skip deriving a secret
+    constexpr KnownAnswer UNSEEDED_LONG{ 4103, 0x1617C1D290912C33ull, { 0x1617C1D290912C33ull, 0x8FEAC1342278B034ull } };
+
+    std::vector<std::byte> input() {
+        std::vector<std::byte> bytes(5000);
+        for (size_t i = 0; i < bytes.size(); ++i) bytes[i] = static_cast<std::byte>(i * 167 + 13);
+        return bytes;
+    }
+}
+
+TEST(Hash, MatchesXxh3AtEveryLengthBoundary) {
+    const std::vector<std::byte> bytes = input();
+    for (const KnownAnswer& answer : KNOWN_ANSWERS) {
+        const std::span<const std::byte> data(bytes.data(), answer.length);
+        CHECK(hash64(data, SEED) == answer.hash64);
+        CHECK(hash128(data, SEED) == answer.hash128);
+    }
+}
+
+TEST(Hash, UnseededLongInputUsesTheDefaultSecret) {
+    const std::vector<std::byte> bytes = input();
+    const std::span<const std::byte> data(bytes.data(), 4103);
+    CHECK(hash64(data) == UNSEEDED_LONG.hash64);
+    CHECK(hash128(data) == UNSEEDED_LONG.hash128);
+}
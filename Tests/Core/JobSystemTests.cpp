@@ -0,0 +1,145 @@
+#include "TestFramework.h"
+
+#include "Jobs/JobSystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace AshCore;
+
+TEST(JobSystem, ParallelForCoversEveryIndexOnce) {
+    JobSystem jobs(3, "Test");
+    std::vector<std::atomic<int>> hits(1000);
+    jobs.parallelFor(hits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) hits[i].fetch_add(1);
+    });
+    for (const auto& hit : hits) CHECK(hit.load() == 1);
+}
+
+TEST(JobSystem, WaitDrainsCounter) {
+    JobSystem jobs(2, "Test");
+    JobCounter counter;
+    std::atomic<int> ran{ 0 };
+    for (int i = 0; i < 100; ++i) {
+        jobs.submit(counter, [&]() { ran.fetch_add(1); });
+    }
+    jobs.wait(counter);
+    CHECK(counter.isDone());
+    CHECK(ran.load() == 100);
+}
+
+TEST(JobSystem, ThreadIndicesStayInRange) {
+    JobSystem jobs(3, "Test");
+    CHECK(jobs.getThreadCount() == 4);
+    CHECK(jobs.getThreadIndex() == 0);
+    CHECK(jobs.ownsThreadSlot());
+
+    std::atomic<bool> in_range{ true };
+    jobs.parallelFor(256, 1, [&](size_t, size_t) {
+        if (jobs.getThreadIndex() >= jobs.getThreadCount()) in_range = false;
+    });
+    CHECK(in_range.load());
+}
+
+TEST(JobSystem, ForeignThreadNeverRunsJobsInSlotZero) {
+    JobSystem jobs(2, "Test");
+
+    // Slot 0 is the creating thread's; a helper thread must leave batches to the workers
+    std::atomic<int> foreign_batches{ 0 };
+    std::atomic<int> batches{ 0 };
+    std::thread helper([&]() {
+        const std::thread::id helper_id = std::this_thread::get_id();
+        CHECK(!jobs.ownsThreadSlot());
+        CHECK(!jobs.tryRunOne());
+        jobs.parallelFor(64, 1, [&](size_t, size_t) {
+            batches.fetch_add(1);
+            if (std::this_thread::get_id() == helper_id) foreign_batches.fetch_add(1);
+        });
+    });
+    helper.join();
+
+    CHECK(batches.load() == 64);
+    CHECK(foreign_batches.load() == 0);
+}
+
+TEST(JobSystem, ParallelForWaitsForBatchesBeforeRethrowing) {
+    JobSystem jobs(2, "Test");
+    std::atomic<int> finished{ 0 };
+    bool thrown = false;
+    try {
+        jobs.parallelFor(16, 1, [&](size_t begin, size_t) {
+            if (begin == 0) throw std::runtime_error("first batch");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            finished.fetch_add(1);
+        });
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+        // Every queued batch ran before control came back here
+        CHECK(finished.load() == 15);
+    }
+    CHECK(thrown);
+}
+
+TEST(JobSystem, ParallelForRethrowsQueuedBatchException) {
+    JobSystem jobs(2, "Test");
+    std::atomic<int> ran{ 0 };
+    bool thrown = false;
+    try {
+        jobs.parallelFor(64, 1, [&](size_t begin, size_t) {
+            ran.fetch_add(1);
+            if (begin == 37) throw std::runtime_error("queued batch");
+        });
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(ran.load() == 64);
+}
+
+TEST(JobSystem, WaitRethrowsFirstExceptionOnce) {
+    JobSystem jobs(2, "Test");
+    JobCounter counter;
+    for (int i = 0; i < 8; ++i) {
+        jobs.submit(counter, []() { throw std::runtime_error("job"); });
+    }
+
+    bool thrown = false;
+    try {
+        jobs.wait(counter);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+    CHECK(counter.isDone());
+
+    // Cleared by the rethrow, so the counter can be reused
+    jobs.submit(counter, []() {});
+    jobs.wait(counter);
+    CHECK(counter.isDone());
+}
+
+TEST(JobSystem, ForeignThreadWaitWakesWhenCounterDrains) {
+    JobSystem jobs(1, "Test");
+    JobCounter counter;
+    std::atomic<bool> release{ false };
+    jobs.submit(counter, [&]() {
+        while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+
+    std::atomic<bool> woke{ false };
+    std::thread waiter([&]() {
+        jobs.wait(counter);
+        woke = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(!woke.load());
+    release = true;
+    waiter.join();
+    CHECK(woke.load());
+}
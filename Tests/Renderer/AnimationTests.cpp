@@ -0,0 +1,196 @@
+#include "TestFramework.h"
+
+#include "Animation/AnimationClip.h"
+#include "Animation/AnimationSystem.h"
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    using Quat = std::array<float, 4>;
+
+    Quat normalized(Quat q) {
+        const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        for (float& component : q) component /= length;
+        return q;
+    }
+
+    float dot(const Quat& a, const Quat& b) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+    }
+
+    // Row-major 3x3 rotation of a unit quaternion; q and -q give the same matrix
+    std::array<float, 9> rotationMatrix(const Quat& q) {
+        const float x = q[0], y = q[1], z = q[2], w = q[3];
+        return {
+            1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y),
+            2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x),
+            2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y),
+        };
+    }
+
+    // The 3x3 part of bone's palette matrix
+    std::array<float, 9> paletteRotation(const AnimationSystem& animation, uint32_t instance, uint32_t bone) {
+        const float* m = animation.getPaletteData().data() + (animation.getPaletteOffset(instance) + bone) * AnimationSystem::FLOATS_PER_BONE;
+        return { m[0], m[1], m[2], m[4], m[5], m[6], m[8], m[9], m[10] };
+    }
+
+    float maxDifference(const std::array<float, 9>& a, const std::array<float, 9>& b) {
+        float difference = 0.0f;
+        for (size_t i = 0; i < a.size(); ++i) difference = std::max(difference, std::abs(a[i] - b[i]));
+        return difference;
+    }
+
+    RawAnimationClip randomClip(uint32_t bones, uint32_t frames, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<float> gaussian;
+        std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+
+        RawAnimationClip raw;
+        raw.bone_count = bones;
+        raw.frame_count = frames;
+        raw.keys.resize(size_t{ bones } * frames);
+        for (BoneTransform& key : raw.keys) {
+            key.rotation = normalized({ gaussian(rng), gaussian(rng), gaussian(rng), gaussian(rng) });
+            key.translation = { offset(rng), offset(rng), offset(rng) };
+        }
+        return raw;
+    }
+
+    // Every bone a child of the previous one, with a non-trivial inverse bind
+    Skeleton chainSkeleton(uint32_t bones) {
+        Skeleton skeleton;
+        for (uint32_t bone = 0; bone < bones; ++bone) {
+            skeleton.parents.push_back(static_cast<int32_t>(bone) - 1);
+            skeleton.inverse_bind.push_back({ 1, 0, 0, -0.1f * bone, 0, 1, 0, 0.05f * bone, 0, 0, 1, 0.2f });
+        }
+        return skeleton;
+    }
+
+    // One bone whose frames are the given rotations
+    AnimationClip rotationClip(std::initializer_list<Quat> rotations) {
+        RawAnimationClip raw;
+        raw.bone_count = 1;
+        for (const Quat& rotation : rotations) {
+            BoneTransform key;
+            key.rotation = rotation;
+            raw.keys.push_back(key);
+        }
+        raw.frame_count = static_cast<uint32_t>(raw.keys.size());
+        return *AnimationClip::compress(raw);
+    }
+
+    // Same rotation (almost), opposite 4D hemispheres after smallest-three keeps the largest positive
+    const Quat FIRST = normalized({ 0.70f, -0.69f, 0.10f, 0.10f });
+    const Quat SECOND = normalized({ -0.69f, 0.70f, -0.10f, -0.10f });
+}
+
+TEST(AnimationClip, RandomRotationsSurviveQuantization) {
+    const RawAnimationClip raw = randomClip(13, 6, 89);
+    const auto clip = AnimationClip::compress(raw);
+    REQUIRE(clip.has_value());
+    REQUIRE(clip->getPaddedBoneCount() == 16);
+
+    float worst_rotation = 0.0f;
+    float worst_translation = 0.0f;
+    for (uint32_t frame = 0; frame < raw.frame_count; ++frame) {
+        for (uint32_t bone = 0; bone < raw.bone_count; ++bone) {
+            const BoneTransform& source = raw.keys[size_t{ frame } * raw.bone_count + bone];
+            const BoneTransform decoded = clip->decodeKey(frame, bone);
+
+            // The dropped component comes back positive, so compare up to sign
+            const float sign = dot(source.rotation, decoded.rotation) < 0.0f ? -1.0f : 1.0f;
+            for (size_t i = 0; i < 4; ++i) {
+                worst_rotation = std::max(worst_rotation, std::abs(source.rotation[i] - sign * decoded.rotation[i]));
+            }
+            for (size_t axis = 0; axis < 3; ++axis) {
+                worst_translation = std::max(worst_translation, std::abs(source.translation[axis] - decoded.translation[axis]));
+            }
+        }
+    }
+    // Half a 16-bit step is ~1.1e-5 per stored component; the rebuilt one adds a little
+    CHECK(worst_rotation < 1e-4f);
+    CHECK(worst_translation < 4.0f / 65535.0f);
+}
+
+TEST(AnimationClip, PaddingLanesDecodeToIdentity) {
+    const auto clip = AnimationClip::compress(randomClip(5, 3, 7));
+    REQUIRE(clip.has_value());
+    for (uint32_t frame = 0; frame < clip->getFrameCount(); ++frame) {
+        for (uint32_t bone = clip->getBoneCount(); bone < clip->getPaddedBoneCount(); ++bone) {
+            const BoneTransform key = clip->decodeKey(frame, bone);
+            CHECK(std::abs(key.rotation[0]) < 1e-4f);
+            CHECK(std::abs(key.rotation[1]) < 1e-4f);
+            CHECK(std::abs(key.rotation[2]) < 1e-4f);
+            CHECK(std::abs(key.rotation[3] - 1.0f) < 1e-4f);
+            CHECK(key.translation == (std::array<float, 3>{ 0.0f, 0.0f, 0.0f }));
+        }
+    }
+}
+
+TEST(AnimationSystem, SimdPaletteMatchesScalar) {
+    // Without AVX2 compiled in both systems take the scalar path
+    constexpr uint32_t BONES = 11;
+    std::array<std::vector<float>, 2> palettes;
+    for (const bool simd : { false, true }) {
+        AnimationSystem animation({ .use_simd = simd });
+        const auto skeleton = animation.addSkeleton(chainSkeleton(BONES));
+        REQUIRE(skeleton.has_value());
+        const uint32_t walk = animation.addClip(*AnimationClip::compress(randomClip(BONES, 8, 1)));
+        const uint32_t wave = animation.addClip(*AnimationClip::compress(randomClip(BONES, 5, 2)));
+        const auto instance = animation.createInstance(*skeleton);
+        REQUIRE(instance.has_value());
+
+        const AnimationLayer layers[] = {
+            { .clip = walk, .time = 0.07f, .weight = 0.7f },
+            { .clip = wave, .time = 0.11f, .weight = 0.3f },
+        };
+        REQUIRE(animation.setLayers(*instance, layers));
+        animation.update(0.013f, { 0.0f, 0.0f, 0.0f }, nullptr);
+        palettes[simd].assign(animation.getPaletteData().begin(), animation.getPaletteData().end());
+    }
+
+    REQUIRE(palettes[0].size() == palettes[1].size());
+    float worst = 0.0f;
+    for (size_t i = 0; i < palettes[0].size(); ++i) worst = std::max(worst, std::abs(palettes[0][i] - palettes[1][i]));
+    CHECK(worst < 1e-4f);
+}
+
+TEST(AnimationSystem, BlendsTakeTheShortArc) {
+    REQUIRE(dot(FIRST, SECOND) < -0.9f);
+    const Quat halfway = normalized({ FIRST[0] - SECOND[0], FIRST[1] - SECOND[1], FIRST[2] - SECOND[2], FIRST[3] - SECOND[3] });
+    const std::array<float, 9> expected = rotationMatrix(halfway);
+
+    Skeleton skeleton;
+    skeleton.parents = { -1 };
+    skeleton.inverse_bind = { { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0 } };
+
+    for (const bool simd : { false, true }) {
+        AnimationSystem animation({ .use_simd = simd });
+        const uint32_t bone_skeleton = *animation.addSkeleton(skeleton);
+        const uint32_t first = animation.addClip(rotationClip({ FIRST, FIRST }));
+        const uint32_t second = animation.addClip(rotationClip({ SECOND, SECOND }));
+        const uint32_t both = animation.addClip(rotationClip({ FIRST, SECOND }));
+
+        // Two layers half and half
+        const uint32_t layered = *animation.createInstance(bone_skeleton);
+        const AnimationLayer layers[] = {
+            { .clip = first, .weight = 0.5f, .loop = false },
+            { .clip = second, .weight = 0.5f, .loop = false },
+        };
+        REQUIRE(animation.setLayers(layered, layers));
+
+        // Halfway between two frames of one clip
+        const uint32_t sampled = *animation.createInstance(bone_skeleton);
+        const AnimationLayer between[] = { { .clip = both, .time = 0.5f / 30.0f, .loop = false } };
+        REQUIRE(animation.setLayers(sampled, between));
+
+        animation.update(0.0f, { 0.0f, 0.0f, 0.0f }, nullptr);
+        CHECK(maxDifference(paletteRotation(animation, layered, 0), expected) < 2e-3f);
+        CHECK(maxDifference(paletteRotation(animation, sampled, 0), expected) < 2e-3f);
+    }
+}
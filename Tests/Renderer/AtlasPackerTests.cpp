@@ -0,0 +1,72 @@
+#include "TestFramework.h"
+
+#include "Texture/AtlasPacker.h"
+#include "Texture/MipGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace AshCore;
+
+TEST(AtlasPacker, MipLimitFollowsPadding) {
+    AtlasPackSettings settings;
+    MipSettings mips;
+    mips.filter = MipFilter::Box;
+    CHECK(getAtlasMipLimit(settings, mips) == 3);
+
+    mips.filter = MipFilter::Kaiser;
+    CHECK(getAtlasMipLimit(settings, mips) == 1);
+
+    settings.padding = 0;
+    mips.filter = MipFilter::Box;
+    CHECK(getAtlasMipLimit(settings, mips) == 1);
+}
+
+TEST(AtlasPacker, ClampedMipsDoNotBleed) {
+    constexpr std::array<std::array<uint32_t, 2>, 6> sizes{ { {13, 7}, {5, 21}, {30, 30}, {9, 9}, {1, 17}, {26, 3} } };
+
+    std::vector<std::vector<std::byte>> pixels;
+    std::vector<AtlasImage> images;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        const auto [width, height] = sizes[i];
+        std::vector<std::byte>& rgba = pixels.emplace_back(size_t{ width } * height * 4);
+        for (size_t t = 0; t < rgba.size(); t += 4) {
+            rgba[t + 0] = static_cast<std::byte>(40 * (i + 1));
+            rgba[t + 1] = static_cast<std::byte>(255 - 30 * i);
+            rgba[t + 2] = static_cast<std::byte>(i * 17);
+            rgba[t + 3] = std::byte{ 255 };
+        }
+    }
+    for (size_t i = 0; i < sizes.size(); ++i) images.push_back({ pixels[i], sizes[i][0], sizes[i][1] });
+
+    AtlasPackSettings settings;
+    const auto layout = packAtlas(images, settings);
+    REQUIRE(layout.has_value());
+    REQUIRE(layout->page_count == 1);
+    const std::vector<std::byte> page = composeAtlas(*layout, images, settings.padding, nullptr);
+
+    MipSettings mip_settings;
+    mip_settings.filter = MipFilter::Box;
+    mip_settings.max_mips = getAtlasMipLimit(settings, mip_settings);
+    MipGenerator generator(mip_settings);
+    const auto chain = generator.generate(page, layout->width, layout->height, nullptr);
+    REQUIRE(chain.has_value());
+    REQUIRE(chain->size() == mip_settings.max_mips);
+
+    // Every texel that samples a region's content must be that region's colour
+    for (uint32_t mip = 0; mip < chain->size(); ++mip) {
+        const uint32_t scale = 1u << mip;
+        const uint32_t width = std::max(layout->width >> mip, 1u);
+        const std::vector<std::byte>& level = (*chain)[mip];
+        for (size_t i = 0; i < images.size(); ++i) {
+            const AtlasPlacement& placement = layout->placements[i];
+            for (uint32_t y = placement.y / scale; y * scale < placement.y + placement.height; ++y) {
+                for (uint32_t x = placement.x / scale; x * scale < placement.x + placement.width; ++x) {
+                    const size_t texel = (size_t{ y } * width + x) * 4;
+                    for (size_t c = 0; c < 4; ++c) CHECK(level[texel + c] == pixels[i][c]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "TestFramework.h"
+
+#include "Bindless/BindlessTable.h"
+#include "Bindless/NullBindlessBackend.h"
+
+#include <thread>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    BindlessConfig smallConfig() {
+        BindlessConfig config;
+        config.capacities = { 8, 4, 4, 2 };
+        return config;
+    }
+}
+
+TEST(BindlessHandle, PacksTypeGenerationAndIndex) {
+    const BindlessHandle handle = BindlessHandle::make(BindlessType::StorageBuffer, 3, 12345);
+    CHECK(handle.getType() == BindlessType::StorageBuffer);
+    CHECK(handle.getGeneration() == 3);
+    CHECK(handle.getIndex() == 12345);
+    CHECK(handle.isValid());
+    CHECK(!BindlessHandle{}.isValid());
+}
+
+TEST(BindlessTable, FillsDenselyFromIndexOne) {
+    NullBindlessBackend backend;
+    BindlessTable table(backend, smallConfig());
+    REQUIRE(table.initialize().has_value());
+
+    std::vector<BindlessHandle> handles;
+    for (uint64_t i = 0; i < 7; ++i) {
+        const auto handle = table.registerImage(GpuImageHandle{ 100 + i });
+        REQUIRE(handle.has_value());
+        handles.push_back(*handle);
+    }
+    CHECK(handles.front().getIndex() == 1);
+    CHECK(handles.back().getIndex() == 7);
+    CHECK(!table.registerImage(GpuImageHandle{ 5 }).has_value());
+    CHECK(table.getStats().allocation_failures == 1);
+
+    // Slots 1..7 land in one contiguous write
+    table.flush();
+    CHECK(table.getStats().runs_last_flush == 1);
+    CHECK(table.getStats().writes_last_flush == 7);
+    CHECK(backend.getDescriptor(BindlessType::SampledImage, 3).image.value == 102);
+}
+
+TEST(BindlessTable, ReleasedSlotsWaitForTheirFrame) {
+    NullBindlessBackend backend;
+    BindlessTable table(backend, smallConfig());
+    REQUIRE(table.initialize().has_value());
+    BindlessResource fallback;
+    fallback.image = GpuImageHandle{ 999 };
+    table.setFallback(BindlessType::SampledImage, fallback);
+
+    std::vector<BindlessHandle> handles;
+    for (uint64_t i = 0; i < 7; ++i) handles.push_back(*table.registerImage(GpuImageHandle{ 100 + i }));
+    table.flush();
+
+    table.release(handles[2], 5);
+    CHECK(!table.isAlive(handles[2]));
+    table.collect(4);
+    CHECK(!table.registerImage(GpuImageHandle{ 5 }).has_value());
+
+    table.collect(5);
+    const auto reused = table.registerImage(GpuImageHandle{ 555 });
+    REQUIRE(reused.has_value());
+    CHECK(reused->getIndex() == 3);
+    CHECK(reused->getGeneration() == 1);
+    CHECK(!table.isAlive(handles[2]));
+    CHECK(table.isAlive(*reused));
+
+    table.flush();
+    CHECK(backend.getDescriptor(BindlessType::SampledImage, 3).image.value == 555);
+}
+
+TEST(BindlessTable, StaleAndMistypedHandlesAreRejected) {
+    NullBindlessBackend backend;
+    BindlessTable table(backend, smallConfig());
+    REQUIRE(table.initialize().has_value());
+
+    const auto image = table.registerImage(GpuImageHandle{ 1 });
+    REQUIRE(image.has_value());
+    table.release(*image, 1);
+    table.release(*image, 1);
+    CHECK(table.getStats().stale_handle_errors == 1);
+
+    const auto buffer = table.registerBuffer(GpuBufferHandle{ 7 }, 64, 128);
+    REQUIRE(buffer.has_value());
+    CHECK(buffer->getType() == BindlessType::StorageBuffer);
+    CHECK(!table.isAlive(BindlessHandle::make(BindlessType::Sampler, 0, buffer->getIndex())));
+
+    table.flush();
+    CHECK(backend.getDescriptor(BindlessType::StorageBuffer, buffer->getIndex()).offset == 64);
+}
+
+TEST(BindlessTable, RegistersFromSeveralThreads) {
+    NullBindlessBackend backend;
+    BindlessConfig config;
+    config.capacities = { 1024, 4, 4, 2 };
+    BindlessTable table(backend, config);
+    REQUIRE(table.initialize().has_value());
+
+    std::vector<std::vector<BindlessHandle>> handles(4);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint64_t i = 0; i < 200; ++i) {
+                if (auto handle = table.registerImage(GpuImageHandle{ t * 1000 + i + 1 })) handles[t].push_back(*handle);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    std::vector<uint8_t> seen(1024, 0);
+    for (const auto& list : handles) {
+        CHECK(list.size() == 200);
+        for (BindlessHandle handle : list) {
+            CHECK(seen[handle.getIndex()] == 0);
+            seen[handle.getIndex()] = 1;
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#include "TestFramework.h"
+
+#include "Lighting/CascadedShadows.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace AshCore;
+
+namespace {
+    // Straight down: light right is world -X, light up is world +Z
+    constexpr std::array<float, 3> SUN{ 0.0f, -1.0f, 0.0f };
+
+    // Looking down -Z from position
+    ClusterCamera cameraAt(float x, float y, float z) {
+        ClusterCamera camera;
+        camera.view[12] = -x;
+        camera.view[13] = -y;
+        camera.view[14] = -z;
+        return camera;
+    }
+
+    std::array<float, 3> sunTiltedBy(float degrees) {
+        const float radians = degrees * 3.14159265f / 180.0f;
+        return { std::sin(radians), -std::cos(radians), 0.0f };
+    }
+
+    // Half extent of a cascade's light box
+    float boxRadius(const CascadedShadowMaps& shadows, uint32_t cascade) {
+        return shadows.getCascades()[cascade].texel_size * static_cast<float>(shadows.getConfig().resolution) * 0.5f;
+    }
+
+    // Whether a world point lands inside a cascade's light box
+    bool insideCascade(const ShadowCascade& cascade, const std::array<float, 3>& point) {
+        const auto& m = cascade.view_projection;
+        std::array<float, 3> clip{};
+        for (size_t row = 0; row < 3; ++row) {
+            clip[row] = m[row] * point[0] + m[4 + row] * point[1] + m[8 + row] * point[2] + m[12 + row];
+        }
+        return std::abs(clip[0]) <= 1.0f && std::abs(clip[1]) <= 1.0f && clip[2] >= 0.0f && clip[2] <= 1.0f;
+    }
+}
+
+TEST(CascadedShadows, SubTexelMovesKeepTheSnappedMatrix) {
+    CascadedShadowMaps shadows;
+    ShadowCasterTable casters;
+    shadows.update(cameraAt(0.0f, 0.0f, 0.0f), SUN, casters, nullptr);
+    const uint32_t count = static_cast<uint32_t>(shadows.getCascades().size());
+    std::array<std::array<float, 16>, MAX_SHADOW_CASCADES> before{};
+    for (uint32_t i = 0; i < count; ++i) before[i] = shadows.getCascades()[i].view_projection;
+
+    // Cascade 0 has the finest texels, so this is under a texel for all of them
+    const float texel = shadows.getCascades()[0].texel_size;
+    for (const float step : { 0.3f, -0.3f, 0.45f }) {
+        shadows.update(cameraAt(step * texel, 0.0f, 0.0f), SUN, casters, nullptr);
+        for (uint32_t i = 0; i < count; ++i) CHECK(shadows.getCascades()[i].view_projection == before[i]);
+    }
+
+    // Larger moves shift the refitted cascades by whole texels
+    shadows.update(cameraAt(10.3f * texel, 0.0f, 0.0f), SUN, casters, nullptr);
+    CHECK(shadows.getCascades()[0].view_projection != before[0]);
+    for (uint32_t i = 0; i < shadows.getConfig().first_cached_cascade; ++i) {
+        const ShadowCascade& cascade = shadows.getCascades()[i];
+        const float texels = cascade.view_projection[12] * boxRadius(shadows, i) / cascade.texel_size;
+        CHECK(std::abs(texels - std::round(texels)) < 1e-3f);
+    }
+}
+
+TEST(CascadedShadows, SunChangeInvalidatesCachedCascades) {
+    CascadedShadowMaps shadows;
+    ShadowCasterTable casters;
+    const ClusterCamera camera = cameraAt(0.0f, 0.0f, 0.0f);
+    const uint32_t cached = shadows.getConfig().cascade_count - shadows.getConfig().first_cached_cascade;
+    REQUIRE(cached == 2);
+
+    shadows.update(camera, SUN, casters, nullptr);
+    CHECK(shadows.getStats().cascades_rendered == 4);
+    shadows.update(camera, SUN, casters, nullptr);
+    CHECK(shadows.getStats().cascades_reused == cached);
+
+    // Under the threshold the cached layers keep the old sun
+    shadows.update(camera, sunTiltedBy(0.2f), casters, nullptr);
+    CHECK(shadows.getStats().invalidated_by_sun == 0);
+    CHECK(shadows.getStats().cascades_reused == cached);
+    CHECK(shadows.getCascades()[3].sun_direction == SUN);
+
+    shadows.update(camera, sunTiltedBy(1.0f), casters, nullptr);
+    CHECK(shadows.getStats().invalidated_by_sun == cached);
+    CHECK(shadows.getStats().cascades_rendered == 4);
+    CHECK(shadows.getCascades()[3].sun_direction != SUN);
+}
+
+TEST(CascadedShadows, LeavingTheMarginInvalidatesOnlyThatCascade) {
+    CascadedShadowMaps shadows;
+    ShadowCasterTable casters;
+    shadows.update(cameraAt(0.0f, 0.0f, 0.0f), SUN, casters, nullptr);
+
+    // The margin is cache_margin of the fitted radius, less up to half a texel of snapping
+    const float margin = shadows.getConfig().cache_margin / (1.0f + shadows.getConfig().cache_margin);
+    const float slack2 = boxRadius(shadows, 2) * margin;
+    const float slack3 = boxRadius(shadows, 3) * margin;
+    REQUIRE(slack3 > slack2 * 1.5f);
+
+    shadows.update(cameraAt(slack2 * 0.5f, 0.0f, 0.0f), SUN, casters, nullptr);
+    CHECK(shadows.getStats().invalidated_by_camera == 0);
+    CHECK(shadows.getStats().cascades_reused == 2);
+
+    shadows.update(cameraAt((slack2 + slack3) * 0.5f, 0.0f, 0.0f), SUN, casters, nullptr);
+    CHECK(shadows.getStats().invalidated_by_camera == 1);
+    CHECK(shadows.getCascades()[2].render);
+    CHECK(!shadows.getCascades()[3].render);
+
+    shadows.update(cameraAt(slack3 * 3.0f, 0.0f, 0.0f), SUN, casters, nullptr);
+    CHECK(shadows.getStats().invalidated_by_camera == 2);
+}
+
+TEST(CascadedShadows, FarSectionChangeRedrawsOnlyTheFarCascade) {
+    CascadedShadowMaps shadows;
+    ShadowCasterTable casters;
+    const ClusterCamera camera = cameraAt(0.0f, 0.0f, 0.0f);
+    casters.setSection(0, { -1.0f, -1.0f, -6.0f }, { 1.0f, 1.0f, -4.0f });
+    shadows.update(camera, SUN, casters, nullptr);
+    shadows.update(camera, SUN, casters, nullptr);
+    REQUIRE(shadows.getStats().cascades_reused == 2);
+
+    // Only the last cascade's light box reaches this far
+    const std::array<float, 3> far_point{ 0.0f, 0.0f, -230.0f };
+    REQUIRE(!insideCascade(shadows.getCascades()[2], far_point));
+    REQUIRE(insideCascade(shadows.getCascades()[3], far_point));
+
+    casters.setSection(5, { -2.0f, -2.0f, -232.0f }, { 2.0f, 2.0f, -228.0f });
+    shadows.update(camera, SUN, casters, nullptr);
+    const ShadowStats& stats = shadows.getStats();
+    CHECK(stats.invalidated_by_sections == 1);
+    CHECK(stats.cascades_rendered == 3);
+    CHECK(stats.cascades_reused == 1);
+    CHECK(!shadows.getCascades()[2].render);
+    CHECK(shadows.getCascades()[3].render);
+
+    const auto& far_casters = shadows.getCascades()[3].casters;
+    CHECK(std::any_of(far_casters.begin(), far_casters.end(), [](const VisibleSection& section) { return section.section_slot == 5; }));
+    CHECK(casters.getChanges().empty());
+
+    // The change was consumed, so the next frame reuses both again
+    shadows.update(camera, SUN, casters, nullptr);
+    CHECK(shadows.getStats().cascades_reused == 2);
+}
@@ -0,0 +1,171 @@
+#include "TestFramework.h"
+
+#include "Jobs/JobSystem.h"
+#include "Lighting/ClusteredLighting.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    enum class Overlap { No, Yes, Tangent };
+
+    // Sphere against one froxel, with the frustum built the way the shader sees it
+    Overlap froxelOverlap(const ClusterCamera& camera, const ClusterConfig& config, uint32_t slice, uint32_t row, uint32_t column,
+        const GpuPointLight& light) {
+        const double tan_y = std::tan(camera.fov_y * 0.5);
+        const double tan_x = tan_y * camera.aspect;
+        const double ratio = static_cast<double>(camera.far_plane) / camera.near_plane;
+        const double near_depth = camera.near_plane * std::pow(ratio, static_cast<double>(slice) / config.slices);
+        const double far_depth = camera.near_plane * std::pow(ratio, static_cast<double>(slice + 1) / config.slices);
+
+        const double left = tan_x * (-1.0 + 2.0 * column / config.tiles_x);
+        const double right = tan_x * (-1.0 + 2.0 * (column + 1) / config.tiles_x);
+        const double top = tan_y * (1.0 - 2.0 * row / config.tiles_y);
+        const double bottom = tan_y * (1.0 - 2.0 * (row + 1) / config.tiles_y);
+
+        // Box around the froxel's view-space corners
+        const double min_x = std::min(left * near_depth, left * far_depth);
+        const double max_x = std::max(right * near_depth, right * far_depth);
+        const double min_y = std::min(bottom * near_depth, bottom * far_depth);
+        const double max_y = std::max(top * near_depth, top * far_depth);
+
+        const auto& m = camera.view;
+        const float* p = light.position;
+        const double x = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+        const double y = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+        const double depth = -(m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14]);
+
+        const double dx = std::max({ min_x - x, x - max_x, 0.0 });
+        const double dy = std::max({ min_y - y, y - max_y, 0.0 });
+        const double dz = std::max({ near_depth - depth, depth - far_depth, 0.0 });
+        const double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+        // Float rounding decides lights that just graze a face either way
+        const double slack = 1e-3 * std::max<double>(light.radius, 1.0);
+        if (std::abs(distance - light.radius) <= slack) return Overlap::Tangent;
+        return distance < light.radius ? Overlap::Yes : Overlap::No;
+    }
+
+    std::vector<GpuPointLight> makeLights(const ClusterCamera& camera) {
+        std::mt19937 rng(86);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> depth(0.0f, camera.far_plane * 1.1f);
+        std::uniform_real_distribution<float> radius(0.2f, 12.0f);
+
+        std::vector<GpuPointLight> lights;
+        auto add = [&](float x, float y, float d, float r) {
+            // Identity view: depth runs down -Z
+            lights.push_back({ { x, y, -d }, r, { 1.0f, 1.0f, 1.0f }, 1.0f });
+            };
+
+        for (int i = 0; i < 600; ++i) {
+            const float d = depth(rng);
+            add(unit(rng) * d, unit(rng) * d * 0.7f, d, radius(rng));
+        }
+        // Straddling the near plane, behind the camera, and reaching past it
+        add(0.0f, 0.0f, camera.near_plane, 0.3f);
+        add(0.5f, -0.2f, camera.near_plane * 0.5f, 1.0f);
+        add(0.0f, 0.0f, -2.0f, 1.0f);
+        // Straddling and beyond the far plane, where the last slice is clamped
+        add(4.0f, 1.0f, camera.far_plane, 6.0f);
+        add(-10.0f, 3.0f, camera.far_plane - 0.01f, 0.5f);
+        add(0.0f, 0.0f, camera.far_plane + 5.0f, 3.0f);
+        add(0.0f, 0.0f, camera.far_plane + 5.0f, 6.0f);
+        // Zero radius never lights anything
+        add(0.0f, 0.0f, 10.0f, 0.0f);
+        return lights;
+    }
+}
+
+TEST(ClusteredLighting, BuildMatchesBruteForce) {
+    ClusterCamera camera;
+    camera.near_plane = 0.5f;
+    camera.far_plane = 100.0f;
+    camera.viewport_width = 800;
+    camera.viewport_height = 500;
+    camera.aspect = 800.0f / 500.0f;
+
+    ClusterConfig config;
+    config.tiles_x = 8;
+    config.tiles_y = 5;
+    config.slices = 12;
+    config.max_lights_per_cluster = 4096;
+    config.transform_batch_size = 64;
+
+    const std::vector<GpuPointLight> lights = makeLights(camera);
+    JobSystem jobs(2, "Test");
+
+    for (const bool use_simd : { false, true }) {
+        config.use_simd = use_simd;
+        LightClusterBuilder builder(config);
+        ClusterLightGrid grid;
+        builder.build(camera, lights, &jobs, grid);
+        REQUIRE(grid.ranges.size() == size_t{ config.tiles_x } * config.tiles_y * config.slices);
+        CHECK(grid.stats.clusters_overflowed == 0);
+
+        uint32_t mismatches = 0;
+        for (uint32_t slice = 0; slice < config.slices; ++slice) {
+            for (uint32_t row = 0; row < config.tiles_y; ++row) {
+                for (uint32_t column = 0; column < config.tiles_x; ++column) {
+                    const ClusterRange range = grid.ranges[(slice * config.tiles_y + row) * config.tiles_x + column];
+                    std::vector<uint32_t> assigned(grid.light_indices.begin() + range.offset,
+                        grid.light_indices.begin() + range.offset + range.count);
+                    std::sort(assigned.begin(), assigned.end());
+                    CHECK(std::adjacent_find(assigned.begin(), assigned.end()) == assigned.end());
+
+                    for (uint32_t light = 0; light < lights.size(); ++light) {
+                        const Overlap expected = froxelOverlap(camera, config, slice, row, column, lights[light]);
+                        if (expected == Overlap::Tangent) continue;
+                        const bool found = std::binary_search(assigned.begin(), assigned.end(), light);
+                        if (found != (expected == Overlap::Yes)) ++mismatches;
+                    }
+                }
+            }
+        }
+        CHECK(mismatches == 0);
+
+        // The far-plane straddler lands in the last slice, the light past it nowhere
+        const auto lightsInSlice = [&](uint32_t slice) {
+            std::vector<uint32_t> found;
+            for (uint32_t tile = 0; tile < config.tiles_x * config.tiles_y; ++tile) {
+                const ClusterRange range = grid.ranges[slice * config.tiles_x * config.tiles_y + tile];
+                found.insert(found.end(), grid.light_indices.begin() + range.offset, grid.light_indices.begin() + range.offset + range.count);
+            }
+            return found;
+            };
+        const std::vector<uint32_t> last = lightsInSlice(config.slices - 1);
+        const uint32_t straddler = static_cast<uint32_t>(lights.size() - 5);
+        const uint32_t beyond = static_cast<uint32_t>(lights.size() - 3);
+        CHECK(std::find(last.begin(), last.end(), straddler) != last.end());
+        CHECK(std::find(grid.light_indices.begin(), grid.light_indices.end(), beyond) == grid.light_indices.end());
+        CHECK(std::find(grid.light_indices.begin(), grid.light_indices.end(), static_cast<uint32_t>(lights.size() - 1))
+            == grid.light_indices.end());
+    }
+}
+
+TEST(ClusteredLighting, ThreadCountDoesNotChangeTheGrid) {
+    ClusterCamera camera;
+    camera.far_plane = 100.0f;
+    const std::vector<GpuPointLight> lights = makeLights(camera);
+
+    ClusterConfig config;
+    config.transform_batch_size = 64;
+    LightClusterBuilder builder(config);
+    ClusterLightGrid serial;
+    builder.build(camera, lights, nullptr, serial);
+
+    JobSystem jobs(3, "Test");
+    ClusterLightGrid parallel;
+    builder.build(camera, lights, &jobs, parallel);
+
+    CHECK(serial.light_indices == parallel.light_indices);
+    REQUIRE(serial.ranges.size() == parallel.ranges.size());
+    for (size_t i = 0; i < serial.ranges.size(); ++i) {
+        CHECK(serial.ranges[i].offset == parallel.ranges[i].offset);
+        CHECK(serial.ranges[i].count == parallel.ranges[i].count);
+    }
+}
@@ -0,0 +1,136 @@
+#include "TestFramework.h"
+
+#include "Entity/EntityInstanceBatcher.h"
+#include "Jobs/JobSystem.h"
+
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    constexpr uint32_t MESH_COUNT = 4;  // Mesh 3 has no index range
+
+    // Box frustum: x, y in [-100, 100], z in [0, 100]
+    Frustum boxFrustum() {
+        const float s = 1.0f / 100.0f;
+        return Frustum::fromViewProjection({ s, 0, 0, 0, 0, s, 0, 0, 0, 0, s, 0, 0, 0, 0, 1 });
+    }
+
+    EntityMeshTable makeMeshes() {
+        EntityMeshTable meshes;
+        for (uint32_t mesh = 0; mesh + 1 < MESH_COUNT; ++mesh) {
+            meshes.setMesh(mesh, { static_cast<int32_t>(mesh * 1000), mesh * 300, 36 + mesh * 6 });
+        }
+        meshes.setMesh(MESH_COUNT - 1, {});
+        return meshes;
+    }
+
+    std::vector<EntityRenderProxy> makeEntities(size_t count) {
+        std::vector<EntityRenderProxy> entities(count);
+        for (size_t i = 0; i < count; ++i) {
+            EntityRenderProxy& entity = entities[i];
+            const bool outside = i % 5 == 4;
+            entity.bounds = { outside ? 500.0f : static_cast<float>(i % 150) - 75.0f, 10.0f, 50.0f, 1.0f };
+            entity.mesh = static_cast<uint32_t>((i * 7) % MESH_COUNT);
+            entity.material = static_cast<uint32_t>((i / 3) % 3);
+            entity.entity_id = static_cast<uint32_t>(i);
+            entity.transform[3] = static_cast<float>(i);
+        }
+        return entities;
+    }
+
+    GpuEntityInstance readInstance(const std::vector<std::byte>& memory, uint32_t slot) {
+        GpuEntityInstance instance;
+        std::memcpy(&instance, memory.data() + size_t{ slot } * sizeof(GpuEntityInstance), sizeof(instance));
+        return instance;
+    }
+}
+
+TEST(EntityInstanceBatcher, OneDrawPerMeshMaterialPair) {
+    const std::vector<EntityRenderProxy> entities = makeEntities(301);
+    const EntityMeshTable meshes = makeMeshes();
+
+    // What should survive: inside the box with a drawable mesh, grouped material-major
+    std::map<std::pair<uint32_t, uint32_t>, std::vector<uint32_t>> expected;
+    for (const EntityRenderProxy& entity : entities) {
+        if (entity.bounds[0] > 100.0f || !meshes.isValid(entity.mesh)) continue;
+        expected[{ entity.material, entity.mesh }].push_back(entity.entity_id);
+    }
+
+    JobSystem jobs(2, "Test");
+    for (const bool threaded : { false, true }) {
+        for (const bool simd : { false, true }) {
+            EntityInstanceBatcher batcher({ .batch_size = 16, .use_simd = simd });
+            std::vector<std::byte> memory(entities.size() * sizeof(GpuEntityInstance));
+            EntityDrawList list;
+            batcher.build(boxFrustum(), entities, meshes, memory, threaded ? &jobs : nullptr, list);
+
+            CHECK(list.stats.entities == entities.size());
+            CHECK(list.stats.instances_dropped == 0);
+            REQUIRE(list.groups.size() == expected.size());
+            REQUIRE(list.commands.size() == expected.size());
+            CHECK(list.stats.draws == expected.size());
+
+            uint32_t first_instance = 0;
+            size_t group = 0;
+            for (const auto& [key, ids] : expected) {
+                const EntityDrawGroup& draw = list.groups[group];
+                const DrawIndexedIndirectCommand& command = list.commands[group];
+                const EntityMeshInfo& mesh = meshes.getMesh(key.second);
+                CHECK(draw.material == key.first);
+                CHECK(draw.mesh == key.second);
+                CHECK(draw.first_instance == first_instance);
+                CHECK(draw.instance_count == ids.size());
+                CHECK(command.first_instance == first_instance);
+                CHECK(command.instance_count == ids.size());
+                CHECK(command.index_count == mesh.index_count);
+                CHECK(command.first_index == mesh.first_index);
+                CHECK(command.vertex_offset == mesh.vertex_offset);
+
+                // Instances of a group sit in visible (input) order
+                for (size_t i = 0; i < ids.size(); ++i) {
+                    const GpuEntityInstance instance = readInstance(memory, first_instance + static_cast<uint32_t>(i));
+                    CHECK(instance.entity_id == ids[i]);
+                    CHECK(instance.transform[3] == static_cast<float>(ids[i]));
+                }
+                first_instance += static_cast<uint32_t>(ids.size());
+                ++group;
+            }
+            CHECK(list.stats.entities_visible == first_instance);
+            CHECK(list.stats.instances_written == first_instance);
+        }
+    }
+}
+
+TEST(EntityInstanceBatcher, FullInstanceBufferDropsTheTail) {
+    const std::vector<EntityRenderProxy> entities = makeEntities(100);
+    const EntityMeshTable meshes = makeMeshes();
+    EntityInstanceBatcher batcher;
+
+    std::vector<std::byte> unlimited(entities.size() * sizeof(GpuEntityInstance));
+    EntityDrawList full;
+    batcher.build(boxFrustum(), entities, meshes, unlimited, nullptr, full);
+    REQUIRE(full.stats.entities_visible > 20);
+
+    std::vector<std::byte> memory(20 * sizeof(GpuEntityInstance));
+    EntityDrawList list;
+    batcher.build(boxFrustum(), entities, meshes, memory, nullptr, list);
+    CHECK(list.stats.entities == entities.size());
+    CHECK(list.stats.instances_written == 20);
+    CHECK(list.stats.instances_dropped == full.stats.entities_visible - 20);
+    for (const DrawIndexedIndirectCommand& command : list.commands) {
+        CHECK(command.first_instance + command.instance_count <= 20);
+    }
+}
+
+TEST(EntityInstanceBatcher, EmptyInputStillReportsZeroEntities) {
+    EntityInstanceBatcher batcher;
+    EntityDrawList list;
+    list.stats.entities = 7;
+    batcher.build(boxFrustum(), {}, makeMeshes(), {}, nullptr, list);
+    CHECK(list.stats.entities == 0);
+    CHECK(list.commands.empty());
+}
@@ -0,0 +1,159 @@
+#include "TestFramework.h"
+
+#include "Memory/GpuMemory.h"
+#include "Memory/NullGpuMemoryBackend.h"
+
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    constexpr uint64_t MB = 1024 * 1024;
+
+    RendererConfig makeRendererConfig(uint64_t vram_budget) {
+        RendererConfig config;
+        config.vram_budget = vram_budget;
+        return config;
+    }
+}
+
+TEST(GpuMemory, SubAllocatesFromSharedBlocks) {
+    NullGpuMemoryBackend backend;
+    GpuMemoryAllocator allocator(backend, makeRendererConfig(1024 * MB));
+
+    std::vector<GpuAllocation> allocations;
+    for (int i = 0; i < 64; ++i) {
+        auto allocation = allocator.allocate({ .size = MB, .alignment = 256 });
+        REQUIRE(allocation.has_value());
+        CHECK(allocation->offset % 256 == 0);
+        allocations.push_back(*allocation);
+    }
+    // 64 MB of small resources fit in one 256 MB block
+    CHECK(allocator.getStats().device_allocations == 1);
+
+    for (const GpuAllocation& allocation : allocations) allocator.free(allocation);
+    CHECK(allocator.getStats().getDeviceLocalUsed() <= 256 * MB);
+}
+
+TEST(GpuMemory, LargeAllocationsAreDedicated) {
+    NullGpuMemoryBackend backend;
+    GpuMemoryAllocator allocator(backend, makeRendererConfig(1024 * MB));
+
+    const auto big = allocator.allocate({ .size = 200 * MB });
+    REQUIRE(big.has_value());
+    CHECK(big->offset == 0);
+    CHECK(allocator.getStats().heaps[0].dedicated_count == 1);
+
+    allocator.free(*big);
+    CHECK(backend.getAllocationCount() == 0);
+}
+
+TEST(GpuMemory, DoubleFreeIsIgnored) {
+    NullGpuMemoryBackend backend;
+    GpuMemoryAllocator allocator(backend, makeRendererConfig(1024 * MB));
+
+    const auto first = allocator.allocate({ .size = MB });
+    const auto keep = allocator.allocate({ .size = MB });
+    REQUIRE(first && keep);
+    allocator.free(*first);
+    allocator.free(*first);
+
+    const GpuMemoryStats stats = allocator.getStats();
+    CHECK(stats.heaps[0].allocation_count == 1);
+    CHECK(stats.heaps[0].used == MB);
+}
+
+TEST(GpuMemory, StaleFreeDoesNotReleaseTheNewOwner) {
+    NullGpuMemoryBackend backend;
+    GpuMemoryAllocator allocator(backend, makeRendererConfig(1024 * MB));
+
+    const auto keep = allocator.allocate({ .size = MB });
+    const auto old_allocation = allocator.allocate({ .size = MB });
+    REQUIRE(keep && old_allocation);
+    allocator.free(*old_allocation);
+
+    // Same size right after the free: TLSF hands back the same range
+    const auto reused = allocator.allocate({ .size = MB });
+    REQUIRE(reused.has_value());
+    CHECK(reused->offset == old_allocation->offset);
+
+    allocator.free(*old_allocation);
+    CHECK(allocator.getStats().heaps[0].allocation_count == 2);
+
+    allocator.free(*reused);
+    allocator.free(*keep);
+    CHECK(allocator.getStats().heaps[0].allocation_count == 0);
+}
+
+TEST(GpuMemory, StaleDedicatedFreeIsIgnored) {
+    NullGpuMemoryBackend backend;
+    GpuMemoryAllocator allocator(backend, makeRendererConfig(1024 * MB));
+
+    const auto old_allocation = allocator.allocate({ .size = 200 * MB });
+    REQUIRE(old_allocation.has_value());
+    allocator.free(*old_allocation);
+
+    // The new dedicated block takes over the same slot
+    const auto reused = allocator.allocate({ .size = 200 * MB });
+    REQUIRE(reused.has_value());
+    CHECK(reused->block == old_allocation->block);
+
+    allocator.free(*old_allocation);
+    CHECK(backend.getAllocationCount() == 1);
+    allocator.free(*reused);
+    CHECK(backend.getAllocationCount() == 0);
+}
+
+TEST(GpuMemory, LinearPoolFreesAfterResetAreIgnored) {
+    NullGpuMemoryBackend backend;
+    GpuMemoryAllocator allocator(backend, makeRendererConfig(1024 * MB));
+
+    const auto pool = allocator.createLinearPool(GpuMemoryUsage::Upload, MB);
+    REQUIRE(pool.has_value());
+    const auto a = allocator.allocate({ .size = 1000, .alignment = 256 }, { .linear_pool = *pool });
+    const auto b = allocator.allocate({ .size = 1000, .alignment = 256 }, { .linear_pool = *pool });
+    REQUIRE(a && b);
+    CHECK(b->offset == 1024);
+    CHECK(a->mapped != nullptr);
+
+    allocator.resetLinearPool(*pool);
+    const auto c = allocator.allocate({ .size = 1000 }, { .linear_pool = *pool });
+    REQUIRE(c.has_value());
+    CHECK(c->offset == 0);
+
+    allocator.free(*a);
+    allocator.free(*b);
+    uint32_t live = 0;
+    for (const GpuHeapStats& heap : allocator.getStats().heaps) live += heap.allocation_count;
+    CHECK(live == 1);
+
+    allocator.destroyLinearPool(*pool);
+}
+
+TEST(GpuMemory, EvictionCallbackMakesRoom) {
+    NullGpuMemoryBackend backend;
+    GpuMemoryAllocator allocator(backend, makeRendererConfig(512 * MB));
+
+    std::vector<GpuAllocation> resident;
+    for (int i = 0; i < 2; ++i) {
+        auto allocation = allocator.allocate({ .size = 200 * MB });
+        REQUIRE(allocation.has_value());
+        resident.push_back(*allocation);
+    }
+
+    allocator.addEvictionCallback([&](uint32_t, uint64_t needed) {
+        uint64_t released = 0;
+        while (released < needed && !resident.empty()) {
+            released += resident.back().size;
+            allocator.free(resident.back());
+            resident.pop_back();
+        }
+        return released;
+    });
+
+    const auto next = allocator.allocate({ .size = 200 * MB });
+    CHECK(next.has_value());
+    CHECK(allocator.getStats().evicted_bytes >= 200 * MB);
+    if (next) allocator.free(*next);
+    for (const GpuAllocation& allocation : resident) allocator.free(allocation);
+}
@@ -0,0 +1,80 @@
+#include "TestFramework.h"
+
+#include "Draw/IndirectDraw.h"
+#include "Jobs/JobSystem.h"
+
+using namespace AshCore;
+
+namespace {
+    // Section i: vertex_offset i*100, six indices per face group
+    SectionMeshTable makeTable(uint32_t count) {
+        SectionMeshTable table;
+        for (uint32_t i = 0; i < count; ++i) {
+            SectionMeshRange range;
+            range.vertex_offset = static_cast<int32_t>(i * 100);
+            range.first_index = i * 36;
+            range.face_index_counts.fill(6);
+            table.setSection(i, range, { float(i), 0.0f, 0.0f });
+        }
+        return table;
+    }
+}
+
+TEST(IndirectDraw, MergesAdjacentFaceGroups) {
+    const SectionMeshTable table = makeTable(2);
+    const std::vector<VisibleSection> visible = {
+        { 0, 0b000111 },  // PosX, PosY, PosZ: one run
+        { 1, 0b101010 },  // PosY, NegX, NegZ: three runs
+    };
+
+    IndirectDrawBuilder builder;
+    IndirectDrawList list;
+    builder.build(visible, table, nullptr, list);
+
+    REQUIRE(list.commands.size() == 4);
+    CHECK(list.commands[0].first_index == 0);
+    CHECK(list.commands[0].index_count == 18);
+    CHECK(list.commands[1].first_index == 36 + 6);
+    CHECK(list.commands[2].first_index == 36 + 18);
+    CHECK(list.commands[3].first_index == 36 + 30);
+    CHECK(list.commands[3].vertex_offset == 100);
+    // first_instance indexes the per-section draw data
+    CHECK(list.commands[3].first_instance == 1);
+    CHECK(list.draw_data.size() == 2);
+    CHECK(list.stats.faces == 6);
+}
+
+TEST(IndirectDraw, ParallelBuildMatchesSerial) {
+    const SectionMeshTable table = makeTable(5000);
+    std::vector<VisibleSection> visible;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        visible.push_back({ i, static_cast<uint8_t>(i % 2 ? 0b000111 : 0b101010) });
+    }
+
+    JobSystem jobs(3, "Test");
+    IndirectDrawBuilder builder({ .batch_size = 64 });
+    IndirectDrawList parallel;
+    IndirectDrawList serial;
+    builder.build(visible, table, &jobs, parallel);
+    builder.build(visible, table, nullptr, serial);
+
+    REQUIRE(parallel.commands.size() == serial.commands.size());
+    for (size_t i = 0; i < serial.commands.size(); ++i) {
+        CHECK(parallel.commands[i].first_index == serial.commands[i].first_index);
+        CHECK(parallel.commands[i].first_instance == serial.commands[i].first_instance);
+    }
+}
+
+TEST(IndirectDraw, EmptySectionsAreSkipped) {
+    SectionMeshTable table = makeTable(3);
+    table.clearSection(1);
+    const std::vector<VisibleSection> visible = { { 0 }, { 1 }, { 2 } };
+
+    IndirectDrawBuilder builder;
+    IndirectDrawList list;
+    builder.build(visible, table, nullptr, list);
+
+    CHECK(list.stats.sections_visible == 3);
+    CHECK(list.stats.sections_drawn == 2);
+    CHECK(list.commands.size() == 2);
+}
@@ -0,0 +1,141 @@
+#include "TestFramework.h"
+
+#include "Draw/MeshArena.h"
+#include "Memory/TlsfAllocator.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    std::array<uint32_t, FACE_DIRECTION_COUNT> uniformFaces(uint32_t indices_per_face) {
+        std::array<uint32_t, FACE_DIRECTION_COUNT> faces;
+        faces.fill(indices_per_face);
+        return faces;
+    }
+}
+
+TEST(TlsfAllocator, AlignsAndCoalesces) {
+    TlsfAllocator allocator(1000);
+    const auto a = allocator.allocate(100);
+    const auto b = allocator.allocate(100, 64);
+    const auto c = allocator.allocate(10);
+    REQUIRE(a && b && c);
+    CHECK(b->offset % 64 == 0);
+    CHECK(allocator.getAllocationSize(*a) >= 100);
+
+    allocator.free(*b);
+    allocator.free(*a);
+    allocator.free(*c);
+    const TlsfStats stats = allocator.getStats();
+    CHECK(stats.used == 0);
+    CHECK(stats.free_block_count == 1);
+    CHECK(stats.largest_free == 1000);
+}
+
+TEST(TlsfAllocator, FailsWhenFull) {
+    TlsfAllocator allocator(256);
+    const auto all = allocator.allocate(256);
+    REQUIRE(all.has_value());
+    CHECK(!allocator.allocate(1).has_value());
+    allocator.free(*all);
+    CHECK(allocator.allocate(1).has_value());
+}
+
+TEST(TlsfAllocator, StaleFreeDoesNotReleaseTheNewOwner) {
+    TlsfAllocator allocator(256);
+    const auto first = allocator.allocate(64);
+    REQUIRE(first.has_value());
+    allocator.free(*first);
+
+    // Same node, same offset: only the generation tells the two apart
+    const auto second = allocator.allocate(64);
+    REQUIRE(second.has_value());
+    CHECK(second->node == first->node);
+    CHECK(second->offset == first->offset);
+    CHECK(second->generation != first->generation);
+
+    allocator.free(*first);
+    CHECK(allocator.getUsed() == 64);
+    CHECK(allocator.getAllocationSize(*first) == 0);
+    CHECK(allocator.getAllocationSize(*second) == 64);
+
+    allocator.free(*second);
+    allocator.free(*second);
+    CHECK(allocator.isEmpty());
+    CHECK(allocator.getStats().free_block_count == 1);
+}
+
+TEST(TlsfAllocator, HandlesFromBeforeResetAreStale) {
+    TlsfAllocator allocator(128);
+    const auto before = allocator.allocate(32);
+    REQUIRE(before.has_value());
+    allocator.reset(128);
+
+    const auto after = allocator.allocate(32);
+    REQUIRE(after.has_value());
+    allocator.free(*before);
+    CHECK(allocator.getUsed() == 32);
+}
+
+TEST(MeshArena, FreedRangesWaitForTheirFrame) {
+    MeshArenaConfig config;
+    config.vertex_capacity = 1024;  // Power of two: TLSF rounding cannot overshoot
+    config.index_capacity = 4096;
+    MeshArena arena(config);
+
+    const auto first = arena.allocateSection(0, 1024, uniformFaces(6), 1);
+    REQUIRE(first.has_value());
+    CHECK(first->getIndexCount() == 36);
+
+    // Replacing the mesh at frame 2 keeps the old range alive until frame 2 completes
+    CHECK(!arena.allocateSection(0, 1024, uniformFaces(6), 2).has_value());
+    CHECK(arena.getStats().failed_allocations == 1);
+
+    arena.collectGarbage(1);
+    CHECK(arena.getStats().pending_frees > 0);
+    arena.collectGarbage(2);
+    CHECK(arena.getStats().pending_frees == 0);
+    CHECK(!arena.getSection(0).has_value());
+    CHECK(arena.allocateSection(1, 1024, uniformFaces(6), 3).has_value());
+}
+
+TEST(MeshArena, ChurnNeverOverlapsAndCompactionMovesBytes) {
+    MeshArenaConfig config;
+    config.vertex_capacity = 1 << 20;
+    config.index_capacity = 1 << 21;
+    config.compaction_threshold = 0.05f;
+    MeshArena arena(config);
+
+    std::mt19937 rng(1);
+    uint64_t frame = 0;
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        ++frame;
+        for (int k = 0; k < 20; ++k) {
+            std::array<uint32_t, FACE_DIRECTION_COUNT> faces;
+            for (uint32_t& count : faces) count = (rng() % 200) * 6;
+            CHECK(arena.allocateSection(rng() % 300, rng() % 3000 + 1, faces, frame).has_value());
+        }
+        std::vector<MeshArenaCopy> copies;
+        arena.compact(frame, copies);
+        for (const MeshArenaCopy& copy : copies) {
+            CHECK(copy.dst_offset < copy.src_offset);
+        }
+        arena.collectGarbage(frame > 2 ? frame - 2 : 0);
+    }
+    CHECK(arena.getStats().bytes_moved_total > 0);
+
+    // Live index ranges must be disjoint
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+    for (uint32_t slot = 0; slot < 300; ++slot) {
+        const auto range = arena.getSection(slot);
+        if (range && !range->isEmpty()) ranges.push_back({ range->first_index, range->first_index + range->getIndexCount() });
+    }
+    std::sort(ranges.begin(), ranges.end());
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        CHECK(ranges[i - 1].second <= ranges[i].first);
+    }
+}
@@ -0,0 +1,160 @@
+#include "TestFramework.h"
+
+#include "Jobs/JobSystem.h"
+#include "Texture/AtlasPacker.h"
+#include "Texture/MipGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    using Chain = std::vector<std::vector<std::byte>>;
+
+    std::vector<std::byte> noiseImage(uint32_t width, uint32_t height, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::byte> rgba(size_t{ width } * height * 4);
+        for (std::byte& b : rgba) b = static_cast<std::byte>(rng());
+        return rgba;
+    }
+
+    Chain generate(const MipSettings& settings, const std::vector<std::byte>& rgba, uint32_t width, uint32_t height, JobSystem* jobs) {
+        MipGenerator generator(settings);
+        auto chain = generator.generate(rgba, width, height, jobs);
+        REQUIRE(chain.has_value());
+        return std::move(*chain);
+    }
+
+    // Largest per-byte difference; chains of different shape never match
+    int maxDifference(const Chain& a, const Chain& b) {
+        if (a.size() != b.size()) return 256;
+        int worst = 0;
+        for (size_t mip = 0; mip < a.size(); ++mip) {
+            if (a[mip].size() != b[mip].size()) return 256;
+            for (size_t i = 0; i < a[mip].size(); ++i) {
+                worst = std::max(worst, std::abs(static_cast<int>(a[mip][i]) - static_cast<int>(b[mip][i])));
+            }
+        }
+        return worst;
+    }
+
+    // Atlas of solid-colour images, so any texel that mixes in a neighbour shows
+    struct SolidAtlas {
+        static constexpr std::array<std::array<uint32_t, 2>, 6> SIZES{ { {13, 7}, {5, 21}, {30, 30}, {9, 9}, {1, 17}, {26, 3} } };
+
+        AtlasPackSettings settings;
+        std::vector<std::vector<std::byte>> pixels;
+        std::vector<AtlasImage> images;
+        AtlasLayout layout;
+        std::vector<std::byte> page;
+
+        SolidAtlas() {
+            for (size_t i = 0; i < SIZES.size(); ++i) {
+                std::vector<std::byte>& rgba = pixels.emplace_back(size_t{ SIZES[i][0] } * SIZES[i][1] * 4);
+                for (size_t t = 0; t < rgba.size(); t += 4) {
+                    rgba[t + 0] = static_cast<std::byte>(40 * (i + 1));
+                    rgba[t + 1] = static_cast<std::byte>(255 - 30 * i);
+                    rgba[t + 2] = static_cast<std::byte>(i * 17);
+                    rgba[t + 3] = std::byte{ 255 };
+                }
+            }
+            for (size_t i = 0; i < SIZES.size(); ++i) images.push_back({ pixels[i], SIZES[i][0], SIZES[i][1] });
+
+            auto packed = packAtlas(images, settings);
+            REQUIRE(packed.has_value());
+            REQUIRE(packed->page_count == 1);
+            layout = std::move(*packed);
+            page = composeAtlas(layout, images, settings.padding, nullptr);
+        }
+
+        // Texels of a level that sample some region's content but not only its colour
+        size_t bleeding(const Chain& chain, uint32_t mip) const {
+            const uint32_t scale = 1u << mip;
+            const uint32_t width = std::max(layout.width >> mip, 1u);
+            const std::vector<std::byte>& level = chain[mip];
+            size_t count = 0;
+            for (size_t i = 0; i < images.size(); ++i) {
+                const AtlasPlacement& placement = layout.placements[i];
+                for (uint32_t y = placement.y / scale; y * scale < placement.y + placement.height; ++y) {
+                    for (uint32_t x = placement.x / scale; x * scale < placement.x + placement.width; ++x) {
+                        const size_t texel = (size_t{ y } * width + x) * 4;
+                        for (size_t c = 0; c < 4; ++c) {
+                            // sRGB filtering can move a solid colour by a rounding step
+                            const int difference = static_cast<int>(level[texel + c]) - static_cast<int>(pixels[i][c]);
+                            if (std::abs(difference) > 1) {
+                                ++count;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            return count;
+        }
+    };
+}
+
+TEST(MipGenerator, SimdMatchesScalarOnOddSizes) {
+    // Odd, non-square, single row and single column
+    constexpr std::array<std::array<uint32_t, 2>, 7> SIZES{ { {13, 7}, {5, 21}, {1, 17}, {33, 1}, {31, 18}, {64, 48}, {3, 3} } };
+    JobSystem jobs(2, "Test");
+
+    for (const MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+        for (const bool srgb : { true, false }) {
+            for (const bool premultiply : { false, true }) {
+                for (size_t s = 0; s < SIZES.size(); ++s) {
+                    const auto [width, height] = SIZES[s];
+                    const std::vector<std::byte> rgba = noiseImage(width, height, static_cast<uint32_t>(s));
+
+                    MipSettings settings;
+                    settings.filter = filter;
+                    settings.srgb = srgb;
+                    settings.premultiply = premultiply;
+                    settings.row_batch_size = 4;
+                    settings.use_simd = false;
+                    const Chain scalar = generate(settings, rgba, width, height, nullptr);
+                    settings.use_simd = true;
+                    const Chain simd = generate(settings, rgba, width, height, &jobs);
+
+                    // Full chain down to 1x1, with every level the expected size
+                    const uint32_t levels = 1 + static_cast<uint32_t>(std::bit_width(std::max(width, height)) - 1);
+                    REQUIRE(scalar.size() == levels);
+                    for (uint32_t mip = 0; mip < levels; ++mip) {
+                        CHECK(scalar[mip].size() == size_t{ std::max(width >> mip, 1u) } * std::max(height >> mip, 1u) * 4);
+                    }
+
+                    // FMA contraction may round the scalar path differently by one step
+                    CHECK(maxDifference(scalar, simd) <= 1);
+                }
+            }
+        }
+    }
+}
+
+TEST(MipGenerator, AtlasChainStopsWherePaddingStopsProtecting) {
+    const SolidAtlas atlas;
+    for (const MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+        for (const bool simd : { false, true }) {
+            MipSettings settings;
+            settings.filter = filter;
+            settings.use_simd = simd;
+            const uint32_t limit = getAtlasMipLimit(atlas.settings, settings);
+            REQUIRE(limit >= 1);
+
+            // One level past the limit, to show it is the first that bleeds
+            settings.max_mips = limit + 1;
+            const Chain chain = generate(settings, atlas.page, atlas.layout.width, atlas.layout.height, nullptr);
+            REQUIRE(chain.size() == limit + 1);
+            for (uint32_t mip = 0; mip < limit; ++mip) CHECK(atlas.bleeding(chain, mip) == 0);
+            CHECK(atlas.bleeding(chain, limit) > 0);
+
+            settings.max_mips = limit;
+            CHECK(generate(settings, atlas.page, atlas.layout.width, atlas.layout.height, nullptr).size() == limit);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include "TestFramework.h"
+
+#include "Command/ParallelCommandRecorder.h"
+#include "Command/RecordingCommandBackend.h"
+#include "Jobs/JobSystem.h"
+
+#include <thread>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    const CommandInheritance INHERITANCE{ { RenderFormat::RGBA8Unorm }, 1, RenderFormat::D32Float };
+    const SectionDrawState STATE{ GpuPipelineHandle{ 1 }, GpuBufferHandle{ 2 }, GpuBufferHandle{ 3 } };
+
+    IndirectDrawList makeDraws(uint32_t count) {
+        IndirectDrawList draws;
+        for (uint32_t i = 0; i < count; ++i) {
+            draws.commands.push_back({ 6, 1, i * 6, static_cast<int32_t>(i), i });
+        }
+        return draws;
+    }
+}
+
+TEST(ParallelCommandRecorder, OnePoolPerThreadSlotAndFrame) {
+    JobSystem jobs(4, "Test");
+    RecordingCommandBackend backend;
+    SimulatedFrameFence fence;
+    FrameTimeline timeline(fence, 2);
+    ParallelCommandRecorder recorder(backend, jobs, timeline);
+
+    REQUIRE(recorder.initialize().has_value());
+    CHECK(backend.getPoolCount() == jobs.getThreadCount() * 2);
+}
+
+TEST(ParallelCommandRecorder, SecondariesKeepDrawOrder) {
+    JobSystem jobs(4, "Test");
+    RecordingCommandBackend backend;
+    SimulatedFrameFence fence;
+    FrameTimeline timeline(fence, 2);
+    ParallelCommandRecorder recorder(backend, jobs, timeline, { .batch_size = 64, .min_parallel_items = 100 });
+    REQUIRE(recorder.initialize().has_value());
+
+    const IndirectDrawList draws = makeDraws(5000);
+    REQUIRE(recorder.willUseSecondaries(5000));
+
+    for (int iteration = 0; iteration < 4; ++iteration) {
+        const uint64_t frame = timeline.beginFrame();
+        recorder.beginFrame();
+        ICommandPool* pool = recorder.getThreadPool();
+        REQUIRE(pool != nullptr);
+
+        auto* primary = static_cast<RecordingCommandBuffer*>(pool->allocate(CommandBufferLevel::Primary));
+        primary->begin();
+        recorder.recordSectionDraws(*primary, draws, STATE, INHERITANCE);
+        primary->end();
+
+        std::vector<RecordedCommand> flat;
+        primary->flatten(flat);
+        uint32_t next = 0;
+        for (const RecordedCommand& command : flat) {
+            if (command.type != RecordedCommandType::DrawIndexed) continue;
+            CHECK(command.args[3] == next);
+            ++next;
+        }
+        CHECK(next == 5000);
+        CHECK(primary->getErrorCount() == 0);
+        CHECK(recorder.getStats().secondaries == (5000 + 63) / 64);
+        CHECK(!recorder.getStats().recorded_inline);
+        fence.signal(frame);
+    }
+}
+
+TEST(ParallelCommandRecorder, SmallListsRecordInline) {
+    JobSystem jobs(2, "Test");
+    RecordingCommandBackend backend;
+    SimulatedFrameFence fence;
+    FrameTimeline timeline(fence, 1);
+    ParallelCommandRecorder recorder(backend, jobs, timeline, { .batch_size = 64, .min_parallel_items = 100 });
+    REQUIRE(recorder.initialize().has_value());
+    CHECK(!recorder.willUseSecondaries(10));
+
+    timeline.beginFrame();
+    recorder.beginFrame();
+    auto* primary = static_cast<RecordingCommandBuffer*>(recorder.getThreadPool()->allocate(CommandBufferLevel::Primary));
+    primary->begin();
+    recorder.recordSectionDraws(*primary, makeDraws(10), STATE, INHERITANCE);
+    primary->end();
+
+    CHECK(recorder.getStats().recorded_inline);
+    // Pipeline + vertex + index binds, then the draws
+    CHECK(primary->getCommands().size() == 13);
+}
+
+TEST(ParallelCommandRecorder, ForeignThreadGetsNoPool) {
+    JobSystem jobs(2, "Test");
+    RecordingCommandBackend backend;
+    SimulatedFrameFence fence;
+    FrameTimeline timeline(fence, 1);
+    ParallelCommandRecorder recorder(backend, jobs, timeline);
+    REQUIRE(recorder.initialize().has_value());
+
+    timeline.beginFrame();
+    recorder.beginFrame();
+    CHECK(recorder.getThreadPool() != nullptr);
+
+    ICommandPool* foreign = nullptr;
+    std::thread thread([&]() { foreign = recorder.getThreadPool(); });
+    thread.join();
+    CHECK(foreign == nullptr);
+}
@@ -0,0 +1,98 @@
+#include "TestFramework.h"
+
+#include "Jobs/JobSystem.h"
+#include "Particles/ParticleSystem.h"
+#include "Upload/NullUploadBackend.h"
+#include "Upload/UploadManager.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace AshCore;
+
+TEST(ParticleSystem, ZeroLifetimeStaysFinite) {
+    ParticleSystem particles;
+    ParticleTypeDesc desc;
+    desc.lifetime_min = 0.0f;
+    desc.lifetime_max = 0.0f;
+    const ParticleTypeId type = particles.registerType(desc);
+
+    ParticleBurst burst;
+    burst.count = 20;
+    CHECK(particles.emit(type, burst) == 20);
+
+    // Freshly spawned: age 0 over a lifetime of 0 would write NaN
+    RendererConfig renderer_config;
+    renderer_config.max_frames_in_flight = 2;
+    NullUploadBackend backend;
+    UploadManager uploads(backend, renderer_config, { .frame_budget = 4096, .alignment = 16 });
+    REQUIRE(uploads.initialize().has_value());
+    const GpuBufferHandle buffer = backend.createBuffer(particles.getInstanceBufferSize());
+    uploads.beginFrame(1, 0);
+    REQUIRE(particles.writeInstances(uploads, buffer, 0, nullptr));
+    uploads.flush();
+
+    const std::vector<std::byte>* contents = backend.getBufferContents(buffer);
+    REQUIRE(contents != nullptr);
+    for (uint32_t i = 0; i < 20; ++i) {
+        ParticleInstance instance;
+        std::memcpy(&instance, contents->data() + i * sizeof(ParticleInstance), sizeof(instance));
+        CHECK(std::isfinite(instance.life));
+    }
+
+    particles.update(1.0f / 60.0f, nullptr);
+    CHECK(particles.getStats().died == 20);
+    CHECK(particles.getAliveCount(type) == 0);
+}
+
+TEST(ParticleSystem, DroppedCountsOnlySinceLastUpdate) {
+    ParticleSystem particles;
+    ParticleTypeDesc desc;
+    desc.max_particles = 16;
+    desc.lifetime_min = desc.lifetime_max = 10.0f;
+    const ParticleTypeId type = particles.registerType(desc);
+
+    ParticleBurst burst;
+    burst.count = 24;
+    CHECK(particles.emit(type, burst) == 16);
+    particles.update(0.01f, nullptr);
+    CHECK(particles.getStats().dropped == 8);
+
+    particles.update(0.01f, nullptr);
+    CHECK(particles.getStats().dropped == 0);
+
+    burst.count = 3;
+    CHECK(particles.emit(type, burst) == 0);
+    particles.update(0.01f, nullptr);
+    CHECK(particles.getStats().dropped == 3);
+    CHECK(particles.getStats().alive == 16);
+}
+
+TEST(ParticleSystem, ThreadCountDoesNotChangeSurvivors) {
+    JobSystem jobs(3, "Test");
+    ParticleConfig config;
+    config.batch_size = 64;
+
+    ParticleTypeDesc desc;
+    desc.max_particles = 2000;
+    desc.lifetime_min = 0.05f;
+    desc.lifetime_max = 0.5f;
+
+    ParticleSystem serial(config);
+    ParticleSystem parallel(config);
+    const ParticleTypeId serial_type = serial.registerType(desc);
+    const ParticleTypeId parallel_type = parallel.registerType(desc);
+
+    ParticleBurst burst;
+    burst.count = 1500;
+    burst.velocity_jitter = { 1.0f, 1.0f, 1.0f };
+    serial.emit(serial_type, burst);
+    parallel.emit(parallel_type, burst);
+
+    for (int frame = 0; frame < 20; ++frame) {
+        serial.update(1.0f / 60.0f, nullptr);
+        parallel.update(1.0f / 60.0f, &jobs);
+        CHECK(serial.getAliveCount(serial_type) == parallel.getAliveCount(parallel_type));
+    }
+    CHECK(serial.getStats().died == parallel.getStats().died);
+}
@@ -0,0 +1,124 @@
+#include "TestFramework.h"
+
+#include "Jobs/JobSystem.h"
+#include "Pipeline/NullPipelineBackend.h"
+#include "Pipeline/PipelineCache.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    GraphicsPipelineDesc makeDesc(uint64_t shader) {
+        GraphicsPipelineDesc desc;
+        desc.vertex_shader = shader;
+        desc.fragment_shader = shader + 1;
+        desc.color_formats = { RenderFormat::RGBA16Float };
+        desc.attributes = { { 1, 0, VertexFormat::Float2, 12 }, { 0, 0, VertexFormat::Float3, 0 } };
+        desc.bindings = { { 0, 20, false } };
+        desc.specialization = { { 2, 5 }, { 1, 3 } };
+        return desc;
+    }
+
+    RendererConfig makeRendererConfig(const char* name) {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(path);
+        RendererConfig config;
+        config.shader_cache_path = path.string();
+        return config;
+    }
+}
+
+TEST(PipelineKey, IgnoresDeclarationOrderAndDeadState) {
+    GraphicsPipelineDesc a = makeDesc(10);
+    GraphicsPipelineDesc b = makeDesc(10);
+    std::swap(b.attributes[0], b.attributes[1]);
+    std::swap(b.specialization[0], b.specialization[1]);
+    b.blend = { BlendAttachmentDesc{ false, BlendFactor::SrcAlpha } };
+    CHECK(PipelineKey::make(a) == PipelineKey::make(b));
+
+    // Compare op is irrelevant with depth testing off
+    GraphicsPipelineDesc c = makeDesc(10);
+    c.depth_test = false;
+    GraphicsPipelineDesc d = c;
+    d.depth_compare = CompareOp::Less;
+    CHECK(PipelineKey::make(c) == PipelineKey::make(d));
+}
+
+TEST(PipelineKey, DecodesWhatItEncodes) {
+    const PipelineKey key = PipelineKey::make(makeDesc(10));
+    const auto decoded = PipelineKey::decode(key.bytes);
+    REQUIRE(decoded.has_value());
+    CHECK(PipelineKey::make(*decoded) == key);
+
+    auto truncated = key.bytes;
+    truncated.pop_back();
+    CHECK(!PipelineKey::decode(truncated).has_value());
+}
+
+TEST(PipelineCache, DeduplicatesAndPersistsAcrossSessions) {
+    const RendererConfig renderer_config = makeRendererConfig("ashborn_pipeline_cache_test");
+    JobSystem jobs(2, "Test");
+    {
+        NullPipelineBackend backend({ 1, 2, 3, {} });
+        PipelineCache cache(backend, jobs, renderer_config);
+        REQUIRE(cache.initialize().has_value());
+
+        const PipelineId first = cache.request(makeDesc(10));
+        CHECK(cache.request(makeDesc(10)) == first);
+        for (uint64_t i = 0; i < 20; ++i) (void)cache.request(makeDesc(100 + i));
+        const PipelineId bad = cache.request(ComputePipelineDesc{ 0, 0, {} });
+
+        CHECK(cache.wait(first).isValid());
+        cache.waitAll();
+        CHECK(!cache.isReady(bad));
+        CHECK(cache.getStats().hits == 1);
+        CHECK(cache.save().has_value());
+    }
+    {
+        NullPipelineBackend backend({ 1, 2, 3, {} });
+        PipelineCache cache(backend, jobs, renderer_config);
+        REQUIRE(cache.initialize().has_value());
+        cache.waitAll();
+        CHECK(cache.getStats().driver_cache_loaded);
+        CHECK(cache.getStats().prewarmed == 21);
+        CHECK(cache.isReady(cache.request(makeDesc(105))));
+    }
+    {
+        // New driver: the blob is rejected, the prewarm list still applies
+        NullPipelineBackend backend({ 1, 2, 4, {} });
+        PipelineCache cache(backend, jobs, renderer_config);
+        REQUIRE(cache.initialize().has_value());
+        cache.waitAll();
+        CHECK(!cache.getStats().driver_cache_loaded);
+        CHECK(cache.getStats().prewarmed == 21);
+    }
+}
+
+TEST(PipelineCache, WaitNeverSeesAnUnsubmittedEntry) {
+    const RendererConfig renderer_config = makeRendererConfig("ashborn_pipeline_race_test");
+    JobSystem jobs(2, "Test");
+    NullPipelineBackend backend({ 1, 2, 3, {} });
+    PipelineCache cache(backend, jobs, renderer_config);
+    REQUIRE(cache.initialize().has_value());
+
+    // Every thread requests the same keys and waits right away, so most
+    // waits hit an entry another thread has only just inserted
+    std::atomic<uint32_t> null_handles{ 0 };
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (uint64_t i = 0; i < 2000; ++i) {
+                if (!cache.wait(cache.request(makeDesc(1000 + i * 2))).isValid()) null_handles.fetch_add(1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    CHECK(null_handles.load() == 0);
+    CHECK(cache.getStats().pipelines == 2000);
+}
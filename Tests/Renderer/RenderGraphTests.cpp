@@ -0,0 +1,140 @@
+#include "TestFramework.h"
+
+#include "RenderGraph/NullRenderGraphBackend.h"
+#include "RenderGraph/RenderGraph.h"
+
+#include <string>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    constexpr RGTextureDesc SCREEN{ 1920, 1080, RenderFormat::BGRA8Srgb };
+
+    // Depth -> GBuffer -> (Unused) -> Light -> Blur -> Composite into the backbuffer
+    struct DeferredFrame {
+        RGResource backbuffer, depth, albedo, lit, blur, unused;
+        std::vector<std::string> executed;
+
+        void declare(RenderGraph& graph) {
+            backbuffer = graph.importTexture("backbuffer", GpuImageHandle{ 1 }, SCREEN, RGLayout::Undefined, RGLayout::Present);
+
+            graph.addPass("Depth", [&](RenderGraphBuilder& builder) {
+                depth = builder.write(builder.createTexture("depth", { 1920, 1080, RenderFormat::D32Float }), RGAccess::DepthAttachment);
+            }, [&](RenderPassContext& context) { executed.emplace_back(context.getPassName()); });
+
+            graph.addPass("GBuffer", [&](RenderGraphBuilder& builder) {
+                albedo = builder.write(builder.createTexture("albedo", { 1920, 1080, RenderFormat::RGBA8Unorm }), RGAccess::ColorAttachment);
+                depth = builder.readWrite(depth, RGAccess::DepthAttachment);
+            }, [&](RenderPassContext& context) { executed.emplace_back(context.getPassName()); });
+
+            graph.addPass("Unused", [&](RenderGraphBuilder& builder) {
+                builder.read(albedo, RGAccess::SampledFragment);
+                unused = builder.write(builder.createTexture("unused", { 1920, 1080, RenderFormat::RGBA16Float }), RGAccess::ColorAttachment);
+            }, [&](RenderPassContext& context) { executed.emplace_back(context.getPassName()); });
+
+            graph.addPass("Light", [&](RenderGraphBuilder& builder) {
+                builder.read(albedo, RGAccess::SampledFragment);
+                builder.read(depth, RGAccess::SampledFragment);
+                lit = builder.write(builder.createTexture("lit", { 1920, 1080, RenderFormat::RGBA16Float }), RGAccess::ColorAttachment);
+            }, [&](RenderPassContext& context) {
+                CHECK(context.getImage(lit).isValid());
+                executed.emplace_back(context.getPassName());
+            });
+
+            graph.addPass("Blur", [&](RenderGraphBuilder& builder) {
+                builder.read(lit, RGAccess::SampledCompute);
+                blur = builder.write(builder.createTexture("blur", { 1920, 1080, RenderFormat::RGBA8Unorm }), RGAccess::StorageCompute);
+            }, [&](RenderPassContext& context) { executed.emplace_back(context.getPassName()); });
+
+            graph.addPass("Composite", [&](RenderGraphBuilder& builder) {
+                builder.read(blur, RGAccess::SampledFragment);
+                backbuffer = builder.write(backbuffer, RGAccess::ColorAttachment);
+            }, [&](RenderPassContext& context) { executed.emplace_back(context.getPassName()); });
+
+            graph.markOutput(backbuffer);
+        }
+    };
+}
+
+TEST(RenderGraph, CullsPassesThatReachNoOutput) {
+    NullRenderGraphBackend backend;
+    RenderGraph graph(backend);
+    DeferredFrame frame;
+    frame.declare(graph);
+
+    REQUIRE(graph.compile().has_value());
+    CHECK(graph.isPassCulled(2));
+    CHECK(graph.getStats().passes_culled == 1);
+
+    REQUIRE(graph.execute().has_value());
+    const std::vector<std::string> expected = { "Depth", "GBuffer", "Light", "Blur", "Composite" };
+    CHECK(frame.executed == expected);
+}
+
+TEST(RenderGraph, AliasesTransientsWithDisjointLifetimes) {
+    NullRenderGraphBackend backend;
+    RenderGraph graph(backend);
+    DeferredFrame frame;
+    frame.declare(graph);
+
+    REQUIRE(graph.compile().has_value());
+    const RenderGraphStats& stats = graph.getStats();
+    CHECK(stats.transient_resources == 4);
+    CHECK(stats.transient_bytes_allocated < stats.transient_bytes_requested);
+}
+
+TEST(RenderGraph, BarriersTransitionIntoReadLayouts) {
+    NullRenderGraphBackend backend;
+    RenderGraph graph(backend);
+    DeferredFrame frame;
+    frame.declare(graph);
+
+    REQUIRE(graph.compile().has_value());
+    REQUIRE(graph.execute().has_value());
+
+    // Light samples what GBuffer wrote: color attachment -> shader read-only
+    bool albedo_transition = false;
+    bool present_transition = false;
+    for (const auto& event : backend.getEvents()) {
+        if (event.type != NullRenderGraphBackend::EventType::Barriers) continue;
+        for (const RenderGraphBarrier& barrier : event.barriers) {
+            if (barrier.resource == frame.albedo.index &&
+                barrier.old_layout == RGLayout::ColorAttachment && barrier.new_layout == RGLayout::ShaderReadOnly) {
+                albedo_transition = (barrier.src_access & RGAccessBits::ColorAttachmentWrite) != 0;
+            }
+            if (barrier.resource == frame.backbuffer.index && barrier.new_layout == RGLayout::Present) {
+                present_transition = true;
+            }
+        }
+    }
+    CHECK(albedo_transition);
+    CHECK(present_transition);
+}
+
+TEST(RenderGraph, ReadingUnwrittenTransientFails) {
+    NullRenderGraphBackend backend;
+    RenderGraph graph(backend);
+    graph.addPass("Bad", [&](RenderGraphBuilder& builder) {
+        const RGResource texture = builder.createTexture("never_written", {});
+        builder.read(texture, RGAccess::SampledFragment);
+    }, {});
+    CHECK(!graph.compile().has_value());
+}
+
+TEST(RenderGraph, ResetKeepsResultsStable) {
+    NullRenderGraphBackend backend;
+    RenderGraph graph(backend);
+
+    DeferredFrame first;
+    first.declare(graph);
+    REQUIRE(graph.compile().has_value());
+    const RenderGraphStats stats = graph.getStats();
+
+    graph.reset();
+    DeferredFrame second;
+    second.declare(graph);
+    REQUIRE(graph.compile().has_value());
+    CHECK(graph.getStats().barriers == stats.barriers);
+    CHECK(graph.getStats().transient_bytes_allocated == stats.transient_bytes_allocated);
+}
@@ -0,0 +1,135 @@
+#include "TestFramework.h"
+
+#include "Streaming/TextureStreamer.h"
+
+using namespace AshCore;
+
+namespace {
+    // 1024x1024 R8: mips 0..3 are 1 MiB, 256 KiB, 64 KiB, 16 KiB; 4..10 are the tail
+    constexpr StreamedTextureDesc TEXTURE_DESC{ 1024, 1024, 11, 1, 1 };
+
+    void completeLoads(TextureStreamer& streamer, const StreamingDecisions& decisions) {
+        for (const MipLoadRequest& load : decisions.loads) streamer.onLoadComplete(load.texture, load.mip);
+    }
+
+    uint64_t bytesFrom(const TextureStreamer& streamer, StreamedTextureId texture, uint32_t mip) {
+        uint64_t bytes = 0;
+        for (; mip < TEXTURE_DESC.mip_count; ++mip) bytes += streamer.getMipBytes(texture, mip);
+        return bytes;
+    }
+}
+
+TEST(TextureStreamer, LoadsTailThenGrantsByAreaWithinBudget) {
+    TextureStreamingConfig config;
+    config.budget = 2 * 1024 * 1024;
+    config.max_load_bytes_per_frame = 64ull << 20;
+    TextureStreamer streamer(RendererConfig{}, config);
+    const StreamedTextureId a = streamer.registerTexture(TEXTURE_DESC);
+    const StreamedTextureId b = streamer.registerTexture(TEXTURE_DESC);
+
+    StreamingDecisions out;
+    streamer.update(1, out);
+    REQUIRE(out.loads.size() == 2);
+    CHECK(out.loads[0].mip == 4);
+    CHECK(out.loads[0].count == 7);
+    completeLoads(streamer, out);
+    CHECK(streamer.getResidentMip(a) == 4);
+
+    uint64_t frame = 2;
+    for (; frame < 40; ++frame) {
+        const TextureFeedback feedback[] = { { a, 0.0f, 0.5f }, { b, 0.0f, 0.1f } };
+        streamer.submitFeedback(feedback);
+        streamer.update(frame, out);
+        completeLoads(streamer, out);
+    }
+    // a gets its full 1 MiB level; b stops at mip 1, its next 1 MiB doesn't fit
+    CHECK(streamer.getResidentMip(a) == 0);
+    CHECK(streamer.getResidentMip(b) == 1);
+
+    for (; frame < 80; ++frame) {
+        const TextureFeedback feedback[] = { { a, 0.0f, 0.01f }, { b, 0.0f, 0.9f } };
+        streamer.submitFeedback(feedback);
+        streamer.update(frame, out);
+        completeLoads(streamer, out);
+    }
+    CHECK(streamer.getResidentMip(b) == 0);
+    CHECK(streamer.getStats().resident_bytes <= config.budget);
+    CHECK(streamer.getStats().resident_bytes == bytesFrom(streamer, a, streamer.getResidentMip(a)) + bytesFrom(streamer, b, 0));
+}
+
+TEST(TextureStreamer, KeepsCacheUntilBudgetPressure) {
+    TextureStreamingConfig config;
+    config.budget = 4 * 1024 * 1024;
+    TextureStreamer streamer(RendererConfig{}, config);
+    const StreamedTextureId texture = streamer.registerTexture(TEXTURE_DESC);
+
+    StreamingDecisions out;
+    uint64_t frame = 1;
+    for (; frame < 10; ++frame) {
+        const TextureFeedback feedback[] = { { texture, 0.0f, 1.0f } };
+        streamer.submitFeedback(feedback);
+        streamer.update(frame, out);
+        completeLoads(streamer, out);
+    }
+    REQUIRE(streamer.getResidentMip(texture) == 0);
+
+    // Unseen for feedback_frames: only the tail is wanted, but nothing is evicted yet
+    for (; frame < 100; ++frame) {
+        streamer.update(frame, out);
+        CHECK(out.evictions.empty());
+    }
+    CHECK(streamer.getStats().textures_at_desired == 1);
+
+    streamer.setBudget(100 * 1024);
+    streamer.update(frame, out);
+    REQUIRE(out.evictions.size() == 1);
+    CHECK(out.evictions[0].new_resident_mip == streamer.getResidentMip(texture));
+    CHECK(streamer.getResidentMip(texture) >= 2);
+    CHECK(streamer.getStats().resident_bytes == bytesFrom(streamer, texture, streamer.getResidentMip(texture)));
+}
+
+TEST(TextureStreamer, DoesNotEvictUnderPendingLoad) {
+    TextureStreamingConfig config;
+    config.budget = 4 * 1024 * 1024;
+    TextureStreamer streamer(RendererConfig{}, config);
+    const StreamedTextureId texture = streamer.registerTexture(TEXTURE_DESC);
+
+    StreamingDecisions out;
+    const TextureFeedback feedback[] = { { texture, 0.0f, 1.0f } };
+    for (uint64_t frame = 1; frame <= 2; ++frame) {
+        streamer.submitFeedback(feedback);
+        streamer.update(frame, out);
+        completeLoads(streamer, out);
+    }
+    REQUIRE(streamer.getResidentMip(texture) == 3);
+
+    // Mip 2 goes out, then the budget collapses before it lands
+    streamer.submitFeedback(feedback);
+    streamer.update(3, out);
+    REQUIRE(out.loads.size() == 1);
+    REQUIRE(out.loads[0].mip == 2);
+
+    streamer.setBudget(8 * 1024);
+    streamer.update(4, out);
+    CHECK(out.evictions.empty());
+    CHECK(streamer.getResidentMip(texture) == 3);
+
+    streamer.onLoadComplete(texture, 2);
+    CHECK(streamer.getResidentMip(texture) == 2);
+    CHECK(streamer.getStats().pending_loads == 1);  // Refreshed by the next update()
+
+    streamer.update(5, out);
+    REQUIRE(out.evictions.size() == 1);
+    CHECK(out.evictions[0].new_resident_mip == 4);
+    CHECK(streamer.getResidentMip(texture) == 4);
+    CHECK(streamer.getStats().resident_bytes == bytesFrom(streamer, texture, 4));
+    CHECK(streamer.getStats().pending_bytes == 0);
+}
+
+TEST(TextureStreamer, DesiredMipFollowsDistance) {
+    const float near_mip = TextureStreamer::computeDesiredMip(1024.0f, 1.0f, 1080.0f, 1.0f);
+    const float far_mip = TextureStreamer::computeDesiredMip(1024.0f, 50.0f, 1080.0f, 1.0f);
+    CHECK(near_mip >= 0.0f);
+    CHECK(far_mip > near_mip);
+    CHECK(TextureStreamer::computeDesiredMip(1.0f, 0.0f, 1080.0f, 1.0f) == 0.0f);
+}
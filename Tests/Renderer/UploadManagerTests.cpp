@@ -0,0 +1,173 @@
+#include "TestFramework.h"
+
+#include "Upload/NullUploadBackend.h"
+#include "Upload/UploadManager.h"
+#include "Jobs/Task.h"
+
+#include <thread>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    RendererConfig makeRendererConfig() {
+        RendererConfig config;
+        config.max_frames_in_flight = 2;
+        return config;
+    }
+
+    std::vector<std::byte> bytes(size_t size, uint8_t value) {
+        return std::vector<std::byte>(size, std::byte{ value });
+    }
+
+    Task<void> awaitUpload(UploadManager& uploads, UploadTicket ticket, bool& resumed) {
+        co_await uploads.completion(ticket);
+        resumed = true;
+    }
+}
+
+TEST(UploadManager, OversizedUploadIsRefused) {
+    NullUploadBackend backend;
+    UploadManager uploads(backend, makeRendererConfig(), { .frame_budget = 4096, .alignment = 16 });
+    REQUIRE(uploads.initialize().has_value());
+    const GpuBufferHandle buffer = backend.createBuffer(1 << 16);
+
+    CHECK(uploads.getRingCapacity() == 8192);
+    CHECK(!uploads.enqueueBuffer(buffer, 0, bytes(8193, 1)).has_value());
+    CHECK(uploads.getStats().uploads_pending == 0);
+
+    // Over the frame budget but within the ring: staged alone
+    const auto large = uploads.enqueueBuffer(buffer, 0, bytes(6000, 2));
+    REQUIRE(large.has_value());
+    uploads.beginFrame(1, 0);
+    uploads.flush();
+    CHECK(uploads.getStats().bytes_staged_this_frame == 6000);
+}
+
+TEST(UploadManager, BudgetCarriesOverToLaterFrames) {
+    NullUploadBackend backend;
+    UploadManager uploads(backend, makeRendererConfig(), { .frame_budget = 4096, .alignment = 16 });
+    REQUIRE(uploads.initialize().has_value());
+    const GpuBufferHandle buffer = backend.createBuffer(1 << 16);
+
+    std::vector<UploadTicket> tickets;
+    for (uint32_t i = 0; i < 12; ++i) {
+        const auto ticket = uploads.enqueueBuffer(buffer, i * 1024, bytes(1024, static_cast<uint8_t>(i + 1)));
+        REQUIRE(ticket.has_value());
+        tickets.push_back(*ticket);
+    }
+
+    uploads.beginFrame(1, 0);
+    uploads.flush();
+    CHECK(uploads.getStats().bytes_staged_this_frame == 4096);
+    CHECK(uploads.getStats().uploads_pending == 8);
+
+    uploads.beginFrame(2, 0);
+    uploads.flush();
+    CHECK(uploads.getStats().uploads_pending == 4);
+
+    // Frames 1 and 2 still own the whole ring
+    uploads.beginFrame(3, 0);
+    uploads.flush();
+    CHECK(uploads.getStats().uploads_pending == 4);
+
+    uploads.beginFrame(4, 2);
+    uploads.flush();
+    CHECK(uploads.getStats().uploads_pending == 0);
+
+    const std::vector<std::byte>* contents = backend.getBufferContents(buffer);
+    REQUIRE(contents != nullptr);
+    for (uint32_t i = 0; i < 12; ++i) {
+        CHECK((*contents)[i * 1024] == std::byte{ static_cast<uint8_t>(i + 1) });
+    }
+}
+
+TEST(UploadManager, TicketsRetireWithTheirFrame) {
+    NullUploadBackend backend;
+    UploadManager uploads(backend, makeRendererConfig(), { .frame_budget = 4096, .alignment = 16 });
+    REQUIRE(uploads.initialize().has_value());
+    const GpuBufferHandle buffer = backend.createBuffer(1 << 16);
+
+    const auto first = uploads.enqueueBuffer(buffer, 0, bytes(4096, 1));
+    const auto second = uploads.enqueueBuffer(buffer, 4096, bytes(4096, 2));
+    REQUIRE(first && second);
+    CHECK(uploads.isComplete(*uploads.enqueueBuffer(buffer, 0, {})));
+
+    uploads.beginFrame(1, 0);
+    uploads.flush();
+    uploads.beginFrame(2, 0);
+    uploads.flush();
+    CHECK(!uploads.isComplete(*first));
+
+    uploads.beginFrame(3, 1);
+    CHECK(uploads.isComplete(*first));
+    CHECK(!uploads.isComplete(*second));
+
+    uploads.beginFrame(4, 2);
+    CHECK(uploads.isComplete(*second));
+}
+
+TEST(UploadManager, AdjacentWritesCoalesceAndOverlapsKeepOrder) {
+    NullUploadBackend backend;
+    UploadManager uploads(backend, makeRendererConfig(), { .frame_budget = 4096, .alignment = 16 });
+    REQUIRE(uploads.initialize().has_value());
+    const GpuBufferHandle buffer = backend.createBuffer(1 << 16);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        REQUIRE(uploads.enqueueBuffer(buffer, i * 256, bytes(256, 1)).has_value());
+    }
+    REQUIRE(uploads.enqueueBuffer(buffer, 100, bytes(16, 9)).has_value());
+
+    uploads.beginFrame(1, 0);
+    uploads.flush();
+    CHECK(uploads.getStats().regions_this_frame == 5);
+    CHECK(uploads.getStats().copy_commands_this_frame == 2);
+    CHECK((*backend.getBufferContents(buffer))[100] == std::byte{ 9 });
+    CHECK((*backend.getBufferContents(buffer))[99] == std::byte{ 1 });
+}
+
+TEST(UploadManager, CompletionResumesAwaitingCoroutine) {
+    NullUploadBackend backend;
+    UploadManager uploads(backend, makeRendererConfig(), { .frame_budget = 4096, .alignment = 16 });
+    REQUIRE(uploads.initialize().has_value());
+    const GpuBufferHandle buffer = backend.createBuffer(1 << 16);
+
+    const auto ticket = uploads.enqueueBuffer(buffer, 0, bytes(64, 1));
+    REQUIRE(ticket.has_value());
+
+    bool resumed = false;
+    Task<void> task = awaitUpload(uploads, *ticket, resumed);
+    spawn(std::move(task));
+    CHECK(!resumed);
+
+    uploads.beginFrame(1, 0);
+    uploads.flush();
+    uploads.beginFrame(2, 1);
+    CHECK(resumed);
+}
+
+TEST(UploadManager, EnqueueFromSeveralThreads) {
+    NullUploadBackend backend;
+    UploadManager uploads(backend, makeRendererConfig(), { .frame_budget = 1 << 20, .alignment = 16 });
+    REQUIRE(uploads.initialize().has_value());
+    const GpuBufferHandle buffer = backend.createBuffer(1 << 20);
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t i = 0; i < 64; ++i) {
+                CHECK(uploads.enqueueBuffer(buffer, (t * 64 + i) * 64, bytes(64, static_cast<uint8_t>(t + 1))).has_value());
+            }
+        });
+    }
+    for (uint64_t frame = 1; frame <= 4; ++frame) {
+        uploads.beginFrame(frame, frame - 1);
+        uploads.flush();
+    }
+    for (std::thread& thread : threads) thread.join();
+    uploads.beginFrame(5, 4);
+    uploads.flush();
+
+    CHECK(uploads.getStats().uploads_pending == 0);
+    CHECK(uploads.getStats().bytes_uploaded_total == 4 * 64 * 64);
+}
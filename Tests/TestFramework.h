@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+namespace AshTest {
+
+    // ==========================================
+    // REGISTRY
+    // ==========================================
+
+    struct TestCase {
+        const char* suite;
+        const char* name;
+        std::function<void()> body;
+    };
+
+    inline std::vector<TestCase>& getRegistry() {
+        static std::vector<TestCase> registry;
+        return registry;
+    }
+
+    // Failed checks of the test that is running
+    inline int& getFailureCount() {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar {
+        Registrar(const char* suite, const char* name, std::function<void()> body) {
+            getRegistry().push_back({ suite, name, std::move(body) });
+        }
+    };
+
+    // Thrown by REQUIRE to abandon the current test
+    struct RequireFailed {};
+
+    inline void reportFailure(const char* file, int line, const char* expression) {
+        std::fprintf(stderr, "    %s:%d: %s failed\n", file, line, expression);
+        ++getFailureCount();
+    }
+
+} // namespace AshTest
+
+#define ASH_TEST_CONCAT_INNER(a, b) a##b
+#define ASH_TEST_CONCAT(a, b) ASH_TEST_CONCAT_INNER(a, b)
+
+// TEST(Suite, Name) { ... } registers a test run by TestMain.cpp
+#define TEST(suite, name)                                                              \
+    static void ASH_TEST_CONCAT(test_, ASH_TEST_CONCAT(suite, ASH_TEST_CONCAT(_, name)))(); \
+    static AshTest::Registrar ASH_TEST_CONCAT(registrar_, ASH_TEST_CONCAT(suite, ASH_TEST_CONCAT(_, name))){ \
+        #suite, #name, &ASH_TEST_CONCAT(test_, ASH_TEST_CONCAT(suite, ASH_TEST_CONCAT(_, name))) }; \
+    static void ASH_TEST_CONCAT(test_, ASH_TEST_CONCAT(suite, ASH_TEST_CONCAT(_, name)))()
+
+// CHECK records a failure and carries on; REQUIRE also ends the test
+#define CHECK(expression)                                                              \
+    do {                                                                               \
+        if (!(expression)) AshTest::reportFailure(__FILE__, __LINE__, #expression);    \
+    } while (false)
+
+#define REQUIRE(expression)                                                            \
+    do {                                                                               \
+        if (!(expression)) {                                                           \
+            AshTest::reportFailure(__FILE__, __LINE__, #expression);                   \
+            throw AshTest::RequireFailed{};                                            \
+        }                                                                              \
+    } while (false)
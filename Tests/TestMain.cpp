@@ -0,0 +1,42 @@
+#include "TestFramework.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+// Usage: Tests [filter]  runs every test whose "Suite.Name" contains filter
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    int run = 0;
+    int failed = 0;
+    for (const AshTest::TestCase& test : AshTest::getRegistry()) {
+        char full_name[256];
+        std::snprintf(full_name, sizeof(full_name), "%s.%s", test.suite, test.name);
+        if (filter && !std::strstr(full_name, filter)) continue;
+
+        std::printf("[ RUN  ] %s\n", full_name);
+        AshTest::getFailureCount() = 0;
+        try {
+            test.body();
+        }
+        catch (const AshTest::RequireFailed&) {
+        }
+        catch (const std::exception& e) {
+            std::fprintf(stderr, "    unexpected exception: %s\n", e.what());
+            ++AshTest::getFailureCount();
+        }
+        catch (...) {
+            std::fprintf(stderr, "    unexpected exception\n");
+            ++AshTest::getFailureCount();
+        }
+
+        ++run;
+        const bool passed = AshTest::getFailureCount() == 0;
+        if (!passed) ++failed;
+        std::printf("[ %s ] %s\n", passed ? " OK " : "FAIL", full_name);
+    }
+
+    std::printf("%d tests, %d failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+#include "TestFramework.h"
+
+#include "AssetCooker/AssetCooker.h"
+#include "Jobs/JobSystem.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace AshCore;
+
+namespace {
+    struct TempDirectory {
+        std::filesystem::path path;
+
+        TempDirectory() {
+            path = std::filesystem::temp_directory_path() / "ashborn_cooker_test";
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path / "source" / "ui");
+        }
+
+        ~TempDirectory() {
+            std::error_code error;
+            std::filesystem::remove_all(path, error);
+        }
+
+        void write(const std::string& relative, const std::string& contents) const {
+            std::ofstream(path / "source" / relative, std::ios::binary | std::ios::trunc) << contents;
+        }
+    };
+
+    // Uncompressed 32-bit TGA, bottom-up BGRA
+    std::string tga(uint8_t width, uint8_t height, uint8_t shade) {
+        std::string file(18, '\0');
+        file[2] = 2;
+        file[12] = static_cast<char>(width);
+        file[14] = static_cast<char>(height);
+        file[16] = 32;
+        file[17] = 8;
+        for (size_t i = 0; i < size_t{ width } * height; ++i) {
+            file += static_cast<char>(shade);
+            file += static_cast<char>(255 - shade);
+            file += static_cast<char>(i);
+            file += static_cast<char>(255);
+        }
+        return file;
+    }
+
+    AssetCookerStats cook(const TempDirectory& directory, JobSystem& jobs) {
+        AssetCookerOptions options;
+        options.source = directory.path / "source";
+        options.output = directory.path / "cooked";
+        AssetCooker cooker(std::move(options));
+        const auto stats = cooker.run(jobs);
+        REQUIRE(stats.has_value());
+        CHECK(stats->failed == 0);
+        return *stats;
+    }
+}
+
+TEST(AssetCooker, OnlyChangedInputsAreRecooked) {
+    TempDirectory directory;
+    directory.write("data.txt", "hello");
+    directory.write("stone.tga", tga(8, 4, 10));
+    directory.write("stone.tga.cook", "premultiply = false\n");
+    directory.write("ui/dir.cook", "atlas = ui/atlas\n");
+    directory.write("ui/a.tga", tga(5, 7, 20));
+    directory.write("ui/b.tga", tga(9, 3, 30));
+    JobSystem jobs(2, "Test");
+
+    // A texture, an atlas of two images, and a copy
+    AssetCookerStats stats = cook(directory, jobs);
+    CHECK(stats.cooked == 2);
+    CHECK(stats.copied == 1);
+    CHECK(std::filesystem::exists(directory.path / "cooked" / "stone.ashtex"));
+    CHECK(std::filesystem::exists(directory.path / "cooked" / "ui" / "atlas.ashtex"));
+    const auto cooked_time = std::filesystem::last_write_time(directory.path / "cooked" / "stone.ashtex");
+
+    stats = cook(directory, jobs);
+    CHECK(stats.up_to_date == 3);
+    CHECK(stats.cooked + stats.copied == 0);
+    CHECK(std::filesystem::last_write_time(directory.path / "cooked" / "stone.ashtex") == cooked_time);
+
+    // Keys follow content, so rewriting the same bytes changes nothing
+    directory.write("stone.tga", tga(8, 4, 10));
+    stats = cook(directory, jobs);
+    CHECK(stats.up_to_date == 3);
+
+    directory.write("data.txt", "hello again");
+    stats = cook(directory, jobs);
+    CHECK(stats.copied == 1);
+    CHECK(stats.up_to_date == 2);
+
+    // The image's settings file is an input of its texture
+    directory.write("stone.tga.cook", "premultiply = true\n");
+    stats = cook(directory, jobs);
+    CHECK(stats.cooked == 1);
+    CHECK(stats.up_to_date == 2);
+
+    // So is every image of an atlas, and the directory settings above them
+    directory.write("ui/b.tga", tga(9, 3, 31));
+    stats = cook(directory, jobs);
+    CHECK(stats.cooked == 1);
+    CHECK(stats.up_to_date == 2);
+
+    directory.write("ui/dir.cook", "atlas = ui/atlas\natlas_padding = 8\n");
+    stats = cook(directory, jobs);
+    CHECK(stats.cooked == 1);
+    CHECK(stats.up_to_date == 2);
+
+    // A deleted source takes its output with it
+    std::filesystem::remove(directory.path / "source" / "data.txt");
+    stats = cook(directory, jobs);
+    CHECK(stats.removed == 1);
+    CHECK(stats.up_to_date == 2);
+    CHECK(!std::filesystem::exists(directory.path / "cooked" / "data.txt"));
+}